@@ -0,0 +1,245 @@
+#include "asset_archive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <latch>
+
+#include "lz4.h"
+#include "thread_pool.h"
+
+namespace {
+constexpr uint32_t kChunksPerJob = 4;  // 256 KB of output per pool job
+
+char ToLowerAscii(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+    return ToLowerAscii(x) == ToLowerAscii(y);
+  });
+}
+
+// [offset, offset + size) lies within a file of file_size bytes
+bool InFile(uint64_t offset, uint64_t size, uint64_t file_size) {
+  return offset <= file_size && size <= file_size - offset;
+}
+
+// Header, table bounds and chunk layout of a whole archive file (entry data is not touched)
+bool ValidateArchive(const uint8_t* data, uint64_t file_size) {
+  if (file_size < sizeof(AssetArchiveHeader)) {
+    return false;
+  }
+  const auto& header = *reinterpret_cast<const AssetArchiveHeader*>(data);
+  if (header.magic != kAssetArchiveMagic || header.version != kAssetArchiveVersion || header.chunk_size == 0) {
+    return false;
+  }
+  // The tables are used in place, so they must be aligned for their records
+  if (header.entry_table_offset % alignof(AssetArchiveEntry) != 0 || header.chunk_table_offset % alignof(AssetArchiveChunk) != 0 ||
+      !InFile(header.entry_table_offset, static_cast<uint64_t>(header.entry_count) * sizeof(AssetArchiveEntry), file_size) ||
+      !InFile(header.chunk_table_offset, static_cast<uint64_t>(header.chunk_count) * sizeof(AssetArchiveChunk), file_size) ||
+      !InFile(header.path_table_offset, header.path_table_size, file_size)) {
+    return false;
+  }
+
+  const auto* entries = reinterpret_cast<const AssetArchiveEntry*>(data + header.entry_table_offset);
+  const auto* chunks = reinterpret_cast<const AssetArchiveChunk*>(data + header.chunk_table_offset);
+  for (uint32_t i = 0; i < header.entry_count; ++i) {
+    const AssetArchiveEntry& entry = entries[i];
+    if (i > 0 && entries[i - 1].path_hash > entry.path_hash) {
+      return false;  // Lookups binary search the hashes
+    }
+    if (!InFile(entry.path_offset, entry.path_length, header.path_table_size) ||
+        entry.first_chunk > header.chunk_count || entry.chunk_count > header.chunk_count - entry.first_chunk ||
+        entry.chunk_count != (entry.size + header.chunk_size - 1) / header.chunk_size) {
+      return false;
+    }
+
+    bool compressed = false;
+    for (uint32_t c = 0; c < entry.chunk_count; ++c) {
+      const AssetArchiveChunk& chunk = chunks[entry.first_chunk + c];
+      const uint64_t offset = static_cast<uint64_t>(c) * header.chunk_size;
+      const uint64_t raw_size = (std::min)(static_cast<uint64_t>(header.chunk_size), entry.size - offset);
+      const bool lz4 = (chunk.flags & kAssetArchiveChunkFlagLz4) != 0;
+      if (!InFile(chunk.offset, chunk.stored_size, file_size) || (!lz4 && chunk.stored_size != raw_size)) {
+        return false;
+      }
+      compressed = compressed || lz4;
+      // Entries read in place are one contiguous range
+      if (!lz4 && (entry.flags & kAssetArchiveEntryFlagCompressed) == 0 &&
+          chunk.offset != entry.data_offset + offset) {
+        return false;
+      }
+    }
+    if (compressed != ((entry.flags & kAssetArchiveEntryFlagCompressed) != 0) ||
+        (!compressed && !InFile(entry.data_offset, entry.size, file_size))) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+std::string NormalizeAssetPath(std::string_view path) {
+  std::string normalized;
+  normalized.reserve(path.size());
+  size_t begin = 0;
+  while (begin <= path.size()) {
+    size_t end = path.find_first_of("/\\", begin);
+    if (end == std::string_view::npos) {
+      end = path.size();
+    }
+    const std::string_view segment = path.substr(begin, end - begin);
+    if (!segment.empty() && segment != ".") {
+      if (!normalized.empty()) {
+        normalized += '/';
+      }
+      normalized += segment;
+    }
+    begin = end + 1;
+  }
+  return normalized;
+}
+
+std::string NormalizeAssetPath(const std::filesystem::path& path) {
+  const std::u8string utf8 = path.generic_u8string();
+  return NormalizeAssetPath(std::string_view(reinterpret_cast<const char*>(utf8.data()), utf8.size()));
+}
+
+uint64_t HashAssetPath(std::string_view normalized_path) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : normalized_path) {
+    hash ^= static_cast<uint8_t>(ToLowerAscii(c));
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool AssetArchive::Open(const std::filesystem::path& file_path) {
+  Close();
+  if (!file_.Open(file_path)) {
+    return false;
+  }
+
+  const uint8_t* data = file_.GetData();
+  if (!ValidateArchive(data, file_.GetSize())) {
+    std::cerr << "[AssetArchive] Invalid archive: " << file_path.string() << '\n';
+    file_.Close();
+    return false;
+  }
+  header_ = reinterpret_cast<const AssetArchiveHeader*>(data);
+  entries_ = reinterpret_cast<const AssetArchiveEntry*>(data + header_->entry_table_offset);
+  chunks_ = reinterpret_cast<const AssetArchiveChunk*>(data + header_->chunk_table_offset);
+  paths_ = reinterpret_cast<const char*>(data + header_->path_table_offset);
+  return true;
+}
+
+void AssetArchive::Close() {
+  file_.Close();
+  header_ = nullptr;
+  entries_ = nullptr;
+  chunks_ = nullptr;
+  paths_ = nullptr;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(std::string_view path) const {
+  if (header_ == nullptr) {
+    return nullptr;
+  }
+  const std::string normalized = NormalizeAssetPath(path);
+  const uint64_t hash = HashAssetPath(normalized);
+
+  const AssetArchiveEntry* end = entries_ + header_->entry_count;
+  const AssetArchiveEntry* it =
+    std::lower_bound(entries_, end, hash, [](const AssetArchiveEntry& entry, uint64_t value) { return entry.path_hash < value; });
+  for (; it != end && it->path_hash == hash; ++it) {
+    if (EqualsIgnoreCase(GetEntryPath(*it), normalized)) {
+      return it;
+    }
+  }
+  return nullptr;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const std::filesystem::path& path) const {
+  const std::u8string utf8 = path.generic_u8string();
+  return Find(std::string_view(reinterpret_cast<const char*>(utf8.data()), utf8.size()));
+}
+
+const uint8_t* AssetArchive::GetStoredData(const AssetArchiveEntry& entry) const {
+  if ((entry.flags & kAssetArchiveEntryFlagCompressed) != 0) {
+    return nullptr;
+  }
+  return file_.GetData() + entry.data_offset;
+}
+
+bool AssetArchive::ReadChunks(const AssetArchiveEntry& entry, uint32_t begin, uint32_t end, uint8_t* dst) const {
+  const uint32_t chunk_size = header_->chunk_size;
+  for (uint32_t c = begin; c < end; ++c) {
+    const AssetArchiveChunk& chunk = chunks_[entry.first_chunk + c];
+    const uint64_t offset = static_cast<uint64_t>(c) * chunk_size;
+    const size_t raw_size = static_cast<size_t>((std::min)(static_cast<uint64_t>(chunk_size), entry.size - offset));
+    const uint8_t* stored = file_.GetData() + chunk.offset;
+    if ((chunk.flags & kAssetArchiveChunkFlagLz4) == 0) {
+      std::memcpy(dst + offset, stored, raw_size);
+    } else if (!Lz4Decompress(stored, chunk.stored_size, dst + offset, raw_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AssetArchive::Read(const AssetArchiveEntry& entry, uint8_t* dst, ThreadPool* pool) const {
+  bool success = true;
+  if (pool == nullptr || pool->GetWorkerCount() == 0 || entry.chunk_count <= kChunksPerJob) {
+    success = ReadChunks(entry, 0, entry.chunk_count, dst);
+  } else {
+    // Chunks decode independently: a few per job, and the caller takes the first batch itself
+    const uint32_t job_count = (entry.chunk_count + kChunksPerJob - 1) / kChunksPerJob;
+    std::atomic<bool> failed = false;
+    std::latch done(job_count - 1);
+    for (uint32_t job = 1; job < job_count; ++job) {
+      pool->Submit([this, &entry, &failed, &done, dst, job] {
+        const uint32_t begin = job * kChunksPerJob;
+        if (!ReadChunks(entry, begin, (std::min)(begin + kChunksPerJob, entry.chunk_count), dst)) {
+          failed = true;
+        }
+        done.count_down();
+      });
+    }
+    success = ReadChunks(entry, 0, kChunksPerJob, dst);
+    done.wait();
+    success = success && !failed;
+  }
+
+  if (!success) {
+    std::cerr << "[AssetArchive] Corrupt chunk data in " << GetEntryPath(entry) << '\n';
+  }
+  return success;
+}
+
+bool AssetArchive::Load(const AssetArchiveEntry& entry, AssetBlob& out_blob, ThreadPool* pool) const {
+  out_blob.size = static_cast<size_t>(entry.size);
+  if (const uint8_t* stored = GetStoredData(entry); stored != nullptr) {
+    out_blob.data = stored;
+    return true;
+  }
+  out_blob.buffer.resize(out_blob.size);
+  out_blob.data = out_blob.buffer.data();
+  return Read(entry, out_blob.buffer.data(), pool);
+}
+
+bool LoadAsset(const AssetArchive* archive, const std::filesystem::path& path, AssetBlob& out_blob) {
+  if (archive != nullptr) {
+    if (const AssetArchiveEntry* entry = archive->Find(path); entry != nullptr) {
+      return archive->Load(*entry, out_blob);
+    }
+  }
+  if (!out_blob.file.Open(path)) {
+    return false;
+  }
+  out_blob.data = out_blob.file.GetData();
+  out_blob.size = out_blob.file.GetSize();
+  return true;
+}
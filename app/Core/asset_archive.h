@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+
+class ThreadPool;
+
+// Packed asset archive (.pak): many asset files in one memory-mapped file, written by tools/asset_packer.
+//
+//   [AssetArchiveHeader][entry data][AssetArchiveEntry x entry_count][AssetArchiveChunk x chunk_count][paths]
+//
+// Entries are sorted by the hash of their path, so a lookup is a binary search over the mapped table and
+// opening an archive only validates the tables. Entry data is split into 64 KB chunks stored back to back;
+// each chunk is LZ4 compressed, or raw when compression does not pay. An entry without compressed chunks
+// is one contiguous range of the mapping, starts at a 4096-byte aligned offset and is read in place: cooked
+// textures stored this way keep their aligned data block aligned, ready to be copied into upload memory.
+// The format is little-endian, fixed-layout records.
+
+constexpr uint32_t kAssetArchiveMagic = 0x4B415041;  // "APAK"
+constexpr uint32_t kAssetArchiveVersion = 1;
+constexpr uint32_t kAssetArchiveChunkSize = 64 * 1024;
+constexpr uint32_t kAssetArchiveDataAlignment = 4096;
+
+struct AssetArchiveHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t chunk_size;  // Uncompressed bytes per chunk (the last chunk of an entry may be shorter)
+  uint32_t entry_count;
+  uint32_t chunk_count;
+  uint32_t reserved;
+  uint64_t entry_table_offset;
+  uint64_t chunk_table_offset;
+  uint64_t path_table_offset;
+  uint64_t path_table_size;
+};
+static_assert(sizeof(AssetArchiveHeader) == 56, "AssetArchiveHeader layout is part of the file format");
+
+constexpr uint32_t kAssetArchiveEntryFlagCompressed = 1u << 0;  // At least one chunk is LZ4 compressed
+
+struct AssetArchiveEntry {
+  uint64_t path_hash;    // HashAssetPath of the path
+  uint64_t data_offset;  // File offset of the first chunk
+  uint64_t size;         // Uncompressed bytes
+  uint32_t first_chunk;
+  uint32_t chunk_count;
+  uint32_t path_offset;  // Into the path table (not null-terminated)
+  uint32_t path_length;
+  uint32_t flags;
+  uint32_t reserved;
+};
+static_assert(sizeof(AssetArchiveEntry) == 48, "AssetArchiveEntry layout is part of the file format");
+
+constexpr uint32_t kAssetArchiveChunkFlagLz4 = 1u << 0;
+
+struct AssetArchiveChunk {
+  uint64_t offset;       // File offset
+  uint32_t stored_size;  // Bytes in the file
+  uint32_t flags;        // Raw bytes unless kAssetArchiveChunkFlagLz4
+};
+static_assert(sizeof(AssetArchiveChunk) == 16, "AssetArchiveChunk layout is part of the file format");
+
+// Archive paths are relative and '/'-separated, e.g. "Content/textures/white.png": backslashes become
+// slashes, and empty and "." segments are dropped. Lookups ignore ASCII case.
+std::string NormalizeAssetPath(std::string_view path);
+std::string NormalizeAssetPath(const std::filesystem::path& path);
+
+// 64-bit FNV-1a of the ASCII-lowercased normalized path
+uint64_t HashAssetPath(std::string_view normalized_path);
+
+// Bytes of one loaded asset: archive entries read in place point into the archive mapping (valid while the
+// archive stays open), decompressed entries into buffer, and loose files into their own mapping.
+struct AssetBlob {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  std::vector<uint8_t> buffer;
+  MappedFile file;
+};
+
+// AssetArchive: Read-only view of a mapped .pak. All const member functions are thread-safe.
+class AssetArchive {
+ public:
+  AssetArchive() = default;
+  ~AssetArchive() = default;
+
+  AssetArchive(const AssetArchive&) = delete;
+  AssetArchive& operator=(const AssetArchive&) = delete;
+
+  // Map file_path and validate the header and tables (entry data is not touched)
+  bool Open(const std::filesystem::path& file_path);
+  void Close();
+
+  bool IsOpen() const {
+    return header_ != nullptr;
+  }
+
+  // Entry for a path (normalized here); nullptr when the archive has none
+  const AssetArchiveEntry* Find(std::string_view path) const;
+  const AssetArchiveEntry* Find(const std::filesystem::path& path) const;
+
+  uint32_t GetEntryCount() const {
+    return header_ != nullptr ? header_->entry_count : 0;
+  }
+  const AssetArchiveEntry& GetEntry(uint32_t index) const {
+    return entries_[index];
+  }
+  std::string_view GetEntryPath(const AssetArchiveEntry& entry) const {
+    return {paths_ + entry.path_offset, entry.path_length};
+  }
+
+  // Bytes of an entry without compressed chunks, in place in the mapping; nullptr for compressed entries
+  const uint8_t* GetStoredData(const AssetArchiveEntry& entry) const;
+
+  // Decompress entry into dst (entry.size bytes). With a pool, the chunks of large entries decompress on
+  // its workers (do not call from a job of the same pool).
+  bool Read(const AssetArchiveEntry& entry, uint8_t* dst, ThreadPool* pool = nullptr) const;
+
+  // Stored entries point into the mapping, compressed ones are decompressed into out_blob.buffer
+  bool Load(const AssetArchiveEntry& entry, AssetBlob& out_blob, ThreadPool* pool = nullptr) const;
+
+  // Bytes in the file, for statistics
+  size_t GetFileSize() const {
+    return file_.GetSize();
+  }
+
+ private:
+  MappedFile file_;
+  const AssetArchiveHeader* header_ = nullptr;
+  const AssetArchiveEntry* entries_ = nullptr;
+  const AssetArchiveChunk* chunks_ = nullptr;
+  const char* paths_ = nullptr;
+
+  bool ReadChunks(const AssetArchiveEntry& entry, uint32_t begin, uint32_t end, uint8_t* dst) const;
+};
+
+// Load path from archive when it is given and has the entry, otherwise map the loose file
+bool LoadAsset(const AssetArchive* archive, const std::filesystem::path& path, AssetBlob& out_blob);
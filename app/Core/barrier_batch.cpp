@@ -0,0 +1,77 @@
+#include "barrier_batch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+void BarrierBatch::Transition(void* resource, TrackedState& tracked, uint32_t subresource_count, uint32_t new_state, uint32_t subresource) {
+  std::vector<uint32_t>& states = tracked.subresource_states;
+
+  if (subresource == kAllSubresources) {
+    if (states.empty()) {
+      if (tracked.state == new_state) {
+        ++eliminated_count_;
+        return;
+      }
+      AddBarrier(resource, subresource, tracked.state, new_state);
+    } else {
+      // Subresources diverged: bring each one over individually
+      for (uint32_t i = 0; i < static_cast<uint32_t>(states.size()); ++i) {
+        if (states[i] != new_state) {
+          AddBarrier(resource, i, states[i], new_state);
+        }
+      }
+      states.clear();
+    }
+    tracked.state = new_state;
+    return;
+  }
+
+  if (states.empty()) {
+    if (tracked.state == new_state) {
+      ++eliminated_count_;
+      return;
+    }
+    states.assign(subresource_count, tracked.state);
+  }
+
+  assert(subresource < states.size());
+  if (states[subresource] == new_state) {
+    ++eliminated_count_;
+    return;
+  }
+
+  AddBarrier(resource, subresource, states[subresource], new_state);
+  states[subresource] = new_state;
+
+  // Back to whole-resource tracking once every subresource agrees
+  if (std::all_of(states.begin(), states.end(), [new_state](uint32_t state) { return state == new_state; })) {
+    states.clear();
+    tracked.state = new_state;
+  }
+}
+
+void BarrierBatch::AddBarrier(void* resource, uint32_t subresource, uint32_t before, uint32_t after) {
+  // Only the last pending barrier of this resource can be merged; anything earlier would reorder barriers
+  for (auto it = pending_.rbegin(); it != pending_.rend(); ++it) {
+    if (it->resource != resource) {
+      continue;
+    }
+    if (it->subresource != subresource) {
+      break;
+    }
+
+    assert(it->after == before);
+    ++eliminated_count_;
+    if (it->before == after) {
+      // A->B->A within one batch: neither barrier is needed
+      pending_.erase(std::next(it).base());
+      ++eliminated_count_;
+    } else {
+      it->after = after;
+    }
+    return;
+  }
+
+  pending_.push_back({resource, subresource, before, after});
+}
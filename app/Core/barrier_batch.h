@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// BarrierBatch: Device-independent bookkeeping behind ResourceStateTracker. Transitions are recorded
+// against each resource's TrackedState and collected as pending barriers until the owner issues them.
+//
+// The tracked state is updated when the transition is recorded, so later transitions in the same batch
+// see the right "before" state. A transition that undoes a pending one (A->B then B->A) is dropped, and
+// chained ones (A->B then B->C) are merged into one barrier. Subresources are tracked individually once a
+// single one is transitioned, and collapse back to whole-resource tracking when they agree again.
+// States are opaque bit masks (D3D12_RESOURCE_STATES on the Graphic side), resources opaque pointers.
+class BarrierBatch {
+ public:
+  static constexpr uint32_t kAllSubresources = 0xffffffff;
+
+  // Lives with the resource
+  struct TrackedState {
+    uint32_t state = 0;                         // Whole-resource state while subresource_states is empty
+    std::vector<uint32_t> subresource_states;  // One per subresource once they diverged
+
+    void Reset(uint32_t new_state) {
+      state = new_state;
+      subresource_states.clear();
+    }
+
+    uint32_t Get(uint32_t subresource) const {
+      return subresource_states.empty() ? state : subresource_states[subresource];
+    }
+  };
+
+  struct Barrier {
+    void* resource = nullptr;
+    uint32_t subresource = kAllSubresources;
+    uint32_t before = 0;
+    uint32_t after = 0;
+  };
+
+  BarrierBatch() = default;
+
+  // Move resource (or one of its subresource_count subresources) to new_state. subresource_count is
+  // only read when a single subresource is transitioned.
+  void Transition(void* resource, TrackedState& tracked, uint32_t subresource_count, uint32_t new_state,
+    uint32_t subresource = kAllSubresources);
+
+  const std::vector<Barrier>& GetPending() const {
+    return pending_;
+  }
+
+  bool IsEmpty() const {
+    return pending_.empty();
+  }
+
+  // Drop the pending barriers once they are issued
+  void Clear() {
+    pending_.clear();
+  }
+
+  // Redundant (already in state), merged or cancelled transitions since construction
+  uint64_t GetEliminatedCount() const {
+    return eliminated_count_;
+  }
+
+ private:
+  std::vector<Barrier> pending_;
+  uint64_t eliminated_count_ = 0;
+
+  void AddBarrier(void* resource, uint32_t subresource, uint32_t before, uint32_t after);
+};
@@ -0,0 +1,708 @@
+#include "block_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <latch>
+
+#include "thread_pool.h"
+
+namespace {
+constexpr int kBlockPixels = 16;
+
+// ---- Shared helpers ----
+
+int Clamp255(float value) {
+  return static_cast<int>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+}
+
+// Principal axis of `count`-channel points (power iteration on the covariance matrix); returns the mean
+template <int N>
+void PrincipalAxis(const std::array<std::array<float, N>, kBlockPixels>& points, std::array<float, N>& mean, std::array<float, N>& axis) {
+  mean.fill(0.0f);
+  for (const auto& p : points) {
+    for (int c = 0; c < N; ++c) {
+      mean[c] += p[c];
+    }
+  }
+  for (int c = 0; c < N; ++c) {
+    mean[c] /= kBlockPixels;
+  }
+
+  std::array<std::array<float, N>, N> cov{};
+  for (const auto& p : points) {
+    for (int i = 0; i < N; ++i) {
+      for (int j = i; j < N; ++j) {
+        cov[i][j] += (p[i] - mean[i]) * (p[j] - mean[j]);
+      }
+    }
+  }
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < i; ++j) {
+      cov[i][j] = cov[j][i];
+    }
+  }
+
+  // Start from the channel with the largest spread so a dominant single channel converges immediately
+  axis.fill(0.0f);
+  int widest = 0;
+  for (int c = 1; c < N; ++c) {
+    widest = (cov[c][c] > cov[widest][widest]) ? c : widest;
+  }
+  axis[widest] = 1.0f;
+  for (int iteration = 0; iteration < 8; ++iteration) {
+    std::array<float, N> next{};
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        next[i] += cov[i][j] * axis[j];
+      }
+    }
+    float length = 0.0f;
+    for (int c = 0; c < N; ++c) {
+      length += next[c] * next[c];
+    }
+    if (length < 1e-12f) {
+      break;
+    }
+    length = 1.0f / std::sqrt(length);
+    for (int c = 0; c < N; ++c) {
+      axis[c] = next[c] * length;
+    }
+  }
+}
+
+// ---- BC1 ----
+
+uint16_t Pack565(const std::array<int, 3>& rgb) {
+  const int r = (rgb[0] * 31 + 127) / 255;
+  const int g = (rgb[1] * 63 + 127) / 255;
+  const int b = (rgb[2] * 31 + 127) / 255;
+  return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+std::array<int, 3> Unpack565(uint16_t color) {
+  const int r = (color >> 11) & 31;
+  const int g = (color >> 5) & 63;
+  const int b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+// Palette of a 4-color block
+std::array<std::array<int, 3>, 4> BC1Palette(uint16_t c0, uint16_t c1) {
+  const std::array<int, 3> e0 = Unpack565(c0);
+  const std::array<int, 3> e1 = Unpack565(c1);
+  std::array<std::array<int, 3>, 4> palette{};
+  for (int c = 0; c < 3; ++c) {
+    palette[0][c] = e0[c];
+    palette[1][c] = e1[c];
+    palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+    palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+  }
+  return palette;
+}
+
+// Best palette index per pixel; returns the total squared error
+int ChooseBC1Indices(const uint8_t* rgba, uint16_t c0, uint16_t c1, std::array<uint8_t, kBlockPixels>& indices) {
+  const auto palette = BC1Palette(c0, c1);
+  int total = 0;
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const uint8_t* p = rgba + i * 4;
+    int best = 0;
+    int best_error = INT32_MAX;
+    for (int k = 0; k < 4; ++k) {
+      const int dr = p[0] - palette[k][0];
+      const int dg = p[1] - palette[k][1];
+      const int db = p[2] - palette[k][2];
+      const int error = dr * dr + dg * dg + db * db;
+      if (error < best_error) {
+        best_error = error;
+        best = k;
+      }
+    }
+    indices[i] = static_cast<uint8_t>(best);
+    total += best_error;
+  }
+  return total;
+}
+
+// Least-squares endpoints for fixed indices (weights of endpoint 0 per palette entry: 1, 0, 2/3, 1/3)
+bool RefineBC1Endpoints(
+  const uint8_t* rgba, const std::array<uint8_t, kBlockPixels>& indices, std::array<int, 3>& e0, std::array<int, 3>& e1) {
+  constexpr std::array<float, 4> kWeight0 = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float aa = 0.0f;
+  float ab = 0.0f;
+  float bb = 0.0f;
+  std::array<float, 3> ax{};
+  std::array<float, 3> bx{};
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const float a = kWeight0[indices[i]];
+    const float b = 1.0f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (int c = 0; c < 3; ++c) {
+      ax[c] += a * rgba[i * 4 + c];
+      bx[c] += b * rgba[i * 4 + c];
+    }
+  }
+  const float det = aa * bb - ab * ab;
+  if (std::fabs(det) < 1e-6f) {
+    return false;
+  }
+  const float inv = 1.0f / det;
+  for (int c = 0; c < 3; ++c) {
+    e0[c] = Clamp255((ax[c] * bb - bx[c] * ab) * inv);
+    e1[c] = Clamp255((bx[c] * aa - ax[c] * ab) * inv);
+  }
+  return true;
+}
+
+void WriteBC1(uint16_t c0, uint16_t c1, const std::array<uint8_t, kBlockPixels>& indices, uint8_t* out) {
+  // 4-color mode requires c0 > c1: swapping the endpoints swaps indices 0<->1 and 2<->3
+  uint32_t flip = 0;
+  if (c0 < c1) {
+    std::swap(c0, c1);
+    flip = 1;
+  }
+  uint32_t bits = 0;
+  for (int i = 0; i < kBlockPixels; ++i) {
+    // Equal endpoints: every entry decodes to the same color, index 0 avoids the 3-color mode entries
+    const uint32_t index = (c0 == c1) ? 0 : (indices[i] ^ flip);
+    bits |= index << (i * 2);
+  }
+  out[0] = static_cast<uint8_t>(c0);
+  out[1] = static_cast<uint8_t>(c0 >> 8);
+  out[2] = static_cast<uint8_t>(c1);
+  out[3] = static_cast<uint8_t>(c1 >> 8);
+  std::memcpy(out + 4, &bits, 4);
+}
+
+// ---- BC4 ----
+
+void EncodeSingleChannel(const uint8_t* rgba, uint32_t channel, uint8_t* out) {
+  int lo = 255;
+  int hi = 0;
+  for (int i = 0; i < kBlockPixels; ++i) {
+    lo = (std::min)(lo, static_cast<int>(rgba[i * 4 + channel]));
+    hi = (std::max)(hi, static_cast<int>(rgba[i * 4 + channel]));
+  }
+
+  out[0] = static_cast<uint8_t>(hi);
+  out[1] = static_cast<uint8_t>(lo);
+  uint64_t bits = 0;
+  if (hi != lo) {
+    // 8-value mode (a0 > a1): index 0 = a0, 1 = a1, 2..7 = (7 - k) / 7 blends from a0 toward a1
+    std::array<int, 8> values{};
+    values[0] = hi;
+    values[1] = lo;
+    for (int k = 1; k < 7; ++k) {
+      values[k + 1] = ((7 - k) * hi + k * lo) / 7;
+    }
+    for (int i = 0; i < kBlockPixels; ++i) {
+      const int value = rgba[i * 4 + channel];
+      uint64_t best = 0;
+      int best_error = INT32_MAX;
+      for (int k = 0; k < 8; ++k) {
+        const int error = std::abs(value - values[k]);
+        if (error < best_error) {
+          best_error = error;
+          best = static_cast<uint64_t>(k);
+        }
+      }
+      bits |= best << (i * 3);
+    }
+  }
+  for (int i = 0; i < 6; ++i) {
+    out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+  }
+}
+
+void DecodeSingleChannel(const uint8_t* block, uint8_t* values_out) {
+  const int a0 = block[0];
+  const int a1 = block[1];
+  std::array<int, 8> values{};
+  values[0] = a0;
+  values[1] = a1;
+  if (a0 > a1) {
+    for (int k = 1; k < 7; ++k) {
+      values[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+    }
+  } else {
+    for (int k = 1; k < 5; ++k) {
+      values[k + 1] = ((5 - k) * a0 + k * a1) / 5;
+    }
+    values[6] = 0;
+    values[7] = 255;
+  }
+  uint64_t bits = 0;
+  for (int i = 0; i < 6; ++i) {
+    bits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+  }
+  for (int i = 0; i < kBlockPixels; ++i) {
+    values_out[i] = static_cast<uint8_t>(values[(bits >> (i * 3)) & 7]);
+  }
+}
+
+// ---- BC7 mode 6 ----
+
+constexpr std::array<int, 16> kBC7Weights4 = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct BC7Endpoints {
+  std::array<int, 4> q0{};  // 7-bit
+  std::array<int, 4> q1{};
+  int p0 = 0;
+  int p1 = 0;
+};
+
+int BC7Interpolate(int e0, int e1, int weight) {
+  return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+}
+
+int QuantizeBC7(int value, int p_bit) {
+  return std::clamp((value - p_bit + 1) >> 1, 0, 127);
+}
+
+int ChooseBC7Indices(const uint8_t* rgba, const BC7Endpoints& ep, std::array<uint8_t, kBlockPixels>& indices) {
+  std::array<std::array<int, 4>, 16> palette{};
+  for (int c = 0; c < 4; ++c) {
+    const int e0 = (ep.q0[c] << 1) | ep.p0;
+    const int e1 = (ep.q1[c] << 1) | ep.p1;
+    for (int k = 0; k < 16; ++k) {
+      palette[k][c] = BC7Interpolate(e0, e1, kBC7Weights4[k]);
+    }
+  }
+
+  int total = 0;
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const uint8_t* p = rgba + i * 4;
+    int best = 0;
+    int best_error = INT32_MAX;
+    for (int k = 0; k < 16; ++k) {
+      int error = 0;
+      for (int c = 0; c < 4; ++c) {
+        const int d = p[c] - palette[k][c];
+        error += d * d;
+      }
+      if (error < best_error) {
+        best_error = error;
+        best = k;
+      }
+    }
+    indices[i] = static_cast<uint8_t>(best);
+    total += best_error;
+  }
+  return total;
+}
+
+// Quantize float endpoints trying all four p-bit combinations; keeps the best in ep / indices
+int FitBC7Endpoints(const uint8_t* rgba,
+  const std::array<int, 4>& e0,
+  const std::array<int, 4>& e1,
+  BC7Endpoints& ep,
+  std::array<uint8_t, kBlockPixels>& indices,
+  int best_error) {
+  for (int p0 = 0; p0 < 2; ++p0) {
+    for (int p1 = 0; p1 < 2; ++p1) {
+      BC7Endpoints candidate;
+      candidate.p0 = p0;
+      candidate.p1 = p1;
+      for (int c = 0; c < 4; ++c) {
+        candidate.q0[c] = QuantizeBC7(e0[c], p0);
+        candidate.q1[c] = QuantizeBC7(e1[c], p1);
+      }
+      std::array<uint8_t, kBlockPixels> candidate_indices{};
+      const int error = ChooseBC7Indices(rgba, candidate, candidate_indices);
+      if (error < best_error) {
+        best_error = error;
+        ep = candidate;
+        indices = candidate_indices;
+      }
+    }
+  }
+  return best_error;
+}
+
+void WriteBits(uint8_t* out, uint32_t& bit_pos, uint32_t value, uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i, ++bit_pos) {
+    if ((value >> i) & 1u) {
+      out[bit_pos >> 3] |= static_cast<uint8_t>(1u << (bit_pos & 7));
+    }
+  }
+}
+
+uint32_t ReadBits(const uint8_t* in, uint32_t& bit_pos, uint32_t count) {
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < count; ++i, ++bit_pos) {
+    value |= ((in[bit_pos >> 3] >> (bit_pos & 7)) & 1u) << i;
+  }
+  return value;
+}
+
+// ---- Image helpers ----
+
+// 4x4 block at (bx, by) with edge pixels repeated past the image bounds
+void GatherBlock(const Image& image, uint32_t bx, uint32_t by, uint8_t* rgba) {
+  for (uint32_t y = 0; y < 4; ++y) {
+    const uint32_t sy = (std::min)(by * 4 + y, image.height - 1);
+    for (uint32_t x = 0; x < 4; ++x) {
+      const uint32_t sx = (std::min)(bx * 4 + x, image.width - 1);
+      std::memcpy(rgba + (y * 4 + x) * 4, image.GetPixel(sx, sy), 4);
+    }
+  }
+}
+
+void EncodeBlock(BlockFormat format, const uint8_t* rgba, uint8_t* out) {
+  switch (format) {
+    case BlockFormat::BC1:
+      EncodeBC1Block(rgba, out);
+      break;
+    case BlockFormat::BC3:
+      EncodeBC3Block(rgba, out);
+      break;
+    case BlockFormat::BC4:
+      EncodeBC4Block(rgba, out);
+      break;
+    case BlockFormat::BC5:
+      EncodeBC5Block(rgba, out);
+      break;
+    case BlockFormat::BC7:
+      EncodeBC7Block(rgba, out);
+      break;
+  }
+}
+
+void CompressBlockRows(const Image& image, BlockFormat format, uint8_t* dst, size_t dst_row_pitch, uint32_t first_row, uint32_t end_row) {
+  const uint32_t blocks_x = (image.width + 3) / 4;
+  const uint32_t block_bytes = GetBlockBytes(format);
+  std::array<uint8_t, kBlockPixels * 4> rgba{};
+  for (uint32_t by = first_row; by < end_row; ++by) {
+    uint8_t* row = dst + by * dst_row_pitch;
+    for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+      GatherBlock(image, bx, by, rgba.data());
+      EncodeBlock(format, rgba.data(), row + bx * block_bytes);
+    }
+  }
+}
+}  // namespace
+
+uint32_t GetBlockBytes(BlockFormat format) {
+  return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+}
+
+void EncodeBC1Block(const uint8_t* rgba, uint8_t* out) {
+  std::array<std::array<float, 3>, kBlockPixels> points{};
+  for (int i = 0; i < kBlockPixels; ++i) {
+    for (int c = 0; c < 3; ++c) {
+      points[i][c] = rgba[i * 4 + c];
+    }
+  }
+  std::array<float, 3> mean{};
+  std::array<float, 3> axis{};
+  PrincipalAxis<3>(points, mean, axis);
+
+  // Extremes along the axis, inset slightly: the end points of a 4-entry palette rarely sit on outliers
+  float t_min = 0.0f;
+  float t_max = 0.0f;
+  for (const auto& p : points) {
+    const float t = (p[0] - mean[0]) * axis[0] + (p[1] - mean[1]) * axis[1] + (p[2] - mean[2]) * axis[2];
+    t_min = (std::min)(t_min, t);
+    t_max = (std::max)(t_max, t);
+  }
+  const float inset = (t_max - t_min) / 16.0f;
+  t_min += inset;
+  t_max -= inset;
+
+  std::array<int, 3> e0{};
+  std::array<int, 3> e1{};
+  for (int c = 0; c < 3; ++c) {
+    e0[c] = Clamp255(mean[c] + axis[c] * t_max);
+    e1[c] = Clamp255(mean[c] + axis[c] * t_min);
+  }
+
+  uint16_t c0 = Pack565(e0);
+  uint16_t c1 = Pack565(e1);
+  std::array<uint8_t, kBlockPixels> indices{};
+  int best_error = ChooseBC1Indices(rgba, c0, c1, indices);
+
+  for (int iteration = 0; iteration < 2 && best_error > 0; ++iteration) {
+    if (!RefineBC1Endpoints(rgba, indices, e0, e1)) {
+      break;
+    }
+    const uint16_t r0 = Pack565(e0);
+    const uint16_t r1 = Pack565(e1);
+    std::array<uint8_t, kBlockPixels> refined{};
+    const int error = ChooseBC1Indices(rgba, r0, r1, refined);
+    if (error >= best_error) {
+      break;
+    }
+    best_error = error;
+    c0 = r0;
+    c1 = r1;
+    indices = refined;
+  }
+
+  WriteBC1(c0, c1, indices, out);
+}
+
+void EncodeBC3Block(const uint8_t* rgba, uint8_t* out) {
+  EncodeSingleChannel(rgba, 3, out);
+  EncodeBC1Block(rgba, out + 8);
+}
+
+void EncodeBC4Block(const uint8_t* rgba, uint8_t* out, uint32_t channel) {
+  EncodeSingleChannel(rgba, channel, out);
+}
+
+void EncodeBC5Block(const uint8_t* rgba, uint8_t* out) {
+  EncodeSingleChannel(rgba, 0, out);
+  EncodeSingleChannel(rgba, 1, out + 8);
+}
+
+void EncodeBC7Block(const uint8_t* rgba, uint8_t* out) {
+  std::array<std::array<float, 4>, kBlockPixels> points{};
+  for (int i = 0; i < kBlockPixels; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      points[i][c] = rgba[i * 4 + c];
+    }
+  }
+  std::array<float, 4> mean{};
+  std::array<float, 4> axis{};
+  PrincipalAxis<4>(points, mean, axis);
+
+  float t_min = 0.0f;
+  float t_max = 0.0f;
+  for (const auto& p : points) {
+    float t = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+      t += (p[c] - mean[c]) * axis[c];
+    }
+    t_min = (std::min)(t_min, t);
+    t_max = (std::max)(t_max, t);
+  }
+
+  std::array<int, 4> e0{};
+  std::array<int, 4> e1{};
+  for (int c = 0; c < 4; ++c) {
+    e0[c] = Clamp255(mean[c] + axis[c] * t_min);
+    e1[c] = Clamp255(mean[c] + axis[c] * t_max);
+  }
+
+  BC7Endpoints ep;
+  std::array<uint8_t, kBlockPixels> indices{};
+  int best_error = FitBC7Endpoints(rgba, e0, e1, ep, indices, INT32_MAX);
+
+  // Least-squares refinement of the unquantized endpoints for the chosen indices
+  for (int iteration = 0; iteration < 2 && best_error > 0; ++iteration) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    std::array<float, 4> ax{};
+    std::array<float, 4> bx{};
+    for (int i = 0; i < kBlockPixels; ++i) {
+      const float b = kBC7Weights4[indices[i]] / 64.0f;
+      const float a = 1.0f - b;
+      aa += a * a;
+      ab += a * b;
+      bb += b * b;
+      for (int c = 0; c < 4; ++c) {
+        ax[c] += a * rgba[i * 4 + c];
+        bx[c] += b * rgba[i * 4 + c];
+      }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+      break;
+    }
+    const float inv = 1.0f / det;
+    for (int c = 0; c < 4; ++c) {
+      e0[c] = Clamp255((ax[c] * bb - bx[c] * ab) * inv);
+      e1[c] = Clamp255((bx[c] * aa - ax[c] * ab) * inv);
+    }
+    const int error = FitBC7Endpoints(rgba, e0, e1, ep, indices, best_error);
+    if (error >= best_error) {
+      break;
+    }
+    best_error = error;
+  }
+
+  // The anchor (pixel 0) index is stored without its top bit: make it < 8 by swapping the endpoints
+  if (indices[0] >= 8) {
+    std::swap(ep.q0, ep.q1);
+    std::swap(ep.p0, ep.p1);
+    for (uint8_t& index : indices) {
+      index = static_cast<uint8_t>(15 - index);
+    }
+  }
+
+  std::memset(out, 0, 16);
+  uint32_t bit_pos = 0;
+  WriteBits(out, bit_pos, 1u << 6, 7);  // Mode 6
+  for (int c = 0; c < 4; ++c) {
+    WriteBits(out, bit_pos, static_cast<uint32_t>(ep.q0[c]), 7);
+    WriteBits(out, bit_pos, static_cast<uint32_t>(ep.q1[c]), 7);
+  }
+  WriteBits(out, bit_pos, static_cast<uint32_t>(ep.p0), 1);
+  WriteBits(out, bit_pos, static_cast<uint32_t>(ep.p1), 1);
+  WriteBits(out, bit_pos, indices[0], 3);
+  for (int i = 1; i < kBlockPixels; ++i) {
+    WriteBits(out, bit_pos, indices[i], 4);
+  }
+}
+
+void DecodeBC1Block(const uint8_t* block, uint8_t* rgba) {
+  const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+  const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+  uint32_t bits = 0;
+  std::memcpy(&bits, block + 4, 4);
+
+  std::array<std::array<int, 4>, 4> palette{};
+  const std::array<int, 3> e0 = Unpack565(c0);
+  const std::array<int, 3> e1 = Unpack565(c1);
+  for (int c = 0; c < 3; ++c) {
+    palette[0][c] = e0[c];
+    palette[1][c] = e1[c];
+    if (c0 > c1) {
+      palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+      palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+    } else {
+      palette[2][c] = (e0[c] + e1[c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  palette[0][3] = palette[1][3] = palette[2][3] = 255;
+  palette[3][3] = (c0 > c1) ? 255 : 0;
+
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const auto& entry = palette[(bits >> (i * 2)) & 3];
+    for (int c = 0; c < 4; ++c) {
+      rgba[i * 4 + c] = static_cast<uint8_t>(entry[c]);
+    }
+  }
+}
+
+void DecodeBC3Block(const uint8_t* block, uint8_t* rgba) {
+  // The color half of BC2 / BC3 always uses the 4-color palette
+  const uint16_t c0 = static_cast<uint16_t>(block[8] | (block[9] << 8));
+  const uint16_t c1 = static_cast<uint16_t>(block[10] | (block[11] << 8));
+  const auto palette = BC1Palette(c0, c1);
+  uint32_t bits = 0;
+  std::memcpy(&bits, block + 12, 4);
+
+  std::array<uint8_t, kBlockPixels> alpha{};
+  DecodeSingleChannel(block, alpha.data());
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const auto& entry = palette[(bits >> (i * 2)) & 3];
+    rgba[i * 4 + 0] = static_cast<uint8_t>(entry[0]);
+    rgba[i * 4 + 1] = static_cast<uint8_t>(entry[1]);
+    rgba[i * 4 + 2] = static_cast<uint8_t>(entry[2]);
+    rgba[i * 4 + 3] = alpha[i];
+  }
+}
+
+void DecodeBC4Block(const uint8_t* block, uint8_t* rgba) {
+  std::array<uint8_t, kBlockPixels> values{};
+  DecodeSingleChannel(block, values.data());
+  for (int i = 0; i < kBlockPixels; ++i) {
+    rgba[i * 4 + 0] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = values[i];
+    rgba[i * 4 + 3] = 255;
+  }
+}
+
+void DecodeBC5Block(const uint8_t* block, uint8_t* rgba) {
+  std::array<uint8_t, kBlockPixels> red{};
+  std::array<uint8_t, kBlockPixels> green{};
+  DecodeSingleChannel(block, red.data());
+  DecodeSingleChannel(block + 8, green.data());
+  for (int i = 0; i < kBlockPixels; ++i) {
+    rgba[i * 4 + 0] = red[i];
+    rgba[i * 4 + 1] = green[i];
+    rgba[i * 4 + 2] = 0;
+    rgba[i * 4 + 3] = 255;
+  }
+}
+
+bool DecodeBC7Block(const uint8_t* block, uint8_t* rgba) {
+  if ((block[0] & 0x7F) != (1u << 6)) {
+    for (int i = 0; i < kBlockPixels; ++i) {
+      rgba[i * 4 + 0] = 255;
+      rgba[i * 4 + 1] = 0;
+      rgba[i * 4 + 2] = 255;
+      rgba[i * 4 + 3] = 255;
+    }
+    return false;
+  }
+
+  uint32_t bit_pos = 7;
+  std::array<int, 4> q0{};
+  std::array<int, 4> q1{};
+  for (int c = 0; c < 4; ++c) {
+    q0[c] = static_cast<int>(ReadBits(block, bit_pos, 7));
+    q1[c] = static_cast<int>(ReadBits(block, bit_pos, 7));
+  }
+  const int p0 = static_cast<int>(ReadBits(block, bit_pos, 1));
+  const int p1 = static_cast<int>(ReadBits(block, bit_pos, 1));
+  for (int i = 0; i < kBlockPixels; ++i) {
+    const uint32_t index = ReadBits(block, bit_pos, (i == 0) ? 3 : 4);
+    for (int c = 0; c < 4; ++c) {
+      rgba[i * 4 + c] = static_cast<uint8_t>(BC7Interpolate((q0[c] << 1) | p0, (q1[c] << 1) | p1, kBC7Weights4[index]));
+    }
+  }
+  return true;
+}
+
+void CompressImage(const Image& image, BlockFormat format, uint8_t* dst, size_t dst_row_pitch, ThreadPool* pool) {
+  const uint32_t blocks_y = (image.height + 3) / 4;
+  const uint32_t band_count = (pool != nullptr) ? (std::min)(blocks_y, pool->GetWorkerCount() * 4) : 0;
+  if (band_count <= 1) {
+    CompressBlockRows(image, format, dst, dst_row_pitch, 0, blocks_y);
+    return;
+  }
+
+  std::latch done(band_count);
+  for (uint32_t band = 0; band < band_count; ++band) {
+    const uint32_t first_row = blocks_y * band / band_count;
+    const uint32_t end_row = blocks_y * (band + 1) / band_count;
+    pool->Submit([&image, format, dst, dst_row_pitch, first_row, end_row, &done] {
+      CompressBlockRows(image, format, dst, dst_row_pitch, first_row, end_row);
+      done.count_down();
+    });
+  }
+  done.wait();
+}
+
+void DecompressImage(const uint8_t* src, size_t src_row_pitch, BlockFormat format, uint32_t width, uint32_t height, Image& out_image) {
+  out_image.Resize(width, height);
+  const uint32_t blocks_x = (width + 3) / 4;
+  const uint32_t blocks_y = (height + 3) / 4;
+  const uint32_t block_bytes = GetBlockBytes(format);
+  std::array<uint8_t, kBlockPixels * 4> rgba{};
+
+  for (uint32_t by = 0; by < blocks_y; ++by) {
+    for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+      const uint8_t* block = src + by * src_row_pitch + bx * block_bytes;
+      switch (format) {
+        case BlockFormat::BC1:
+          DecodeBC1Block(block, rgba.data());
+          break;
+        case BlockFormat::BC3:
+          DecodeBC3Block(block, rgba.data());
+          break;
+        case BlockFormat::BC4:
+          DecodeBC4Block(block, rgba.data());
+          break;
+        case BlockFormat::BC5:
+          DecodeBC5Block(block, rgba.data());
+          break;
+        case BlockFormat::BC7:
+          DecodeBC7Block(block, rgba.data());
+          break;
+      }
+      for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+        for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+          std::memcpy(out_image.GetPixel(bx * 4 + x, by * 4 + y), rgba.data() + (y * 4 + x) * 4, 4);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image.h"
+
+class ThreadPool;
+
+// Block compression (BCn) encoders and reference decoders for 4x4 blocks of 8-bit RGBA.
+// Blocks are 64-byte row-major RGBA inputs / outputs.
+//
+// BC1   RGB, 4-color mode only (alpha ignored).  8 bytes
+// BC3   BC1 color + BC4 alpha.                   16 bytes
+// BC4   One channel (R).                          8 bytes
+// BC5   Two channels (R, G), e.g. normal XY.    16 bytes
+// BC7   Mode 6 only (single subset RGBA, 7.7.7.7 endpoints with p-bits, 4-bit indices). Every mode 6
+//       block is a valid BC7 block; the other modes are neither produced nor decoded here.
+//
+// Encoders fit endpoints along the principal axis of the block and refine them by least squares.
+enum class BlockFormat : uint8_t { BC1, BC3, BC4, BC5, BC7 };
+
+uint32_t GetBlockBytes(BlockFormat format);
+
+void EncodeBC1Block(const uint8_t* rgba, uint8_t* out);
+void EncodeBC3Block(const uint8_t* rgba, uint8_t* out);
+void EncodeBC4Block(const uint8_t* rgba, uint8_t* out, uint32_t channel = 0);
+void EncodeBC5Block(const uint8_t* rgba, uint8_t* out);
+void EncodeBC7Block(const uint8_t* rgba, uint8_t* out);
+
+void DecodeBC1Block(const uint8_t* block, uint8_t* rgba);
+void DecodeBC3Block(const uint8_t* block, uint8_t* rgba);
+void DecodeBC4Block(const uint8_t* block, uint8_t* rgba);  // R = G = B = value, A = 255
+void DecodeBC5Block(const uint8_t* block, uint8_t* rgba);  // B = 0, A = 255
+bool DecodeBC7Block(const uint8_t* block, uint8_t* rgba);  // false (and magenta) for modes other than 6
+
+// Compress a whole image into rows of blocks (dst_row_pitch bytes apart). Partial edge blocks repeat the
+// last row / column. With a pool, bands of block rows are encoded on its workers (do not call from a job).
+void CompressImage(const Image& image, BlockFormat format, uint8_t* dst, size_t dst_row_pitch, ThreadPool* pool = nullptr);
+
+// Inverse of CompressImage (for verification and tools)
+void DecompressImage(const uint8_t* src, size_t src_row_pitch, BlockFormat format, uint32_t width, uint32_t height, Image& out_image);
@@ -0,0 +1,516 @@
+#include "cooked_mesh.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+
+#include "mesh_optimizer.h"
+#include "profiler.h"
+
+namespace {
+constexpr float kOctahedralScale = 32767.0f;
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+float SignNotZero(float value) {
+  return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+void Normalize(float v[3]) {
+  const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  if (length > 0.0f) {
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+  } else {
+    v[0] = 0.0f;
+    v[1] = 0.0f;
+    v[2] = 1.0f;
+  }
+}
+
+// Area-weighted normals shared by every vertex at the same position, so hard edges from split texcoords
+// do not show up as shading seams
+void GenerateSmoothNormals(const MeshSourceSubmesh& submesh, std::vector<float>& out_normals) {
+  const size_t vertex_count = submesh.GetVertexCount();
+  std::vector<uint32_t> position_ids;
+  const size_t position_count = WeldVertices(submesh.positions.data(), vertex_count, 3 * sizeof(float), position_ids);
+
+  std::vector<float> accumulated(position_count * 3, 0.0f);
+  for (size_t i = 0; i + 2 < submesh.indices.size(); i += 3) {
+    const float* a = &submesh.positions[submesh.indices[i] * 3];
+    const float* b = &submesh.positions[submesh.indices[i + 1] * 3];
+    const float* c = &submesh.positions[submesh.indices[i + 2] * 3];
+    const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    // Clockwise front faces in a left-handed space: ab x ac points out of the front face
+    const float normal[3] = {ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0]};
+    for (size_t k = 0; k < 3; ++k) {
+      float* sum = &accumulated[position_ids[submesh.indices[i + k]] * 3];
+      sum[0] += normal[0];
+      sum[1] += normal[1];
+      sum[2] += normal[2];
+    }
+  }
+
+  out_normals.resize(vertex_count * 3);
+  for (size_t v = 0; v < vertex_count; ++v) {
+    float* normal = &out_normals[v * 3];
+    std::memcpy(normal, &accumulated[position_ids[v] * 3], 3 * sizeof(float));
+    Normalize(normal);
+  }
+}
+
+uint16_t QuantizeUnorm16(float value, float offset, float scale) {
+  if (scale <= 0.0f) {
+    return 0;
+  }
+  const float q = std::round((value - offset) / scale);
+  return static_cast<uint16_t>(std::clamp(q, 0.0f, 65535.0f));
+}
+
+// Cache and fetch figures summed over submeshes, so the ratios come out weighted by their sizes
+struct AnalysisTotals {
+  double misses = 0.0;
+  double fetched_bytes = 0.0;
+
+  void Add(const std::vector<uint32_t>& indices, size_t vertex_count) {
+    const VertexCacheStats cache = AnalyzeVertexCache(indices.data(), indices.size(), vertex_count);
+    misses += static_cast<double>(cache.acmr) * static_cast<double>(indices.size() / 3);
+    const float overfetch = AnalyzeVertexFetch(indices.data(), indices.size(), vertex_count, sizeof(CookedMeshVertex));
+    fetched_bytes += static_cast<double>(overfetch) * static_cast<double>(vertex_count * sizeof(CookedMeshVertex));
+  }
+};
+}  // namespace
+
+uint16_t FloatToHalf(float value) {
+  uint32_t bits = std::bit_cast<uint32_t>(value);
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7FFFFFFFu;
+
+  uint32_t half;
+  if (bits >= 0x47800000u) {
+    half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;  // NaN, or too large for half: infinity
+  } else if (bits < 0x38800000u) {
+    // Subnormal half: adding 0.5 lines the mantissa up so the FPU rounds it to nearest even
+    constexpr uint32_t kDenormMagic = 126u << 23;
+    const float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(kDenormMagic);
+    half = std::bit_cast<uint32_t>(shifted) - kDenormMagic;
+  } else {
+    const uint32_t mantissa_odd = (bits >> 13) & 1u;
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + mantissa_odd;
+    half = bits >> 13;
+  }
+  return static_cast<uint16_t>(half | sign);
+}
+
+float HalfToFloat(uint16_t value) {
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1Fu;
+  const uint32_t mantissa = value & 0x3FFu;
+  if (exponent == 0) {
+    const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -magnitude : magnitude;
+  }
+  if (exponent == 31) {
+    return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+  }
+  return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void EncodeOctahedralNormal(const float normal[3], int16_t out_encoded[2]) {
+  const float l1 = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+  float u = l1 > 0.0f ? normal[0] / l1 : 0.0f;
+  float v = l1 > 0.0f ? normal[1] / l1 : 0.0f;
+  if (l1 > 0.0f && normal[2] < 0.0f) {
+    // Fold the lower hemisphere over the diagonals
+    const float folded_u = (1.0f - std::abs(v)) * SignNotZero(u);
+    const float folded_v = (1.0f - std::abs(u)) * SignNotZero(v);
+    u = folded_u;
+    v = folded_v;
+  }
+
+  // Of the four neighbouring grid points, keep the one that decodes closest to the normal
+  float unit[3] = {normal[0], normal[1], normal[2]};
+  Normalize(unit);
+  const float base_u = std::floor(u * kOctahedralScale);
+  const float base_v = std::floor(v * kOctahedralScale);
+  float best_dot = -2.0f;
+  for (int corner = 0; corner < 4; ++corner) {
+    const int16_t candidate[2] = {
+      static_cast<int16_t>(std::clamp(base_u + static_cast<float>(corner & 1), -kOctahedralScale, kOctahedralScale)),
+      static_cast<int16_t>(std::clamp(base_v + static_cast<float>(corner >> 1), -kOctahedralScale, kOctahedralScale)),
+    };
+    float decoded[3];
+    DecodeOctahedralNormal(candidate, decoded);
+    const float dot = decoded[0] * unit[0] + decoded[1] * unit[1] + decoded[2] * unit[2];
+    if (dot > best_dot) {
+      best_dot = dot;
+      out_encoded[0] = candidate[0];
+      out_encoded[1] = candidate[1];
+    }
+  }
+}
+
+void DecodeOctahedralNormal(const int16_t encoded[2], float out_normal[3]) {
+  // Same mapping as an R16G16_SNORM fetch
+  const float u = (std::max)(static_cast<float>(encoded[0]) / kOctahedralScale, -1.0f);
+  const float v = (std::max)(static_cast<float>(encoded[1]) / kOctahedralScale, -1.0f);
+  out_normal[2] = 1.0f - std::abs(u) - std::abs(v);
+  if (out_normal[2] < 0.0f) {
+    out_normal[0] = (1.0f - std::abs(v)) * SignNotZero(u);
+    out_normal[1] = (1.0f - std::abs(u)) * SignNotZero(v);
+  } else {
+    out_normal[0] = u;
+    out_normal[1] = v;
+  }
+  Normalize(out_normal);
+}
+
+void DequantizePosition(const CookedMeshHeader& header, const CookedMeshVertex& vertex, float out_position[3]) {
+  for (size_t axis = 0; axis < 3; ++axis) {
+    out_position[axis] = header.position_offset[axis] + static_cast<float>(vertex.position[axis]) * header.position_scale[axis];
+  }
+}
+
+namespace {
+std::vector<float> DequantizePositions(const CookedMeshHeader& header, const std::vector<CookedMeshVertex>& vertices) {
+  std::vector<float> positions(vertices.size() * 3);
+  for (size_t v = 0; v < vertices.size(); ++v) {
+    DequantizePosition(header, vertices[v], &positions[v * 3]);
+  }
+  return positions;
+}
+
+// Re-run the cache optimizer inside one meshlet on local vertex ids, since the meshlet builder picks
+// triangles by locality rather than by cache score
+void OptimizeMeshletVertexCache(uint32_t* indices, uint32_t triangle_count, std::vector<uint32_t>& local_ids) {
+  std::vector<uint32_t> global_ids;
+  std::vector<uint32_t> local_indices(static_cast<size_t>(triangle_count) * 3);
+  for (size_t i = 0; i < local_indices.size(); ++i) {
+    uint32_t& local = local_ids[indices[i]];
+    if (local == ~0u) {
+      local = static_cast<uint32_t>(global_ids.size());
+      global_ids.push_back(indices[i]);
+    }
+    local_indices[i] = local;
+  }
+  OptimizeVertexCache(local_indices.data(), local_indices.size(), global_ids.size());
+  for (size_t i = 0; i < local_indices.size(); ++i) {
+    indices[i] = global_ids[local_indices[i]];
+  }
+  for (uint32_t global : global_ids) {
+    local_ids[global] = ~0u;
+  }
+}
+}  // namespace
+
+bool ParseCookedMesh(const uint8_t* bytes, size_t size, CookedMeshView& out_view) {
+  if (bytes == nullptr || size < sizeof(CookedMeshHeader)) {
+    std::cerr << "[CookedMesh] File too small for a header" << '\n';
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const CookedMeshHeader*>(bytes);
+  if (header->magic != kCookedMeshMagic || header->version != kCookedMeshVersion) {
+    std::cerr << "[CookedMesh] Not a version " << kCookedMeshVersion << " cooked mesh" << '\n';
+    return false;
+  }
+  if (header->vertex_stride != sizeof(CookedMeshVertex) || header->submesh_count == 0 || header->index_count % 3 != 0) {
+    std::cerr << "[CookedMesh] Invalid header" << '\n';
+    return false;
+  }
+
+  const uint64_t table_end = sizeof(CookedMeshHeader) + static_cast<uint64_t>(header->submesh_count) * sizeof(CookedMeshSubmesh);
+  const uint64_t meshlet_bytes = static_cast<uint64_t>(header->meshlet_count) * sizeof(CookedMeshMeshlet);
+  const uint64_t vertex_bytes = static_cast<uint64_t>(header->vertex_count) * header->vertex_stride;
+  const uint32_t index_size = (header->flags & kCookedMeshFlagIndex32) != 0 ? 4 : 2;
+  const uint64_t index_bytes = static_cast<uint64_t>(header->index_count) * index_size;
+  if (header->meshlet_count > 0 && (header->meshlet_offset < table_end || header->meshlet_offset > header->vertex_offset ||
+                                    meshlet_bytes > header->vertex_offset - header->meshlet_offset)) {
+    std::cerr << "[CookedMesh] Meshlet table out of bounds" << '\n';
+    return false;
+  }
+  if (table_end > size || header->vertex_offset < table_end || header->vertex_offset > size ||
+      vertex_bytes > size - header->vertex_offset || header->index_offset < header->vertex_offset + vertex_bytes ||
+      header->index_offset > size || index_bytes > size - header->index_offset) {
+    std::cerr << "[CookedMesh] Data out of bounds" << '\n';
+    return false;
+  }
+
+  const auto* submeshes = reinterpret_cast<const CookedMeshSubmesh*>(bytes + sizeof(CookedMeshHeader));
+  const auto* meshlets = header->meshlet_count > 0 ? reinterpret_cast<const CookedMeshMeshlet*>(bytes + header->meshlet_offset) : nullptr;
+  for (uint32_t i = 0; i < header->submesh_count; ++i) {
+    const CookedMeshSubmesh& submesh = submeshes[i];
+    if (submesh.index_count % 3 != 0 || submesh.first_index > header->index_count ||
+        submesh.index_count > header->index_count - submesh.first_index || submesh.base_vertex > header->vertex_count ||
+        submesh.vertex_count > header->vertex_count - submesh.base_vertex || submesh.first_meshlet > header->meshlet_count ||
+        submesh.meshlet_count > header->meshlet_count - submesh.first_meshlet) {
+      std::cerr << "[CookedMesh] Submesh " << i << " out of bounds" << '\n';
+      return false;
+    }
+    // Meshlets must stay inside their submesh's index range, since they are drawn with its base vertex
+    const uint64_t submesh_end = static_cast<uint64_t>(submesh.first_index) + submesh.index_count;
+    for (uint32_t m = submesh.first_meshlet; m < submesh.first_meshlet + submesh.meshlet_count; ++m) {
+      const uint64_t meshlet_end = static_cast<uint64_t>(meshlets[m].first_index) + meshlets[m].triangle_count * 3ull;
+      if (meshlets[m].first_index < submesh.first_index || meshlet_end > submesh_end) {
+        std::cerr << "[CookedMesh] Meshlet " << m << " out of bounds" << '\n';
+        return false;
+      }
+    }
+  }
+
+  out_view.header = header;
+  out_view.submeshes = submeshes;
+  out_view.meshlets = meshlets;
+  out_view.vertices = reinterpret_cast<const CookedMeshVertex*>(bytes + header->vertex_offset);
+  out_view.indices = bytes + header->index_offset;
+  return true;
+}
+
+bool CookMesh(const MeshSource& source, const CookMeshOptions& options, std::vector<uint8_t>& out_file, CookMeshStats* out_stats) {
+  PROFILE_SCOPE("CookMesh");
+
+  CookMeshStats stats;
+  float bounds_min[3] = {INFINITY, INFINITY, INFINITY};
+  float bounds_max[3] = {-INFINITY, -INFINITY, -INFINITY};
+  for (const MeshSourceSubmesh& submesh : source.submeshes) {
+    const size_t vertex_count = submesh.GetVertexCount();
+    if (submesh.indices.size() % 3 != 0 || (!submesh.normals.empty() && submesh.normals.size() != vertex_count * 3) ||
+        (!submesh.texcoords.empty() && submesh.texcoords.size() != vertex_count * 2)) {
+      std::cerr << "[CookedMesh] Submesh attribute counts do not match" << '\n';
+      return false;
+    }
+    for (uint32_t index : submesh.indices) {
+      if (index >= vertex_count) {
+        std::cerr << "[CookedMesh] Index " << index << " out of range (" << vertex_count << " vertices)" << '\n';
+        return false;
+      }
+    }
+    for (size_t i = 0; i < submesh.positions.size(); ++i) {
+      if (!std::isfinite(submesh.positions[i])) {
+        std::cerr << "[CookedMesh] Non-finite vertex position" << '\n';
+        return false;
+      }
+      bounds_min[i % 3] = (std::min)(bounds_min[i % 3], submesh.positions[i]);
+      bounds_max[i % 3] = (std::max)(bounds_max[i % 3], submesh.positions[i]);
+    }
+    stats.source_vertices += vertex_count;
+  }
+  if (source.submeshes.empty() || stats.source_vertices == 0) {
+    std::cerr << "[CookedMesh] Source has no vertices" << '\n';
+    return false;
+  }
+
+  CookedMeshHeader header = {};
+  header.magic = kCookedMeshMagic;
+  header.version = kCookedMeshVersion;
+  header.vertex_stride = sizeof(CookedMeshVertex);
+  header.submesh_count = static_cast<uint32_t>(source.submeshes.size());
+  for (size_t axis = 0; axis < 3; ++axis) {
+    header.position_offset[axis] = bounds_min[axis];
+    // Flat axes still get a non-zero step, so the dequantization transform stays invertible
+    const float extent = bounds_max[axis] - bounds_min[axis];
+    header.position_scale[axis] = (extent > 0.0f ? extent : 1.0f) / 65535.0f;
+    header.bounds_min[axis] = bounds_min[axis];
+    header.bounds_max[axis] = bounds_max[axis];
+  }
+
+  std::vector<CookedMeshSubmesh> submeshes(source.submeshes.size());
+  std::vector<CookedMeshMeshlet> meshlets;
+  std::vector<CookedMeshVertex> vertices;
+  std::vector<uint32_t> indices;
+  AnalysisTotals before;
+  AnalysisTotals after;
+  bool needs_index32 = options.force_index32;
+
+  for (size_t s = 0; s < source.submeshes.size(); ++s) {
+    const MeshSourceSubmesh& submesh = source.submeshes[s];
+    const size_t source_count = submesh.GetVertexCount();
+
+    std::vector<float> generated_normals;
+    const std::vector<float>* normals = &submesh.normals;
+    if (submesh.normals.empty()) {
+      GenerateSmoothNormals(submesh, generated_normals);
+      normals = &generated_normals;
+      stats.generated_normals = true;
+    }
+
+    // 1) Quantize every source vertex, measuring what the encoding loses
+    std::vector<CookedMeshVertex> quantized(source_count);
+    for (size_t v = 0; v < source_count; ++v) {
+      CookedMeshVertex& vertex = quantized[v];
+      const float* position = &submesh.positions[v * 3];
+      for (size_t axis = 0; axis < 3; ++axis) {
+        vertex.position[axis] = QuantizeUnorm16(position[axis], header.position_offset[axis], header.position_scale[axis]);
+      }
+      vertex.position[3] = 0;
+
+      float normal[3];
+      std::memcpy(normal, &(*normals)[v * 3], sizeof(normal));
+      Normalize(normal);
+      EncodeOctahedralNormal(normal, vertex.normal);
+
+      const float texcoord[2] = {
+        submesh.texcoords.empty() ? 0.0f : submesh.texcoords[v * 2],
+        submesh.texcoords.empty() ? 0.0f : submesh.texcoords[v * 2 + 1],
+      };
+      vertex.texcoord[0] = FloatToHalf(texcoord[0]);
+      vertex.texcoord[1] = FloatToHalf(texcoord[1]);
+
+      float decoded_position[3];
+      DequantizePosition(header, vertex, decoded_position);
+      float decoded_normal[3];
+      DecodeOctahedralNormal(vertex.normal, decoded_normal);
+      const float dot = normal[0] * decoded_normal[0] + normal[1] * decoded_normal[1] + normal[2] * decoded_normal[2];
+      const float angle = std::acos(std::clamp(dot, -1.0f, 1.0f)) * 180.0f / std::numbers::pi_v<float>;
+      stats.max_normal_error = (std::max)(stats.max_normal_error, angle);
+      for (size_t axis = 0; axis < 3; ++axis) {
+        stats.max_position_error = (std::max)(stats.max_position_error, std::abs(decoded_position[axis] - position[axis]));
+      }
+      for (size_t k = 0; k < 2; ++k) {
+        stats.max_texcoord_error = (std::max)(stats.max_texcoord_error, std::abs(HalfToFloat(vertex.texcoord[k]) - texcoord[k]));
+      }
+    }
+
+    // 2) Weld on the quantized bytes: vertices that became identical after quantization merge too
+    std::vector<uint32_t> remap;
+    const size_t welded_count = WeldVertices(quantized.data(), source_count, sizeof(CookedMeshVertex), remap);
+    std::vector<CookedMeshVertex> welded(welded_count);
+    RemapVertices(quantized.data(), source_count, sizeof(CookedMeshVertex), remap, welded.data());
+
+    std::vector<uint32_t> submesh_indices(submesh.indices.size());
+    for (size_t i = 0; i < submesh.indices.size(); ++i) {
+      submesh_indices[i] = remap[submesh.indices[i]];
+    }
+    const size_t kept_count = RemoveDegenerateTriangles(submesh_indices.data(), submesh_indices.size());
+    stats.degenerate_triangles += (submesh_indices.size() - kept_count) / 3;
+    submesh_indices.resize(kept_count);
+    before.Add(submesh_indices, welded_count);
+
+    // 3) Triangle order for the post-transform cache, then meshlets (each re-optimized for the cache on its
+    // own), then vertex order for fetch locality. The fetch pass renames vertices without moving triangles,
+    // so meshlet index ranges stay valid.
+    if (options.optimize_vertex_cache) {
+      OptimizeVertexCache(submesh_indices.data(), submesh_indices.size(), welded_count);
+    }
+    std::vector<Meshlet> submesh_meshlets;
+    if (options.build_meshlets) {
+      const std::vector<float> positions = DequantizePositions(header, welded);
+      BuildMeshlets(submesh_indices.data(),
+        submesh_indices.size(),
+        positions.data(),
+        welded_count,
+        submesh_meshlets,
+        options.meshlet_max_vertices,
+        options.meshlet_max_triangles);
+      if (options.optimize_vertex_cache) {
+        std::vector<uint32_t> local_ids(welded_count, ~0u);
+        for (const Meshlet& meshlet : submesh_meshlets) {
+          OptimizeMeshletVertexCache(&submesh_indices[meshlet.first_index], meshlet.triangle_count, local_ids);
+        }
+      }
+    }
+    size_t vertex_count = welded_count;
+    std::vector<CookedMeshVertex> ordered;
+    if (options.optimize_vertex_fetch) {
+      vertex_count = OptimizeVertexFetch(submesh_indices.data(), submesh_indices.size(), welded_count, remap);
+      ordered.resize(vertex_count);
+      RemapVertices(welded.data(), welded_count, sizeof(CookedMeshVertex), remap, ordered.data());
+    } else {
+      ordered = std::move(welded);
+    }
+    after.Add(submesh_indices, vertex_count);
+
+    CookedMeshSubmesh& out_submesh = submeshes[s];
+    out_submesh = {};
+    out_submesh.first_index = static_cast<uint32_t>(indices.size());
+    out_submesh.index_count = static_cast<uint32_t>(submesh_indices.size());
+    out_submesh.base_vertex = static_cast<uint32_t>(vertices.size());
+    out_submesh.vertex_count = static_cast<uint32_t>(vertex_count);
+    out_submesh.material_index = submesh.material_index;
+    out_submesh.first_meshlet = static_cast<uint32_t>(meshlets.size());
+    out_submesh.meshlet_count = static_cast<uint32_t>(submesh_meshlets.size());
+    for (size_t axis = 0; axis < 3; ++axis) {
+      out_submesh.bounds_min[axis] = INFINITY;
+      out_submesh.bounds_max[axis] = -INFINITY;
+    }
+    for (size_t i = 0; i < submesh.positions.size(); ++i) {
+      out_submesh.bounds_min[i % 3] = (std::min)(out_submesh.bounds_min[i % 3], submesh.positions[i]);
+      out_submesh.bounds_max[i % 3] = (std::max)(out_submesh.bounds_max[i % 3], submesh.positions[i]);
+    }
+    needs_index32 = needs_index32 || vertex_count > 65536;
+
+    // Meshlet bounds from the final (quantized) positions, so they enclose exactly what the GPU draws
+    if (!submesh_meshlets.empty()) {
+      const std::vector<float> positions = DequantizePositions(header, ordered);
+      for (const Meshlet& meshlet : submesh_meshlets) {
+        const MeshletBounds bounds = ComputeMeshletBounds(&submesh_indices[meshlet.first_index], meshlet.triangle_count, positions.data());
+        CookedMeshMeshlet& out_meshlet = meshlets.emplace_back();
+        out_meshlet = {};
+        out_meshlet.first_index = out_submesh.first_index + meshlet.first_index;
+        out_meshlet.triangle_count = meshlet.triangle_count;
+        out_meshlet.vertex_count = meshlet.vertex_count;
+        std::copy(std::begin(bounds.center), std::end(bounds.center), out_meshlet.center);
+        out_meshlet.radius = bounds.radius;
+        std::copy(std::begin(bounds.cone_axis), std::end(bounds.cone_axis), out_meshlet.cone_axis);
+        out_meshlet.cone_cutoff = bounds.cone_cutoff;
+        stats.meshlet_vertices += meshlet.vertex_count;
+      }
+    }
+
+    vertices.insert(vertices.end(), ordered.begin(), ordered.end());
+    indices.insert(indices.end(), submesh_indices.begin(), submesh_indices.end());
+  }
+  if (indices.empty()) {
+    std::cerr << "[CookedMesh] No triangles left after removing degenerate ones" << '\n';
+    return false;
+  }
+
+  header.flags = needs_index32 ? kCookedMeshFlagIndex32 : 0;
+  header.vertex_count = static_cast<uint32_t>(vertices.size());
+  header.index_count = static_cast<uint32_t>(indices.size());
+  header.meshlet_count = static_cast<uint32_t>(meshlets.size());
+  const size_t index_size = needs_index32 ? sizeof(uint32_t) : sizeof(uint16_t);
+  header.meshlet_offset = sizeof(CookedMeshHeader) + submeshes.size() * sizeof(CookedMeshSubmesh);
+  header.vertex_offset = AlignUp(header.meshlet_offset + meshlets.size() * sizeof(CookedMeshMeshlet), kCookedMeshDataAlignment);
+  header.index_offset = AlignUp(header.vertex_offset + vertices.size() * sizeof(CookedMeshVertex), kCookedMeshDataAlignment);
+
+  out_file.assign(header.index_offset + indices.size() * index_size, 0);
+  std::memcpy(out_file.data(), &header, sizeof(header));
+  std::memcpy(out_file.data() + sizeof(header), submeshes.data(), submeshes.size() * sizeof(CookedMeshSubmesh));
+  if (!meshlets.empty()) {
+    std::memcpy(out_file.data() + header.meshlet_offset, meshlets.data(), meshlets.size() * sizeof(CookedMeshMeshlet));
+  }
+  std::memcpy(out_file.data() + header.vertex_offset, vertices.data(), vertices.size() * sizeof(CookedMeshVertex));
+  if (needs_index32) {
+    std::memcpy(out_file.data() + header.index_offset, indices.data(), indices.size() * sizeof(uint32_t));
+  } else {
+    auto* dst = reinterpret_cast<uint16_t*>(out_file.data() + header.index_offset);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      dst[i] = static_cast<uint16_t>(indices[i]);
+    }
+  }
+
+  if (out_stats != nullptr) {
+    stats.vertices = vertices.size();
+    stats.triangles = indices.size() / 3;
+    stats.meshlets = meshlets.size();
+    const double triangles = static_cast<double>((std::max)(stats.triangles, size_t{1}));
+    const double vertex_count = static_cast<double>((std::max)(stats.vertices, size_t{1}));
+    const double vertex_bytes = vertex_count * sizeof(CookedMeshVertex);
+    stats.acmr_before = static_cast<float>(before.misses / triangles);
+    stats.acmr_after = static_cast<float>(after.misses / triangles);
+    stats.atvr_before = static_cast<float>(before.misses / vertex_count);
+    stats.atvr_after = static_cast<float>(after.misses / vertex_count);
+    stats.overfetch_before = static_cast<float>(before.fetched_bytes / vertex_bytes);
+    stats.overfetch_after = static_cast<float>(after.fetched_bytes / vertex_bytes);
+    *out_stats = stats;
+  }
+  return true;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_import.h"
+#include "meshlet.h"
+
+// Cooked mesh container (.cmsh): welded, cache-optimized and quantized triangle lists written by
+// tools/mesh_cooker and memory-mapped by the runtime loader.
+//
+//   [CookedMeshHeader][CookedMeshSubmesh x submesh_count][CookedMeshMeshlet x meshlet_count][padding]
+//   [vertex data][padding][index data]
+//
+// Vertex and index data start at kCookedMeshDataAlignment-aligned file offsets and are laid out as the
+// GPU reads them, so the loader copies each block into upload memory with one memcpy. Submeshes own
+// contiguous index and vertex ranges; indices are relative to the submesh's base_vertex, which is what
+// keeps 16-bit indices usable for meshes with more than 65536 vertices in total. When meshlets are built,
+// each submesh's index range is ordered meshlet by meshlet, so every meshlet is a contiguous index range
+// (drawable as an indexed sub-draw) with bounds for frustum and backface-cone culling.
+// The format is little-endian, fixed-layout records.
+
+constexpr uint32_t kCookedMeshMagic = 0x48534D43;  // "CMSH"
+constexpr uint32_t kCookedMeshVersion = 2;
+constexpr uint32_t kCookedMeshDataAlignment = 256;
+
+constexpr uint32_t kCookedMeshFlagIndex32 = 1u << 0;  // Indices are uint32_t, otherwise uint16_t
+
+// 16 bytes per vertex (R16G16B16A16_UNORM, R16G16_SNORM, R16G16_FLOAT):
+// position is quantized over the mesh bounds (local = position_offset + position * position_scale, with
+// position read as 0..65535), the normal is octahedral-encoded and texcoords are half floats.
+struct CookedMeshVertex {
+  uint16_t position[4];  // w is unused (0)
+  int16_t normal[2];
+  uint16_t texcoord[2];
+};
+static_assert(sizeof(CookedMeshVertex) == 16, "CookedMeshVertex layout is part of the file format");
+
+struct CookedMeshHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t flags;
+  uint32_t vertex_stride;
+  uint32_t vertex_count;
+  uint32_t index_count;
+  uint32_t submesh_count;
+  uint32_t meshlet_count;    // 0 when cooked without meshlets
+  float position_offset[3];  // Dequantization: local = offset + unorm16 * scale (per axis, scale in units per step)
+  float position_scale[3];
+  float bounds_min[3];       // Local-space AABB of all submeshes
+  float bounds_max[3];
+  uint64_t vertex_offset;    // File offset of the vertex data
+  uint64_t index_offset;     // File offset of the index data
+  uint64_t meshlet_offset;   // File offset of the meshlet table
+};
+static_assert(sizeof(CookedMeshHeader) == 104, "CookedMeshHeader layout is part of the file format");
+
+struct CookedMeshSubmesh {
+  uint32_t first_index;
+  uint32_t index_count;
+  uint32_t base_vertex;
+  uint32_t vertex_count;
+  uint32_t material_index;  // Index into the source's material names (0 when it has none)
+  uint32_t first_meshlet;
+  uint32_t meshlet_count;
+  uint32_t reserved;
+  float bounds_min[3];
+  float bounds_max[3];
+};
+static_assert(sizeof(CookedMeshSubmesh) == 56, "CookedMeshSubmesh layout is part of the file format");
+
+// Bounds are in local space (dequantized positions); first_index is absolute and, like the submesh's
+// indices, relative to the submesh's base_vertex
+struct CookedMeshMeshlet {
+  uint32_t first_index;
+  uint32_t triangle_count;
+  uint32_t vertex_count;
+  uint32_t reserved;
+  float center[3];
+  float radius;
+  float cone_axis[3];
+  float cone_cutoff;  // See MeshletBounds (meshlet.h)
+};
+static_assert(sizeof(CookedMeshMeshlet) == 48, "CookedMeshMeshlet layout is part of the file format");
+
+// Container contents, pointing into the parsed bytes (e.g. a MappedFile)
+struct CookedMeshView {
+  const CookedMeshHeader* header = nullptr;
+  const CookedMeshSubmesh* submeshes = nullptr;
+  const CookedMeshMeshlet* meshlets = nullptr;
+  const CookedMeshVertex* vertices = nullptr;
+  const void* indices = nullptr;
+
+  bool HasIndex32() const {
+    return (header->flags & kCookedMeshFlagIndex32) != 0;
+  }
+
+  uint32_t GetIndexSize() const {
+    return HasIndex32() ? 4 : 2;
+  }
+
+  uint32_t GetIndex(uint32_t i) const {
+    return HasIndex32() ? static_cast<const uint32_t*>(indices)[i] : static_cast<const uint16_t*>(indices)[i];
+  }
+};
+
+// Validate bytes as a container (header, submesh and meshlet ranges and bounds); false on malformed input
+bool ParseCookedMesh(const uint8_t* bytes, size_t size, CookedMeshView& out_view);
+
+// Attribute encodings used by CookedMeshVertex (IEEE half with round-to-nearest-even; octahedral normals
+// in [-32767, 32767], decoded vectors are normalized)
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+void EncodeOctahedralNormal(const float normal[3], int16_t out_encoded[2]);
+void DecodeOctahedralNormal(const int16_t encoded[2], float out_normal[3]);
+
+// Local-space position of a cooked vertex
+void DequantizePosition(const CookedMeshHeader& header, const CookedMeshVertex& vertex, float out_position[3]);
+
+struct CookMeshOptions {
+  bool optimize_vertex_cache = true;  // Reorder triangles for the post-transform cache
+  bool optimize_vertex_fetch = true;  // Reorder vertices in first-use order
+  bool force_index32 = false;         // Otherwise 16-bit whenever every submesh has <= 65536 vertices
+  bool build_meshlets = true;         // Group triangles into meshlets (after cache optimization)
+  uint32_t meshlet_max_vertices = kMeshletMaxVertices;
+  uint32_t meshlet_max_triangles = kMeshletMaxTriangles;
+};
+
+// What cooking did, with cache / fetch figures before (welded, source triangle order) and after optimization
+struct CookMeshStats {
+  size_t source_vertices = 0;
+  size_t vertices = 0;
+  size_t triangles = 0;
+  size_t degenerate_triangles = 0;
+  size_t meshlets = 0;
+  size_t meshlet_vertices = 0;  // Summed over meshlets (vertices shared between meshlets count once per meshlet)
+  float acmr_before = 0.0f;
+  float acmr_after = 0.0f;
+  float atvr_before = 0.0f;
+  float atvr_after = 0.0f;
+  float overfetch_before = 0.0f;
+  float overfetch_after = 0.0f;
+  bool generated_normals = false;
+  float max_position_error = 0.0f;  // Largest per-axis error of dequantized positions, in local units
+  float max_normal_error = 0.0f;    // Largest angle between a source and a decoded normal, in degrees
+  float max_texcoord_error = 0.0f;  // Largest absolute error of decoded texcoords
+};
+
+// Weld, optimize and quantize every submesh of source and lay out a complete container.
+// Sources without normals get smooth, area-weighted normals.
+bool CookMesh(const MeshSource& source, const CookMeshOptions& options, std::vector<uint8_t>& out_file, CookMeshStats* out_stats = nullptr);
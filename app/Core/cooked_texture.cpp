@@ -0,0 +1,193 @@
+#include "cooked_texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "block_compression.h"
+#include "mip_generator.h"
+#include "profiler.h"
+
+namespace {
+constexpr uint32_t kMaxMipCount = 16;
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+BlockFormat ToBlockFormat(CookedTextureFormat format) {
+  switch (format) {
+    case CookedTextureFormat::BC1:
+      return BlockFormat::BC1;
+    case CookedTextureFormat::BC3:
+      return BlockFormat::BC3;
+    case CookedTextureFormat::BC4:
+      return BlockFormat::BC4;
+    case CookedTextureFormat::BC5:
+      return BlockFormat::BC5;
+    default:
+      return BlockFormat::BC7;
+  }
+}
+}  // namespace
+
+const char* GetCookedTextureFormatName(CookedTextureFormat format) {
+  switch (format) {
+    case CookedTextureFormat::RGBA8:
+      return "rgba8";
+    case CookedTextureFormat::BC1:
+      return "bc1";
+    case CookedTextureFormat::BC3:
+      return "bc3";
+    case CookedTextureFormat::BC4:
+      return "bc4";
+    case CookedTextureFormat::BC5:
+      return "bc5";
+    case CookedTextureFormat::BC7:
+      return "bc7";
+  }
+  return "unknown";
+}
+
+bool ParseCookedTextureFormat(std::string_view name, CookedTextureFormat& out_format) {
+  for (uint32_t i = 0; i <= static_cast<uint32_t>(CookedTextureFormat::BC7); ++i) {
+    const auto format = static_cast<CookedTextureFormat>(i);
+    if (name == GetCookedTextureFormatName(format)) {
+      out_format = format;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsBlockCompressed(CookedTextureFormat format) {
+  return format != CookedTextureFormat::RGBA8;
+}
+
+uint64_t ComputeCookedTextureLayout(CookedTextureFormat format,
+  uint32_t width,
+  uint32_t height,
+  uint32_t mip_count,
+  std::vector<CookedTextureSubresource>& out_subresources) {
+  out_subresources.resize(mip_count);
+
+  uint64_t offset = 0;
+  for (uint32_t mip = 0; mip < mip_count; ++mip) {
+    CookedTextureSubresource& sub = out_subresources[mip];
+    sub.width = (std::max)(1u, width >> mip);
+    sub.height = (std::max)(1u, height >> mip);
+    if (IsBlockCompressed(format)) {
+      sub.row_bytes = (sub.width + 3) / 4 * GetBlockBytes(ToBlockFormat(format));
+      sub.row_count = (sub.height + 3) / 4;
+    } else {
+      sub.row_bytes = sub.width * Image::kBytesPerPixel;
+      sub.row_count = sub.height;
+    }
+    sub.row_pitch = static_cast<uint32_t>(AlignUp(sub.row_bytes, kCookedTextureRowPitchAlignment));
+    sub.reserved = 0;
+
+    offset = AlignUp(offset, kCookedTextureSubresourceAlignment);
+    sub.offset = offset;
+    offset += static_cast<uint64_t>(sub.row_pitch) * sub.row_count;
+  }
+  return offset;
+}
+
+bool ParseCookedTexture(const uint8_t* bytes, size_t size, CookedTextureView& out_view) {
+  if (bytes == nullptr || size < sizeof(CookedTextureHeader)) {
+    std::cerr << "[CookedTexture] File too small for a header" << '\n';
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const CookedTextureHeader*>(bytes);
+  if (header->magic != kCookedTextureMagic || header->version != kCookedTextureVersion) {
+    std::cerr << "[CookedTexture] Not a version " << kCookedTextureVersion << " cooked texture" << '\n';
+    return false;
+  }
+  if (header->format > CookedTextureFormat::BC7 || header->width == 0 || header->height == 0 || header->mip_count == 0 ||
+      header->mip_count > kMaxMipCount || header->array_size == 0 || header->array_size > 2048) {
+    std::cerr << "[CookedTexture] Invalid header" << '\n';
+    return false;
+  }
+
+  const uint64_t subresource_count = static_cast<uint64_t>(header->mip_count) * header->array_size;
+  const uint64_t table_end = sizeof(CookedTextureHeader) + subresource_count * sizeof(CookedTextureSubresource);
+  if (header->data_offset < table_end || header->data_offset > size || header->data_size > size - header->data_offset) {
+    std::cerr << "[CookedTexture] Data block out of bounds" << '\n';
+    return false;
+  }
+
+  const auto* subresources = reinterpret_cast<const CookedTextureSubresource*>(bytes + sizeof(CookedTextureHeader));
+  for (uint64_t i = 0; i < subresource_count; ++i) {
+    const CookedTextureSubresource& sub = subresources[i];
+    const uint64_t extent = static_cast<uint64_t>(sub.row_pitch) * sub.row_count;
+    if (sub.row_count == 0 || sub.row_bytes > sub.row_pitch || sub.offset > header->data_size || extent > header->data_size - sub.offset) {
+      std::cerr << "[CookedTexture] Subresource " << i << " out of bounds" << '\n';
+      return false;
+    }
+  }
+
+  out_view.header = header;
+  out_view.subresources = subresources;
+  out_view.data = bytes + header->data_offset;
+  return true;
+}
+
+bool CookTexture(const Image& source, const CookTextureOptions& options, std::vector<uint8_t>& out_file) {
+  PROFILE_SCOPE("CookTexture");
+
+  if (source.IsEmpty()) {
+    std::cerr << "[CookedTexture] Empty source image" << '\n';
+    return false;
+  }
+  if (IsBlockCompressed(options.format) && (source.width % 4 != 0 || source.height % 4 != 0)) {
+    std::cerr << "[CookedTexture] " << GetCookedTextureFormatName(options.format) << " needs a size that is a multiple of 4 (got "
+              << source.width << "x" << source.height << ")" << '\n';
+    return false;
+  }
+
+  MipGenerationOptions mip_options;
+  mip_options.filter = options.mip_filter;
+  mip_options.alpha_mode = options.alpha_mode;
+  mip_options.srgb = options.srgb;
+  mip_options.max_levels = options.generate_mips ? 0 : 1;
+  mip_options.pool = options.pool;
+
+  std::vector<Image> mips;
+  GenerateMipChain(source, mip_options, mips);
+  const uint32_t mip_count = static_cast<uint32_t>(mips.size());
+
+  std::vector<CookedTextureSubresource> subresources;
+  const uint64_t data_size = ComputeCookedTextureLayout(options.format, source.width, source.height, mip_count, subresources);
+
+  CookedTextureHeader header = {};
+  header.magic = kCookedTextureMagic;
+  header.version = kCookedTextureVersion;
+  header.format = options.format;
+  header.flags = options.srgb ? kCookedTextureFlagSrgb : 0;
+  header.width = source.width;
+  header.height = source.height;
+  header.mip_count = mip_count;
+  header.array_size = 1;
+  header.data_offset =
+    AlignUp(sizeof(CookedTextureHeader) + subresources.size() * sizeof(CookedTextureSubresource), kCookedTextureDataAlignment);
+  header.data_size = data_size;
+
+  out_file.assign(header.data_offset + data_size, 0);
+  std::memcpy(out_file.data(), &header, sizeof(header));
+  std::memcpy(out_file.data() + sizeof(header), subresources.data(), subresources.size() * sizeof(CookedTextureSubresource));
+
+  uint8_t* data = out_file.data() + header.data_offset;
+  for (uint32_t mip = 0; mip < mip_count; ++mip) {
+    const CookedTextureSubresource& sub = subresources[mip];
+    uint8_t* dst = data + sub.offset;
+    if (IsBlockCompressed(options.format)) {
+      CompressImage(mips[mip], ToBlockFormat(options.format), dst, sub.row_pitch, options.pool);
+    } else {
+      for (uint32_t y = 0; y < sub.row_count; ++y) {
+        std::memcpy(dst + static_cast<size_t>(y) * sub.row_pitch, mips[mip].GetPixel(0, y), sub.row_bytes);
+      }
+    }
+  }
+  return true;
+}
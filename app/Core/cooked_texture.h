@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "image.h"
+#include "mip_generator.h"
+
+class ThreadPool;
+
+// Cooked texture container (.ctex): pre-mipped, optionally block-compressed texture data written by
+// tools/texture_cooker and memory-mapped by the runtime loader.
+//
+//   [CookedTextureHeader][CookedTextureSubresource x mip_count * array_size][padding][data block]
+//
+// The data block starts at a 4096-byte aligned file offset and lays every subresource out the way
+// ID3D12Device::GetCopyableFootprints places it from a 512-byte aligned base offset: row pitches are
+// multiples of 256 bytes and subresource offsets multiples of 512 bytes. The loader can therefore copy
+// the whole block into upload memory with one memcpy and issue one CopyTextureRegion per subresource.
+// Subresources are ordered like D3D12 subresource indices (mip-major within each array slice).
+// The format is little-endian, fixed-layout records.
+
+constexpr uint32_t kCookedTextureMagic = 0x58455443;  // "CTEX"
+constexpr uint32_t kCookedTextureVersion = 1;
+constexpr uint32_t kCookedTextureRowPitchAlignment = 256;     // D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+constexpr uint32_t kCookedTextureSubresourceAlignment = 512;  // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+constexpr uint32_t kCookedTextureDataAlignment = 4096;
+
+enum class CookedTextureFormat : uint32_t { RGBA8, BC1, BC3, BC4, BC5, BC7 };
+
+constexpr uint32_t kCookedTextureFlagSrgb = 1u << 0;
+
+struct CookedTextureHeader {
+  uint32_t magic;
+  uint32_t version;
+  CookedTextureFormat format;
+  uint32_t flags;
+  uint32_t width;
+  uint32_t height;
+  uint32_t mip_count;
+  uint32_t array_size;
+  uint64_t data_offset;  // File offset of the data block
+  uint64_t data_size;
+};
+static_assert(sizeof(CookedTextureHeader) == 48, "CookedTextureHeader layout is part of the file format");
+
+struct CookedTextureSubresource {
+  uint64_t offset;     // From the start of the data block
+  uint32_t width;
+  uint32_t height;
+  uint32_t row_pitch;  // Bytes between rows (rows of 4x4 blocks for BC formats)
+  uint32_t row_count;
+  uint32_t row_bytes;  // Bytes of data in each row
+  uint32_t reserved;
+};
+static_assert(sizeof(CookedTextureSubresource) == 32, "CookedTextureSubresource layout is part of the file format");
+
+const char* GetCookedTextureFormatName(CookedTextureFormat format);
+bool ParseCookedTextureFormat(std::string_view name, CookedTextureFormat& out_format);
+
+bool IsBlockCompressed(CookedTextureFormat format);
+
+// Fill the footprints of a single-slice width x height texture with mip_count levels; returns the size of
+// the data block. BC formats require a mip 0 size that is a multiple of 4.
+uint64_t ComputeCookedTextureLayout(CookedTextureFormat format,
+  uint32_t width,
+  uint32_t height,
+  uint32_t mip_count,
+  std::vector<CookedTextureSubresource>& out_subresources);
+
+// Container contents, pointing into the parsed bytes (e.g. a MappedFile)
+struct CookedTextureView {
+  const CookedTextureHeader* header = nullptr;
+  const CookedTextureSubresource* subresources = nullptr;
+  const uint8_t* data = nullptr;
+
+  uint32_t GetSubresourceCount() const {
+    return header->mip_count * header->array_size;
+  }
+};
+
+// Validate bytes as a container (header, footprints and bounds); false on malformed input
+bool ParseCookedTexture(const uint8_t* bytes, size_t size, CookedTextureView& out_view);
+
+struct CookTextureOptions {
+  CookedTextureFormat format = CookedTextureFormat::BC7;
+  bool srgb = false;           // Color data: mips are filtered in linear space, views use *_SRGB formats
+  bool generate_mips = true;   // Full chain down to 1x1, otherwise mip 0 only
+  MipFilter mip_filter = MipFilter::Kaiser;
+  MipAlphaMode alpha_mode = MipAlphaMode::Straight;
+  ThreadPool* pool = nullptr;  // Mip filtering and block compression run on its workers when given
+};
+
+// Generate mips, encode and lay out a complete container for source
+bool CookTexture(const Image& source, const CookTextureOptions& options, std::vector<uint8_t>& out_file);
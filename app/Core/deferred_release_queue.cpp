@@ -0,0 +1,55 @@
+#include "deferred_release_queue.h"
+
+void DeferredReleaseQueue::Enqueue(uint64_t fence_value, ReleaseFunc release) {
+  if (!release) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back({fence_value, std::move(release)});
+}
+
+uint32_t DeferredReleaseQueue::Process(uint64_t completed_fence_value) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!entries_.empty() && entries_.front().fence_value <= completed_fence_value) {
+      ready_.push_back(std::move(entries_.front().release));
+      entries_.pop_front();
+    }
+  }
+  return RunReady();
+}
+
+uint32_t DeferredReleaseQueue::Flush() {
+  uint32_t released = 0;
+  // Releases may enqueue follow-up work, so drain until empty
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entries_.empty()) {
+        break;
+      }
+      while (!entries_.empty()) {
+        ready_.push_back(std::move(entries_.front().release));
+        entries_.pop_front();
+      }
+    }
+    released += RunReady();
+  }
+  return released;
+}
+
+size_t DeferredReleaseQueue::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+uint32_t DeferredReleaseQueue::RunReady() {
+  const uint32_t count = static_cast<uint32_t>(ready_.size());
+  for (ReleaseFunc& release : ready_) {
+    release();
+  }
+  ready_.clear();
+  released_count_ += count;
+  return count;
+}
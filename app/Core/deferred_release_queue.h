@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// DeferredReleaseQueue: Retires objects the GPU may still be reading.
+// Each release is tagged with the fence value that will be signaled after the last command list that
+// can reference it; Process(completed) runs every release whose value the GPU has passed.
+//
+// Enqueue is thread-safe; Process / Flush belong to the thread that owns the fence. Entries are kept in submission order, so an entry whose fence value is lower
+// than an earlier one is simply released a little later (never early).
+class DeferredReleaseQueue {
+ public:
+  using ReleaseFunc = std::move_only_function<void()>;
+
+  DeferredReleaseQueue() = default;
+  ~DeferredReleaseQueue() {
+    Flush();
+  }
+
+  DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+  DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+
+  void Enqueue(uint64_t fence_value, ReleaseFunc release);
+
+  // Run releases whose fence value is <= completed_fence_value. Returns the number released.
+  uint32_t Process(uint64_t completed_fence_value);
+
+  // Run every pending release (only after the GPU is idle, e.g. at shutdown)
+  uint32_t Flush();
+
+  size_t GetPendingCount() const;
+
+  uint64_t GetReleasedCount() const {
+    return released_count_;
+  }
+
+ private:
+  struct Entry {
+    uint64_t fence_value;
+    ReleaseFunc release;
+  };
+
+  mutable std::mutex mutex_;
+  std::deque<Entry> entries_;
+  uint64_t released_count_ = 0;
+
+  // Reused between Process calls; releases run outside the lock so they may enqueue again
+  std::vector<ReleaseFunc> ready_;
+
+  uint32_t RunReady();
+};
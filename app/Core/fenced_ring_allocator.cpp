@@ -0,0 +1,99 @@
+#include "fenced_ring_allocator.h"
+
+#include <bit>
+#include <cassert>
+
+namespace {
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+void FencedRingAllocator::Initialize(uint64_t capacity) {
+  capacity_ = capacity;
+  head_ = 0;
+  tail_ = 0;
+  entries_.clear();
+}
+
+bool FencedRingAllocator::Allocate(uint64_t size, uint64_t alignment, uint32_t owner, uint64_t& out_offset) {
+  assert(std::has_single_bit(alignment));
+  if (size == 0 || size > capacity_) {
+    return false;
+  }
+
+  if (entries_.empty()) {
+    head_ = 0;
+    tail_ = 0;
+  }
+
+  // Live memory is [head_, tail_) or, once wrapped, [head_, capacity_) + [0, tail_). A wrapped allocation
+  // must end strictly before head_ so that tail_ == head_ only ever means empty.
+  uint64_t offset = AlignUp(tail_, alignment);
+  if (entries_.empty() || tail_ > head_) {
+    if (offset + size > capacity_) {
+      // Wrap; the unused end of the range is reclaimed together with the allocations before it
+      if (entries_.empty() || size >= head_) {
+        return false;
+      }
+      offset = 0;
+    }
+  } else if (offset + size >= head_) {
+    return false;
+  }
+
+  tail_ = offset + size;
+  out_offset = offset;
+
+  // Consecutive allocations of one owner share an entry
+  if (!entries_.empty()) {
+    Entry& last = entries_.back();
+    if (!last.closed && last.owner == owner && offset >= last.end) {
+      last.end = tail_;
+      return true;
+    }
+  }
+
+  Entry& entry = entries_.emplace_back();
+  entry.begin = offset;
+  entry.end = tail_;
+  entry.owner = owner;
+  return true;
+}
+
+void FencedRingAllocator::Close(uint32_t owner, uint64_t fence_value) {
+  for (Entry& entry : entries_) {
+    if (!entry.closed && entry.owner == owner) {
+      entry.fence = fence_value;
+      entry.closed = true;
+    }
+  }
+}
+
+void FencedRingAllocator::Retire(uint64_t completed_fence) {
+  while (!entries_.empty() && entries_.front().closed && entries_.front().fence <= completed_fence) {
+    entries_.pop_front();
+  }
+
+  if (entries_.empty()) {
+    head_ = 0;
+    tail_ = 0;
+  } else {
+    head_ = entries_.front().begin;
+  }
+}
+
+bool FencedRingAllocator::GetOldestFence(uint64_t& out_fence) const {
+  if (entries_.empty() || !entries_.front().closed) {
+    return false;
+  }
+  out_fence = entries_.front().fence;
+  return true;
+}
+
+uint64_t FencedRingAllocator::GetUsedSize() const {
+  if (entries_.empty()) {
+    return 0;
+  }
+  return (tail_ > head_) ? tail_ - head_ : capacity_ - head_ + tail_;
+}
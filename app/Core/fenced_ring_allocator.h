@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+// FencedRingAllocator: Circular allocator over an abstract range [0, capacity) whose memory is reclaimed
+// in allocation order once a fence value completes. Allocations are tagged with an owner (e.g. an upload
+// batch being recorded); Close stamps every allocation of that owner with the fence value its work
+// signals, and Retire frees the oldest allocations whose fence has completed.
+//
+// An allocation that is not closed yet blocks reclaiming everything allocated after it, so owners
+// should be closed soon after they stop allocating. Only bookkeeping lives here (offsets, not memory).
+class FencedRingAllocator {
+ public:
+  FencedRingAllocator() = default;
+  explicit FencedRingAllocator(uint64_t capacity) {
+    Initialize(capacity);
+  }
+
+  void Initialize(uint64_t capacity);
+
+  // Returns false when no contiguous free range of size bytes exists at the requested alignment
+  // (alignment must be a power of two); the caller may Retire / wait for GetOldestFence and retry.
+  bool Allocate(uint64_t size, uint64_t alignment, uint32_t owner, uint64_t& out_offset);
+
+  // Stamp all open allocations of owner with fence_value
+  void Close(uint32_t owner, uint64_t fence_value);
+
+  // Free the oldest closed allocations with fence <= completed_fence
+  void Retire(uint64_t completed_fence);
+
+  // Fence of the oldest allocation; false when empty or when the oldest allocation is still open
+  bool GetOldestFence(uint64_t& out_fence) const;
+
+  uint64_t GetCapacity() const {
+    return capacity_;
+  }
+
+  // Bytes between the oldest live allocation and the end of the newest (includes alignment / wrap waste)
+  uint64_t GetUsedSize() const;
+
+  bool IsEmpty() const {
+    return entries_.empty();
+  }
+
+ private:
+  struct Entry {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    uint64_t fence = 0;
+    uint32_t owner = 0;
+    bool closed = false;
+  };
+
+  uint64_t capacity_ = 0;
+  uint64_t head_ = 0;  // Begin of the oldest live allocation
+  uint64_t tail_ = 0;  // End of the newest allocation
+  std::deque<Entry> entries_;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Size and color space of an encoded image, read from its header before decoding (so the destination can
+// be allocated, e.g. directly in upload memory)
+struct ImageInfo {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  bool srgb = false;  // The file declares sRGB-encoded color
+};
+
+// Image: CPU pixels as tightly packed rows of 8-bit RGBA (the common currency of the decoders, the
+// mip generator and the block compressors).
+struct Image {
+  static constexpr uint32_t kBytesPerPixel = 4;
+
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> pixels;
+
+  void Resize(uint32_t new_width, uint32_t new_height) {
+    width = new_width;
+    height = new_height;
+    pixels.assign(static_cast<size_t>(width) * height * kBytesPerPixel, 0);
+  }
+
+  bool IsEmpty() const {
+    return width == 0 || height == 0;
+  }
+
+  uint32_t GetRowPitch() const {
+    return width * kBytesPerPixel;
+  }
+
+  uint8_t* GetPixel(uint32_t x, uint32_t y) {
+    return pixels.data() + (static_cast<size_t>(y) * width + x) * kBytesPerPixel;
+  }
+  const uint8_t* GetPixel(uint32_t x, uint32_t y) const {
+    return pixels.data() + (static_cast<size_t>(y) * width + x) * kBytesPerPixel;
+  }
+};
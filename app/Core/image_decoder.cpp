@@ -0,0 +1,67 @@
+#include "image_decoder.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "mapped_file.h"
+#include "png_decoder.h"
+#include "tga_decoder.h"
+
+namespace {
+constexpr uint8_t kPngSignature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+}  // namespace
+
+ImageFileFormat DetectImageFileFormat(const uint8_t* data, size_t size) {
+  if (data != nullptr && size >= sizeof(kPngSignature) && std::memcmp(data, kPngSignature, sizeof(kPngSignature)) == 0) {
+    return ImageFileFormat::Png;
+  }
+  if (IsTga(data, size)) {
+    return ImageFileFormat::Tga;
+  }
+  return ImageFileFormat::Unknown;
+}
+
+bool ReadImageInfo(const uint8_t* data, size_t size, ImageInfo& out_info) {
+  switch (DetectImageFileFormat(data, size)) {
+    case ImageFileFormat::Png:
+      return ReadPngInfo(data, size, out_info);
+    case ImageFileFormat::Tga:
+      return ReadTgaInfo(data, size, out_info);
+    default:
+      std::cerr << "[ImageDecoder] Unrecognized image format" << '\n';
+      return false;
+  }
+}
+
+bool DecodeImage(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch) {
+  switch (DetectImageFileFormat(data, size)) {
+    case ImageFileFormat::Png:
+      return DecodePng(data, size, dst, dst_row_pitch);
+    case ImageFileFormat::Tga:
+      return DecodeTga(data, size, dst, dst_row_pitch);
+    default:
+      std::cerr << "[ImageDecoder] Unrecognized image format" << '\n';
+      return false;
+  }
+}
+
+bool DecodeImage(const uint8_t* data, size_t size, Image& out_image) {
+  ImageInfo info;
+  if (!ReadImageInfo(data, size, info)) {
+    return false;
+  }
+  out_image.Resize(info.width, info.height);
+  return DecodeImage(data, size, out_image.pixels.data(), out_image.GetRowPitch());
+}
+
+bool DecodeImageFile(const std::filesystem::path& file_path, Image& out_image) {
+  MappedFile file;
+  if (!file.Open(file_path)) {
+    return false;
+  }
+  if (!DecodeImage(file.GetData(), file.GetSize(), out_image)) {
+    std::cerr << "[ImageDecoder] Failed to decode " << file_path.string() << '\n';
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "image.h"
+
+// Image decoding front end over the built-in decoders: the format is picked from the contents (PNG
+// signature, otherwise a TGA header, which has no signature), not from the file extension.
+
+enum class ImageFileFormat : uint8_t { Unknown, Png, Tga };
+
+ImageFileFormat DetectImageFileFormat(const uint8_t* data, size_t size);
+
+bool ReadImageInfo(const uint8_t* data, size_t size, ImageInfo& out_info);
+
+// Decode into caller memory sized from ReadImageInfo: height rows of width RGBA pixels, dst_row_pitch
+// bytes apart. dst is only written, so it may be mapped upload memory.
+bool DecodeImage(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch);
+
+bool DecodeImage(const uint8_t* data, size_t size, Image& out_image);
+
+// Map file_path and decode it (no intermediate copy of the file)
+bool DecodeImageFile(const std::filesystem::path& file_path, Image& out_image);
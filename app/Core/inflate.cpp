@@ -0,0 +1,478 @@
+#include "inflate.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define INFLATE_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define INFLATE_USE_SSE 0
+#endif
+
+static_assert(std::endian::native == std::endian::little, "Bit reader refill assumes a little-endian host");
+
+namespace {
+constexpr int kMaxCodeLength = 15;
+constexpr int kFastBits = 11;  // Codes up to this length decode with one table lookup
+constexpr int kNumLitLenSymbols = 288;
+constexpr int kNumDistSymbols = 32;
+
+constexpr std::array<uint16_t, 29> kLengthBase = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29> kLengthExtra = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> kDistBase = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537,
+  2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> kDistExtra = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr std::array<uint8_t, 19> kCodeLengthOrder = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// LSB-first bit stream over the compressed bytes; reads past the end set the error flag
+class BitReader {
+ public:
+  BitReader(const uint8_t* data, size_t size) : cursor_(data), end_(data + size) {
+  }
+
+  void Refill() {
+    if (end_ - cursor_ >= 8) {
+      uint64_t bytes;
+      std::memcpy(&bytes, cursor_, sizeof(bytes));
+      buffer_ |= bytes << count_;
+      cursor_ += (63 - count_) >> 3;
+      count_ |= 56;
+      return;
+    }
+    while (count_ <= 56 && cursor_ < end_) {
+      buffer_ |= static_cast<uint64_t>(*cursor_++) << count_;
+      count_ += 8;
+    }
+  }
+
+  uint32_t GetBits(int n) {
+    if (count_ < n) {
+      Refill();
+      if (count_ < n) {
+        error_ = true;
+        return 0;
+      }
+    }
+    const uint32_t value = static_cast<uint32_t>(buffer_ & ((1ull << n) - 1));
+    Consume(n);
+    return value;
+  }
+
+  void Consume(int n) {
+    buffer_ >>= n;
+    count_ -= n;
+  }
+
+  // Drop bits up to the next byte boundary (stored blocks)
+  void AlignToByte() {
+    Consume(count_ & 7);
+  }
+
+  // Copy whole bytes at a byte-aligned position (bits still buffered come first)
+  bool ReadBytes(uint8_t* dst, size_t size) {
+    while (size > 0 && count_ >= 8) {
+      *dst++ = static_cast<uint8_t>(buffer_);
+      Consume(8);
+      --size;
+    }
+    if (size == 0) {
+      return true;
+    }
+    // Drained; bits above count_ are look-ahead of the old cursor position
+    buffer_ = 0;
+    count_ = 0;
+    if (static_cast<size_t>(end_ - cursor_) < size) {
+      error_ = true;
+      return false;
+    }
+    std::memcpy(dst, cursor_, size);
+    cursor_ += size;
+    return true;
+  }
+
+  uint64_t PeekBuffer() const {
+    return buffer_;
+  }
+  int GetBitCount() const {
+    return count_;
+  }
+  bool HasError() const {
+    return error_;
+  }
+
+ private:
+  const uint8_t* cursor_;
+  const uint8_t* end_;
+  uint64_t buffer_ = 0;
+  int count_ = 0;
+  bool error_ = false;
+};
+
+// Canonical Huffman code: one-lookup table for short codes, canonical walk for the rest
+struct HuffmanTable {
+  std::array<uint16_t, 1 << kFastBits> fast{};  // (symbol << 4) | length; 0 = longer than kFastBits
+  std::array<uint16_t, kMaxCodeLength + 1> counts{};
+  std::array<uint16_t, kNumLitLenSymbols> symbols{};
+
+  bool Build(const uint8_t* lengths, int symbol_count) {
+    counts.fill(0);
+    fast.fill(0);
+    for (int i = 0; i < symbol_count; ++i) {
+      ++counts[lengths[i]];
+    }
+    counts[0] = 0;
+
+    // Reject over-subscribed codes (incomplete codes are allowed, e.g. a single distance code)
+    int left = 1;
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+      left = (left << 1) - counts[len];
+      if (left < 0) {
+        return false;
+      }
+    }
+
+    std::array<uint16_t, kMaxCodeLength + 2> offsets{};
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+      offsets[len + 1] = static_cast<uint16_t>(offsets[len] + counts[len]);
+    }
+    for (int i = 0; i < symbol_count; ++i) {
+      if (lengths[i] != 0) {
+        symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+      }
+    }
+
+    // Codes are assigned in (length, symbol) order and stored bit-reversed in the stream
+    uint32_t code = 0;
+    int index = 0;
+    for (int len = 1; len <= kFastBits; ++len) {
+      for (int i = 0; i < counts[len]; ++i, ++index, ++code) {
+        uint32_t reversed = 0;
+        for (int bit = 0; bit < len; ++bit) {
+          reversed |= ((code >> bit) & 1u) << (len - 1 - bit);
+        }
+        const uint16_t entry = static_cast<uint16_t>((symbols[index] << 4) | len);
+        for (uint32_t slot = reversed; slot < fast.size(); slot += 1u << len) {
+          fast[slot] = entry;
+        }
+      }
+      code <<= 1;
+    }
+    return true;
+  }
+
+  // Returns the symbol, or -1 for an unused code / end of input
+  int Decode(BitReader& reader) const {
+    reader.Refill();
+    return DecodeBuffered(reader);
+  }
+
+  // Decode without refilling first (the caller refilled for several symbols)
+  int DecodeBuffered(BitReader& reader) const {
+    if (reader.GetBitCount() >= kFastBits) {
+      const uint16_t entry = fast[reader.PeekBuffer() & ((1u << kFastBits) - 1)];
+      if (entry != 0) {
+        reader.Consume(entry & 15);
+        return entry >> 4;
+      }
+    }
+
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+      code |= static_cast<int>(reader.GetBits(1));
+      if (reader.HasError()) {
+        return -1;
+      }
+      const int count = counts[len];
+      if (code - first < count) {
+        return symbols[index + code - first];
+      }
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+};
+
+struct FixedTables {
+  HuffmanTable lit_len;
+  HuffmanTable dist;
+
+  FixedTables() {
+    std::array<uint8_t, kNumLitLenSymbols> lengths{};
+    for (int i = 0; i < kNumLitLenSymbols; ++i) {
+      lengths[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+    }
+    lit_len.Build(lengths.data(), kNumLitLenSymbols);
+    lengths.fill(5);
+    dist.Build(lengths.data(), kNumDistSymbols);
+  }
+};
+
+bool ReadDynamicTables(BitReader& reader, HuffmanTable& lit_len, HuffmanTable& dist) {
+  const int lit_len_count = static_cast<int>(reader.GetBits(5)) + 257;
+  const int dist_count = static_cast<int>(reader.GetBits(5)) + 1;
+  const int code_length_count = static_cast<int>(reader.GetBits(4)) + 4;
+  if (reader.HasError() || lit_len_count > 286 || dist_count > 30) {
+    return false;
+  }
+
+  std::array<uint8_t, 19> code_length_lengths{};
+  for (int i = 0; i < code_length_count; ++i) {
+    code_length_lengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(reader.GetBits(3));
+  }
+  HuffmanTable code_lengths;
+  if (reader.HasError() || !code_lengths.Build(code_length_lengths.data(), 19)) {
+    return false;
+  }
+
+  // Literal/length and distance code lengths form one sequence (repeats may cross between them)
+  std::array<uint8_t, 286 + 30> lengths{};
+  int count = 0;
+  while (count < lit_len_count + dist_count) {
+    const int symbol = code_lengths.Decode(reader);
+    if (symbol < 0) {
+      return false;
+    }
+    if (symbol < 16) {
+      lengths[count++] = static_cast<uint8_t>(symbol);
+      continue;
+    }
+
+    uint8_t value = 0;
+    int repeat = 0;
+    if (symbol == 16) {
+      if (count == 0) {
+        return false;
+      }
+      value = lengths[count - 1];
+      repeat = 3 + static_cast<int>(reader.GetBits(2));
+    } else if (symbol == 17) {
+      repeat = 3 + static_cast<int>(reader.GetBits(3));
+    } else {
+      repeat = 11 + static_cast<int>(reader.GetBits(7));
+    }
+    if (reader.HasError() || count + repeat > lit_len_count + dist_count) {
+      return false;
+    }
+    std::memset(lengths.data() + count, value, repeat);
+    count += repeat;
+  }
+
+  // A block without an end-of-block code could never terminate
+  if (lengths[256] == 0) {
+    return false;
+  }
+  return lit_len.Build(lengths.data(), lit_len_count) && dist.Build(lengths.data() + lit_len_count, dist_count);
+}
+
+// Copy a `length`-byte match from `distance` bytes back. With at least 8 bytes of room after the match,
+// far matches move in 8-byte chunks (each chunk reads only bytes that are already final).
+void CopyMatch(uint8_t* out, size_t distance, size_t length, size_t room) {
+  const uint8_t* from = out - distance;
+  if (distance >= 8 && room >= length + 8) {
+    for (size_t i = 0; i < length; i += 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, from + i, sizeof(chunk));
+      std::memcpy(out + i, &chunk, sizeof(chunk));
+    }
+  } else if (distance >= length) {
+    std::memcpy(out, from, length);
+  } else if (distance == 1) {
+    std::memset(out, *from, length);
+  } else {
+    // Overlapping match repeats the last `distance` bytes
+    for (size_t i = 0; i < length; ++i) {
+      out[i] = from[i];
+    }
+  }
+}
+
+bool InflateBlock(BitReader& reader, const HuffmanTable& lit_len, const HuffmanTable& dist, uint8_t* dst, size_t capacity, size_t& pos) {
+  for (;;) {
+    // A refill buffers at least 56 bits until the last 8 input bytes: enough for two short literals or a
+    // whole length / distance pair (15 + 5 + 15 + 13 bits), so only the first decode refills
+    reader.Refill();
+    int symbol = lit_len.DecodeBuffered(reader);
+    if (symbol < 0) {
+      return false;
+    }
+    if (symbol < 256) {
+      if (pos >= capacity) {
+        return false;
+      }
+      dst[pos++] = static_cast<uint8_t>(symbol);
+      if (reader.GetBitCount() < kMaxCodeLength) {
+        continue;
+      }
+      symbol = lit_len.DecodeBuffered(reader);
+      if (symbol < 0) {
+        return false;
+      }
+      if (symbol < 256) {
+        if (pos >= capacity) {
+          return false;
+        }
+        dst[pos++] = static_cast<uint8_t>(symbol);
+        continue;
+      }
+    }
+    if (symbol == 256) {
+      return true;
+    }
+
+    const int length_index = symbol - 257;
+    if (length_index >= static_cast<int>(kLengthBase.size())) {
+      return false;
+    }
+    const size_t length = kLengthBase[length_index] + reader.GetBits(kLengthExtra[length_index]);
+
+    const int dist_symbol = (reader.GetBitCount() >= kMaxCodeLength) ? dist.DecodeBuffered(reader) : dist.Decode(reader);
+    if (dist_symbol < 0 || dist_symbol >= static_cast<int>(kDistBase.size())) {
+      return false;
+    }
+    const size_t distance = kDistBase[dist_symbol] + reader.GetBits(kDistExtra[dist_symbol]);
+    if (reader.HasError() || distance > pos || length > capacity - pos) {
+      return false;
+    }
+
+    CopyMatch(dst + pos, distance, length, capacity - pos);
+    pos += length;
+  }
+}
+}  // namespace
+
+bool InflateRaw(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity, size_t& out_size) {
+  static const FixedTables fixed_tables;
+
+  BitReader reader(src, src_size);
+  HuffmanTable lit_len;
+  HuffmanTable dist;
+  size_t pos = 0;
+  out_size = 0;
+
+  bool last_block = false;
+  while (!last_block) {
+    last_block = reader.GetBits(1) != 0;
+    const uint32_t type = reader.GetBits(2);
+    if (reader.HasError()) {
+      return false;
+    }
+
+    bool ok = false;
+    switch (type) {
+      case 0: {
+        reader.AlignToByte();
+        const uint32_t length = reader.GetBits(16);
+        const uint32_t inverted = reader.GetBits(16);
+        if (reader.HasError() || (length ^ 0xFFFFu) != inverted || length > dst_capacity - pos) {
+          return false;
+        }
+        ok = reader.ReadBytes(dst + pos, length);
+        pos += length;
+        break;
+      }
+      case 1:
+        ok = InflateBlock(reader, fixed_tables.lit_len, fixed_tables.dist, dst, dst_capacity, pos);
+        break;
+      case 2:
+        ok = ReadDynamicTables(reader, lit_len, dist) && InflateBlock(reader, lit_len, dist, dst, dst_capacity, pos);
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok || reader.HasError()) {
+      return false;
+    }
+  }
+
+  out_size = pos;
+  return true;
+}
+
+bool ZlibDecompress(const uint8_t* src, size_t src_size, size_t max_size, std::vector<uint8_t>& out) {
+  if (src_size < 6) {
+    std::cerr << "[Inflate] zlib stream too short" << '\n';
+    return false;
+  }
+
+  // CMF / FLG: deflate method, window <= 32K, header checksum, no preset dictionary
+  const uint8_t cmf = src[0];
+  const uint8_t flg = src[1];
+  if ((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20) != 0) {
+    std::cerr << "[Inflate] Unsupported zlib header" << '\n';
+    return false;
+  }
+
+  out.resize(max_size);
+  size_t written = 0;
+  if (!InflateRaw(src + 2, src_size - 6, out.data(), max_size, written)) {
+    std::cerr << "[Inflate] Corrupt or oversized deflate stream" << '\n';
+    return false;
+  }
+  out.resize(written);
+
+  const uint8_t* trailer = src + src_size - 4;
+  const uint32_t expected = (uint32_t{trailer[0]} << 24) | (uint32_t{trailer[1]} << 16) | (uint32_t{trailer[2]} << 8) | trailer[3];
+  if (Adler32(out.data(), out.size()) != expected) {
+    std::cerr << "[Inflate] Adler-32 mismatch" << '\n';
+    return false;
+  }
+  return true;
+}
+
+uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler) {
+  constexpr uint32_t kModulus = 65521;
+  constexpr size_t kMaxRun = 5552;  // Largest run before the 32-bit sums can overflow
+
+  uint32_t a = adler & 0xFFFF;
+  uint32_t b = adler >> 16;
+  while (size > 0) {
+    const size_t run = (size < kMaxRun) ? size : kMaxRun;
+    size_t i = 0;
+#if INFLATE_USE_SSE
+    // 16 bytes per step: a gains the byte sum, b gains 16 * a plus the bytes weighted 16..1 (the sums of
+    // a before each step are accumulated separately and scaled once per run)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights_low = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+    const __m128i weights_high = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+    __m128i sum_a = zero;
+    __m128i sum_prefix = zero;
+    __m128i sum_b = zero;
+    for (; i + 16 <= run; i += 16) {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      sum_prefix = _mm_add_epi32(sum_prefix, sum_a);
+      sum_a = _mm_add_epi32(sum_a, _mm_sad_epu8(bytes, zero));
+      sum_b = _mm_add_epi32(sum_b, _mm_madd_epi16(_mm_unpacklo_epi8(bytes, zero), weights_low));
+      sum_b = _mm_add_epi32(sum_b, _mm_madd_epi16(_mm_unpackhi_epi8(bytes, zero), weights_high));
+    }
+    if (i > 0) {
+      alignas(16) uint32_t lanes_a[4];
+      alignas(16) uint32_t lanes_prefix[4];
+      alignas(16) uint32_t lanes_b[4];
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes_a), sum_a);
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes_prefix), sum_prefix);
+      _mm_store_si128(reinterpret_cast<__m128i*>(lanes_b), sum_b);
+      b += a * static_cast<uint32_t>(i) + 16 * (lanes_prefix[0] + lanes_prefix[2]) + lanes_b[0] + lanes_b[1] + lanes_b[2] + lanes_b[3];
+      a += lanes_a[0] + lanes_a[2];
+    }
+#endif
+    for (; i < run; ++i) {
+      a += data[i];
+      b += a;
+    }
+    a %= kModulus;
+    b %= kModulus;
+    data += run;
+    size -= run;
+  }
+  return (b << 16) | a;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Inflate: DEFLATE (RFC 1951) decompressor with the zlib (RFC 1950) wrapper used by PNG.
+// Decodes a whole stream in one call into caller-sized memory; no streaming and no preset dictionaries.
+
+// Decompress a raw DEFLATE stream into dst. out_size receives the number of bytes written (bytes between
+// out_size and dst_capacity may be overwritten). Returns false on malformed input or when the data does not
+// fit dst_capacity.
+bool InflateRaw(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity, size_t& out_size);
+
+// Decompress a zlib stream (2-byte header, DEFLATE data, Adler-32 trailer) into out, which is resized to the
+// decompressed size (at most max_size). The checksum is verified.
+bool ZlibDecompress(const uint8_t* src, size_t src_size, size_t max_size, std::vector<uint8_t>& out);
+
+uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler = 1);
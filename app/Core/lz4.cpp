@@ -0,0 +1,243 @@
+#include "lz4.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace {
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;     // The block always ends with at least this many literals
+constexpr size_t kMatchFindLimit = 12;  // ... and no match starts in its last 12 bytes
+constexpr size_t kMaxDistance = 65535;
+constexpr int kHashLog = 12;
+constexpr int kSkipStrength = 6;  // Search step grows by one every 64 bytes without a match
+
+uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint64_t Read64(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+// Length of the common prefix of a and b, comparing at most up to limit (a < limit)
+size_t CountMatch(const uint8_t* a, const uint8_t* b, const uint8_t* limit) {
+  const uint8_t* start = a;
+  while (limit - a >= 8) {
+    const uint64_t diff = Read64(a) ^ Read64(b);
+    if (diff != 0) {
+      // Little-endian: the lowest set bit marks the first differing byte
+      return static_cast<size_t>(a - start) + static_cast<size_t>(std::countr_zero(diff) >> 3);
+    }
+    a += 8;
+    b += 8;
+  }
+  while (a < limit && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return static_cast<size_t>(a - start);
+}
+
+// 15 in the token nibble, then 255-valued bytes and the remainder
+uint8_t* WriteLength(uint8_t* op, size_t length) {
+  length -= 15;
+  for (; length >= 255; length -= 255) {
+    *op++ = 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+// Emit literals [anchor, anchor + literal_count) and, when match_length > 0, a match; nullptr if it does not fit
+uint8_t* WriteSequence(
+  uint8_t* op, uint8_t* op_end, const uint8_t* anchor, size_t literal_count, size_t distance, size_t match_length) {
+  size_t needed = 1 + literal_count + (literal_count >= 15 ? (literal_count - 15) / 255 + 1 : 0);
+  if (match_length > 0) {
+    const size_t length_code = match_length - kMinMatch;
+    needed += 2 + (length_code >= 15 ? (length_code - 15) / 255 + 1 : 0);
+  }
+  if (static_cast<size_t>(op_end - op) < needed) {
+    return nullptr;
+  }
+
+  uint8_t* token = op++;
+  *token = static_cast<uint8_t>((literal_count >= 15 ? 15 : literal_count) << 4);
+  if (literal_count >= 15) {
+    op = WriteLength(op, literal_count);
+  }
+  if (literal_count > 0) {
+    std::memcpy(op, anchor, literal_count);
+  }
+  op += literal_count;
+  if (match_length == 0) {
+    return op;
+  }
+
+  *op++ = static_cast<uint8_t>(distance);
+  *op++ = static_cast<uint8_t>(distance >> 8);
+  const size_t length_code = match_length - kMinMatch;
+  *token |= static_cast<uint8_t>(length_code >= 15 ? 15 : length_code);
+  if (length_code >= 15) {
+    op = WriteLength(op, length_code);
+  }
+  return op;
+}
+
+// Extra length bytes after a 15 nibble; false when they run past the input or past limit
+bool ReadLength(const uint8_t*& ip, const uint8_t* ip_end, size_t limit, size_t& length) {
+  uint8_t byte;
+  do {
+    if (ip >= ip_end) {
+      return false;
+    }
+    byte = *ip++;
+    length += byte;
+    if (length > limit) {
+      return false;
+    }
+  } while (byte == 255);
+  return true;
+}
+
+void CopyMatch(uint8_t* out, size_t distance, size_t length, size_t room) {
+  const uint8_t* from = out - distance;
+  if (distance >= 16 && room >= length + 16) {
+    for (size_t i = 0; i < length; i += 16) {
+      std::memcpy(out + i, from + i, 16);
+    }
+  } else if (distance >= 8 && room >= length + 8) {
+    for (size_t i = 0; i < length; i += 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, from + i, sizeof(chunk));
+      std::memcpy(out + i, &chunk, sizeof(chunk));
+    }
+  } else if (distance >= length) {
+    std::memcpy(out, from, length);
+  } else if (distance == 1) {
+    std::memset(out, *from, length);
+  } else {
+    // Overlapping match repeats the last `distance` bytes: every copy doubles the pattern written so far
+    for (size_t copied = 0; copied < length;) {
+      const size_t count = (std::min)(distance + copied, length - copied);
+      std::memcpy(out + copied, from, count);
+      copied += count;
+    }
+  }
+}
+}  // namespace
+
+size_t Lz4CompressBound(size_t size) {
+  return size + size / 255 + 16;
+}
+
+size_t Lz4Compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity) {
+  uint8_t* op = dst;
+  uint8_t* const op_end = dst + dst_capacity;
+  const uint8_t* anchor = src;
+  const uint8_t* const ip_end = src + src_size;
+
+  if (src_size > kMatchFindLimit) {
+    // Positions relative to src; a stale or colliding entry fails the distance / content check below
+    std::array<uint32_t, size_t{1} << kHashLog> table{};
+    const uint8_t* const match_limit = ip_end - kLastLiterals;
+    const uint8_t* const search_limit = ip_end - kMatchFindLimit;
+
+    const uint8_t* ip = src;
+    while (ip <= search_limit) {
+      const uint32_t sequence = Read32(ip);
+      const uint32_t hash = HashSequence(sequence);
+      const uint8_t* candidate = src + table[hash];
+      table[hash] = static_cast<uint32_t>(ip - src);
+      if (candidate >= ip || static_cast<size_t>(ip - candidate) > kMaxDistance || Read32(candidate) != sequence) {
+        ip += 1 + (static_cast<size_t>(ip - anchor) >> kSkipStrength);
+        continue;
+      }
+
+      // Extend backwards over pending literals, then forwards up to the last-literals boundary
+      while (ip > anchor && candidate > src && ip[-1] == candidate[-1]) {
+        --ip;
+        --candidate;
+      }
+      const size_t match_length = kMinMatch + CountMatch(ip + kMinMatch, candidate + kMinMatch, match_limit);
+      op = WriteSequence(op, op_end, anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - candidate), match_length);
+      if (op == nullptr) {
+        return 0;
+      }
+      ip += match_length;
+      anchor = ip;
+
+      // Index a position inside the match so the next search can chain onto it
+      if (ip <= search_limit) {
+        table[HashSequence(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+      }
+    }
+  }
+
+  op = WriteSequence(op, op_end, anchor, static_cast<size_t>(ip_end - anchor), 0, 0);
+  return op != nullptr ? static_cast<size_t>(op - dst) : 0;
+}
+
+bool Lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+  const uint8_t* ip = src;
+  const uint8_t* const ip_end = src + src_size;
+  uint8_t* op = dst;
+  uint8_t* const op_end = dst + dst_size;
+
+  for (;;) {
+    if (ip >= ip_end) {
+      return false;
+    }
+    const uint8_t token = *ip++;
+
+    size_t literal_count = token >> 4;
+    if (literal_count == 15 && !ReadLength(ip, ip_end, dst_size, literal_count)) {
+      return false;
+    }
+    if (literal_count > static_cast<size_t>(ip_end - ip) || literal_count > static_cast<size_t>(op_end - op)) {
+      return false;
+    }
+    // Short literal runs copy a fixed 16 bytes when both buffers have the room
+    if (literal_count <= 16 && ip_end - ip >= 16 && op_end - op >= 16) {
+      std::memcpy(op, ip, 16);
+    } else if (literal_count > 0) {
+      std::memcpy(op, ip, literal_count);
+    }
+    ip += literal_count;
+    op += literal_count;
+
+    // The last sequence is literals only
+    if (ip == ip_end) {
+      return op == op_end;
+    }
+
+    if (ip_end - ip < 2) {
+      return false;
+    }
+    const size_t distance = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    if (distance == 0 || distance > static_cast<size_t>(op - dst)) {
+      return false;
+    }
+
+    size_t match_length = token & 15;
+    if (match_length == 15 && !ReadLength(ip, ip_end, dst_size, match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (match_length > static_cast<size_t>(op_end - op)) {
+      return false;
+    }
+    CopyMatch(op, distance, match_length, static_cast<size_t>(op_end - op));
+    op += match_length;
+  }
+}
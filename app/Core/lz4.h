@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4: Block format compressor and decompressor (no frame format, no dictionaries). Compression is the
+// greedy single-probe hash search of the reference "fast" mode; decompression validates every length and
+// offset, so malformed input fails instead of reading or writing out of bounds.
+
+// Worst-case compressed size of size input bytes
+size_t Lz4CompressBound(size_t size);
+
+// Compress src into dst; returns the compressed size, or 0 when the result does not fit dst_capacity
+size_t Lz4Compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity);
+
+// Decompress one block that decodes to exactly dst_size bytes; false on malformed input or any other size
+bool Lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
@@ -0,0 +1,137 @@
+#include "mapped_file.h"
+
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    is_open_ = std::exchange(other.is_open_, false);
+#ifdef _WIN32
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& file_path) {
+  Close();
+
+#ifdef _WIN32
+  HANDLE file =
+    CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    std::cerr << "[MappedFile] Failed to open " << file_path.string() << '\n';
+    return false;
+  }
+
+  LARGE_INTEGER file_size = {};
+  if (!GetFileSizeEx(file, &file_size)) {
+    std::cerr << "[MappedFile] Failed to query the size of " << file_path.string() << '\n';
+    CloseHandle(file);
+    return false;
+  }
+
+  file_handle_ = file;
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  is_open_ = true;
+  if (size_ == 0) {
+    return true;  // Zero-length files cannot be mapped
+  }
+
+  mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle_ == nullptr) {
+    std::cerr << "[MappedFile] Failed to create a mapping of " << file_path.string() << '\n';
+    Close();
+    return false;
+  }
+
+  data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    std::cerr << "[MappedFile] Failed to map " << file_path.string() << '\n';
+    Close();
+    return false;
+  }
+#else
+  const int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "[MappedFile] Failed to open " << file_path.string() << '\n';
+    return false;
+  }
+
+  struct stat file_stat = {};
+  if (fstat(fd, &file_stat) != 0) {
+    std::cerr << "[MappedFile] Failed to query the size of " << file_path.string() << '\n';
+    close(fd);
+    return false;
+  }
+
+  size_ = static_cast<size_t>(file_stat.st_size);
+  is_open_ = true;
+  if (size_ > 0) {
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      std::cerr << "[MappedFile] Failed to map " << file_path.string() << '\n';
+      close(fd);
+      Close();
+      return false;
+    }
+    data_ = static_cast<const uint8_t*>(mapping);
+  }
+
+  // The mapping keeps its own reference to the file
+  close(fd);
+#endif
+
+  return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+    mapping_handle_ = nullptr;
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+    file_handle_ = nullptr;
+  }
+#else
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+  is_open_ = false;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// MappedFile: Read-only memory mapping of a whole file (CreateFileMapping on Windows, mmap elsewhere).
+// Pages are faulted in on first access, so only the parts of the file that are read cost I/O.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // Map file_path; an empty file opens with GetData() == nullptr
+  bool Open(const std::filesystem::path& file_path);
+  void Close();
+
+  bool IsOpen() const {
+    return is_open_;
+  }
+
+  const uint8_t* GetData() const {
+    return data_;
+  }
+
+  size_t GetSize() const {
+    return size_;
+  }
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  bool is_open_ = false;
+
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
@@ -0,0 +1,815 @@
+#include "mesh_import.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "mapped_file.h"
+
+namespace {
+// Minimal JSON reader for glTF (the whole document becomes a tree; glTF JSON is small next to its buffers)
+struct JsonValue {
+  enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+  Type type = Type::Null;
+  bool boolean = false;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> array;
+  std::vector<std::pair<std::string, JsonValue>> object;
+
+  const JsonValue* Find(std::string_view key) const {
+    for (const auto& [name, value] : object) {
+      if (name == key) {
+        return &value;
+      }
+    }
+    return nullptr;
+  }
+
+  // Member as a number (default when missing or not a number)
+  double GetNumber(std::string_view key, double default_value) const {
+    const JsonValue* value = Find(key);
+    return value != nullptr && value->type == Type::Number ? value->number : default_value;
+  }
+};
+
+const JsonValue* GetArrayElement(const JsonValue* array_value, double index) {
+  if (array_value == nullptr || array_value->type != JsonValue::Type::Array || index < 0.0 ||
+      index >= static_cast<double>(array_value->array.size())) {
+    return nullptr;
+  }
+  return &array_value->array[static_cast<size_t>(index)];
+}
+
+class JsonParser {
+ public:
+  JsonParser(const char* begin, const char* end) : cursor_(begin), end_(end) {
+  }
+
+  bool Parse(JsonValue& out_value) {
+    if (!ParseValue(out_value, 0)) {
+      return false;
+    }
+    SkipWhitespace();
+    return cursor_ == end_;
+  }
+
+ private:
+  static constexpr int kMaxDepth = 64;
+
+  const char* cursor_;
+  const char* end_;
+
+  void SkipWhitespace() {
+    while (cursor_ < end_ && (*cursor_ == ' ' || *cursor_ == '\t' || *cursor_ == '\n' || *cursor_ == '\r')) {
+      ++cursor_;
+    }
+  }
+
+  bool Consume(std::string_view token) {
+    if (static_cast<size_t>(end_ - cursor_) < token.size() || std::memcmp(cursor_, token.data(), token.size()) != 0) {
+      return false;
+    }
+    cursor_ += token.size();
+    return true;
+  }
+
+  bool ParseValue(JsonValue& out_value, int depth) {
+    SkipWhitespace();
+    if (cursor_ == end_ || depth > kMaxDepth) {
+      return false;
+    }
+    switch (*cursor_) {
+      case '{':
+        return ParseObject(out_value, depth);
+      case '[':
+        return ParseArray(out_value, depth);
+      case '"':
+        out_value.type = JsonValue::Type::String;
+        return ParseString(out_value.string);
+      case 't':
+        out_value.type = JsonValue::Type::Bool;
+        out_value.boolean = true;
+        return Consume("true");
+      case 'f':
+        out_value.type = JsonValue::Type::Bool;
+        return Consume("false");
+      case 'n':
+        return Consume("null");
+      default: {
+        out_value.type = JsonValue::Type::Number;
+        const auto result = std::from_chars(cursor_, end_, out_value.number);
+        if (result.ec != std::errc()) {
+          return false;
+        }
+        cursor_ = result.ptr;
+        return true;
+      }
+    }
+  }
+
+  bool ParseObject(JsonValue& out_value, int depth) {
+    out_value.type = JsonValue::Type::Object;
+    ++cursor_;
+    SkipWhitespace();
+    if (Consume("}")) {
+      return true;
+    }
+    for (;;) {
+      SkipWhitespace();
+      std::string key;
+      if (cursor_ == end_ || *cursor_ != '"' || !ParseString(key)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (!Consume(":")) {
+        return false;
+      }
+      out_value.object.emplace_back(std::move(key), JsonValue());
+      if (!ParseValue(out_value.object.back().second, depth + 1)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (Consume("}")) {
+        return true;
+      }
+      if (!Consume(",")) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseArray(JsonValue& out_value, int depth) {
+    out_value.type = JsonValue::Type::Array;
+    ++cursor_;
+    SkipWhitespace();
+    if (Consume("]")) {
+      return true;
+    }
+    for (;;) {
+      out_value.array.emplace_back();
+      if (!ParseValue(out_value.array.back(), depth + 1)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (Consume("]")) {
+        return true;
+      }
+      if (!Consume(",")) {
+        return false;
+      }
+    }
+  }
+
+  static void AppendUtf8(uint32_t code_point, std::string& out) {
+    if (code_point < 0x80) {
+      out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      out += static_cast<char>(0xC0 | (code_point >> 6));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      out += static_cast<char>(0xE0 | (code_point >> 12));
+      out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (code_point >> 18));
+      out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  bool ParseHex4(uint32_t& out_value) {
+    if (end_ - cursor_ < 4) {
+      return false;
+    }
+    const auto result = std::from_chars(cursor_, cursor_ + 4, out_value, 16);
+    if (result.ec != std::errc() || result.ptr != cursor_ + 4) {
+      return false;
+    }
+    cursor_ += 4;
+    return true;
+  }
+
+  bool ParseString(std::string& out_string) {
+    ++cursor_;
+    while (cursor_ < end_) {
+      const char c = *cursor_++;
+      if (c == '"') {
+        return true;
+      }
+      if (c != '\\') {
+        out_string += c;
+        continue;
+      }
+      if (cursor_ == end_) {
+        return false;
+      }
+      const char escape = *cursor_++;
+      switch (escape) {
+        case 'b':
+          out_string += '\b';
+          break;
+        case 'f':
+          out_string += '\f';
+          break;
+        case 'n':
+          out_string += '\n';
+          break;
+        case 'r':
+          out_string += '\r';
+          break;
+        case 't':
+          out_string += '\t';
+          break;
+        case 'u': {
+          uint32_t code_point = 0;
+          if (!ParseHex4(code_point)) {
+            return false;
+          }
+          // Surrogate pair
+          uint32_t low = 0;
+          if (code_point >= 0xD800 && code_point < 0xDC00 && Consume("\\u") && ParseHex4(low) && low >= 0xDC00 && low < 0xE000) {
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(code_point, out_string);
+          break;
+        }
+        default:
+          out_string += escape;  // \" \\ \/
+          break;
+      }
+    }
+    return false;
+  }
+};
+
+// Right-handed (OBJ, glTF) to left-handed: mirror z, then flip winding so front faces stay front faces
+void ConvertToLeftHanded(MeshSourceSubmesh& submesh) {
+  for (size_t i = 2; i < submesh.positions.size(); i += 3) {
+    submesh.positions[i] = -submesh.positions[i];
+  }
+  for (size_t i = 2; i < submesh.normals.size(); i += 3) {
+    submesh.normals[i] = -submesh.normals[i];
+  }
+  for (size_t i = 0; i + 2 < submesh.indices.size(); i += 3) {
+    std::swap(submesh.indices[i + 1], submesh.indices[i + 2]);
+  }
+}
+
+bool ReadWholeFile(const std::filesystem::path& file_path, std::vector<uint8_t>& out_bytes) {
+  MappedFile file;
+  if (!file.Open(file_path)) {
+    return false;
+  }
+  out_bytes.assign(file.GetData(), file.GetData() + file.GetSize());
+  return true;
+}
+
+std::string_view NextToken(std::string_view& line) {
+  const size_t begin = line.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) {
+    line = {};
+    return {};
+  }
+  const size_t end = line.find_first_of(" \t", begin);
+  const std::string_view token = line.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+  line = end == std::string_view::npos ? std::string_view() : line.substr(end);
+  return token;
+}
+
+bool ParseFloats(std::string_view& line, float* out_values, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const std::string_view token = NextToken(line);
+    if (token.empty() || std::from_chars(token.data(), token.data() + token.size(), out_values[i]).ec != std::errc()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// One-based (or negative, relative to the end) OBJ index to a zero-based one; -1 when absent or out of range
+int64_t ResolveObjIndex(std::string_view token, size_t element_count) {
+  int64_t index = 0;
+  if (token.empty() || std::from_chars(token.data(), token.data() + token.size(), index).ec != std::errc() || index == 0) {
+    return -1;
+  }
+  index = index > 0 ? index - 1 : static_cast<int64_t>(element_count) + index;
+  return index >= 0 && index < static_cast<int64_t>(element_count) ? index : -1;
+}
+
+struct ObjSubmeshBuilder {
+  MeshSourceSubmesh submesh;
+  size_t corners_with_texcoord = 0;
+  size_t corners_with_normal = 0;
+};
+
+constexpr uint32_t kGlbMagic = 0x46546C67;      // "glTF"
+constexpr uint32_t kGlbChunkJson = 0x4E4F534A;  // "JSON"
+constexpr uint32_t kGlbChunkBin = 0x004E4942;   // "BIN\0"
+
+constexpr uint32_t kComponentUnsignedByte = 5121;
+constexpr uint32_t kComponentUnsignedShort = 5123;
+constexpr uint32_t kComponentUnsignedInt = 5125;
+constexpr uint32_t kComponentFloat = 5126;
+constexpr uint32_t kModeTriangles = 4;
+
+bool DecodeBase64(std::string_view text, std::vector<uint8_t>& out_bytes) {
+  // Standard and URL-safe alphabets
+  auto decode_char = [](char c) -> int {
+    if (c >= 'A' && c <= 'Z') {
+      return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+      return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+      return c - '0' + 52;
+    }
+    if (c == '+' || c == '-') {
+      return 62;
+    }
+    return (c == '/' || c == '_') ? 63 : -1;
+  };
+
+  out_bytes.clear();
+  out_bytes.reserve(text.size() / 4 * 3);
+  uint32_t accumulator = 0;
+  int bits = 0;
+  for (char c : text) {
+    if (c == '=') {
+      break;
+    }
+    const int value = decode_char(c);
+    if (value < 0) {
+      return false;
+    }
+    accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out_bytes.push_back(static_cast<uint8_t>(accumulator >> bits));
+    }
+  }
+  return true;
+}
+
+// Percent-decoded relative URI
+std::string DecodeUri(std::string_view uri) {
+  std::string decoded;
+  for (size_t i = 0; i < uri.size(); ++i) {
+    uint32_t value = 0;
+    if (uri[i] == '%' && i + 2 < uri.size() && std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ec == std::errc()) {
+      decoded += static_cast<char>(value);
+      i += 2;
+    } else {
+      decoded += uri[i];
+    }
+  }
+  return decoded;
+}
+
+class GltfReader {
+ public:
+  GltfReader(const JsonValue& document, std::vector<std::vector<uint8_t>> buffers) : document_(document), buffers_(std::move(buffers)) {
+  }
+
+  // Accessor as floats, component_count per element (normalized integer components map to [0, 1])
+  bool ReadFloats(double accessor_index, uint32_t component_count, std::vector<float>& out_values) const {
+    Source source;
+    if (!Resolve(accessor_index, component_count, source)) {
+      return false;
+    }
+    out_values.resize(source.count * component_count);
+    for (size_t i = 0; i < source.count; ++i) {
+      const uint8_t* element = source.data + i * source.stride;
+      for (uint32_t c = 0; c < component_count; ++c) {
+        float& value = out_values[i * component_count + c];
+        switch (source.component_type) {
+          case kComponentFloat:
+            std::memcpy(&value, element + c * 4, 4);
+            break;
+          case kComponentUnsignedShort: {
+            uint16_t raw;
+            std::memcpy(&raw, element + c * 2, 2);
+            value = source.normalized ? static_cast<float>(raw) / 65535.0f : static_cast<float>(raw);
+            break;
+          }
+          case kComponentUnsignedByte:
+            value = source.normalized ? static_cast<float>(element[c]) / 255.0f : static_cast<float>(element[c]);
+            break;
+          default:
+            std::cerr << "[MeshImport] Unsupported attribute component type " << source.component_type << '\n';
+            return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool ReadIndices(double accessor_index, std::vector<uint32_t>& out_indices) const {
+    Source source;
+    if (!Resolve(accessor_index, 1, source)) {
+      return false;
+    }
+    out_indices.resize(source.count);
+    for (size_t i = 0; i < source.count; ++i) {
+      const uint8_t* element = source.data + i * source.stride;
+      switch (source.component_type) {
+        case kComponentUnsignedByte:
+          out_indices[i] = element[0];
+          break;
+        case kComponentUnsignedShort: {
+          uint16_t raw;
+          std::memcpy(&raw, element, 2);
+          out_indices[i] = raw;
+          break;
+        }
+        case kComponentUnsignedInt:
+          std::memcpy(&out_indices[i], element, 4);
+          break;
+        default:
+          std::cerr << "[MeshImport] Unsupported index component type " << source.component_type << '\n';
+          return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  struct Source {
+    const uint8_t* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    uint32_t component_type = 0;
+    bool normalized = false;
+  };
+
+  const JsonValue& document_;
+  std::vector<std::vector<uint8_t>> buffers_;
+
+  static uint32_t GetComponentSize(uint32_t component_type) {
+    switch (component_type) {
+      case kComponentUnsignedByte:
+        return 1;
+      case kComponentUnsignedShort:
+        return 2;
+      case kComponentUnsignedInt:
+      case kComponentFloat:
+        return 4;
+      default:
+        return 0;
+    }
+  }
+
+  static uint32_t GetTypeComponentCount(const std::string& type) {
+    constexpr std::string_view kTypes[] = {"SCALAR", "VEC2", "VEC3", "VEC4"};
+    for (uint32_t i = 0; i < std::size(kTypes); ++i) {
+      if (type == kTypes[i]) {
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+
+  bool Resolve(double accessor_index, uint32_t component_count, Source& out_source) const {
+    const JsonValue* accessor = GetArrayElement(document_.Find("accessors"), accessor_index);
+    if (accessor == nullptr) {
+      std::cerr << "[MeshImport] Missing accessor " << accessor_index << '\n';
+      return false;
+    }
+    const JsonValue* type = accessor->Find("type");
+    if (accessor->Find("sparse") != nullptr || type == nullptr || GetTypeComponentCount(type->string) != component_count) {
+      std::cerr << "[MeshImport] Accessor " << accessor_index << " is sparse or has an unexpected type" << '\n';
+      return false;
+    }
+    const JsonValue* view = GetArrayElement(document_.Find("bufferViews"), accessor->GetNumber("bufferView", -1.0));
+    const double buffer_index = view != nullptr ? view->GetNumber("buffer", -1.0) : -1.0;
+    if (view == nullptr || buffer_index < 0.0 || buffer_index >= static_cast<double>(buffers_.size())) {
+      std::cerr << "[MeshImport] Accessor " << accessor_index << " has no buffer view" << '\n';
+      return false;
+    }
+
+    const std::vector<uint8_t>& buffer = buffers_[static_cast<size_t>(buffer_index)];
+    out_source.component_type = static_cast<uint32_t>(accessor->GetNumber("componentType", 0.0));
+    const JsonValue* normalized = accessor->Find("normalized");
+    out_source.normalized = normalized != nullptr && normalized->boolean;
+    out_source.count = static_cast<size_t>(accessor->GetNumber("count", 0.0));
+    const size_t element_size = static_cast<size_t>(GetComponentSize(out_source.component_type)) * component_count;
+    out_source.stride = static_cast<size_t>(view->GetNumber("byteStride", 0.0));
+    if (out_source.stride == 0) {
+      out_source.stride = element_size;
+    }
+
+    const size_t view_offset = static_cast<size_t>(view->GetNumber("byteOffset", 0.0));
+    const size_t view_length = static_cast<size_t>(view->GetNumber("byteLength", 0.0));
+    const size_t accessor_offset = static_cast<size_t>(accessor->GetNumber("byteOffset", 0.0));
+    const size_t extent = out_source.count == 0 ? 0 : accessor_offset + (out_source.count - 1) * out_source.stride + element_size;
+    if (element_size == 0 || view_offset > buffer.size() || view_length > buffer.size() - view_offset || extent > view_length) {
+      std::cerr << "[MeshImport] Accessor " << accessor_index << " out of bounds" << '\n';
+      return false;
+    }
+    out_source.data = buffer.data() + view_offset + accessor_offset;
+    return true;
+  }
+};
+
+bool LoadGltfBuffers(const JsonValue& document,
+  const std::filesystem::path& base_dir,
+  std::vector<uint8_t> glb_bin,
+  std::vector<std::vector<uint8_t>>& out_buffers) {
+  const JsonValue* buffers = document.Find("buffers");
+  if (buffers == nullptr) {
+    return true;
+  }
+  for (size_t i = 0; i < buffers->array.size(); ++i) {
+    const JsonValue* uri = buffers->array[i].Find("uri");
+    std::vector<uint8_t> bytes;
+    if (uri == nullptr) {
+      if (i != 0) {
+        std::cerr << "[MeshImport] Buffer " << i << " has no uri" << '\n';
+        return false;
+      }
+      bytes = std::move(glb_bin);
+    } else if (uri->string.starts_with("data:")) {
+      const size_t comma = uri->string.find(',');
+      if (comma == std::string::npos || uri->string.rfind(";base64", comma) == std::string::npos ||
+          !DecodeBase64(std::string_view(uri->string).substr(comma + 1), bytes)) {
+        std::cerr << "[MeshImport] Buffer " << i << " has an unsupported data uri" << '\n';
+        return false;
+      }
+    } else {
+      const std::filesystem::path buffer_path = base_dir / std::filesystem::path(DecodeUri(uri->string));
+      if (!ReadWholeFile(buffer_path, bytes)) {
+        std::cerr << "[MeshImport] Failed to read " << buffer_path.string() << '\n';
+        return false;
+      }
+    }
+    const size_t byte_length = static_cast<size_t>(buffers->array[i].GetNumber("byteLength", 0.0));
+    if (bytes.size() < byte_length) {
+      std::cerr << "[MeshImport] Buffer " << i << " is shorter than its byteLength" << '\n';
+      return false;
+    }
+    out_buffers.push_back(std::move(bytes));
+  }
+  return true;
+}
+}  // namespace
+
+bool ImportObj(const std::filesystem::path& file_path, MeshSource& out_source) {
+  MappedFile file;
+  if (!file.Open(file_path)) {
+    std::cerr << "[MeshImport] Failed to open " << file_path.string() << '\n';
+    return false;
+  }
+
+  std::vector<float> positions;
+  std::vector<float> texcoords;
+  std::vector<float> normals;
+  std::vector<ObjSubmeshBuilder> builders;
+  std::unordered_map<std::string, size_t> material_submeshes;
+  size_t current = SIZE_MAX;
+
+  std::vector<int64_t> face;  // position / texcoord / normal index triples of the current face
+  std::string_view text(reinterpret_cast<const char*>(file.GetData()), file.GetSize());
+  size_t line_number = 0;
+  while (!text.empty()) {
+    const size_t line_end = text.find('\n');
+    std::string_view line = text.substr(0, line_end);
+    text = line_end == std::string_view::npos ? std::string_view() : text.substr(line_end + 1);
+    ++line_number;
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+
+    const std::string_view keyword = NextToken(line);
+    if (keyword == "v" || keyword == "vn") {
+      float values[3];
+      if (!ParseFloats(line, values, 3)) {
+        std::cerr << "[MeshImport] " << file_path.string() << ":" << line_number << ": malformed " << keyword << '\n';
+        return false;
+      }
+      std::vector<float>& target = (keyword == "v") ? positions : normals;
+      target.insert(target.end(), values, values + 3);
+    } else if (keyword == "vt") {
+      float values[2];
+      if (!ParseFloats(line, values, 2)) {
+        std::cerr << "[MeshImport] " << file_path.string() << ":" << line_number << ": malformed vt" << '\n';
+        return false;
+      }
+      texcoords.push_back(values[0]);
+      texcoords.push_back(1.0f - values[1]);  // Bottom-left origin to top-left
+    } else if (keyword == "usemtl" || (keyword == "f" && current == SIZE_MAX)) {
+      const std::string material = keyword == "usemtl" ? std::string(NextToken(line)) : std::string();
+      const auto [it, inserted] = material_submeshes.try_emplace(material, builders.size());
+      if (inserted) {
+        builders.emplace_back();
+        builders.back().submesh.material_index = static_cast<uint32_t>(out_source.material_names.size());
+        out_source.material_names.push_back(material);
+      }
+      current = it->second;
+    }
+
+    if (keyword != "f") {
+      continue;  // Groups, objects, smoothing groups and material libraries do not affect the geometry
+    }
+
+    face.clear();
+    for (std::string_view corner = NextToken(line); !corner.empty(); corner = NextToken(line)) {
+      const size_t slash = corner.find('/');
+      const size_t second_slash = slash == std::string_view::npos ? std::string_view::npos : corner.find('/', slash + 1);
+      const int64_t position = ResolveObjIndex(corner.substr(0, slash), positions.size() / 3);
+      const int64_t texcoord = slash == std::string_view::npos
+                                 ? -1
+                                 : ResolveObjIndex(corner.substr(slash + 1, second_slash - slash - 1), texcoords.size() / 2);
+      const int64_t normal =
+        second_slash == std::string_view::npos ? -1 : ResolveObjIndex(corner.substr(second_slash + 1), normals.size() / 3);
+      if (position < 0) {
+        std::cerr << "[MeshImport] " << file_path.string() << ":" << line_number << ": bad face index" << '\n';
+        return false;
+      }
+      face.insert(face.end(), {position, texcoord, normal});
+    }
+
+    ObjSubmeshBuilder& builder = builders[current];
+    MeshSourceSubmesh& submesh = builder.submesh;
+    const size_t corner_count = face.size() / 3;
+    for (size_t k = 2; k < corner_count; ++k) {
+      for (size_t corner : {size_t{0}, k - 1, k}) {
+        const int64_t* ids = &face[corner * 3];
+        submesh.indices.push_back(static_cast<uint32_t>(submesh.GetVertexCount()));
+        submesh.positions.insert(submesh.positions.end(), &positions[ids[0] * 3], &positions[ids[0] * 3] + 3);
+        if (ids[1] >= 0) {
+          submesh.texcoords.insert(submesh.texcoords.end(), &texcoords[ids[1] * 2], &texcoords[ids[1] * 2] + 2);
+          ++builder.corners_with_texcoord;
+        } else {
+          submesh.texcoords.insert(submesh.texcoords.end(), {0.0f, 0.0f});
+        }
+        if (ids[2] >= 0) {
+          submesh.normals.insert(submesh.normals.end(), &normals[ids[2] * 3], &normals[ids[2] * 3] + 3);
+          ++builder.corners_with_normal;
+        } else {
+          submesh.normals.insert(submesh.normals.end(), {0.0f, 0.0f, 0.0f});
+        }
+      }
+    }
+  }
+
+  for (ObjSubmeshBuilder& builder : builders) {
+    MeshSourceSubmesh& submesh = builder.submesh;
+    if (submesh.indices.empty()) {
+      continue;
+    }
+    // Partially specified normals are regenerated for the whole submesh; missing texcoords stay 0
+    if (builder.corners_with_normal != submesh.GetVertexCount()) {
+      submesh.normals.clear();
+    }
+    if (builder.corners_with_texcoord == 0) {
+      submesh.texcoords.clear();
+    }
+    ConvertToLeftHanded(submesh);
+    out_source.submeshes.push_back(std::move(submesh));
+  }
+
+  if (out_source.submeshes.empty()) {
+    std::cerr << "[MeshImport] " << file_path.string() << " has no faces" << '\n';
+    return false;
+  }
+  return true;
+}
+
+bool ImportGltf(const std::filesystem::path& file_path, MeshSource& out_source) {
+  std::vector<uint8_t> bytes;
+  if (!ReadWholeFile(file_path, bytes)) {
+    std::cerr << "[MeshImport] Failed to open " << file_path.string() << '\n';
+    return false;
+  }
+
+  // .glb: 12-byte header, then a JSON chunk and an optional binary chunk
+  const char* json_begin = reinterpret_cast<const char*>(bytes.data());
+  const char* json_end = json_begin + bytes.size();
+  std::vector<uint8_t> glb_bin;
+  uint32_t magic = 0;
+  if (bytes.size() >= 4) {
+    std::memcpy(&magic, bytes.data(), 4);
+  }
+  if (magic == kGlbMagic) {
+    size_t offset = 12;
+    bool has_json = false;
+    while (offset + 8 <= bytes.size()) {
+      uint32_t chunk_length = 0;
+      uint32_t chunk_type = 0;
+      std::memcpy(&chunk_length, bytes.data() + offset, 4);
+      std::memcpy(&chunk_type, bytes.data() + offset + 4, 4);
+      offset += 8;
+      if (chunk_length > bytes.size() - offset) {
+        break;
+      }
+      if (chunk_type == kGlbChunkJson && !has_json) {
+        json_begin = reinterpret_cast<const char*>(bytes.data() + offset);
+        json_end = json_begin + chunk_length;
+        has_json = true;
+      } else if (chunk_type == kGlbChunkBin && glb_bin.empty()) {
+        glb_bin.assign(bytes.data() + offset, bytes.data() + offset + chunk_length);
+      }
+      offset += chunk_length;
+    }
+    if (!has_json) {
+      std::cerr << "[MeshImport] " << file_path.string() << " has no JSON chunk" << '\n';
+      return false;
+    }
+  }
+
+  JsonValue document;
+  if (!JsonParser(json_begin, json_end).Parse(document) || document.type != JsonValue::Type::Object) {
+    std::cerr << "[MeshImport] " << file_path.string() << " is not valid glTF JSON" << '\n';
+    return false;
+  }
+
+  std::vector<std::vector<uint8_t>> buffers;
+  if (!LoadGltfBuffers(document, file_path.parent_path(), std::move(glb_bin), buffers)) {
+    return false;
+  }
+  const GltfReader reader(document, std::move(buffers));
+
+  if (const JsonValue* materials = document.Find("materials")) {
+    for (size_t i = 0; i < materials->array.size(); ++i) {
+      const JsonValue* name = materials->array[i].Find("name");
+      out_source.material_names.push_back(name != nullptr ? name->string : "material" + std::to_string(i));
+    }
+  }
+
+  const JsonValue* meshes = document.Find("meshes");
+  const size_t mesh_count = meshes != nullptr ? meshes->array.size() : 0;
+  for (size_t m = 0; m < mesh_count; ++m) {
+    const JsonValue* primitives = meshes->array[m].Find("primitives");
+    const size_t primitive_count = primitives != nullptr ? primitives->array.size() : 0;
+    for (size_t p = 0; p < primitive_count; ++p) {
+      const JsonValue& primitive = primitives->array[p];
+      if (primitive.GetNumber("mode", kModeTriangles) != kModeTriangles) {
+        std::cerr << "[MeshImport] Skipping mesh " << m << " primitive " << p << ": not a triangle list" << '\n';
+        continue;
+      }
+      const JsonValue* attributes = primitive.Find("attributes");
+      const JsonValue* position = attributes != nullptr ? attributes->Find("POSITION") : nullptr;
+      if (position == nullptr) {
+        std::cerr << "[MeshImport] Skipping mesh " << m << " primitive " << p << ": no POSITION" << '\n';
+        continue;
+      }
+
+      MeshSourceSubmesh submesh;
+      if (!reader.ReadFloats(position->number, 3, submesh.positions)) {
+        return false;
+      }
+      if (const JsonValue* normal = attributes->Find("NORMAL");
+          normal != nullptr && !reader.ReadFloats(normal->number, 3, submesh.normals)) {
+        return false;
+      }
+      if (const JsonValue* texcoord = attributes->Find("TEXCOORD_0");
+          texcoord != nullptr && !reader.ReadFloats(texcoord->number, 2, submesh.texcoords)) {
+        return false;
+      }
+      if (const JsonValue* indices = primitive.Find("indices")) {
+        if (!reader.ReadIndices(indices->number, submesh.indices)) {
+          return false;
+        }
+      } else {
+        submesh.indices.resize(submesh.GetVertexCount());
+        for (size_t i = 0; i < submesh.indices.size(); ++i) {
+          submesh.indices[i] = static_cast<uint32_t>(i);
+        }
+      }
+      submesh.indices.resize(submesh.indices.size() / 3 * 3);
+      submesh.material_index = static_cast<uint32_t>((std::max)(0.0, primitive.GetNumber("material", 0.0)));
+      ConvertToLeftHanded(submesh);
+      out_source.submeshes.push_back(std::move(submesh));
+    }
+  }
+
+  if (out_source.submeshes.empty()) {
+    std::cerr << "[MeshImport] " << file_path.string() << " has no triangle meshes" << '\n';
+    return false;
+  }
+  return true;
+}
+
+bool ImportMesh(const std::filesystem::path& file_path, MeshSource& out_source) {
+  std::string extension = file_path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  if (extension == ".obj") {
+    return ImportObj(file_path, out_source);
+  }
+  if (extension == ".gltf" || extension == ".glb") {
+    return ImportGltf(file_path, out_source);
+  }
+  std::cerr << "[MeshImport] Unsupported mesh format: " << file_path.string() << '\n';
+  return false;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Triangle meshes read from interchange formats, as input for CookMesh.
+// Importers convert to the engine's left-handed space (z is negated and triangle winding flipped) and to
+// top-left texcoord origin (OBJ v is flipped; glTF already uses it). Node transforms are not applied:
+// every glTF mesh primitive (or OBJ material group) becomes one submesh in its mesh's local space.
+
+struct MeshSourceSubmesh {
+  std::vector<float> positions;  // xyz per vertex
+  std::vector<float> normals;    // xyz per vertex, or empty
+  std::vector<float> texcoords;  // uv per vertex, or empty
+  std::vector<uint32_t> indices; // Triangle list
+  uint32_t material_index = 0;
+
+  size_t GetVertexCount() const {
+    return positions.size() / 3;
+  }
+};
+
+struct MeshSource {
+  std::vector<MeshSourceSubmesh> submeshes;
+  std::vector<std::string> material_names;
+};
+
+// Wavefront OBJ: v / vt / vn / f (polygons are fan-triangulated, negative indices allowed); usemtl starts a
+// new submesh per material. Face corners are emitted unwelded (CookMesh welds them).
+bool ImportObj(const std::filesystem::path& file_path, MeshSource& out_source);
+
+// glTF 2.0, .gltf (external .bin or base64 data URI buffers) or .glb: triangle-list primitives with
+// POSITION and optional NORMAL / TEXCOORD_0 (float, or normalized unsigned byte / short) attributes
+bool ImportGltf(const std::filesystem::path& file_path, MeshSource& out_source);
+
+// Pick the importer from the file extension
+bool ImportMesh(const std::filesystem::path& file_path, MeshSource& out_source);
@@ -0,0 +1,267 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "xxhash.h"
+
+namespace {
+constexpr uint32_t kUnused = ~0u;
+
+// Forsyth's scoring: vertices near the front of the cache and vertices with few triangles left score highest
+constexpr uint32_t kCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr uint32_t kMaxTabulatedValence = 32;
+
+struct ScoreTables {
+  std::array<float, kCacheSize> cache{};
+  std::array<float, kMaxTabulatedValence + 1> valence{};
+
+  ScoreTables() {
+    for (uint32_t position = 0; position < kCacheSize; ++position) {
+      if (position < 3) {
+        // The last triangle's vertices score a fixed value, so it is not simply emitted again
+        cache[position] = kLastTriangleScore;
+      } else {
+        const float scale = 1.0f / static_cast<float>(kCacheSize - 3);
+        cache[position] = std::pow(1.0f - static_cast<float>(position - 3) * scale, kCacheDecayPower);
+      }
+    }
+    for (uint32_t count = 1; count <= kMaxTabulatedValence; ++count) {
+      valence[count] = kValenceBoostScale * std::pow(static_cast<float>(count), -kValenceBoostPower);
+    }
+  }
+
+  float Score(uint32_t cache_position, uint32_t remaining_valence) const {
+    if (remaining_valence == 0) {
+      return -1.0f;  // No triangles left to emit
+    }
+    float score = (cache_position < kCacheSize) ? cache[cache_position] : 0.0f;
+    score += (remaining_valence <= kMaxTabulatedValence)
+               ? valence[remaining_valence]
+               : kValenceBoostScale * std::pow(static_cast<float>(remaining_valence), -kValenceBoostPower);
+    return score;
+  }
+};
+}  // namespace
+
+size_t WeldVertices(const void* vertices, size_t vertex_count, size_t stride, std::vector<uint32_t>& out_remap) {
+  const auto* bytes = static_cast<const uint8_t*>(vertices);
+  out_remap.assign(vertex_count, kUnused);
+
+  // Open addressing over first occurrences, at most half full
+  const size_t table_size = std::bit_ceil((std::max)(vertex_count * 2, size_t{16}));
+  std::vector<uint32_t> table(table_size, kUnused);
+  size_t unique_count = 0;
+  for (size_t i = 0; i < vertex_count; ++i) {
+    const uint8_t* vertex = bytes + i * stride;
+    size_t bucket = static_cast<size_t>(XxHash64(vertex, stride)) & (table_size - 1);
+    for (;;) {
+      const uint32_t first = table[bucket];
+      if (first == kUnused) {
+        table[bucket] = static_cast<uint32_t>(i);
+        out_remap[i] = static_cast<uint32_t>(unique_count++);
+        break;
+      }
+      if (std::memcmp(bytes + static_cast<size_t>(first) * stride, vertex, stride) == 0) {
+        out_remap[i] = out_remap[first];
+        break;
+      }
+      bucket = (bucket + 1) & (table_size - 1);
+    }
+  }
+  return unique_count;
+}
+
+void RemapVertices(const void* src, size_t vertex_count, size_t stride, const std::vector<uint32_t>& remap, void* dst) {
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  for (size_t i = 0; i < vertex_count; ++i) {
+    if (remap[i] != kUnused) {
+      std::memcpy(dst_bytes + static_cast<size_t>(remap[i]) * stride, src_bytes + i * stride, stride);
+    }
+  }
+}
+
+size_t RemoveDegenerateTriangles(uint32_t* indices, size_t index_count) {
+  size_t kept = 0;
+  for (size_t i = 0; i + 2 < index_count; i += 3) {
+    const uint32_t a = indices[i];
+    const uint32_t b = indices[i + 1];
+    const uint32_t c = indices[i + 2];
+    if (a != b && b != c && a != c) {
+      indices[kept++] = a;
+      indices[kept++] = b;
+      indices[kept++] = c;
+    }
+  }
+  return kept;
+}
+
+void OptimizeVertexCache(uint32_t* indices, size_t index_count, size_t vertex_count) {
+  const size_t triangle_count = index_count / 3;
+  if (triangle_count == 0) {
+    return;
+  }
+  static const ScoreTables kTables;
+
+  // Triangles of each vertex (CSR); the first remaining_valence[v] entries are the ones not emitted yet
+  std::vector<uint32_t> remaining_valence(vertex_count, 0);
+  for (size_t i = 0; i < triangle_count * 3; ++i) {
+    assert(indices[i] < vertex_count);
+    ++remaining_valence[indices[i]];
+  }
+  std::vector<uint32_t> adjacency_offset(vertex_count + 1, 0);
+  for (size_t v = 0; v < vertex_count; ++v) {
+    adjacency_offset[v + 1] = adjacency_offset[v] + remaining_valence[v];
+  }
+  std::vector<uint32_t> adjacency(triangle_count * 3);
+  {
+    std::vector<uint32_t> fill(adjacency_offset.begin(), adjacency_offset.end() - 1);
+    for (size_t t = 0; t < triangle_count; ++t) {
+      for (size_t k = 0; k < 3; ++k) {
+        adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+      }
+    }
+  }
+
+  std::vector<uint32_t> cache_position(vertex_count, kUnused);
+  std::vector<float> vertex_score(vertex_count);
+  for (size_t v = 0; v < vertex_count; ++v) {
+    vertex_score[v] = kTables.Score(kUnused, remaining_valence[v]);
+  }
+  std::vector<float> triangle_score(triangle_count);
+  std::vector<uint8_t> emitted(triangle_count, 0);
+  for (size_t t = 0; t < triangle_count; ++t) {
+    triangle_score[t] =
+      vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+  }
+
+  std::vector<uint32_t> output(triangle_count * 3);
+  std::array<uint32_t, kCacheSize + 3> cache{};
+  std::array<uint32_t, kCacheSize + 3> next_cache{};
+  uint32_t cache_count = 0;
+  size_t input_cursor = 0;  // Dead-end fallback: next triangle in input order not emitted yet
+
+  uint32_t best_triangle = 0;
+  for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count) {
+    if (best_triangle == kUnused) {
+      while (emitted[input_cursor] != 0) {
+        ++input_cursor;
+      }
+      best_triangle = static_cast<uint32_t>(input_cursor);
+    }
+
+    const uint32_t* triangle = indices + static_cast<size_t>(best_triangle) * 3;
+    std::memcpy(&output[emitted_count * 3], triangle, 3 * sizeof(uint32_t));
+    emitted[best_triangle] = 1;
+
+    // The triangle's vertices move to the front of the LRU cache; the rest shift back
+    uint32_t next_count = 0;
+    for (size_t k = 0; k < 3; ++k) {
+      const uint32_t v = triangle[k];
+      next_cache[next_count++] = v;
+
+      // Drop the triangle from the vertex's remaining list
+      uint32_t* begin = adjacency.data() + adjacency_offset[v];
+      uint32_t* end = begin + remaining_valence[v];
+      uint32_t* it = std::find(begin, end, best_triangle);
+      assert(it != end);
+      std::swap(*it, *(end - 1));
+      --remaining_valence[v];
+    }
+    for (uint32_t i = 0; i < cache_count; ++i) {
+      const uint32_t v = cache[i];
+      if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+        next_cache[next_count++] = v;
+      }
+    }
+
+    // Rescore the vertices in (or just pushed out of) the cache and their remaining triangles
+    for (uint32_t i = 0; i < next_count; ++i) {
+      const uint32_t v = next_cache[i];
+      cache_position[v] = (i < kCacheSize) ? i : kUnused;
+    }
+    best_triangle = kUnused;
+    float best_score = -1.0f;
+    for (uint32_t i = 0; i < next_count; ++i) {
+      const uint32_t v = next_cache[i];
+      const float score = kTables.Score(cache_position[v], remaining_valence[v]);
+      const float delta = score - vertex_score[v];
+      vertex_score[v] = score;
+      for (uint32_t a = 0; a < remaining_valence[v]; ++a) {
+        const uint32_t t = adjacency[adjacency_offset[v] + a];
+        triangle_score[t] += delta;
+        if (triangle_score[t] > best_score) {
+          best_score = triangle_score[t];
+          best_triangle = t;
+        }
+      }
+    }
+
+    cache_count = (std::min)(next_count, kCacheSize);
+    std::copy(next_cache.begin(), next_cache.begin() + cache_count, cache.begin());
+  }
+
+  std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+size_t OptimizeVertexFetch(uint32_t* indices, size_t index_count, size_t vertex_count, std::vector<uint32_t>& out_remap) {
+  out_remap.assign(vertex_count, kUnused);
+  uint32_t next = 0;
+  for (size_t i = 0; i < index_count; ++i) {
+    uint32_t& remapped = out_remap[indices[i]];
+    if (remapped == kUnused) {
+      remapped = next++;
+    }
+    indices[i] = remapped;
+  }
+  return next;
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t index_count, size_t vertex_count, uint32_t cache_size) {
+  // FIFO: a vertex is in the cache while fewer than cache_size misses happened since its own miss
+  std::vector<uint64_t> miss_time(vertex_count, 0);
+  uint64_t misses = 0;
+  for (size_t i = 0; i < index_count; ++i) {
+    const uint32_t v = indices[i];
+    if (miss_time[v] == 0 || misses + 1 - miss_time[v] > cache_size) {
+      ++misses;
+      miss_time[v] = misses;
+    }
+  }
+
+  VertexCacheStats stats;
+  const size_t triangle_count = index_count / 3;
+  stats.acmr = triangle_count > 0 ? static_cast<float>(misses) / static_cast<float>(triangle_count) : 0.0f;
+  stats.atvr = vertex_count > 0 ? static_cast<float>(misses) / static_cast<float>(vertex_count) : 0.0f;
+  return stats;
+}
+
+float AnalyzeVertexFetch(const uint32_t* indices, size_t index_count, size_t vertex_count, size_t vertex_size) {
+  constexpr size_t kLineSize = 64;
+  constexpr size_t kLineCount = 16 * 1024 / kLineSize;
+  std::array<size_t, kLineCount> tags;
+  tags.fill(~size_t{0});
+
+  size_t fetched = 0;
+  for (size_t i = 0; i < index_count; ++i) {
+    const size_t begin = indices[i] * vertex_size;
+    for (size_t line = begin / kLineSize; line <= (begin + vertex_size - 1) / kLineSize; ++line) {
+      size_t& tag = tags[line % kLineCount];
+      if (tag != line) {
+        tag = line;
+        fetched += kLineSize;
+      }
+    }
+  }
+  const size_t data_size = vertex_count * vertex_size;
+  return data_size > 0 ? static_cast<float>(fetched) / static_cast<float>(data_size) : 0.0f;
+}
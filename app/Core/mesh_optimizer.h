@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mesh optimization passes over triangle lists with 32-bit indices, used by the mesh cooker:
+// welding identical vertices, ordering triangles for the post-transform vertex cache and ordering
+// vertices for fetch locality. The passes only reorder and remap; they never change the rendered result.
+
+// Merge vertices with identical bytes (stride bytes each). out_remap[i] is the new index of vertex i;
+// unique vertices keep the order of their first occurrence. Returns the unique vertex count.
+size_t WeldVertices(const void* vertices, size_t vertex_count, size_t stride, std::vector<uint32_t>& out_remap);
+
+// Gather vertices into their new order: dst[remap[i]] = src[i] (remap as returned by WeldVertices or
+// OptimizeVertexFetch, skipping entries that are ~0u)
+void RemapVertices(const void* src, size_t vertex_count, size_t stride, const std::vector<uint32_t>& remap, void* dst);
+
+// Remove triangles with a repeated index in place; returns the new index count
+size_t RemoveDegenerateTriangles(uint32_t* indices, size_t index_count);
+
+// Reorder triangles for a post-transform vertex cache (Forsyth's linear-speed algorithm, 32 entry LRU
+// model, which also works well for the FIFO / batch caches of real GPUs)
+void OptimizeVertexCache(uint32_t* indices, size_t index_count, size_t vertex_count);
+
+// Renumber vertices in the order the indices first use them, so vertex fetches walk memory forward.
+// Rewrites indices; out_remap[old] = new, ~0u for unused vertices. Returns the used vertex count.
+size_t OptimizeVertexFetch(uint32_t* indices, size_t index_count, size_t vertex_count, std::vector<uint32_t>& out_remap);
+
+struct VertexCacheStats {
+  float acmr = 0.0f;  // Vertex shader invocations per triangle (0.5 is the ideal for regular grids)
+  float atvr = 0.0f;  // Vertex shader invocations per vertex (1.0 is ideal)
+};
+
+// Simulate a FIFO post-transform cache of cache_size entries
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t index_count, size_t vertex_count, uint32_t cache_size = 16);
+
+// Bytes fetched through a 16 KB direct-mapped cache of 64-byte lines, relative to the vertex data size
+// (1.0 means every vertex byte is fetched exactly once)
+float AnalyzeVertexFetch(const uint32_t* indices, size_t index_count, size_t vertex_count, size_t vertex_size);
@@ -0,0 +1,342 @@
+#include "meshlet.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "mesh_optimizer.h"
+
+namespace {
+constexpr uint32_t kNone = ~0u;
+
+// Tie-break between candidates adding the same number of vertices: distance from the meshlet's centroid in
+// average edge lengths, plus this much per unit of (1 - cos) between the triangle and the meshlet normal
+constexpr float kConeWeight = 2.0f;
+
+// Cones wider than this (cosine of the spread) never cull anything useful, so they are disabled
+constexpr float kMinConeSpreadCos = 0.1f;
+
+float Dot(const float a[3], const float b[3]) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+float Length(const float v[3]) {
+  return std::sqrt(Dot(v, v));
+}
+
+// Unit normal of the front face (clockwise, left-handed); zero for zero-area triangles
+void ComputeTriangleNormal(const float* positions, const uint32_t* triangle, float out_normal[3]) {
+  const float* a = positions + static_cast<size_t>(triangle[0]) * 3;
+  const float* b = positions + static_cast<size_t>(triangle[1]) * 3;
+  const float* c = positions + static_cast<size_t>(triangle[2]) * 3;
+  const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  out_normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+  out_normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+  out_normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+  const float length = Length(out_normal);
+  const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+  out_normal[0] *= scale;
+  out_normal[1] *= scale;
+  out_normal[2] *= scale;
+}
+}  // namespace
+
+void BuildMeshlets(uint32_t* indices,
+  size_t index_count,
+  const float* positions,
+  size_t vertex_count,
+  std::vector<Meshlet>& out_meshlets,
+  uint32_t max_vertices,
+  uint32_t max_triangles) {
+  assert(max_vertices >= 3 && max_triangles >= 1);
+  out_meshlets.clear();
+  const size_t triangle_count = index_count / 3;
+  if (triangle_count == 0) {
+    return;
+  }
+
+  // Triangles around each position (CSR). Adjacency goes through welded positions rather than vertex ids,
+  // so meshes with split normals or texcoords still grow connected meshlets.
+  std::vector<uint32_t> position_ids;
+  const size_t position_count = WeldVertices(positions, vertex_count, 3 * sizeof(float), position_ids);
+  std::vector<uint32_t> adjacency_offset(position_count + 1, 0);
+  for (size_t i = 0; i < triangle_count * 3; ++i) {
+    ++adjacency_offset[position_ids[indices[i]] + 1];
+  }
+  for (size_t p = 0; p < position_count; ++p) {
+    adjacency_offset[p + 1] += adjacency_offset[p];
+  }
+  std::vector<uint32_t> adjacency(triangle_count * 3);
+  {
+    std::vector<uint32_t> fill(adjacency_offset.begin(), adjacency_offset.end() - 1);
+    for (size_t t = 0; t < triangle_count; ++t) {
+      for (size_t k = 0; k < 3; ++k) {
+        adjacency[fill[position_ids[indices[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+      }
+    }
+  }
+
+  std::vector<float> centroids(triangle_count * 3);
+  std::vector<float> normals(triangle_count * 3);
+  double edge_sum = 0.0;
+  for (size_t t = 0; t < triangle_count; ++t) {
+    const uint32_t* triangle = indices + t * 3;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < 3; ++k) {
+        sum += positions[static_cast<size_t>(triangle[k]) * 3 + axis];
+      }
+      centroids[t * 3 + axis] = sum / 3.0f;
+    }
+    ComputeTriangleNormal(positions, triangle, &normals[t * 3]);
+    const float* a = positions + static_cast<size_t>(triangle[0]) * 3;
+    const float* b = positions + static_cast<size_t>(triangle[1]) * 3;
+    const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    edge_sum += Length(ab);
+  }
+  const float average_edge = static_cast<float>(edge_sum / static_cast<double>(triangle_count));
+  const float inverse_edge = average_edge > 0.0f ? 1.0f / average_edge : 0.0f;
+
+  std::vector<uint32_t> output;
+  output.reserve(triangle_count * 3);
+  std::vector<uint8_t> emitted(triangle_count, 0);
+  std::vector<uint32_t> vertex_meshlet(vertex_count, kNone);       // Meshlet that already holds the vertex
+  std::vector<uint32_t> candidate_meshlet(triangle_count, kNone);  // Meshlet whose candidate list holds the triangle
+  std::vector<uint32_t> candidates;
+
+  Meshlet current;
+  uint32_t meshlet_id = 0;
+  float centroid_sum[3] = {0.0f, 0.0f, 0.0f};
+  float normal_sum[3] = {0.0f, 0.0f, 0.0f};
+
+  auto add_triangle = [&](uint32_t t) {
+    emitted[t] = 1;
+    for (size_t k = 0; k < 3; ++k) {
+      const uint32_t v = indices[static_cast<size_t>(t) * 3 + k];
+      output.push_back(v);
+      if (vertex_meshlet[v] != meshlet_id) {
+        vertex_meshlet[v] = meshlet_id;
+        ++current.vertex_count;
+      }
+      const uint32_t p = position_ids[v];
+      for (uint32_t a = adjacency_offset[p]; a < adjacency_offset[p + 1]; ++a) {
+        const uint32_t neighbour = adjacency[a];
+        if (emitted[neighbour] == 0 && candidate_meshlet[neighbour] != meshlet_id) {
+          candidate_meshlet[neighbour] = meshlet_id;
+          candidates.push_back(neighbour);
+        }
+      }
+    }
+    for (size_t axis = 0; axis < 3; ++axis) {
+      centroid_sum[axis] += centroids[static_cast<size_t>(t) * 3 + axis];
+      normal_sum[axis] += normals[static_cast<size_t>(t) * 3 + axis];
+    }
+    ++current.triangle_count;
+  };
+
+  auto finish_meshlet = [&]() {
+    out_meshlets.push_back(current);
+    ++meshlet_id;
+    current = {};
+    current.first_index = static_cast<uint32_t>(output.size());
+    candidates.clear();
+    std::fill(std::begin(centroid_sum), std::end(centroid_sum), 0.0f);
+    std::fill(std::begin(normal_sum), std::end(normal_sum), 0.0f);
+  };
+
+  size_t seed_cursor = 0;  // Triangles before it are all emitted
+  size_t emitted_count = 0;
+  while (emitted_count < triangle_count) {
+    uint32_t next = kNone;
+    if (current.triangle_count == 0) {
+      while (emitted[seed_cursor] != 0) {
+        ++seed_cursor;
+      }
+      next = static_cast<uint32_t>(seed_cursor);
+    } else {
+      const float inverse_count = 1.0f / static_cast<float>(current.triangle_count);
+      const float center[3] = {centroid_sum[0] * inverse_count, centroid_sum[1] * inverse_count, centroid_sum[2] * inverse_count};
+      float axis[3] = {normal_sum[0], normal_sum[1], normal_sum[2]};
+      const float axis_length = Length(axis);
+      for (float& component : axis) {
+        component = axis_length > 0.0f ? component / axis_length : 0.0f;
+      }
+
+      uint32_t best_new_vertices = 4;
+      float best_score = std::numeric_limits<float>::max();
+      size_t kept = 0;
+      for (const uint32_t t : candidates) {
+        if (emitted[t] != 0) {
+          continue;  // Dropped from the list
+        }
+        candidates[kept++] = t;
+
+        uint32_t new_vertices = 0;
+        for (size_t k = 0; k < 3; ++k) {
+          new_vertices += vertex_meshlet[indices[static_cast<size_t>(t) * 3 + k]] != meshlet_id ? 1 : 0;
+        }
+        if (current.vertex_count + new_vertices > max_vertices || new_vertices > best_new_vertices) {
+          continue;
+        }
+        const float* centroid = &centroids[static_cast<size_t>(t) * 3];
+        const float offset[3] = {centroid[0] - center[0], centroid[1] - center[1], centroid[2] - center[2]};
+        const float score = Length(offset) * inverse_edge + kConeWeight * (1.0f - Dot(&normals[static_cast<size_t>(t) * 3], axis));
+        if (new_vertices < best_new_vertices || score < best_score) {
+          next = t;
+          best_new_vertices = new_vertices;
+          best_score = score;
+        }
+      }
+      candidates.resize(kept);
+
+      if (next == kNone) {
+        // Full on vertices, or no neighbour left
+        finish_meshlet();
+        continue;
+      }
+    }
+
+    add_triangle(next);
+    ++emitted_count;
+    if (current.triangle_count == max_triangles) {
+      finish_meshlet();
+    }
+  }
+  if (current.triangle_count > 0) {
+    finish_meshlet();
+  }
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+MeshletBounds ComputeMeshletBounds(const uint32_t* indices, uint32_t triangle_count, const float* positions) {
+  MeshletBounds bounds;
+  if (triangle_count == 0) {
+    return bounds;
+  }
+
+  // Sphere around the AABB center
+  float bounds_min[3] = {INFINITY, INFINITY, INFINITY};
+  float bounds_max[3] = {-INFINITY, -INFINITY, -INFINITY};
+  for (uint32_t i = 0; i < triangle_count * 3; ++i) {
+    const float* p = positions + static_cast<size_t>(indices[i]) * 3;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      bounds_min[axis] = (std::min)(bounds_min[axis], p[axis]);
+      bounds_max[axis] = (std::max)(bounds_max[axis], p[axis]);
+    }
+  }
+  for (size_t axis = 0; axis < 3; ++axis) {
+    bounds.center[axis] = (bounds_min[axis] + bounds_max[axis]) * 0.5f;
+  }
+  float radius_squared = 0.0f;
+  for (uint32_t i = 0; i < triangle_count * 3; ++i) {
+    const float* p = positions + static_cast<size_t>(indices[i]) * 3;
+    const float offset[3] = {p[0] - bounds.center[0], p[1] - bounds.center[1], p[2] - bounds.center[2]};
+    radius_squared = (std::max)(radius_squared, Dot(offset, offset));
+  }
+  bounds.radius = std::sqrt(radius_squared);
+
+  // Normal cone: axis along the average normal, opened to the normal furthest from it
+  std::vector<float> normals(static_cast<size_t>(triangle_count) * 3);
+  float axis[3] = {0.0f, 0.0f, 0.0f};
+  for (uint32_t t = 0; t < triangle_count; ++t) {
+    float* normal = &normals[static_cast<size_t>(t) * 3];
+    ComputeTriangleNormal(positions, indices + static_cast<size_t>(t) * 3, normal);
+    axis[0] += normal[0];
+    axis[1] += normal[1];
+    axis[2] += normal[2];
+  }
+  const float axis_length = Length(axis);
+  if (axis_length <= 1e-6f) {
+    return bounds;
+  }
+  for (float& component : axis) {
+    component /= axis_length;
+  }
+
+  float min_cos = 1.0f;
+  for (uint32_t t = 0; t < triangle_count; ++t) {
+    const float* normal = &normals[static_cast<size_t>(t) * 3];
+    if (Dot(normal, normal) > 0.0f) {
+      min_cos = (std::min)(min_cos, Dot(normal, axis));
+    }
+  }
+  std::copy(std::begin(axis), std::end(axis), bounds.cone_axis);
+  bounds.cone_cutoff = min_cos <= kMinConeSpreadCos ? 1.0f : std::sqrt(1.0f - min_cos * min_cos);
+  return bounds;
+}
+
+void ExtractFrustumPlanes(const float* local_to_clip, float out_planes[6][4]) {
+  // clip = [x y z 1] * M, so each clip component is a dot product with a column of M
+  auto column = [&](size_t c, size_t r) {
+    return local_to_clip[r * 4 + c];
+  };
+  for (size_t r = 0; r < 4; ++r) {
+    out_planes[0][r] = column(3, r) + column(0, r);  // -w <= x
+    out_planes[1][r] = column(3, r) - column(0, r);  // x <= w
+    out_planes[2][r] = column(3, r) + column(1, r);  // -w <= y
+    out_planes[3][r] = column(3, r) - column(1, r);  // y <= w
+    out_planes[4][r] = column(2, r);                 // 0 <= z
+    out_planes[5][r] = column(3, r) - column(2, r);  // z <= w
+  }
+  for (size_t p = 0; p < 6; ++p) {
+    const float length = Length(out_planes[p]);
+    if (length > 0.0f) {
+      for (float& value : out_planes[p]) {
+        value /= length;
+      }
+    }
+  }
+}
+
+bool IsMeshletOutsideFrustum(const MeshletBounds& bounds, const float planes[6][4]) {
+  for (size_t p = 0; p < 6; ++p) {
+    if (Dot(planes[p], bounds.center) + planes[p][3] < -bounds.radius) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsMeshletBackfacing(const MeshletBounds& bounds, const float camera_position[3]) {
+  if (bounds.cone_cutoff >= 1.0f) {
+    return false;
+  }
+  // Every triangle faces away when the view direction to any point of the sphere stays inside the cone
+  const float view[3] = {
+    bounds.center[0] - camera_position[0],
+    bounds.center[1] - camera_position[1],
+    bounds.center[2] - camera_position[2],
+  };
+  return Dot(view, bounds.cone_axis) >= bounds.cone_cutoff * Length(view) + bounds.radius;
+}
+
+void CullMeshlets(const MeshletBounds* bounds,
+  size_t meshlet_count,
+  const float* local_to_clip,
+  const float* camera_position,
+  std::vector<uint32_t>& out_visible,
+  MeshletCullStats* stats) {
+  float planes[6][4];
+  ExtractFrustumPlanes(local_to_clip, planes);
+
+  size_t frustum_culled = 0;
+  size_t cone_culled = 0;
+  for (size_t i = 0; i < meshlet_count; ++i) {
+    if (IsMeshletOutsideFrustum(bounds[i], planes)) {
+      ++frustum_culled;
+    } else if (camera_position != nullptr && IsMeshletBackfacing(bounds[i], camera_position)) {
+      ++cone_culled;
+    } else {
+      out_visible.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  if (stats != nullptr) {
+    stats->tested += meshlet_count;
+    stats->frustum_culled += frustum_culled;
+    stats->cone_culled += cone_culled;
+  }
+}
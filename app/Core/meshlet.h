@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Meshlets: small clusters of a triangle list (at most kMeshletMaxVertices unique vertices and
+// kMeshletMaxTriangles triangles, the sizes mesh shaders are tuned for) with bounds for per-cluster culling.
+// The builder reorders indices so each meshlet is a contiguous index range, which lets the CPU path draw
+// the visible meshlets as indexed sub-draws of the unchanged index buffer.
+//
+// Matrices are 16 floats in XMFLOAT4X4 layout (row-major, row vector): clip = [x y z 1] * M, with D3D
+// clip space (0 <= z <= w). Front faces are clockwise in a left-handed space.
+
+constexpr uint32_t kMeshletMaxVertices = 64;
+constexpr uint32_t kMeshletMaxTriangles = 124;
+
+struct Meshlet {
+  uint32_t first_index = 0;  // Into the reordered index list
+  uint32_t triangle_count = 0;
+  uint32_t vertex_count = 0;  // Unique vertices referenced
+};
+
+struct MeshletBounds {
+  float center[3] = {0.0f, 0.0f, 0.0f};
+  float radius = 0.0f;
+  float cone_axis[3] = {0.0f, 0.0f, 1.0f};  // Average front-face normal
+  float cone_cutoff = 1.0f;                 // Sine of the normal spread around the axis; 1 disables cone culling
+};
+
+// Group the triangles of an indexed list (positions are tightly packed xyz per vertex) into meshlets,
+// reordering indices in place. Greedy: each meshlet grows from a seed triangle through triangles sharing
+// a position with it, preferring those that add the fewest vertices, then the closest ones facing the same way.
+// Triangles with no remaining neighbour start a new meshlet, so disconnected parts never share one.
+void BuildMeshlets(uint32_t* indices,
+  size_t index_count,
+  const float* positions,
+  size_t vertex_count,
+  std::vector<Meshlet>& out_meshlets,
+  uint32_t max_vertices = kMeshletMaxVertices,
+  uint32_t max_triangles = kMeshletMaxTriangles);
+
+// Bounding sphere and normal cone of triangle_count triangles starting at indices
+MeshletBounds ComputeMeshletBounds(const uint32_t* indices, uint32_t triangle_count, const float* positions);
+
+// Inward-facing frustum planes (a, b, c, d with dot(n, p) + d >= 0 inside, n normalized) in the space
+// local_to_clip maps from: left, right, bottom, top, near, far
+void ExtractFrustumPlanes(const float* local_to_clip, float out_planes[6][4]);
+
+// Conservative tests: true only when no part of the meshlet can be visible
+bool IsMeshletOutsideFrustum(const MeshletBounds& bounds, const float planes[6][4]);
+bool IsMeshletBackfacing(const MeshletBounds& bounds, const float camera_position[3]);
+
+struct MeshletCullStats {
+  size_t tested = 0;
+  size_t frustum_culled = 0;
+  size_t cone_culled = 0;
+};
+
+// Append the indices of meshlets that pass frustum and backface-cone culling to out_visible.
+// camera_position is in the meshlets' local space; pass nullptr to skip cone culling (the cone test needs
+// local-to-world to preserve angles, i.e. no non-uniform scale).
+void CullMeshlets(const MeshletBounds* bounds,
+  size_t meshlet_count,
+  const float* local_to_clip,
+  const float* camera_position,
+  std::vector<uint32_t>& out_visible,
+  MeshletCullStats* stats = nullptr);
@@ -0,0 +1,488 @@
+#include "mip_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <latch>
+#include <numbers>
+
+#include "profiler.h"
+#include "thread_pool.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MIP_GENERATOR_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define MIP_GENERATOR_USE_SSE 0
+#endif
+
+// AVX2 kernels are compiled for x64 regardless of the target flags and selected at runtime
+#if defined(_M_X64) || defined(__x86_64__)
+#define MIP_GENERATOR_USE_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MIP_GENERATOR_AVX2_TARGET
+#else
+#define MIP_GENERATOR_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define MIP_GENERATOR_USE_AVX2 0
+#endif
+
+namespace {
+constexpr uint32_t kChannels = Image::kBytesPerPixel;
+constexpr uint32_t kMinRowsPerBand = 16;
+
+// sRGB <-> linear transfer (IEC 61966-2-1)
+double SrgbToLinear(double c) {
+  return (c <= 0.04045) ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+struct SrgbTables {
+  std::array<float, 256> to_linear{};
+  // encode_threshold[i]: smallest linear value that rounds to sRGB code i + 1
+  std::array<float, 255> encode_threshold{};
+
+  SrgbTables() {
+    for (int i = 0; i < 256; ++i) {
+      to_linear[i] = static_cast<float>(SrgbToLinear(i / 255.0));
+    }
+    for (int i = 0; i < 255; ++i) {
+      encode_threshold[i] = static_cast<float>(SrgbToLinear((i + 0.5) / 255.0));
+    }
+  }
+};
+
+const SrgbTables& GetSrgbTables() {
+  static const SrgbTables tables;
+  return tables;
+}
+
+uint8_t EncodeSrgb8(const SrgbTables& tables, float linear) {
+  return static_cast<uint8_t>(std::upper_bound(tables.encode_threshold.begin(), tables.encode_threshold.end(), linear) -
+                              tables.encode_threshold.begin());
+}
+
+uint8_t EncodeUnorm8(float value) {
+  return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+bool HasAvx2() {
+#if MIP_GENERATOR_USE_AVX2
+#ifdef _MSC_VER
+  static const bool supported = [] {
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+      return false;
+    }
+    // AVX state must be enabled by the OS (OSXSAVE + XCR0 XMM / YMM bits)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+      return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+  }();
+  return supported;
+#else
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#endif
+#else
+  return false;
+#endif
+}
+
+// RGBA float working image (linear, premultiplied unless the source already was)
+struct FloatImage {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<float> pixels;
+
+  void Resize(uint32_t new_width, uint32_t new_height) {
+    width = new_width;
+    height = new_height;
+    pixels.resize(static_cast<size_t>(width) * height * kChannels);
+  }
+
+  float* GetRow(uint32_t y) {
+    return pixels.data() + static_cast<size_t>(y) * width * kChannels;
+  }
+  const float* GetRow(uint32_t y) const {
+    return pixels.data() + static_cast<size_t>(y) * width * kChannels;
+  }
+};
+
+// Separable 2:1 downsampling kernel: output texel x reads source texels 2x + offset .. 2x + offset + tap_count - 1
+struct Kernel {
+  int offset = 0;
+  int tap_count = 0;
+  std::array<float, 8> weights{};
+};
+
+double BesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+Kernel BuildKernel(MipFilter filter) {
+  Kernel kernel;
+  if (filter == MipFilter::Box) {
+    kernel.offset = 0;
+    kernel.tap_count = 2;
+    kernel.weights[0] = 0.5f;
+    kernel.weights[1] = 0.5f;
+    return kernel;
+  }
+
+  // Windowed sinc with a radius of 2 output texels (8 source taps), Kaiser window with alpha = 4
+  constexpr double kRadius = 2.0;
+  constexpr double kAlpha = 4.0;
+  kernel.offset = -3;
+  kernel.tap_count = 8;
+  std::array<double, 8> weights{};
+  double total = 0.0;
+  for (int tap = 0; tap < kernel.tap_count; ++tap) {
+    // Distance from the output texel center in output texels
+    const double t = ((tap + kernel.offset + 0.5) - 1.0) * 0.5;
+    const double sinc = (t == 0.0) ? 1.0 : std::sin(std::numbers::pi * t) / (std::numbers::pi * t);
+    const double ratio = t / kRadius;
+    const double window = BesselI0(kAlpha * std::sqrt((std::max)(0.0, 1.0 - ratio * ratio))) / BesselI0(kAlpha);
+    weights[tap] = sinc * window;
+    total += weights[tap];
+  }
+  for (int tap = 0; tap < kernel.tap_count; ++tap) {
+    kernel.weights[tap] = static_cast<float>(weights[tap] / total);
+  }
+  return kernel;
+}
+
+// Run fn(first_row, end_row) over bands of rows on the pool's workers (inline without workers)
+template <typename Fn>
+void ParallelRows(ThreadPool* pool, uint32_t row_count, const Fn& fn) {
+  const uint32_t worker_count = (pool != nullptr) ? pool->GetWorkerCount() : 0;
+  const uint32_t band_count = (std::min)(worker_count * 4, row_count / kMinRowsPerBand);
+  if (band_count <= 1) {
+    fn(0u, row_count);
+    return;
+  }
+
+  std::latch done(band_count);
+  for (uint32_t band = 0; band < band_count; ++band) {
+    const uint32_t first_row = row_count * band / band_count;
+    const uint32_t end_row = row_count * (band + 1) / band_count;
+    pool->Submit([&fn, first_row, end_row, &done] {
+      fn(first_row, end_row);
+      done.count_down();
+    });
+  }
+  done.wait();
+}
+
+// ---- Conversion ----
+
+void DecodeRows(const Image& src, const MipGenerationOptions& options, FloatImage& dst, uint32_t first_row, uint32_t end_row) {
+  const SrgbTables& tables = GetSrgbTables();
+  const bool premultiply = options.alpha_mode == MipAlphaMode::Straight;
+  constexpr float kInv255 = 1.0f / 255.0f;
+
+#if MIP_GENERATOR_USE_SSE
+  if (!options.force_scalar) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 inv255 = _mm_set1_ps(kInv255);
+    const __m128 alpha_lane = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (uint32_t y = first_row; y < end_row; ++y) {
+      const uint8_t* in = src.GetPixel(0, y);
+      float* out = dst.GetRow(y);
+      for (uint32_t x = 0; x < src.width; ++x, in += kChannels, out += kChannels) {
+        int32_t packed = 0;
+        std::memcpy(&packed, in, sizeof(packed));
+        const __m128i widened = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+        __m128 texel = _mm_mul_ps(_mm_cvtepi32_ps(widened), inv255);
+        if (options.srgb) {
+          const __m128 color = _mm_setr_ps(tables.to_linear[in[0]], tables.to_linear[in[1]], tables.to_linear[in[2]], 0.0f);
+          texel = _mm_or_ps(_mm_andnot_ps(alpha_lane, color), _mm_and_ps(alpha_lane, texel));
+        }
+        if (premultiply) {
+          // (a, a, a, 1)
+          const __m128 alpha = _mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 3, 3));
+          texel = _mm_mul_ps(texel, _mm_or_ps(_mm_andnot_ps(alpha_lane, alpha), _mm_and_ps(alpha_lane, one)));
+        }
+        _mm_storeu_ps(out, texel);
+      }
+    }
+    return;
+  }
+#endif
+
+  for (uint32_t y = first_row; y < end_row; ++y) {
+    const uint8_t* in = src.GetPixel(0, y);
+    float* out = dst.GetRow(y);
+    for (uint32_t x = 0; x < src.width; ++x, in += kChannels, out += kChannels) {
+      const float alpha = in[3] * kInv255;
+      const float scale = premultiply ? alpha : 1.0f;
+      for (uint32_t c = 0; c < 3; ++c) {
+        out[c] = (options.srgb ? tables.to_linear[in[c]] : in[c] * kInv255) * scale;
+      }
+      out[3] = alpha;
+    }
+  }
+}
+
+void EncodeRows(const FloatImage& src, const MipGenerationOptions& options, Image& dst, uint32_t first_row, uint32_t end_row) {
+  const SrgbTables& tables = GetSrgbTables();
+  const bool unpremultiply = options.alpha_mode == MipAlphaMode::Straight;
+
+#if MIP_GENERATOR_USE_SSE
+  if (!options.force_scalar) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale_255 = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 alpha_lane = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    for (uint32_t y = first_row; y < end_row; ++y) {
+      const float* in = src.GetRow(y);
+      uint8_t* out = dst.GetPixel(0, y);
+      for (uint32_t x = 0; x < src.width; ++x, in += kChannels, out += kChannels) {
+        const float alpha = std::clamp(in[3], 0.0f, 1.0f);
+        const float scale = !unpremultiply ? 1.0f : (alpha > 0.0f ? 1.0f / alpha : 0.0f);
+        __m128 texel = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(scale)), zero), one);
+        texel = _mm_or_ps(_mm_andnot_ps(alpha_lane, texel), _mm_and_ps(alpha_lane, _mm_set1_ps(alpha)));
+
+        if (options.srgb) {
+          alignas(16) float values[4];
+          _mm_store_ps(values, texel);
+          out[0] = EncodeSrgb8(tables, values[0]);
+          out[1] = EncodeSrgb8(tables, values[1]);
+          out[2] = EncodeSrgb8(tables, values[2]);
+          out[3] = EncodeUnorm8(alpha);
+        } else {
+          const __m128i quantized = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(texel, scale_255), half));
+          const __m128i words = _mm_packs_epi32(quantized, quantized);
+          const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+          std::memcpy(out, &packed, sizeof(packed));
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  for (uint32_t y = first_row; y < end_row; ++y) {
+    const float* in = src.GetRow(y);
+    uint8_t* out = dst.GetPixel(0, y);
+    for (uint32_t x = 0; x < src.width; ++x, in += kChannels, out += kChannels) {
+      const float alpha = std::clamp(in[3], 0.0f, 1.0f);
+      // Undo the alpha weighting; fully transparent texels have no meaningful color left
+      const float scale = !unpremultiply ? 1.0f : (alpha > 0.0f ? 1.0f / alpha : 0.0f);
+      for (uint32_t c = 0; c < 3; ++c) {
+        const float value = std::clamp(in[c] * scale, 0.0f, 1.0f);
+        out[c] = options.srgb ? EncodeSrgb8(tables, value) : EncodeUnorm8(value);
+      }
+      out[3] = EncodeUnorm8(alpha);
+    }
+  }
+}
+
+// ---- Horizontal pass: src (w x h) -> dst (w / 2 x h) ----
+
+void FilterRowsHorizontalScalar(const FloatImage& src, const Kernel& kernel, FloatImage& dst, uint32_t first_row, uint32_t end_row) {
+  const int src_width = static_cast<int>(src.width);
+  for (uint32_t y = first_row; y < end_row; ++y) {
+    const float* in = src.GetRow(y);
+    float* out = dst.GetRow(y);
+    for (uint32_t x = 0; x < dst.width; ++x, out += kChannels) {
+      const int first = static_cast<int>(x) * 2 + kernel.offset;
+      std::array<float, kChannels> sum{};
+      for (int tap = 0; tap < kernel.tap_count; ++tap) {
+        const float* texel = in + static_cast<size_t>(std::clamp(first + tap, 0, src_width - 1)) * kChannels;
+        for (uint32_t c = 0; c < kChannels; ++c) {
+          sum[c] = sum[c] + kernel.weights[tap] * texel[c];
+        }
+      }
+      std::copy(sum.begin(), sum.end(), out);
+    }
+  }
+}
+
+#if MIP_GENERATOR_USE_SSE
+// One RGBA texel per SSE register; the edge clamp only applies to the first / last few outputs
+void FilterRowsHorizontalSse(const FloatImage& src, const Kernel& kernel, FloatImage& dst, uint32_t first_row, uint32_t end_row) {
+  const int src_width = static_cast<int>(src.width);
+  __m128 weights[8] = {};
+  for (int tap = 0; tap < kernel.tap_count; ++tap) {
+    weights[tap] = _mm_set1_ps(kernel.weights[tap]);
+  }
+
+  for (uint32_t y = first_row; y < end_row; ++y) {
+    const float* in = src.GetRow(y);
+    float* out = dst.GetRow(y);
+    for (uint32_t x = 0; x < dst.width; ++x, out += kChannels) {
+      const int first = static_cast<int>(x) * 2 + kernel.offset;
+      __m128 sum = _mm_setzero_ps();
+      if (first >= 0 && first + kernel.tap_count <= src_width) {
+        const float* texel = in + static_cast<size_t>(first) * kChannels;
+        for (int tap = 0; tap < kernel.tap_count; ++tap, texel += kChannels) {
+          sum = _mm_add_ps(sum, _mm_mul_ps(weights[tap], _mm_loadu_ps(texel)));
+        }
+      } else {
+        for (int tap = 0; tap < kernel.tap_count; ++tap) {
+          const float* texel = in + static_cast<size_t>(std::clamp(first + tap, 0, src_width - 1)) * kChannels;
+          sum = _mm_add_ps(sum, _mm_mul_ps(weights[tap], _mm_loadu_ps(texel)));
+        }
+      }
+      _mm_storeu_ps(out, sum);
+    }
+  }
+}
+#endif
+
+// ---- Vertical pass: src (w x h) -> dst (w x h / 2), a weighted sum of whole rows ----
+
+void SumRowsScalar(const std::array<const float*, 8>& rows, const Kernel& kernel, float* out, size_t begin, size_t count) {
+  for (size_t i = begin; i < count; ++i) {
+    float sum = 0.0f;
+    for (int tap = 0; tap < kernel.tap_count; ++tap) {
+      sum = sum + kernel.weights[tap] * rows[tap][i];
+    }
+    out[i] = sum;
+  }
+}
+
+#if MIP_GENERATOR_USE_SSE
+size_t SumRowsSse(const std::array<const float*, 8>& rows, const Kernel& kernel, float* out, size_t begin, size_t count) {
+  size_t i = begin;
+  for (; i + 4 <= count; i += 4) {
+    __m128 sum = _mm_setzero_ps();
+    for (int tap = 0; tap < kernel.tap_count; ++tap) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel.weights[tap]), _mm_loadu_ps(rows[tap] + i)));
+    }
+    _mm_storeu_ps(out + i, sum);
+  }
+  return i;
+}
+#endif
+
+#if MIP_GENERATOR_USE_AVX2
+MIP_GENERATOR_AVX2_TARGET size_t SumRowsAvx2(const std::array<const float*, 8>& rows, const Kernel& kernel, float* out, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (int tap = 0; tap < kernel.tap_count; ++tap) {
+      sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(kernel.weights[tap]), _mm256_loadu_ps(rows[tap] + i)));
+    }
+    _mm256_storeu_ps(out + i, sum);
+  }
+  return i;
+}
+#endif
+
+// Every path evaluates the same multiply / add sequence per float, so all of them produce identical results
+void FilterRowsVertical(
+  const FloatImage& src, const Kernel& kernel, bool use_simd, FloatImage& dst, uint32_t first_row, uint32_t end_row) {
+  const int src_height = static_cast<int>(src.height);
+  const size_t count = static_cast<size_t>(dst.width) * kChannels;
+  [[maybe_unused]] const bool use_avx2 = use_simd && HasAvx2();
+
+  for (uint32_t y = first_row; y < end_row; ++y) {
+    std::array<const float*, 8> rows{};
+    const int first = static_cast<int>(y) * 2 + kernel.offset;
+    for (int tap = 0; tap < kernel.tap_count; ++tap) {
+      rows[tap] = src.GetRow(static_cast<uint32_t>(std::clamp(first + tap, 0, src_height - 1)));
+    }
+
+    float* out = dst.GetRow(y);
+    size_t done = 0;
+#if MIP_GENERATOR_USE_AVX2
+    if (use_avx2) {
+      done = SumRowsAvx2(rows, kernel, out, count);
+    }
+#endif
+#if MIP_GENERATOR_USE_SSE
+    if (use_simd) {
+      done = SumRowsSse(rows, kernel, out, done, count);
+    }
+#endif
+    SumRowsScalar(rows, kernel, out, done, count);
+  }
+}
+
+void Downsample(const FloatImage& src, const Kernel& kernel, const MipGenerationOptions& options, FloatImage& scratch, FloatImage& dst) {
+  const bool use_simd = !options.force_scalar;
+  scratch.Resize((std::max)(1u, src.width / 2), src.height);
+  dst.Resize(scratch.width, (std::max)(1u, src.height / 2));
+
+  ParallelRows(options.pool, scratch.height, [&](uint32_t first_row, uint32_t end_row) {
+#if MIP_GENERATOR_USE_SSE
+    if (use_simd) {
+      FilterRowsHorizontalSse(src, kernel, scratch, first_row, end_row);
+      return;
+    }
+#endif
+    FilterRowsHorizontalScalar(src, kernel, scratch, first_row, end_row);
+  });
+  ParallelRows(options.pool, dst.height, [&](uint32_t first_row, uint32_t end_row) {
+    FilterRowsVertical(scratch, kernel, use_simd, dst, first_row, end_row);
+  });
+}
+}  // namespace
+
+uint32_t CalculateMipCount(uint32_t width, uint32_t height) {
+  return static_cast<uint32_t>(std::bit_width((std::max)(width, height)));
+}
+
+void GenerateMipChain(const Image& source, const MipGenerationOptions& options, std::vector<Image>& out_mips) {
+  PROFILE_SCOPE("GenerateMipChain");
+
+  const uint32_t full_count = CalculateMipCount(source.width, source.height);
+  const uint32_t level_count = (options.max_levels == 0) ? full_count : (std::min)(options.max_levels, full_count);
+
+  out_mips.resize(level_count);
+  if (level_count == 0) {
+    return;
+  }
+  out_mips[0] = source;
+  if (level_count == 1) {
+    return;
+  }
+
+  const Kernel kernel = BuildKernel(options.filter);
+  FloatImage current;
+  FloatImage next;
+  FloatImage scratch;
+  current.Resize(source.width, source.height);
+  ParallelRows(options.pool, source.height, [&](uint32_t first_row, uint32_t end_row) {
+    DecodeRows(source, options, current, first_row, end_row);
+  });
+
+  // Each level filters the previous one at float precision (no 8-bit round trip between levels)
+  for (uint32_t level = 1; level < level_count; ++level) {
+    Downsample(current, kernel, options, scratch, next);
+    std::swap(current, next);
+
+    Image& mip = out_mips[level];
+    mip.Resize(current.width, current.height);
+    ParallelRows(options.pool, current.height, [&](uint32_t first_row, uint32_t end_row) {
+      EncodeRows(current, options, mip, first_row, end_row);
+    });
+  }
+}
+
+const char* GetMipGeneratorSimdPath() {
+  if (HasAvx2()) {
+    return "AVX2";
+  }
+  return MIP_GENERATOR_USE_SSE ? "SSE" : "scalar";
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "image.h"
+
+class ThreadPool;
+
+enum class MipFilter : uint8_t {
+  Box,     // 2x2 average: cheapest, slightly blurry and prone to aliasing on high-frequency content
+  Kaiser,  // 8-tap Kaiser-windowed sinc: sharper mips with less aliasing (may ring slightly on hard edges)
+};
+
+enum class MipAlphaMode : uint8_t {
+  Straight,       // Color is weighted by alpha while filtering, so transparent texels do not bleed into edges
+  Premultiplied,  // Color is already premultiplied: all channels filter independently
+};
+
+struct MipGenerationOptions {
+  MipFilter filter = MipFilter::Box;
+  MipAlphaMode alpha_mode = MipAlphaMode::Straight;
+  bool srgb = false;           // Color channels are sRGB encoded: filter in linear space (alpha is always linear)
+  uint32_t max_levels = 0;     // 0 = full chain down to 1x1
+  ThreadPool* pool = nullptr;  // Rows of each level are filtered on its workers (do not call from a job)
+  bool force_scalar = false;   // Skip the SSE / AVX2 kernels (reference path for verification and benchmarks)
+};
+
+// Number of levels in a full mip chain (down to 1x1)
+uint32_t CalculateMipCount(uint32_t width, uint32_t height);
+
+// Mip chain of source: out_mips[0] is a copy of source, each further level halves the previous one (odd
+// sizes round down). Levels are filtered from the previous level at float precision in linear space with
+// separable kernels and edge clamping; only the output is quantized back to 8 bits.
+void GenerateMipChain(const Image& source, const MipGenerationOptions& options, std::vector<Image>& out_mips);
+
+// Widest kernel path available on this CPU ("AVX2", "SSE" or "scalar")
+const char* GetMipGeneratorSimdPath();
@@ -0,0 +1,337 @@
+#include "occlusion_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define OCCLUSION_BUFFER_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define OCCLUSION_BUFFER_USE_SSE 0
+#endif
+
+namespace {
+constexpr float kMinTriangleArea = 1e-6f;
+
+void TransformPoint(const float* m, float x, float y, float z, float out[4]) {
+  out[0] = x * m[0] + y * m[4] + z * m[8] + m[12];
+  out[1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+  out[2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+  out[3] = x * m[3] + y * m[7] + z * m[11] + m[15];
+}
+
+uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+bool OcclusionBuffer::Initialize(uint32_t width, uint32_t height) {
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  width_ = AlignUp(width, kTileSize);
+  height_ = AlignUp(height, kTileSize);
+  tiles_x_ = width_ / kTileSize;
+  tiles_y_ = height_ / kTileSize;
+
+  depth_.assign(static_cast<size_t>(width_) * height_, 1.0f);
+  tile_max_depth_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, 1.0f);
+  stats_ = {};
+  return true;
+}
+
+void OcclusionBuffer::Clear() {
+  std::fill(depth_.begin(), depth_.end(), 1.0f);
+  std::fill(tile_max_depth_.begin(), tile_max_depth_.end(), 1.0f);
+  stats_ = {};
+}
+
+uint32_t OcclusionBuffer::RasterizeOccluder(
+  const float* local_to_clip, const float* positions, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) {
+  if (depth_.empty() || local_to_clip == nullptr || positions == nullptr || indices == nullptr) {
+    return 0;
+  }
+
+  std::vector<ClipVertex> clip_vertices(vertex_count);
+  for (uint32_t i = 0; i < vertex_count; ++i) {
+    const float* p = positions + static_cast<size_t>(i) * 3;
+    TransformPoint(local_to_clip, p[0], p[1], p[2], &clip_vertices[i].x);
+  }
+
+  const uint32_t triangles_before = stats_.triangles;
+
+  for (uint32_t i = 0; i + 2 < index_count; i += 3) {
+    if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) {
+      continue;
+    }
+
+    const ClipVertex tri[3] = {clip_vertices[indices[i]], clip_vertices[indices[i + 1]], clip_vertices[indices[i + 2]]};
+
+    // Sutherland-Hodgman against the D3D near plane (z >= 0): a triangle becomes at most a quad
+    ClipVertex clipped[4];
+    uint32_t clipped_count = 0;
+    for (uint32_t e = 0; e < 3; ++e) {
+      const ClipVertex& a = tri[e];
+      const ClipVertex& b = tri[(e + 1) % 3];
+      const bool a_inside = a.z >= 0.0f;
+      const bool b_inside = b.z >= 0.0f;
+
+      if (a_inside) {
+        clipped[clipped_count++] = a;
+      }
+      if (a_inside != b_inside) {
+        const float t = a.z / (a.z - b.z);
+        clipped[clipped_count++] = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, 0.0f, a.w + (b.w - a.w) * t};
+      }
+    }
+
+    for (uint32_t v = 1; v + 1 < clipped_count; ++v) {
+      RasterizeClippedTriangle(clipped[0], clipped[v], clipped[v + 1]);
+    }
+  }
+
+  if (stats_.triangles != triangles_before) {
+    ++stats_.occluders;
+  }
+  return stats_.triangles - triangles_before;
+}
+
+void OcclusionBuffer::RasterizeClippedTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) {
+  const ClipVertex* verts[3] = {&v0, &v1, &v2};
+  float sx[3];
+  float sy[3];
+  float sz[3];
+
+  for (int i = 0; i < 3; ++i) {
+    // After near clipping w >= near distance (perspective) or 1 (orthographic)
+    if (verts[i]->w <= 0.0f) {
+      return;
+    }
+    const float inv_w = 1.0f / verts[i]->w;
+    sx[i] = (verts[i]->x * inv_w * 0.5f + 0.5f) * static_cast<float>(width_);
+    sy[i] = (0.5f - verts[i]->y * inv_w * 0.5f) * static_cast<float>(height_);
+    sz[i] = verts[i]->z * inv_w;
+  }
+
+  RasterizeScreenTriangle(sx, sy, sz);
+}
+
+void OcclusionBuffer::RasterizeScreenTriangle(const float* sx, const float* sy, const float* sz) {
+  float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+  if (std::fabs(area) < kMinTriangleArea) {
+    return;
+  }
+
+  // Double-sided: flip winding so that inside is where all edge functions are >= 0
+  int i0 = 0;
+  int i1 = 1;
+  int i2 = 2;
+  if (area < 0.0f) {
+    std::swap(i1, i2);
+    area = -area;
+  }
+
+  // Pixel bounds (pixel centers at +0.5)
+  const float min_fx = (std::min)({sx[0], sx[1], sx[2]});
+  const float max_fx = (std::max)({sx[0], sx[1], sx[2]});
+  const float min_fy = (std::min)({sy[0], sy[1], sy[2]});
+  const float max_fy = (std::max)({sy[0], sy[1], sy[2]});
+
+  if (max_fx < 0.0f || max_fy < 0.0f || min_fx >= static_cast<float>(width_) || min_fy >= static_cast<float>(height_)) {
+    return;
+  }
+
+  const int min_x = (std::max)(0, static_cast<int>(std::floor(min_fx)));
+  const int max_x = (std::min)(static_cast<int>(width_) - 1, static_cast<int>(std::ceil(max_fx)));
+  const int min_y = (std::max)(0, static_cast<int>(std::floor(min_fy)));
+  const int max_y = (std::min)(static_cast<int>(height_) - 1, static_cast<int>(std::ceil(max_fy)));
+
+  // Edge function E(p) = A * p.x + B * p.y + C for edge (a -> b), opposite to the third vertex
+  struct Edge {
+    float a, b, c;
+  };
+  auto make_edge = [&](int ia, int ib) {
+    const float a = sy[ia] - sy[ib];
+    const float b = sx[ib] - sx[ia];
+    return Edge{a, b, -(a * sx[ia] + b * sy[ia])};
+  };
+
+  const Edge e0 = make_edge(i1, i2);  // weight of i0
+  const Edge e1 = make_edge(i2, i0);  // weight of i1
+  const Edge e2 = make_edge(i0, i1);  // weight of i2
+
+  // Depth is affine in screen space: z = dzdx * x + dzdy * y + zc
+  const float inv_area = 1.0f / area;
+  const float dzdx = (e0.a * sz[i0] + e1.a * sz[i1] + e2.a * sz[i2]) * inv_area;
+  const float dzdy = (e0.b * sz[i0] + e1.b * sz[i1] + e2.b * sz[i2]) * inv_area;
+  const float zc = (e0.c * sz[i0] + e1.c * sz[i1] + e2.c * sz[i2]) * inv_area;
+
+#if OCCLUSION_BUFFER_USE_SSE
+  // Rows are a multiple of the tile size, so 4-wide groups starting at a multiple of 4 stay in bounds
+  const int start_x = min_x & ~3;
+  const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+  const __m128 e0_a = _mm_set1_ps(e0.a);
+  const __m128 e1_a = _mm_set1_ps(e1.a);
+  const __m128 e2_a = _mm_set1_ps(e2.a);
+  const __m128 dzdx_v = _mm_set1_ps(dzdx);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (int y = min_y; y <= max_y; ++y) {
+    const float py = static_cast<float>(y) + 0.5f;
+    const float row_e0 = e0.b * py + e0.c;
+    const float row_e1 = e1.b * py + e1.c;
+    const float row_e2 = e2.b * py + e2.c;
+    const float row_z = dzdy * py + zc;
+    float* row = depth_.data() + static_cast<size_t>(y) * width_;
+
+    for (int x = start_x; x <= max_x; x += 4) {
+      const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane_offsets);
+      const __m128 w0 = _mm_add_ps(_mm_mul_ps(e0_a, px), _mm_set1_ps(row_e0));
+      const __m128 w1 = _mm_add_ps(_mm_mul_ps(e1_a, px), _mm_set1_ps(row_e1));
+      const __m128 w2 = _mm_add_ps(_mm_mul_ps(e2_a, px), _mm_set1_ps(row_e2));
+
+      const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+      if (_mm_movemask_ps(inside) == 0) {
+        continue;
+      }
+
+      const __m128 z = _mm_add_ps(_mm_mul_ps(dzdx_v, px), _mm_set1_ps(row_z));
+      const __m128 old_depth = _mm_loadu_ps(row + x);
+      const __m128 new_depth = _mm_min_ps(old_depth, z);
+      _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, new_depth), _mm_andnot_ps(inside, old_depth)));
+    }
+  }
+#else
+  for (int y = min_y; y <= max_y; ++y) {
+    const float py = static_cast<float>(y) + 0.5f;
+    float* row = depth_.data() + static_cast<size_t>(y) * width_;
+
+    for (int x = min_x; x <= max_x; ++x) {
+      const float px = static_cast<float>(x) + 0.5f;
+      if (e0.a * px + e0.b * py + e0.c < 0.0f || e1.a * px + e1.b * py + e1.c < 0.0f || e2.a * px + e2.b * py + e2.c < 0.0f) {
+        continue;
+      }
+      row[x] = (std::min)(row[x], dzdx * px + dzdy * py + zc);
+    }
+  }
+#endif
+
+  ++stats_.triangles;
+}
+
+void OcclusionBuffer::BuildHiZ() {
+  for (uint32_t ty = 0; ty < tiles_y_; ++ty) {
+    for (uint32_t tx = 0; tx < tiles_x_; ++tx) {
+      float max_depth = 0.0f;
+      for (uint32_t y = 0; y < kTileSize; ++y) {
+        const float* row = depth_.data() + static_cast<size_t>(ty * kTileSize + y) * width_ + tx * kTileSize;
+        for (uint32_t x = 0; x < kTileSize; ++x) {
+          max_depth = (std::max)(max_depth, row[x]);
+        }
+      }
+      tile_max_depth_[static_cast<size_t>(ty) * tiles_x_ + tx] = max_depth;
+    }
+  }
+}
+
+bool OcclusionBuffer::ProjectBounds(const float* local_to_clip, const float local_min[3], const float local_max[3], ScreenBounds& out) const {
+  out.min_x = out.min_y = out.min_z = 3.402823466e+38f;
+  out.max_x = out.max_y = -3.402823466e+38f;
+
+  for (int corner = 0; corner < 8; ++corner) {
+    float clip[4];
+    TransformPoint(local_to_clip,
+      (corner & 1) ? local_max[0] : local_min[0],
+      (corner & 2) ? local_max[1] : local_min[1],
+      (corner & 4) ? local_max[2] : local_min[2],
+      clip);
+
+    if (clip[3] <= 0.0f || clip[2] < 0.0f) {
+      return false;
+    }
+
+    const float inv_w = 1.0f / clip[3];
+    const float sx = (clip[0] * inv_w * 0.5f + 0.5f) * static_cast<float>(width_);
+    const float sy = (0.5f - clip[1] * inv_w * 0.5f) * static_cast<float>(height_);
+    out.min_x = (std::min)(out.min_x, sx);
+    out.max_x = (std::max)(out.max_x, sx);
+    out.min_y = (std::min)(out.min_y, sy);
+    out.max_y = (std::max)(out.max_y, sy);
+    out.min_z = (std::min)(out.min_z, clip[2] * inv_w);
+  }
+
+  return true;
+}
+
+bool OcclusionBuffer::IsVisible(const float* local_to_clip, const float local_min[3], const float local_max[3]) {
+  if (depth_.empty()) {
+    return true;
+  }
+
+  ++stats_.tests;
+
+  ScreenBounds bounds;
+  if (!ProjectBounds(local_to_clip, local_min, local_max, bounds)) {
+    return true;
+  }
+
+  // Completely outside the view (or beyond the far plane): nothing would be rasterized anyway
+  if (bounds.max_x < 0.0f || bounds.max_y < 0.0f || bounds.min_x >= static_cast<float>(width_) ||
+      bounds.min_y >= static_cast<float>(height_) || bounds.min_z > 1.0f) {
+    ++stats_.culled;
+    return false;
+  }
+
+  // Every pixel touched by the rect, not just pixel centers
+  const uint32_t min_x = static_cast<uint32_t>((std::max)(0.0f, std::floor(bounds.min_x)));
+  const uint32_t min_y = static_cast<uint32_t>((std::max)(0.0f, std::floor(bounds.min_y)));
+  const uint32_t max_x = (std::min)(width_ - 1, static_cast<uint32_t>((std::max)(0.0f, std::ceil(bounds.max_x) - 1.0f)));
+  const uint32_t max_y = (std::min)(height_ - 1, static_cast<uint32_t>((std::max)(0.0f, std::ceil(bounds.max_y) - 1.0f)));
+
+  for (uint32_t ty = min_y / kTileSize; ty <= max_y / kTileSize; ++ty) {
+    for (uint32_t tx = min_x / kTileSize; tx <= max_x / kTileSize; ++tx) {
+      // Whole tile nearer than the bounds: occluded here
+      if (tile_max_depth_[static_cast<size_t>(ty) * tiles_x_ + tx] < bounds.min_z) {
+        continue;
+      }
+
+      // Refine against the pixels of this tile that overlap the rect
+      const uint32_t x0 = (std::max)(min_x, tx * kTileSize);
+      const uint32_t x1 = (std::min)(max_x, tx * kTileSize + kTileSize - 1);
+      const uint32_t y0 = (std::max)(min_y, ty * kTileSize);
+      const uint32_t y1 = (std::min)(max_y, ty * kTileSize + kTileSize - 1);
+
+      for (uint32_t y = y0; y <= y1; ++y) {
+        const float* row = depth_.data() + static_cast<size_t>(y) * width_;
+        for (uint32_t x = x0; x <= x1; ++x) {
+          if (row[x] >= bounds.min_z) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  ++stats_.culled;
+  return false;
+}
+
+float OcclusionBuffer::ComputeScreenCoverage(const float* local_to_clip, const float local_min[3], const float local_max[3]) const {
+  if (depth_.empty()) {
+    return 0.0f;
+  }
+
+  ScreenBounds bounds;
+  if (!ProjectBounds(local_to_clip, local_min, local_max, bounds)) {
+    return 1.0f;
+  }
+
+  const float w = (std::min)(bounds.max_x, static_cast<float>(width_)) - (std::max)(bounds.min_x, 0.0f);
+  const float h = (std::min)(bounds.max_y, static_cast<float>(height_)) - (std::max)(bounds.min_y, 0.0f);
+  if (w <= 0.0f || h <= 0.0f) {
+    return 0.0f;
+  }
+
+  return (w * h) / (static_cast<float>(width_) * static_cast<float>(height_));
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// OcclusionBuffer: Low-resolution CPU depth buffer for software occlusion culling.
+// Large occluders are rasterized (SSE, 4 pixels per step) into a coarse depth buffer, a per-tile
+// max-depth level is built on top of it, and candidate bounds are tested against that before submission.
+//
+// Matrices are 16 floats in XMFLOAT4X4 layout (row-major, row vector): clip = [x y z 1] * M.
+// Depth follows the D3D convention: 0 = near, 1 = far.
+class OcclusionBuffer {
+ public:
+  static constexpr uint32_t kTileSize = 8;
+
+  struct ScreenBounds {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+    float min_z = 0.0f;  // nearest depth of the bounds
+  };
+
+  struct Stats {
+    uint32_t occluders = 0;
+    uint32_t triangles = 0;
+    uint32_t tests = 0;
+    uint32_t culled = 0;
+  };
+
+  OcclusionBuffer() = default;
+
+  // Width/height are rounded up to the tile size
+  bool Initialize(uint32_t width, uint32_t height);
+
+  // Reset depth to far and clear per-frame stats
+  void Clear();
+
+  // Rasterize an indexed triangle list (positions are tightly packed xyz). Triangles are clipped
+  // against the near plane and drawn double-sided. Returns the number of triangles rasterized.
+  uint32_t RasterizeOccluder(
+    const float* local_to_clip, const float* positions, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count);
+
+  // Build the per-tile max-depth level. Call once after all occluders and before any IsVisible.
+  void BuildHiZ();
+
+  // Conservative test of local-space AABB. Bounds crossing the near plane are always visible.
+  bool IsVisible(const float* local_to_clip, const float local_min[3], const float local_max[3]);
+
+  // Fraction of the screen covered by the projected AABB rectangle (1 if it crosses the near plane)
+  float ComputeScreenCoverage(const float* local_to_clip, const float local_min[3], const float local_max[3]) const;
+
+  uint32_t GetWidth() const {
+    return width_;
+  }
+
+  uint32_t GetHeight() const {
+    return height_;
+  }
+
+  const float* GetDepthData() const {
+    return depth_.data();
+  }
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+ private:
+  struct ClipVertex {
+    float x, y, z, w;
+  };
+
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint32_t tiles_x_ = 0;
+  uint32_t tiles_y_ = 0;
+
+  std::vector<float> depth_;
+  std::vector<float> tile_max_depth_;
+
+  Stats stats_;
+
+  // Returns false if any corner is behind the near plane
+  bool ProjectBounds(const float* local_to_clip, const float local_min[3], const float local_max[3], ScreenBounds& out) const;
+
+  void RasterizeClippedTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+  void RasterizeScreenTriangle(const float* sx, const float* sy, const float* sz);
+};
@@ -0,0 +1,139 @@
+#include "paged_range_allocator.h"
+
+#include <bit>
+
+void PagedRangeAllocator::Initialize(uint64_t page_size) {
+  page_size_ = page_size;
+  Reset();
+}
+
+void PagedRangeAllocator::Reset() {
+  pages_.clear();
+  unused_pages_.clear();
+  empty_page_count_ = 0;
+}
+
+PagedRangeAllocator::Allocation PagedRangeAllocator::Allocate(uint64_t size, uint64_t alignment, bool& new_page) {
+  new_page = false;
+  if (size == 0 || alignment == 0 || !std::has_single_bit(alignment)) {
+    return {};
+  }
+
+  if (size > page_size_) {
+    new_page = true;
+    return AllocateDedicated(size);
+  }
+
+  // First fit over existing pages (older pages first, so newer ones drain and can be released)
+  for (uint32_t page = 0; page < pages_.size(); ++page) {
+    Page& candidate = pages_[page];
+    if (!candidate.active || candidate.dedicated) {
+      continue;
+    }
+
+    const bool was_empty = candidate.allocator.GetAllocationCount() == 0;
+    const RangeAllocator::Allocation range = candidate.allocator.Allocate(size, alignment);
+    if (range.IsValid()) {
+      if (was_empty) {
+        --empty_page_count_;
+      }
+      return {page, range.offset, range.size, range.node};
+    }
+  }
+
+  new_page = true;
+  const uint32_t page = AddPage(page_size_, false);
+  const RangeAllocator::Allocation range = pages_[page].allocator.Allocate(size, alignment);
+  if (!range.IsValid()) {
+    // Offset 0 of an empty page satisfies any alignment, so this is only a guard: hand the page
+    // back and place the request on its own
+    ReleasePage(page);
+    return AllocateDedicated(size);
+  }
+  --empty_page_count_;
+  return {page, range.offset, range.size, range.node};
+}
+
+PagedRangeAllocator::Allocation PagedRangeAllocator::AllocateDedicated(uint64_t size) {
+  // Sized exactly and never shared; offset 0 satisfies any alignment
+  const uint32_t page = AddPage(0, true);
+  pages_[page].dedicated_size = size;
+  --empty_page_count_;
+  return {page, 0, size, RangeAllocator::kInvalidNode};
+}
+
+uint32_t PagedRangeAllocator::Free(const Allocation& allocation, bool release_empty_page) {
+  if (!allocation.IsValid() || !IsPageActive(allocation.page)) {
+    return kInvalidPage;
+  }
+
+  Page& page = pages_[allocation.page];
+  if (page.dedicated) {
+    ++empty_page_count_;
+    ReleasePage(allocation.page);
+    return allocation.page;
+  }
+
+  page.allocator.Free(allocation.node);
+  if (page.allocator.GetAllocationCount() > 0) {
+    return kInvalidPage;
+  }
+
+  // Keep the first empty shared page
+  ++empty_page_count_;
+  if (empty_page_count_ == 1 && !release_empty_page) {
+    return kInvalidPage;
+  }
+
+  ReleasePage(allocation.page);
+  return allocation.page;
+}
+
+PagedRangeAllocator::Stats PagedRangeAllocator::GetStats() const {
+  Stats stats;
+  for (const Page& page : pages_) {
+    if (!page.active) {
+      continue;
+    }
+    ++stats.page_count;
+    if (page.dedicated) {
+      ++stats.dedicated_page_count;
+      ++stats.allocation_count;
+      stats.reserved_bytes += page.dedicated_size;
+      stats.allocated_bytes += page.dedicated_size;
+      continue;
+    }
+    stats.allocation_count += page.allocator.GetAllocationCount();
+    stats.reserved_bytes += page.allocator.GetCapacity();
+    stats.allocated_bytes += page.allocator.GetAllocatedSize();
+    stats.free_block_count += page.allocator.GetFreeBlockCount();
+    const uint64_t largest = page.allocator.GetLargestFreeBlock();
+    stats.largest_free_block = largest > stats.largest_free_block ? largest : stats.largest_free_block;
+  }
+  return stats;
+}
+
+uint32_t PagedRangeAllocator::AddPage(uint64_t size, bool dedicated) {
+  uint32_t page = 0;
+  if (!unused_pages_.empty()) {
+    page = unused_pages_.back();
+    unused_pages_.pop_back();
+  } else {
+    pages_.emplace_back();
+    page = static_cast<uint32_t>(pages_.size() - 1);
+  }
+
+  pages_[page].allocator.Initialize(size);
+  pages_[page].active = true;
+  pages_[page].dedicated = dedicated;
+  pages_[page].dedicated_size = 0;
+  ++empty_page_count_;
+  return page;
+}
+
+void PagedRangeAllocator::ReleasePage(uint32_t page) {
+  --empty_page_count_;
+  pages_[page].active = false;
+  pages_[page].allocator.Initialize(0);
+  unused_pages_.push_back(page);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "range_allocator.h"
+
+// PagedRangeAllocator: Places allocations into a growable set of fixed-size pages (e.g. ID3D12Heaps),
+// each managed by its own RangeAllocator. Requests larger than the page size get a dedicated page.
+//
+// Only bookkeeping lives here; the owner creates the backing memory when Allocate reports a new page
+// and destroys it when Free reports a page as released. One empty page is kept around so a
+// create / destroy pattern at a page boundary does not churn heaps.
+class PagedRangeAllocator {
+ public:
+  static constexpr uint32_t kInvalidPage = ~0u;
+
+  struct Allocation {
+    uint32_t page = kInvalidPage;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t node = RangeAllocator::kInvalidNode;
+
+    bool IsValid() const {
+      return page != kInvalidPage;
+    }
+  };
+
+  struct Stats {
+    uint32_t page_count = 0;
+    uint32_t dedicated_page_count = 0;
+    uint32_t allocation_count = 0;
+    uint64_t reserved_bytes = 0;   // Sum of page sizes
+    uint64_t allocated_bytes = 0;  // Sum of allocation sizes (excludes alignment padding)
+    uint32_t free_block_count = 0;
+    uint64_t largest_free_block = 0;
+
+    // 0 = all free space is one block, 1 = free space is scattered into tiny blocks
+    double GetFragmentation() const {
+      const uint64_t free_bytes = reserved_bytes - allocated_bytes;
+      return free_bytes > 0 ? 1.0 - static_cast<double>(largest_free_block) / static_cast<double>(free_bytes) : 0.0;
+    }
+  };
+
+  PagedRangeAllocator() = default;
+
+  void Initialize(uint64_t page_size);
+
+  // new_page is set when a page had to be added; the caller must back allocation.page with
+  // GetPageSize(allocation.page) bytes (or Free the allocation if that fails)
+  Allocation Allocate(uint64_t size, uint64_t alignment, bool& new_page);
+
+  // Returns the page whose backing memory can be destroyed now, or kInvalidPage.
+  // release_empty_page skips keeping the page around (e.g. its backing memory could not be created).
+  uint32_t Free(const Allocation& allocation, bool release_empty_page = false);
+
+  // Drop every page (the owner destroys all backing memory)
+  void Reset();
+
+  uint64_t GetDefaultPageSize() const {
+    return page_size_;
+  }
+
+  uint64_t GetPageSize(uint32_t page) const {
+    return pages_[page].dedicated ? pages_[page].dedicated_size : pages_[page].allocator.GetCapacity();
+  }
+
+  // Page ids are reused after release, so owners can keep a parallel array indexed by page
+  uint32_t GetPageSlotCount() const {
+    return static_cast<uint32_t>(pages_.size());
+  }
+
+  bool IsPageActive(uint32_t page) const {
+    return page < pages_.size() && pages_[page].active;
+  }
+
+  Stats GetStats() const;
+
+ private:
+  struct Page {
+    RangeAllocator allocator;  // Unused for dedicated pages
+    uint64_t dedicated_size = 0;
+    bool active = false;
+    bool dedicated = false;
+  };
+
+  uint64_t page_size_ = 0;
+  std::vector<Page> pages_;
+  std::vector<uint32_t> unused_pages_;
+  uint32_t empty_page_count_ = 0;  // Active pages without allocations (at most one after Free)
+
+  Allocation AllocateDedicated(uint64_t size);
+
+  // New pages count as empty until their first allocation
+  uint32_t AddPage(uint64_t size, bool dedicated);
+  void ReleasePage(uint32_t page);
+};
@@ -0,0 +1,691 @@
+#include "png_decoder.h"
+
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "inflate.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PNG_DECODER_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define PNG_DECODER_USE_SSE 0
+#endif
+
+namespace {
+constexpr std::array<uint8_t, 8> kSignature = {137, 80, 78, 71, 13, 10, 26, 10};
+constexpr uint32_t kMaxDimension = 1u << 24;
+constexpr uint64_t kMaxPixels = 1ull << 28;
+constexpr uint32_t kSrgbGamma = 45455;  // gAMA value of the sRGB transfer curve (1 / 2.2 * 100000)
+
+enum ColorType : uint8_t {
+  kGray = 0,
+  kRgb = 2,
+  kPalette = 3,
+  kGrayAlpha = 4,
+  kRgba = 6,
+};
+
+struct Adam7Pass {
+  uint32_t x0, y0, dx, dy;
+};
+constexpr std::array<Adam7Pass, 7> kAdam7 = {
+  {{0, 0, 8, 8}, {4, 0, 8, 8}, {0, 4, 4, 8}, {2, 0, 4, 4}, {0, 2, 2, 4}, {1, 0, 2, 2}, {0, 1, 1, 2}}};
+
+struct PngInfo {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint8_t bit_depth = 0;
+  uint8_t color_type = 0;
+  bool interlaced = false;
+  bool srgb = false;  // sRGB chunk or 2.2 gamma
+  uint32_t channels = 0;
+
+  std::array<uint8_t, 256 * 4> palette{};  // RGBA
+  uint32_t palette_size = 0;
+  bool has_color_key = false;
+  std::array<uint16_t, 3> color_key{};  // tRNS for gray / RGB (raw sample values)
+
+  uint32_t BitsPerPixel() const {
+    return channels * bit_depth;
+  }
+  // Byte distance to the corresponding byte of the previous pixel (filters), at least 1
+  uint32_t FilterStride() const {
+    return (BitsPerPixel() + 7) / 8;
+  }
+  size_t RowBytes(uint32_t pixels) const {
+    return (static_cast<size_t>(pixels) * BitsPerPixel() + 7) / 8;
+  }
+};
+
+uint32_t ReadBE32(const uint8_t* p) {
+  return (uint32_t{p[0]} << 24) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 8) | p[3];
+}
+
+bool IsValidFormat(uint8_t color_type, uint8_t bit_depth) {
+  switch (color_type) {
+    case kGray:
+      return bit_depth == 1 || bit_depth == 2 || bit_depth == 4 || bit_depth == 8 || bit_depth == 16;
+    case kPalette:
+      return bit_depth == 1 || bit_depth == 2 || bit_depth == 4 || bit_depth == 8;
+    case kRgb:
+    case kGrayAlpha:
+    case kRgba:
+      return bit_depth == 8 || bit_depth == 16;
+    default:
+      return false;
+  }
+}
+
+uint32_t ChannelCount(uint8_t color_type) {
+  switch (color_type) {
+    case kRgb:
+      return 3;
+    case kGrayAlpha:
+      return 2;
+    case kRgba:
+      return 4;
+    default:
+      return 1;
+  }
+}
+
+// Branch-free form of the spec's predictor: p - a = b - c, p - b = a - c, p - c = a + b - 2c
+uint8_t PaethPredictor(int a, int b, int c) {
+  const int pa = std::abs(b - c);
+  const int pb = std::abs(a - c);
+  const int pc = std::abs(a + b - 2 * c);
+  const int nearest = (pb <= pc) ? b : c;
+  return static_cast<uint8_t>((pa <= pb && pa <= pc) ? a : nearest);
+}
+
+#if PNG_DECODER_USE_SSE
+// One pixel (Stride <= 8 bytes) in the low lanes of a register; memcpy keeps the access within the row
+template <uint32_t Stride>
+__m128i LoadPixel(const uint8_t* p) {
+  uint64_t bytes = 0;
+  std::memcpy(&bytes, p, Stride);
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+}
+
+template <uint32_t Stride>
+void StorePixel(uint8_t* p, __m128i value) {
+  uint64_t bytes;
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(&bytes), value);
+  std::memcpy(p, &bytes, Stride);
+}
+
+// Sub / Avg / Paeth one pixel per step with every byte of the pixel in its own lane. The filters chain
+// through the left neighbour, so pixels stay serial; this pays off from 3-byte pixels up.
+template <uint32_t Stride>
+void UnfilterSubSse(uint8_t* row, size_t row_bytes) {
+  __m128i left = _mm_setzero_si128();
+  for (size_t i = 0; i < row_bytes; i += Stride) {
+    left = _mm_add_epi8(LoadPixel<Stride>(row + i), left);
+    StorePixel<Stride>(row + i, left);
+  }
+}
+
+template <uint32_t Stride>
+void UnfilterAvgSse(uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i left = _mm_setzero_si128();
+  for (size_t i = 0; i < row_bytes; i += Stride) {
+    const __m128i up = LoadPixel<Stride>(prev + i);
+    // _mm_avg_epu8 rounds up; the spec floors
+    const __m128i average = _mm_sub_epi8(_mm_avg_epu8(left, up), _mm_and_si128(_mm_xor_si128(left, up), one));
+    left = _mm_add_epi8(LoadPixel<Stride>(row + i), average);
+    StorePixel<Stride>(row + i, left);
+  }
+}
+
+__m128i Abs16(__m128i value) {
+  return _mm_max_epi16(value, _mm_sub_epi16(_mm_setzero_si128(), value));
+}
+
+template <uint32_t Stride>
+void UnfilterPaethSse(uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i left = zero;       // a, widened to 16 bits
+  __m128i up_left = zero;    // c
+  for (size_t i = 0; i < row_bytes; i += Stride) {
+    const __m128i up = _mm_unpacklo_epi8(LoadPixel<Stride>(prev + i), zero);  // b
+    const __m128i pa = Abs16(_mm_sub_epi16(up, up_left));
+    const __m128i pb = Abs16(_mm_sub_epi16(left, up_left));
+    const __m128i pc = Abs16(_mm_sub_epi16(_mm_add_epi16(left, up), _mm_add_epi16(up_left, up_left)));
+    const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+    // a when pa is smallest, else b when pb is, else c (the spec's tie order)
+    const __m128i use_a = _mm_cmpeq_epi16(pa, smallest);
+    const __m128i use_b = _mm_andnot_si128(use_a, _mm_cmpeq_epi16(pb, smallest));
+    const __m128i use_c = _mm_andnot_si128(_mm_or_si128(use_a, use_b), _mm_set1_epi16(-1));
+    const __m128i nearest =
+      _mm_or_si128(_mm_or_si128(_mm_and_si128(use_a, left), _mm_and_si128(use_b, up)), _mm_and_si128(use_c, up_left));
+
+    const __m128i value = _mm_add_epi8(LoadPixel<Stride>(row + i), _mm_packus_epi16(nearest, nearest));
+    StorePixel<Stride>(row + i, value);
+    left = _mm_unpacklo_epi8(value, zero);
+    up_left = up;
+  }
+}
+#endif
+
+// Sub / Avg / Paeth with the stride known at compile time (the first pixel has no left neighbour)
+template <uint32_t Stride>
+void UnfilterSub(uint8_t* row, size_t row_bytes) {
+#if PNG_DECODER_USE_SSE
+  if constexpr (Stride >= 3) {
+    UnfilterSubSse<Stride>(row, row_bytes);
+    return;
+  }
+#endif
+  for (size_t i = Stride; i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + row[i - Stride]);
+  }
+}
+
+template <uint32_t Stride>
+void UnfilterAvg(uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+#if PNG_DECODER_USE_SSE
+  if constexpr (Stride >= 3) {
+    UnfilterAvgSse<Stride>(row, prev, row_bytes);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < Stride && i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + (prev[i] >> 1));
+  }
+  for (size_t i = Stride; i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + ((row[i - Stride] + prev[i]) >> 1));
+  }
+}
+
+template <uint32_t Stride>
+void UnfilterPaeth(uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+#if PNG_DECODER_USE_SSE
+  if constexpr (Stride >= 3) {
+    UnfilterPaethSse<Stride>(row, prev, row_bytes);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < Stride && i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + prev[i]);
+  }
+  for (size_t i = Stride; i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + PaethPredictor(row[i - Stride], prev[i], prev[i - Stride]));
+  }
+}
+
+void UnfilterUp(uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+  size_t i = 0;
+#if PNG_DECODER_USE_SSE
+  for (; i + 16 <= row_bytes; i += 16) {
+    const __m128i value = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), value);
+  }
+#endif
+  for (; i < row_bytes; ++i) {
+    row[i] = static_cast<uint8_t>(row[i] + prev[i]);
+  }
+}
+
+template <uint32_t Stride>
+bool UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* prev, size_t row_bytes) {
+  switch (filter) {
+    case 0:
+      return true;
+    case 1:
+      UnfilterSub<Stride>(row, row_bytes);
+      return true;
+    case 2:
+      UnfilterUp(row, prev, row_bytes);
+      return true;
+    case 3:
+      UnfilterAvg<Stride>(row, prev, row_bytes);
+      return true;
+    case 4:
+      UnfilterPaeth<Stride>(row, prev, row_bytes);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Reverse the row filter in place; prev is the previous unfiltered row (all zero for the first row)
+bool Unfilter(uint8_t filter, uint8_t* row, const uint8_t* prev, size_t row_bytes, uint32_t stride) {
+  switch (stride) {
+    case 1:
+      return UnfilterRow<1>(filter, row, prev, row_bytes);
+    case 2:
+      return UnfilterRow<2>(filter, row, prev, row_bytes);
+    case 3:
+      return UnfilterRow<3>(filter, row, prev, row_bytes);
+    case 4:
+      return UnfilterRow<4>(filter, row, prev, row_bytes);
+    case 6:
+      return UnfilterRow<6>(filter, row, prev, row_bytes);
+    default:
+      return UnfilterRow<8>(filter, row, prev, row_bytes);
+  }
+}
+
+// Raw sample `index` of an unfiltered row (sub-byte samples are packed MSB first)
+uint16_t ReadSample(const uint8_t* row, size_t index, uint8_t bit_depth) {
+  switch (bit_depth) {
+    case 16:
+      return static_cast<uint16_t>((row[index * 2] << 8) | row[index * 2 + 1]);
+    case 8:
+      return row[index];
+    default: {
+      const size_t bit = index * bit_depth;
+      const uint32_t shift = 8 - bit_depth - static_cast<uint32_t>(bit & 7);
+      return static_cast<uint16_t>((row[bit >> 3] >> shift) & ((1u << bit_depth) - 1));
+    }
+  }
+}
+
+uint8_t ScaleTo8(uint16_t sample, uint8_t bit_depth) {
+  switch (bit_depth) {
+    case 16:
+      return static_cast<uint8_t>((sample * 255u + 32767u) / 65535u);
+    case 8:
+      return static_cast<uint8_t>(sample);
+    default:
+      return static_cast<uint8_t>(sample * (255u / ((1u << bit_depth) - 1)));
+  }
+}
+
+#if PNG_DECODER_USE_SSE
+// Eight big-endian 16-bit samples rounded to 8 bits, (s * 255 + 32767) / 65535 exactly: the high half of
+// s * 255 plus a carry when the low half reaches 65536 - 32895
+__m128i ScaleTo8Sse(__m128i big_endian) {
+  const __m128i samples = _mm_or_si128(_mm_slli_epi16(big_endian, 8), _mm_srli_epi16(big_endian, 8));
+  const __m128i scale = _mm_set1_epi16(255);
+  const __m128i high = _mm_mulhi_epu16(samples, scale);
+  const __m128i low = _mm_mullo_epi16(samples, scale);
+  const __m128i sign = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  const __m128i carry = _mm_cmpgt_epi16(_mm_xor_si128(low, sign), _mm_set1_epi16(static_cast<int16_t>(32640 ^ 0x8000)));
+  return _mm_sub_epi16(high, carry);
+}
+
+// 16 gray bytes to 16 opaque RGBA pixels
+void StoreGraySse(uint8_t* dst, __m128i gray) {
+  const __m128i opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+  const __m128i gray_gray_low = _mm_unpacklo_epi8(gray, gray);
+  const __m128i gray_alpha_low = _mm_unpacklo_epi8(gray, opaque);
+  const __m128i gray_gray_high = _mm_unpackhi_epi8(gray, gray);
+  const __m128i gray_alpha_high = _mm_unpackhi_epi8(gray, opaque);
+  auto* out = reinterpret_cast<__m128i*>(dst);
+  _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(gray_gray_low, gray_alpha_low));
+  _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(gray_gray_low, gray_alpha_low));
+  _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(gray_gray_high, gray_alpha_high));
+  _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(gray_gray_high, gray_alpha_high));
+}
+#endif
+
+// Tightly packed output for the common layouts (no color key); returns false for the rest
+bool ExpandRowFast(const PngInfo& info, const uint8_t* row, uint32_t pixel_count, uint8_t* dst) {
+  uint32_t i = 0;
+  if (info.bit_depth == 8) {
+    switch (info.color_type) {
+      case kRgba:
+        std::memcpy(dst, row, static_cast<size_t>(pixel_count) * 4);
+        return true;
+      case kRgb:
+        for (; i < pixel_count; ++i, row += 3, dst += 4) {
+          dst[0] = row[0];
+          dst[1] = row[1];
+          dst[2] = row[2];
+          dst[3] = 255;
+        }
+        return true;
+      case kGray:
+#if PNG_DECODER_USE_SSE
+        for (; i + 16 <= pixel_count; i += 16) {
+          StoreGraySse(dst + i * 4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)));
+        }
+#endif
+        for (; i < pixel_count; ++i) {
+          dst[i * 4 + 0] = dst[i * 4 + 1] = dst[i * 4 + 2] = row[i];
+          dst[i * 4 + 3] = 255;
+        }
+        return true;
+      case kGrayAlpha:
+        for (; i < pixel_count; ++i, row += 2, dst += 4) {
+          dst[0] = dst[1] = dst[2] = row[0];
+          dst[3] = row[1];
+        }
+        return true;
+      case kPalette:
+        for (; i < pixel_count; ++i, dst += 4) {
+          if (row[i] < info.palette_size) {
+            std::memcpy(dst, &info.palette[row[i] * 4], 4);
+          } else {
+            dst[0] = dst[1] = dst[2] = 0;
+            dst[3] = 255;
+          }
+        }
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  if (info.bit_depth == 16 && info.color_type == kGray) {
+#if PNG_DECODER_USE_SSE
+    for (; i + 16 <= pixel_count; i += 16) {
+      const __m128i low = ScaleTo8Sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i * 2)));
+      const __m128i high = ScaleTo8Sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i * 2 + 16)));
+      StoreGraySse(dst + i * 4, _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < pixel_count; ++i) {
+      dst[i * 4 + 0] = dst[i * 4 + 1] = dst[i * 4 + 2] = ScaleTo8(ReadSample(row, i, 16), 16);
+      dst[i * 4 + 3] = 255;
+    }
+    return true;
+  }
+  return false;
+}
+
+// Convert one unfiltered row to RGBA, writing pixel i at dst + i * dst_stride
+void ExpandRow(const PngInfo& info, const uint8_t* row, uint32_t pixel_count, uint8_t* dst, size_t dst_stride) {
+  if (dst_stride == Image::kBytesPerPixel && !info.has_color_key && ExpandRowFast(info, row, pixel_count, dst)) {
+    return;
+  }
+
+  const uint8_t depth = info.bit_depth;
+  for (uint32_t i = 0; i < pixel_count; ++i, dst += dst_stride) {
+    switch (info.color_type) {
+      case kGray: {
+        const uint16_t gray = ReadSample(row, i, depth);
+        const uint8_t value = ScaleTo8(gray, depth);
+        dst[0] = dst[1] = dst[2] = value;
+        dst[3] = (info.has_color_key && gray == info.color_key[0]) ? 0 : 255;
+        break;
+      }
+      case kRgb: {
+        const uint16_t r = ReadSample(row, i * 3 + 0, depth);
+        const uint16_t g = ReadSample(row, i * 3 + 1, depth);
+        const uint16_t b = ReadSample(row, i * 3 + 2, depth);
+        dst[0] = ScaleTo8(r, depth);
+        dst[1] = ScaleTo8(g, depth);
+        dst[2] = ScaleTo8(b, depth);
+        const bool keyed = info.has_color_key && r == info.color_key[0] && g == info.color_key[1] && b == info.color_key[2];
+        dst[3] = keyed ? 0 : 255;
+        break;
+      }
+      case kPalette: {
+        // Out-of-range indices are an error in the spec; they decode as opaque black like most decoders
+        const uint16_t index = ReadSample(row, i, depth);
+        if (index < info.palette_size) {
+          std::memcpy(dst, &info.palette[index * 4], 4);
+        } else {
+          dst[0] = dst[1] = dst[2] = 0;
+          dst[3] = 255;
+        }
+        break;
+      }
+      case kGrayAlpha: {
+        const uint8_t value = ScaleTo8(ReadSample(row, i * 2, depth), depth);
+        dst[0] = dst[1] = dst[2] = value;
+        dst[3] = ScaleTo8(ReadSample(row, i * 2 + 1, depth), depth);
+        break;
+      }
+      default:
+        for (uint32_t c = 0; c < 4; ++c) {
+          dst[c] = ScaleTo8(ReadSample(row, i * 4 + c, depth), depth);
+        }
+        break;
+    }
+  }
+}
+
+// Unfilter (in place) and expand one (sub)image of the stream; returns the bytes consumed from data.
+// Rows are unfiltered in the inflated buffer, so dst only receives writes.
+bool DecodePass(const PngInfo& info,
+  uint8_t* data,
+  size_t data_size,
+  uint32_t pass_width,
+  uint32_t pass_height,
+  const Adam7Pass& pass,
+  uint8_t* dst,
+  size_t dst_row_pitch,
+  size_t& consumed) {
+  const size_t row_bytes = info.RowBytes(pass_width);
+  const uint32_t stride = info.FilterStride();
+  if (data_size < (row_bytes + 1) * pass_height) {
+    std::cerr << "[PngDecoder] Image data is truncated" << '\n';
+    return false;
+  }
+
+  const std::vector<uint8_t> zero_row(row_bytes, 0);
+  const uint8_t* prev = zero_row.data();
+  for (uint32_t y = 0; y < pass_height; ++y) {
+    uint8_t* current = data + y * (row_bytes + 1) + 1;
+    const uint8_t filter = current[-1];
+    if (!Unfilter(filter, current, prev, row_bytes, stride)) {
+      std::cerr << "[PngDecoder] Invalid filter type " << static_cast<int>(filter) << '\n';
+      return false;
+    }
+
+    uint8_t* row_dst = dst + static_cast<size_t>(pass.y0 + y * pass.dy) * dst_row_pitch;
+    ExpandRow(info, current, pass_width, row_dst + pass.x0 * Image::kBytesPerPixel, static_cast<size_t>(pass.dx) * Image::kBytesPerPixel);
+    prev = current;
+  }
+
+  consumed = (row_bytes + 1) * pass_height;
+  return true;
+}
+
+// Walk the chunks into info and gather the IDAT payloads. Without out_compressed the walk stops at the
+// first IDAT (header only).
+bool ParseChunks(const uint8_t* data, size_t size, PngInfo& info, std::vector<uint8_t>* out_compressed) {
+  if (size < kSignature.size() || std::memcmp(data, kSignature.data(), kSignature.size()) != 0) {
+    std::cerr << "[PngDecoder] Not a PNG file" << '\n';
+    return false;
+  }
+
+  bool has_header = false;
+  bool has_end = false;
+  std::vector<std::pair<const uint8_t*, uint32_t>> idat_chunks;
+  size_t compressed_size = 0;
+
+  size_t offset = kSignature.size();
+  while (!has_end) {
+    if (size - offset < 12) {
+      std::cerr << "[PngDecoder] Truncated chunk" << '\n';
+      return false;
+    }
+    const uint32_t length = ReadBE32(data + offset);
+    const uint8_t* type = data + offset + 4;
+    const uint8_t* payload = data + offset + 8;
+    if (length > size - offset - 12) {
+      std::cerr << "[PngDecoder] Truncated chunk" << '\n';
+      return false;
+    }
+    offset += 12 + static_cast<size_t>(length);
+
+    if (std::memcmp(type, "IHDR", 4) == 0) {
+      if (length != 13 || has_header) {
+        std::cerr << "[PngDecoder] Invalid IHDR" << '\n';
+        return false;
+      }
+      info.width = ReadBE32(payload);
+      info.height = ReadBE32(payload + 4);
+      info.bit_depth = payload[8];
+      info.color_type = payload[9];
+      info.interlaced = payload[12] == 1;
+      if (info.width == 0 || info.height == 0 || info.width > kMaxDimension || info.height > kMaxDimension ||
+          static_cast<uint64_t>(info.width) * info.height > kMaxPixels) {
+        std::cerr << "[PngDecoder] Unsupported image size " << info.width << "x" << info.height << '\n';
+        return false;
+      }
+      if (!IsValidFormat(info.color_type, info.bit_depth) || payload[10] != 0 || payload[11] != 0 || payload[12] > 1) {
+        std::cerr << "[PngDecoder] Invalid format (color type " << static_cast<int>(info.color_type) << ", depth "
+                  << static_cast<int>(info.bit_depth) << ")" << '\n';
+        return false;
+      }
+      info.channels = ChannelCount(info.color_type);
+      has_header = true;
+    } else if (!has_header) {
+      std::cerr << "[PngDecoder] Missing IHDR" << '\n';
+      return false;
+    } else if (std::memcmp(type, "PLTE", 4) == 0) {
+      if (length % 3 != 0 || length / 3 > 256) {
+        std::cerr << "[PngDecoder] Invalid PLTE" << '\n';
+        return false;
+      }
+      info.palette_size = length / 3;
+      for (uint32_t i = 0; i < info.palette_size; ++i) {
+        info.palette[i * 4 + 0] = payload[i * 3 + 0];
+        info.palette[i * 4 + 1] = payload[i * 3 + 1];
+        info.palette[i * 4 + 2] = payload[i * 3 + 2];
+        info.palette[i * 4 + 3] = 255;
+      }
+    } else if (std::memcmp(type, "tRNS", 4) == 0) {
+      if (info.color_type == kPalette) {
+        for (uint32_t i = 0; i < length && i < 256; ++i) {
+          info.palette[i * 4 + 3] = payload[i];
+        }
+      } else if (info.color_type == kGray && length >= 2) {
+        info.has_color_key = true;
+        info.color_key[0] = static_cast<uint16_t>((payload[0] << 8) | payload[1]);
+      } else if (info.color_type == kRgb && length >= 6) {
+        info.has_color_key = true;
+        for (uint32_t c = 0; c < 3; ++c) {
+          info.color_key[c] = static_cast<uint16_t>((payload[c * 2] << 8) | payload[c * 2 + 1]);
+        }
+      }
+    } else if (std::memcmp(type, "sRGB", 4) == 0) {
+      info.srgb = true;
+    } else if (std::memcmp(type, "gAMA", 4) == 0) {
+      info.srgb = info.srgb || (length == 4 && ReadBE32(payload) == kSrgbGamma);
+    } else if (std::memcmp(type, "IDAT", 4) == 0) {
+      if (out_compressed == nullptr) {
+        return true;
+      }
+      idat_chunks.emplace_back(payload, length);
+      compressed_size += length;
+    } else if (std::memcmp(type, "IEND", 4) == 0) {
+      has_end = true;
+    } else if ((type[0] & 0x20) == 0) {
+      // Unknown critical chunk (uppercase first letter): the image cannot be decoded correctly
+      std::cerr << "[PngDecoder] Unsupported critical chunk " << std::string(reinterpret_cast<const char*>(type), 4) << '\n';
+      return false;
+    }
+  }
+
+  if (info.color_type == kPalette && info.palette_size == 0) {
+    std::cerr << "[PngDecoder] Palette image without PLTE" << '\n';
+    return false;
+  }
+  if (out_compressed == nullptr || compressed_size == 0) {
+    std::cerr << "[PngDecoder] Missing image data" << '\n';
+    return false;
+  }
+
+  out_compressed->clear();
+  out_compressed->reserve(compressed_size);
+  for (const auto& [payload, length] : idat_chunks) {
+    out_compressed->insert(out_compressed->end(), payload, payload + length);
+  }
+  return true;
+}
+}  // namespace
+
+bool ReadPngInfo(const uint8_t* data, size_t size, ImageInfo& out_info) {
+  PngInfo info;
+  if (!ParseChunks(data, size, info, nullptr)) {
+    return false;
+  }
+  out_info.width = info.width;
+  out_info.height = info.height;
+  out_info.srgb = info.srgb;
+  return true;
+}
+
+bool DecodePng(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch) {
+  PngInfo info;
+  std::vector<uint8_t> compressed;
+  if (!ParseChunks(data, size, info, &compressed)) {
+    return false;
+  }
+  assert(dst_row_pitch >= static_cast<size_t>(info.width) * Image::kBytesPerPixel);
+
+  // Exact size of the filtered stream (one filter byte per row of every non-empty pass)
+  size_t raw_size = 0;
+  if (info.interlaced) {
+    for (const Adam7Pass& pass : kAdam7) {
+      const uint32_t pass_width = (info.width + pass.dx - 1 - pass.x0) / pass.dx;
+      const uint32_t pass_height = (info.height + pass.dy - 1 - pass.y0) / pass.dy;
+      if (info.width > pass.x0 && info.height > pass.y0) {
+        raw_size += (info.RowBytes(pass_width) + 1) * pass_height;
+      }
+    }
+  } else {
+    raw_size = (info.RowBytes(info.width) + 1) * info.height;
+  }
+
+  std::vector<uint8_t> raw;
+  if (!ZlibDecompress(compressed.data(), compressed.size(), raw_size, raw)) {
+    std::cerr << "[PngDecoder] Failed to decompress image data" << '\n';
+    return false;
+  }
+
+  if (!info.interlaced) {
+    size_t consumed = 0;
+    return DecodePass(info, raw.data(), raw.size(), info.width, info.height, Adam7Pass{0, 0, 1, 1}, dst, dst_row_pitch, consumed);
+  }
+
+  size_t raw_offset = 0;
+  for (const Adam7Pass& pass : kAdam7) {
+    if (info.width <= pass.x0 || info.height <= pass.y0) {
+      continue;
+    }
+    const uint32_t pass_width = (info.width + pass.dx - 1 - pass.x0) / pass.dx;
+    const uint32_t pass_height = (info.height + pass.dy - 1 - pass.y0) / pass.dy;
+    size_t consumed = 0;
+    if (!DecodePass(
+          info, raw.data() + raw_offset, raw.size() - raw_offset, pass_width, pass_height, pass, dst, dst_row_pitch, consumed)) {
+      return false;
+    }
+    raw_offset += consumed;
+  }
+  return true;
+}
+
+bool DecodePng(const uint8_t* data, size_t size, Image& out_image) {
+  ImageInfo info;
+  if (!ReadPngInfo(data, size, info)) {
+    return false;
+  }
+  out_image.Resize(info.width, info.height);
+  return DecodePng(data, size, out_image.pixels.data(), out_image.GetRowPitch());
+}
+bool DecodePngFile(const std::string& file_path, Image& out_image) {
+  std::ifstream stream(file_path, std::ios::binary | std::ios::ate);
+  if (!stream) {
+    std::cerr << "[PngDecoder] Failed to open " << file_path << '\n';
+    return false;
+  }
+
+  std::vector<uint8_t> bytes(static_cast<size_t>(stream.tellg()));
+  stream.seekg(0);
+  if (!stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+    std::cerr << "[PngDecoder] Failed to read " << file_path << '\n';
+    return false;
+  }
+
+  if (!DecodePng(bytes.data(), bytes.size(), out_image)) {
+    std::cerr << "[PngDecoder] Failed to decode " << file_path << '\n';
+    return false;
+  }
+  return true;
+}
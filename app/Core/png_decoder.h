@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "image.h"
+
+// PNG decoder: every color type and bit depth of the PNG 1.2 spec, including palettes, tRNS transparency
+// and Adam7 interlacing. The output is always 8-bit RGBA (16-bit channels are rounded to 8 bits).
+// Ancillary chunks other than tRNS, sRGB and gAMA (color profiles, text) are ignored and CRCs are not verified.
+// Row unfiltering and the conversion of the common layouts to RGBA use SSE2 where available.
+
+// Read the header chunks only: size, and srgb when the file has an sRGB chunk or a 2.2 gAMA
+bool ReadPngInfo(const uint8_t* data, size_t size, ImageInfo& out_info);
+
+// Decode into caller memory: height rows of width RGBA pixels, dst_row_pitch bytes apart. dst is only
+// written, never read, so it can be mapped (write-combined) upload memory laid out by GetCopyableFootprints.
+bool DecodePng(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch);
+
+bool DecodePng(const uint8_t* data, size_t size, Image& out_image);
+
+bool DecodePngFile(const std::string& file_path, Image& out_image);
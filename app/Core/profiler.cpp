@@ -0,0 +1,126 @@
+#include "profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+void WriteJsonString(std::ofstream& out, const char* text) {
+  out << '"';
+  for (const char* c = text; c != nullptr && *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+void WriteMicroseconds(std::ofstream& out, uint64_t ns) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+  out << text;
+}
+}  // namespace
+
+Profiler& Profiler::Get() {
+  static Profiler instance;
+  return instance;
+}
+
+uint64_t Profiler::NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    auto new_buffer = std::make_unique<ThreadBuffer>();
+    new_buffer->events.resize(kEventsPerThread);
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    new_buffer->thread_id = static_cast<uint32_t>(buffers_.size()) + 1;
+    buffer = new_buffer.get();
+    buffers_.push_back(std::move(new_buffer));
+  }
+  return *buffer;
+}
+
+void Profiler::RecordZone(const char* name, uint64_t start_ns, uint64_t end_ns) {
+  ThreadBuffer& buffer = GetThreadBuffer();
+
+  // Single writer per buffer: plain stores, then publish the new count
+  const uint64_t index = buffer.write_count.load(std::memory_order_relaxed);
+  Event& event = buffer.events[index % kEventsPerThread];
+  event.name = name;
+  event.start_ns = start_ns;
+  event.end_ns = end_ns;
+  buffer.write_count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+  frame_start_ns_ = NowNs();
+}
+
+void Profiler::EndFrame() {
+  if (frame_start_ns_ != 0) {
+    RecordZone("Frame", frame_start_ns_, NowNs());
+  }
+  frame_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char* name) {
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  buffer.thread_name = name != nullptr ? name : "";
+}
+
+bool Profiler::ExportChromeTrace(const std::string& file_path) {
+  std::ofstream out(file_path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    std::cerr << "[Profiler] Failed to open trace file: " << file_path << '\n';
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  size_t event_count = 0;
+  bool first = true;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+  for (const auto& buffer : buffers_) {
+    if (!buffer->thread_name.empty()) {
+      out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->thread_id
+          << ",\"args\":{\"name\":";
+      WriteJsonString(out, buffer->thread_name.c_str());
+      out << "}}";
+      first = false;
+    }
+
+    const uint64_t count = buffer->write_count.load(std::memory_order_acquire);
+    const uint64_t begin = count > kEventsPerThread ? count - kEventsPerThread : 0;
+
+    for (uint64_t i = begin; i < count; ++i) {
+      const Event& event = buffer->events[i % kEventsPerThread];
+      const uint64_t start = event.start_ns > epoch_ns_ ? event.start_ns - epoch_ns_ : 0;
+      const uint64_t duration = event.end_ns > event.start_ns ? event.end_ns - event.start_ns : 0;
+
+      out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+      WriteJsonString(out, event.name);
+      out << ",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"ts\":";
+      WriteMicroseconds(out, start);
+      out << ",\"dur\":";
+      WriteMicroseconds(out, duration);
+      out << "}";
+      first = false;
+      ++event_count;
+    }
+  }
+
+  out << "\n]}\n";
+
+  std::cout << "[Profiler] Exported " << event_count << " events (" << GetFrameCount() << " frames) to " << file_path << '\n';
+  return static_cast<bool>(out);
+}
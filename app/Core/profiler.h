@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// CPU profiler: scoped zones recorded into per-thread ring buffers, exported as Chrome trace JSON
+// (open in chrome://tracing or https://ui.perfetto.dev).
+//
+// Use the PROFILE_* macros only. With ENABLE_PROFILER=0 (CMake option ENABLE_PROFILER=OFF) they expand
+// to nothing and no profiler code is referenced.
+//
+// Recording is lock-free: each thread owns its buffer and is its only writer. The registry mutex is
+// taken once per thread (first event) and by ExportChromeTrace. Zone names must have static storage
+// duration (string literals or __func__).
+
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+
+class Profiler {
+ public:
+  static constexpr uint32_t kEventsPerThread = 1u << 16;  // Ring capacity; older events are overwritten
+
+  struct Event {
+    const char* name = nullptr;
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+  };
+
+  static Profiler& Get();
+
+  static uint64_t NowNs();
+
+  void RecordZone(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+  // Frame markers: every BeginFrame/EndFrame pair becomes a "Frame" zone on the calling thread
+  void BeginFrame();
+  void EndFrame();
+
+  // Label the calling thread in the exported trace
+  void SetThreadName(const char* name);
+
+  // Write all buffered events. Call while other threads are not recording (e.g. at shutdown).
+  bool ExportChromeTrace(const std::string& file_path);
+
+  uint64_t GetFrameCount() const {
+    return frame_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct ThreadBuffer {
+    std::vector<Event> events;
+    std::atomic<uint64_t> write_count{0};
+    uint32_t thread_id = 0;
+    std::string thread_name;
+  };
+
+  Profiler() = default;
+
+  ThreadBuffer& GetThreadBuffer();
+
+  std::mutex registry_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  std::atomic<uint64_t> frame_count_{0};
+  uint64_t frame_start_ns_ = 0;
+  uint64_t epoch_ns_ = NowNs();
+};
+
+// RAII zone: records [construction, destruction) under the given name
+class ProfileScope {
+ public:
+  explicit ProfileScope(const char* name) : name_(name), start_ns_(Profiler::NowNs()) {
+  }
+
+  ~ProfileScope() {
+    Profiler::Get().RecordZone(name_, start_ns_, Profiler::NowNs());
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t start_ns_;
+};
+
+#if ENABLE_PROFILER
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILER_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_FRAME_BEGIN() Profiler::Get().BeginFrame()
+#define PROFILE_FRAME_END() Profiler::Get().EndFrame()
+#define PROFILE_THREAD_NAME(name) Profiler::Get().SetThreadName(name)
+#define PROFILE_EXPORT(file_path) Profiler::Get().ExportChromeTrace(file_path)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_EXPORT(file_path) ((void)0)
+#endif
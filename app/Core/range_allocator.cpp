@@ -0,0 +1,288 @@
+#include "range_allocator.h"
+
+#include <bit>
+
+void RangeAllocator::Initialize(uint64_t capacity) {
+  capacity_ = capacity;
+  Reset();
+}
+
+void RangeAllocator::Reset() {
+  nodes_.clear();
+  unused_nodes_.clear();
+
+  first_level_bitmap_ = 0;
+  second_level_bitmaps_.fill(0);
+  for (auto& heads : free_heads_) {
+    heads.fill(kInvalidNode);
+  }
+
+  allocated_size_ = 0;
+  allocation_count_ = 0;
+  free_block_count_ = 0;
+
+  if (capacity_ > 0) {
+    const uint32_t node = CreateNode();
+    nodes_[node].offset = 0;
+    nodes_[node].size = capacity_;
+    InsertFreeBlock(node);
+  }
+}
+
+RangeAllocator::Allocation RangeAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  if (size == 0 || alignment == 0 || !std::has_single_bit(alignment)) {
+    return {};
+  }
+
+  if (size > capacity_) {
+    return {};
+  }
+
+  // Over-request so that any block of the found class can be aligned; when no such class has a block,
+  // look for one that fits exactly (e.g. the last aligned slot of a nearly full range)
+  const uint64_t padding_budget = alignment - 1;
+  uint32_t first_level = 0;
+  uint32_t second_level = 0;
+  uint32_t node = kInvalidNode;
+  if (padding_budget <= capacity_ - size && FindSuitableClass(size + padding_budget, first_level, second_level)) {
+    node = free_heads_[first_level][second_level];
+  } else {
+    node = FindAlignedFit(size, alignment);
+    if (node == kInvalidNode) {
+      return {};
+    }
+  }
+  RemoveFreeBlock(node);
+
+  // Front padding becomes its own free block (the previous neighbour is in use, so no merge is possible)
+  const uint64_t offset = nodes_[node].offset;
+  const uint64_t aligned_offset = (offset + alignment - 1) & ~(alignment - 1);
+  const uint64_t padding = aligned_offset - offset;
+  if (padding > 0) {
+    const uint32_t front = CreateNode();
+    Node& front_node = nodes_[front];
+    Node& block = nodes_[node];
+
+    front_node.offset = offset;
+    front_node.size = padding;
+    front_node.prev_physical = block.prev_physical;
+    front_node.next_physical = node;
+    if (block.prev_physical != kInvalidNode) {
+      nodes_[block.prev_physical].next_physical = front;
+    }
+    block.prev_physical = front;
+    block.offset = aligned_offset;
+    block.size -= padding;
+
+    InsertFreeBlock(front);
+  }
+
+  if (nodes_[node].size > size) {
+    SplitTail(node, size);
+  }
+
+  allocated_size_ += size;
+  ++allocation_count_;
+
+  Allocation allocation;
+  allocation.offset = aligned_offset;
+  allocation.size = size;
+  allocation.node = node;
+  return allocation;
+}
+
+void RangeAllocator::Free(uint32_t node) {
+  if (node >= nodes_.size() || nodes_[node].is_free || nodes_[node].size == 0) {
+    return;
+  }
+
+  allocated_size_ -= nodes_[node].size;
+  --allocation_count_;
+
+  // Coalesce with the previous physical block
+  const uint32_t prev = nodes_[node].prev_physical;
+  if (prev != kInvalidNode && nodes_[prev].is_free) {
+    RemoveFreeBlock(prev);
+    nodes_[prev].size += nodes_[node].size;
+    nodes_[prev].next_physical = nodes_[node].next_physical;
+    if (nodes_[node].next_physical != kInvalidNode) {
+      nodes_[nodes_[node].next_physical].prev_physical = prev;
+    }
+    ReleaseNode(node);
+    node = prev;
+  }
+
+  // Coalesce with the next physical block
+  const uint32_t next = nodes_[node].next_physical;
+  if (next != kInvalidNode && nodes_[next].is_free) {
+    RemoveFreeBlock(next);
+    nodes_[node].size += nodes_[next].size;
+    nodes_[node].next_physical = nodes_[next].next_physical;
+    if (nodes_[next].next_physical != kInvalidNode) {
+      nodes_[nodes_[next].next_physical].prev_physical = node;
+    }
+    ReleaseNode(next);
+  }
+
+  InsertFreeBlock(node);
+}
+
+uint64_t RangeAllocator::GetLargestFreeBlock() const {
+  if (first_level_bitmap_ == 0) {
+    return 0;
+  }
+
+  const uint32_t first_level = 63 - static_cast<uint32_t>(std::countl_zero(first_level_bitmap_));
+  const uint32_t second_level = 31 - static_cast<uint32_t>(std::countl_zero(second_level_bitmaps_[first_level]));
+
+  uint64_t largest = 0;
+  for (uint32_t node = free_heads_[first_level][second_level]; node != kInvalidNode; node = nodes_[node].next_free) {
+    largest = (nodes_[node].size > largest) ? nodes_[node].size : largest;
+  }
+  return largest;
+}
+
+void RangeAllocator::MapSize(uint64_t size, uint32_t& first_level, uint32_t& second_level) {
+  if (size < kSecondLevelCount) {
+    // Small sizes: one linear class per unit
+    first_level = 0;
+    second_level = static_cast<uint32_t>(size);
+    return;
+  }
+
+  const uint32_t msb = static_cast<uint32_t>(std::bit_width(size)) - 1;
+  first_level = msb - kSecondLevelLog2 + 1;
+  second_level = static_cast<uint32_t>(size >> (msb - kSecondLevelLog2)) - kSecondLevelCount;
+}
+
+bool RangeAllocator::FindSuitableClass(uint64_t size, uint32_t& first_level, uint32_t& second_level) const {
+  // Round up to the next class boundary so every block in the found class is large enough
+  if (size >= kSecondLevelCount) {
+    const uint32_t msb = static_cast<uint32_t>(std::bit_width(size)) - 1;
+    const uint64_t round = (1ull << (msb - kSecondLevelLog2)) - 1;
+    if (size > ~0ull - round) {
+      return false;
+    }
+    size += round;
+  }
+
+  MapSize(size, first_level, second_level);
+
+  uint32_t second_level_map = second_level_bitmaps_[first_level] & (~0u << second_level);
+  if (second_level_map == 0) {
+    const uint64_t first_level_map = (first_level + 1 < kFirstLevelCount) ? (first_level_bitmap_ & (~0ull << (first_level + 1))) : 0;
+    if (first_level_map == 0) {
+      return false;
+    }
+    first_level = static_cast<uint32_t>(std::countr_zero(first_level_map));
+    second_level_map = second_level_bitmaps_[first_level];
+  }
+
+  second_level = static_cast<uint32_t>(std::countr_zero(second_level_map));
+  return true;
+}
+
+uint32_t RangeAllocator::FindAlignedFit(uint64_t size, uint64_t alignment) const {
+  uint32_t first_level = 0;
+  uint32_t second_level = 0;
+  MapSize(size, first_level, second_level);
+
+  // Classes below the one holding size only have smaller blocks
+  for (; first_level < kFirstLevelCount; ++first_level, second_level = 0) {
+    uint32_t second_level_map = second_level_bitmaps_[first_level] & (~0u << second_level);
+    while (second_level_map != 0) {
+      const uint32_t level = static_cast<uint32_t>(std::countr_zero(second_level_map));
+      second_level_map &= second_level_map - 1;
+      for (uint32_t node = free_heads_[first_level][level]; node != kInvalidNode; node = nodes_[node].next_free) {
+        const uint64_t aligned_offset = (nodes_[node].offset + alignment - 1) & ~(alignment - 1);
+        if (aligned_offset + size <= nodes_[node].offset + nodes_[node].size) {
+          return node;
+        }
+      }
+    }
+  }
+  return kInvalidNode;
+}
+
+uint32_t RangeAllocator::CreateNode() {
+  if (!unused_nodes_.empty()) {
+    const uint32_t node = unused_nodes_.back();
+    unused_nodes_.pop_back();
+    nodes_[node] = Node{};
+    return node;
+  }
+
+  nodes_.emplace_back();
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void RangeAllocator::ReleaseNode(uint32_t node) {
+  nodes_[node] = Node{};
+  unused_nodes_.push_back(node);
+}
+
+void RangeAllocator::InsertFreeBlock(uint32_t node) {
+  uint32_t first_level = 0;
+  uint32_t second_level = 0;
+  MapSize(nodes_[node].size, first_level, second_level);
+
+  const uint32_t head = free_heads_[first_level][second_level];
+  nodes_[node].prev_free = kInvalidNode;
+  nodes_[node].next_free = head;
+  nodes_[node].is_free = true;
+  if (head != kInvalidNode) {
+    nodes_[head].prev_free = node;
+  }
+  free_heads_[first_level][second_level] = node;
+
+  first_level_bitmap_ |= 1ull << first_level;
+  second_level_bitmaps_[first_level] |= 1u << second_level;
+  ++free_block_count_;
+}
+
+void RangeAllocator::RemoveFreeBlock(uint32_t node) {
+  uint32_t first_level = 0;
+  uint32_t second_level = 0;
+  MapSize(nodes_[node].size, first_level, second_level);
+
+  Node& block = nodes_[node];
+  if (block.prev_free != kInvalidNode) {
+    nodes_[block.prev_free].next_free = block.next_free;
+  }
+  if (block.next_free != kInvalidNode) {
+    nodes_[block.next_free].prev_free = block.prev_free;
+  }
+
+  if (free_heads_[first_level][second_level] == node) {
+    free_heads_[first_level][second_level] = block.next_free;
+    if (block.next_free == kInvalidNode) {
+      second_level_bitmaps_[first_level] &= ~(1u << second_level);
+      if (second_level_bitmaps_[first_level] == 0) {
+        first_level_bitmap_ &= ~(1ull << first_level);
+      }
+    }
+  }
+
+  block.prev_free = kInvalidNode;
+  block.next_free = kInvalidNode;
+  block.is_free = false;
+  --free_block_count_;
+}
+
+void RangeAllocator::SplitTail(uint32_t node, uint64_t size) {
+  const uint32_t tail = CreateNode();
+  Node& tail_node = nodes_[tail];
+  Node& block = nodes_[node];
+
+  tail_node.offset = block.offset + size;
+  tail_node.size = block.size - size;
+  tail_node.prev_physical = node;
+  tail_node.next_physical = block.next_physical;
+  if (block.next_physical != kInvalidNode) {
+    nodes_[block.next_physical].prev_physical = tail;
+  }
+  block.next_physical = tail;
+  block.size = size;
+
+  InsertFreeBlock(tail);
+}
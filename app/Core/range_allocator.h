@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// RangeAllocator: Two-level segregated fit (TLSF) allocator over an abstract range [0, capacity).
+// Allocate, Free and coalescing are O(1): free blocks are bucketed by size class with two bitmaps,
+// and physical neighbours are linked so freeing merges without searching. Only when no size class
+// guarantees a fit (nearly full range, large alignment) does Allocate scan free blocks for an exact fit.
+//
+// Only bookkeeping lives here (offsets, not memory), so the same class manages descriptor indices,
+// heap offsets, etc. Block nodes come from an internal pool, so steady-state use does not allocate.
+class RangeAllocator {
+ public:
+  static constexpr uint64_t kInvalidOffset = ~0ull;
+  static constexpr uint32_t kInvalidNode = ~0u;
+
+  struct Allocation {
+    uint64_t offset = kInvalidOffset;
+    uint64_t size = 0;
+    uint32_t node = kInvalidNode;  // Pass back to Free
+
+    bool IsValid() const {
+      return node != kInvalidNode;
+    }
+  };
+
+  RangeAllocator() = default;
+  explicit RangeAllocator(uint64_t capacity) {
+    Initialize(capacity);
+  }
+
+  void Initialize(uint64_t capacity);
+
+  // Returns an invalid allocation when no free block can hold size bytes at the requested
+  // alignment (alignment must be a power of two)
+  Allocation Allocate(uint64_t size, uint64_t alignment = 1);
+
+  void Free(const Allocation& allocation) {
+    Free(allocation.node);
+  }
+  void Free(uint32_t node);
+
+  // Release everything (capacity unchanged)
+  void Reset();
+
+  uint64_t GetCapacity() const {
+    return capacity_;
+  }
+
+  uint64_t GetAllocatedSize() const {
+    return allocated_size_;
+  }
+
+  uint64_t GetFreeSize() const {
+    return capacity_ - allocated_size_;
+  }
+
+  uint32_t GetAllocationCount() const {
+    return allocation_count_;
+  }
+
+  uint32_t GetFreeBlockCount() const {
+    return free_block_count_;
+  }
+
+  // Size of the largest free block (O(1): highest non-empty size class, then a short scan of its list)
+  uint64_t GetLargestFreeBlock() const;
+
+ private:
+  static constexpr uint32_t kSecondLevelLog2 = 4;
+  static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelLog2;
+  static constexpr uint32_t kFirstLevelCount = 64;
+
+  struct Node {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t prev_physical = kInvalidNode;
+    uint32_t next_physical = kInvalidNode;
+    uint32_t prev_free = kInvalidNode;
+    uint32_t next_free = kInvalidNode;
+    bool is_free = false;
+  };
+
+  uint64_t capacity_ = 0;
+  uint64_t allocated_size_ = 0;
+  uint32_t allocation_count_ = 0;
+  uint32_t free_block_count_ = 0;
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> unused_nodes_;
+
+  uint64_t first_level_bitmap_ = 0;
+  std::array<uint32_t, kFirstLevelCount> second_level_bitmaps_{};
+  std::array<std::array<uint32_t, kSecondLevelCount>, kFirstLevelCount> free_heads_{};
+
+  static void MapSize(uint64_t size, uint32_t& first_level, uint32_t& second_level);
+  bool FindSuitableClass(uint64_t size, uint32_t& first_level, uint32_t& second_level) const;
+
+  // Slow path: scan free blocks from the class holding size upwards for one that fits once aligned
+  uint32_t FindAlignedFit(uint64_t size, uint64_t alignment) const;
+
+  uint32_t CreateNode();
+  void ReleaseNode(uint32_t node);
+
+  void InsertFreeBlock(uint32_t node);
+  void RemoveFreeBlock(uint32_t node);
+
+  // Split node so that it keeps `size` units; the remainder becomes a new free block after it
+  void SplitTail(uint32_t node, uint64_t size);
+};
@@ -0,0 +1,132 @@
+#include "rect_packer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+bool IsContainedIn(const RectPacker::Rect& a, const RectPacker::Rect& b) {
+  return a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height;
+}
+}  // namespace
+
+void RectPacker::Reset(uint32_t width, uint32_t height) {
+  width_ = width;
+  height_ = height;
+  used_width_ = 0;
+  used_height_ = 0;
+  used_area_ = 0;
+
+  free_rects_.clear();
+  if (width > 0 && height > 0) {
+    free_rects_.push_back({0, 0, width, height});
+  }
+}
+
+bool RectPacker::Insert(uint32_t width, uint32_t height, Rect& out_rect) {
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  Rect placed;
+  if (!FindPosition(width, height, placed)) {
+    return false;
+  }
+
+  // Every free rect overlapping the placed rect is replaced by up to four maximal sub-rects.
+  std::vector<Rect> split_rects;
+  for (size_t i = 0; i < free_rects_.size();) {
+    if (SplitFreeRect(free_rects_[i], placed, split_rects)) {
+      free_rects_[i] = free_rects_.back();
+      free_rects_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+  free_rects_.insert(free_rects_.end(), split_rects.begin(), split_rects.end());
+  PruneFreeRects();
+
+  used_area_ += static_cast<uint64_t>(width) * height;
+  used_width_ = (std::max)(used_width_, placed.x + placed.width);
+  used_height_ = (std::max)(used_height_, placed.y + placed.height);
+
+  out_rect = placed;
+  return true;
+}
+
+float RectPacker::GetOccupancy() const {
+  const uint64_t total_area = static_cast<uint64_t>(width_) * height_;
+  if (total_area == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(static_cast<double>(used_area_) / static_cast<double>(total_area));
+}
+
+bool RectPacker::FindPosition(uint32_t width, uint32_t height, Rect& out_rect) const {
+  uint32_t best_short_side = (std::numeric_limits<uint32_t>::max)();
+  uint32_t best_long_side = (std::numeric_limits<uint32_t>::max)();
+  bool found = false;
+
+  for (const Rect& free_rect : free_rects_) {
+    if (free_rect.width < width || free_rect.height < height) {
+      continue;
+    }
+
+    const uint32_t leftover_x = free_rect.width - width;
+    const uint32_t leftover_y = free_rect.height - height;
+    const uint32_t short_side = (std::min)(leftover_x, leftover_y);
+    const uint32_t long_side = (std::max)(leftover_x, leftover_y);
+
+    if (short_side < best_short_side || (short_side == best_short_side && long_side < best_long_side)) {
+      best_short_side = short_side;
+      best_long_side = long_side;
+      out_rect = {free_rect.x, free_rect.y, width, height};
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+bool RectPacker::SplitFreeRect(const Rect& free_rect, const Rect& used_rect, std::vector<Rect>& out_rects) {
+  const uint32_t free_right = free_rect.x + free_rect.width;
+  const uint32_t free_bottom = free_rect.y + free_rect.height;
+  const uint32_t used_right = used_rect.x + used_rect.width;
+  const uint32_t used_bottom = used_rect.y + used_rect.height;
+
+  if (used_rect.x >= free_right || used_right <= free_rect.x || used_rect.y >= free_bottom || used_bottom <= free_rect.y) {
+    return false;
+  }
+
+  if (used_rect.x > free_rect.x) {
+    out_rects.push_back({free_rect.x, free_rect.y, used_rect.x - free_rect.x, free_rect.height});
+  }
+  if (used_right < free_right) {
+    out_rects.push_back({used_right, free_rect.y, free_right - used_right, free_rect.height});
+  }
+  if (used_rect.y > free_rect.y) {
+    out_rects.push_back({free_rect.x, free_rect.y, free_rect.width, used_rect.y - free_rect.y});
+  }
+  if (used_bottom < free_bottom) {
+    out_rects.push_back({free_rect.x, used_bottom, free_rect.width, free_bottom - used_bottom});
+  }
+
+  return true;
+}
+
+void RectPacker::PruneFreeRects() {
+  // Drop free rects fully covered by another free rect (keeps the list maximal and small).
+  for (size_t i = 0; i < free_rects_.size(); ++i) {
+    for (size_t j = i + 1; j < free_rects_.size();) {
+      if (IsContainedIn(free_rects_[i], free_rects_[j])) {
+        free_rects_.erase(free_rects_.begin() + static_cast<std::ptrdiff_t>(i));
+        --i;
+        break;
+      }
+      if (IsContainedIn(free_rects_[j], free_rects_[i])) {
+        free_rects_.erase(free_rects_.begin() + static_cast<std::ptrdiff_t>(j));
+      } else {
+        ++j;
+      }
+    }
+  }
+}
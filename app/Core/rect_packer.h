@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// RectPacker: MaxRects bin packer (best short side fit).
+// Device-independent so atlas layouts can be computed at load time or in offline tools.
+class RectPacker {
+ public:
+  struct Rect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+  };
+
+  RectPacker() = default;
+  RectPacker(uint32_t width, uint32_t height) {
+    Reset(width, height);
+  }
+
+  void Reset(uint32_t width, uint32_t height);
+
+  // Place a width x height rect. Returns false if it does not fit anywhere in the bin.
+  bool Insert(uint32_t width, uint32_t height, Rect& out_rect);
+
+  uint32_t GetWidth() const {
+    return width_;
+  }
+
+  uint32_t GetHeight() const {
+    return height_;
+  }
+
+  // Bounding extent of all placed rects (useful to trim the final bin size)
+  uint32_t GetUsedWidth() const {
+    return used_width_;
+  }
+
+  uint32_t GetUsedHeight() const {
+    return used_height_;
+  }
+
+  // Ratio of placed area to bin area [0, 1]
+  float GetOccupancy() const;
+
+ private:
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint32_t used_width_ = 0;
+  uint32_t used_height_ = 0;
+  uint64_t used_area_ = 0;
+
+  std::vector<Rect> free_rects_;
+
+  bool FindPosition(uint32_t width, uint32_t height, Rect& out_rect) const;
+  static bool SplitFreeRect(const Rect& free_rect, const Rect& used_rect, std::vector<Rect>& out_rects);
+  void PruneFreeRects();
+};
@@ -0,0 +1,129 @@
+#include "render_capture.h"
+
+#include <iostream>
+
+namespace {
+constexpr uint32_t kCaptureMagic = 0x50435052;  // "RPCP"
+constexpr uint32_t kCaptureVersion = 1;
+
+// Sanity limits for reading untrusted files
+constexpr uint32_t kMaxViewsPerFrame = 256;
+constexpr uint32_t kMaxPacketsPerView = 1u << 24;
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream& stream, T& value) {
+  return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}  // namespace
+
+bool RenderCaptureWriter::Open(const std::string& file_path) {
+  Close();
+
+  stream_.open(file_path, std::ios::binary | std::ios::trunc);
+  if (!stream_) {
+    std::cerr << "[RenderCapture] Failed to open capture file: " << file_path << '\n';
+    return false;
+  }
+
+  WriteValue(stream_, kCaptureMagic);
+  WriteValue(stream_, kCaptureVersion);
+  frame_count_ = 0;
+  return true;
+}
+
+void RenderCaptureWriter::Close() {
+  if (stream_.is_open()) {
+    stream_.close();
+  }
+}
+
+bool RenderCaptureWriter::WriteFrame(const RenderCaptureFrame& frame) {
+  if (!stream_.is_open()) {
+    return false;
+  }
+
+  WriteValue(stream_, frame.frame_number);
+  WriteValue(stream_, static_cast<uint32_t>(frame.views.size()));
+
+  for (const RenderCaptureView& view : frame.views) {
+    WriteValue(stream_, static_cast<uint16_t>(view.name.size()));
+    stream_.write(view.name.data(), static_cast<std::streamsize>(view.name.size()));
+    WriteValue(stream_, view.layer_mask);
+    WriteValue(stream_, view.tag_mask);
+    WriteValue(stream_, view.tag_exclude_mask);
+    WriteValue(stream_, view.scene_data);
+    WriteValue(stream_, static_cast<uint32_t>(view.packets.size()));
+    stream_.write(reinterpret_cast<const char*>(view.packets.data()),
+      static_cast<std::streamsize>(view.packets.size() * sizeof(RenderCapturePacket)));
+  }
+
+  ++frame_count_;
+  return static_cast<bool>(stream_);
+}
+
+bool RenderCaptureReader::Open(const std::string& file_path) {
+  stream_.open(file_path, std::ios::binary);
+  if (!stream_) {
+    std::cerr << "[RenderCapture] Failed to open capture file: " << file_path << '\n';
+    return false;
+  }
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!ReadValue(stream_, magic) || !ReadValue(stream_, version) || magic != kCaptureMagic) {
+    std::cerr << "[RenderCapture] Not a render capture file: " << file_path << '\n';
+    return false;
+  }
+
+  if (version != kCaptureVersion) {
+    std::cerr << "[RenderCapture] Unsupported capture version " << version << " (expected " << kCaptureVersion << ")" << '\n';
+    return false;
+  }
+
+  return true;
+}
+
+bool RenderCaptureReader::ReadFrame(RenderCaptureFrame& out_frame) {
+  uint32_t view_count = 0;
+  if (!ReadValue(stream_, out_frame.frame_number) || !ReadValue(stream_, view_count)) {
+    return false;
+  }
+
+  if (view_count > kMaxViewsPerFrame) {
+    std::cerr << "[RenderCapture] Malformed frame (view count " << view_count << ")" << '\n';
+    return false;
+  }
+
+  out_frame.views.resize(view_count);
+  for (RenderCaptureView& view : out_frame.views) {
+    uint16_t name_length = 0;
+    if (!ReadValue(stream_, name_length)) {
+      return false;
+    }
+    view.name.resize(name_length);
+    stream_.read(view.name.data(), name_length);
+
+    uint32_t packet_count = 0;
+    if (!ReadValue(stream_, view.layer_mask) || !ReadValue(stream_, view.tag_mask) || !ReadValue(stream_, view.tag_exclude_mask) ||
+        !ReadValue(stream_, view.scene_data) || !ReadValue(stream_, packet_count)) {
+      return false;
+    }
+
+    if (packet_count > kMaxPacketsPerView) {
+      std::cerr << "[RenderCapture] Malformed view (packet count " << packet_count << ")" << '\n';
+      return false;
+    }
+
+    view.packets.resize(packet_count);
+    if (!stream_.read(reinterpret_cast<char*>(view.packets.data()), static_cast<std::streamsize>(packet_count * sizeof(RenderCapturePacket)))) {
+      return false;
+    }
+  }
+
+  return true;
+}
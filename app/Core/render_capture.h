@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Render packet capture: binary stream of per-frame views (scene data + submitted packets),
+// written by RenderSystem and replayed offline by tools/render_replay.
+//
+// Pointers are replaced by ids assigned in first-use order during a capture, so the same scene
+// captured twice produces the same ids. The format is little-endian, fixed-layout records.
+
+struct RenderCaptureSceneData {
+  float view[16];
+  float proj[16];
+  float view_proj[16];
+  float inv_view_proj[16];
+  float camera_position[3];
+  uint32_t debug_id;
+};
+static_assert(sizeof(RenderCaptureSceneData) == 272, "RenderCaptureSceneData layout is part of the file format");
+
+struct RenderCapturePacket {
+  uint32_t mesh_id;
+  uint32_t material_id;
+  uint32_t template_id;
+  uint32_t texture_index;  // kSortKeyInvalidTexture when the material has no texture bound
+  uint32_t index_count;
+
+  uint8_t layer;
+  uint8_t tag;
+  uint8_t lod_level;
+  uint8_t reserved;
+
+  float sort_order;
+  float world[16];
+  float color[4];
+  float uv_transform[4];
+};
+static_assert(sizeof(RenderCapturePacket) == 124, "RenderCapturePacket layout is part of the file format");
+
+struct RenderCaptureView {
+  std::string name;
+
+  // RenderFilter of the pass that consumes this view
+  uint8_t layer_mask = 0xFF;
+  uint8_t tag_mask = 0xFF;
+  uint8_t tag_exclude_mask = 0;
+
+  RenderCaptureSceneData scene_data{};
+  std::vector<RenderCapturePacket> packets;
+};
+
+struct RenderCaptureFrame {
+  uint64_t frame_number = 0;
+  std::vector<RenderCaptureView> views;
+};
+
+class RenderCaptureWriter {
+ public:
+  bool Open(const std::string& file_path);
+  void Close();
+
+  bool WriteFrame(const RenderCaptureFrame& frame);
+
+  bool IsOpen() const {
+    return stream_.is_open();
+  }
+
+  uint32_t GetFrameCount() const {
+    return frame_count_;
+  }
+
+ private:
+  std::ofstream stream_;
+  uint32_t frame_count_ = 0;
+};
+
+class RenderCaptureReader {
+ public:
+  bool Open(const std::string& file_path);
+
+  // Returns false at end of file or on a malformed frame
+  bool ReadFrame(RenderCaptureFrame& out_frame);
+
+ private:
+  std::ifstream stream_;
+};
@@ -0,0 +1,320 @@
+#include "render_graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+namespace {
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+void RenderGraph::PassBuilder::Read(Resource resource, Access access) {
+  graph_.AddAccess(pass_, resource, access, false);
+}
+
+void RenderGraph::PassBuilder::Write(Resource resource, Access access) {
+  graph_.AddAccess(pass_, resource, access, true);
+}
+
+void RenderGraph::PassBuilder::SetSideEffect() {
+  graph_.passes_[pass_].side_effect = true;
+}
+
+RenderGraph::Resource RenderGraph::Import(const std::string& name, Access final_access) {
+  ResourceNode& node = resources_.emplace_back();
+  node.name = name;
+  node.final_access = final_access;
+  compiled_ = false;
+  return static_cast<Resource>(resources_.size() - 1);
+}
+
+RenderGraph::Resource RenderGraph::CreateTransient(const std::string& name, const TransientDesc& desc) {
+  assert(desc.size > 0);
+  assert(desc.alignment > 0);
+
+  ResourceNode& node = resources_.emplace_back();
+  node.name = name;
+  node.transient = true;
+  node.desc = desc;
+  compiled_ = false;
+  return static_cast<Resource>(resources_.size() - 1);
+}
+
+void RenderGraph::AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute) {
+  const uint32_t index = static_cast<uint32_t>(passes_.size());
+  PassNode& pass = passes_.emplace_back();
+  pass.name = name;
+  pass.execute = std::move(execute);
+  compiled_ = false;
+
+  if (setup) {
+    PassBuilder builder(*this, index);
+    setup(builder);
+  }
+}
+
+void RenderGraph::AddAccess(uint32_t pass, Resource resource, Access access, bool write) {
+  assert(resource < resources_.size());
+  assert(access != Access::None);
+  passes_[pass].accesses.push_back({resource, access, write});
+}
+
+bool RenderGraph::Compile() {
+  compiled_ = false;
+  schedule_.clear();
+  barriers_.clear();
+  final_barriers_.clear();
+  stats_ = {};
+  stats_.pass_count = static_cast<uint32_t>(passes_.size());
+
+  if (!Validate()) {
+    return false;
+  }
+
+  CullPasses();
+  if (!ComputeLifetimes()) {
+    return false;
+  }
+  PlaceTransients();
+  BuildBarriers();
+
+  compiled_ = true;
+  return true;
+}
+
+bool RenderGraph::Validate() const {
+  for (const PassNode& pass : passes_) {
+    for (size_t i = 0; i < pass.accesses.size(); ++i) {
+      for (size_t j = i + 1; j < pass.accesses.size(); ++j) {
+        const ResourceAccess& a = pass.accesses[i];
+        const ResourceAccess& b = pass.accesses[j];
+        // One state per resource per pass (a resource cannot be in two states at once)
+        if (a.resource == b.resource && a.access != b.access) {
+          std::cerr << "[RenderGraph] Pass '" << pass.name << "' uses '" << resources_[a.resource].name << "' as both "
+                    << GetAccessName(a.access) << " and " << GetAccessName(b.access) << '\n';
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void RenderGraph::CullPasses() {
+  // Walk backwards from the outputs: imported resources are observed outside the graph, everything
+  // else only matters if a live pass reads it. Writers of a needed resource stay needed (a write may
+  // only touch part of the resource, e.g. a blended draw), so earlier writers are kept as well.
+  std::vector<bool> needed(resources_.size(), false);
+  for (size_t i = 0; i < resources_.size(); ++i) {
+    needed[i] = !resources_[i].transient;
+  }
+
+  for (size_t p = passes_.size(); p-- > 0;) {
+    PassNode& pass = passes_[p];
+    bool live = pass.side_effect;
+    for (const ResourceAccess& access : pass.accesses) {
+      if (access.write && needed[access.resource]) {
+        live = true;
+      }
+    }
+
+    pass.culled = !live;
+    if (!live) {
+      ++stats_.culled_pass_count;
+      continue;
+    }
+    for (const ResourceAccess& access : pass.accesses) {
+      if (!access.write) {
+        needed[access.resource] = true;
+      }
+    }
+  }
+
+  for (uint32_t p = 0; p < static_cast<uint32_t>(passes_.size()); ++p) {
+    if (!passes_[p].culled) {
+      schedule_.push_back(p);
+    }
+  }
+}
+
+bool RenderGraph::ComputeLifetimes() {
+  for (ResourceNode& resource : resources_) {
+    resource.first_access = Access::None;
+    resource.first_use = ~0u;
+    resource.last_use = 0;
+    resource.heap_offset = kUnplaced;
+  }
+
+  for (uint32_t s = 0; s < static_cast<uint32_t>(schedule_.size()); ++s) {
+    const PassNode& pass = passes_[schedule_[s]];
+    for (const ResourceAccess& access : pass.accesses) {
+      ResourceNode& resource = resources_[access.resource];
+      if (resource.first_use == ~0u) {
+        // Transient contents are undefined until written
+        if (resource.transient && !access.write) {
+          std::cerr << "[RenderGraph] Pass '" << pass.name << "' reads transient '" << resource.name << "' before any pass writes it"
+                    << '\n';
+          return false;
+        }
+        resource.first_use = s;
+        resource.first_access = access.access;
+      }
+      resource.last_use = s;
+    }
+  }
+  return true;
+}
+
+void RenderGraph::PlaceTransients() {
+  std::vector<Resource> order;
+  for (Resource r = 0; r < static_cast<Resource>(resources_.size()); ++r) {
+    if (resources_[r].transient && resources_[r].first_use != ~0u) {
+      order.push_back(r);
+      stats_.transient_bytes += resources_[r].desc.size;
+    }
+  }
+
+  // Largest first, each at the lowest offset that does not overlap a placed transient alive at the same time
+  std::stable_sort(
+    order.begin(), order.end(), [this](Resource a, Resource b) { return resources_[a].desc.size > resources_[b].desc.size; });
+
+  std::vector<Resource> placed;
+  std::vector<Resource> conflicts;
+  for (Resource r : order) {
+    ResourceNode& node = resources_[r];
+
+    conflicts.clear();
+    for (Resource other : placed) {
+      const ResourceNode& o = resources_[other];
+      if (o.first_use <= node.last_use && node.first_use <= o.last_use) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(), [this](Resource a, Resource b) {
+      return resources_[a].heap_offset < resources_[b].heap_offset;
+    });
+
+    uint64_t offset = 0;
+    for (Resource other : conflicts) {
+      const ResourceNode& o = resources_[other];
+      if (AlignUp(offset, node.desc.alignment) + node.desc.size <= o.heap_offset) {
+        break;
+      }
+      offset = (std::max)(offset, o.heap_offset + o.desc.size);
+    }
+    node.heap_offset = AlignUp(offset, node.desc.alignment);
+    stats_.transient_heap_size = (std::max)(stats_.transient_heap_size, node.heap_offset + node.desc.size);
+    placed.push_back(r);
+  }
+}
+
+void RenderGraph::BuildBarriers() {
+  std::vector<Access> current(resources_.size(), Access::None);
+
+  for (uint32_t s = 0; s < static_cast<uint32_t>(schedule_.size()); ++s) {
+    PassNode& pass = passes_[schedule_[s]];
+    pass.barrier_begin = static_cast<uint32_t>(barriers_.size());
+
+    for (const ResourceAccess& access : pass.accesses) {
+      const Resource r = access.resource;
+      const ResourceNode& node = resources_[r];
+
+      if (node.transient && node.first_use == s) {
+        if (current[r] != Access::None) {
+          continue;  // Listed twice in this pass
+        }
+        // Memory takes over from every transient that used the same range earlier in the frame
+        for (Resource other = 0; other < static_cast<Resource>(resources_.size()); ++other) {
+          const ResourceNode& o = resources_[other];
+          if (!o.transient || o.heap_offset == kUnplaced || o.last_use >= s) {
+            continue;
+          }
+          if (o.heap_offset < node.heap_offset + node.desc.size && node.heap_offset < o.heap_offset + o.desc.size) {
+            barriers_.push_back({Barrier::Type::Aliasing, r, Access::None, access.access, other});
+            ++stats_.aliasing_barrier_count;
+          }
+        }
+        current[r] = access.access;
+        continue;
+      }
+
+      if (current[r] != access.access) {
+        barriers_.push_back({Barrier::Type::Transition, r, current[r], access.access, kInvalidResource});
+        ++stats_.barrier_count;
+        current[r] = access.access;
+      }
+    }
+
+    pass.barrier_count = static_cast<uint32_t>(barriers_.size()) - pass.barrier_begin;
+  }
+
+  for (Resource r = 0; r < static_cast<Resource>(resources_.size()); ++r) {
+    const ResourceNode& node = resources_[r];
+    if (!node.transient && node.final_access != Access::None && current[r] != node.final_access) {
+      final_barriers_.push_back({Barrier::Type::Transition, r, current[r], node.final_access, kInvalidResource});
+      ++stats_.barrier_count;
+    }
+  }
+}
+
+void RenderGraph::Execute(const BarrierFunc& barrier_func) {
+  assert(compiled_);
+
+  for (uint32_t p : schedule_) {
+    const std::span<const Barrier> barriers = GetPassBarriers(p);
+    if (!barriers.empty() && barrier_func) {
+      barrier_func(barriers);
+    }
+    if (passes_[p].execute) {
+      passes_[p].execute();
+    }
+  }
+
+  if (!final_barriers_.empty() && barrier_func) {
+    barrier_func(final_barriers_);
+  }
+}
+
+std::span<const RenderGraph::Barrier> RenderGraph::GetPassBarriers(uint32_t pass) const {
+  const PassNode& node = passes_[pass];
+  if (node.culled || node.barrier_count == 0) {
+    return {};
+  }
+  return std::span<const Barrier>(barriers_).subspan(node.barrier_begin, node.barrier_count);
+}
+
+void RenderGraph::Reset() {
+  resources_.clear();
+  passes_.clear();
+  schedule_.clear();
+  barriers_.clear();
+  final_barriers_.clear();
+  stats_ = {};
+  compiled_ = false;
+}
+
+const char* RenderGraph::GetAccessName(Access access) {
+  switch (access) {
+    case Access::None:
+      return "None";
+    case Access::RenderTarget:
+      return "RenderTarget";
+    case Access::DepthWrite:
+      return "DepthWrite";
+    case Access::DepthRead:
+      return "DepthRead";
+    case Access::ShaderRead:
+      return "ShaderRead";
+    case Access::UnorderedAccess:
+      return "UnorderedAccess";
+    case Access::CopySource:
+      return "CopySource";
+    case Access::CopyDest:
+      return "CopyDest";
+    case Access::Present:
+      return "Present";
+  }
+  return "Unknown";
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+// RenderGraph: Per-frame graph of passes that declare the resources they read and write.
+// Compile() turns the declarations into a schedule: passes whose outputs nothing observes are culled,
+// the transitions each pass needs are derived from the declared accesses, and transient resources
+// with disjoint lifetimes are packed into one shared heap (aliasing barriers mark each reuse).
+//
+// The graph only knows abstract resources (handles, sizes, access kinds); the backend maps handles
+// to API objects and accesses to API states. Passes run in declaration order, so a pass may only
+// depend on passes declared before it.
+//
+// Typical frame: Reset, Import / CreateTransient, AddPass..., Compile, Execute.
+class RenderGraph {
+ public:
+  using Resource = uint32_t;
+  static constexpr Resource kInvalidResource = ~0u;
+
+  // How a pass uses a resource (the backend maps each to an API state)
+  enum class Access : uint8_t { None, RenderTarget, DepthWrite, DepthRead, ShaderRead, UnorderedAccess, CopySource, CopyDest, Present };
+
+  // Memory footprint of a transient resource, as reported by the backend
+  struct TransientDesc {
+    uint64_t size = 0;
+    uint64_t alignment = 1;
+  };
+
+  struct Barrier {
+    enum class Type : uint8_t { Transition, Aliasing };
+
+    Type type = Type::Transition;
+    Resource resource = kInvalidResource;
+    Access before = Access::None;  // None for the first use of an imported resource (state is tracked by the backend)
+    Access after = Access::None;
+    Resource aliased = kInvalidResource;  // Aliasing: transient that used the memory before
+  };
+
+  struct Stats {
+    uint32_t pass_count = 0;
+    uint32_t culled_pass_count = 0;
+    uint32_t barrier_count = 0;
+    uint32_t aliasing_barrier_count = 0;
+    uint64_t transient_bytes = 0;      // Sum of live transient sizes
+    uint64_t transient_heap_size = 0;  // Shared heap size after aliasing
+  };
+
+  class PassBuilder {
+   public:
+    void Read(Resource resource, Access access);
+    void Write(Resource resource, Access access);
+
+    // Never culled (e.g. the pass writes something the graph does not model)
+    void SetSideEffect();
+
+   private:
+    friend class RenderGraph;
+
+    PassBuilder(RenderGraph& graph, uint32_t pass) : graph_(graph), pass_(pass) {
+    }
+
+    RenderGraph& graph_;
+    uint32_t pass_;
+  };
+
+  using SetupFunc = std::function<void(PassBuilder&)>;
+  using ExecuteFunc = std::function<void()>;
+  using BarrierFunc = std::function<void(std::span<const Barrier>)>;
+
+  RenderGraph() = default;
+
+  // External resource (back buffer, persistent depth). Imported resources count as graph outputs;
+  // final_access is requested after the last pass (None = leave as is).
+  Resource Import(const std::string& name, Access final_access = Access::None);
+
+  // Resource that only lives inside this frame's graph and may share memory with other transients
+  Resource CreateTransient(const std::string& name, const TransientDesc& desc);
+
+  void AddPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute);
+
+  // Returns false when the declarations are inconsistent (e.g. a transient read before any write)
+  bool Compile();
+
+  // Run the compiled schedule; barrier_func receives each pass's barriers right before it executes
+  void Execute(const BarrierFunc& barrier_func);
+
+  // Drop all passes and resources (keeps capacity)
+  void Reset();
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+  uint32_t GetPassCount() const {
+    return static_cast<uint32_t>(passes_.size());
+  }
+
+  const std::string& GetPassName(uint32_t pass) const {
+    return passes_[pass].name;
+  }
+
+  bool IsPassCulled(uint32_t pass) const {
+    return passes_[pass].culled;
+  }
+
+  // Pass indices in execution order (after Compile)
+  const std::vector<uint32_t>& GetSchedule() const {
+    return schedule_;
+  }
+
+  std::span<const Barrier> GetPassBarriers(uint32_t pass) const;
+
+  // Barriers issued after the last pass (imported resources to their final access)
+  std::span<const Barrier> GetFinalBarriers() const {
+    return final_barriers_;
+  }
+
+  const std::string& GetResourceName(Resource resource) const {
+    return resources_[resource].name;
+  }
+
+  bool IsTransient(Resource resource) const {
+    return resources_[resource].transient;
+  }
+
+  // Transients only: offset into the shared heap, kUnplaced if culled with every pass using it
+  static constexpr uint64_t kUnplaced = ~0ull;
+  uint64_t GetTransientOffset(Resource resource) const {
+    return resources_[resource].heap_offset;
+  }
+
+  // Access of the first scheduled use (transients are created / initialized in this state)
+  Access GetFirstAccess(Resource resource) const {
+    return resources_[resource].first_access;
+  }
+
+  static const char* GetAccessName(Access access);
+
+ private:
+  struct ResourceNode {
+    std::string name;
+    bool transient = false;
+    Access final_access = Access::None;
+    TransientDesc desc;
+
+    // Compile results
+    Access first_access = Access::None;
+    uint32_t first_use = ~0u;  // Schedule positions
+    uint32_t last_use = 0;
+    uint64_t heap_offset = kUnplaced;
+  };
+
+  struct ResourceAccess {
+    Resource resource;
+    Access access;
+    bool write;
+  };
+
+  struct PassNode {
+    std::string name;
+    std::vector<ResourceAccess> accesses;
+    ExecuteFunc execute;
+    bool side_effect = false;
+
+    // Compile results
+    bool culled = false;
+    uint32_t barrier_begin = 0;
+    uint32_t barrier_count = 0;
+  };
+
+  std::vector<ResourceNode> resources_;
+  std::vector<PassNode> passes_;
+
+  std::vector<uint32_t> schedule_;
+  std::vector<Barrier> barriers_;
+  std::vector<Barrier> final_barriers_;
+  Stats stats_;
+  bool compiled_ = false;
+
+  void AddAccess(uint32_t pass, Resource resource, Access access, bool write);
+  bool Validate() const;
+  void CullPasses();
+  bool ComputeLifetimes();
+  void PlaceTransients();
+  void BuildBarriers();
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Render sort key shared by SceneRenderer and offline tools (render_replay).
+// Layout (64 bits):
+// [8 bits: Layer] [24 bits: Template/PSO id] [24 bits: Texture index] [2 bits: LOD level] [6 bits: Material id]
+// Template and material ids are only used for grouping, so pointer low bits are acceptable.
+
+constexpr uint32_t kSortKeyInvalidTexture = 0xFFFFFF;
+
+inline uint64_t ComposeRenderSortKey(uint8_t layer, uint64_t template_id, uint32_t texture_index, uint32_t lod_level, uint64_t material_id) {
+  uint64_t key = 0;
+  key |= (static_cast<uint64_t>(layer) & 0xFF) << 56;
+  key |= (template_id & 0xFFFFFF) << 32;
+  key |= (static_cast<uint64_t>(texture_index) & 0xFFFFFF) << 8;
+  key |= (static_cast<uint64_t>(lod_level) & 0x3) << 6;
+  key |= (material_id & 0x3F);
+  return key;
+}
+
+// Draw order: layer first, then sort_order inside the ordered layer (UI), then the sort key
+inline bool RenderDrawOrderLess(
+  uint8_t layer_a, float sort_order_a, uint64_t key_a, uint8_t layer_b, float sort_order_b, uint64_t key_b, uint8_t ordered_layer) {
+  if (layer_a != layer_b) {
+    return layer_a < layer_b;
+  }
+
+  if (layer_a == ordered_layer && sort_order_a != sort_order_b) {
+    return sort_order_a < sort_order_b;
+  }
+
+  return key_a < key_b;
+}
@@ -0,0 +1,130 @@
+#include "residency_policy.h"
+
+#include <cassert>
+
+ResidencyPolicy::Handle ResidencyPolicy::Register(uint64_t size, bool pinned) {
+  Handle handle;
+  if (!free_handles_.empty()) {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+  } else {
+    handle = static_cast<Handle>(entries_.size());
+    entries_.emplace_back();
+  }
+
+  Entry& entry = entries_[handle];
+  entry = {};
+  entry.size = size;
+  entry.last_used_frame = current_frame_;
+  entry.in_use = true;
+  entry.resident = true;
+  entry.pinned = pinned;
+  if (!pinned) {
+    LinkBack(handle);
+  }
+
+  stats_.tracked_bytes += size;
+  stats_.resident_bytes += size;
+  ++stats_.tracked_count;
+  ++stats_.resident_count;
+  return handle;
+}
+
+void ResidencyPolicy::Unregister(Handle handle) {
+  assert(handle < entries_.size() && entries_[handle].in_use);
+
+  Entry& entry = entries_[handle];
+  if (entry.resident) {
+    if (!entry.pinned) {
+      Unlink(handle);
+    }
+    stats_.resident_bytes -= entry.size;
+    --stats_.resident_count;
+  }
+  stats_.tracked_bytes -= entry.size;
+  --stats_.tracked_count;
+
+  entry.in_use = false;
+  free_handles_.push_back(handle);
+}
+
+bool ResidencyPolicy::Touch(Handle handle) {
+  assert(handle < entries_.size() && entries_[handle].in_use);
+
+  Entry& entry = entries_[handle];
+  entry.last_used_frame = current_frame_;
+  if (entry.pinned) {
+    return false;
+  }
+
+  if (entry.resident) {
+    // Move to the most recently used end (already there for repeated use in one frame)
+    if (lru_tail_ != handle) {
+      Unlink(handle);
+      LinkBack(handle);
+    }
+    return false;
+  }
+
+  entry.resident = true;
+  LinkBack(handle);
+  stats_.resident_bytes += entry.size;
+  ++stats_.resident_count;
+  ++stats_.restores;
+  return true;
+}
+
+uint32_t ResidencyPolicy::CollectEvictions(uint32_t min_idle_frames, std::vector<Handle>& out_evicted) {
+  if (stats_.budget == 0) {
+    return 0;
+  }
+
+  uint32_t evicted = 0;
+  while (stats_.resident_bytes > stats_.budget && lru_head_ != kNil) {
+    const Handle handle = lru_head_;
+    Entry& entry = entries_[handle];
+    // Everything behind the head was used at least as recently, so stop at the first busy entry
+    if (entry.last_used_frame + min_idle_frames > current_frame_) {
+      break;
+    }
+
+    Unlink(handle);
+    entry.resident = false;
+    stats_.resident_bytes -= entry.size;
+    --stats_.resident_count;
+    ++stats_.evictions;
+    stats_.evicted_bytes += entry.size;
+
+    out_evicted.push_back(handle);
+    ++evicted;
+  }
+  return evicted;
+}
+
+void ResidencyPolicy::LinkBack(Handle handle) {
+  Entry& entry = entries_[handle];
+  entry.prev = lru_tail_;
+  entry.next = kNil;
+  if (lru_tail_ != kNil) {
+    entries_[lru_tail_].next = handle;
+  } else {
+    lru_head_ = handle;
+  }
+  lru_tail_ = handle;
+}
+
+void ResidencyPolicy::Unlink(Handle handle) {
+  Entry& entry = entries_[handle];
+  if (entry.prev != kNil) {
+    entries_[entry.prev].next = entry.next;
+  } else {
+    lru_head_ = entry.next;
+  }
+  if (entry.next != kNil) {
+    entries_[entry.next].prev = entry.prev;
+  } else {
+    lru_tail_ = entry.prev;
+  }
+  entry.prev = kNil;
+  entry.next = kNil;
+}
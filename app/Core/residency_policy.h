@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// ResidencyPolicy: Decides which GPU allocations to evict when resident memory exceeds a budget.
+// Entries sit in an LRU list ordered by the last frame they were used; eviction takes the least recently
+// used entries that no frame in flight can still reference (idle for at least min_idle_frames).
+// An evicted entry becomes resident again the next time it is used (Touch reports this to the caller).
+//
+// Only bookkeeping lives here; the owner calls Evict / MakeResident on the API objects.
+class ResidencyPolicy {
+ public:
+  using Handle = uint32_t;
+  static constexpr Handle kInvalidHandle = ~0u;
+
+  struct Stats {
+    uint64_t budget = 0;
+    uint64_t tracked_bytes = 0;
+    uint64_t resident_bytes = 0;
+    uint32_t tracked_count = 0;
+    uint32_t resident_count = 0;
+    uint64_t evictions = 0;  // Totals since start
+    uint64_t restores = 0;
+    uint64_t evicted_bytes = 0;
+  };
+
+  ResidencyPolicy() = default;
+
+  // New entries are resident and most recently used. Pinned entries count towards the budget but
+  // are never evicted (e.g. memory whose residency is managed elsewhere).
+  Handle Register(uint64_t size, bool pinned = false);
+  void Unregister(Handle handle);
+
+  // Start of a frame; Touch stamps entries with this frame
+  void BeginFrame(uint64_t frame) {
+    current_frame_ = frame;
+  }
+
+  // Mark used this frame. Returns true when the entry was evicted and must be made resident before use.
+  bool Touch(Handle handle);
+
+  // Budget for resident bytes (0 = unlimited)
+  void SetBudget(uint64_t budget) {
+    stats_.budget = budget;
+  }
+
+  // Evict least recently used entries until resident bytes fit the budget. Appends evicted handles
+  // to out_evicted and returns how many were added.
+  uint32_t CollectEvictions(uint32_t min_idle_frames, std::vector<Handle>& out_evicted);
+
+  bool IsResident(Handle handle) const {
+    return entries_[handle].resident;
+  }
+
+  uint64_t GetSize(Handle handle) const {
+    return entries_[handle].size;
+  }
+
+  uint64_t GetLastUsedFrame(Handle handle) const {
+    return entries_[handle].last_used_frame;
+  }
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+ private:
+  static constexpr uint32_t kNil = ~0u;
+
+  struct Entry {
+    uint64_t size = 0;
+    uint64_t last_used_frame = 0;
+    uint32_t prev = kNil;  // LRU links (resident, unpinned entries only)
+    uint32_t next = kNil;
+    bool in_use = false;
+    bool resident = false;
+    bool pinned = false;
+  };
+
+  std::vector<Entry> entries_;
+  std::vector<Handle> free_handles_;
+
+  // Least recently used first
+  uint32_t lru_head_ = kNil;
+  uint32_t lru_tail_ = kNil;
+
+  uint64_t current_frame_ = 0;
+  Stats stats_;
+
+  void LinkBack(Handle handle);
+  void Unlink(Handle handle);
+};
@@ -0,0 +1,301 @@
+#include "tga_decoder.h"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+constexpr size_t kHeaderSize = 18;
+constexpr uint32_t kMaxPixels = 1u << 28;
+
+enum ImageType : uint8_t {
+  kColorMapped = 1,
+  kTrueColor = 2,
+  kGrayscale = 3,
+  kRleColorMapped = 9,
+  kRleTrueColor = 10,
+  kRleGrayscale = 11,
+};
+
+struct TgaHeader {
+  uint8_t id_length = 0;
+  uint8_t color_map_type = 0;
+  uint8_t image_type = 0;
+  uint16_t color_map_first = 0;
+  uint16_t color_map_length = 0;
+  uint8_t color_map_depth = 0;
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint8_t pixel_depth = 0;
+  uint8_t descriptor = 0;
+
+  uint8_t BaseType() const {
+    return image_type & 7;
+  }
+  bool IsRle() const {
+    return (image_type & 8) != 0;
+  }
+  uint32_t AttributeBits() const {
+    return descriptor & 0x0F;
+  }
+  bool IsTopDown() const {
+    return (descriptor & 0x20) != 0;
+  }
+  bool IsRightToLeft() const {
+    return (descriptor & 0x10) != 0;
+  }
+  uint32_t BytesPerPixel() const {
+    return (pixel_depth + 7u) / 8u;
+  }
+  size_t ColorMapBytes() const {
+    return color_map_type == 1 ? static_cast<size_t>(color_map_length) * ((color_map_depth + 7u) / 8u) : 0;
+  }
+};
+
+uint16_t ReadLE16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+bool IsTrueColorDepth(uint8_t depth) {
+  return depth == 15 || depth == 16 || depth == 24 || depth == 32;
+}
+
+// Parse and validate the fixed header; logs only when requested (IsTga probes silently)
+bool ParseHeader(const uint8_t* data, size_t size, TgaHeader& out_header, bool log_errors) {
+  auto fail = [log_errors](const char* message) {
+    if (log_errors) {
+      std::cerr << "[TgaDecoder] " << message << '\n';
+    }
+    return false;
+  };
+
+  if (data == nullptr || size < kHeaderSize) {
+    return fail("File too small for a TGA header");
+  }
+
+  TgaHeader& header = out_header;
+  header.id_length = data[0];
+  header.color_map_type = data[1];
+  header.image_type = data[2];
+  header.color_map_first = ReadLE16(data + 3);
+  header.color_map_length = ReadLE16(data + 5);
+  header.color_map_depth = data[7];
+  header.width = ReadLE16(data + 12);
+  header.height = ReadLE16(data + 14);
+  header.pixel_depth = data[16];
+  header.descriptor = data[17];
+
+  switch (header.image_type) {
+    case kColorMapped:
+    case kTrueColor:
+    case kGrayscale:
+    case kRleColorMapped:
+    case kRleTrueColor:
+    case kRleGrayscale:
+      break;
+    default:
+      return fail("Unsupported image type");
+  }
+
+  // Color maps are allowed (and skipped) in true-color and grayscale files
+  const uint8_t base_type = header.BaseType();
+  if (header.color_map_type > 1 || (base_type == kColorMapped && (header.color_map_type != 1 || header.color_map_length == 0))) {
+    return fail("Invalid color map");
+  }
+  if (base_type == kColorMapped && !IsTrueColorDepth(header.color_map_depth)) {
+    return fail("Unsupported color map depth");
+  }
+
+  bool valid_depth = false;
+  switch (base_type) {
+    case kColorMapped:
+    case kGrayscale:
+      valid_depth = header.pixel_depth == 8 || header.pixel_depth == 16;
+      break;
+    default:
+      valid_depth = IsTrueColorDepth(header.pixel_depth);
+      break;
+  }
+  if (!valid_depth) {
+    return fail("Unsupported pixel depth");
+  }
+  if (header.width == 0 || header.height == 0 || static_cast<uint32_t>(header.width) * header.height > kMaxPixels) {
+    return fail("Unsupported image size");
+  }
+  if (kHeaderSize + header.id_length + header.ColorMapBytes() > size) {
+    return fail("Truncated color map");
+  }
+  return true;
+}
+
+// One 15/16/24/32-bit BGR(A) value as RGBA
+void ConvertTrueColor(const uint8_t* src, uint32_t depth, bool has_alpha_bit, uint8_t* dst) {
+  switch (depth) {
+    case 32:
+      dst[0] = src[2];
+      dst[1] = src[1];
+      dst[2] = src[0];
+      dst[3] = src[3];
+      break;
+    case 24:
+      dst[0] = src[2];
+      dst[1] = src[1];
+      dst[2] = src[0];
+      dst[3] = 255;
+      break;
+    default: {
+      // A1R5G5B5, little-endian; 5-bit channels replicate their high bits
+      const uint32_t value = ReadLE16(src);
+      const uint32_t r = (value >> 10) & 31;
+      const uint32_t g = (value >> 5) & 31;
+      const uint32_t b = value & 31;
+      dst[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+      dst[1] = static_cast<uint8_t>((g << 3) | (g >> 2));
+      dst[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+      dst[3] = (has_alpha_bit && (value & 0x8000) == 0) ? 0 : 255;
+      break;
+    }
+  }
+}
+
+// Converts raw pixels of one file to RGBA (color maps are expanded up front)
+class PixelConverter {
+ public:
+  PixelConverter(const TgaHeader& header, const uint8_t* color_map) : header_(header) {
+    has_alpha_bit_ = header.pixel_depth == 16 && header.AttributeBits() >= 1;
+    if (header.BaseType() != kColorMapped) {
+      return;
+    }
+    const uint32_t entry_bytes = (header.color_map_depth + 7u) / 8u;
+    palette_.resize(static_cast<size_t>(header.color_map_length) * 4);
+    const bool map_alpha_bit = header.color_map_depth == 16 && header.AttributeBits() >= 1;
+    for (uint32_t i = 0; i < header.color_map_length; ++i) {
+      ConvertTrueColor(color_map + static_cast<size_t>(i) * entry_bytes, header.color_map_depth, map_alpha_bit, &palette_[i * 4]);
+    }
+  }
+
+  void Convert(const uint8_t* src, uint8_t* dst) const {
+    switch (header_.BaseType()) {
+      case kColorMapped: {
+        // Indices outside the map decode as opaque black
+        const uint32_t index = (header_.pixel_depth == 16) ? ReadLE16(src) : src[0];
+        if (index >= header_.color_map_first && index - header_.color_map_first < header_.color_map_length) {
+          std::memcpy(dst, &palette_[(index - header_.color_map_first) * 4], 4);
+        } else {
+          dst[0] = dst[1] = dst[2] = 0;
+          dst[3] = 255;
+        }
+        break;
+      }
+      case kGrayscale:
+        dst[0] = dst[1] = dst[2] = src[0];
+        dst[3] = (header_.pixel_depth == 16) ? src[1] : 255;
+        break;
+      default:
+        ConvertTrueColor(src, header_.pixel_depth, has_alpha_bit_, dst);
+        break;
+    }
+  }
+
+ private:
+  const TgaHeader& header_;
+  bool has_alpha_bit_ = false;
+  std::vector<uint8_t> palette_;  // RGBA
+};
+}  // namespace
+
+bool IsTga(const uint8_t* data, size_t size) {
+  TgaHeader header;
+  return ParseHeader(data, size, header, false);
+}
+
+bool ReadTgaInfo(const uint8_t* data, size_t size, ImageInfo& out_info) {
+  TgaHeader header;
+  if (!ParseHeader(data, size, header, true)) {
+    return false;
+  }
+  out_info.width = header.width;
+  out_info.height = header.height;
+  out_info.srgb = false;
+  return true;
+}
+
+bool DecodeTga(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch) {
+  TgaHeader header;
+  if (!ParseHeader(data, size, header, true)) {
+    return false;
+  }
+  assert(dst_row_pitch >= static_cast<size_t>(header.width) * Image::kBytesPerPixel);
+
+  const uint8_t* color_map = data + kHeaderSize + header.id_length;
+  const uint8_t* src = color_map + header.ColorMapBytes();
+  const uint8_t* end = data + size;
+  const PixelConverter converter(header, color_map);
+
+  const uint32_t width = header.width;
+  const uint32_t height = header.height;
+  const uint32_t pixel_bytes = header.BytesPerPixel();
+  if (!header.IsRle() && static_cast<size_t>(end - src) < static_cast<size_t>(width) * height * pixel_bytes) {
+    std::cerr << "[TgaDecoder] Image data is truncated" << '\n';
+    return false;
+  }
+
+  // RLE packets may continue across rows, so the packet state lives outside the row loop
+  uint32_t packet_left = 0;
+  bool packet_repeats = false;
+  std::array<uint8_t, 4> repeated_pixel{};
+
+  for (uint32_t y = 0; y < height; ++y) {
+    uint8_t* row = dst + static_cast<size_t>(header.IsTopDown() ? y : height - 1 - y) * dst_row_pitch;
+    for (uint32_t x = 0; x < width; ++x) {
+      uint8_t* pixel = row + static_cast<size_t>(header.IsRightToLeft() ? width - 1 - x : x) * Image::kBytesPerPixel;
+      if (!header.IsRle()) {
+        converter.Convert(src, pixel);
+        src += pixel_bytes;
+        continue;
+      }
+
+      if (packet_left == 0) {
+        if (end - src < 1) {
+          std::cerr << "[TgaDecoder] Image data is truncated" << '\n';
+          return false;
+        }
+        packet_repeats = (*src & 0x80) != 0;
+        packet_left = (*src & 0x7F) + 1u;
+        ++src;
+        if (packet_repeats) {
+          if (static_cast<size_t>(end - src) < pixel_bytes) {
+            std::cerr << "[TgaDecoder] Image data is truncated" << '\n';
+            return false;
+          }
+          converter.Convert(src, repeated_pixel.data());
+          src += pixel_bytes;
+        }
+      }
+
+      if (packet_repeats) {
+        std::memcpy(pixel, repeated_pixel.data(), 4);
+      } else {
+        if (static_cast<size_t>(end - src) < pixel_bytes) {
+          std::cerr << "[TgaDecoder] Image data is truncated" << '\n';
+          return false;
+        }
+        converter.Convert(src, pixel);
+        src += pixel_bytes;
+      }
+      --packet_left;
+    }
+  }
+  return true;
+}
+
+bool DecodeTga(const uint8_t* data, size_t size, Image& out_image) {
+  ImageInfo info;
+  if (!ReadTgaInfo(data, size, info)) {
+    return false;
+  }
+  out_image.Resize(info.width, info.height);
+  return DecodeTga(data, size, out_image.pixels.data(), out_image.GetRowPitch());
+}
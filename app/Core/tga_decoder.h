@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image.h"
+
+// TGA decoder: uncompressed and RLE true-color (15/16/24/32-bit), grayscale (8-bit, or 16-bit with alpha)
+// and color-mapped (8/16-bit indices into a 15/16/24/32-bit map) images with any origin. The output is
+// 8-bit RGBA: 32-bit pixels keep their alpha, 16-bit pixels use their attribute bit when the descriptor
+// declares one. The ID field, developer area and TGA 2.0 footer are ignored.
+
+// TGA has no signature: true when the header is one this decoder accepts (no logging)
+bool IsTga(const uint8_t* data, size_t size);
+
+bool ReadTgaInfo(const uint8_t* data, size_t size, ImageInfo& out_info);
+
+// Decode into caller memory: height rows of width RGBA pixels, dst_row_pitch bytes apart. dst is only
+// written, never read (bottom-up files fill it from the last row).
+bool DecodeTga(const uint8_t* data, size_t size, uint8_t* dst, size_t dst_row_pitch);
+
+bool DecodeTga(const uint8_t* data, size_t size, Image& out_image);
@@ -0,0 +1,172 @@
+#include "thread_cached_range_allocator.h"
+
+namespace {
+std::atomic<uint32_t> g_next_thread_slot{0};
+}  // namespace
+
+void ThreadCachedRangeAllocator::Initialize(uint64_t capacity) {
+  capacity_ = capacity;
+  Reset();
+}
+
+void ThreadCachedRangeAllocator::Reset() {
+  // Same lock order as Refill / Flush (magazine, then shared)
+  for (Magazine& magazine : magazines_) {
+    std::lock_guard<std::mutex> lock(magazine.mutex);
+    magazine.count = 0;
+  }
+  std::lock_guard<std::mutex> shared_lock(shared_mutex_);
+  shared_.Initialize(capacity_);
+  cached_units_.store(0, std::memory_order_relaxed);
+}
+
+uint32_t ThreadCachedRangeAllocator::GetThreadSlot() {
+  thread_local const uint32_t slot = g_next_thread_slot.fetch_add(1, std::memory_order_relaxed) % kThreadSlots;
+  return slot;
+}
+
+std::unique_lock<std::mutex> ThreadCachedRangeAllocator::LockCounted(std::mutex& mutex) const {
+  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    lock_contentions_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
+}
+
+RangeAllocator::Allocation ThreadCachedRangeAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+
+  if (size != 1 || alignment != 1) {
+    std::unique_lock<std::mutex> shared_lock = LockCounted(shared_mutex_);
+    return shared_.Allocate(size, alignment);
+  }
+
+  Magazine& magazine = magazines_[GetThreadSlot()];
+  std::unique_lock<std::mutex> lock = LockCounted(magazine.mutex);
+
+  if (magazine.count == 0) {
+    if (!Refill(magazine)) {
+      // Shared allocator exhausted: units may still be parked in other threads' magazines
+      CachedUnit unit{};
+      if (!StealUnit(magazine, unit)) {
+        return {};
+      }
+      RangeAllocator::Allocation allocation;
+      allocation.offset = unit.offset;
+      allocation.size = 1;
+      allocation.node = unit.node;
+      return allocation;
+    }
+  } else {
+    magazine_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const CachedUnit unit = magazine.units[--magazine.count];
+  cached_units_.fetch_sub(1, std::memory_order_relaxed);
+
+  RangeAllocator::Allocation allocation;
+  allocation.offset = unit.offset;
+  allocation.size = 1;
+  allocation.node = unit.node;
+  return allocation;
+}
+
+void ThreadCachedRangeAllocator::Free(const RangeAllocator::Allocation& allocation) {
+  if (!allocation.IsValid()) {
+    return;
+  }
+
+  frees_.fetch_add(1, std::memory_order_relaxed);
+
+  if (allocation.size != 1) {
+    std::unique_lock<std::mutex> shared_lock = LockCounted(shared_mutex_);
+    shared_.Free(allocation);
+    return;
+  }
+
+  Magazine& magazine = magazines_[GetThreadSlot()];
+  std::unique_lock<std::mutex> lock = LockCounted(magazine.mutex);
+
+  // Full: return half so alternating alloc/free at the boundary does not hit the shared lock every time
+  if (magazine.count == kMagazineSize) {
+    Flush(magazine, kMagazineSize / 2);
+  }
+
+  magazine.units[magazine.count++] = {allocation.offset, allocation.node};
+  cached_units_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ThreadCachedRangeAllocator::Refill(Magazine& magazine) {
+  refills_.fetch_add(1, std::memory_order_relaxed);
+
+  std::unique_lock<std::mutex> shared_lock = LockCounted(shared_mutex_);
+  const uint32_t target = kMagazineSize / 2;
+  while (magazine.count < target) {
+    RangeAllocator::Allocation allocation = shared_.Allocate(1);
+    if (!allocation.IsValid()) {
+      break;
+    }
+    magazine.units[magazine.count++] = {allocation.offset, allocation.node};
+    cached_units_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return magazine.count > 0;
+}
+
+void ThreadCachedRangeAllocator::Flush(Magazine& magazine, uint32_t keep_count) {
+  flushes_.fetch_add(1, std::memory_order_relaxed);
+
+  std::unique_lock<std::mutex> shared_lock = LockCounted(shared_mutex_);
+  while (magazine.count > keep_count) {
+    const CachedUnit& unit = magazine.units[--magazine.count];
+    shared_.Free(unit.node);
+    cached_units_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+bool ThreadCachedRangeAllocator::StealUnit(const Magazine& self, CachedUnit& out_unit) {
+  for (Magazine& other : magazines_) {
+    if (&other == &self) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(other.mutex, std::try_to_lock);
+    if (lock.owns_lock() && other.count > 0) {
+      out_unit = other.units[--other.count];
+      cached_units_.fetch_sub(1, std::memory_order_relaxed);
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t ThreadCachedRangeAllocator::GetAllocatedSize() const {
+  std::lock_guard<std::mutex> shared_lock(shared_mutex_);
+  const uint64_t reserved = shared_.GetAllocatedSize();
+  const uint64_t cached = cached_units_.load(std::memory_order_relaxed);
+  return reserved > cached ? reserved - cached : 0;
+}
+
+uint32_t ThreadCachedRangeAllocator::GetFreeBlockCount() const {
+  std::lock_guard<std::mutex> shared_lock(shared_mutex_);
+  return shared_.GetFreeBlockCount();
+}
+
+uint64_t ThreadCachedRangeAllocator::GetLargestFreeBlock() const {
+  std::lock_guard<std::mutex> shared_lock(shared_mutex_);
+  return shared_.GetLargestFreeBlock();
+}
+
+ThreadCachedRangeAllocator::Stats ThreadCachedRangeAllocator::GetStats() const {
+  Stats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.frees = frees_.load(std::memory_order_relaxed);
+  stats.magazine_hits = magazine_hits_.load(std::memory_order_relaxed);
+  stats.refills = refills_.load(std::memory_order_relaxed);
+  stats.flushes = flushes_.load(std::memory_order_relaxed);
+  stats.steals = steals_.load(std::memory_order_relaxed);
+  stats.lock_contentions = lock_contentions_.load(std::memory_order_relaxed);
+  return stats;
+}
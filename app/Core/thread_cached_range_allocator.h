@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "range_allocator.h"
+
+// ThreadCachedRangeAllocator: Thread-safe front-end for RangeAllocator.
+// Single-unit allocations (the common case: one SRV) are served from per-thread magazines of
+// pre-reserved units; a magazine is refilled from / flushed to the shared RangeAllocator in
+// batches under one short lock. Multi-unit and aligned requests go straight to the shared allocator.
+//
+// Threads map onto kThreadSlots magazines by a per-thread id, each guarded by its own mutex,
+// so more threads than slots still work (they just share a magazine).
+class ThreadCachedRangeAllocator {
+ public:
+  static constexpr uint32_t kMagazineSize = 32;
+  static constexpr uint32_t kThreadSlots = 32;
+
+  struct Stats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t magazine_hits = 0;     // Single-unit requests served without touching the shared allocator
+    uint64_t refills = 0;           // Magazine refills from the shared allocator
+    uint64_t flushes = 0;           // Magazine overflows returned to the shared allocator
+    uint64_t steals = 0;            // Units taken from other magazines when the shared allocator ran dry
+    uint64_t lock_contentions = 0;  // Lock acquisitions that had to wait
+  };
+
+  ThreadCachedRangeAllocator() = default;
+
+  ThreadCachedRangeAllocator(const ThreadCachedRangeAllocator&) = delete;
+  ThreadCachedRangeAllocator& operator=(const ThreadCachedRangeAllocator&) = delete;
+
+  void Initialize(uint64_t capacity);
+
+  RangeAllocator::Allocation Allocate(uint64_t size, uint64_t alignment = 1);
+  void Free(const RangeAllocator::Allocation& allocation);
+
+  // Drop all allocations and cached units. Not safe concurrently with Allocate/Free.
+  void Reset();
+
+  uint64_t GetCapacity() const {
+    return capacity_;
+  }
+
+  // Units handed out to callers (units parked in magazines count as free)
+  uint64_t GetAllocatedSize() const;
+
+  uint32_t GetFreeBlockCount() const;
+  uint64_t GetLargestFreeBlock() const;
+
+  Stats GetStats() const;
+
+ private:
+  struct CachedUnit {
+    uint64_t offset;
+    uint32_t node;
+  };
+
+  struct alignas(64) Magazine {
+    std::mutex mutex;
+    uint32_t count = 0;
+    std::array<CachedUnit, kMagazineSize> units{};
+  };
+
+  uint64_t capacity_ = 0;
+
+  mutable std::mutex shared_mutex_;
+  RangeAllocator shared_;
+
+  std::array<Magazine, kThreadSlots> magazines_;
+  std::atomic<uint64_t> cached_units_{0};
+
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> frees_{0};
+  std::atomic<uint64_t> magazine_hits_{0};
+  std::atomic<uint64_t> refills_{0};
+  std::atomic<uint64_t> flushes_{0};
+  std::atomic<uint64_t> steals_{0};
+  mutable std::atomic<uint64_t> lock_contentions_{0};
+
+  static uint32_t GetThreadSlot();
+
+  // try_lock first so contention can be counted
+  std::unique_lock<std::mutex> LockCounted(std::mutex& mutex) const;
+
+  bool Refill(Magazine& magazine);
+  void Flush(Magazine& magazine, uint32_t keep_count);
+
+  // try_lock only (the caller holds its own magazine lock), so this cannot deadlock
+  bool StealUnit(const Magazine& self, CachedUnit& out_unit);
+};
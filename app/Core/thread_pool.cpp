@@ -0,0 +1,107 @@
+#include "thread_pool.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "profiler.h"
+
+bool ThreadPool::Initialize(uint32_t worker_count, const char* thread_name, ThreadHook on_thread_start, ThreadHook on_thread_exit) {
+  assert(workers_.empty());
+  assert(worker_count > 0);
+
+  thread_name_ = thread_name;
+  on_thread_start_ = std::move(on_thread_start);
+  on_thread_exit_ = std::move(on_thread_exit);
+  stopping_ = false;
+
+  workers_.reserve(worker_count);
+  for (uint32_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+
+  std::cout << "[ThreadPool] Started " << worker_count << " worker(s)" << '\n';
+  return true;
+}
+
+void ThreadPool::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  job_available_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void ThreadPool::Submit(Job job) {
+  assert(job);
+
+  // Not initialized (or already shut down): run on the caller
+  if (workers_.empty()) {
+    job();
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++completed_;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  job_available_.notify_one();
+}
+
+void ThreadPool::WaitIdle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return jobs_.empty() && running_ == 0; });
+}
+
+size_t ThreadPool::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return jobs_.size() + running_;
+}
+
+uint64_t ThreadPool::GetCompletedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return completed_;
+}
+
+void ThreadPool::WorkerLoop() {
+  PROFILE_THREAD_NAME(thread_name_);
+  if (on_thread_start_) {
+    on_thread_start_();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    job_available_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+    // Queued jobs still run after Shutdown is requested
+    if (jobs_.empty()) {
+      break;
+    }
+
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    ++running_;
+    lock.unlock();
+
+    job();
+    // Destroy captures before reporting completion
+    job = nullptr;
+
+    lock.lock();
+    --running_;
+    ++completed_;
+    if (jobs_.empty() && running_ == 0) {
+      idle_.notify_all();
+    }
+  }
+  lock.unlock();
+
+  if (on_thread_exit_) {
+    on_thread_exit_();
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool: Fixed set of worker threads running queued jobs in submission order (background work such
+// as file decoding; not meant for fine-grained per-frame parallelism).
+//
+// Submit / WaitIdle are thread-safe. Jobs must not call WaitIdle. Shutdown (and the destructor) run every
+// job still queued before joining, so whatever the jobs reference must outlive the pool.
+class ThreadPool {
+ public:
+  using Job = std::move_only_function<void()>;
+  using ThreadHook = std::function<void()>;
+
+  ThreadPool() = default;
+  ~ThreadPool() {
+    Shutdown();
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // on_thread_start / on_thread_exit run on every worker (e.g. per-thread COM initialization)
+  bool Initialize(
+    uint32_t worker_count, const char* thread_name = "Worker", ThreadHook on_thread_start = {}, ThreadHook on_thread_exit = {});
+  void Shutdown();
+
+  void Submit(Job job);
+
+  // Block until the queue is empty and no job is running
+  void WaitIdle();
+
+  uint32_t GetWorkerCount() const {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  size_t GetPendingCount() const;
+
+  uint64_t GetCompletedCount() const;
+
+ private:
+  std::vector<std::thread> workers_;
+  const char* thread_name_ = "Worker";
+  ThreadHook on_thread_start_;
+  ThreadHook on_thread_exit_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable job_available_;
+  std::condition_variable idle_;
+  std::deque<Job> jobs_;
+  uint32_t running_ = 0;
+  uint64_t completed_ = 0;
+  bool stopping_ = false;
+
+  void WorkerLoop();
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// XXH64: 64-bit xxHash of a byte range (the reference algorithm, so values match other implementations).
+// A fast non-cryptographic content hash, e.g. to find byte-identical asset files.
+uint64_t XxHash64(const void* data, size_t size, uint64_t seed = 0);
@@ -5,6 +5,7 @@
 #include "component.h"
 #include "material_instance.h"
 #include "mesh.h"
+#include "mesh_lod.h"
 
 // RendererComponent: Submits render packets to scene renderer
 class RendererComponent : public Component {
@@ -17,6 +18,25 @@ class RendererComponent : public Component {
     mesh_ = mesh;
   }
 
+  // Optional LOD set; when present the world pass picks the mesh per frame and mesh_ is only a fallback
+  void SetMeshLOD(MeshLOD* mesh_lod) {
+    mesh_lod_ = mesh_lod;
+    current_lod_ = 0;
+  }
+
+  MeshLOD* GetMeshLOD() const {
+    return mesh_lod_;
+  }
+
+  // Last selected LOD level (hysteresis state)
+  uint32_t GetCurrentLOD() const {
+    return current_lod_;
+  }
+
+  void SetCurrentLOD(uint32_t level) {
+    current_lod_ = level;
+  }
+
   void SetMaterial(MaterialInstance* material) {
     material_ = material;
   }
@@ -45,6 +65,16 @@ class RendererComponent : public Component {
     return uv_transform_;
   }
 
+  // Opt-in: rasterize this renderer into the software occlusion buffer (needs a fully opaque,
+  // Static, large object whose mesh provides occluder geometry)
+  void SetOccluder(bool occluder) {
+    occluder_ = occluder;
+  }
+
+  bool IsOccluder() const {
+    return occluder_;
+  }
+
   void SetSortOrder(float sort_order) {
     sort_order_ = sort_order;
   }
@@ -74,6 +104,8 @@ class RendererComponent : public Component {
 
  private:
   Mesh* mesh_ = nullptr;
+  MeshLOD* mesh_lod_ = nullptr;
+  uint32_t current_lod_ = 0;
   MaterialInstance* material_ = nullptr;
   RenderLayer layer_ = RenderLayer::Opaque;
   RenderTag tag_ = RenderTag::Static;
@@ -85,4 +117,5 @@ class RendererComponent : public Component {
   DirectX::XMFLOAT4 color_ = {1.0f, 1.0f, 1.0f, 1.0f};
   DirectX::XMFLOAT4 uv_transform_ = {0.0f, 0.0f, 1.0f, 1.0f};
   float sort_order_ = 0.0f;
+  bool occluder_ = false;
 };
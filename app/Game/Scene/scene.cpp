@@ -1,5 +1,7 @@
 #include "scene.h"
 
+#include "profiler.h"
+
 GameObject* Scene::CreateGameObject(const std::string& name) {
   auto game_object = std::make_unique<GameObject>(name);
   GameObject* ptr = game_object.get();
@@ -16,6 +18,7 @@ void Scene::DestroyGameObject(GameObject* obj) {
 }
 
 void Scene::Update(float dt) {
+  PROFILE_SCOPE("Scene::Update");
   for (auto& obj : game_objects_) {
     obj->Update(dt);
   }
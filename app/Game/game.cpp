@@ -2,7 +2,9 @@
 
 #include <DirectXMath.h>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 
 #include "Component/camera_component.h"
 #include "Component/renderer_component.h"
@@ -10,12 +12,14 @@
 #include "RenderPass/render_layer.h"
 #include "debug_visual_service.h"
 #include "graphic.h"
+#include "mesh.h"
 
 using namespace DirectX;
 
 namespace {
 constexpr const char* kBlockTestWorldMaterialInstance = "BlockTest_World";
 constexpr const char* kBlockTestUIMaterialInstance = "BlockTest_UI";
+constexpr const wchar_t* kCookedSpherePath = L"Content/meshes/sphere.cmsh";
 }  // namespace
 
 void Game::Initialize(Graphic& graphic) {
@@ -33,16 +37,19 @@ void Game::Initialize(Graphic& graphic) {
     return;
   }
 
-  // Load block_test.png and create a dedicated material instance for world + UI.
-  graphic.ExecuteImmediate([&](ID3D12GraphicsCommandList* cmd) {
-    TextureLoadParams params;
-    params.file_path = L"Content/textures/block_test.png";
-    params.force_srgb = false;
-    block_test_texture_ = graphic.GetTextureManager().LoadTexture(cmd, params);
+  // Load block_test.png in the background and create a dedicated material instance for world + UI.
+  // The materials reference the handle right away; it shows the white placeholder until the texture is ready.
+  TextureLoadParams params;
+  params.file_path = L"Content/textures/block_test.png";
+  params.force_srgb = false;
+  block_test_texture_ = graphic.GetTextureManager().LoadTextureAsync(params, [](TextureHandle, bool loaded) {
+    if (!loaded) {
+      std::cerr << "[Game] Failed to load Content/textures/block_test.png; block test sprites show the error texture" << '\n';
+    }
   });
 
   if (!block_test_texture_.IsValid()) {
-    std::cerr << "[Game] Failed to load Content/textures/block_test.png; block test sprites will use default textures" << '\n';
+    std::cerr << "[Game] Could not start loading Content/textures/block_test.png; block test sprites will use default textures" << '\n';
   } else {
     const auto& defaults = graphic_->GetDefaultAssets();
     auto& material_mgr = graphic_->GetMaterialManager();
@@ -63,6 +70,16 @@ void Game::Initialize(Graphic& graphic) {
     }
   }
 
+  // Cooked sphere (tools/mesh_cooker output); like the sprites it can be drawn as soon as the batch is submitted
+  if (graphic_->GetDefaultAssets().GetMeshCookedOpaqueMaterial()) {
+    graphic.Upload([&](UploadBatch& batch) {
+      cooked_sphere_mesh_ = Mesh::LoadCooked(graphic.GetDevice(), batch, kCookedSpherePath, graphic.GetAssetArchive());
+    });
+    if (!cooked_sphere_mesh_) {
+      std::cerr << "[Game] Failed to load Content/meshes/sphere.cmsh; the cooked mesh demo is skipped" << '\n';
+    }
+  }
+
   // Create demo scene using new system
   CreateNewDemoScene();
 
@@ -182,6 +199,10 @@ GameObject* Game::CreateSprite(const SpriteCreateParams& params) {
   if (!material_to_use) {
     // Route to default material based on layer: UI gets UI material (no depth), world gets depth-tested sprite material.
     material_to_use = HasLayer(params.layer, RenderLayer::UI) ? defaults.GetSpriteUIMaterial() : defaults.GetSpriteWorldOpaqueMaterial();
+    // The defaults sample the white texture; atlas sprites need their page bound instead
+    if (material_to_use && params.texture_region.IsValid()) {
+      material_to_use = GetAtlasPageMaterial(material_to_use, params.texture_region.texture);
+    }
   }
 
   if (material_to_use) {
@@ -192,16 +213,54 @@ GameObject* Game::CreateSprite(const SpriteCreateParams& params) {
 
   // Set rendering properties
   renderer->SetColor(params.color);
-  renderer->SetUVTransform(params.uv_transform);
+  // Atlas sprites sample a sub-rect of the shared page (bound by the atlas page material, or by params.material)
+  renderer->SetUVTransform(params.texture_region.IsValid() ? params.texture_region.Apply(params.uv_transform) : params.uv_transform);
   renderer->SetLayer(params.layer);
   renderer->SetTag(params.tag);
   renderer->SetSortOrder(params.sort_order);
+  renderer->SetOccluder(params.occluder);
 
   obj->AddComponent(renderer);
 
   return obj;
 }
 
+MaterialInstance* Game::GetAtlasPageMaterial(MaterialInstance* default_material, TextureHandle page) {
+  MaterialManager& material_manager = graphic_->GetMaterialManager();
+  MaterialTemplate* material_template = default_material->GetTemplate();
+  const std::string name =
+    "AtlasPage_" + material_template->GetName() + "_" + std::to_string(page.index) + "_" + std::to_string(page.generation);
+  if (MaterialInstance* existing = material_manager.GetInstance(name)) {
+    return existing;
+  }
+
+  MaterialInstance* material = material_manager.CreateInstance(name, material_template);
+  if (!material) {
+    std::cerr << "[Game] Warning: Failed to create atlas page material " << name << ", sprite draws untextured" << '\n';
+    return default_material;
+  }
+  material->SetTexture("BaseColor", page);
+  atlas_page_materials_.emplace_back(page, name);
+  return material;
+}
+
+void Game::ReleaseAtlas(const std::string& atlas_name) {
+  TextureManager& texture_manager = graphic_->GetTextureManager();
+  const std::vector<TextureHandle> pages = texture_manager.GetAtlasPages(atlas_name);
+
+  // The page materials hold page references; remove them first so releasing the atlas frees the pages
+  MaterialManager& material_manager = graphic_->GetMaterialManager();
+  std::erase_if(atlas_page_materials_, [&](const std::pair<TextureHandle, std::string>& entry) {
+    if (std::find(pages.begin(), pages.end(), entry.first) == pages.end()) {
+      return false;
+    }
+    material_manager.RemoveInstance(entry.second);
+    return true;
+  });
+
+  texture_manager.ReleaseAtlas(atlas_name);
+}
+
 void Game::Shutdown() {
   // Shutdown render system first
   render_system_.Shutdown();
@@ -209,6 +268,11 @@ void Game::Shutdown() {
   // Clear scene
   scene_.Clear();
 
+  // Frames in flight may still draw the cooked mesh
+  if (cooked_sphere_mesh_ && graphic_) {
+    graphic_->DeferRelease([mesh = std::move(cooked_sphere_mesh_)]() mutable { mesh.reset(); });
+  }
+
   // Reset references
   active_camera_ = nullptr;
   graphic_ = nullptr;
@@ -298,6 +362,24 @@ void Game::CreateNewDemoScene() {
   }
 
   demo_sprite_ = sprite1;  // Keep reference to first sprite
+
+  // Cooked sphere between the red and green sprites, nearer the camera
+  if (cooked_sphere_mesh_) {
+    GameObject* sphere = scene_.CreateGameObject("CookedSphere");
+
+    auto* transform = new TransformComponent();
+    transform->SetPosition(-2.0f, 0.0f, -1.0f);
+    transform->SetScale(1.5f, 1.5f, 1.5f);
+    sphere->AddComponent(transform);
+
+    auto* renderer = new RendererComponent();
+    renderer->SetMesh(cooked_sphere_mesh_.get());
+    renderer->SetMaterial(graphic_->GetDefaultAssets().GetMeshCookedOpaqueMaterial());
+    renderer->SetColor({1.0f, 0.85f, 0.4f, 1.0f});
+    renderer->SetLayer(RenderLayer::Opaque);
+    sphere->AddComponent(renderer);
+    std::cout << "[Game] Created cooked sphere" << '\n';
+  }
 }
 
 void Game::CreateCamera() {
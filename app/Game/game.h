@@ -2,6 +2,11 @@
 
 #include <DirectXMath.h>
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "RenderPass/render_layer.h"
 #include "Scene/scene.h"
 #include "game_object.h"
@@ -11,6 +16,7 @@
 class Graphic;
 class MaterialInstance;
 class MaterialTemplate;
+class Mesh;
 
 // Updated sprite creation parameters structure
 struct SpriteCreateParams {
@@ -24,6 +30,8 @@ struct SpriteCreateParams {
   RenderTag tag = RenderTag::Static;                          // Default tag
   DirectX::XMFLOAT4 color = {1.0f, 1.0f, 1.0f, 1.0f};         // Optional tint color
   DirectX::XMFLOAT4 uv_transform = {0.0f, 0.0f, 1.0f, 1.0f};  // offset.xy, scale.xy
+  TextureRegion texture_region{};                             // Optional: atlas region, uv_transform is remapped into it
+  bool occluder = false;                                      // Rasterize into the occlusion buffer (opaque Static sprites only)
 };
 
 class Game {
@@ -41,6 +49,10 @@ class Game {
     return scene_;
   }
 
+  // Release an atlas (TextureManager::ReleaseAtlas) along with the atlas page materials created for its
+  // pages; sprites using its regions must be destroyed first
+  void ReleaseAtlas(const std::string& atlas_name);
+
  private:
   Scene scene_;
   RenderSystem render_system_;
@@ -54,6 +66,12 @@ class Game {
   MaterialInstance* block_test_world_material_ = nullptr;
   MaterialInstance* block_test_ui_material_ = nullptr;
 
+  // Atlas page materials (page, instance name); they hold a reference on the page until removed
+  std::vector<std::pair<TextureHandle, std::string>> atlas_page_materials_;
+
+  // Cooked mesh demo (Content/meshes/sphere.cmsh, drawn with the MeshCookedOpaque material)
+  std::shared_ptr<Mesh> cooked_sphere_mesh_;
+
   // Initialization helpers
   bool VerifyDefaultAssets();  // DefaultAssets sanity check
   void CreateNewDemoScene();   // New demo scene using DefaultAssets + Debug API
@@ -61,4 +79,8 @@ class Game {
 
   // Create sprite using DefaultAssets
   GameObject* CreateSprite(const SpriteCreateParams& params);
+
+  // Shared instance of default_material's template sampling an atlas page (one per page and template, so
+  // sprites from the same page still batch)
+  MaterialInstance* GetAtlasPageMaterial(MaterialInstance* default_material, TextureHandle page);
 };
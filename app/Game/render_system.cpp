@@ -1,29 +1,68 @@
 #include "render_system.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 #include "Component/camera_component.h"
 #include "Component/renderer_component.h"
 #include "Component/transform_component.h"
+#include "RenderPass/render_pass.h"
 #include "RenderPass/render_pass_manager.h"
 #include "RenderPass/scene_renderer.h"
 #include "debug_visual_renderer.h"
 #include "debug_visual_renderer_2d.h"
 #include "graphic.h"
+#include "profiler.h"
+
+namespace {
+// Occlusion buffer resolution (coarse on purpose: rasterization cost scales with pixel count)
+constexpr uint32_t kOcclusionBufferWidth = 256;
+constexpr uint32_t kOcclusionBufferHeight = 144;
+
+// Occluders must cover at least this fraction of the screen to be worth rasterizing
+constexpr float kMinOccluderScreenCoverage = 0.01f;
+
+// Relative margin around LOD thresholds before switching (prevents popping at boundaries)
+constexpr float kLODHysteresis = 0.1f;
+
+// Largest relative difference between axis scales for which cone culling still runs in local space
+constexpr float kMaxConeCullScaleSkew = 1e-3f;
+
+// Camera position in the packet's local space, or false when the normal cones do not survive the world
+// transform (non-uniform scale bends them, mirroring flips which side the rasterizer culls)
+bool ComputeLocalCameraPosition(const DirectX::XMFLOAT4X4& world, DirectX::FXMVECTOR camera_position, DirectX::XMFLOAT3& out) {
+  const DirectX::XMMATRIX world_matrix = DirectX::XMLoadFloat4x4(&world);
+  const float scale_x = DirectX::XMVectorGetX(DirectX::XMVector3Length(world_matrix.r[0]));
+  const float scale_y = DirectX::XMVectorGetX(DirectX::XMVector3Length(world_matrix.r[1]));
+  const float scale_z = DirectX::XMVectorGetX(DirectX::XMVector3Length(world_matrix.r[2]));
+  const float max_scale = (std::max)({scale_x, scale_y, scale_z});
+  const float min_scale = (std::min)({scale_x, scale_y, scale_z});
+  if (min_scale <= 0.0f || max_scale - min_scale > kMaxConeCullScaleSkew * max_scale) {
+    return false;
+  }
 
+  DirectX::XMVECTOR determinant;
+  const DirectX::XMMATRIX world_to_local = DirectX::XMMatrixInverse(&determinant, world_matrix);
+  if (DirectX::XMVectorGetX(determinant) <= 0.0f) {
+    return false;
+  }
+  DirectX::XMStoreFloat3(&out, DirectX::XMVector3TransformCoord(camera_position, world_to_local));
+  return true;
+}
+}  // namespace
 
 void RenderSystem::RenderFrame(Scene& scene, GameObject* active_camera) {
   assert(graphic_ != nullptr);
 
   graphic_->BeginFrame();
-  const uint32_t frame_index = graphic_->GetCurrentFrameIndex();
 
   auto& rpm = graphic_->GetRenderPassManager();
   SceneRenderer& sr = rpm.GetSceneRenderer();
 
-  sr.BeginFrame(frame_index);
+  sr.BeginFrame();
 
   // 1) World SceneData
   SceneData world_scene{};
@@ -34,29 +73,62 @@ void RenderSystem::RenderFrame(Scene& scene, GameObject* active_camera) {
   std::vector<RenderPacket> ui_packets;
   BuildRenderQueues(scene, world_packets, ui_packets);
 
-  // 3) World pass + 3D debug
-  RenderWorldPass(scene, active_camera, rpm, sr, world_packets);
+  if (IsCapturing()) {
+    CaptureView("World", rpm.GetPass("Forward"), world_scene, world_packets);
+  }
 
-  // 4) UI pass
-  RenderUIPass(rpm, sr, ui_packets);
+  // 3) Frame graph: world, 3D debug, UI and 2D debug in declaration order.
+  // Barriers (including back buffer -> PRESENT after the last pass) come from the declared accesses.
+  RenderTarget* backbuffer_target = graphic_->GetBackBufferRenderTarget();
+  graph_executor_.Reset(render_graph_);
+  const RenderGraph::Resource backbuffer =
+    graph_executor_.Import(render_graph_, "BackBuffer", backbuffer_target, RenderGraph::Access::Present);
+  const RenderGraph::Resource depth = graph_executor_.Import(render_graph_, "Depth", graphic_->GetDepthBuffer());
+
+  render_graph_.AddPass(
+    "World",
+    [&](RenderGraph::PassBuilder& builder) {
+      builder.Write(backbuffer, RenderGraph::Access::RenderTarget);
+      builder.Write(depth, RenderGraph::Access::DepthWrite);
+    },
+    [&]() { RenderWorldPass(scene, active_camera, rpm, sr, world_packets); });
+
+  // Uses the world scene CB (cached_camera_data_ + scene_renderer.GetCurrentSceneCBVAddress())
+  render_graph_.AddPass(
+    "Debug3D",
+    [&](RenderGraph::PassBuilder& builder) {
+      builder.Write(backbuffer, RenderGraph::Access::RenderTarget);
+      builder.Write(depth, RenderGraph::Access::DepthWrite);
+    },
+    [&]() { RenderDebugVisuals(sr); });
+
+  render_graph_.AddPass(
+    "UI",
+    [&](RenderGraph::PassBuilder& builder) { builder.Write(backbuffer, RenderGraph::Access::RenderTarget); },
+    [&]() { RenderUIPass(rpm, sr, ui_packets); });
+
+  render_graph_.AddPass(
+    "Debug2D",
+    [&](RenderGraph::PassBuilder& builder) { builder.Write(backbuffer, RenderGraph::Access::RenderTarget); },
+    [&]() { RenderDebugVisuals2D(); });
+
+  if (!graph_executor_.Execute(render_graph_, *graphic_)) {
+    graphic_->Transition(backbuffer_target, D3D12_RESOURCE_STATE_PRESENT);
+  }
 
-  // 5) 2D debug
-  RenderDebugVisuals2D(frame_index);
+  if (IsCapturing()) {
+    FinishCaptureFrame();
+  }
 
-  // 6) reset pass if needed
   rpm.Clear();
-  if (rpm.GetPass("Forward")) rpm.GetPass("Forward")->SetEnabled(true);
-  if (rpm.GetPass("UI")) rpm.GetPass("UI")->SetEnabled(true);
-
-  // Transition back buffer for presentation (explicit state management)
-  RenderTarget* backbuffer = graphic_->GetBackBufferRenderTarget();
-  graphic_->Transition(backbuffer, D3D12_RESOURCE_STATE_PRESENT);
 
   graphic_->EndFrame();
 }
 
 void RenderSystem::BuildRenderQueues(Scene& scene, std::vector<RenderPacket>& world_packets, std::vector<RenderPacket>& ui_packets) {
+  PROFILE_SCOPE("RenderSystem::BuildRenderQueues");
   const auto& game_objects = scene.GetGameObjects();
+  std::vector<size_t> occluder_indices;
 
   for (const auto& game_object : game_objects) {
     if (!game_object->IsActive()) {
@@ -83,6 +155,20 @@ void RenderSystem::BuildRenderQueues(Scene& scene, std::vector<RenderPacket>& wo
       DirectX::XMStoreFloat4x4(&packet.world, transform->GetWorldMatrix());
     }
 
+    // LOD selection from projected bounding-sphere size (world objects only)
+    MeshLOD* mesh_lod = renderer->GetMeshLOD();
+    if (mesh_lod && mesh_lod->GetLevelCount() > 0 && !HasLayer(packet.layer, RenderLayer::UI)) {
+      uint32_t level = 0;
+      if (cached_camera_data_.is_valid) {
+        const float screen_size =
+          mesh_lod->ComputeScreenSize(packet.world, cached_camera_data_.view_projection_matrix, cached_camera_data_.projection_matrix);
+        level = mesh_lod->SelectLevel(screen_size, renderer->GetCurrentLOD(), kLODHysteresis);
+      }
+      renderer->SetCurrentLOD(level);
+      packet.mesh = mesh_lod->GetMesh(level);
+      packet.lod_level = static_cast<uint8_t>(level);
+    }
+
     if (!packet.IsValid()) {
       std::cerr << "[RenderSystem] Warning: Invalid render packet from GameObject: " << game_object->GetName() << '\n';
       continue;
@@ -91,9 +177,158 @@ void RenderSystem::BuildRenderQueues(Scene& scene, std::vector<RenderPacket>& wo
     if (HasLayer(packet.layer, RenderLayer::UI)) {
       ui_packets.push_back(packet);
     } else {
+      if (renderer->IsOccluder()) {
+        occluder_indices.push_back(world_packets.size());
+      }
       world_packets.push_back(packet);
     }
   }
+
+  if (occlusion_culling_enabled_ && cached_camera_data_.is_valid) {
+    CullOccludedPackets(world_packets, occluder_indices);
+  }
+  meshlet_draws_.clear();
+  meshlet_cull_stats_ = {};
+  if (meshlet_culling_enabled_ && cached_camera_data_.is_valid) {
+    CullPacketMeshlets(world_packets);
+  }
+}
+
+void RenderSystem::CullPacketMeshlets(std::vector<RenderPacket>& world_packets) {
+  PROFILE_SCOPE("RenderSystem::CullPacketMeshlets");
+
+  const DirectX::XMMATRIX view_proj = cached_camera_data_.view_projection_matrix;
+  // Eye position from the view matrix, so it is the world-space position the projection uses
+  const DirectX::XMVECTOR camera_position = DirectX::XMMatrixInverse(nullptr, cached_camera_data_.view_matrix).r[3];
+
+  // Sub-draw range of each packet in meshlet_draws_; pointers are assigned once the vector stops growing
+  struct DrawRange {
+    size_t packet_index;
+    size_t first;
+    size_t count;
+  };
+  std::vector<DrawRange> ranges;
+
+  size_t write_index = 0;
+  for (size_t i = 0; i < world_packets.size(); ++i) {
+    RenderPacket& packet = world_packets[i];
+    const Mesh* mesh = packet.mesh;
+    if (mesh->HasMeshlets()) {
+      DirectX::XMFLOAT4X4 local_to_clip;
+      DirectX::XMStoreFloat4x4(&local_to_clip, DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&packet.world), view_proj));
+
+      // Cone culling relies on back faces being culled, which transparent materials may not do
+      DirectX::XMFLOAT3 local_camera;
+      const bool cone_cull =
+        !HasLayer(packet.layer, RenderLayer::Transparent) && ComputeLocalCameraPosition(packet.world, camera_position, local_camera);
+
+      const std::vector<Mesh::Section>& meshlets = mesh->GetMeshlets();
+      visible_meshlets_.clear();
+      CullMeshlets(mesh->GetMeshletBounds().data(),
+        meshlets.size(),
+        &local_to_clip.m[0][0],
+        cone_cull ? &local_camera.x : nullptr,
+        visible_meshlets_,
+        &meshlet_cull_stats_);
+      if (visible_meshlets_.empty()) {
+        continue;
+      }
+
+      // Everything visible: the packet keeps drawing its sections
+      if (visible_meshlets_.size() < meshlets.size()) {
+        // Neighbouring visible meshlets are contiguous index ranges, so they merge into one sub-draw
+        const size_t first = meshlet_draws_.size();
+        for (uint32_t meshlet_index : visible_meshlets_) {
+          const Mesh::Section& meshlet = meshlets[meshlet_index];
+          if (meshlet_draws_.size() > first) {
+            Mesh::Section& last = meshlet_draws_.back();
+            if (last.base_vertex == meshlet.base_vertex && last.first_index + last.index_count == meshlet.first_index) {
+              last.index_count += meshlet.index_count;
+              continue;
+            }
+          }
+          meshlet_draws_.push_back(meshlet);
+        }
+        ranges.push_back({write_index, first, meshlet_draws_.size() - first});
+      }
+    }
+
+    if (write_index != i) {
+      world_packets[write_index] = world_packets[i];
+    }
+    ++write_index;
+  }
+  world_packets.resize(write_index);
+
+  for (const DrawRange& range : ranges) {
+    world_packets[range.packet_index].sections = &meshlet_draws_[range.first];
+    world_packets[range.packet_index].section_count = static_cast<uint32_t>(range.count);
+  }
+}
+
+void RenderSystem::CullOccludedPackets(std::vector<RenderPacket>& world_packets, const std::vector<size_t>& occluder_indices) {
+  PROFILE_SCOPE("RenderSystem::CullOccludedPackets");
+  occlusion_buffer_.Clear();
+
+  const DirectX::XMMATRIX view_proj = cached_camera_data_.view_projection_matrix;
+  auto compute_local_to_clip = [&](const RenderPacket& packet, DirectX::XMFLOAT4X4& out) {
+    DirectX::XMStoreFloat4x4(&out, DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&packet.world), view_proj));
+  };
+
+  // 1) Rasterize opted-in occluders: opaque, Static and large on screen
+  std::vector<bool> is_occluder(world_packets.size(), false);
+  for (size_t index : occluder_indices) {
+    const RenderPacket& packet = world_packets[index];
+    const Mesh* mesh = packet.mesh;
+    if (!mesh->HasOccluderGeometry() || !mesh->HasLocalBounds() || !HasTag(packet.tag, RenderTag::Static) ||
+        HasLayer(packet.layer, RenderLayer::Transparent)) {
+      continue;
+    }
+
+    DirectX::XMFLOAT4X4 local_to_clip;
+    compute_local_to_clip(packet, local_to_clip);
+
+    const float* local_to_clip_data = &local_to_clip.m[0][0];
+    if (occlusion_buffer_.ComputeScreenCoverage(local_to_clip_data, &mesh->GetLocalBoundsMin().x, &mesh->GetLocalBoundsMax().x) <
+        kMinOccluderScreenCoverage) {
+      continue;
+    }
+
+    const auto& positions = mesh->GetOccluderPositions();
+    const auto& indices = mesh->GetOccluderIndices();
+    occlusion_buffer_.RasterizeOccluder(local_to_clip_data,
+      &positions[0].x,
+      static_cast<uint32_t>(positions.size()),
+      indices.data(),
+      static_cast<uint32_t>(indices.size()));
+    is_occluder[index] = true;
+  }
+
+  if (occlusion_buffer_.GetStats().occluders == 0) {
+    return;
+  }
+
+  occlusion_buffer_.BuildHiZ();
+
+  // 2) Test remaining packets; occluders themselves are always kept
+  size_t write_index = 0;
+  for (size_t i = 0; i < world_packets.size(); ++i) {
+    const RenderPacket& packet = world_packets[i];
+    bool visible = true;
+    if (!is_occluder[i] && packet.mesh->HasLocalBounds()) {
+      DirectX::XMFLOAT4X4 local_to_clip;
+      compute_local_to_clip(packet, local_to_clip);
+      visible = occlusion_buffer_.IsVisible(&local_to_clip.m[0][0], &packet.mesh->GetLocalBoundsMin().x, &packet.mesh->GetLocalBoundsMax().x);
+    }
+
+    if (visible) {
+      if (write_index != i) {
+        world_packets[write_index] = world_packets[i];
+      }
+      ++write_index;
+    }
+  }
+  world_packets.resize(write_index);
 }
 
 void RenderSystem::Initialize(Graphic& graphic) {
@@ -103,10 +338,13 @@ void RenderSystem::Initialize(Graphic& graphic) {
   debug_renderer_.Initialize(graphic);
   debug_renderer_2d_.Initialize(graphic);
 
+  occlusion_buffer_.Initialize(kOcclusionBufferWidth, kOcclusionBufferHeight);
+
   std::cout << "[RenderSystem] Initialized with debug visual support" << '\n';
 }
 
 void RenderSystem::Shutdown() {
+  EndCapture();
   debug_renderer_.Shutdown();
   debug_renderer_2d_.Shutdown();
   graphic_ = nullptr;
@@ -146,19 +384,18 @@ void RenderSystem::RenderDebugVisuals(SceneRenderer& scene_renderer) {
   }
   debug_scene_data.scene_cb_gpu_address = scene_renderer.GetCurrentSceneCBVAddress();
 
-  const uint32_t frame_index = graphic_->GetCurrentFrameIndex();
-  debug_renderer_.BeginFrame(frame_index);
+  debug_renderer_.BeginFrame();
 
   // Depth-tested pass then overlay pass share the same vertex buffer
   auto render_depth = [&]() {
     if (render_depth_tested) {
-      debug_renderer_.RenderDepthTested(cmds3D, *graphic_, debug_scene_data, scene_renderer.GetFrameConstantBuffer(), debug_settings_);
+      debug_renderer_.RenderDepthTested(cmds3D, *graphic_, debug_scene_data, debug_settings_);
     }
   };
 
   auto render_overlay_pass = [&]() {
     if (render_overlay) {
-      debug_renderer_.RenderOverlay(cmds3D, *graphic_, debug_scene_data, scene_renderer.GetFrameConstantBuffer(), debug_settings_);
+      debug_renderer_.RenderOverlay(cmds3D, *graphic_, debug_scene_data, debug_settings_);
     }
   };
 
@@ -171,7 +408,7 @@ void RenderSystem::RenderDebugVisuals(SceneRenderer& scene_renderer) {
   }
 }
 
-void RenderSystem::RenderDebugVisuals2D(uint32_t frame_index) {
+void RenderSystem::RenderDebugVisuals2D() {
   if (!graphic_) {
     return;
   }
@@ -195,7 +432,7 @@ void RenderSystem::RenderDebugVisuals2D(uint32_t frame_index) {
   UISceneData ui_scene_data;
   ui_scene_data.view_projection_matrix = ortho_proj;
 
-  debug_renderer_2d_.BeginFrame(frame_index);
+  debug_renderer_2d_.BeginFrame();
   debug_renderer_2d_.Render(cmds2D, *graphic_, ui_scene_data, debug_settings_);
 }
 
@@ -243,15 +480,11 @@ void RenderSystem::SetupWorldSceneData(GameObject* active_camera, SceneRenderer&
 }
 
 void RenderSystem::RenderWorldPass(
-  Scene&, GameObject*, RenderPassManager& rpm, SceneRenderer& scene_renderer, const std::vector<RenderPacket>& world_packets) {
+  Scene&, GameObject*, RenderPassManager& rpm, SceneRenderer&, const std::vector<RenderPacket>& world_packets) {
   RenderTarget* backbuffer = graphic_->GetBackBufferRenderTarget();
   DepthBuffer* depth = graphic_->GetDepthBuffer();
 
-  // Explicit resource state setup for the main scene pass
-  graphic_->Transition(backbuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
-  graphic_->Transition(depth, D3D12_RESOURCE_STATE_DEPTH_WRITE);
-
-  // Clear after transitioning to the correct states
+  // The render graph has already transitioned both targets for this pass
   if (backbuffer) {
     std::array<float, 4> clear_color = {0.2f, 0.3f, 0.4f, 1.0f};
     graphic_->Clear(backbuffer, clear_color.data());
@@ -260,35 +493,18 @@ void RenderSystem::RenderWorldPass(
     graphic_->Clear(depth, 1.0f, 0);
   }
 
-  RenderPass* forward_pass = rpm.GetPass("Forward");
-  RenderPass* ui_pass = rpm.GetPass("UI");
-
   rpm.Clear();
-  if (ui_pass) ui_pass->SetEnabled(false);
-  if (forward_pass) forward_pass->SetEnabled(true);
-
   for (const auto& packet : world_packets) {
     rpm.SubmitPacket(packet);
   }
 
-  graphic_->RenderPasses();
-
-  // cached_camera_data_ + scene_renderer.GetFrameConstantBuffer()
-  RenderDebugVisuals(scene_renderer);
+  graphic_->ExecutePass(rpm.GetPass("Forward"));
 }
 
 void RenderSystem::RenderUIPass(RenderPassManager& rpm, SceneRenderer& scene_renderer, const std::vector<RenderPacket>& ui_packets) {
-  // Ensure the main render target is in the correct state for UI rendering.
-  // (Usually a no-op unless an intermediate pass changed the state.)
-  RenderTarget* backbuffer = graphic_->GetBackBufferRenderTarget();
-  graphic_->Transition(backbuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
-
-  RenderPass* forward_pass = rpm.GetPass("Forward");
   RenderPass* ui_pass = rpm.GetPass("UI");
 
   rpm.Clear();
-  if (forward_pass) forward_pass->SetEnabled(false);
-  if (ui_pass) ui_pass->SetEnabled(true);
 
   SceneData ui_scene{};
   DirectX::XMMATRIX view = DirectX::XMMatrixIdentity();
@@ -307,9 +523,97 @@ void RenderSystem::RenderUIPass(RenderPassManager& rpm, SceneRenderer& scene_ren
 
   scene_renderer.SetSceneData(ui_scene);
 
+  if (IsCapturing()) {
+    CaptureView("UI", ui_pass, ui_scene, ui_packets);
+  }
+
   for (const auto& packet : ui_packets) {
     rpm.SubmitPacket(packet);
   }
 
-  graphic_->RenderPasses();
+  graphic_->ExecutePass(ui_pass);
+}
+
+bool RenderSystem::BeginCapture(const std::string& file_path, uint32_t frame_count) {
+  EndCapture();
+
+  if (!capture_writer_.Open(file_path)) {
+    return false;
+  }
+
+  capture_ids_.clear();
+  capture_frame_ = RenderCaptureFrame{};
+  capture_frames_remaining_ = frame_count;
+  capture_frame_number_ = 0;
+
+  std::cout << "[RenderSystem] Capturing render packets to " << file_path << '\n';
+  return true;
+}
+
+void RenderSystem::EndCapture() {
+  if (!capture_writer_.IsOpen()) {
+    return;
+  }
+
+  std::cout << "[RenderSystem] Capture finished (" << capture_writer_.GetFrameCount() << " frames, " << capture_ids_.size() << " ids)"
+            << '\n';
+  capture_writer_.Close();
+  capture_ids_.clear();
+}
+
+uint32_t RenderSystem::GetCaptureId(const void* object) {
+  if (object == nullptr) {
+    return 0;
+  }
+  auto [it, inserted] = capture_ids_.try_emplace(object, static_cast<uint32_t>(capture_ids_.size()) + 1);
+  return it->second;
+}
+
+void RenderSystem::CaptureView(const char* name, const RenderPass* pass, const SceneData& scene_data, const std::vector<RenderPacket>& packets) {
+  static_assert(sizeof(SceneData) == sizeof(RenderCaptureSceneData), "SceneData layout must match the capture format");
+
+  RenderCaptureView& view = capture_frame_.views.emplace_back();
+  view.name = name;
+  if (pass) {
+    const RenderFilter filter = pass->GetFilter();
+    view.layer_mask = static_cast<uint8_t>(filter.layer_mask);
+    view.tag_mask = static_cast<uint8_t>(filter.tag_mask);
+    view.tag_exclude_mask = static_cast<uint8_t>(filter.tag_exclude_mask);
+  }
+  std::memcpy(&view.scene_data, &scene_data, sizeof(SceneData));
+
+  view.packets.reserve(packets.size());
+  for (const RenderPacket& packet : packets) {
+    RenderCapturePacket& captured = view.packets.emplace_back();
+    captured.mesh_id = GetCaptureId(packet.mesh);
+    captured.material_id = GetCaptureId(packet.material);
+    captured.template_id = GetCaptureId(packet.material->GetTemplate());
+    captured.texture_index = SceneRenderer::GetSortTextureIndex(packet.material);
+    captured.index_count = packet.mesh->GetIndexCount();
+    if (packet.sections != nullptr) {
+      // Only the meshlets that survived culling are drawn
+      captured.index_count = 0;
+      for (uint32_t i = 0; i < packet.section_count; ++i) {
+        captured.index_count += packet.sections[i].index_count;
+      }
+    }
+    captured.layer = static_cast<uint8_t>(packet.layer);
+    captured.tag = static_cast<uint8_t>(packet.tag);
+    captured.lod_level = packet.lod_level;
+    captured.reserved = 0;
+    captured.sort_order = packet.sort_order;
+    std::memcpy(captured.world, &packet.world, sizeof(captured.world));
+    std::memcpy(captured.color, &packet.color, sizeof(captured.color));
+    std::memcpy(captured.uv_transform, &packet.uv_transform, sizeof(captured.uv_transform));
+  }
+}
+
+void RenderSystem::FinishCaptureFrame() {
+  capture_frame_.frame_number = capture_frame_number_++;
+  capture_writer_.WriteFrame(capture_frame_);
+  capture_frame_.views.clear();
+
+  if (capture_frames_remaining_ > 0 && --capture_frames_remaining_ == 0) {
+    EndCapture();
+  }
 }
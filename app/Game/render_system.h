@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "RenderPass/scene_renderer.h"
@@ -8,6 +10,11 @@
 #include "debug_visual_renderer_2d.h"
 #include "debug_visual_service.h"
 #include "game_object.h"
+#include "meshlet.h"
+#include "occlusion_buffer.h"
+#include "render_capture.h"
+#include "render_graph.h"
+#include "render_graph_executor.h"
 
 class Graphic;
 class RenderPassManager;
@@ -39,6 +46,42 @@ class RenderSystem {
     return debug_settings_;
   }
 
+  // Software occlusion culling of world packets
+  void SetOcclusionCullingEnabled(bool enabled) {
+    occlusion_culling_enabled_ = enabled;
+  }
+
+  bool IsOcclusionCullingEnabled() const {
+    return occlusion_culling_enabled_;
+  }
+
+  const OcclusionBuffer::Stats& GetOcclusionStats() const {
+    return occlusion_buffer_.GetStats();
+  }
+
+  // Per-meshlet frustum and backface-cone culling of world packets whose mesh has meshlets; the visible
+  // ones are drawn as merged indexed sub-draws
+  void SetMeshletCullingEnabled(bool enabled) {
+    meshlet_culling_enabled_ = enabled;
+  }
+
+  bool IsMeshletCullingEnabled() const {
+    return meshlet_culling_enabled_;
+  }
+
+  const MeshletCullStats& GetMeshletCullStats() const {
+    return meshlet_cull_stats_;
+  }
+
+  // Record the submitted packets of the next frame_count frames (0 = until EndCapture)
+  // into a binary capture for offline replay (tools/render_replay)
+  bool BeginCapture(const std::string& file_path, uint32_t frame_count = 0);
+  void EndCapture();
+
+  bool IsCapturing() const {
+    return capture_writer_.IsOpen();
+  }
+
  private:
   Graphic* graphic_ = nullptr;
   DebugVisualService debug_service_;
@@ -55,9 +98,35 @@ class RenderSystem {
     bool is_valid = false;
   } cached_camera_data_;
 
+  // Rebuilt every frame (keeps its allocations)
+  RenderGraph render_graph_;
+  RenderGraphExecutor graph_executor_;
+
+  OcclusionBuffer occlusion_buffer_;
+  bool occlusion_culling_enabled_ = true;
+
+  // Sub-draws of meshlet-culled packets (RenderPacket::sections points in here until the next frame)
+  std::vector<Mesh::Section> meshlet_draws_;
+  std::vector<uint32_t> visible_meshlets_;
+  MeshletCullStats meshlet_cull_stats_;
+  bool meshlet_culling_enabled_ = true;
+
+  // Render packet capture
+  RenderCaptureWriter capture_writer_;
+  RenderCaptureFrame capture_frame_;
+  std::unordered_map<const void*, uint32_t> capture_ids_;  // stable ids in first-use order
+  uint32_t capture_frames_remaining_ = 0;
+  uint64_t capture_frame_number_ = 0;
+
+  void CaptureView(const char* name, const RenderPass* pass, const SceneData& scene_data, const std::vector<RenderPacket>& packets);
+  void FinishCaptureFrame();
+  uint32_t GetCaptureId(const void* object);
+
   void BuildRenderQueues(Scene& scene, std::vector<RenderPacket>& world_packets, std::vector<RenderPacket>& ui_packets);
+  void CullOccludedPackets(std::vector<RenderPacket>& world_packets, const std::vector<size_t>& occluder_indices);
+  void CullPacketMeshlets(std::vector<RenderPacket>& world_packets);
   void RenderDebugVisuals(SceneRenderer& scene_renderer);
-  void RenderDebugVisuals2D(uint32_t frame_index);
+  void RenderDebugVisuals2D();
 
   void RenderWorldPass(Scene& scene,
     GameObject* active_camera,
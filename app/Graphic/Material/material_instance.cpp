@@ -1,10 +1,24 @@
 #include "material_instance.h"
 
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <iostream>
 
-bool MaterialInstance::Initialize(MaterialTemplate* material_template) {
+#include "descriptor_table_ring.h"
+
+MaterialInstance::~MaterialInstance() {
+  if (texture_manager_ == nullptr) {
+    return;
+  }
+  for (const TextureHandle& texture : textures_) {
+    if (texture_manager_->IsValid(texture)) {
+      texture_manager_->ReleaseTexture(texture);
+    }
+  }
+}
+
+bool MaterialInstance::Initialize(MaterialTemplate* material_template, TextureManager* texture_manager) {
   assert(material_template != nullptr);
 
   if (!material_template->IsValid()) {
@@ -13,6 +27,8 @@ bool MaterialInstance::Initialize(MaterialTemplate* material_template) {
   }
 
   template_ = material_template;
+  texture_manager_ = texture_manager;
+  textures_.assign(template_->GetTextureSlotCount(), INVALID_TEXTURE_HANDLE);
 
   // Pre-allocate constant buffer storage based on template definitions
   for (int i = 0; i < template_->GetConstantBufferCount(); ++i) {
@@ -29,8 +45,8 @@ bool MaterialInstance::Initialize(MaterialTemplate* material_template) {
 
 void MaterialInstance::SetTexture(const std::string& slot_name, TextureHandle handle) {
   // Validate slot exists in template
-  const TextureSlotDefinition* slot = template_->GetTextureSlot(slot_name);
-  if (slot == nullptr) {
+  const int slot_index = template_->GetTextureSlotIndex(slot_name);
+  if (slot_index < 0) {
     if (warning_logged_[slot_name] == false) {
       std::cerr << "[MaterialInstance] Warning: Texture slot '" << slot_name << "' not defined in template '" << template_->GetName() << "'"
                 << '\n';
@@ -39,20 +55,27 @@ void MaterialInstance::SetTexture(const std::string& slot_name, TextureHandle ha
     return;
   }
 
-  textures_[slot_name] = handle;
+  // Acquire before releasing, in case the slot already holds this texture's last reference
+  if (texture_manager_ != nullptr) {
+    if (texture_manager_->IsValid(handle)) {
+      texture_manager_->AcquireTexture(handle);
+    }
+    if (texture_manager_->IsValid(textures_[slot_index])) {
+      texture_manager_->ReleaseTexture(textures_[slot_index]);
+    }
+  }
+  textures_[slot_index] = handle;
 }
 
 TextureHandle MaterialInstance::GetTexture(const std::string& slot_name) const {
-  auto it = textures_.find(slot_name);
-  if (it != textures_.end()) {
-    return it->second;
+  if (template_ == nullptr) {
+    return INVALID_TEXTURE_HANDLE;
   }
-  return INVALID_TEXTURE_HANDLE;
+  return GetTextureBySlotIndex(template_->GetTextureSlotIndex(slot_name));
 }
 
 bool MaterialInstance::HasTexture(const std::string& slot_name) const {
-  auto it = textures_.find(slot_name);
-  return it != textures_.end() && it->second.IsValid();
+  return GetTexture(slot_name).IsValid();
 }
 
 void MaterialInstance::SetConstantBufferData(const std::string& cb_name, const void* data, size_t size) {
@@ -90,30 +113,71 @@ void MaterialInstance::Bind(ID3D12GraphicsCommandList* command_list, TextureMana
     return;
   }
 
-  // Bind textures
-  for (int i = 0; i < template_->GetTextureSlotCount(); ++i) {
-    const TextureSlotDefinition* slot_def = template_->GetTextureSlotByIndex(i);
-    if (slot_def == nullptr) continue;
+  const int slot_count = static_cast<int>(textures_.size());
+  for (const TextureHandle& texture : textures_) {
+    texture_manager.MarkUsed(texture);
+  }
 
-    // Get texture handle for this slot
-    TextureHandle handle = GetTexture(slot_def->name);
-    if (!handle.IsValid()) {
-      // No texture bound for this slot - could use a default texture here
-      continue;
+  // Bindless: the SRV table is bound once per root signature by the renderer; only indices change per draw
+  if (template_->IsBindless()) {
+    if (slot_count > 0) {
+      std::array<uint32_t, MaterialTemplate::kMaxBindlessTextureSlots> indices{};
+      for (int i = 0; i < slot_count; ++i) {
+        indices[i] = texture_manager.GetBindlessIndex(textures_[i]);
+      }
+      command_list->SetGraphicsRoot32BitConstants(template_->GetBindlessIndexRootIndex(), static_cast<UINT>(slot_count), indices.data(), 0);
     }
+    return;
+  }
 
-    // Get texture from manager
-    const Texture* texture = texture_manager.GetTexture(handle);
-    if (texture == nullptr) {
-      std::cerr << "[MaterialInstance] Warning: Invalid texture handle for slot '" << slot_def->name << "'" << '\n';
-      continue;
+  // Bind textures. Consecutive slots sharing a root parameter form one descriptor table (in slot order).
+  DescriptorTableRing* table_ring = texture_manager.GetDescriptorTableRing();
+  int first = 0;
+  while (first < slot_count) {
+    const TextureSlotDefinition* first_def = template_->GetTextureSlotByIndex(first);
+    int end = first + 1;
+    while (end < slot_count && template_->GetTextureSlotByIndex(end)->root_parameter_index == first_def->root_parameter_index) {
+      ++end;
+    }
+    const int table_size = end - first;
+
+    // Assemble the table from staging SRVs (deduplicated per frame, copied in one batch at frame end)
+    if (table_ring != nullptr && table_size <= kMaxTableSlots) {
+      std::array<D3D12_CPU_DESCRIPTOR_HANDLE, kMaxTableSlots> sources{};
+      bool complete = true;
+      for (int i = 0; i < table_size && complete; ++i) {
+        sources[i] = texture_manager.GetTableSource(textures_[first + i]);
+        complete = sources[i].ptr != 0;
+      }
+      if (complete) {
+        const D3D12_GPU_DESCRIPTOR_HANDLE table = table_ring->AllocateTable(sources.data(), static_cast<uint32_t>(table_size));
+        if (table.ptr != 0) {
+          command_list->SetGraphicsRootDescriptorTable(first_def->root_parameter_index, table);
+          first = end;
+          continue;
+        }
+      }
     }
 
-    // Get SRV and bind
-    auto srv = texture->GetSRV();
-    if (srv.IsValid() && srv.IsShaderVisible()) {
-      command_list->SetGraphicsRootDescriptorTable(slot_def->root_parameter_index, srv.gpu);
+    // Fallback: point a single-slot table straight at the texture's shader-visible SRV
+    if (table_size == 1) {
+      // Get texture handle for this slot
+      TextureHandle handle = textures_[first];
+      const Texture* texture = handle.IsValid() ? texture_manager.GetTexture(handle) : nullptr;
+      if (handle.IsValid() && texture == nullptr) {
+        std::cerr << "[MaterialInstance] Warning: Invalid texture handle for slot '" << first_def->name << "'" << '\n';
+      }
+
+      // Get SRV and bind
+      if (texture != nullptr) {
+        auto srv = texture->GetSRV();
+        if (srv.IsValid() && srv.IsShaderVisible()) {
+          command_list->SetGraphicsRootDescriptorTable(first_def->root_parameter_index, srv.gpu);
+        }
+      }
     }
+
+    first = end;
   }
 
   // TOOD: Bind constant buffers
@@ -128,8 +192,9 @@ void MaterialInstance::PrintInfo() const {
   }
 
   std::cout << "\nBound Textures (" << textures_.size() << "):" << '\n';
-  for (const auto& [name, handle] : textures_) {
-    std::cout << "  - " << name << ": [" << handle.index << ":" << handle.generation << "]" << '\n';
+  for (size_t i = 0; i < textures_.size(); ++i) {
+    const TextureSlotDefinition* slot_def = template_->GetTextureSlotByIndex(static_cast<int>(i));
+    std::cout << "  - " << slot_def->name << ": [" << textures_[i].index << ":" << textures_[i].generation << "]" << '\n';
   }
 
   std::cout << "\nConstant Buffers (" << constant_buffers_.size() << "):" << '\n';
@@ -14,19 +14,27 @@
 // References a shared MaterialTemplate for PSO and root signature
 class MaterialInstance {
  public:
+  // Largest descriptor table assembled from consecutive texture slots
+  static constexpr int kMaxTableSlots = 8;
+
   MaterialInstance() = default;
-  ~MaterialInstance() = default;
+  ~MaterialInstance();
 
   MaterialInstance(const MaterialInstance&) = delete;
   MaterialInstance& operator=(const MaterialInstance&) = delete;
 
-  // Initialize with a template
-  bool Initialize(MaterialTemplate* material_template);
+  // Initialize with a template. With a texture manager, assigned textures hold a reference
+  // (AcquireTexture) until they are replaced or the instance is destroyed.
+  bool Initialize(MaterialTemplate* material_template, TextureManager* texture_manager = nullptr);
 
   // Texture management
   void SetTexture(const std::string& slot_name, TextureHandle handle);
   TextureHandle GetTexture(const std::string& slot_name) const;
   bool HasTexture(const std::string& slot_name) const;
+  // Slot index as defined by the template (no string lookup; used on the draw path)
+  TextureHandle GetTextureBySlotIndex(int slot_index) const {
+    return (slot_index >= 0 && slot_index < static_cast<int>(textures_.size())) ? textures_[slot_index] : INVALID_TEXTURE_HANDLE;
+  }
 
   // Constant buffer data management
   // Sets raw data for a constant buffer
@@ -49,7 +57,8 @@ class MaterialInstance {
   }
 
   // Bind this material instance for rendering
-  // Sets PSO, root signature, textures, and constant buffers
+  // Sets textures (one descriptor table per slot, or the per-draw index constants for bindless templates)
+  // and constant buffers
   void Bind(ID3D12GraphicsCommandList* command_list, TextureManager& texture_manager) const;
 
   // Getters
@@ -65,9 +74,10 @@ class MaterialInstance {
 
  private:
   MaterialTemplate* template_ = nullptr;
+  TextureManager* texture_manager_ = nullptr;
 
-  // Texture assignments: slot_name -> TextureHandle
-  std::map<std::string, TextureHandle> textures_;
+  // Texture assignments, indexed like the template's texture slots
+  std::vector<TextureHandle> textures_;
 
   // Constant buffer data: cb_name -> raw byte data
   std::map<std::string, std::vector<uint8_t>> constant_buffers_;
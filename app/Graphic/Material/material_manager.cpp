@@ -43,7 +43,7 @@ MaterialInstance* MaterialManager::CreateInstance(const std::string& name, Mater
   }
 
   auto instance = std::make_unique<MaterialInstance>();
-  if (!instance->Initialize(material_template)) {
+  if (!instance->Initialize(material_template, texture_manager_)) {
     std::cerr << "[MaterialManager] Failed to initialize instance '" << name << "'" << '\n';
     return nullptr;
   }
@@ -7,6 +7,7 @@
 #include "material_template.h"
 
 class MaterialInstance;
+class TextureManager;
 
 // MaterialManager: Manages MaterialTemplates
 // Provides centralized creation and lookup of material templates
@@ -25,6 +26,11 @@ class MaterialManager {
     const std::vector<TextureSlotDefinition>& texture_slots = {},
     const std::vector<ConstantBufferDefinition>& constant_buffers = {});
 
+  // Optional: instances created afterwards hold references on their textures (must outlive the instances)
+  void SetTextureManager(TextureManager* texture_manager) {
+    texture_manager_ = texture_manager;
+  }
+
   // Create and register a material instance owned by the manager
   MaterialInstance* CreateInstance(const std::string& name, MaterialTemplate* material_template);
 
@@ -65,4 +71,5 @@ class MaterialManager {
  private:
   std::unordered_map<std::string, std::unique_ptr<MaterialTemplate>> templates_;
   std::unordered_map<std::string, std::unique_ptr<MaterialInstance>> instances_;
+  TextureManager* texture_manager_ = nullptr;
 };
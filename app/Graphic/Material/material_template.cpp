@@ -19,6 +19,11 @@ bool MaterialTemplate::Initialize(ID3D12PipelineState* pso,
   texture_slots_ = texture_slots;
   constant_buffers_ = constant_buffers;
 
+  sort_texture_slot_index_ = GetTextureSlotIndex("albedo");
+  if (sort_texture_slot_index_ < 0 && !texture_slots_.empty()) {
+    sort_texture_slot_index_ = 0;
+  }
+
   std::cout << "[MaterialTemplate] Initialized: " << name_ << " with " << texture_slots_.size() << " texture slots, "
             << constant_buffers_.size() << " constant buffers" << '\n';
 
@@ -41,6 +46,23 @@ const TextureSlotDefinition* MaterialTemplate::GetTextureSlotByIndex(int index)
   return &texture_slots_[index];
 }
 
+int MaterialTemplate::GetTextureSlotIndex(const std::string& name) const {
+  for (size_t i = 0; i < texture_slots_.size(); ++i) {
+    if (texture_slots_[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void MaterialTemplate::SetBindless(UINT texture_table_root_index, UINT texture_index_root_index) {
+  assert(texture_slots_.size() <= static_cast<size_t>(kMaxBindlessTextureSlots));
+
+  bindless_ = true;
+  bindless_table_root_index_ = texture_table_root_index;
+  bindless_index_root_index_ = texture_index_root_index;
+}
+
 const ConstantBufferDefinition* MaterialTemplate::GetConstantBuffer(const std::string& name) const {
   for (const auto& cb : constant_buffers_) {
     if (cb.name == name) {
@@ -61,6 +83,7 @@ void MaterialTemplate::PrintInfo() const {
   std::cout << "\n=== MaterialTemplate: " << name_ << " ===" << '\n';
   std::cout << "PSO: " << (pso_ != nullptr ? "Valid" : "Invalid") << '\n';
   std::cout << "Root Signature: " << (root_signature_ != nullptr ? "Valid" : "Invalid") << '\n';
+  std::cout << "Bindless: " << (bindless_ ? "Yes" : "No") << '\n';
 
   std::cout << "\nTexture Slots (" << texture_slots_.size() << "):" << '\n';
   for (const auto& slot : texture_slots_) {
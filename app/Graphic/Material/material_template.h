@@ -24,6 +24,9 @@ struct ConstantBufferDefinition {
 
 class MaterialTemplate {
  public:
+  // Bindless templates take one uint texture index per slot (in slot order) as root constants
+  static constexpr int kMaxBindlessTextureSlots = 8;
+
   MaterialTemplate() = default;
   ~MaterialTemplate() = default;
 
@@ -54,6 +57,39 @@ class MaterialTemplate {
 
   const TextureSlotDefinition* GetTextureSlot(const std::string& name) const;
   const TextureSlotDefinition* GetTextureSlotByIndex(int index) const;
+  int GetTextureSlotIndex(const std::string& name) const;
+
+  // Slot used for the texture part of the sort key ("albedo" if present, otherwise the first slot; -1 if none)
+  int GetSortTextureSlotIndex() const {
+    return sort_texture_slot_index_;
+  }
+
+  // Switch to the bindless model: the whole texture SRV table is bound once at texture_table_root_index,
+  // and per-draw texture indices go to the root constants at texture_index_root_index.
+  void SetBindless(UINT texture_table_root_index, UINT texture_index_root_index);
+  bool IsBindless() const {
+    return bindless_;
+  }
+  UINT GetBindlessTableRootIndex() const {
+    return bindless_table_root_index_;
+  }
+  UINT GetBindlessIndexRootIndex() const {
+    return bindless_index_root_index_;
+  }
+
+  // Quantized meshes (Mesh::HasPositionDequantization) send offset.xyz, 0, scale.xyz, 0 as 8 root constants at
+  // root_index and keep the world matrix as is, so the shader can transform normals with it. Without this the
+  // renderer folds the dequantization into the world matrix.
+  void SetPositionDequantization(UINT root_index) {
+    position_dequantization_ = true;
+    position_dequantization_root_index_ = root_index;
+  }
+  bool TakesPositionDequantization() const {
+    return position_dequantization_;
+  }
+  UINT GetPositionDequantizationRootIndex() const {
+    return position_dequantization_root_index_;
+  }
 
   int GetConstantBufferCount() const {
     return static_cast<int>(constant_buffers_.size());
@@ -75,4 +111,12 @@ class MaterialTemplate {
 
   std::vector<TextureSlotDefinition> texture_slots_;
   std::vector<ConstantBufferDefinition> constant_buffers_;
+  int sort_texture_slot_index_ = -1;
+
+  bool bindless_ = false;
+  UINT bindless_table_root_index_ = 0;
+  UINT bindless_index_root_index_ = 0;
+
+  bool position_dequantization_ = false;
+  UINT position_dequantization_root_index_ = 0;
 };
@@ -12,10 +12,18 @@ struct FullscreenVertex {
   XMFLOAT2 uv;
 };
 
-bool FullscreenPassHelper::Initialize(ID3D12Device* device, UploadContext& upload_context) {
+bool FullscreenPassHelper::Initialize(ID3D12Device* device, CopyQueue& copy_queue) {
   assert(device != nullptr);
 
-  if (!CreateFullscreenQuadGeometry(device, upload_context)) {
+  UploadBatch* batch = copy_queue.Begin();
+  if (batch == nullptr) {
+    std::cerr << "[FullscreenPassHelper] Failed to begin upload batch" << '\n';
+    return false;
+  }
+  const bool created = CreateFullscreenQuadGeometry(device, *batch);
+  copy_queue.Submit(batch);
+
+  if (!created) {
     std::cerr << "[FullscreenPassHelper] Failed to create fullscreen quad geometry" << '\n';
     return false;
   }
@@ -63,6 +71,7 @@ void FullscreenPassHelper::DrawQuadWithTexture(ID3D12GraphicsCommandList* comman
 
   // Bind input texture (assume root parameter 0 for descriptor table)
   if (input.IsValid()) {
+    texture_manager.MarkUsed(input);
     const Texture* input_texture = texture_manager.GetTexture(input);
     if (input_texture != nullptr) {
       auto srv = input_texture->GetSRV();
@@ -77,7 +86,7 @@ void FullscreenPassHelper::DrawQuadWithTexture(ID3D12GraphicsCommandList* comman
   fullscreen_quad_.Draw(command_list);
 }
 
-bool FullscreenPassHelper::CreateFullscreenQuadGeometry(ID3D12Device* device, UploadContext& upload_context) {
+bool FullscreenPassHelper::CreateFullscreenQuadGeometry(ID3D12Device* device, UploadBatch& batch) {
   // Fullscreen quad vertices (NDC space: -1 to 1)
   // Counter-clockwise winding
   FullscreenVertex vertices[] = {
@@ -88,8 +97,7 @@ bool FullscreenPassHelper::CreateFullscreenQuadGeometry(ID3D12Device* device, Up
   };
 
   // Create vertex buffer
-  vertex_buffer_ = Buffer::CreateAndUploadToDefaultHeapForInit(
-    device, upload_context, vertices, sizeof(vertices), Buffer::Type::Vertex, "FullscreenQuad_VertexBuffer");
+  vertex_buffer_ = Buffer::CreateAndUpload(device, batch, vertices, sizeof(vertices), Buffer::Type::Vertex, "FullscreenQuad_VertexBuffer");
   if (!vertex_buffer_) {
     std::cerr << "[FullscreenPassHelper] Failed to create vertex buffer" << '\n';
     return false;
@@ -99,8 +107,7 @@ bool FullscreenPassHelper::CreateFullscreenQuadGeometry(ID3D12Device* device, Up
   uint16_t indices[] = {0, 1, 2, 2, 1, 3};
 
   // Create index buffer
-  index_buffer_ = Buffer::CreateAndUploadToDefaultHeapForInit(
-    device, upload_context, indices, sizeof(indices), Buffer::Type::Index, "FullscreenQuad_IndexBuffer");
+  index_buffer_ = Buffer::CreateAndUpload(device, batch, indices, sizeof(indices), Buffer::Type::Index, "FullscreenQuad_IndexBuffer");
   if (!index_buffer_) {
     std::cerr << "[FullscreenPassHelper] Failed to create index buffer" << '\n';
     return false;
@@ -3,10 +3,10 @@
 #include <d3d12.h>
 
 #include "buffer.h"
+#include "copy_queue.h"
 #include "mesh.h"
 #include "render_target.h"
 #include "texture_manager.h"
-#include "upload_context.h"
 
 // Helper class for rendering fullscreen quads (post-processing, screen-space effects)
 class FullscreenPassHelper {
@@ -17,8 +17,8 @@ class FullscreenPassHelper {
   FullscreenPassHelper(const FullscreenPassHelper&) = delete;
   FullscreenPassHelper& operator=(const FullscreenPassHelper&) = delete;
 
-  // Initialize with device
-  bool Initialize(ID3D12Device* device, UploadContext& upload_context);
+  // Initialize with device (the quad geometry is uploaded on the copy queue)
+  bool Initialize(ID3D12Device* device, CopyQueue& copy_queue);
 
   // Draw a fullscreen quad with custom PSO and input texture
   void DrawQuad(
@@ -41,5 +41,5 @@ class FullscreenPassHelper {
   std::shared_ptr<Buffer> index_buffer_;
   Mesh fullscreen_quad_;
 
-  bool CreateFullscreenQuadGeometry(ID3D12Device* device, UploadContext& upload_context);
+  bool CreateFullscreenQuadGeometry(ID3D12Device* device, UploadBatch& batch);
 };
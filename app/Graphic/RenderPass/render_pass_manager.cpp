@@ -5,17 +5,17 @@
 
 #include "RenderPass/render_pass.h"
 
-bool RenderPassManager::Initialize(ID3D12Device* device, uint32_t frame_count, UploadContext& upload_context) {
+bool RenderPassManager::Initialize(ID3D12Device* device, UploadRing& upload_ring, CopyQueue& copy_queue) {
   assert(device != nullptr);
 
   // Initialize shared scene renderer
-  if (!scene_renderer_.Initialize(device, frame_count)) {
+  if (!scene_renderer_.Initialize(&upload_ring)) {
     std::cerr << "[RenderPassManager] Failed to initialize scene renderer" << '\n';
     return false;
   }
 
   // Initialize fullscreen pass helper
-  if (!fullscreen_helper_.Initialize(device, upload_context)) {
+  if (!fullscreen_helper_.Initialize(device, copy_queue)) {
     std::cerr << "[RenderPassManager] Failed to initialize fullscreen pass helper" << '\n';
     return false;
   }
@@ -86,34 +86,48 @@ void RenderPassManager::RenderFrame(ID3D12GraphicsCommandList* command_list, Tex
 
   // Execute each enabled pass in order
   for (const auto& pass : passes_) {
-    if (!pass->IsEnabled()) {
-      continue;
+    if (pass->IsEnabled()) {
+      RecordPass(command_list, pass.get(), texture_manager);
     }
+  }
+}
+
+void RenderPassManager::ExecutePass(ID3D12GraphicsCommandList* command_list, RenderPass* pass, TextureManager& texture_manager) {
+  assert(command_list != nullptr);
+  assert(pass != nullptr);
+
+  auto pass_queue_it = pass_queues_.find(pass);
+  if (render_queue_.empty() && (pass_queue_it == pass_queues_.end() || pass_queue_it->second.empty())) {
+    return;
+  }
 
-    // Clear scene renderer and feed packets from unified queue or pass-specific queue
-    scene_renderer_.Clear();
+  RecordPass(command_list, pass, texture_manager);
+}
+
+void RenderPassManager::RecordPass(ID3D12GraphicsCommandList* command_list, RenderPass* pass, TextureManager& texture_manager) {
+  // Clear scene renderer and feed packets from unified queue or pass-specific queue
+  scene_renderer_.Clear();
 
-    // Unified queue flows through all passes
-    for (const auto& packet : render_queue_) {
+  // Unified queue flows through all passes
+  for (const auto& packet : render_queue_) {
+    scene_renderer_.Submit(packet);
+  }
+  // Pass-specific queue applies only to this pass
+  auto pass_queue_it = pass_queues_.find(pass);
+  if (pass_queue_it != pass_queues_.end()) {
+    for (const auto& packet : pass_queue_it->second) {
       scene_renderer_.Submit(packet);
     }
-    // Pass-specific queue applies only to this pass
-    auto pass_queue_it = pass_queues_.find(pass.get());
-    if (pass_queue_it != pass_queues_.end()) {
-      for (const auto& packet : pass_queue_it->second) {
-        scene_renderer_.Submit(packet);
-      }
-    }
+  }
 
-    // Begin pass
-    pass->Begin(command_list);
+  // Begin pass
+  pass->Begin(command_list);
 
-    // Render pass
-    pass->Render(command_list, scene_renderer_, texture_manager);
+  // Render pass
+  pass->Render(command_list, scene_renderer_, texture_manager);
 
-    // End pass
-    pass->End(command_list);
-  }
+  // End pass
+  pass->End(command_list);
 }
 
 void RenderPassManager::Clear() {
@@ -21,7 +21,7 @@ class RenderPassManager {
   RenderPassManager& operator=(const RenderPassManager&) = delete;
 
   // Initialize manager with device
-  bool Initialize(ID3D12Device* device, uint32_t frame_count, UploadContext& upload_context);
+  bool Initialize(ID3D12Device* device, UploadRing& upload_ring, CopyQueue& copy_queue);
 
   // Register a render pass
   void RegisterPass(const std::string& name, std::unique_ptr<RenderPass> pass);
@@ -38,6 +38,9 @@ class RenderPassManager {
   // Execute all enabled passes
   void RenderFrame(ID3D12GraphicsCommandList* command_list, TextureManager& texture_manager);
 
+  // Execute one pass regardless of its enabled flag (used when a render graph schedules the passes)
+  void ExecutePass(ID3D12GraphicsCommandList* command_list, RenderPass* pass, TextureManager& texture_manager);
+
   // Clear render queue
   void Clear();
 
@@ -70,4 +73,6 @@ class RenderPassManager {
 
   SceneRenderer scene_renderer_;
   FullscreenPassHelper fullscreen_helper_;
+
+  void RecordPass(ID3D12GraphicsCommandList* command_list, RenderPass* pass, TextureManager& texture_manager);
 };
@@ -6,28 +6,19 @@
 
 #include "utils.h"
 #include "RenderPass/render_constants.h"
+#include "profiler.h"
+#include "render_sort_key.h"
 
-bool SceneRenderer::Initialize(ID3D12Device* device, uint32_t frame_count) {
-  frame_count_ = (frame_count == 0) ? 1u : frame_count;
-  const size_t per_frame_size = kMaxSceneUpdatesPerFrame * kAlignedSceneDataSize;
-  const size_t total_size = static_cast<size_t>(frame_count_) * per_frame_size;
-
-  bool result = frame_cb_.Create(device, total_size, Buffer::Type::Constant, D3D12_HEAP_TYPE_UPLOAD);
-
-  if (!result) {
-    std::cerr << "[SceneRenderer] Failed to create frame constant buffer." << '\n';
+bool SceneRenderer::Initialize(UploadRing* upload_ring) {
+  if (upload_ring == nullptr) {
+    std::cerr << "[SceneRenderer] Upload ring is null." << '\n';
     return false;
   }
-  frame_cb_.SetDebugName("Scene_FrameCB");
+  upload_ring_ = upload_ring;
   return true;
 }
 
-void SceneRenderer::BeginFrame(uint32_t frame_index) {
-  current_frame_index_ = (frame_count_ == 0) ? 0u : (frame_index % frame_count_);
-
-  const size_t per_frame_size = kMaxSceneUpdatesPerFrame * kAlignedSceneDataSize;
-  current_frame_base_offset_ = static_cast<size_t>(current_frame_index_) * per_frame_size;
-  current_cb_offset_ = current_frame_base_offset_;
+void SceneRenderer::BeginFrame() {
   current_scene_data_gpu_address_ = 0;
 }
 
@@ -42,6 +33,7 @@ void SceneRenderer::Submit(const RenderPacket& packet) {
 
 void SceneRenderer::Flush(ID3D12GraphicsCommandList* command_list, TextureManager& texture_manager, const RenderFilter& filter) {
   assert(command_list != nullptr);
+  PROFILE_SCOPE("SceneRenderer::Flush");
 
   if (packets_.empty()) {
     return;
@@ -67,27 +59,24 @@ void SceneRenderer::Flush(ID3D12GraphicsCommandList* command_list, TextureManage
   }
 
   // Sort filtered packets using custom comparator that incorporates sort_order for UI layer
+  // Layer first, UI by sort_order (lower values first), then sort_key (template, texture, etc.)
   std::sort(filtered_packets.begin(), filtered_packets.end(), [](const RenderPacket& a, const RenderPacket& b) {
-    // First by layer
-    if (a.layer != b.layer) {
-      return static_cast<int>(a.layer) < static_cast<int>(b.layer);
-    }
-
-    // For UI layer, sort by sort_order (lower values first)
-    if (a.layer == RenderLayer::UI) {
-      if (a.sort_order != b.sort_order) {
-        return a.sort_order < b.sort_order;
-      }
-    }
-
-    // Then by sort_key (which includes material, texture, etc.)
-    return a.sort_key < b.sort_key;
+    return RenderDrawOrderLess(static_cast<uint8_t>(a.layer),
+      a.sort_order,
+      a.sort_key,
+      static_cast<uint8_t>(b.layer),
+      b.sort_order,
+      b.sort_key,
+      static_cast<uint8_t>(RenderLayer::UI));
   });
 
   // Track state changes
   MaterialTemplate* current_template = nullptr;
+  ID3D12RootSignature* current_root_signature = nullptr;
   size_t draw_calls = 0;
   size_t pso_switches = 0;
+  size_t table_binds = 0;
+  size_t triangles = 0;
 
   // Execute render packets
   for (const auto& packet : filtered_packets) {
@@ -96,32 +85,68 @@ void SceneRenderer::Flush(ID3D12GraphicsCommandList* command_list, TextureManage
     if (packet_template != current_template) {
       current_template = packet_template;
 
-      // Set PSO and root signature
       command_list->SetPipelineState(current_template->GetPSO());
-      command_list->SetGraphicsRootSignature(current_template->GetRootSignature());
-
-      // Bind frame constant buffer (b1)
-      RenderHelpers::SetFrameConstants(command_list, current_scene_data_gpu_address_);
       ++pso_switches;
+
+      // Templates sharing a root signature keep its bindings, so only rebind on an actual change
+      if (current_template->GetRootSignature() != current_root_signature) {
+        current_root_signature = current_template->GetRootSignature();
+        command_list->SetGraphicsRootSignature(current_root_signature);
+
+        // Bind frame constant buffer (b1)
+        RenderHelpers::SetFrameConstants(command_list, current_scene_data_gpu_address_);
+
+        // Bindless: the whole texture table once per root signature instead of one table per texture per draw
+        if (current_template->IsBindless()) {
+          command_list->SetGraphicsRootDescriptorTable(
+            current_template->GetBindlessTableRootIndex(), texture_manager.GetBindlessTableStart());
+          ++table_binds;
+        }
+      }
     }
 
-    // Bind material (PSO, root signature, textures)
+    // Bind material (textures)
     packet.material->Bind(command_list, texture_manager);
 
     // Bind mesh (vertex/index buffers, topology)
     packet.mesh->Bind(command_list);
 
-    // Set per-object constants (b0), color (b2), and UV transform (b3)
-    RenderHelpers::SetPerObjectConstants(command_list, packet.world, packet.color, packet.uv_transform);
+    // Set per-object constants (b0), color (b2), and UV transform (b3); quantized positions are
+    // dequantized by the template's constants when it takes them, otherwise by the world matrix
+    if (packet.mesh->HasPositionDequantization() && current_template->TakesPositionDequantization()) {
+      const DirectX::XMFLOAT3& offset = packet.mesh->GetPositionOffset();
+      const DirectX::XMFLOAT3& scale = packet.mesh->GetPositionScale();
+      const float dequantization[8] = {offset.x, offset.y, offset.z, 0.0f, scale.x, scale.y, scale.z, 0.0f};
+      command_list->SetGraphicsRoot32BitConstants(current_template->GetPositionDequantizationRootIndex(), 8, dequantization, 0);
+      RenderHelpers::SetPerObjectConstants(command_list, packet.world, packet.color, packet.uv_transform);
+    } else if (packet.mesh->HasPositionDequantization()) {
+      DirectX::XMFLOAT4X4 world;
+      DirectX::XMStoreFloat4x4(&world,
+        DirectX::XMMatrixMultiply(packet.mesh->GetPositionDequantizationMatrix(), DirectX::XMLoadFloat4x4(&packet.world)));
+      RenderHelpers::SetPerObjectConstants(command_list, world, packet.color, packet.uv_transform);
+    } else {
+      RenderHelpers::SetPerObjectConstants(command_list, packet.world, packet.color, packet.uv_transform);
+    }
 
     // Draw
-    packet.mesh->Draw(command_list);
-    ++draw_calls;
+    if (packet.sections != nullptr) {
+      packet.mesh->Draw(command_list, packet.sections, packet.section_count);
+      draw_calls += packet.section_count;
+      for (uint32_t i = 0; i < packet.section_count; ++i) {
+        triangles += packet.sections[i].index_count / 3;
+      }
+    } else {
+      packet.mesh->Draw(command_list);
+      draw_calls += packet.mesh->GetDrawCount();
+      triangles += packet.mesh->GetIndexCount() / 3;
+    }
   }
 
   // Update statistics
   draw_call_count_ += draw_calls;
   pso_switch_count_ += pso_switches;
+  descriptor_table_bind_count_ += table_binds;
+  triangle_count_ += triangles;
 }
 
 void SceneRenderer::Clear() {
@@ -139,62 +164,41 @@ void SceneRenderer::SortPackets() {
 }
 
 bool SceneRenderer::SetSceneData(const SceneData& scene_data) {
-  if (!frame_cb_.IsValid()) {
+  if (upload_ring_ == nullptr) {
     return false;
   }
 
-  const size_t per_frame_size = kMaxSceneUpdatesPerFrame * kAlignedSceneDataSize;
-  const size_t frame_end = current_frame_base_offset_ + per_frame_size;
-  if (current_cb_offset_ + kAlignedSceneDataSize > frame_end) {
-    std::cerr << "[SceneRenderer] Error: Exceeded max SetSceneData calls per frame (kMaxSceneUpdatesPerFrame)" << '\n';
+  const UploadRing::Allocation allocation = upload_ring_->Push(&scene_data, sizeof(SceneData));
+  if (!allocation.IsValid()) {
+    std::cerr << "[SceneRenderer] Error: Failed to allocate scene constants" << '\n';
     return false;
   }
 
-  frame_cb_.Upload(&scene_data, sizeof(SceneData), current_cb_offset_);
-
-  current_scene_data_gpu_address_ = frame_cb_.GetGPUAddress() + current_cb_offset_;
-  current_cb_offset_ += kAlignedSceneDataSize;
-
+  current_scene_data_gpu_address_ = allocation.gpu;
   return true;
 }
 
 uint64_t SceneRenderer::GenerateSortKey(const RenderPacket& packet) const {
-  // Sort key layout (64 bits):
-  // [8 bits: Layer] [24 bits: Template/PSO ptr low bits] [24 bits: Texture index] [8 bits: Material ptr low bits]
-
-  uint64_t key = 0;
-
-  // Layer (highest priority to keep passes grouped; each pass typically filters by layer)
-  uint64_t layer_bits = static_cast<uint64_t>(static_cast<uint8_t>(packet.layer)) & 0xFF;
-  key |= (layer_bits << 56);
-
-  // PSO/Template (next priority - minimize PSO switches)
-  MaterialTemplate* template_ptr = packet.material->GetTemplate();
-  uint64_t template_hash = reinterpret_cast<uint64_t>(template_ptr);
-  key |= ((template_hash & 0xFFFFFF) << 32);
+  // Layout is defined in render_sort_key.h: layer keeps passes grouped, template minimizes PSO switches,
+  // texture batches identical textures, LOD groups identical meshes, material pointer last.
+  return ComposeRenderSortKey(static_cast<uint8_t>(packet.layer),
+    reinterpret_cast<uint64_t>(packet.material->GetTemplate()),
+    GetSortTextureIndex(packet.material),
+    packet.lod_level,
+    reinterpret_cast<uint64_t>(packet.material));
+}
 
-  // Texture index (next priority - batch identical textures together)
-  uint32_t texture_index = 0xFFFFFF;  // invalid default
+uint32_t SceneRenderer::GetSortTextureIndex(const MaterialInstance* material) {
+  uint32_t texture_index = kSortKeyInvalidTexture;
+  MaterialTemplate* template_ptr = material->GetTemplate();
   if (template_ptr != nullptr) {
-    // Prefer an "albedo" slot if present, otherwise use the first slot
-    const TextureSlotDefinition* slot_def = template_ptr->GetTextureSlot("albedo");
-    if (slot_def == nullptr) {
-      slot_def = template_ptr->GetTextureSlotByIndex(0);
-    }
-    if (slot_def != nullptr) {
-      TextureHandle handle = packet.material->GetTexture(slot_def->name);
-      if (handle.IsValid()) {
-        texture_index = handle.index & 0xFFFFFF;
-      }
+    // "albedo" slot if present, otherwise the first slot (resolved once by the template)
+    TextureHandle handle = material->GetTextureBySlotIndex(template_ptr->GetSortTextureSlotIndex());
+    if (handle.IsValid()) {
+      texture_index = handle.index & kSortKeyInvalidTexture;
     }
   }
-  key |= (static_cast<uint64_t>(texture_index & 0xFFFFFF) << 8);
-
-  // Material pointer (final priority)
-  uint64_t material_hash = reinterpret_cast<uint64_t>(packet.material);
-  key |= (material_hash & 0xFF);
-
-  return key;
+  return texture_index;
 }
 
 void SceneRenderer::PrintStats() const {
@@ -202,6 +206,8 @@ void SceneRenderer::PrintStats() const {
   std::cout << "Packets Submitted: " << packets_.size() << '\n';
   std::cout << "Draw Calls: " << draw_call_count_ << '\n';
   std::cout << "PSO Switches: " << pso_switch_count_ << '\n';
+  std::cout << "Bindless Table Binds: " << descriptor_table_bind_count_ << '\n';
+  std::cout << "Triangles: " << triangle_count_ << '\n';
 
   if (draw_call_count_ > 0) {
     float batching_efficiency = 1.0f - (static_cast<float>(pso_switch_count_) / static_cast<float>(draw_call_count_));
@@ -7,10 +7,10 @@
 #include <vector>
 
 #include "RenderPass/render_layer.h"
-#include "buffer.h"
 #include "material_instance.h"
 #include "mesh.h"
 #include "texture_manager.h"
+#include "upload_ring.h"
 
 using namespace DirectX;
 
@@ -39,6 +39,13 @@ struct RenderPacket {
   RenderLayer layer = RenderLayer::Opaque;
   RenderTag tag = RenderTag::None;
 
+  uint8_t lod_level = 0;  // Selected MeshLOD level (0 when the object has no LOD set)
+
+  // Index ranges to draw instead of the whole mesh (visible meshlets); owned by whoever built the packet
+  // and valid until it is rendered
+  const Mesh::Section* sections = nullptr;
+  uint32_t section_count = 0;
+
   bool IsValid() const {
     return mesh != nullptr && material != nullptr && mesh->IsValid() && material->IsValid();
   }
@@ -83,9 +90,10 @@ class SceneRenderer {
   SceneRenderer(const SceneRenderer&) = delete;
   SceneRenderer& operator=(const SceneRenderer&) = delete;
 
-  bool Initialize(ID3D12Device* device, uint32_t frame_count);
+  // Scene constants are written into the engine-wide per-frame upload ring
+  bool Initialize(UploadRing* upload_ring);
 
-  void BeginFrame(uint32_t frame_index);
+  void BeginFrame();
 
   // Submit a render packet
   void Submit(const RenderPacket& packet);
@@ -96,18 +104,13 @@ class SceneRenderer {
   // Clear all packets (call after flush or at frame start)
   void Clear();
 
-  // Set FrameCB, Scene Data
+  // Set FrameCB, Scene Data (any number of times per frame; each call gets its own CB)
   bool SetSceneData(const SceneData& scene_data);
 
   D3D12_GPU_VIRTUAL_ADDRESS GetCurrentSceneCBVAddress() const {
     return current_scene_data_gpu_address_;
   }
 
-  // Get frame constant buffer for debug rendering
-  const Buffer& GetFrameConstantBuffer() const {
-    return frame_cb_;
-  }
-
   // Statistics
   size_t GetPacketCount() const {
     return packets_.size();
@@ -121,32 +124,40 @@ class SceneRenderer {
     return pso_switch_count_;
   }
 
+  size_t GetTriangleCount() const {
+    return triangle_count_;
+  }
+
+  // Bindless texture table binds (once per root signature per flush)
+  size_t GetDescriptorTableBindCount() const {
+    return descriptor_table_bind_count_;
+  }
+
   void ResetStats() {
     draw_call_count_ = 0;
     pso_switch_count_ = 0;
+    descriptor_table_bind_count_ = 0;
+    triangle_count_ = 0;
   }
 
   void PrintStats() const;
 
- private:
-  static constexpr uint32_t kMaxSceneUpdatesPerFrame = 64;
-  static constexpr size_t kAlignedSceneDataSize = (sizeof(SceneData) + 255u) & ~255u;
+  // Texture index used for batching in the sort key ("albedo" slot, else the first slot)
+  static uint32_t GetSortTextureIndex(const MaterialInstance* material);
 
+ private:
   std::vector<RenderPacket> packets_;
 
   // Statistics
   size_t draw_call_count_ = 0;
   size_t pso_switch_count_ = 0;
+  size_t descriptor_table_bind_count_ = 0;
+  size_t triangle_count_ = 0;
 
   // Sorting
   void SortPackets();
   uint64_t GenerateSortKey(const RenderPacket& packet) const;
 
-  Buffer frame_cb_;
-
-  uint32_t frame_count_ = 1;
-  uint32_t current_frame_index_ = 0;
-  size_t current_frame_base_offset_ = 0;
-  size_t current_cb_offset_ = 0;
+  UploadRing* upload_ring_ = nullptr;
   D3D12_GPU_VIRTUAL_ADDRESS current_scene_data_gpu_address_ = 0;
 };
@@ -5,34 +5,33 @@
 #include <cstring>
 #include <iostream>
 
-#include "../utils.h"
-#include "upload_context.h"
+#include "copy_queue.h"
+#include "profiler.h"
 
 Buffer::~Buffer() {
   Cleanup();
 }
 
-std::shared_ptr<Buffer> Buffer::CreateAndUploadToDefaultHeapForInit(
+std::shared_ptr<Buffer> Buffer::CreateAndUpload(
   ID3D12Device* device,
-  UploadContext& upload_context,
+  UploadBatch& batch,
   const void* data,
   size_t size_in_bytes,
   Type type,
-  const std::string& debug_name) {
+  const std::string& debug_name,
+  GpuMemoryAllocator* memory_allocator) {
+  PROFILE_SCOPE("Buffer::CreateAndUpload");
+
   if (device == nullptr) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - device is null" << '\n';
-    return nullptr;
-  }
-  if (!upload_context.IsInitialized()) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - upload_context is not initialized" << '\n';
+    std::cerr << "Buffer::CreateAndUpload - device is null" << '\n';
     return nullptr;
   }
   if (data == nullptr || size_in_bytes == 0) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - invalid data/size" << '\n';
+    std::cerr << "Buffer::CreateAndUpload - invalid data/size" << '\n';
     return nullptr;
   }
   if (type != Type::Vertex && type != Type::Index) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - only Vertex/Index are supported in init-only helper" << '\n';
+    std::cerr << "Buffer::CreateAndUpload - only Vertex/Index are supported" << '\n';
     return nullptr;
   }
 
@@ -60,80 +59,53 @@ std::shared_ptr<Buffer> Buffer::CreateAndUploadToDefaultHeapForInit(
   buffer_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
   ComPtr<ID3D12Resource> default_resource;
-  HRESULT hr = device->CreateCommittedResource(
-    &default_heap_props,
-    D3D12_HEAP_FLAG_NONE,
-    &buffer_desc,
-    D3D12_RESOURCE_STATE_COPY_DEST,
-    nullptr,
-    IID_PPV_ARGS(default_resource.GetAddressOf()));
+  HRESULT hr = S_OK;
+  if (memory_allocator != nullptr) {
+    if (!memory_allocator->CreateResource(
+          D3D12_HEAP_TYPE_DEFAULT, buffer_desc, D3D12_RESOURCE_STATE_COPY_DEST, default_resource, result->memory_allocation_)) {
+      hr = E_FAIL;
+    }
+    result->memory_allocator_ = memory_allocator;
+  } else {
+    hr = device->CreateCommittedResource(&default_heap_props,
+      D3D12_HEAP_FLAG_NONE,
+      &buffer_desc,
+      D3D12_RESOURCE_STATE_COPY_DEST,
+      nullptr,
+      IID_PPV_ARGS(default_resource.GetAddressOf()));
+  }
 
   if (FAILED(hr) || default_resource == nullptr) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - Failed to create DEFAULT buffer resource (hr=0x" << std::hex << hr << std::dec << ")"
+    std::cerr << "Buffer::CreateAndUpload - Failed to create DEFAULT buffer resource (hr=0x" << std::hex << hr << std::dec << ")"
               << '\n';
     return nullptr;
   }
 
   result->SetResource(default_resource, D3D12_RESOURCE_STATE_COPY_DEST);
 
-  if (!debug_name.empty()) {
-    result->SetDebugName(debug_name);
-  }
-
-  // Create staging UPLOAD heap buffer
-  D3D12_HEAP_PROPERTIES upload_heap_props = {};
-  upload_heap_props.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-  ComPtr<ID3D12Resource> staging_resource;
-  hr = device->CreateCommittedResource(
-    &upload_heap_props,
-    D3D12_HEAP_FLAG_NONE,
-    &buffer_desc,
-    D3D12_RESOURCE_STATE_GENERIC_READ,
-    nullptr,
-    IID_PPV_ARGS(staging_resource.GetAddressOf()));
-
-  if (FAILED(hr) || staging_resource == nullptr) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - Failed to create staging UPLOAD buffer (hr=0x" << std::hex << hr << std::dec << ")"
-              << '\n';
-    return nullptr;
-  }
+  // The batch owns the buffer until the copy completes, whatever the caller does with it meanwhile
+  batch.Track(result);
 
   if (!debug_name.empty()) {
-    staging_resource->SetName(utils::Utf8ToWstring(debug_name + "_Staging").c_str());
+    result->SetDebugName(debug_name);
   }
 
-  // Copy CPU -> staging
-  void* mapped = nullptr;
-  hr = staging_resource->Map(0, nullptr, &mapped);
-  if (FAILED(hr) || mapped == nullptr) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - Failed to map staging buffer (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
-    return nullptr;
-  }
-  std::memcpy(mapped, data, size_in_bytes);
-  staging_resource->Unmap(0, nullptr);
-
-  // Atomic blocking submission: Begin -> Record -> SubmitAndWait
-  upload_context.Begin();
-  ID3D12GraphicsCommandList* cmd = upload_context.GetCommandList();
-  if (cmd == nullptr) {
-    std::cerr << "Buffer::CreateAndUploadToDefaultHeapForInit - upload_context returned null command list" << '\n';
+  // Copy CPU -> staging ring, staging -> DEFAULT on the copy queue
+  const UploadBatch::Staging staging = batch.AllocateStaging(size_in_bytes, 4);
+  if (!staging.IsValid()) {
+    std::cerr << "Buffer::CreateAndUpload - Failed to allocate staging memory" << '\n';
     return nullptr;
   }
+  std::memcpy(staging.cpu, data, size_in_bytes);
 
-  cmd->CopyBufferRegion(default_resource.Get(), 0, staging_resource.Get(), 0, size_in_bytes);
+  batch.GetCommandList()->CopyBufferRegion(default_resource.Get(), 0, staging.resource, staging.offset, size_in_bytes);
 
-  const D3D12_RESOURCE_STATES final_state =
-    (type == Type::Vertex) ? D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER : D3D12_RESOURCE_STATE_INDEX_BUFFER;
-  result->TransitionTo(cmd, final_state);
-
-  // INITIALIZATION ONLY: blocking wait makes staging lifetime safe to release on return.
-  upload_context.SubmitAndWait();
+  // No transition on the copy queue: the buffer decays to COMMON and is promoted to VB / IB on first use
 
   return result;
 }
 
-bool Buffer::Create(ID3D12Device* device, size_t size, Type type, D3D12_HEAP_TYPE heap_type) {
+bool Buffer::Create(ID3D12Device* device, size_t size, Type type, D3D12_HEAP_TYPE heap_type, GpuMemoryAllocator* memory_allocator) {
   assert(device != nullptr);
   assert(size > 0);
 
@@ -148,6 +120,19 @@ bool Buffer::Create(ID3D12Device* device, size_t size, Type type, D3D12_HEAP_TYP
     size_ = (size + 255) & ~255;
   }
 
+  // Small upload buffers share one mapped buffer (persistently mapped already, never transitioned)
+  if (memory_allocator != nullptr && heap_type == D3D12_HEAP_TYPE_UPLOAD && size_ <= SMALL_BUFFER_THRESHOLD) {
+    GpuMemoryAllocator::SubBuffer sub_buffer;
+    if (memory_allocator->AllocateSmallUploadBuffer(size_, 1, sub_buffer, memory_allocation_)) {
+      memory_allocator_ = memory_allocator;
+      resource_ = sub_buffer.resource;
+      offset_ = sub_buffer.offset;
+      mapped_data_ = sub_buffer.cpu;
+      ResetState(D3D12_RESOURCE_STATE_GENERIC_READ);
+      return true;
+    }
+  }
+
   D3D12_HEAP_PROPERTIES heap_props = {};
   heap_props.Type = heap_type;
 
@@ -176,14 +161,22 @@ bool Buffer::Create(ID3D12Device* device, size_t size, Type type, D3D12_HEAP_TYP
     initial_state = D3D12_RESOURCE_STATE_COMMON;
   }
 
-  HRESULT hr = device->CreateCommittedResource(&heap_props, D3D12_HEAP_FLAG_NONE, &buffer_desc, initial_state, nullptr, IID_PPV_ARGS(&resource_));
+  HRESULT hr = S_OK;
+  if (memory_allocator != nullptr) {
+    memory_allocator_ = memory_allocator;
+    if (!memory_allocator->CreateResource(heap_type, buffer_desc, initial_state, resource_, memory_allocation_)) {
+      hr = E_FAIL;
+    }
+  } else {
+    hr = device->CreateCommittedResource(&heap_props, D3D12_HEAP_FLAG_NONE, &buffer_desc, initial_state, nullptr, IID_PPV_ARGS(&resource_));
+  }
 
   if (FAILED(hr)) {
     std::cerr << "Buffer::Create - Failed to create buffer resource" << '\n';
     return false;
   }
 
-  current_state_ = initial_state;
+  ResetState(initial_state);
 
   // Map persistent upload buffers
   if (heap_type == D3D12_HEAP_TYPE_UPLOAD) {
@@ -222,7 +215,7 @@ D3D12_VERTEX_BUFFER_VIEW Buffer::GetVBV(uint32_t stride) const {
   assert(resource_ != nullptr);
 
   D3D12_VERTEX_BUFFER_VIEW vbv = {};
-  vbv.BufferLocation = resource_->GetGPUVirtualAddress();
+  vbv.BufferLocation = resource_->GetGPUVirtualAddress() + offset_;
   vbv.SizeInBytes = static_cast<UINT>(size_);
   vbv.StrideInBytes = stride;
 
@@ -234,7 +227,7 @@ D3D12_INDEX_BUFFER_VIEW Buffer::GetIBV(DXGI_FORMAT format) const {
   assert(resource_ != nullptr);
 
   D3D12_INDEX_BUFFER_VIEW ibv = {};
-  ibv.BufferLocation = resource_->GetGPUVirtualAddress();
+  ibv.BufferLocation = resource_->GetGPUVirtualAddress() + offset_;
   ibv.SizeInBytes = static_cast<UINT>(size_);
   ibv.Format = format;
 
@@ -243,18 +236,28 @@ D3D12_INDEX_BUFFER_VIEW Buffer::GetIBV(DXGI_FORMAT format) const {
 
 D3D12_GPU_VIRTUAL_ADDRESS Buffer::GetGPUAddress() const {
   if (resource_ != nullptr) {
-    return resource_->GetGPUVirtualAddress();
+    return resource_->GetGPUVirtualAddress() + offset_;
   }
   return 0;
 }
 
 void Buffer::Cleanup() {
-  if (mapped_data_ != nullptr && resource_ != nullptr) {
+  // Releasing counts as a use: deferred frees are keyed to the direct queue, which must wait for the copy
+  ResolvePendingUpload();
+
+  // Sub-allocated buffers point into a page mapped by the allocator
+  if (mapped_data_ != nullptr && resource_ != nullptr && !IsSubAllocated()) {
     resource_->Unmap(0, nullptr);
-    mapped_data_ = nullptr;
   }
+  mapped_data_ = nullptr;
 
   resource_.Reset();
+  if (memory_allocator_ != nullptr) {
+    memory_allocator_->Free(memory_allocation_);
+  }
+  memory_allocator_ = nullptr;
+  memory_allocation_ = {};
+  offset_ = 0;
   size_ = 0;
-  current_state_ = D3D12_RESOURCE_STATE_COMMON;
+  ResetState(D3D12_RESOURCE_STATE_COMMON);
 }
\ No newline at end of file
@@ -6,9 +6,10 @@
 #include <memory>
 #include <string>
 
+#include "gpu_memory_allocator.h"
 #include "gpu_resource.h"
 
-class UploadContext;
+class UploadBatch;
 
 class Buffer : public GpuResource {
  public:
@@ -20,17 +21,24 @@ class Buffer : public GpuResource {
   Buffer(const Buffer&) = delete;
   Buffer& operator=(const Buffer&) = delete;
 
-  bool Create(ID3D12Device* device, size_t size, Type type, D3D12_HEAP_TYPE heap_type = D3D12_HEAP_TYPE_UPLOAD);
+  // With a memory allocator the buffer is placed in a shared heap; small upload buffers become a range
+  // inside a shared mapped buffer (views and GetGPUAddress include the offset)
+  bool Create(ID3D12Device* device,
+    size_t size,
+    Type type,
+    D3D12_HEAP_TYPE heap_type = D3D12_HEAP_TYPE_UPLOAD,
+    GpuMemoryAllocator* memory_allocator = nullptr);
 
-  // BLOCKING helper. Handles staging lifetime internally.
-  // INITIALIZATION ONLY: calls SubmitAndWait(); do not use for runtime/streaming.
-  static std::shared_ptr<Buffer> CreateAndUploadToDefaultHeapForInit(
+  // DEFAULT heap buffer filled by a copy queue batch (no CPU wait). The direct queue waits for the
+  // batch the first time the buffer is bound (Mesh::Bind resolves the pending upload).
+  static std::shared_ptr<Buffer> CreateAndUpload(
     ID3D12Device* device,
-    UploadContext& upload_context,
+    UploadBatch& batch,
     const void* data,
     size_t size_in_bytes,
     Type type,
-    const std::string& debug_name = "");
+    const std::string& debug_name = "",
+    GpuMemoryAllocator* memory_allocator = nullptr);
 
   void Upload(const void* data, size_t size);
 
@@ -58,5 +66,14 @@ class Buffer : public GpuResource {
   Type type_ = Type::Vertex;
   D3D12_HEAP_TYPE heap_type_ = D3D12_HEAP_TYPE_UPLOAD;
 
+  // Set when the memory came from a GpuMemoryAllocator
+  GpuMemoryAllocator* memory_allocator_ = nullptr;
+  GpuMemoryAllocator::Allocation memory_allocation_ = {};
+  uint64_t offset_ = 0;  // Non-zero only for sub-allocated small buffers
+
+  bool IsSubAllocated() const {
+    return memory_allocation_.IsValid() && memory_allocation_.pool == GpuMemoryAllocator::Pool::SmallUploadBuffers;
+  }
+
   void Cleanup();
 };
@@ -0,0 +1,317 @@
+#include "copy_queue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+#include "gpu_resource.h"
+#include "profiler.h"
+
+ID3D12Device* UploadBatch::GetDevice() const {
+  return owner_->GetDevice();
+}
+
+UploadBatch::Staging UploadBatch::AllocateStaging(uint64_t size, uint64_t alignment) {
+  return owner_->AllocateStaging(*this, size, alignment);
+}
+
+CopyQueue::~CopyQueue() {
+  // Batches still executing reference the staging buffer and pooled allocators
+  if (queue_ != nullptr && fence_ != nullptr) {
+    WaitIdle();
+  }
+}
+
+bool CopyQueue::Initialize(ID3D12Device* device, uint64_t staging_size) {
+  assert(device != nullptr);
+  assert(staging_size > 0);
+
+  device_ = device;
+
+  D3D12_COMMAND_QUEUE_DESC queue_desc = {};
+  queue_desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+  queue_desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+  HRESULT hr = device_->CreateCommandQueue(&queue_desc, IID_PPV_ARGS(&queue_));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create copy queue (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return false;
+  }
+  queue_->SetName(L"CopyQueue");
+
+  hr = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create fence (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return false;
+  }
+
+  D3D12_HEAP_PROPERTIES heap_props = {};
+  heap_props.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+  D3D12_RESOURCE_DESC buffer_desc = {};
+  buffer_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+  buffer_desc.Width = staging_size;
+  buffer_desc.Height = 1;
+  buffer_desc.DepthOrArraySize = 1;
+  buffer_desc.MipLevels = 1;
+  buffer_desc.Format = DXGI_FORMAT_UNKNOWN;
+  buffer_desc.SampleDesc.Count = 1;
+  buffer_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+  hr = device_->CreateCommittedResource(
+    &heap_props, D3D12_HEAP_FLAG_NONE, &buffer_desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&staging_buffer_));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create staging ring (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return false;
+  }
+  staging_buffer_->SetName(L"CopyQueue_StagingRing");
+
+  // Upload heaps stay mapped for their lifetime; the CPU never reads them
+  D3D12_RANGE read_range = {0, 0};
+  void* mapped = nullptr;
+  hr = staging_buffer_->Map(0, &read_range, &mapped);
+  if (FAILED(hr) || mapped == nullptr) {
+    std::cerr << "[CopyQueue] Failed to map staging ring (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return false;
+  }
+  staging_cpu_ = static_cast<uint8_t*>(mapped);
+  staging_ring_.Initialize(staging_size);
+
+  return true;
+}
+
+UploadBatch* CopyQueue::Begin() {
+  assert(queue_ != nullptr);
+
+  std::unique_ptr<UploadBatch> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RetireCompleted();
+    if (!free_batches_.empty()) {
+      batch = std::move(free_batches_.back());
+      free_batches_.pop_back();
+    }
+    if (batch != nullptr) {
+      batch->id_ = next_batch_id_++;
+    }
+  }
+
+  if (batch == nullptr) {
+    batch = CreateBatch();
+    if (batch == nullptr) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch->id_ = next_batch_id_++;
+    ++stats_.command_lists;
+  } else {
+    // Pooled batches only come back once the GPU has finished with their allocator
+    HRESULT hr = batch->command_allocator_->Reset();
+    if (SUCCEEDED(hr)) {
+      hr = batch->command_list_->Reset(batch->command_allocator_.Get(), nullptr);
+    }
+    if (FAILED(hr)) {
+      std::cerr << "[CopyQueue] Failed to reset command list (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+      return nullptr;
+    }
+  }
+
+  return batch.release();
+}
+
+UploadTicket CopyQueue::Submit(UploadBatch* batch) {
+  assert(batch != nullptr && batch->owner_ == this);
+  PROFILE_SCOPE("CopyQueue::Submit");
+
+  HRESULT hr = batch->command_list_->Close();
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to close command list (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Execute + Signal under the lock so fence values follow submission order
+  if (SUCCEEDED(hr)) {
+    ID3D12CommandList* lists[] = {batch->command_list_.Get()};
+    queue_->ExecuteCommandLists(1, lists);
+  }
+  const uint64_t fence_value = ++last_signaled_;
+  queue_->Signal(fence_.Get(), fence_value);
+
+  staging_ring_.Close(batch->id_, fence_value);
+  for (const std::shared_ptr<GpuResource>& resource : batch->resources_) {
+    if (resource->IsValid()) {
+      resource->SetPendingUpload(this, fence_value);
+    }
+  }
+  ++stats_.batches_submitted;
+
+  in_flight_.push_back({std::unique_ptr<UploadBatch>(batch), fence_value});
+  return {fence_value};
+}
+
+void CopyQueue::Wait(UploadTicket ticket) {
+  if (!ticket.IsValid() || IsComplete(ticket)) {
+    return;
+  }
+  PROFILE_SCOPE("CopyQueue::Wait");
+  // A null event blocks until the fence is reached (safe to call from any thread)
+  fence_->SetEventOnCompletion(ticket.fence_value, nullptr);
+}
+
+void CopyQueue::WaitIdle() {
+  uint64_t last = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last = last_signaled_;
+  }
+  Wait({last});
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  RetireCompleted();
+}
+
+void CopyQueue::RequireOnDirectQueue(uint64_t fence_value) {
+  // Finished uploads need no wait; this also keeps destinations released by a retiring batch (on whatever
+  // thread retires it) off the render thread's bookkeeping
+  if (fence_value <= GetCompletedFenceValue()) {
+    return;
+  }
+  required_fence_ = (std::max)(required_fence_, fence_value);
+}
+
+void CopyQueue::InsertPendingWait(ID3D12CommandQueue* direct_queue) {
+  assert(direct_queue != nullptr);
+  if (required_fence_ <= waited_fence_) {
+    return;
+  }
+
+  // Uploads that already finished need no GPU-side dependency
+  const bool complete = required_fence_ <= GetCompletedFenceValue();
+  if (!complete) {
+    direct_queue->Wait(fence_.Get(), required_fence_);
+  }
+  waited_fence_ = required_fence_;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (complete) {
+    ++stats_.waits_skipped;
+  } else {
+    ++stats_.cross_queue_waits;
+  }
+}
+
+UploadBatch::Staging CopyQueue::AllocateStaging(UploadBatch& batch, uint64_t size, uint64_t alignment) {
+  assert(size > 0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.staging_bytes += size;
+
+  uint64_t offset = 0;
+  bool placed = staging_ring_.Allocate(size, alignment, batch.id_, offset);
+  if (!placed) {
+    RetireCompleted();
+    placed = staging_ring_.Allocate(size, alignment, batch.id_, offset);
+  }
+
+  // Ring full: wait for the oldest submitted batch. An oldest batch that is still being recorded (by this or
+  // another thread) cannot be waited for, so the request falls back to a dedicated buffer instead.
+  uint64_t oldest_fence = 0;
+  while (!placed && size < staging_ring_.GetCapacity() && staging_ring_.GetOldestFence(oldest_fence)) {
+    ++stats_.staging_stalls;
+    lock.unlock();
+    Wait({oldest_fence});
+    lock.lock();
+    RetireCompleted();
+    placed = staging_ring_.Allocate(size, alignment, batch.id_, offset);
+  }
+
+  if (placed) {
+    return {staging_cpu_ + offset, staging_buffer_.Get(), offset, size};
+  }
+
+  ++stats_.dedicated_staging;
+  lock.unlock();
+
+  D3D12_HEAP_PROPERTIES heap_props = {};
+  heap_props.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+  D3D12_RESOURCE_DESC buffer_desc = {};
+  buffer_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+  buffer_desc.Width = size;
+  buffer_desc.Height = 1;
+  buffer_desc.DepthOrArraySize = 1;
+  buffer_desc.MipLevels = 1;
+  buffer_desc.Format = DXGI_FORMAT_UNKNOWN;
+  buffer_desc.SampleDesc.Count = 1;
+  buffer_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+  ComPtr<ID3D12Resource> buffer;
+  HRESULT hr = device_->CreateCommittedResource(
+    &heap_props, D3D12_HEAP_FLAG_NONE, &buffer_desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create dedicated staging buffer (" << size << " bytes, hr=0x" << std::hex << hr << std::dec << ")"
+              << '\n';
+    return {};
+  }
+
+  D3D12_RANGE read_range = {0, 0};
+  void* mapped = nullptr;
+  hr = buffer->Map(0, &read_range, &mapped);
+  if (FAILED(hr) || mapped == nullptr) {
+    std::cerr << "[CopyQueue] Failed to map dedicated staging buffer (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return {};
+  }
+
+  // Released with the batch once it completes
+  batch.dedicated_staging_.push_back(buffer);
+  return {mapped, buffer.Get(), 0, size};
+}
+
+std::unique_ptr<UploadBatch> CopyQueue::CreateBatch() {
+  std::unique_ptr<UploadBatch> batch(new UploadBatch());
+  batch->owner_ = this;
+
+  HRESULT hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&batch->command_allocator_));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create command allocator (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return nullptr;
+  }
+
+  // Created open, ready for recording
+  hr = device_->CreateCommandList(
+    0, D3D12_COMMAND_LIST_TYPE_COPY, batch->command_allocator_.Get(), nullptr, IID_PPV_ARGS(&batch->command_list_));
+  if (FAILED(hr)) {
+    std::cerr << "[CopyQueue] Failed to create command list (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return nullptr;
+  }
+  return batch;
+}
+
+void CopyQueue::RetireCompleted() {
+  const uint64_t completed = GetCompletedFenceValue();
+  while (!in_flight_.empty() && in_flight_.front().fence_value <= completed) {
+    std::unique_ptr<UploadBatch> batch = std::move(in_flight_.front().batch);
+    in_flight_.pop_front();
+    batch->dedicated_staging_.clear();
+    // Destinations the caller already dropped are destroyed here, after their copies
+    batch->resources_.clear();
+    free_batches_.push_back(std::move(batch));
+  }
+  staging_ring_.Retire(completed);
+}
+
+CopyQueue::Stats CopyQueue::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void CopyQueue::PrintStats() const {
+  const Stats stats = GetStats();
+
+  std::cout << "\n=== Copy Queue Statistics ===" << '\n';
+  std::cout << "Batches: " << stats.batches_submitted << " (" << stats.command_lists << " command lists)" << '\n';
+  std::cout << "Staged: " << (stats.staging_bytes >> 10) << " KB in a " << (staging_ring_.GetCapacity() >> 20) << " MB ring, "
+            << stats.dedicated_staging << " dedicated, " << stats.staging_stalls << " stalls" << '\n';
+  std::cout << "Direct queue waits: " << stats.cross_queue_waits << " (" << stats.waits_skipped << " skipped, already complete)" << '\n';
+  std::cout << "=============================\n" << '\n';
+}
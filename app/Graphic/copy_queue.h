@@ -0,0 +1,168 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fenced_ring_allocator.h"
+#include "types.h"
+
+class CopyQueue;
+class GpuResource;
+
+constexpr uint64_t DEFAULT_COPY_STAGING_SIZE = 32ull << 20;
+
+// Identifies a submitted upload batch; complete once the copy queue fence reaches fence_value
+struct UploadTicket {
+  uint64_t fence_value = 0;
+
+  bool IsValid() const {
+    return fence_value != 0;
+  }
+};
+
+// UploadBatch: One command list of copies recorded for the copy queue (CopyQueue::Begin .. Submit).
+// Only copy commands are valid; copy queues cannot transition to shader states, so every resource written
+// here must be in COMMON or COPY_DEST and decays to COMMON when the batch completes (reads on the direct
+// queue promote it implicitly).
+class UploadBatch {
+ public:
+  struct Staging {
+    void* cpu = nullptr;
+    ID3D12Resource* resource = nullptr;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+
+    bool IsValid() const {
+      return cpu != nullptr;
+    }
+  };
+
+  UploadBatch(const UploadBatch&) = delete;
+  UploadBatch& operator=(const UploadBatch&) = delete;
+
+  ID3D12GraphicsCommandList* GetCommandList() const {
+    return command_list_.Get();
+  }
+
+  ID3D12Device* GetDevice() const;
+
+  // Upload memory for this batch's copy sources; valid until the batch completes on the GPU
+  Staging AllocateStaging(uint64_t size, uint64_t alignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+  // Resource written by this batch: the batch keeps it alive until its copies complete on the GPU, and the
+  // direct queue waits for the batch the first time it is used. Track before recording copies into it, so
+  // the destination outlives the batch even when the caller drops it on a later failure.
+  void Track(std::shared_ptr<GpuResource> resource) {
+    resources_.push_back(std::move(resource));
+  }
+
+ private:
+  friend class CopyQueue;
+
+  UploadBatch() = default;
+
+  CopyQueue* owner_ = nullptr;
+  uint32_t id_ = 0;
+  ComPtr<ID3D12CommandAllocator> command_allocator_;
+  ComPtr<ID3D12GraphicsCommandList> command_list_;
+  std::vector<ComPtr<ID3D12Resource>> dedicated_staging_;  // Requests the ring could not hold
+  std::vector<std::shared_ptr<GpuResource>> resources_;  // Released when the batch retires
+};
+
+// CopyQueue: Uploads on a dedicated D3D12 copy queue so they overlap with rendering and with each other.
+// Batches record into pooled command lists, copy from a persistently mapped staging ring that is
+// reclaimed by the copy fence, and Submit returns a ticket without waiting. The direct queue only waits
+// for a batch when a resource it wrote is first used (GpuResource::ResolvePendingUpload requests the
+// wait, InsertPendingWait issues it before the frame's ExecuteCommandLists).
+//
+// Begin / AllocateStaging / Submit are thread-safe; a batch is recorded by one thread at a time.
+class CopyQueue {
+ public:
+  struct Stats {
+    uint64_t batches_submitted = 0;
+    uint64_t staging_bytes = 0;
+    uint64_t dedicated_staging = 0;  // Allocations that did not fit the ring
+    uint64_t staging_stalls = 0;     // Ring full: CPU waited for the oldest batch
+    uint64_t cross_queue_waits = 0;  // Direct queue waits issued
+    uint64_t waits_skipped = 0;      // Required uploads already complete at submission
+    uint32_t command_lists = 0;      // Pooled command lists created
+  };
+
+  CopyQueue() = default;
+  ~CopyQueue();
+
+  CopyQueue(const CopyQueue&) = delete;
+  CopyQueue& operator=(const CopyQueue&) = delete;
+
+  bool Initialize(ID3D12Device* device, uint64_t staging_size = DEFAULT_COPY_STAGING_SIZE);
+
+  // Open a batch for recording; every batch must be submitted
+  UploadBatch* Begin();
+
+  // Close and execute the batch; the batch object returns to the pool
+  UploadTicket Submit(UploadBatch* batch);
+
+  bool IsComplete(UploadTicket ticket) const {
+    return ticket.fence_value <= GetCompletedFenceValue();
+  }
+
+  // Block the CPU until the batch completes (tools / shutdown; rendering never needs this)
+  void Wait(UploadTicket ticket);
+  void WaitIdle();
+
+  uint64_t GetCompletedFenceValue() const {
+    return (fence_ != nullptr) ? fence_->GetCompletedValue() : 0;
+  }
+
+  // The next direct queue submission must not start before fence_value (no-op once it has completed)
+  void RequireOnDirectQueue(uint64_t fence_value);
+
+  // Make direct_queue wait for every upload required since the last call (before ExecuteCommandLists)
+  void InsertPendingWait(ID3D12CommandQueue* direct_queue);
+
+  ID3D12Device* GetDevice() const {
+    return device_;
+  }
+
+  Stats GetStats() const;
+  void PrintStats() const;
+
+ private:
+  friend class UploadBatch;
+
+  struct InFlight {
+    std::unique_ptr<UploadBatch> batch;
+    uint64_t fence_value = 0;
+  };
+
+  ID3D12Device* device_ = nullptr;
+  ComPtr<ID3D12CommandQueue> queue_;
+  ComPtr<ID3D12Fence> fence_;
+
+  // Staging ring (persistently mapped upload buffer)
+  ComPtr<ID3D12Resource> staging_buffer_;
+  uint8_t* staging_cpu_ = nullptr;
+
+  mutable std::mutex mutex_;
+  FencedRingAllocator staging_ring_;
+  std::vector<std::unique_ptr<UploadBatch>> free_batches_;
+  std::deque<InFlight> in_flight_;  // Submission order
+  uint64_t last_signaled_ = 0;
+  uint32_t next_batch_id_ = 0;
+  Stats stats_;
+
+  // Direct queue wait bookkeeping (render thread)
+  uint64_t required_fence_ = 0;
+  uint64_t waited_fence_ = 0;
+
+  UploadBatch::Staging AllocateStaging(UploadBatch& batch, uint64_t size, uint64_t alignment);
+  std::unique_ptr<UploadBatch> CreateBatch();
+
+  // Return completed batches to the pool and reclaim their staging memory (mutex_ held)
+  void RetireCompleted();
+};
@@ -36,12 +36,6 @@ void DebugVisualRenderer::Initialize(Graphic& graphic) {
     debug_line_template_depth_ = debug_line_material_depth_->GetTemplate();
   }
 
-  // Create per-frame upload buffers
-  if (!CreateFrameBuffers()) {
-    std::cerr << "[DebugVisualRenderer] Failed to create frame buffers" << '\n';
-    return;
-  }
-
   is_initialized_ = true;
   std::cout << "[DebugVisualRenderer] Initialized successfully" << '\n';
 }
@@ -51,8 +45,6 @@ void DebugVisualRenderer::Shutdown() {
     return;
   }
 
-  ReleaseFrameBuffers();
-
   debug_line_template_overlay_ = nullptr;
   debug_line_material_overlay_ = nullptr;
   debug_line_template_depth_ = nullptr;
@@ -63,89 +55,63 @@ void DebugVisualRenderer::Shutdown() {
   std::cout << "[DebugVisualRenderer] Shutdown complete" << '\n';
 }
 
-void DebugVisualRenderer::BeginFrame(uint32_t frameIndex) {
-  if (!is_initialized_) {
+void DebugVisualRenderer::BeginFrame() {
+  last_frame_vertex_count_ = 0;
+}
+
+void DebugVisualRenderer::RenderDepthTested(
+  const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings) {
+  if (!is_initialized_ || !debug_line_material_depth_ || !debug_line_template_depth_) {
     return;
   }
+  RenderLines(cmds, graphic, sceneData, settings, DebugDepthMode::TestDepth, debug_line_template_depth_);
+}
 
-  current_frame_index_ = (frame_count_ == 0) ? 0u : (frameIndex % frame_count_);
-  if (current_frame_index_ < frames_.size()) {
-    if (frames_[current_frame_index_]) {
-      frames_[current_frame_index_]->Reset();
-    }
+void DebugVisualRenderer::RenderOverlay(
+  const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings) {
+  if (!is_initialized_ || !debug_line_material_overlay_ || !debug_line_template_overlay_) {
+    return;
   }
+  RenderLines(cmds, graphic, sceneData, settings, DebugDepthMode::IgnoreDepth, debug_line_template_overlay_);
 }
 
-void DebugVisualRenderer::RenderDepthTested(const DebugVisualCommandBuffer& cmds,
+void DebugVisualRenderer::Render(
+  const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings) {
+  RenderDepthTested(cmds, graphic, sceneData, settings);
+  RenderOverlay(cmds, graphic, sceneData, settings);
+}
+
+void DebugVisualRenderer::RenderLines(const DebugVisualCommandBuffer& cmds,
   Graphic& graphic,
   const SceneGlobalData& sceneData,
-  const Buffer& frame_cb,
-  const DebugVisualSettings& settings) {
+  const DebugVisualSettings& settings,
+  DebugDepthMode depthMode,
+  MaterialTemplate* line_template) {
   ID3D12GraphicsCommandList* cmd_list = graphic.GetCommandList();
-  if (!is_initialized_ || !cmd_list || !debug_line_material_depth_ || !debug_line_template_depth_) {
+  if (!cmd_list) {
     return;
   }
 
-  // Bind main render targets and viewport/scissor for debug drawing.
-  {
-    auto rtv = graphic.GetMainRTV();
-    auto dsv = graphic.GetMainDSV();
-    cmd_list->OMSetRenderTargets(1, &rtv, FALSE, &dsv);
-
-    auto viewport = graphic.GetScreenViewport();
-    auto scissor = graphic.GetScissorRect();
-    cmd_list->RSSetViewports(1, &viewport);
-    cmd_list->RSSetScissorRects(1, &scissor);
-  }
-
-  auto& frame = *frames_[current_frame_index_];
-
-  // Fill depth-tested vertices first
-  frame.vertex_count = FillVertexData(cmds, frame.mapped_ptr, MAX_DEBUG_VERTICES, DebugDepthMode::TestDepth, settings);
-  last_frame_vertex_count_ = frame.vertex_count;
-
-  if (frame.vertex_count == 0) {
+  const UINT vertex_count = CountVertices(cmds, depthMode, settings);
+  if (vertex_count == 0) {
     return;
   }
 
   if (sceneData.scene_cb_gpu_address == 0) {
-    std::cerr << "[DebugVisualRenderer] Skipping depth-tested debug lines because Scene CB address is invalid" << '\n';
+    std::cerr << "[DebugVisualRenderer] Skipping debug lines because Scene CB address is invalid" << '\n';
     return;
   }
 
-  const D3D12_GPU_VIRTUAL_ADDRESS cb_address = sceneData.scene_cb_gpu_address ? sceneData.scene_cb_gpu_address : frame_cb.GetGPUAddress();
-  if (cb_address == 0) {
-    return;
-  }
-  if (cb_address == 0) {
+  const UINT buffer_size = vertex_count * sizeof(DebugVertex);
+  const UploadRing::Allocation vertices = graphic.GetUploadRing().Allocate(buffer_size, alignof(DebugVertex));
+  if (!vertices.IsValid()) {
+    std::cerr << "[DebugVisualRenderer] Failed to allocate " << vertex_count << " debug vertices" << '\n';
     return;
   }
 
-  DirectX::XMFLOAT4X4 identity_world;
-  DirectX::XMStoreFloat4x4(&identity_world, DirectX::XMMatrixIdentity());
-
-  D3D12_VERTEX_BUFFER_VIEW vbv = frame.vertex_buffer.GetVBV(sizeof(DebugVertex));
-
-  cmd_list->SetPipelineState(debug_line_template_depth_->GetPSO());
-  cmd_list->SetGraphicsRootSignature(debug_line_template_depth_->GetRootSignature());
-  cmd_list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-  cmd_list->IASetVertexBuffers(0, 1, &vbv);
-
-  cmd_list->SetGraphicsRoot32BitConstants(0, 16, &identity_world, 0);  // b0 - world matrix
-  cmd_list->SetGraphicsRootConstantBufferView(1, cb_address);          // b1 - FrameCB
-
-  cmd_list->DrawInstanced(frame.vertex_count, 1, 0, 0);
-}
-
-void DebugVisualRenderer::RenderOverlay(const DebugVisualCommandBuffer& cmds,
-  Graphic& graphic,
-  const SceneGlobalData& sceneData,
-  const Buffer& frame_cb,
-  const DebugVisualSettings& settings) {
-  ID3D12GraphicsCommandList* cmd_list = graphic.GetCommandList();
-  if (!is_initialized_ || !cmd_list || !debug_line_material_overlay_ || !debug_line_template_overlay_) {
-    return;
-  }
+  const UINT written = FillVertexData(cmds, static_cast<DebugVertex*>(vertices.cpu), vertex_count, depthMode, settings);
+  assert(written == vertex_count);
+  last_frame_vertex_count_ += written;
 
   // Bind main render targets and viewport/scissor for debug drawing.
   {
@@ -159,107 +125,34 @@ void DebugVisualRenderer::RenderOverlay(const DebugVisualCommandBuffer& cmds,
     cmd_list->RSSetScissorRects(1, &scissor);
   }
 
-  auto& frame = *frames_[current_frame_index_];
-
-  const UINT start_offset = frame.vertex_count;  // Depth-tested vertices already written (if any)
-  assert(start_offset <= MAX_DEBUG_VERTICES);
-  if (start_offset >= MAX_DEBUG_VERTICES) {
-    return;
-  }
-
-  const UINT remaining = MAX_DEBUG_VERTICES - start_offset;
-  DebugVertex* dst = frame.mapped_ptr + start_offset;
-
-  const UINT overlay_vertex_count = FillVertexData(cmds, dst, remaining, DebugDepthMode::IgnoreDepth, settings);
-  assert(start_offset + overlay_vertex_count <= MAX_DEBUG_VERTICES);
-  if (overlay_vertex_count == 0) {
-    last_frame_vertex_count_ = frame.vertex_count;
-    return;
-  }
-
-  assert(start_offset + overlay_vertex_count <= MAX_DEBUG_VERTICES);
-  frame.vertex_count += overlay_vertex_count;
-  last_frame_vertex_count_ = frame.vertex_count;
-
-  const D3D12_GPU_VIRTUAL_ADDRESS cb_address = sceneData.scene_cb_gpu_address ? sceneData.scene_cb_gpu_address : frame_cb.GetGPUAddress();
-
   DirectX::XMFLOAT4X4 identity_world;
   DirectX::XMStoreFloat4x4(&identity_world, DirectX::XMMatrixIdentity());
 
-  D3D12_VERTEX_BUFFER_VIEW vbv = frame.vertex_buffer.GetVBV(sizeof(DebugVertex));
+  D3D12_VERTEX_BUFFER_VIEW vbv = {};
+  vbv.BufferLocation = vertices.gpu;
+  vbv.SizeInBytes = buffer_size;
+  vbv.StrideInBytes = sizeof(DebugVertex);
 
-  cmd_list->SetPipelineState(debug_line_template_overlay_->GetPSO());
-  cmd_list->SetGraphicsRootSignature(debug_line_template_overlay_->GetRootSignature());
+  cmd_list->SetPipelineState(line_template->GetPSO());
+  cmd_list->SetGraphicsRootSignature(line_template->GetRootSignature());
   cmd_list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
   cmd_list->IASetVertexBuffers(0, 1, &vbv);
 
-  cmd_list->SetGraphicsRoot32BitConstants(0, 16, &identity_world, 0);  // b0 - world matrix
-  cmd_list->SetGraphicsRootConstantBufferView(1, cb_address);          // b1 - FrameCB
+  cmd_list->SetGraphicsRoot32BitConstants(0, 16, &identity_world, 0);            // b0 - world matrix
+  cmd_list->SetGraphicsRootConstantBufferView(1, sceneData.scene_cb_gpu_address);  // b1 - FrameCB
 
-  // Note: firstVertexLocation = start_offset to append after depth-tested vertices
-  cmd_list->DrawInstanced(overlay_vertex_count, 1, start_offset, 0);
+  cmd_list->DrawInstanced(written, 1, 0, 0);
 }
 
-void DebugVisualRenderer::Render(const DebugVisualCommandBuffer& cmds,
-  Graphic& graphic,
-  const SceneGlobalData& sceneData,
-  const Buffer& frame_cb,
-  const DebugVisualSettings& settings) {
-  RenderDepthTested(cmds, graphic, sceneData, frame_cb, settings);
-  RenderOverlay(cmds, graphic, sceneData, frame_cb, settings);
-}
-
-bool DebugVisualRenderer::CreateFrameBuffers() {
-  if (!graphic_) {
-    return false;
-  }
-
-  frame_count_ = Graphic::FrameCount;
-  frames_.clear();
-  frames_.resize(frame_count_);
-
-  // Create upload buffers for each frame
-  for (uint32_t i = 0; i < frame_count_; ++i) {
-    frames_[i] = std::make_unique<FrameData>();
-    auto& frame = *frames_[i];
-
-    // Create upload buffer
-    size_t buffer_size = MAX_DEBUG_VERTICES * sizeof(DebugVertex);
-    if (!frame.vertex_buffer.Create(graphic_->GetDevice(), buffer_size, Buffer::Type::Vertex, D3D12_HEAP_TYPE_UPLOAD)) {
-      std::cerr << "[DebugVisualRenderer] Failed to create vertex buffer for frame " << i << '\n';
-      return false;
-    }
-
-    // Map the buffer persistently
-    void* mapped_data = nullptr;
-    D3D12_RANGE read_range = {};  // We won't read from upload buffer
-    HRESULT hr = frame.vertex_buffer.GetResource()->Map(0, &read_range, &mapped_data);
-
-    if (FAILED(hr)) {
-      std::cerr << "[DebugVisualRenderer] Failed to map vertex buffer for frame " << i << '\n';
-      return false;
-    }
-
-    frame.mapped_ptr = static_cast<DebugVertex*>(mapped_data);
-    frame.is_mapped = true;
-    frame.vertex_count = 0;
-  }
-
-  return true;
-}
-
-void DebugVisualRenderer::ReleaseFrameBuffers() {
-  for (auto& frame_ptr : frames_) {
-    if (!frame_ptr) continue;
-    auto& frame = *frame_ptr;
-    if (frame.is_mapped && frame.vertex_buffer.GetResource()) {
-      frame.vertex_buffer.GetResource()->Unmap(0, nullptr);
-      frame.is_mapped = false;
+UINT DebugVisualRenderer::CountVertices(
+  const DebugVisualCommandBuffer& cmds, DebugDepthMode depthMode, const DebugVisualSettings& settings) {
+  UINT vertex_count = 0;
+  for (const auto& line : cmds.lines3D) {
+    if (line.depthMode == depthMode && settings.IsCategoryEnabled(line.category)) {
+      vertex_count += 2;
     }
-    frame.mapped_ptr = nullptr;
-    frame.vertex_count = 0;
-    // Buffer destructor will handle resource cleanup
   }
+  return vertex_count;
 }
 
 UINT DebugVisualRenderer::FillVertexData(const DebugVisualCommandBuffer& cmds,
@@ -3,10 +3,6 @@
 #include <DirectXMath.h>
 #include <d3d12.h>
 
-#include <memory>
-#include <vector>
-
-#include "buffer.h"
 #include "debug_visual_service.h"
 #include "vertex_types.h"
 
@@ -43,28 +39,19 @@ class DebugVisualRenderer {
   void Shutdown();
 
   // Call this at the beginning of each frame
-  void BeginFrame(uint32_t frameIndex);
+  void BeginFrame();
 
   // Render depth-tested debug lines
-  void RenderDepthTested(const DebugVisualCommandBuffer& cmds,
-    Graphic& graphic,
-    const SceneGlobalData& sceneData,
-    const Buffer& frame_cb,
-    const DebugVisualSettings& settings);
+  void RenderDepthTested(
+    const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings);
 
   // Render overlay (ignore depth) debug lines
-  void RenderOverlay(const DebugVisualCommandBuffer& cmds,
-    Graphic& graphic,
-    const SceneGlobalData& sceneData,
-    const Buffer& frame_cb,
-    const DebugVisualSettings& settings);
+  void RenderOverlay(
+    const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings);
 
   // Helper to render both depth-tested then overlay (for compatibility)
-  void Render(const DebugVisualCommandBuffer& cmds,
-    Graphic& graphic,
-    const SceneGlobalData& sceneData,
-    const Buffer& frame_cb,
-    const DebugVisualSettings& settings);
+  void Render(
+    const DebugVisualCommandBuffer& cmds, Graphic& graphic, const SceneGlobalData& sceneData, const DebugVisualSettings& settings);
 
   // Statistics
   uint32_t GetLastFrameVertexCount() const {
@@ -75,40 +62,26 @@ class DebugVisualRenderer {
   }
 
  private:
-  static constexpr UINT MAX_DEBUG_VERTICES = 64 * 1024;  // 64K vertices max per frame
-
-  // Per-frame data
-  struct FrameData {
-    Buffer vertex_buffer;  // Upload heap buffer for this frame
-    DebugVertex* mapped_ptr = nullptr;
-    UINT vertex_count = 0;
-    bool is_mapped = false;
-
-    void Reset() {
-      vertex_count = 0;
-      // Keep buffer mapped persistently
-    }
-  };
-
   // Internal state
   bool is_initialized_ = false;
   Graphic* graphic_ = nullptr;
-  uint32_t frame_count_ = 1;
-  uint32_t current_frame_index_ = 0;
   uint32_t last_frame_vertex_count_ = 0;
 
-  // Per-frame buffers
-  std::vector<std::unique_ptr<FrameData>> frames_;
-
   // Material system references (non-owning)
   MaterialTemplate* debug_line_template_overlay_ = nullptr;
   MaterialInstance* debug_line_material_overlay_ = nullptr;
   MaterialTemplate* debug_line_template_depth_ = nullptr;
   MaterialInstance* debug_line_material_depth_ = nullptr;
 
-  // Internal helpers
-  bool CreateFrameBuffers();
-  void ReleaseFrameBuffers();
+  // Vertices are written into the graphic's per-frame upload ring; each pass allocates exactly what it draws
+  void RenderLines(const DebugVisualCommandBuffer& cmds,
+    Graphic& graphic,
+    const SceneGlobalData& sceneData,
+    const DebugVisualSettings& settings,
+    DebugDepthMode depthMode,
+    MaterialTemplate* line_template);
+
+  static UINT CountVertices(const DebugVisualCommandBuffer& cmds, DebugDepthMode depthMode, const DebugVisualSettings& settings);
   UINT FillVertexData(const DebugVisualCommandBuffer& cmds,
     DebugVertex* vertex_buffer,
     UINT max_vertices,
@@ -13,7 +13,6 @@
 bool DebugVisualRenderer2D::Initialize(Graphic& graphic) {
   device_ = graphic.GetDevice();
   graphic_ = &graphic;
-  frame_count_ = Graphic::FrameCount;
   assert(device_ != nullptr);
 
   // Load shaders
@@ -42,28 +41,18 @@ bool DebugVisualRenderer2D::Initialize(Graphic& graphic) {
     return false;
   }
 
-  if (!CreateFrameResources()) {
-    std::cerr << "[DebugVisualRenderer2D] Failed to create frame resources" << '\n';
-    return false;
-  }
-
   std::cout << "[DebugVisualRenderer2D] Initialized successfully" << '\n';
   return true;
 }
 
 void DebugVisualRenderer2D::Shutdown() {
-  for (auto& frame_res : frame_resources_) {
-    frame_res.vertex_buffer.reset();
-  }
-
   pso_.Reset();
   root_signature_.Reset();
   device_ = nullptr;
   graphic_ = nullptr;
 }
 
-void DebugVisualRenderer2D::BeginFrame(uint32_t frame_index) {
-  current_frame_index_ = (frame_count_ == 0) ? 0u : (frame_index % frame_count_);
+void DebugVisualRenderer2D::BeginFrame() {
   vertex_count_ = 0;
 }
 
@@ -89,9 +78,6 @@ void DebugVisualRenderer2D::Render(const DebugVisualCommandBuffer2D& commands,
     command_list->RSSetScissorRects(1, &scissor);
   }
 
-  FrameResource& frame_res = frame_resources_[current_frame_index_];
-  assert(frame_res.vertex_buffer != nullptr);
-
   // Expand commands into vertices (with category filtering)
   std::vector<DebugVertex2D> vertices;
   vertices.reserve(commands.lines2D.size() * 2 + commands.rects2D.size() * 8);
@@ -137,14 +123,14 @@ void DebugVisualRenderer2D::Render(const DebugVisualCommandBuffer2D& commands,
     return;
   }
 
-  if (vertex_count_ > MAX_VERTICES_PER_FRAME) {
-    std::cerr << "[DebugVisualRenderer2D] Vertex count exceeds maximum: " << vertex_count_ << '\n';
-    vertex_count_ = MAX_VERTICES_PER_FRAME;
+  // Upload vertices into the per-frame ring (no fixed cap)
+  const UINT buffer_size = vertex_count_ * sizeof(DebugVertex2D);
+  const UploadRing::Allocation vertex_data = graphic.GetUploadRing().Push(vertices.data(), buffer_size, alignof(DebugVertex2D));
+  if (!vertex_data.IsValid()) {
+    std::cerr << "[DebugVisualRenderer2D] Failed to allocate " << vertex_count_ << " vertices" << '\n';
+    return;
   }
 
-  // Upload vertices to buffer
-  frame_res.vertex_buffer->Upload(vertices.data(), vertex_count_ * sizeof(DebugVertex2D));
-
   // Set pipeline state
   command_list->SetPipelineState(pso_.Get());
   command_list->SetGraphicsRootSignature(root_signature_.Get());
@@ -155,7 +141,10 @@ void DebugVisualRenderer2D::Render(const DebugVisualCommandBuffer2D& commands,
   command_list->SetGraphicsRoot32BitConstants(0, 16, &view_proj, 0);
 
   // Set vertex buffer
-  D3D12_VERTEX_BUFFER_VIEW vbv = frame_res.vertex_buffer->GetVBV(sizeof(DebugVertex2D));
+  D3D12_VERTEX_BUFFER_VIEW vbv = {};
+  vbv.BufferLocation = vertex_data.gpu;
+  vbv.SizeInBytes = buffer_size;
+  vbv.StrideInBytes = sizeof(DebugVertex2D);
   command_list->IASetVertexBuffers(0, 1, &vbv);
   command_list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
 
@@ -199,26 +188,3 @@ bool DebugVisualRenderer2D::CreatePipelineState() {
 
   return builder.Build(device_, pso_);
 }
-
-bool DebugVisualRenderer2D::CreateFrameResources() {
-  frame_resources_.clear();
-  frame_resources_.resize(frame_count_);
-
-  for (uint32_t i = 0; i < frame_count_; ++i) {
-    FrameResource& frame_res = frame_resources_[i];
-
-    // Create upload buffer for vertices
-    frame_res.vertex_buffer = std::make_unique<Buffer>();
-    const size_t buffer_size = MAX_VERTICES_PER_FRAME * sizeof(DebugVertex2D);
-
-    if (!frame_res.vertex_buffer->Create(device_, buffer_size, Buffer::Type::Vertex, D3D12_HEAP_TYPE_UPLOAD)) {
-      std::cerr << "[DebugVisualRenderer2D] Failed to create vertex buffer for frame " << i << '\n';
-      return false;
-    }
-
-    // Get mapped pointer (Buffer already maps it internally for upload heap)
-    // We'll use Upload method to write data each frame
-  }
-
-  return true;
-}
@@ -95,55 +95,22 @@ bool DescriptorHeapAllocator::InitializeFromExistingHeap(ID3D12Device* device,
 DescriptorHeapAllocator::Allocation DescriptorHeapAllocator::Allocate(uint32_t count) {
   assert(count > 0);
 
-  // No free block
-  if (allocated_ + count > capacity_) {
+  RangeAllocator::Allocation range = range_allocator_.Allocate(count);
+  if (!range.IsValid()) {
     std::cerr << "DescriptorAllocator::Allocate - Out of descriptors! "
-              << "Requested: " << count << ", Available: " << (capacity_ - allocated_) << ", Free blocks: " << free_blocks_.size() << '\n';
+              << "Requested: " << count << ", Available: " << GetAvailable()
+              << ", Largest free block: " << range_allocator_.GetLargestFreeBlock()
+              << ", Free blocks: " << range_allocator_.GetFreeBlockCount() << '\n';
     return {};
   }
 
   Allocation allocation{};
+  allocation.index = static_cast<uint32_t>(range.offset);
   allocation.count = count;
-
-  auto block = FindBestFitBlock(count);
-
-  // free block found
-  if (block != free_blocks_.end()) {
-    allocation.index = block->index;
-    allocation.cpu = GetCpuHandle(allocation.index);
-    allocation.gpu = shader_visible_ ? GetGpuHandle(allocation.index) : D3D12_GPU_DESCRIPTOR_HANDLE{0};
-
-    // remove the best fit from indexing map
-    auto size_range = free_blocks_by_size_.equal_range(block->count);
-    for (auto it = size_range.first; it != size_range.second; ++it) {
-      if (it->second == block) {
-        free_blocks_by_size_.erase(it);
-        break;
-      }
-    }
-
-    // put the remaining space back to indexing map
-    if (block->count > count) {
-      FreeBlock remaining{};
-      remaining.index = block->index + count;
-      remaining.count = block->count - count;
-      block->index = remaining.index;  // inplace update
-      block->count = remaining.count;  // inplace update
-
-      free_blocks_by_size_.insert({remaining.count, block});  // update indexing map
-    } else {
-      free_blocks_.erase(block);
-    }
-
-    return allocation;
-  }
-
-  allocation.index = allocated_;
   allocation.cpu = GetCpuHandle(allocation.index);
   allocation.gpu = shader_visible_ ? GetGpuHandle(allocation.index) : D3D12_GPU_DESCRIPTOR_HANDLE{0};
 
-  allocated_ += count;
-
+  node_by_index_[allocation.index] = range.node;
   return allocation;
 }
 
@@ -152,81 +119,22 @@ void DescriptorHeapAllocator::Free(const Allocation& allocation) {
     return;
   }
 
-  FreeBlock new_block{};
-  new_block.index = allocation.index;
-  new_block.count = allocation.count;
-
-  auto insert_pos = free_blocks_.begin();
-  while (insert_pos != free_blocks_.end() && insert_pos->index < new_block.index) {
-    ++insert_pos;
+  if (allocation.index >= capacity_ || node_by_index_[allocation.index] == RangeAllocator::kInvalidNode) {
+    std::cerr << "DescriptorAllocator::Free - Unknown allocation at index " << allocation.index << '\n';
+    return;
   }
 
-  auto inserted_it = free_blocks_.insert(insert_pos, new_block);
-  free_blocks_by_size_.insert({new_block.count, inserted_it});
-
-  MergeFreeBlocks();
+  RangeAllocator::Allocation range;
+  range.offset = allocation.index;
+  range.size = allocation.count;
+  range.node = node_by_index_[allocation.index];
+  node_by_index_[allocation.index] = RangeAllocator::kInvalidNode;
+  range_allocator_.Free(range);
 }
 
 void DescriptorHeapAllocator::Reset() {
-  allocated_ = 0;
-  free_blocks_.clear();
-  free_blocks_by_size_.clear();
-}
-
-std::list<DescriptorHeapAllocator::FreeBlock>::iterator DescriptorHeapAllocator::FindBestFitBlock(uint32_t count) {
-  auto it = free_blocks_by_size_.lower_bound(count);
-
-  if (it != free_blocks_by_size_.end()) {
-    return it->second;
-  }
-
-  return free_blocks_.end();
-}
-
-void DescriptorHeapAllocator::MergeFreeBlocks() {
-  if (free_blocks_.size() < 2) {
-    return;
-  }
-
-  auto it = free_blocks_.begin();
-  while (it != free_blocks_.end()) {
-    auto next = std::next(it);
-
-    if (next == free_blocks_.end()) {
-      break;
-    }
-
-    // Check if current block and next block are adjacent
-    if (it->index + it->count == next->index) {
-      // Remove both blocks from indexing map
-      auto size_range1 = free_blocks_by_size_.equal_range(it->count);
-      for (auto size_it = size_range1.first; size_it != size_range1.second; ++size_it) {
-        if (size_it->second == it) {
-          free_blocks_by_size_.erase(size_it);
-          break;
-        }
-      }
-
-      auto size_range2 = free_blocks_by_size_.equal_range(next->count);
-      for (auto size_it = size_range2.first; size_it != size_range2.second; ++size_it) {
-        if (size_it->second == next) {
-          free_blocks_by_size_.erase(size_it);
-          break;
-        }
-      }
-
-      // Merge blocks
-      it->count += next->count;
-      free_blocks_.erase(next);
-
-      // Re-insert merged block into size map
-      free_blocks_by_size_.insert({it->count, it});
-
-      // Continue checking with the same iterator (in case we can merge more)
-    } else {
-      ++it;
-    }
-  }
+  range_allocator_.Initialize(capacity_);
+  node_by_index_.assign(capacity_, RangeAllocator::kInvalidNode);
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeapAllocator::GetCpuHandle(uint32_t index) const {
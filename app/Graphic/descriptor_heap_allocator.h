@@ -3,9 +3,9 @@
 #include <d3d12.h>
 
 #include <cstdint>
-#include <list>
-#include <map>
+#include <vector>
 
+#include "thread_cached_range_allocator.h"
 #include "types.h"
 
 class DescriptorHeapAllocator {
@@ -40,6 +40,7 @@ class DescriptorHeapAllocator {
     uint32_t base_index,
     uint32_t capacity,
     bool shader_visible);
+  // Allocate / Free are thread-safe (Reset and Initialize are not)
   Allocation Allocate(uint32_t count = 1);
   void Free(const Allocation& allocation);
   void Reset();
@@ -53,19 +54,26 @@ class DescriptorHeapAllocator {
   uint32_t GetBaseIndex() const {
     return base_index_;
   }
+  // GPU handle of index 0 of this allocator's range (start of a table indexed by Allocation::index)
+  D3D12_GPU_DESCRIPTOR_HANDLE GetGpuBase() const {
+    return GetGpuHandle(0);
+  }
 
   // Statistic
   uint32_t GetCapacity() const {
     return capacity_;
   }
   uint32_t GetAllocated() const {
-    return allocated_;
+    return static_cast<uint32_t>(range_allocator_.GetAllocatedSize());
   }
   uint32_t GetAvailable() const {
-    return capacity_ - allocated_;
+    return capacity_ - GetAllocated();
   }
   uint32_t GetFragmentationCount() const {
-    return static_cast<uint32_t>(free_blocks_.size());
+    return range_allocator_.GetFreeBlockCount();
+  }
+  ThreadCachedRangeAllocator::Stats GetCacheStats() const {
+    return range_allocator_.GetStats();
   }
 
  private:
@@ -74,7 +82,6 @@ class DescriptorHeapAllocator {
   uint32_t descriptor_size_ = 0;
   uint32_t base_index_ = 0;
   uint32_t capacity_ = 0;
-  uint32_t allocated_ = 0;
   bool shader_visible_ = false;
   bool owns_heap_ = true;
 
@@ -84,18 +91,10 @@ class DescriptorHeapAllocator {
   D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(uint32_t index) const;
   D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(uint32_t index) const;
 
-  struct FreeBlock {
-    uint32_t index;
-    uint32_t count;
-
-    bool operator<(const FreeBlock& other) const {
-      return index < other.index;
-    }
-  };
-
-  std::list<FreeBlock> free_blocks_;
-  std::multimap<uint32_t, std::list<FreeBlock>::iterator> free_blocks_by_size_;
+  // O(1) allocate/free/coalesce over descriptor indices; single descriptors come from per-thread caches
+  ThreadCachedRangeAllocator range_allocator_;
 
-  void MergeFreeBlocks();
-  std::list<FreeBlock>::iterator FindBestFitBlock(uint32_t count);
+  // Range node of the allocation starting at each index, so Free keeps taking a plain Allocation.
+  // Each entry is only touched by the owner of that allocation, so no lock is needed.
+  std::vector<uint32_t> node_by_index_;
 };
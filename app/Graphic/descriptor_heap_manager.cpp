@@ -79,6 +79,15 @@ bool DescriptorHeapManager::Initalize(ID3D12Device* device, uint32_t frame_count
     srv_offset += slice_capacity;
   }
 
+  if (!srv_staging_heap_.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, config_.srv_staging_capacity, false)) {
+    std::cerr << "Failed to initialize SRV staging heap" << '\n';
+    return false;
+  }
+  if (!srv_table_ring_.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)) {
+    std::cerr << "Failed to initialize SRV table ring" << '\n';
+    return false;
+  }
+
   if (!sampler_heap_.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, config_.sampler_capacity, true)) {
     std::cerr << "Failed to initialize sampler heap" << '\n';
     return false;
@@ -119,6 +128,7 @@ void DescriptorHeapManager::BeginFrame(uint32_t frame_index) {
   if (current_frame_index_ < srv_dynamic_frames_.size()) {
     if (srv_dynamic_frames_[current_frame_index_]) {
       srv_dynamic_frames_[current_frame_index_]->Reset();
+      srv_table_ring_.BeginFrame(srv_dynamic_frames_[current_frame_index_].get());
     }
   }
   if (current_frame_index_ < sampler_frames_.size()) {
@@ -139,6 +149,10 @@ void DescriptorHeapManager::SetDescriptorHeaps(ID3D12GraphicsCommandList* comman
   command_list->SetDescriptorHeaps(static_cast<UINT>(heaps.size()), heaps.data());
 }
 
+void DescriptorHeapManager::FlushDescriptorCopies() {
+  srv_table_ring_.FlushCopies();
+}
+
 void DescriptorHeapManager::PrintStats() const {
   uint32_t srv_dyn_allocated = 0;
   uint32_t srv_dyn_capacity = 0;
@@ -161,6 +175,15 @@ void DescriptorHeapManager::PrintStats() const {
   std::cout << "DSV Heap: " << dsv_heap_.GetAllocated() << "/" << dsv_heap_.GetCapacity() << '\n';
   std::cout << "SRV Heap Static (persistent): " << srv_static_heap_.GetAllocated() << "/" << srv_static_heap_.GetCapacity() << '\n';
   std::cout << "SRV Heap Dynamic (per-frame slices): " << srv_dyn_allocated << "/" << srv_dyn_capacity << '\n';
+  std::cout << "SRV Staging (CPU-only): " << srv_staging_heap_.GetAllocated() << "/" << srv_staging_heap_.GetCapacity() << '\n';
+
+  const DescriptorTableRing::Stats& ring_stats = srv_table_ring_.GetStats();
+  std::cout << "SRV Table Ring: tables " << ring_stats.tables << ", cache hits " << ring_stats.cache_hits << ", copied "
+            << ring_stats.descriptors_copied << " in " << ring_stats.copy_calls << " CopyDescriptors calls" << '\n';
   std::cout << "Sampler Heap (per-frame slices): " << sampler_allocated << "/" << sampler_capacity << '\n';
+
+  const ThreadCachedRangeAllocator::Stats cache_stats = srv_static_heap_.GetCacheStats();
+  std::cout << "SRV Static cache: hits " << cache_stats.magazine_hits << "/" << cache_stats.allocations << ", refills "
+            << cache_stats.refills << ", flushes " << cache_stats.flushes << ", lock contentions " << cache_stats.lock_contentions << '\n';
   std::cout << "==================================\n" << '\n';
 }
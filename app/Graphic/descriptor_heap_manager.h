@@ -6,12 +6,14 @@
 
 #include "d3d12.h"
 #include "descriptor_heap_allocator.h"
+#include "descriptor_table_ring.h"
 
 constexpr int DEFAULT_RTV_CAPACITY = 256;
 constexpr int DEFAULT_DSV_CAPACITY = 64;
 constexpr int DEFAULT_SRV_CAPACITY = 4096;
 constexpr int DEFAULT_SAMPLER_CAPACITY = 256;
 constexpr int DEFAULT_SRV_STATIC_RESERVED = 2048;
+constexpr int DEFAULT_SRV_STAGING_CAPACITY = 4096;
 
 class DescriptorHeapManager {
  public:
@@ -24,6 +26,8 @@ class DescriptorHeapManager {
   bool Initalize(ID3D12Device* device, uint32_t frame_count);
   void BeginFrame(uint32_t frame_index);
   void SetDescriptorHeaps(ID3D12GraphicsCommandList* command_list);
+  // Copy this frame's assembled descriptor tables into the shader-visible heap (before ExecuteCommandLists)
+  void FlushDescriptorCopies();
 
   DescriptorHeapAllocator& GetRtvAllocator() {
     return rtv_heap_;
@@ -35,6 +39,14 @@ class DescriptorHeapManager {
   DescriptorHeapAllocator& GetSrvStaticAllocator() {
     return srv_static_heap_;
   }
+  // CPU-only SRV heap for persistent descriptors that are copied into per-frame tables.
+  DescriptorHeapAllocator& GetSrvStagingAllocator() {
+    return srv_staging_heap_;
+  }
+  // Per-frame descriptor tables assembled from staging descriptors (lives in the dynamic SRV region).
+  DescriptorTableRing& GetSrvTableRing() {
+    return srv_table_ring_;
+  }
   // Per-frame SRV allocations (reset at BeginFrame).
   DescriptorHeapAllocator& GetSrvDynamicAllocator() {
     return *srv_dynamic_frames_[current_frame_index_];
@@ -53,6 +65,10 @@ class DescriptorHeapManager {
   DescriptorHeapAllocator srv_heap_;
   DescriptorHeapAllocator srv_static_heap_;
   std::vector<std::unique_ptr<DescriptorHeapAllocator>> srv_dynamic_frames_;
+  DescriptorTableRing srv_table_ring_;
+
+  // Non-shader-visible source heap for CopyDescriptors (shader-visible heaps are slow to read from).
+  DescriptorHeapAllocator srv_staging_heap_;
 
   // Underlying sampler heap (owned) + per-frame sub-allocators (slices).
   DescriptorHeapAllocator sampler_heap_;
@@ -67,6 +83,7 @@ class DescriptorHeapManager {
 
     uint32_t srv_capacity = DEFAULT_SRV_CAPACITY;
     uint32_t srv_static_reserved = DEFAULT_SRV_STATIC_RESERVED;
+    uint32_t srv_staging_capacity = DEFAULT_SRV_STAGING_CAPACITY;
     uint32_t sampler_capacity = DEFAULT_SAMPLER_CAPACITY;
   };
 
@@ -0,0 +1,100 @@
+#include "descriptor_table_ring.h"
+
+#include <cassert>
+#include <iostream>
+
+bool DescriptorTableRing::Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type) {
+  assert(device != nullptr);
+
+  device_ = device;
+  type_ = type;
+  frame_allocator_ = nullptr;
+  stats_ = {};
+  return true;
+}
+
+void DescriptorTableRing::BeginFrame(DescriptorHeapAllocator* frame_allocator) {
+  assert(frame_allocator != nullptr);
+
+  // Copies of the previous frame must not leak into the new slice (EndFrame normally flushed them)
+  FlushCopies();
+
+  frame_allocator_ = frame_allocator;
+  table_cache_.clear();
+  table_sources_.clear();
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorTableRing::AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count) {
+  assert(frame_allocator_ != nullptr);
+  assert(sources != nullptr && count > 0);
+
+  ++stats_.tables;
+
+  const uint64_t hash = HashSources(sources, count);
+  auto it = table_cache_.find(hash);
+  if (it != table_cache_.end() && it->second.count == count) {
+    const D3D12_CPU_DESCRIPTOR_HANDLE* cached = table_sources_.data() + it->second.source_offset;
+    bool same = true;
+    for (uint32_t i = 0; i < count && same; ++i) {
+      same = cached[i].ptr == sources[i].ptr;
+    }
+    if (same) {
+      ++stats_.cache_hits;
+      return it->second.gpu;
+    }
+  }
+
+  const DescriptorHeapAllocator::Allocation table = frame_allocator_->Allocate(count);
+  if (!table.IsValid()) {
+    std::cerr << "[DescriptorTableRing] Frame descriptor slice exhausted (" << count << " requested)" << '\n';
+    return D3D12_GPU_DESCRIPTOR_HANDLE{0};
+  }
+
+  dest_starts_.push_back(table.cpu);
+  dest_sizes_.push_back(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    source_starts_.push_back(sources[i]);
+    source_sizes_.push_back(1);
+  }
+
+  // On a hash collision the newer table simply replaces the cached one
+  CachedTable& cached = table_cache_[hash];
+  cached.source_offset = static_cast<uint32_t>(table_sources_.size());
+  cached.count = count;
+  cached.gpu = table.gpu;
+  table_sources_.insert(table_sources_.end(), sources, sources + count);
+
+  return table.gpu;
+}
+
+void DescriptorTableRing::FlushCopies() {
+  if (dest_starts_.empty()) {
+    return;
+  }
+
+  device_->CopyDescriptors(static_cast<UINT>(dest_starts_.size()),
+    dest_starts_.data(),
+    dest_sizes_.data(),
+    static_cast<UINT>(source_starts_.size()),
+    source_starts_.data(),
+    source_sizes_.data(),
+    type_);
+
+  ++stats_.copy_calls;
+  stats_.descriptors_copied += static_cast<uint32_t>(source_starts_.size());
+
+  dest_starts_.clear();
+  dest_sizes_.clear();
+  source_starts_.clear();
+  source_sizes_.clear();
+}
+
+uint64_t DescriptorTableRing::HashSources(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count) {
+  // FNV-1a over the handle values
+  uint64_t hash = 14695981039346656037ull;
+  for (uint32_t i = 0; i < count; ++i) {
+    hash ^= static_cast<uint64_t>(sources[i].ptr);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
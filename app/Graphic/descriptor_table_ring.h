@@ -0,0 +1,72 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "descriptor_heap_allocator.h"
+
+// DescriptorTableRing: Builds shader-visible descriptor tables for the current frame out of CPU-only
+// (staging) descriptors. Tables are carved linearly from the frame's slice of the shader-visible heap,
+// identical tables within a frame are shared through a hash cache, and all copies are issued with a
+// single CopyDescriptors call before the frame's command lists execute.
+//
+// Render thread only.
+class DescriptorTableRing {
+ public:
+  struct Stats {
+    uint32_t tables = 0;              // AllocateTable calls
+    uint32_t cache_hits = 0;          // Served by an identical table built earlier this frame
+    uint32_t descriptors_copied = 0;  // Descriptors copied into the shader-visible heap
+    uint32_t copy_calls = 0;          // CopyDescriptors calls (one per frame with pending copies)
+  };
+
+  DescriptorTableRing() = default;
+  ~DescriptorTableRing() = default;
+
+  DescriptorTableRing(const DescriptorTableRing&) = delete;
+  DescriptorTableRing& operator=(const DescriptorTableRing&) = delete;
+
+  bool Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+  // Start filling this frame's slice (already reset by the caller). Drops the table cache.
+  void BeginFrame(DescriptorHeapAllocator* frame_allocator);
+
+  // GPU handle of a contiguous table holding copies of sources[0..count), or a null handle when the
+  // frame slice is full. Sources must live in a non-shader-visible heap.
+  D3D12_GPU_DESCRIPTOR_HANDLE AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count);
+
+  // Issue all pending copies (must run before the command lists referencing the tables execute)
+  void FlushCopies();
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+ private:
+  struct CachedTable {
+    uint32_t source_offset;  // into table_sources_
+    uint32_t count;
+    D3D12_GPU_DESCRIPTOR_HANDLE gpu;
+  };
+
+  ID3D12Device* device_ = nullptr;
+  D3D12_DESCRIPTOR_HEAP_TYPE type_ = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+  DescriptorHeapAllocator* frame_allocator_ = nullptr;
+
+  // Per-frame dedupe: source hash -> table (sources kept for an exact compare on hash hits)
+  std::unordered_map<uint64_t, CachedTable> table_cache_;
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> table_sources_;
+
+  // Pending copies: one destination range per table, one source range per descriptor
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> dest_starts_;
+  std::vector<UINT> dest_sizes_;
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> source_starts_;
+  std::vector<UINT> source_sizes_;
+
+  Stats stats_;
+
+  static uint64_t HashSources(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count);
+};
@@ -1,5 +1,6 @@
 #include "framework_default_assets.h"
 
+#include <climits>
 #include <cstdint>
 #include <iostream>
 #include <vector>
@@ -19,35 +20,40 @@ namespace {
 constexpr const char* kSpriteWorldOpaqueInstance = "SpriteWorldOpaque_Default";
 constexpr const char* kSpriteWorldTransparentInstance = "SpriteWorldTransparent_Default";
 constexpr const char* kSpriteUIInstance = "SpriteUI_Default";
+constexpr const char* kMeshCookedOpaqueInstance = "MeshCookedOpaque_Default";
 constexpr const char* kDebugLineOverlayInstance = "DebugLine_Overlay_Default";
 constexpr const char* kDebugLineDepthInstance = "DebugLine_Depth_Default";
+
+// Sprite root signature parameter indices (see basic_type.hlsli)
+constexpr UINT kSpriteTextureRootIndex = 4;
+constexpr UINT kSpriteTextureIndexRootIndex = 5;
 }  // namespace
 
 void FrameworkDefaultAssets::Initialize(Graphic& graphic) {
   graphic_ = &graphic;
 
-  // Create a simple rect mesh using the primitive geometry helper.
-  try {
-    rect2d_mesh_ = graphic.GetPrimitiveGeometry2D().CreateRect(graphic.GetUploadContext());
-  } catch (...) {
-    rect2d_mesh_ = nullptr;
-  }
+  // Rect mesh and default textures share one copy queue batch
+  graphic.Upload([&](UploadBatch& batch) {
+    // Create a simple rect mesh using the primitive geometry helper.
+    try {
+      rect2d_mesh_ = graphic.GetPrimitiveGeometry2D().CreateRect(batch);
+    } catch (...) {
+      rect2d_mesh_ = nullptr;
+    }
 
-  // Create default textures in a single upload batch using the upload context
-  graphic.ExecuteImmediate([&](ID3D12GraphicsCommandList* cmd) {
     auto& tex_mgr = graphic.GetTextureManager();
 
     // 1x1 white
     uint8_t white_px[4] = {255, 255, 255, 255};
-    white_texture_ = tex_mgr.CreateTextureFromMemory(cmd, white_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_White");
+    white_texture_ = tex_mgr.CreateTextureFromMemory(batch, white_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_White");
 
     // 1x1 black
     uint8_t black_px[4] = {0, 0, 0, 255};
-    black_texture_ = tex_mgr.CreateTextureFromMemory(cmd, black_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_Black");
+    black_texture_ = tex_mgr.CreateTextureFromMemory(batch, black_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_Black");
 
     // 1x1 flat normal (128,128,255,255)
     uint8_t flat_normal_px[4] = {128, 128, 255, 255};
-    flat_normal_texture_ = tex_mgr.CreateTextureFromMemory(cmd, flat_normal_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_FlatNormal");
+    flat_normal_texture_ = tex_mgr.CreateTextureFromMemory(batch, flat_normal_px, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_FlatNormal");
 
     // 8x8 error checker (pink and black)
     const int checker_w = 8;
@@ -72,9 +78,14 @@ void FrameworkDefaultAssets::Initialize(Graphic& graphic) {
     }
 
     error_texture_ =
-      tex_mgr.CreateTextureFromMemory(cmd, checker_data.data(), checker_w, checker_h, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_ErrorChecker");
+      tex_mgr.CreateTextureFromMemory(batch, checker_data.data(), checker_w, checker_h, DXGI_FORMAT_R8G8B8A8_UNORM, "Default_ErrorChecker");
   });
 
+  // Bindless draws with a missing / released texture sample the checker instead of a stale slot
+  graphic.GetTextureManager().SetBindlessFallback(error_texture_);
+  // Async loads show white while in flight and the checker if they fail
+  graphic.GetTextureManager().SetLoadPlaceholders(white_texture_, error_texture_);
+
   // Create default materials after textures are available
   CreateDefaultMaterials(graphic);
 }
@@ -92,6 +103,7 @@ void FrameworkDefaultAssets::Shutdown() {
     material_mgr.RemoveInstance(kSpriteWorldOpaqueInstance);
     material_mgr.RemoveInstance(kSpriteWorldTransparentInstance);
     material_mgr.RemoveInstance(kSpriteUIInstance);
+    material_mgr.RemoveInstance(kMeshCookedOpaqueInstance);
     material_mgr.RemoveInstance(kDebugLineOverlayInstance);
     material_mgr.RemoveInstance(kDebugLineDepthInstance);
   }
@@ -107,11 +119,13 @@ void FrameworkDefaultAssets::Shutdown() {
   sprite_world_opaque_template_ = nullptr;
   sprite_world_transparent_template_ = nullptr;
   sprite_ui_template_ = nullptr;
+  mesh_cooked_opaque_template_ = nullptr;
   debug_line_template_overlay_ = nullptr;
   debug_line_template_depth_ = nullptr;
   sprite_world_opaque_material_ = nullptr;
   sprite_world_transparent_material_ = nullptr;
   sprite_ui_material_ = nullptr;
+  mesh_cooked_opaque_material_ = nullptr;
   debug_line_material_overlay_ = nullptr;
   debug_line_material_depth_ = nullptr;
 }
@@ -152,6 +166,10 @@ MaterialInstance* FrameworkDefaultAssets::GetSpriteUIMaterial() const {
   return sprite_ui_material_;
 }
 
+MaterialInstance* FrameworkDefaultAssets::GetMeshCookedOpaqueMaterial() const {
+  return mesh_cooked_opaque_material_;
+}
+
 MaterialTemplate* FrameworkDefaultAssets::GetDebugLineTemplateOverlay() const {
   return debug_line_template_overlay_;
 }
@@ -187,6 +205,20 @@ void FrameworkDefaultAssets::CreateDefaultMaterials(Graphic& gfx) {
     }
   }
 
+  // Optional: without it sprites fall back to one descriptor table per texture
+  if (gfx.IsBindlessSupported() && !shader_mgr.HasShader("BasicBindlessPS")) {
+    if (!shader_mgr.LoadShader(L"Content/shaders/basic_bindless.ps.cso", ShaderType::Pixel, "BasicBindlessPS")) {
+      std::cerr << "[FrameworkDefaultAssets] Failed to load BasicBindlessPS shader, using bound textures" << '\n';
+    }
+  }
+
+  // Optional: without it there is no material for cooked meshes
+  if (!shader_mgr.HasShader("CookedMeshVS")) {
+    if (!shader_mgr.LoadShader(L"Content/shaders/cooked_mesh.vs.cso", ShaderType::Vertex, "CookedMeshVS")) {
+      std::cerr << "[FrameworkDefaultAssets] Failed to load CookedMeshVS shader, cooked meshes have no default material" << '\n';
+    }
+  }
+
   if (!shader_mgr.HasShader("DebugLineVS")) {
     if (!shader_mgr.LoadShader(L"Content/shaders/debug_line.vs.cso", ShaderType::Vertex, "DebugLineVS")) {
       std::cerr << "[FrameworkDefaultAssets] Failed to load DebugLineVS shader" << '\n';
@@ -204,6 +236,9 @@ void FrameworkDefaultAssets::CreateDefaultMaterials(Graphic& gfx) {
   // Create Sprite2D material
   CreateSpriteMaterials(gfx);
 
+  // Create the cooked mesh material (only with CookedMeshVS)
+  CreateMeshMaterials(gfx);
+
   // Create DebugLine materials (overlay and depth-tested)
   CreateDebugLineMaterials(gfx);
 }
@@ -212,16 +247,25 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
   auto& shader_mgr = gfx.GetShaderManager();
   auto& material_mgr = gfx.GetMaterialManager();
 
+  // Bindless: one texture table for all sprites plus a per-draw index, instead of a table per draw
+  const bool bindless = gfx.IsBindlessSupported() && shader_mgr.HasShader("BasicBindlessPS");
+
   // Create root signature shared across sprite variants
   ComPtr<ID3D12RootSignature> sprite_root_signature;
   RootSignatureBuilder rs_builder;
   rs_builder
-    .AddRootConstant(16, 0, D3D12_SHADER_VISIBILITY_VERTEX)                                    // b0 - Object constants
-    .AddRootConstant(4, 2, D3D12_SHADER_VISIBILITY_VERTEX)                                     // b2 - Per-object color tint
-    .AddRootConstant(4, 3, D3D12_SHADER_VISIBILITY_VERTEX)                                     // b3 - Per-object UV transform
-    .AddRootCBV(1, D3D12_SHADER_VISIBILITY_ALL)                                                // b1 - Frame CB
-    .AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, D3D12_SHADER_VISIBILITY_PIXEL)  // t0 - Texture
-    .AddStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_WRAP, D3D12_SHADER_VISIBILITY_PIXEL)
+    .AddRootConstant(16, 0, D3D12_SHADER_VISIBILITY_VERTEX)  // b0 - Object constants
+    .AddRootConstant(4, 2, D3D12_SHADER_VISIBILITY_VERTEX)   // b2 - Per-object color tint
+    .AddRootConstant(4, 3, D3D12_SHADER_VISIBILITY_VERTEX)   // b3 - Per-object UV transform
+    .AddRootCBV(1, D3D12_SHADER_VISIBILITY_ALL);             // b1 - Frame CB
+  if (bindless) {
+    rs_builder
+      .AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, 0, D3D12_SHADER_VISIBILITY_PIXEL, 1)  // t0, space1 - All textures
+      .AddRootConstant(1, 4, D3D12_SHADER_VISIBILITY_PIXEL);                                              // b4 - BaseColor index
+  } else {
+    rs_builder.AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, D3D12_SHADER_VISIBILITY_PIXEL);  // t0 - Texture
+  }
+  rs_builder.AddStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_WRAP, D3D12_SHADER_VISIBILITY_PIXEL)
     .AllowInputLayout();
 
   if (!rs_builder.Build(gfx.GetDevice(), sprite_root_signature)) {
@@ -231,11 +275,11 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
 
   // Common shader blobs and input layout
   const ShaderBlob* vs = shader_mgr.GetShader("BasicVS");
-  const ShaderBlob* ps = shader_mgr.GetShader("BasicPS");
+  const ShaderBlob* ps = shader_mgr.GetShader(bindless ? "BasicBindlessPS" : "BasicPS");
   auto input_layout = GetInputLayout_VertexPositionTexture2D();
 
   std::vector<TextureSlotDefinition> sprite_texture_slots = {
-    {"BaseColor", 4, D3D12_SHADER_VISIBILITY_PIXEL}  // t0, parameter index 4 (descriptor table)
+    {"BaseColor", kSpriteTextureRootIndex, D3D12_SHADER_VISIBILITY_PIXEL}  // t0, parameter index 4 (descriptor table)
   };
 
   // World Opaque (depth write)
@@ -259,6 +303,9 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
         material_mgr.CreateTemplate("SpriteWorldOpaque", sprite_pso.Get(), sprite_root_signature.Get(), sprite_texture_slots);
 
       if (sprite_world_opaque_template_) {
+        if (bindless) {
+          sprite_world_opaque_template_->SetBindless(kSpriteTextureRootIndex, kSpriteTextureIndexRootIndex);
+        }
         sprite_world_opaque_material_ = material_mgr.CreateInstance(kSpriteWorldOpaqueInstance, sprite_world_opaque_template_);
         if (sprite_world_opaque_material_) {
           sprite_world_opaque_material_->SetTexture("BaseColor", white_texture_);
@@ -292,6 +339,9 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
         material_mgr.CreateTemplate("SpriteWorldTransparent", sprite_pso.Get(), sprite_root_signature.Get(), sprite_texture_slots);
 
       if (sprite_world_transparent_template_) {
+        if (bindless) {
+          sprite_world_transparent_template_->SetBindless(kSpriteTextureRootIndex, kSpriteTextureIndexRootIndex);
+        }
         sprite_world_transparent_material_ =
           material_mgr.CreateInstance(kSpriteWorldTransparentInstance, sprite_world_transparent_template_);
         if (sprite_world_transparent_material_) {
@@ -327,6 +377,9 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
       sprite_ui_template_ = material_mgr.CreateTemplate("SpriteUI", sprite_pso.Get(), sprite_root_signature.Get(), sprite_texture_slots);
 
       if (sprite_ui_template_) {
+        if (bindless) {
+          sprite_ui_template_->SetBindless(kSpriteTextureRootIndex, kSpriteTextureIndexRootIndex);
+        }
         sprite_ui_material_ = material_mgr.CreateInstance(kSpriteUIInstance, sprite_ui_template_);
         if (sprite_ui_material_) {
           sprite_ui_material_->SetTexture("BaseColor", white_texture_);
@@ -339,6 +392,84 @@ void FrameworkDefaultAssets::CreateSpriteMaterials(Graphic& gfx) {
   }
 }
 
+void FrameworkDefaultAssets::CreateMeshMaterials(Graphic& gfx) {
+  auto& shader_mgr = gfx.GetShaderManager();
+  auto& material_mgr = gfx.GetMaterialManager();
+
+  const ShaderBlob* vs = shader_mgr.GetShader("CookedMeshVS");
+  if (!vs) {
+    return;
+  }
+  const bool bindless = gfx.IsBindlessSupported() && shader_mgr.HasShader("BasicBindlessPS");
+  const ShaderBlob* ps = shader_mgr.GetShader(bindless ? "BasicBindlessPS" : "BasicPS");
+
+  // Sprite layout plus the position dequantization after it, so the world matrix stays usable for normals
+  ComPtr<ID3D12RootSignature> mesh_root_signature;
+  RootSignatureBuilder rs_builder;
+  rs_builder
+    .AddRootConstant(16, 0, D3D12_SHADER_VISIBILITY_VERTEX)  // b0 - Object constants
+    .AddRootConstant(4, 2, D3D12_SHADER_VISIBILITY_VERTEX)   // b2 - Per-object color tint
+    .AddRootConstant(4, 3, D3D12_SHADER_VISIBILITY_VERTEX)   // b3 - Per-object UV transform
+    .AddRootCBV(1, D3D12_SHADER_VISIBILITY_ALL);             // b1 - Frame CB
+  if (bindless) {
+    rs_builder
+      .AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, 0, D3D12_SHADER_VISIBILITY_PIXEL, 1)  // t0, space1 - All textures
+      .AddRootConstant(1, 4, D3D12_SHADER_VISIBILITY_PIXEL);                                              // b4 - BaseColor index
+  } else {
+    rs_builder.AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, D3D12_SHADER_VISIBILITY_PIXEL);  // t0 - Texture
+  }
+  rs_builder.AddRootConstant(8, 5, D3D12_SHADER_VISIBILITY_VERTEX)  // b5 - Position offset and scale
+    .AddStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_WRAP, D3D12_SHADER_VISIBILITY_PIXEL)
+    .AllowInputLayout();
+
+  if (!rs_builder.Build(gfx.GetDevice(), mesh_root_signature)) {
+    std::cerr << "[FrameworkDefaultAssets] Failed to create MeshCooked root signature" << '\n';
+    return;
+  }
+  const UINT dequantization_root_index = bindless ? kSpriteTextureIndexRootIndex + 1 : kSpriteTextureRootIndex + 1;
+
+  auto input_layout = GetInputLayout_CookedMeshVertex();
+  std::vector<TextureSlotDefinition> mesh_texture_slots = {
+    {"BaseColor", kSpriteTextureRootIndex, D3D12_SHADER_VISIBILITY_PIXEL}  // t0, parameter index 4 (descriptor table)
+  };
+
+  // Opaque (depth write)
+  ComPtr<ID3D12PipelineState> mesh_pso;
+  PipelineStateBuilder pso_builder;
+  pso_builder.SetVertexShader(vs)
+    .SetPixelShader(ps)
+    .SetInputLayout(input_layout.data(), static_cast<UINT>(input_layout.size()))
+    .SetRootSignature(mesh_root_signature.Get())
+    .SetPrimitiveTopologyType(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE)
+    .SetRenderTargetFormat(DXGI_FORMAT_R8G8B8A8_UNORM)
+    .SetDepthStencilFormat(DXGI_FORMAT_D32_FLOAT)
+    .SetDepthEnable(true)
+    .SetDepthWriteMask(D3D12_DEPTH_WRITE_MASK_ALL)
+    .SetDepthFunc(D3D12_COMPARISON_FUNC_LESS_EQUAL)
+    .SetBlendEnable(false, 0);
+
+  if (!pso_builder.Build(gfx.GetDevice(), mesh_pso)) {
+    std::cerr << "[FrameworkDefaultAssets] Failed to create MeshCookedOpaque PSO" << '\n';
+    return;
+  }
+
+  mesh_cooked_opaque_template_ =
+    material_mgr.CreateTemplate("MeshCookedOpaque", mesh_pso.Get(), mesh_root_signature.Get(), mesh_texture_slots);
+  if (!mesh_cooked_opaque_template_) {
+    return;
+  }
+  if (bindless) {
+    mesh_cooked_opaque_template_->SetBindless(kSpriteTextureRootIndex, kSpriteTextureIndexRootIndex);
+  }
+  mesh_cooked_opaque_template_->SetPositionDequantization(dequantization_root_index);
+
+  mesh_cooked_opaque_material_ = material_mgr.CreateInstance(kMeshCookedOpaqueInstance, mesh_cooked_opaque_template_);
+  if (mesh_cooked_opaque_material_) {
+    mesh_cooked_opaque_material_->SetTexture("BaseColor", white_texture_);
+    std::cout << "[FrameworkDefaultAssets] Created MeshCookedOpaque material" << '\n';
+  }
+}
+
 void FrameworkDefaultAssets::CreateDebugLineMaterials(Graphic& gfx) {
   auto& shader_mgr = gfx.GetShaderManager();
   auto& material_mgr = gfx.GetMaterialManager();
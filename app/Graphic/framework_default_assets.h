@@ -34,6 +34,7 @@ class FrameworkDefaultAssets {
   MaterialInstance* GetSpriteWorldOpaqueMaterial() const;
   MaterialInstance* GetSpriteWorldTransparentMaterial() const;
   MaterialInstance* GetSpriteUIMaterial() const;
+  MaterialInstance* GetMeshCookedOpaqueMaterial() const;  // Meshes from Mesh::LoadCooked (may be null)
   MaterialTemplate* GetDebugLineTemplateOverlay() const;
   MaterialTemplate* GetDebugLineTemplateDepth() const;
   MaterialInstance* GetDebugLineMaterialOverlay() const;
@@ -55,6 +56,7 @@ class FrameworkDefaultAssets {
   MaterialTemplate* sprite_world_opaque_template_ = nullptr;
   MaterialTemplate* sprite_world_transparent_template_ = nullptr;
   MaterialTemplate* sprite_ui_template_ = nullptr;
+  MaterialTemplate* mesh_cooked_opaque_template_ = nullptr;
 
   MaterialTemplate* debug_line_template_overlay_ = nullptr;
   MaterialTemplate* debug_line_template_depth_ = nullptr;
@@ -63,11 +65,13 @@ class FrameworkDefaultAssets {
   MaterialInstance* sprite_world_opaque_material_ = nullptr;
   MaterialInstance* sprite_world_transparent_material_ = nullptr;
   MaterialInstance* sprite_ui_material_ = nullptr;
+  MaterialInstance* mesh_cooked_opaque_material_ = nullptr;
   MaterialInstance* debug_line_material_overlay_ = nullptr;
   MaterialInstance* debug_line_material_depth_ = nullptr;
 
   // Internal helper methods
   void CreateDefaultMaterials(Graphic& gfx);
   void CreateSpriteMaterials(Graphic& gfx);
+  void CreateMeshMaterials(Graphic& gfx);
   void CreateDebugLineMaterials(Graphic& gfx);
 };
@@ -0,0 +1,301 @@
+#include "gpu_memory_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+#include "deferred_release_queue.h"
+#include "fence_manager.h"
+
+namespace {
+constexpr uint64_t kSmallBufferAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+constexpr const char* kPoolNames[] = {"Default buffers", "Upload buffers", "Textures", "Small upload buffers"};
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+bool GpuMemoryAllocator::Initialize(ID3D12Device* device,
+  const FenceManager* fence_manager,
+  DeferredReleaseQueue* release_queue,
+  uint64_t page_size,
+  uint64_t small_buffer_page_size) {
+  assert(device != nullptr);
+  assert(page_size % D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT == 0);
+
+  device_ = device;
+  fence_manager_ = fence_manager;
+  release_queue_ = release_queue;
+
+  PoolState& default_buffers = GetPool(Pool::DefaultBuffers);
+  default_buffers.heap_type = D3D12_HEAP_TYPE_DEFAULT;
+  default_buffers.heap_flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+  default_buffers.placer.Initialize(page_size);
+
+  PoolState& upload_buffers = GetPool(Pool::UploadBuffers);
+  upload_buffers.heap_type = D3D12_HEAP_TYPE_UPLOAD;
+  upload_buffers.heap_flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+  upload_buffers.placer.Initialize(page_size);
+
+  PoolState& textures = GetPool(Pool::Textures);
+  textures.heap_type = D3D12_HEAP_TYPE_DEFAULT;
+  textures.heap_flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+  textures.placer.Initialize(page_size);
+
+  PoolState& small_buffers = GetPool(Pool::SmallUploadBuffers);
+  small_buffers.heap_type = D3D12_HEAP_TYPE_UPLOAD;
+  small_buffers.placer.Initialize(small_buffer_page_size);
+
+  return true;
+}
+
+bool GpuMemoryAllocator::SelectPool(D3D12_HEAP_TYPE heap_type, const D3D12_RESOURCE_DESC& desc, Pool& out_pool) {
+  if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+    if (heap_type == D3D12_HEAP_TYPE_DEFAULT) {
+      out_pool = Pool::DefaultBuffers;
+      return true;
+    }
+    if (heap_type == D3D12_HEAP_TYPE_UPLOAD) {
+      out_pool = Pool::UploadBuffers;
+      return true;
+    }
+    return false;
+  }
+
+  // RT / DS textures get their own committed allocation (drivers can apply compression / dedicated memory)
+  const D3D12_RESOURCE_FLAGS rt_ds = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+  if (heap_type == D3D12_HEAP_TYPE_DEFAULT && (desc.Flags & rt_ds) == 0 && desc.SampleDesc.Count == 1) {
+    out_pool = Pool::Textures;
+    return true;
+  }
+  return false;
+}
+
+bool GpuMemoryAllocator::CreateResource(D3D12_HEAP_TYPE heap_type,
+  const D3D12_RESOURCE_DESC& desc,
+  D3D12_RESOURCE_STATES initial_state,
+  ComPtr<ID3D12Resource>& out_resource,
+  Allocation& out_allocation) {
+  assert(device_ != nullptr);
+  out_allocation = {};
+
+  Pool pool = Pool::Count;
+  if (SelectPool(heap_type, desc, pool)) {
+    D3D12_RESOURCE_DESC placed_desc = desc;
+    D3D12_RESOURCE_ALLOCATION_INFO info = {};
+
+    // Small textures can use 4KB placement; the runtime reports whether this desc qualifies
+    if (pool == Pool::Textures) {
+      placed_desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+      info = device_->GetResourceAllocationInfo(0, 1, &placed_desc);
+      if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT) {
+        placed_desc.Alignment = 0;
+        info = device_->GetResourceAllocationInfo(0, 1, &placed_desc);
+      }
+    } else {
+      info = device_->GetResourceAllocationInfo(0, 1, &placed_desc);
+    }
+
+    if (info.SizeInBytes != UINT64_MAX) {
+      Allocation allocation;
+      ComPtr<ID3D12Heap> heap;
+      {
+        // Copy the heap reference under the lock (the page array can grow on another thread)
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (Place(pool, info.SizeInBytes, info.Alignment, allocation)) {
+          heap = GetPool(pool).heaps[allocation.range.page];
+        }
+      }
+
+      if (heap != nullptr) {
+        HRESULT hr = device_->CreatePlacedResource(heap.Get(),
+          allocation.range.offset,
+          &placed_desc,
+          initial_state,
+          nullptr,
+          IID_PPV_ARGS(out_resource.ReleaseAndGetAddressOf()));
+
+        if (SUCCEEDED(hr)) {
+          out_allocation = allocation;
+          return true;
+        }
+
+        // Nothing referenced the range yet, so it can go back right away
+        std::cerr << "[GpuMemoryAllocator] CreatePlacedResource failed (hr=0x" << std::hex << hr << std::dec
+                  << "), falling back to committed" << '\n';
+        std::lock_guard<std::mutex> lock(mutex_);
+        FreeNow(allocation);
+      }
+    }
+  }
+
+  D3D12_HEAP_PROPERTIES heap_props = {};
+  heap_props.Type = heap_type;
+
+  HRESULT hr = device_->CreateCommittedResource(
+    &heap_props, D3D12_HEAP_FLAG_NONE, &desc, initial_state, nullptr, IID_PPV_ARGS(out_resource.ReleaseAndGetAddressOf()));
+  if (FAILED(hr)) {
+    std::cerr << "[GpuMemoryAllocator] CreateCommittedResource failed (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++committed_count_;
+  return true;
+}
+
+bool GpuMemoryAllocator::AllocateSmallUploadBuffer(uint64_t size, uint64_t alignment, SubBuffer& out_buffer, Allocation& out_allocation) {
+  assert(device_ != nullptr);
+  out_allocation = {};
+
+  if (size == 0 || size > SMALL_BUFFER_THRESHOLD) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Allocation allocation;
+  if (!Place(Pool::SmallUploadBuffers, AlignUp(size, kSmallBufferAlignment), (std::max)(alignment, kSmallBufferAlignment), allocation)) {
+    return false;
+  }
+
+  const PoolState& state = GetPool(Pool::SmallUploadBuffers);
+  const uint32_t page = allocation.range.page;
+  out_buffer.resource = state.buffers[page].Get();
+  out_buffer.offset = allocation.range.offset;
+  out_buffer.cpu = state.mapped[page] + allocation.range.offset;
+  out_buffer.gpu = state.buffers[page]->GetGPUVirtualAddress() + allocation.range.offset;
+  out_allocation = allocation;
+  return true;
+}
+
+void GpuMemoryAllocator::Free(const Allocation& allocation) {
+  if (!allocation.IsValid()) {
+    return;
+  }
+
+  if (release_queue_ == nullptr || fence_manager_ == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeNow(allocation);
+    return;
+  }
+
+  release_queue_->Enqueue(fence_manager_->GetCurrentFenceValue(), [this, allocation]() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeNow(allocation);
+  });
+}
+
+bool GpuMemoryAllocator::Place(Pool pool, uint64_t size, uint64_t alignment, Allocation& out_allocation) {
+  PoolState& state = GetPool(pool);
+
+  bool new_page = false;
+  const PagedRangeAllocator::Allocation range = state.placer.Allocate(size, alignment, new_page);
+  if (!range.IsValid()) {
+    return false;
+  }
+
+  out_allocation.pool = pool;
+  out_allocation.range = range;
+
+  if (new_page && !CreatePage(state, pool, range.page)) {
+    state.placer.Free(range, true);
+    out_allocation = {};
+    return false;
+  }
+
+  ++state.placed_count;
+  return true;
+}
+
+bool GpuMemoryAllocator::CreatePage(PoolState& state, Pool pool, uint32_t page) {
+  const uint32_t slot_count = state.placer.GetPageSlotCount();
+  state.heaps.resize(slot_count);
+  state.buffers.resize(slot_count);
+  state.mapped.resize(slot_count, nullptr);
+
+  const uint64_t page_size = AlignUp(state.placer.GetPageSize(page), D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+  D3D12_HEAP_PROPERTIES heap_props = {};
+  heap_props.Type = state.heap_type;
+
+  if (pool == Pool::SmallUploadBuffers) {
+    D3D12_RESOURCE_DESC buffer_desc = {};
+    buffer_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    buffer_desc.Width = page_size;
+    buffer_desc.Height = 1;
+    buffer_desc.DepthOrArraySize = 1;
+    buffer_desc.MipLevels = 1;
+    buffer_desc.Format = DXGI_FORMAT_UNKNOWN;
+    buffer_desc.SampleDesc.Count = 1;
+    buffer_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    HRESULT hr = device_->CreateCommittedResource(&heap_props,
+      D3D12_HEAP_FLAG_NONE,
+      &buffer_desc,
+      D3D12_RESOURCE_STATE_GENERIC_READ,
+      nullptr,
+      IID_PPV_ARGS(state.buffers[page].ReleaseAndGetAddressOf()));
+    if (FAILED(hr)) {
+      std::cerr << "[GpuMemoryAllocator] Failed to create small buffer page (" << page_size << " bytes)" << '\n';
+      return false;
+    }
+
+    void* mapped = nullptr;
+    hr = state.buffers[page]->Map(0, nullptr, &mapped);
+    if (FAILED(hr)) {
+      std::cerr << "[GpuMemoryAllocator] Failed to map small buffer page" << '\n';
+      state.buffers[page].Reset();
+      return false;
+    }
+    state.mapped[page] = static_cast<uint8_t*>(mapped);
+    return true;
+  }
+
+  D3D12_HEAP_DESC heap_desc = {};
+  heap_desc.SizeInBytes = page_size;
+  heap_desc.Properties = heap_props;
+  heap_desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+  heap_desc.Flags = state.heap_flags;
+
+  HRESULT hr = device_->CreateHeap(&heap_desc, IID_PPV_ARGS(state.heaps[page].ReleaseAndGetAddressOf()));
+  if (FAILED(hr)) {
+    std::cerr << "[GpuMemoryAllocator] Failed to create heap page (" << page_size << " bytes, hr=0x" << std::hex << hr << std::dec << ")"
+              << '\n';
+    return false;
+  }
+  return true;
+}
+
+void GpuMemoryAllocator::FreeNow(const Allocation& allocation) {
+  PoolState& state = GetPool(allocation.pool);
+  const uint32_t released_page = state.placer.Free(allocation.range);
+  if (released_page == PagedRangeAllocator::kInvalidPage) {
+    return;
+  }
+
+  if (state.buffers[released_page] != nullptr && state.mapped[released_page] != nullptr) {
+    state.buffers[released_page]->Unmap(0, nullptr);
+  }
+  state.heaps[released_page].Reset();
+  state.buffers[released_page].Reset();
+  state.mapped[released_page] = nullptr;
+}
+
+void GpuMemoryAllocator::PrintStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::cout << "\n=== GPU Memory Statistics ===" << '\n';
+  for (size_t i = 0; i < pools_.size(); ++i) {
+    const PagedRangeAllocator::Stats stats = pools_[i].placer.GetStats();
+    std::cout << kPoolNames[i] << ": " << stats.page_count << " pages (" << stats.dedicated_page_count << " dedicated), "
+              << stats.allocated_bytes / 1024 << "/" << stats.reserved_bytes / 1024 << " KB in " << stats.allocation_count
+              << " allocations, placed total " << pools_[i].placed_count << '\n';
+    std::cout << "  Free blocks: " << stats.free_block_count << ", largest " << stats.largest_free_block / 1024 << " KB, fragmentation "
+              << std::fixed << std::setprecision(2) << stats.GetFragmentation() << std::defaultfloat << '\n';
+  }
+  std::cout << "Committed fallbacks: " << committed_count_ << '\n';
+  std::cout << "=============================\n" << '\n';
+}
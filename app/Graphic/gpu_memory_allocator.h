@@ -0,0 +1,110 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "paged_range_allocator.h"
+#include "types.h"
+
+class DeferredReleaseQueue;
+class FenceManager;
+
+constexpr uint64_t DEFAULT_GPU_HEAP_PAGE_SIZE = 32ull << 20;
+constexpr uint64_t DEFAULT_SMALL_BUFFER_PAGE_SIZE = 2ull << 20;
+constexpr uint64_t SMALL_BUFFER_THRESHOLD = 64ull << 10;
+
+// GpuMemoryAllocator: Places buffers and textures into large shared ID3D12Heap pages instead of
+// one committed heap per resource. Placement is done by PagedRangeAllocator (one per pool).
+//
+// Pools follow resource heap tier 1 rules (buffers and non-RT/DS textures never share a heap).
+// Small upload buffers (constant / dynamic vertex data) are sub-allocated inside shared, persistently
+// mapped upload buffers, so they do not pay the 64KB placement alignment.
+// Render targets, depth buffers, MSAA and readback resources stay committed.
+//
+// Freed ranges are returned to the pools through the deferred release queue, so memory is only
+// reused once the GPU has passed every frame that could still read it.
+class GpuMemoryAllocator {
+ public:
+  enum class Pool : uint8_t { DefaultBuffers, UploadBuffers, Textures, SmallUploadBuffers, Count };
+
+  struct Allocation {
+    Pool pool = Pool::Count;
+    PagedRangeAllocator::Allocation range = {};
+
+    bool IsValid() const {
+      return range.IsValid();
+    }
+  };
+
+  // Range inside a shared upload buffer (resource is owned by the allocator)
+  struct SubBuffer {
+    ID3D12Resource* resource = nullptr;
+    uint64_t offset = 0;
+    void* cpu = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;
+  };
+
+  GpuMemoryAllocator() = default;
+  ~GpuMemoryAllocator() = default;
+
+  GpuMemoryAllocator(const GpuMemoryAllocator&) = delete;
+  GpuMemoryAllocator& operator=(const GpuMemoryAllocator&) = delete;
+
+  bool Initialize(ID3D12Device* device,
+    const FenceManager* fence_manager,
+    DeferredReleaseQueue* release_queue,
+    uint64_t page_size = DEFAULT_GPU_HEAP_PAGE_SIZE,
+    uint64_t small_buffer_page_size = DEFAULT_SMALL_BUFFER_PAGE_SIZE);
+
+  // Placed resource when the desc qualifies for a pool, committed otherwise (out_allocation stays invalid)
+  bool CreateResource(D3D12_HEAP_TYPE heap_type,
+    const D3D12_RESOURCE_DESC& desc,
+    D3D12_RESOURCE_STATES initial_state,
+    ComPtr<ID3D12Resource>& out_resource,
+    Allocation& out_allocation);
+
+  // Returns false when size is above SMALL_BUFFER_THRESHOLD (use CreateResource instead)
+  bool AllocateSmallUploadBuffer(uint64_t size, uint64_t alignment, SubBuffer& out_buffer, Allocation& out_allocation);
+
+  // Return a range once the GPU is done with the current frame (thread-safe)
+  void Free(const Allocation& allocation);
+
+  void PrintStats() const;
+
+ private:
+  struct PoolState {
+    PagedRangeAllocator placer;
+    D3D12_HEAP_TYPE heap_type = D3D12_HEAP_TYPE_DEFAULT;
+    D3D12_HEAP_FLAGS heap_flags = D3D12_HEAP_FLAG_NONE;
+
+    // Indexed by page id; SmallUploadBuffers uses buffers / mapped instead of heaps
+    std::vector<ComPtr<ID3D12Heap>> heaps;
+    std::vector<ComPtr<ID3D12Resource>> buffers;
+    std::vector<uint8_t*> mapped;
+
+    uint64_t placed_count = 0;
+  };
+
+  ID3D12Device* device_ = nullptr;
+  const FenceManager* fence_manager_ = nullptr;
+  DeferredReleaseQueue* release_queue_ = nullptr;
+
+  mutable std::mutex mutex_;
+  std::array<PoolState, static_cast<size_t>(Pool::Count)> pools_;
+  uint64_t committed_count_ = 0;
+
+  PoolState& GetPool(Pool pool) {
+    return pools_[static_cast<size_t>(pool)];
+  }
+
+  static bool SelectPool(D3D12_HEAP_TYPE heap_type, const D3D12_RESOURCE_DESC& desc, Pool& out_pool);
+
+  // Caller holds mutex_. Creates the backing heap / buffer when placement opened a new page.
+  bool Place(Pool pool, uint64_t size, uint64_t alignment, Allocation& out_allocation);
+  bool CreatePage(PoolState& state, Pool pool, uint32_t page);
+  void FreeNow(const Allocation& allocation);
+};
@@ -1,26 +1,32 @@
 #include "gpu_resource.h"
 
 #include "../utils.h"
+#include "copy_queue.h"
+#include "resource_state_tracker.h"
 
 void GpuResource::TransitionTo(ID3D12GraphicsCommandList* command_list, D3D12_RESOURCE_STATES new_state, UINT subresource) {
+  ResourceStateTracker tracker;
+  tracker.Transition(this, new_state, subresource);
+  tracker.Flush(command_list);
+}
+
+void GpuResource::RequestUploadWait() {
+  pending_upload_queue_->RequireOnDirectQueue(pending_upload_fence_);
+  pending_upload_queue_ = nullptr;
+  pending_upload_fence_ = 0;
+}
+
+UINT GpuResource::GetSubresourceCount() const {
   if (resource_ == nullptr) {
-    return;
+    return 0;
   }
 
-  if (current_state_ == new_state) {
-    return;
+  const D3D12_RESOURCE_DESC desc = resource_->GetDesc();
+  if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+    return 1;
   }
-
-  D3D12_RESOURCE_BARRIER barrier = {};
-  barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-  barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-  barrier.Transition.pResource = resource_.Get();
-  barrier.Transition.Subresource = subresource;
-  barrier.Transition.StateBefore = current_state_;
-  barrier.Transition.StateAfter = new_state;
-
-  command_list->ResourceBarrier(1, &barrier);
-  current_state_ = new_state;
+  const UINT array_size = (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? 1u : desc.DepthOrArraySize;
+  return desc.MipLevels * array_size;
 }
 
 void GpuResource::SetDebugName(const std::string& name) {
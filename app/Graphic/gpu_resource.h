@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
+#include "barrier_batch.h"
 #include "d3d12.h"
 #include "types.h"
 
+class CopyQueue;
+
 class GpuResource {
  public:
   GpuResource() = default;
@@ -16,13 +20,22 @@ class GpuResource {
   GpuResource(GpuResource&&) = default;
   GpuResource& operator=(GpuResource&&) = default;
 
+  // Immediate single transition; prefer batching through ResourceStateTracker on the frame command list
   void TransitionTo(
     ID3D12GraphicsCommandList* command_list, D3D12_RESOURCE_STATES new_state, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
 
+  // Whole-resource state (not meaningful while subresources are in different states)
   D3D12_RESOURCE_STATES GetCurrentState() const {
-    return current_state_;
+    return static_cast<D3D12_RESOURCE_STATES>(tracked_state_.state);
   };
 
+  D3D12_RESOURCE_STATES GetSubresourceState(UINT subresource) const {
+    return static_cast<D3D12_RESOURCE_STATES>(tracked_state_.Get(subresource));
+  }
+
+  // Mips x array slices (planes are not tracked separately)
+  UINT GetSubresourceCount() const;
+
   ID3D12Resource* GetResource() const {
     return resource_.Get();
   };
@@ -38,13 +51,49 @@ class GpuResource {
     return resource_ != nullptr;
   }
 
+  // Call where the direct queue first uses the resource: if a copy queue batch still owes its contents,
+  // the next direct submission waits for it (once; later uses are free)
+  void ResolvePendingUpload() {
+    if (pending_upload_queue_ != nullptr) {
+      RequestUploadWait();
+    }
+  }
+
+  bool HasPendingUpload() const {
+    return pending_upload_queue_ != nullptr;
+  }
+
  protected:
   ComPtr<ID3D12Resource> resource_ = nullptr;
-  D3D12_RESOURCE_STATES current_state_ = D3D12_RESOURCE_STATE_COMMON;
   std::string debug_name;
 
   void SetResource(ComPtr<ID3D12Resource> resource, D3D12_RESOURCE_STATES initial_state) {
     resource_ = resource;
-    current_state_ = initial_state;
+    tracked_state_.Reset(initial_state);
   }
+
+  // Whole resource in state (after creating or re-pointing resource_ directly)
+  void ResetState(D3D12_RESOURCE_STATES state) {
+    tracked_state_.Reset(state);
+  }
+
+ private:
+  friend class ResourceStateTracker;
+  friend class CopyQueue;
+
+  // Whole-resource state, or per-subresource states once they diverged (starts in COMMON)
+  BarrierBatch::TrackedState tracked_state_;
+
+  // Copy queue batch that wrote the resource and has not been waited for by the direct queue yet
+  CopyQueue* pending_upload_queue_ = nullptr;
+  uint64_t pending_upload_fence_ = 0;
+
+  // Copy queue work leaves the resource in COMMON (decay at the end of ExecuteCommandLists)
+  void SetPendingUpload(CopyQueue* copy_queue, uint64_t fence_value) {
+    pending_upload_queue_ = copy_queue;
+    pending_upload_fence_ = fence_value;
+    tracked_state_.Reset(D3D12_RESOURCE_STATE_COMMON);
+  }
+
+  void RequestUploadWait();
 };
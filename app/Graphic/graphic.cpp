@@ -1,30 +1,55 @@
 #include "graphic.h"
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <filesystem>
 #include <iostream>
+#include <thread>
 
 #include "RenderPass/forward_pass.h"
 #include "RenderPass/ui_pass.h"
+#include "profiler.h"
+
+namespace {
+// Written by tools/asset_packer from the working directory (entries like "Content/textures/white.png")
+constexpr const char* kContentArchivePath = "Content.pak";
+// Texture memory up to which released textures stay loaded for reuse
+constexpr uint64_t kTextureMemoryBudget = 512ull << 20;
+}  // namespace
 
 void Graphic::Transition(GpuResource* resource, D3D12_RESOURCE_STATES new_state) {
   if (!resource) return;
-  resource->TransitionTo(command_list_.Get(), new_state);
+  state_tracker_.Transition(resource, new_state);
+}
+
+void Graphic::FlushBarriers() {
+  state_tracker_.Flush(command_list_.Get());
 }
 
 void Graphic::Clear(RenderTarget* rt, const float* clear_color) {
   if (!rt || !clear_color) return;
+  FlushBarriers();
   rt->Clear(command_list_.Get(), clear_color);
 }
 
 void Graphic::Clear(DepthBuffer* depth, float depth_val, uint8_t stencil_val) {
   if (!depth) return;
+  FlushBarriers();
   depth->Clear(command_list_.Get(), depth_val, stencil_val);
 }
 
 void Graphic::RenderPasses() {
+  FlushBarriers();
   render_pass_manager_.RenderFrame(command_list_.Get(), texture_manager_);
 }
 
+void Graphic::ExecutePass(RenderPass* pass) {
+  if (!pass) return;
+  FlushBarriers();
+  render_pass_manager_.ExecutePass(command_list_.Get(), pass, texture_manager_);
+}
+
 bool Graphic::Initialize(HWND hwnd, UINT frame_buffer_width, UINT frame_buffer_height) {
   frame_buffer_width_ = frame_buffer_width;
   frame_buffer_height_ = frame_buffer_height;
@@ -40,19 +65,61 @@ bool Graphic::Initialize(HWND hwnd, UINT frame_buffer_width, UINT frame_buffer_h
     return false;
   }
 
+  // Bindless texture tables need unbounded SRV ranges (resource binding tier 2+)
+  D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+  if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)))) {
+    bindless_supported_ = options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2;
+  }
+
+  // Video memory budget comes from the adapter the device was created on
+  ComPtr<IDXGIAdapter3> adapter;
+  if (FAILED(dxgi_factory_->EnumAdapterByLuid(device_->GetAdapterLuid(), IID_PPV_ARGS(&adapter)))) {
+    adapter = nullptr;
+  }
+  if (!residency_manager_.Initialize(device_.Get(), adapter.Get(), FrameCount)) {
+    MessageBoxW(nullptr, L"Graphic: Failed to initialize residency manager", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
+    return false;
+  }
+
+  // Buffers and textures are placed in shared heap pages; freed ranges retire through release_queue_
+  if (!gpu_memory_allocator_.Initialize(device_.Get(), &fence_manager_, &release_queue_)) {
+    MessageBoxW(nullptr, L"Graphic: Failed to initialize GPU memory allocator", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
+    return false;
+  }
+
   // Initialize primitive geometry 2D
-  primitive_geometry_2d_ = std::make_unique<PrimitiveGeometry2D>(device_.Get());
+  primitive_geometry_2d_ = std::make_unique<PrimitiveGeometry2D>(device_.Get(), &gpu_memory_allocator_);
 
   if (!descriptor_heap_manager_.Initalize(device_.Get(), FrameCount)) {
     MessageBoxW(nullptr, L"Graphic: Failed to initialize descriptor heap manager", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
     return false;
   }
 
+  // Packed content (tools/asset_packer) is optional: without it everything loads from loose files
+  if (std::filesystem::exists(kContentArchivePath) && !asset_archive_.Open(kContentArchivePath)) {
+    std::cerr << "[Graphic] Ignoring unreadable content archive" << '\n';
+  }
+
   // Textures are persistent; allocate their SRVs from the static region.
-  if (!texture_manager_.Initialize(device_.Get(), &descriptor_heap_manager_.GetSrvStaticAllocator(), 1024)) {
+  if (!texture_manager_.Initialize(
+        device_.Get(), &descriptor_heap_manager_.GetSrvStaticAllocator(), &fence_manager_, &release_queue_, 1024)) {
     MessageBoxW(nullptr, L"Graphic: Failed to initialize texture manager", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
     return false;
   }
+  // Material descriptor tables are assembled per frame from CPU-only staging copies of the texture SRVs.
+  texture_manager_.SetDescriptorTableSources(
+    &descriptor_heap_manager_.GetSrvStagingAllocator(), &descriptor_heap_manager_.GetSrvTableRing());
+  texture_manager_.SetGpuMemoryAllocator(&gpu_memory_allocator_);
+  texture_manager_.SetResidencyManager(&residency_manager_);
+  texture_manager_.SetContentDeduplication(true);
+  texture_manager_.SetMemoryBudget(kTextureMemoryBudget);
+  // Material instances hold references on the textures they bind
+  material_manager_.SetTextureManager(&texture_manager_);
+  if (asset_archive_.IsOpen()) {
+    texture_manager_.SetAssetArchive(&asset_archive_);
+    shader_manager_.SetAssetArchive(&asset_archive_);
+    std::cout << "[Graphic] Mounted " << kContentArchivePath << " (" << asset_archive_.GetEntryCount() << " entries)" << '\n';
+  }
 
   if (!CreateCommandQueue()) {
     MessageBoxW(nullptr, L"Graphic: Failed to create command queue", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
@@ -94,13 +161,27 @@ bool Graphic::Initialize(HWND hwnd, UINT frame_buffer_width, UINT frame_buffer_h
     return false;
   }
 
-  // Initialize upload context for one-shot resource uploads
-  if (!upload_context_.Initialize(device_.Get(), command_queue_.Get(), &fence_manager_)) {
-    MessageBoxW(nullptr, L"Graphic: Failed to initialize upload context", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
+  // Uploads run on their own queue and overlap with rendering
+  if (!copy_queue_.Initialize(device_.Get())) {
+    MessageBoxW(nullptr, L"Graphic: Failed to initialize copy queue", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
+    return false;
+  }
+
+  // Engine-wide linear allocator for per-frame constants and dynamic vertices
+  if (!upload_ring_.Initialize(device_.Get(), &fence_manager_, &release_queue_)) {
+    MessageBoxW(nullptr, L"Graphic: Failed to initialize upload ring", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
+    return false;
+  }
+
+  // Asset workers decode images in parallel with the built-in decoders (no per-thread setup)
+  const uint32_t worker_count = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1u;
+  if (!thread_pool_.Initialize(worker_count, "AssetWorker")) {
+    MessageBoxW(nullptr, L"Graphic: Failed to start worker threads", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
     return false;
   }
+  texture_manager_.SetAsyncLoader(&thread_pool_, &copy_queue_);
 
-  if (!render_pass_manager_.Initialize(device_.Get(), FrameCount, upload_context_)) {
+  if (!render_pass_manager_.Initialize(device_.Get(), upload_ring_, copy_queue_)) {
     MessageBoxW(nullptr, L"Graphic: Failed to initialize render pass manager", init_error_caption.c_str(), MB_OK | MB_ICONERROR);
     return false;
   }
@@ -155,24 +236,26 @@ bool Graphic::InitializeRenderPasses() {
   return true;
 }
 
-void Graphic::ExecuteImmediate(const std::function<void(ID3D12GraphicsCommandList*)>& recordFunc) {
-  if (!recordFunc) return;
-  if (!upload_context_.IsInitialized()) return;
+UploadTicket Graphic::Upload(const std::function<void(UploadBatch&)>& recordFunc) {
+  if (!recordFunc) return {};
 
-  upload_context_.Begin();
-  ID3D12GraphicsCommandList* cmd = upload_context_.GetCommandList();
+  PROFILE_SCOPE("Graphic::Upload");
 
-  // Bind descriptor heaps if code recording requires shader-visible heaps
-  descriptor_heap_manager_.SetDescriptorHeaps(cmd);
+  UploadBatch* batch = copy_queue_.Begin();
+  if (batch == nullptr) {
+    return {};
+  }
 
-  // Let caller record commands
-  recordFunc(cmd);
+  // Let caller record copies
+  recordFunc(*batch);
 
-  // Close/execute and wait
-  upload_context_.SubmitAndWait();
+  return copy_queue_.Submit(batch);
 }
 
 void Graphic::BeginFrame() {
+  PROFILE_FRAME_BEGIN();
+  PROFILE_SCOPE("Graphic::BeginFrame");
+
   // Pin the frame index for the entire frame (BeginFrame..EndFrame).
   frame_index_ = swap_chain_manager_.GetCurrentBackBufferIndex();
 
@@ -188,7 +271,26 @@ void Graphic::BeginFrame() {
 #endif
 
   // Wait only for the previous use of this frame slot (not a full GPU flush).
-  fence_manager_.WaitForFenceValue(frame_fence_values_[frame_index_]);
+  {
+    PROFILE_SCOPE("WaitForFrameSlot");
+    fence_manager_.WaitForFenceValue(frame_fence_values_[frame_index_]);
+  }
+
+  // Retire textures / descriptors released while the GPU could still read them
+  {
+    PROFILE_SCOPE("ProcessDeferredReleases");
+    release_queue_.Process(fence_manager_.GetCompletedFenceValue());
+  }
+
+  upload_ring_.BeginFrame();
+
+  // Swap async loads whose upload finished in for their placeholders
+  texture_manager_.ProcessAsyncLoads();
+
+  // Trim cold textures now that the oldest frame using this slot has finished
+  residency_manager_.BeginFrame();
+
+  assert(!state_tracker_.HasPendingBarriers());
 
   // Reset the per-frame allocator and command list for recording.
   command_allocators_[frame_index_]->Reset();
@@ -220,6 +322,7 @@ void Graphic::BeginFrame() {
 void Graphic::RenderFrame() {
   // Execute all render passes through the pass manager
   // The pass manager will handle filtering and executing each pass
+  FlushBarriers();
   render_pass_manager_.RenderFrame(command_list_.Get(), texture_manager_);
 
   // Clear render queue for next frame
@@ -227,34 +330,64 @@ void Graphic::RenderFrame() {
 }
 
 void Graphic::EndFrame() {
-  // Execute command list
-  command_list_->Close();
+  // Close the EndFrame scope before the frame marker so the frame contains it entirely
+  {
+    PROFILE_SCOPE("Graphic::EndFrame");
 
-  std::array<ID3D12CommandList*, 1> cmdlists = {command_list_.Get()};
-  command_queue_->ExecuteCommandLists(static_cast<UINT>(cmdlists.size()), cmdlists.data());
+    // Transitions recorded since the last draw (e.g. back buffer to PRESENT)
+    FlushBarriers();
 
-  // Signal completion for this frame slot (no per-frame flush).
-  const uint64_t signal_value = fence_manager_.GetCurrentFenceValue();
-  fence_manager_.SignalFence(command_queue_.Get());
-  frame_fence_values_[frame_index_] = signal_value;
+    // Descriptor tables referenced by this frame must be in the shader-visible heap before execution
+    descriptor_heap_manager_.FlushDescriptorCopies();
 
-  // Present
-  const UINT sync_interval = vsync_enabled_ ? 1u : 0u;
-  UINT present_flags = 0u;
-  if (!vsync_enabled_ && swap_chain_manager_.IsTearingSupported() && !swap_chain_manager_.IsFullscreenExclusive()) {
-    present_flags |= DXGI_PRESENT_ALLOW_TEARING;
+    // Textures bound this frame while evicted must be back in video memory before execution
+    residency_manager_.MakePendingResident();
+
+    // Uploads first used this frame must have landed before it executes
+    copy_queue_.InsertPendingWait(command_queue_.Get());
+
+    // Execute command list
+    command_list_->Close();
+
+    std::array<ID3D12CommandList*, 1> cmdlists = {command_list_.Get()};
+    command_queue_->ExecuteCommandLists(static_cast<UINT>(cmdlists.size()), cmdlists.data());
+
+    // Signal completion for this frame slot (no per-frame flush).
+    const uint64_t signal_value = fence_manager_.GetCurrentFenceValue();
+    fence_manager_.SignalFence(command_queue_.Get());
+    frame_fence_values_[frame_index_] = signal_value;
+
+    // Present
+    const UINT sync_interval = vsync_enabled_ ? 1u : 0u;
+    UINT present_flags = 0u;
+    if (!vsync_enabled_ && swap_chain_manager_.IsTearingSupported() && !swap_chain_manager_.IsFullscreenExclusive()) {
+      present_flags |= DXGI_PRESENT_ALLOW_TEARING;
+    }
+    {
+      PROFILE_SCOPE("Present");
+      swap_chain_manager_.Present(sync_interval, present_flags);
+    }
   }
-  swap_chain_manager_.Present(sync_interval, present_flags);
+
+  PROFILE_FRAME_END();
 }
 
 void Graphic::Shutdown() {
-  // Wait for GPU to finish all work
+  // Wait for loader jobs (they submit copies), then for the GPU to finish all work
+  thread_pool_.WaitIdle();
+  copy_queue_.WaitIdle();
   fence_manager_.WaitForGpu(command_queue_.Get());
 
   // Print statistics before cleanup
   texture_manager_.PrintStats();
   material_manager_.PrintStats();
   render_pass_manager_.PrintStats();
+  gpu_memory_allocator_.PrintStats();
+  upload_ring_.PrintStats();
+  copy_queue_.PrintStats();
+  state_tracker_.PrintStats();
+  residency_manager_.PrintStats();
+  PROFILE_EXPORT("profile_trace.json");
 
   // Shutdown framework default assets before clearing managers so they can
   // release references into managers during shutdown if needed.
@@ -263,10 +396,13 @@ void Graphic::Shutdown() {
     default_assets_.reset();
   }
 
-  // Clean up managers
+  // GPU is idle (WaitForGpu above), so everything pending can go now
+  release_queue_.Flush();
+
+  // Clean up managers (material instances release their textures first)
   shader_manager_.Clear();
-  texture_manager_.Clear();
   material_manager_.Clear();
+  texture_manager_.Clear();
 
   std::cout << "[Graphic] Shutdown complete" << '\n';
 }
@@ -12,18 +12,25 @@
 #include "RenderPass/forward_pass.h"
 #include "RenderPass/render_pass_manager.h"
 #include "RenderPass/ui_pass.h"
+#include "asset_archive.h"
+#include "copy_queue.h"
 #include "depth_buffer.h"
+#include "deferred_release_queue.h"
 #include "descriptor_heap_manager.h"
 #include "fence_manager.h"
 #include "framework_default_assets.h"
+#include "gpu_memory_allocator.h"
 #include "gpu_resource.h"
 #include "material_manager.h"
 #include "primitive_geometry_2d.h"
+#include "residency_manager.h"
+#include "resource_state_tracker.h"
 #include "shader_manager.h"
 #include "swapchain_manager.h"
 #include "texture_manager.h"
+#include "thread_pool.h"
 #include "types.h"
-#include "upload_context.h"
+#include "upload_ring.h"
 
 class Scene;
 
@@ -39,30 +46,62 @@ class Graphic {
   void Shutdown();
 
   // RenderSystem decides WHEN; Graphic handles HOW (encapsulation).
+  // Transitions are batched; Clear / RenderPasses / EndFrame flush them before recording
   void Transition(GpuResource* resource, D3D12_RESOURCE_STATES new_state);
+  void FlushBarriers();
   void Clear(RenderTarget* rt, const float* clear_color);
   void Clear(DepthBuffer* depth, float depth_val, uint8_t stencil_val);
   void RenderPasses();
+  void ExecutePass(RenderPass* pass);
 
-  // Execute a short-lived command list for one-shot work (uploads, copies)
-  void ExecuteImmediate(const std::function<void(ID3D12GraphicsCommandList*)>& recordFunc);
+  // Record uploads into one copy queue batch and submit it without waiting. Resources written by the batch
+  // can be used right away; the first frame that uses one waits for the batch on the GPU.
+  UploadTicket Upload(const std::function<void(UploadBatch&)>& recordFunc);
 
   void SetVSync(bool enabled) {
     vsync_enabled_ = enabled;
   }
 
-  // Access upload context for one-shot uploads
-  UploadContext& GetUploadContext() {
-    return upload_context_;
+  // Destroy something once the GPU has finished every frame submitted so far (no GPU stall).
+  // Use for resources / descriptors that frames in flight may still reference.
+  void DeferRelease(DeferredReleaseQueue::ReleaseFunc release) {
+    release_queue_.Enqueue(fence_manager_.GetCurrentFenceValue(), std::move(release));
   }
-  const UploadContext& GetUploadContext() const {
-    return upload_context_;
+
+  // Dedicated copy queue for resource uploads (Begin / Submit batches directly for finer control)
+  CopyQueue& GetCopyQueue() {
+    return copy_queue_;
+  }
+
+  // Background workers for asset loading (TextureManager::LoadTextureAsync)
+  ThreadPool& GetThreadPool() {
+    return thread_pool_;
+  }
+
+  // Per-frame dynamic data (constants, debug vertices); allocations are valid until the frame completes
+  UploadRing& GetUploadRing() {
+    return upload_ring_;
+  }
+
+  // Video memory accounting / budget (SetBudgetOverride to simulate a smaller card)
+  ResidencyManager& GetResidencyManager() {
+    return residency_manager_;
   }
 
   RenderPassManager& GetRenderPassManager() {
     return render_pass_manager_;
   }
 
+  // Pass to Buffer::Create / Texture::Create to place resources in shared heaps
+  GpuMemoryAllocator& GetGpuMemoryAllocator() {
+    return gpu_memory_allocator_;
+  }
+
+  // Mounted content archive, or nullptr when content loads from loose files (Mesh::LoadCooked)
+  const AssetArchive* GetAssetArchive() const {
+    return asset_archive_.IsOpen() ? &asset_archive_ : nullptr;
+  }
+
   TextureManager& GetTextureManager() {
     return texture_manager_;
   }
@@ -103,6 +142,11 @@ class Graphic {
     return frame_index_;
   }
 
+  // Whether materials can use the bindless texture model (see MaterialTemplate::SetBindless)
+  bool IsBindlessSupported() const {
+    return bindless_supported_;
+  }
+
   // Barrier helpers (state-tracked wrappers)
   RenderTarget* GetBackBufferRenderTarget() {
     return swap_chain_manager_.GetRenderTarget(frame_index_);
@@ -138,9 +182,18 @@ class Graphic {
   std::array<uint64_t, FrameCount> frame_fence_values_ = {};
   ComPtr<ID3D12GraphicsCommandList> command_list_ = nullptr;
   ComPtr<ID3D12CommandQueue> command_queue_ = nullptr;
+  ResourceStateTracker state_tracker_;  // Pending barriers for command_list_
+
+  // Outlives every resource it uploads (they may still request a wait on release)
+  CopyQueue copy_queue_;
+
+  // Packed content; loader jobs read from it, so it is mapped until the workers are joined
+  AssetArchive asset_archive_;
 
   // Resource management
+  ResidencyManager residency_manager_;  // Outlives texture_manager_ (textures unregister on release)
   DescriptorHeapManager descriptor_heap_manager_;
+  GpuMemoryAllocator gpu_memory_allocator_;  // Outlives release_queue_ (its deferred frees run on flush)
   SwapChainManager swap_chain_manager_;
   DepthBuffer depth_buffer_;
   FenceManager fence_manager_;
@@ -149,11 +202,17 @@ class Graphic {
   ShaderManager shader_manager_;
   std::unique_ptr<PrimitiveGeometry2D> primitive_geometry_2d_;
 
-  // Upload context for one-shot resource uploads
-  UploadContext upload_context_;
+  // Filled pages return through release_queue_, so the ring must outlive it
+  UploadRing upload_ring_;
+
+  // Fence-keyed retirement; declared after the managers it releases into so it is flushed first
+  DeferredReleaseQueue release_queue_;
 
   RenderPassManager render_pass_manager_;
 
+  // Jobs use the texture manager and the copy queue, so the workers are joined first
+  ThreadPool thread_pool_;
+
   // Cached pass pointers for efficient access
   ForwardPass* forward_pass_ = nullptr;
   UIPass* ui_pass_ = nullptr;
@@ -162,6 +221,7 @@ class Graphic {
   UINT frame_buffer_height_ = 0;
 
   bool vsync_enabled_ = true;
+  bool bindless_supported_ = false;
 
   // Viewport and scissor
   D3D12_VIEWPORT viewport_ = {};
@@ -1,6 +1,109 @@
 #include "mesh.h"
 
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
+#include <iostream>
+
+#include "asset_archive.h"
+#include "cooked_mesh.h"
+#include "profiler.h"
+#include "utils.h"
+
+std::shared_ptr<Mesh> Mesh::LoadCooked(ID3D12Device* device,
+  UploadBatch& batch,
+  const std::wstring& filepath,
+  const AssetArchive* archive,
+  GpuMemoryAllocator* memory_allocator) {
+  PROFILE_SCOPE("Mesh::LoadCooked");
+
+  const std::string name = utils::WstringToUtf8(filepath);
+  AssetBlob blob;
+  if (!LoadAsset(archive, std::filesystem::path(filepath), blob)) {
+    std::cerr << "[Mesh] Failed to open cooked mesh: " << name << '\n';
+    return nullptr;
+  }
+  CookedMeshView view;
+  if (!ParseCookedMesh(blob.data, blob.size, view)) {
+    std::cerr << "[Mesh] Invalid cooked mesh: " << name << '\n';
+    return nullptr;
+  }
+  const CookedMeshHeader& header = *view.header;
+  if (header.index_count == 0) {
+    std::cerr << "[Mesh] Cooked mesh has no triangles: " << name << '\n';
+    return nullptr;
+  }
+
+  auto vertex_buffer = Buffer::CreateAndUpload(device,
+    batch,
+    view.vertices,
+    static_cast<size_t>(header.vertex_count) * header.vertex_stride,
+    Buffer::Type::Vertex,
+    name + "_VertexBuffer",
+    memory_allocator);
+  if (!vertex_buffer) {
+    return nullptr;
+  }
+
+  auto index_buffer = Buffer::CreateAndUpload(device,
+    batch,
+    view.indices,
+    static_cast<size_t>(header.index_count) * view.GetIndexSize(),
+    Buffer::Type::Index,
+    name + "_IndexBuffer",
+    memory_allocator);
+  if (!index_buffer) {
+    // The batch holds its own reference to vertex_buffer until the recorded copy completes
+    return nullptr;
+  }
+
+  auto mesh = std::make_shared<Mesh>();
+  mesh->Initialize(vertex_buffer,
+    index_buffer,
+    header.vertex_stride,
+    header.index_count,
+    view.HasIndex32() ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+  mesh->SetDebugName(name);
+  mesh->SetLocalBounds({header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]},
+    {header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]});
+  mesh->SetPositionDequantization({header.position_offset[0], header.position_offset[1], header.position_offset[2]},
+    {header.position_scale[0], header.position_scale[1], header.position_scale[2]});
+
+  std::vector<Section> sections(header.submesh_count);
+  for (uint32_t i = 0; i < header.submesh_count; ++i) {
+    const CookedMeshSubmesh& submesh = view.submeshes[i];
+    sections[i].first_index = submesh.first_index;
+    sections[i].index_count = submesh.index_count;
+    sections[i].base_vertex = static_cast<int32_t>(submesh.base_vertex);
+    sections[i].material_index = submesh.material_index;
+  }
+  mesh->SetSections(std::move(sections));
+
+  std::vector<Section> meshlets;
+  std::vector<MeshletBounds> meshlet_bounds;
+  meshlets.reserve(header.meshlet_count);
+  meshlet_bounds.reserve(header.meshlet_count);
+  for (uint32_t i = 0; i < header.submesh_count; ++i) {
+    const CookedMeshSubmesh& submesh = view.submeshes[i];
+    for (uint32_t m = submesh.first_meshlet; m < submesh.first_meshlet + submesh.meshlet_count; ++m) {
+      const CookedMeshMeshlet& meshlet = view.meshlets[m];
+      Section& section = meshlets.emplace_back();
+      section.first_index = meshlet.first_index;
+      section.index_count = meshlet.triangle_count * 3;
+      section.base_vertex = static_cast<int32_t>(submesh.base_vertex);
+      section.material_index = submesh.material_index;
+
+      MeshletBounds& bounds = meshlet_bounds.emplace_back();
+      std::copy(std::begin(meshlet.center), std::end(meshlet.center), bounds.center);
+      bounds.radius = meshlet.radius;
+      std::copy(std::begin(meshlet.cone_axis), std::end(meshlet.cone_axis), bounds.cone_axis);
+      bounds.cone_cutoff = meshlet.cone_cutoff;
+    }
+  }
+  mesh->SetMeshlets(std::move(meshlets), std::move(meshlet_bounds));
+  return mesh;
+}
 
 void Mesh::Initialize(std::shared_ptr<Buffer> vertex_buffer,
   std::shared_ptr<Buffer> index_buffer,
@@ -25,6 +128,10 @@ void Mesh::Bind(ID3D12GraphicsCommandList* command_list) const {
   assert(command_list != nullptr);
   assert(IsValid());
 
+  // Buffers uploaded on the copy queue make this frame's submission wait for them (first bind only)
+  vertex_buffer_->ResolvePendingUpload();
+  index_buffer_->ResolvePendingUpload();
+
   // Set topology
   command_list->IASetPrimitiveTopology(topology_);
 
@@ -41,5 +148,22 @@ void Mesh::Draw(ID3D12GraphicsCommandList* command_list) const {
   assert(command_list != nullptr);
   assert(IsValid());
 
-  command_list->DrawIndexedInstanced(index_count_, 1, 0, 0, 0);
+  if (sections_.empty()) {
+    command_list->DrawIndexedInstanced(index_count_, 1, 0, 0, 0);
+    return;
+  }
+  Draw(command_list, sections_.data(), static_cast<uint32_t>(sections_.size()));
+}
+
+void Mesh::Draw(ID3D12GraphicsCommandList* command_list, const Section* sections, uint32_t section_count) const {
+  assert(command_list != nullptr);
+  assert(IsValid());
+
+  for (uint32_t i = 0; i < section_count; ++i) {
+    const Section& section = sections[i];
+    assert(section.first_index + section.index_count <= index_count_);
+    if (section.index_count > 0) {
+      command_list->DrawIndexedInstanced(section.index_count, 1, section.first_index, section.base_vertex, 0);
+    }
+  }
 }
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <DirectXMath.h>
 #include <d3d12.h>
 #include <dxgiformat.h>
 
+#include <cassert>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "buffer.h"
+#include "meshlet.h"
+
+class AssetArchive;
+class UploadBatch;
 
 // Simple mesh representation with vertex and index buffers
 class Mesh {
@@ -18,6 +25,24 @@ class Mesh {
   Mesh(const Mesh&) = delete;
   Mesh& operator=(const Mesh&) = delete;
 
+  // Draw range of one submesh; its indices are relative to base_vertex
+  struct Section {
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    int32_t base_vertex = 0;
+    uint32_t material_index = 0;
+  };
+
+  // Load a cooked mesh (.cmsh, tools/mesh_cooker) from archive when it has the entry, otherwise from disk.
+  // The vertex and index blocks are uploaded as stored; each submesh becomes a section and quantized
+  // positions set the dequantization transform, and cooked meshlets become meshlet sections with their
+  // culling bounds. Vertices use GetInputLayout_CookedMeshVertex.
+  static std::shared_ptr<Mesh> LoadCooked(ID3D12Device* device,
+    UploadBatch& batch,
+    const std::wstring& filepath,
+    const AssetArchive* archive = nullptr,
+    GpuMemoryAllocator* memory_allocator = nullptr);
+
   // Initialize with existing buffers
   void Initialize(std::shared_ptr<Buffer> vertex_buffer,
     std::shared_ptr<Buffer> index_buffer,
@@ -29,9 +54,70 @@ class Mesh {
   // Bind mesh for rendering
   void Bind(ID3D12GraphicsCommandList* command_list) const;
 
-  // Draw mesh
+  // Draw mesh (one draw per section, or the whole index buffer when there are none)
   void Draw(ID3D12GraphicsCommandList* command_list) const;
 
+  // Draw only the given ranges of the index buffer (e.g. the meshlets that survived culling)
+  void Draw(ID3D12GraphicsCommandList* command_list, const Section* sections, uint32_t section_count) const;
+
+  void SetSections(std::vector<Section> sections) {
+    sections_ = std::move(sections);
+  }
+
+  const std::vector<Section>& GetSections() const {
+    return sections_;
+  }
+
+  uint32_t GetDrawCount() const {
+    return sections_.empty() ? 1 : static_cast<uint32_t>(sections_.size());
+  }
+
+  // Meshlets: contiguous index ranges (inside the sections) with local-space bounds for per-cluster culling
+  void SetMeshlets(std::vector<Section> meshlets, std::vector<MeshletBounds> bounds) {
+    assert(meshlets.size() == bounds.size());
+    meshlets_ = std::move(meshlets);
+    meshlet_bounds_ = std::move(bounds);
+  }
+
+  bool HasMeshlets() const {
+    return !meshlets_.empty();
+  }
+
+  const std::vector<Section>& GetMeshlets() const {
+    return meshlets_;
+  }
+
+  const std::vector<MeshletBounds>& GetMeshletBounds() const {
+    return meshlet_bounds_;
+  }
+
+  // Positions stored quantized: local = offset + position * scale. Templates that take the dequantization as
+  // root constants get offset and scale directly; otherwise the renderer folds this into the world matrix.
+  // Either way the bounds and occluder geometry stay in local space.
+  void SetPositionDequantization(const DirectX::XMFLOAT3& offset, const DirectX::XMFLOAT3& scale) {
+    position_offset_ = offset;
+    position_scale_ = scale;
+    has_position_dequantization_ = true;
+  }
+
+  bool HasPositionDequantization() const {
+    return has_position_dequantization_;
+  }
+
+  const DirectX::XMFLOAT3& GetPositionOffset() const {
+    return position_offset_;
+  }
+
+  const DirectX::XMFLOAT3& GetPositionScale() const {
+    return position_scale_;
+  }
+
+  // Row-vector matrix taking stored positions to local space
+  DirectX::XMMATRIX GetPositionDequantizationMatrix() const {
+    return DirectX::XMMatrixMultiply(DirectX::XMMatrixScaling(position_scale_.x, position_scale_.y, position_scale_.z),
+      DirectX::XMMatrixTranslation(position_offset_.x, position_offset_.y, position_offset_.z));
+  }
+
   // Getters
   uint32_t GetIndexCount() const {
     return index_count_;
@@ -57,6 +143,44 @@ class Mesh {
     return debug_name_;
   }
 
+  // Local-space AABB used for CPU culling
+  void SetLocalBounds(const DirectX::XMFLOAT3& bounds_min, const DirectX::XMFLOAT3& bounds_max) {
+    bounds_min_ = bounds_min;
+    bounds_max_ = bounds_max;
+    has_bounds_ = true;
+  }
+
+  bool HasLocalBounds() const {
+    return has_bounds_;
+  }
+
+  const DirectX::XMFLOAT3& GetLocalBoundsMin() const {
+    return bounds_min_;
+  }
+
+  const DirectX::XMFLOAT3& GetLocalBoundsMax() const {
+    return bounds_max_;
+  }
+
+  // Optional CPU-side triangle list rasterized when this mesh is used as an occluder.
+  // Should be a simplified shape that never covers more than the rendered mesh.
+  void SetOccluderGeometry(std::vector<DirectX::XMFLOAT3> positions, std::vector<uint32_t> indices) {
+    occluder_positions_ = std::move(positions);
+    occluder_indices_ = std::move(indices);
+  }
+
+  bool HasOccluderGeometry() const {
+    return !occluder_positions_.empty() && !occluder_indices_.empty();
+  }
+
+  const std::vector<DirectX::XMFLOAT3>& GetOccluderPositions() const {
+    return occluder_positions_;
+  }
+
+  const std::vector<uint32_t>& GetOccluderIndices() const {
+    return occluder_indices_;
+  }
+
  private:
   std::shared_ptr<Buffer> vertex_buffer_;
   std::shared_ptr<Buffer> index_buffer_;
@@ -67,4 +191,19 @@ class Mesh {
   D3D_PRIMITIVE_TOPOLOGY topology_ = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
   std::string debug_name_;
+
+  std::vector<Section> sections_;
+  std::vector<Section> meshlets_;
+  std::vector<MeshletBounds> meshlet_bounds_;
+
+  DirectX::XMFLOAT3 position_offset_ = {0.0f, 0.0f, 0.0f};
+  DirectX::XMFLOAT3 position_scale_ = {1.0f, 1.0f, 1.0f};
+  bool has_position_dequantization_ = false;
+
+  DirectX::XMFLOAT3 bounds_min_ = {0.0f, 0.0f, 0.0f};
+  DirectX::XMFLOAT3 bounds_max_ = {0.0f, 0.0f, 0.0f};
+  bool has_bounds_ = false;
+
+  std::vector<DirectX::XMFLOAT3> occluder_positions_;
+  std::vector<uint32_t> occluder_indices_;
 };
@@ -0,0 +1,93 @@
+#include "mesh_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace DirectX;
+
+bool MeshLOD::AddLevel(std::shared_ptr<Mesh> mesh, float min_screen_size) {
+  if (mesh == nullptr || !mesh->IsValid()) {
+    std::cerr << "[MeshLOD] Invalid mesh for level " << level_count_ << '\n';
+    return false;
+  }
+
+  if (level_count_ >= kMaxLevels) {
+    std::cerr << "[MeshLOD] Too many levels (max " << kMaxLevels << ")" << '\n';
+    return false;
+  }
+
+  if (level_count_ > 0 && min_screen_size >= levels_[level_count_ - 1].min_screen_size) {
+    std::cerr << "[MeshLOD] Level thresholds must be strictly decreasing" << '\n';
+    return false;
+  }
+
+  if (level_count_ == 0 && !mesh->HasLocalBounds()) {
+    std::cerr << "[MeshLOD] Warning: Level 0 mesh '" << mesh->GetDebugName() << "' has no local bounds, LOD 0 will always be used"
+              << '\n';
+  }
+
+  levels_[level_count_].mesh = std::move(mesh);
+  levels_[level_count_].min_screen_size = min_screen_size;
+  ++level_count_;
+  return true;
+}
+
+uint32_t MeshLOD::SelectLevel(float screen_size, uint32_t current_level, float hysteresis) const {
+  if (level_count_ <= 1) {
+    return 0;
+  }
+
+  current_level = (std::min)(current_level, level_count_ - 1);
+
+  // Target level without hysteresis: finest level whose threshold is met
+  uint32_t level = level_count_ - 1;
+  for (uint32_t i = 0; i < level_count_ - 1; ++i) {
+    if (screen_size >= levels_[i].min_screen_size) {
+      level = i;
+      break;
+    }
+  }
+
+  // Refining: the threshold must be exceeded by the hysteresis margin
+  while (level < current_level && screen_size < levels_[level].min_screen_size * (1.0f + hysteresis)) {
+    ++level;
+  }
+
+  // Coarsening: the size must drop below the threshold by the hysteresis margin
+  while (level > current_level && screen_size >= levels_[level - 1].min_screen_size * (1.0f - hysteresis)) {
+    --level;
+  }
+
+  return level;
+}
+
+float MeshLOD::ComputeScreenSize(const XMFLOAT4X4& world, const XMMATRIX& view_proj, const XMMATRIX& proj) const {
+  const Mesh* base = GetMesh(0);
+  if (base == nullptr || !base->HasLocalBounds()) {
+    return (std::numeric_limits<float>::max)();
+  }
+
+  const XMVECTOR bounds_min = XMLoadFloat3(&base->GetLocalBoundsMin());
+  const XMVECTOR bounds_max = XMLoadFloat3(&base->GetLocalBoundsMax());
+  const XMVECTOR local_center = XMVectorScale(XMVectorAdd(bounds_min, bounds_max), 0.5f);
+  const float local_radius = XMVectorGetX(XMVector3Length(XMVectorSubtract(bounds_max, local_center)));
+
+  const XMMATRIX world_matrix = XMLoadFloat4x4(&world);
+  const float scale_x = XMVectorGetX(XMVector3Length(world_matrix.r[0]));
+  const float scale_y = XMVectorGetX(XMVector3Length(world_matrix.r[1]));
+  const float scale_z = XMVectorGetX(XMVector3Length(world_matrix.r[2]));
+  const float radius = local_radius * (std::max)({scale_x, scale_y, scale_z});
+
+  const XMVECTOR clip_center = XMVector4Transform(XMVectorSetW(XMVector3Transform(local_center, world_matrix), 1.0f), view_proj);
+  const float w = XMVectorGetW(clip_center);
+  if (w <= 1e-4f) {
+    return (std::numeric_limits<float>::max)();
+  }
+
+  // NDC radius = radius * proj._22 / w, and the screen is 2 NDC units tall, so this is diameter / screen height
+  XMFLOAT4X4 proj_values;
+  XMStoreFloat4x4(&proj_values, proj);
+  return radius * std::fabs(proj_values._22) / w;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "mesh.h"
+
+// MeshLOD: Up to kMaxLevels meshes of decreasing detail with screen-size switch thresholds.
+// Screen size is the projected bounding-sphere diameter as a fraction of the viewport height
+// (1.0 when the sphere spans the screen vertically).
+class MeshLOD {
+ public:
+  static constexpr uint32_t kMaxLevels = 4;  // Fits the 2-bit LOD field of the sort key
+
+  MeshLOD() = default;
+  ~MeshLOD() = default;
+
+  MeshLOD(const MeshLOD&) = delete;
+  MeshLOD& operator=(const MeshLOD&) = delete;
+
+  // Add the next (coarser) level. It is used while screen size >= min_screen_size.
+  // Thresholds must be strictly decreasing; the last level is used below every threshold.
+  bool AddLevel(std::shared_ptr<Mesh> mesh, float min_screen_size);
+
+  // Pick a level for the given screen size. Hysteresis widens each threshold by the given
+  // fraction in the direction away from current_level, so objects near a boundary do not pop.
+  uint32_t SelectLevel(float screen_size, uint32_t current_level, float hysteresis = 0.1f) const;
+
+  // Bounding sphere from level 0 local bounds, scaled by the largest axis of world
+  // and projected with view_proj. Returns a large value when the center is behind the camera.
+  float ComputeScreenSize(const DirectX::XMFLOAT4X4& world, const DirectX::XMMATRIX& view_proj, const DirectX::XMMATRIX& proj) const;
+
+  Mesh* GetMesh(uint32_t level) const {
+    return level < level_count_ ? levels_[level].mesh.get() : nullptr;
+  }
+
+  uint32_t GetLevelCount() const {
+    return level_count_;
+  }
+
+  float GetMinScreenSize(uint32_t level) const {
+    return level < level_count_ ? levels_[level].min_screen_size : 0.0f;
+  }
+
+ private:
+  struct Level {
+    std::shared_ptr<Mesh> mesh;
+    float min_screen_size = 0.0f;
+  };
+
+  std::array<Level, kMaxLevels> levels_{};
+  uint32_t level_count_ = 0;
+};
@@ -3,13 +3,13 @@
 #include <array>
 
 #include "buffer.h"
-#include "upload_context.h"
 #include "vertex_types.h"
 
-PrimitiveGeometry2D::PrimitiveGeometry2D(ID3D12Device* device) : device_(device) {
+PrimitiveGeometry2D::PrimitiveGeometry2D(ID3D12Device* device, GpuMemoryAllocator* memory_allocator)
+    : device_(device), memory_allocator_(memory_allocator) {
 }
 
-std::shared_ptr<Mesh> PrimitiveGeometry2D::CreateRect(UploadContext& upload_context) {
+std::shared_ptr<Mesh> PrimitiveGeometry2D::CreateRect(UploadBatch& batch) {
   using V = VertexPositionTexture2D;
 
   // Rectangle centered at origin with extents [-0.5, 0.5]
@@ -22,21 +22,30 @@ std::shared_ptr<Mesh> PrimitiveGeometry2D::CreateRect(UploadContext& upload_cont
 
   std::array<uint16_t, 6> indices = {0, 1, 2, 0, 2, 3};
 
-  auto vertex_buffer = Buffer::CreateAndUploadToDefaultHeapForInit(
-    device_, upload_context, vertices.data(), sizeof(vertices), Buffer::Type::Vertex, "Rect2D_VertexBuffer");
+  auto vertex_buffer = Buffer::CreateAndUpload(
+    device_, batch, vertices.data(), sizeof(vertices), Buffer::Type::Vertex, "Rect2D_VertexBuffer", memory_allocator_);
   if (!vertex_buffer) {
     return nullptr;
   }
 
-  auto index_buffer = Buffer::CreateAndUploadToDefaultHeapForInit(
-    device_, upload_context, indices.data(), sizeof(indices), Buffer::Type::Index, "Rect2D_IndexBuffer");
+  auto index_buffer = Buffer::CreateAndUpload(
+    device_, batch, indices.data(), sizeof(indices), Buffer::Type::Index, "Rect2D_IndexBuffer", memory_allocator_);
   if (!index_buffer) {
+    // The batch holds its own reference to vertex_buffer until the recorded copy completes
     return nullptr;
   }
 
   auto mesh = std::make_shared<Mesh>();
   mesh->Initialize(vertex_buffer, index_buffer, sizeof(V), 6, DXGI_FORMAT_R16_UINT, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
   mesh->SetDebugName("Rect2D");
+  mesh->SetLocalBounds({-0.5f, -0.5f, 0.0f}, {0.5f, 0.5f, 0.0f});
+
+  // The quad itself is the occluder shape (only used when a renderer opts in)
+  std::vector<DirectX::XMFLOAT3> occluder_positions;
+  for (const V& v : vertices) {
+    occluder_positions.push_back(v.position);
+  }
+  mesh->SetOccluderGeometry(std::move(occluder_positions), {0, 1, 2, 0, 2, 3});
 
   return mesh;
 }
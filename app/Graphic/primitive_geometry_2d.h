@@ -6,15 +6,17 @@
 
 #include "mesh.h"
 
-class UploadContext;
+class GpuMemoryAllocator;
+class UploadBatch;
 
 class PrimitiveGeometry2D {
  public:
-  explicit PrimitiveGeometry2D(ID3D12Device* device);
+  explicit PrimitiveGeometry2D(ID3D12Device* device, GpuMemoryAllocator* memory_allocator = nullptr);
 
-  // Create a unit quad in NDC/world space for 2D sprites
-  std::shared_ptr<Mesh> CreateRect(UploadContext& upload_context);
+  // Create a unit quad in NDC/world space for 2D sprites (uploaded by batch; the caller submits it)
+  std::shared_ptr<Mesh> CreateRect(UploadBatch& batch);
 
  private:
   ID3D12Device* device_;
+  GpuMemoryAllocator* memory_allocator_;
 };
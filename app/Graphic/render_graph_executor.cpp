@@ -0,0 +1,71 @@
+#include "render_graph_executor.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "gpu_resource.h"
+#include "graphic.h"
+#include "profiler.h"
+
+void RenderGraphExecutor::Reset(RenderGraph& graph) {
+  graph.Reset();
+  resources_.clear();
+}
+
+RenderGraph::Resource RenderGraphExecutor::Import(
+  RenderGraph& graph, const std::string& name, GpuResource* resource, RenderGraph::Access final_access) {
+  const RenderGraph::Resource handle = graph.Import(name, final_access);
+  if (resources_.size() <= handle) {
+    resources_.resize(handle + 1, nullptr);
+  }
+  resources_[handle] = resource;
+  return handle;
+}
+
+bool RenderGraphExecutor::Execute(RenderGraph& graph, Graphic& graphic) {
+  PROFILE_SCOPE("RenderGraph::Execute");
+
+  if (!graph.Compile()) {
+    std::cerr << "[RenderGraphExecutor] Frame graph failed to compile; skipping it" << '\n';
+    return false;
+  }
+  if (graph.GetStats().transient_bytes > 0) {
+    std::cerr << "[RenderGraphExecutor] Transient resources are not supported yet; skipping frame graph" << '\n';
+    return false;
+  }
+
+  graph.Execute([this, &graphic](std::span<const RenderGraph::Barrier> barriers) {
+    for (const RenderGraph::Barrier& barrier : barriers) {
+      assert(barrier.type == RenderGraph::Barrier::Type::Transition);
+      // "before" is not needed: the tracker knows the resource's actual state
+      GpuResource* resource = (barrier.resource < resources_.size()) ? resources_[barrier.resource] : nullptr;
+      graphic.Transition(resource, ToResourceState(barrier.after));
+    }
+    graphic.FlushBarriers();
+  });
+  return true;
+}
+
+D3D12_RESOURCE_STATES RenderGraphExecutor::ToResourceState(RenderGraph::Access access) {
+  switch (access) {
+    case RenderGraph::Access::None:
+      return D3D12_RESOURCE_STATE_COMMON;
+    case RenderGraph::Access::RenderTarget:
+      return D3D12_RESOURCE_STATE_RENDER_TARGET;
+    case RenderGraph::Access::DepthWrite:
+      return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    case RenderGraph::Access::DepthRead:
+      return D3D12_RESOURCE_STATE_DEPTH_READ;
+    case RenderGraph::Access::ShaderRead:
+      return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    case RenderGraph::Access::UnorderedAccess:
+      return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    case RenderGraph::Access::CopySource:
+      return D3D12_RESOURCE_STATE_COPY_SOURCE;
+    case RenderGraph::Access::CopyDest:
+      return D3D12_RESOURCE_STATE_COPY_DEST;
+    case RenderGraph::Access::Present:
+      return D3D12_RESOURCE_STATE_PRESENT;
+  }
+  return D3D12_RESOURCE_STATE_COMMON;
+}
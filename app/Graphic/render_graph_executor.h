@@ -0,0 +1,36 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <string>
+#include <vector>
+
+#include "render_graph.h"
+
+class GpuResource;
+class Graphic;
+
+// RenderGraphExecutor: D3D12 backend for RenderGraph. Maps graph handles to GpuResources and graph
+// accesses to resource states. Each pass's barriers go through Graphic's state tracker and are flushed
+// as one batch before the pass records.
+//
+// Transient resources are not realized yet (every current pass draws into imported targets), so a
+// graph that keeps a transient alive is rejected.
+class RenderGraphExecutor {
+ public:
+  RenderGraphExecutor() = default;
+
+  // Start a new frame graph
+  void Reset(RenderGraph& graph);
+
+  RenderGraph::Resource Import(
+    RenderGraph& graph, const std::string& name, GpuResource* resource, RenderGraph::Access final_access = RenderGraph::Access::None);
+
+  // Compile and run; returns false (nothing recorded) when the graph does not compile
+  bool Execute(RenderGraph& graph, Graphic& graphic);
+
+  static D3D12_RESOURCE_STATES ToResourceState(RenderGraph::Access access);
+
+ private:
+  std::vector<GpuResource*> resources_;  // Indexed by graph resource handle
+};
@@ -0,0 +1,131 @@
+#include "residency_manager.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "profiler.h"
+
+bool ResidencyManager::Initialize(ID3D12Device* device, IDXGIAdapter3* adapter, uint32_t min_idle_frames, uint64_t budget_override) {
+  assert(device != nullptr);
+
+  device_ = device;
+  adapter_ = adapter;
+  min_idle_frames_ = min_idle_frames;
+  budget_override_ = budget_override;
+
+  if (adapter_ == nullptr && budget_override_ == 0) {
+    std::cout << "[ResidencyManager] No adapter budget available; residency is tracked but never trimmed" << '\n';
+  }
+  return true;
+}
+
+ResidencyManager::Handle ResidencyManager::Register(ID3D12Pageable* pageable, uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Handle handle = policy_.Register(size, pageable == nullptr);
+  if (pageables_.size() <= handle) {
+    pageables_.resize(handle + 1, nullptr);
+  }
+  pageables_[handle] = pageable;
+  return handle;
+}
+
+void ResidencyManager::Unregister(Handle handle) {
+  if (handle == kInvalidHandle) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // May still be waiting to be restored: drop it so a released object is never passed to MakeResident
+  if (pageables_[handle] != nullptr) {
+    std::erase(pending_resident_, pageables_[handle]);
+  }
+  policy_.Unregister(handle);
+  pageables_[handle] = nullptr;
+}
+
+void ResidencyManager::Touch(Handle handle) {
+  if (handle == kInvalidHandle) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (policy_.Touch(handle)) {
+    pending_resident_.push_back(pageables_[handle]);
+  }
+}
+
+void ResidencyManager::BeginFrame() {
+  PROFILE_SCOPE("ResidencyManager::BeginFrame");
+
+  UpdateBudget();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  policy_.BeginFrame(++frame_);
+
+  evicted_handles_.clear();
+  if (policy_.CollectEvictions(min_idle_frames_, evicted_handles_) == 0) {
+    return;
+  }
+
+  evict_list_.clear();
+  for (Handle handle : evicted_handles_) {
+    evict_list_.push_back(pageables_[handle]);
+  }
+  HRESULT hr = device_->Evict(static_cast<UINT>(evict_list_.size()), evict_list_.data());
+  if (FAILED(hr)) {
+    std::cerr << "[ResidencyManager] Evict failed (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+  }
+}
+
+void ResidencyManager::MakePendingResident() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_resident_.empty()) {
+    return;
+  }
+
+  PROFILE_SCOPE("ResidencyManager::MakeResident");
+  // Blocks until the memory is paged back in (only for pageables that were actually evicted)
+  HRESULT hr = device_->MakeResident(static_cast<UINT>(pending_resident_.size()), pending_resident_.data());
+  if (FAILED(hr)) {
+    std::cerr << "[ResidencyManager] MakeResident failed (hr=0x" << std::hex << hr << std::dec << ")" << '\n';
+  }
+  pending_resident_.clear();
+}
+
+void ResidencyManager::UpdateBudget() {
+  if (budget_override_ != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_.SetBudget(budget_override_);
+    return;
+  }
+  if (adapter_ == nullptr) {
+    return;
+  }
+
+  DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+  if (FAILED(adapter_->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info))) {
+    return;
+  }
+
+  // Our share is the OS budget minus everything we do not track (swap chain, PSOs, other apps' pressure)
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t tracked = policy_.GetStats().resident_bytes;
+  const uint64_t untracked = (info.CurrentUsage > tracked) ? info.CurrentUsage - tracked : 0;
+  policy_.SetBudget((info.Budget > untracked) ? info.Budget - untracked : 1);
+}
+
+ResidencyPolicy::Stats ResidencyManager::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return policy_.GetStats();
+}
+
+void ResidencyManager::PrintStats() const {
+  const ResidencyPolicy::Stats stats = GetStats();
+
+  std::cout << "\n=== Residency Statistics ===" << '\n';
+  std::cout << "Tracked: " << stats.tracked_count << " (" << (stats.tracked_bytes >> 20) << " MB), resident " << stats.resident_count
+            << " (" << (stats.resident_bytes >> 20) << " MB)" << '\n';
+  std::cout << "Budget: " << (stats.budget >> 20) << " MB" << '\n';
+  std::cout << "Evictions: " << stats.evictions << " (" << (stats.evicted_bytes >> 20) << " MB), restores: " << stats.restores << '\n';
+  std::cout << "============================\n" << '\n';
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "residency_policy.h"
+#include "types.h"
+
+// ResidencyManager: Tracks the video memory of registered pageables and evicts the least recently used
+// ones when the resident total exceeds the budget. The budget is a configured value, or what
+// IDXGIAdapter3::QueryVideoMemoryInfo reports for local memory minus what this manager does not track.
+//
+// Evicted pageables that are touched again are made resident before the frame's command list executes
+// (MakePendingResident). Eviction only considers pageables unused for Graphic::FrameCount frames, so
+// nothing a frame in flight references is evicted.
+//
+// Register / Unregister / Touch are thread-safe; BeginFrame and MakePendingResident run on the render thread.
+class ResidencyManager {
+ public:
+  using Handle = ResidencyPolicy::Handle;
+  static constexpr Handle kInvalidHandle = ResidencyPolicy::kInvalidHandle;
+
+  ResidencyManager() = default;
+  ~ResidencyManager() = default;
+
+  ResidencyManager(const ResidencyManager&) = delete;
+  ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+  // adapter may be null (then only budget_override limits residency; 0 = unlimited)
+  bool Initialize(ID3D12Device* device, IDXGIAdapter3* adapter, uint32_t min_idle_frames, uint64_t budget_override = 0);
+
+  // pageable == nullptr: account the size only (e.g. placed resources, whose heap owns residency)
+  Handle Register(ID3D12Pageable* pageable, uint64_t size);
+  void Unregister(Handle handle);
+
+  // Mark used by the frame being recorded
+  void Touch(Handle handle);
+
+  // Refresh the budget and evict cold pageables (after the frame slot's fence wait)
+  void BeginFrame();
+
+  // Restore pageables touched while evicted (before ExecuteCommandLists)
+  void MakePendingResident();
+
+  void SetBudgetOverride(uint64_t budget) {
+    budget_override_ = budget;
+  }
+
+  ResidencyPolicy::Stats GetStats() const;
+  void PrintStats() const;
+
+ private:
+  ID3D12Device* device_ = nullptr;
+  ComPtr<IDXGIAdapter3> adapter_ = nullptr;
+  uint32_t min_idle_frames_ = 0;
+  uint64_t budget_override_ = 0;
+  uint64_t frame_ = 0;
+
+  mutable std::mutex mutex_;
+  ResidencyPolicy policy_;
+  std::vector<ID3D12Pageable*> pageables_;  // Indexed by handle (not owned)
+  std::vector<ID3D12Pageable*> pending_resident_;
+
+  // Reused per frame
+  std::vector<Handle> evicted_handles_;
+  std::vector<ID3D12Pageable*> evict_list_;
+
+  void UpdateBudget();
+};
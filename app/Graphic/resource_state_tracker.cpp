@@ -0,0 +1,51 @@
+#include "resource_state_tracker.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "gpu_resource.h"
+
+void ResourceStateTracker::Transition(GpuResource* resource, D3D12_RESOURCE_STATES new_state, UINT subresource) {
+  if (resource == nullptr || resource->GetResource() == nullptr) {
+    return;
+  }
+
+  // A barrier is a use: it must not run before a pending copy queue upload
+  resource->ResolvePendingUpload();
+
+  ++stats_.transitions;
+  const UINT subresource_count = (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) ? 0 : resource->GetSubresourceCount();
+  batch_.Transition(resource->GetResource(), resource->tracked_state_, subresource_count, new_state, subresource);
+  stats_.barriers_eliminated = batch_.GetEliminatedCount();
+}
+
+void ResourceStateTracker::Flush(ID3D12GraphicsCommandList* command_list) {
+  if (batch_.IsEmpty()) {
+    return;
+  }
+  assert(command_list != nullptr);
+
+  barriers_.clear();
+  for (const BarrierBatch::Barrier& pending : batch_.GetPending()) {
+    D3D12_RESOURCE_BARRIER& barrier = barriers_.emplace_back();
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Transition.pResource = static_cast<ID3D12Resource*>(pending.resource);
+    barrier.Transition.Subresource = pending.subresource;
+    barrier.Transition.StateBefore = static_cast<D3D12_RESOURCE_STATES>(pending.before);
+    barrier.Transition.StateAfter = static_cast<D3D12_RESOURCE_STATES>(pending.after);
+  }
+
+  command_list->ResourceBarrier(static_cast<UINT>(barriers_.size()), barriers_.data());
+  stats_.barriers_issued += barriers_.size();
+  ++stats_.batches;
+  batch_.Clear();
+}
+
+void ResourceStateTracker::PrintStats() const {
+  std::cout << "\n=== Resource State Tracker Statistics ===" << '\n';
+  std::cout << "Transitions: " << stats_.transitions << '\n';
+  std::cout << "Barriers Issued: " << stats_.barriers_issued << " in " << stats_.batches << " batches" << '\n';
+  std::cout << "Barriers Eliminated: " << stats_.barriers_eliminated << '\n';
+  std::cout << "=========================================\n" << '\n';
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "barrier_batch.h"
+#include "d3d12.h"
+
+class GpuResource;
+
+// ResourceStateTracker: Records transitions for one command list and issues them as a single
+// ResourceBarrier call on Flush (call it before the draw / clear / copy that needs the new states).
+//
+// Redundant transitions are dropped, chained ones merged and A->B->A cancelled; that bookkeeping and the
+// per-subresource tracking live in BarrierBatch (Core). Subresources are mips x array slices (planes are
+// not tracked separately).
+class ResourceStateTracker {
+ public:
+  struct Stats {
+    uint64_t transitions = 0;          // Transition calls
+    uint64_t barriers_issued = 0;      // Barriers passed to ResourceBarrier
+    uint64_t barriers_eliminated = 0;  // Redundant (already in state), merged or cancelled transitions
+    uint64_t batches = 0;              // ResourceBarrier calls
+  };
+
+  ResourceStateTracker() = default;
+  ~ResourceStateTracker() = default;
+
+  ResourceStateTracker(const ResourceStateTracker&) = delete;
+  ResourceStateTracker& operator=(const ResourceStateTracker&) = delete;
+
+  void Transition(GpuResource* resource, D3D12_RESOURCE_STATES new_state, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+  // Issue every pending barrier in one call (no-op when nothing is pending)
+  void Flush(ID3D12GraphicsCommandList* command_list);
+
+  bool HasPendingBarriers() const {
+    return !batch_.IsEmpty();
+  }
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+  void PrintStats() const;
+
+ private:
+  BarrierBatch batch_;
+  std::vector<D3D12_RESOURCE_BARRIER> barriers_;  // Reused for the ResourceBarrier call
+  Stats stats_;
+};
@@ -4,14 +4,17 @@
 
 #include <iostream>
 
-RootSignatureBuilder& RootSignatureBuilder::AddDescriptorTable(
-  D3D12_DESCRIPTOR_RANGE_TYPE range_type, UINT num_descriptors, UINT base_shader_register, D3D12_SHADER_VISIBILITY visibility) {
+RootSignatureBuilder& RootSignatureBuilder::AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE range_type,
+  UINT num_descriptors,
+  UINT base_shader_register,
+  D3D12_SHADER_VISIBILITY visibility,
+  UINT register_space) {
   // Create descriptor range
   D3D12_DESCRIPTOR_RANGE range = {};
   range.RangeType = range_type;
   range.NumDescriptors = num_descriptors;
   range.BaseShaderRegister = base_shader_register;
-  range.RegisterSpace = 0;
+  range.RegisterSpace = register_space;
   range.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
   // Create descriptor table entry
@@ -12,10 +12,12 @@ class RootSignatureBuilder {
   ~RootSignatureBuilder() = default;
 
   // Root parameter builders
+  // num_descriptors = UINT_MAX declares an unbounded range (bindless tables)
   RootSignatureBuilder& AddDescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE range_type,
     UINT num_descriptors,
     UINT base_shader_register,
-    D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
+    D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL,
+    UINT register_space = 0);
 
   RootSignatureBuilder& AddRootConstant(
     UINT num_32bit_values, UINT shader_register, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
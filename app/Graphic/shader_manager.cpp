@@ -2,8 +2,11 @@
 
 #include <d3dcompiler.h>
 
+#include <cstring>
 #include <iostream>
 
+#include "asset_archive.h"
+
 bool ShaderManager::LoadShader(const std::wstring& filepath, ShaderType type, const std::string& name) {
   // Check if already loaded
   if (shaders_.find(name) != shaders_.end()) {
@@ -11,14 +14,20 @@ bool ShaderManager::LoadShader(const std::wstring& filepath, ShaderType type, co
     return false;
   }
 
-  // Load shader blob from file
-  ComPtr<ID3DBlob> blob;
-  HRESULT hr = D3DReadFileToBlob(filepath.c_str(), blob.GetAddressOf());
+  // Load shader blob from the archive or the file (packed entries may be compressed, so they are copied)
+  AssetBlob bytecode;
+  if (!LoadAsset(asset_archive_, filepath, bytecode)) {
+    std::cerr << "[ShaderManager] Failed to load shader from file: " << name << '\n';
+    return false;
+  }
 
+  ComPtr<ID3DBlob> blob;
+  HRESULT hr = D3DCreateBlob(bytecode.size, blob.GetAddressOf());
   if (FAILED(hr)) {
-    std::cerr << "[ShaderManager] Failed to load shader from file: " << name << '\n';
+    std::cerr << "[ShaderManager] Failed to allocate shader blob: " << name << '\n';
     return false;
   }
+  std::memcpy(blob->GetBufferPointer(), bytecode.data, bytecode.size);
 
   // Store shader
   ShaderBlob shader;
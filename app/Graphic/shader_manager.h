@@ -8,6 +8,8 @@
 
 #include "types.h"
 
+class AssetArchive;
+
 // enum class ShaderType { Vertex, Pixel, Geometry, Hull, Domain, Compute };
 enum class ShaderType { Vertex, Pixel };
 
@@ -37,9 +39,14 @@ class ShaderManager {
   ShaderManager(const ShaderManager&) = delete;
   ShaderManager& operator=(const ShaderManager&) = delete;
 
-  // Load compiled shader from file (.cso)
+  // Load compiled shader from file (.cso), from the asset archive when it has the path
   bool LoadShader(const std::wstring& filepath, ShaderType type, const std::string& name);
 
+  // Optional: packed content (tools/asset_packer) searched before loose files
+  void SetAssetArchive(const AssetArchive* archive) {
+    asset_archive_ = archive;
+  }
+
   // Get cached shader by name
   const ShaderBlob* GetShader(const std::string& name) const;
 
@@ -56,4 +63,5 @@ class ShaderManager {
 
  private:
   std::unordered_map<std::string, ShaderBlob> shaders_;
+  const AssetArchive* asset_archive_ = nullptr;
 };
@@ -1,15 +1,67 @@
 #include "texture.h"
 
-#include <WICTextureLoader12.h>
 #include <d3d12.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
-#include <memory>
+#include <vector>
 
+#include "asset_archive.h"
+#include "cooked_texture.h"
+#include "copy_queue.h"
 #include "d3dx12.h"
+#include "image_decoder.h"
+#include "mapped_file.h"
+#include "profiler.h"
 #include "utils.h"
 
+namespace {
+DXGI_FORMAT ToDxgiFormat(CookedTextureFormat format, bool srgb) {
+  switch (format) {
+    case CookedTextureFormat::RGBA8:
+      return srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    case CookedTextureFormat::BC1:
+      return srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+    case CookedTextureFormat::BC3:
+      return srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+    case CookedTextureFormat::BC4:
+      return DXGI_FORMAT_BC4_UNORM;
+    case CookedTextureFormat::BC5:
+      return DXGI_FORMAT_BC5_UNORM;
+    case CookedTextureFormat::BC7:
+      return srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+  }
+  return DXGI_FORMAT_UNKNOWN;
+}
+
+// <stem>.ctex next to a source image, when tools/texture_cooker has produced one that is not older than the source
+std::filesystem::path FindCookedSibling(const std::filesystem::path& source_path) {
+  std::filesystem::path cooked_path = source_path;
+  cooked_path.replace_extension(L".ctex");
+
+  std::error_code error;
+  const auto cooked_time = std::filesystem::last_write_time(cooked_path, error);
+  if (error) {
+    return {};
+  }
+  const auto source_time = std::filesystem::last_write_time(source_path, error);
+  if (!error && source_time > cooked_time) {
+    return {};
+  }
+  return cooked_path;
+}
+}  // namespace
+
+Texture::~Texture() {
+  resource_.Reset();
+  if (memory_allocator_ != nullptr) {
+    memory_allocator_->Free(memory_allocation_);
+  }
+}
+
 bool Texture::Create(ID3D12Device* device,
   UINT width,
   UINT height,
@@ -17,7 +69,8 @@ bool Texture::Create(ID3D12Device* device,
   DescriptorHeapAllocator& srv_allocator,
   D3D12_RESOURCE_FLAGS flags,
   UINT mip_levels,
-  UINT array_size) {
+  UINT array_size,
+  GpuMemoryAllocator* memory_allocator) {
   assert(device != nullptr);
   assert(width > 0 && height > 0);
 
@@ -31,13 +84,8 @@ bool Texture::Create(ID3D12Device* device,
   CD3DX12_RESOURCE_DESC texture_desc =
     CD3DX12_RESOURCE_DESC::Tex2D(format, width, height, static_cast<UINT16>(array_size), static_cast<UINT16>(mip_levels), 1, 0, flags);
 
-  CD3DX12_HEAP_PROPERTIES heap_props(D3D12_HEAP_TYPE_DEFAULT);
-
   ComPtr<ID3D12Resource> resource;
-  HRESULT hr = device->CreateCommittedResource(
-    &heap_props, D3D12_HEAP_FLAG_NONE, &texture_desc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(resource.GetAddressOf()));
-
-  if (FAILED(hr)) {
+  if (!CreateTextureResource(device, texture_desc, D3D12_RESOURCE_STATE_COMMON, memory_allocator, resource)) {
     std::cerr << "[Texture] Failed to create texture resource" << '\n';
     return false;
   }
@@ -52,95 +100,212 @@ bool Texture::Create(ID3D12Device* device,
   return true;
 }
 
-bool Texture::LoadFromFile(
-  ID3D12Device* device, ID3D12GraphicsCommandList* command_list, const std::wstring& file_path, DescriptorHeapAllocator& srv_allocator) {
+bool Texture::LoadFromFile(ID3D12Device* device,
+  UploadBatch& batch,
+  const std::wstring& file_path,
+  DescriptorHeapAllocator& srv_allocator,
+  const AssetArchive* archive) {
+  if (!DecodeFromFile(device, batch, file_path, archive)) {
+    return false;
+  }
+
+  // Create SRV
+  if (!CreateSRV(device, srv_allocator)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool Texture::DecodeFromFile(ID3D12Device* device, UploadBatch& batch, const std::wstring& file_path, const AssetArchive* archive) {
   assert(device != nullptr);
-  assert(command_list != nullptr);
+  PROFILE_SCOPE("Texture::DecodeFromFile");
 
-  ComPtr<ID3D12Resource> resource;
-  ComPtr<ID3D12Resource> upload_heap;
-  std::unique_ptr<uint8_t[]> decoded_data;
-  D3D12_SUBRESOURCE_DATA subresource_data;
+  AssetBlob blob;
+  std::string name;
+  return OpenSource(file_path, archive, blob, name) && DecodeFromMemory(device, batch, blob.data, blob.size, name);
+}
 
-  HRESULT hr = DirectX::LoadWICTextureFromFileEx(device,
-    file_path.c_str(),
-    0,
-    D3D12_RESOURCE_FLAG_NONE,
-    DirectX::WIC_LOADER_DEFAULT,
-    resource.GetAddressOf(),
-    decoded_data,
-    subresource_data);
+bool Texture::OpenSource(const std::wstring& file_path, const AssetArchive* archive, AssetBlob& out_blob, std::string& out_name) {
+  const std::filesystem::path path(file_path);
+  const bool is_cooked = path.extension() == L".ctex";
 
-  if (FAILED(hr)) {
-    std::cerr << "[Texture] Failed to load texture: " << utils::WstringToUtf8(file_path) << '\n';
+  // Packed entries first; the packer has no timestamps to compare, so a packed cooked sibling always wins
+  if (archive != nullptr) {
+    const AssetArchiveEntry* entry = is_cooked ? nullptr : archive->Find(std::filesystem::path(path).replace_extension(L".ctex"));
+    if (entry == nullptr) {
+      entry = archive->Find(path);
+    }
+    if (entry != nullptr) {
+      out_name = archive->GetEntryPath(*entry);
+      return archive->Load(*entry, out_blob);
+    }
+  }
+
+  // Cooked containers (given directly or cooked next to the source) skip decoding entirely
+  std::filesystem::path load_path = path;
+  if (!is_cooked) {
+    if (std::filesystem::path cooked_sibling = FindCookedSibling(path); !cooked_sibling.empty()) {
+      load_path = std::move(cooked_sibling);
+    }
+  }
+  out_name = utils::WstringToUtf8(load_path.wstring());
+  if (!out_blob.file.Open(load_path)) {
     return false;
   }
+  out_blob.data = out_blob.file.GetData();
+  out_blob.size = out_blob.file.GetSize();
+  return true;
+}
 
-  // Get texture description
-  D3D12_RESOURCE_DESC resource_desc = resource->GetDesc();
-  width_ = static_cast<UINT>(resource_desc.Width);
-  height_ = static_cast<UINT>(resource_desc.Height);
-  format_ = resource_desc.Format;
-  mip_levels_ = static_cast<UINT>(resource_desc.MipLevels);
-  array_size_ = static_cast<UINT>(resource_desc.DepthOrArraySize);
+bool Texture::DecodeFromMemory(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name) {
+  uint32_t magic = 0;
+  if (size >= sizeof(magic)) {
+    std::memcpy(&magic, data, sizeof(magic));
+  }
+  if (magic == kCookedTextureMagic) {
+    return LoadCookedData(device, batch, data, size, name);
+  }
+  return LoadImageData(device, batch, data, size, name);
+}
 
-  // Create upload heap
-  const UINT64 upload_buffer_size = GetRequiredIntermediateSize(resource.Get(), 0, 1);
+bool Texture::LoadImageData(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name) {
+  PROFILE_SCOPE("Texture::LoadImageData");
 
-  CD3DX12_HEAP_PROPERTIES upload_heap_props(D3D12_HEAP_TYPE_UPLOAD);
-  CD3DX12_RESOURCE_DESC upload_buffer_desc = CD3DX12_RESOURCE_DESC::Buffer(upload_buffer_size);
+  ImageInfo info;
+  if (!ReadImageInfo(data, size, info)) {
+    std::cerr << "[Texture] Failed to load texture: " << name << '\n';
+    return false;
+  }
 
-  hr = device->CreateCommittedResource(&upload_heap_props,
-    D3D12_HEAP_FLAG_NONE,
-    &upload_buffer_desc,
-    D3D12_RESOURCE_STATE_GENERIC_READ,
-    nullptr,
-    IID_PPV_ARGS(upload_heap.GetAddressOf()));
+  width_ = info.width;
+  height_ = info.height;
+  format_ = info.srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+  mip_levels_ = 1;
+  array_size_ = 1;
 
-  if (FAILED(hr)) {
-    std::cerr << "[Texture] Failed to create upload heap" << '\n';
+  const CD3DX12_RESOURCE_DESC texture_desc = CD3DX12_RESOURCE_DESC::Tex2D(format_, width_, height_, 1, 1);
+  ComPtr<ID3D12Resource> resource;
+  if (!CreateTextureResource(device, texture_desc, D3D12_RESOURCE_STATE_COMMON, nullptr, resource)) {
+    std::cerr << "[Texture] Failed to create texture resource for " << name << '\n';
     return false;
   }
 
-  // Upload texture data
-  UpdateSubresources(command_list, resource.Get(), upload_heap.Get(), 0, 0, 1, &subresource_data);
-  upload_heap_ = upload_heap;
+  D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+  UINT64 upload_size = 0;
+  device->GetCopyableFootprints(&texture_desc, 0, 1, 0, &footprint, nullptr, nullptr, &upload_size);
 
-  // Transition to shader resource
-  CD3DX12_RESOURCE_BARRIER barrier =
-    CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+  const UploadBatch::Staging staging = batch.AllocateStaging(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+  if (!staging.IsValid()) {
+    std::cerr << "[Texture] Failed to allocate staging memory" << '\n';
+    return false;
+  }
 
-  command_list->ResourceBarrier(1, &barrier);
+  // Decode straight into the staging memory in the footprint layout: no intermediate pixel buffer
+  if (!DecodeImage(data, size, static_cast<uint8_t*>(staging.cpu) + footprint.Offset, footprint.Footprint.RowPitch)) {
+    std::cerr << "[Texture] Failed to decode texture: " << name << '\n';
+    return false;
+  }
 
-  SetResource(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+  // No barrier: the texture is created in COMMON, which the copy promotes to COPY_DEST
+  footprint.Offset += staging.offset;
+  const CD3DX12_TEXTURE_COPY_LOCATION destination(resource.Get(), 0);
+  const CD3DX12_TEXTURE_COPY_LOCATION source(staging.resource, footprint);
+  batch.GetCommandList()->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
 
-  // Create SRV
-  if (!CreateSRV(device, srv_allocator)) {
+  SetResource(resource, D3D12_RESOURCE_STATE_COMMON);
+  return true;
+}
+
+bool Texture::LoadCookedData(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name) {
+  PROFILE_SCOPE("Texture::LoadCookedData");
+
+  CookedTextureView view;
+  if (!ParseCookedTexture(data, size, view)) {
+    std::cerr << "[Texture] Invalid cooked texture: " << name << '\n';
+    return false;
+  }
+
+  const CookedTextureHeader& header = *view.header;
+  width_ = header.width;
+  height_ = header.height;
+  format_ = ToDxgiFormat(header.format, (header.flags & kCookedTextureFlagSrgb) != 0);
+  mip_levels_ = header.mip_count;
+  array_size_ = header.array_size;
+
+  CD3DX12_RESOURCE_DESC texture_desc =
+    CD3DX12_RESOURCE_DESC::Tex2D(format_, width_, height_, static_cast<UINT16>(array_size_), static_cast<UINT16>(mip_levels_));
+
+  ComPtr<ID3D12Resource> resource;
+  if (!CreateTextureResource(device, texture_desc, D3D12_RESOURCE_STATE_COMMON, nullptr, resource)) {
+    std::cerr << "[Texture] Failed to create texture resource for " << name << '\n';
     return false;
   }
 
+  const UINT subresource_count = view.GetSubresourceCount();
+  std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(subresource_count);
+  std::vector<UINT> row_counts(subresource_count);
+  std::vector<UINT64> row_sizes(subresource_count);
+  UINT64 upload_size = 0;
+  device->GetCopyableFootprints(
+    &texture_desc, 0, subresource_count, 0, footprints.data(), row_counts.data(), row_sizes.data(), &upload_size);
+
+  const UploadBatch::Staging staging = batch.AllocateStaging(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+  if (!staging.IsValid()) {
+    std::cerr << "[Texture] Failed to allocate staging memory" << '\n';
+    return false;
+  }
+
+  // The cooker writes the data block in this exact footprint layout, so it normally lands with one copy
+  bool matches_footprints = true;
+  for (UINT i = 0; i < subresource_count; ++i) {
+    const CookedTextureSubresource& sub = view.subresources[i];
+    matches_footprints = matches_footprints && footprints[i].Offset == sub.offset && footprints[i].Footprint.RowPitch == sub.row_pitch &&
+                         row_counts[i] == sub.row_count && row_sizes[i] == sub.row_bytes;
+  }
+
+  auto* staging_cpu = static_cast<uint8_t*>(staging.cpu);
+  if (matches_footprints) {
+    std::memcpy(staging_cpu, view.data, static_cast<size_t>((std::min)(upload_size, header.data_size)));
+  } else {
+    for (UINT i = 0; i < subresource_count; ++i) {
+      const CookedTextureSubresource& sub = view.subresources[i];
+      const UINT rows = (std::min)(row_counts[i], sub.row_count);
+      const size_t row_bytes = static_cast<size_t>((std::min)(row_sizes[i], static_cast<UINT64>(sub.row_bytes)));
+      for (UINT row = 0; row < rows; ++row) {
+        std::memcpy(staging_cpu + footprints[i].Offset + static_cast<UINT64>(row) * footprints[i].Footprint.RowPitch,
+          view.data + sub.offset + static_cast<uint64_t>(row) * sub.row_pitch,
+          row_bytes);
+      }
+    }
+  }
+
+  // No barrier: the texture is created in COMMON, which the copy promotes to COPY_DEST
+  for (UINT i = 0; i < subresource_count; ++i) {
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT source_footprint = footprints[i];
+    source_footprint.Offset += staging.offset;
+    const CD3DX12_TEXTURE_COPY_LOCATION destination(resource.Get(), i);
+    const CD3DX12_TEXTURE_COPY_LOCATION source(staging.resource, source_footprint);
+    batch.GetCommandList()->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+  }
+
+  SetResource(resource, D3D12_RESOURCE_STATE_COMMON);
   return true;
 }
 
 bool Texture::LoadFromMemory(ID3D12Device* device,
-  ID3D12GraphicsCommandList* command_list,
+  UploadBatch& batch,
   const void* pixel_data,
   UINT width,
   UINT height,
   DXGI_FORMAT format,
   DescriptorHeapAllocator& srv_allocator,
-  UINT row_pitch) {
+  UINT row_pitch,
+  GpuMemoryAllocator* memory_allocator) {
   assert(device != nullptr);
-  assert(command_list != nullptr);
   assert(pixel_data != nullptr);
   assert(width > 0 && height > 0);
 
-  width_ = width;
-  height_ = height;
-  format_ = format;
-  mip_levels_ = 1;
-  array_size_ = 1;
-
   // Calculate row pitch if not provided
   if (row_pitch == 0) {
     UINT bits_per_pixel = 0;
@@ -161,55 +326,49 @@ bool Texture::LoadFromMemory(ID3D12Device* device,
     row_pitch = (width * bits_per_pixel + 7) / 8;
   }
 
+  // Prepare subresource data
+  D3D12_SUBRESOURCE_DATA subresource_data = {};
+  subresource_data.pData = pixel_data;
+  subresource_data.RowPitch = row_pitch;
+  subresource_data.SlicePitch = row_pitch * height;
+
+  return LoadMipChainFromMemory(device, batch, &subresource_data, 1, width, height, format, srv_allocator, memory_allocator);
+}
+
+bool Texture::LoadMipChainFromMemory(ID3D12Device* device,
+  UploadBatch& batch,
+  const D3D12_SUBRESOURCE_DATA* mips,
+  UINT mip_count,
+  UINT width,
+  UINT height,
+  DXGI_FORMAT format,
+  DescriptorHeapAllocator& srv_allocator,
+  GpuMemoryAllocator* memory_allocator) {
+  assert(device != nullptr);
+  assert(mips != nullptr && mip_count > 0);
+  assert(width > 0 && height > 0);
+
+  width_ = width;
+  height_ = height;
+  format_ = format;
+  mip_levels_ = mip_count;
+  array_size_ = 1;
+
   // Create texture resource
-  CD3DX12_RESOURCE_DESC texture_desc = CD3DX12_RESOURCE_DESC::Tex2D(format, width, height);
-  CD3DX12_HEAP_PROPERTIES heap_props(D3D12_HEAP_TYPE_DEFAULT);
+  CD3DX12_RESOURCE_DESC texture_desc = CD3DX12_RESOURCE_DESC::Tex2D(format, width, height, 1, static_cast<UINT16>(mip_count));
 
   ComPtr<ID3D12Resource> resource;
-  HRESULT hr = device->CreateCommittedResource(
-    &heap_props, D3D12_HEAP_FLAG_NONE, &texture_desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(resource.GetAddressOf()));
-
-  if (FAILED(hr)) {
+  if (!CreateTextureResource(device, texture_desc, D3D12_RESOURCE_STATE_COPY_DEST, memory_allocator, resource)) {
     std::cerr << "[Texture] Failed to create texture resource" << '\n';
     return false;
   }
 
-  // Create upload heap
-  const UINT64 upload_buffer_size = GetRequiredIntermediateSize(resource.Get(), 0, 1);
-
-  CD3DX12_HEAP_PROPERTIES upload_heap_props(D3D12_HEAP_TYPE_UPLOAD);
-  CD3DX12_RESOURCE_DESC upload_buffer_desc = CD3DX12_RESOURCE_DESC::Buffer(upload_buffer_size);
-
-  ComPtr<ID3D12Resource> upload_heap;
-  hr = device->CreateCommittedResource(&upload_heap_props,
-    D3D12_HEAP_FLAG_NONE,
-    &upload_buffer_desc,
-    D3D12_RESOURCE_STATE_GENERIC_READ,
-    nullptr,
-    IID_PPV_ARGS(upload_heap.GetAddressOf()));
-
-  if (FAILED(hr)) {
-    std::cerr << "[Texture] Failed to create upload heap" << '\n';
+  // Upload texture data through the copy queue's staging ring
+  if (!RecordUpload(batch, resource.Get(), mips, mip_count)) {
     return false;
   }
 
-  // Prepare subresource data
-  D3D12_SUBRESOURCE_DATA subresource_data = {};
-  subresource_data.pData = pixel_data;
-  subresource_data.RowPitch = row_pitch;
-  subresource_data.SlicePitch = row_pitch * height;
-
-  // Upload texture data
-  UpdateSubresources(command_list, resource.Get(), upload_heap.Get(), 0, 0, 1, &subresource_data);
-  upload_heap_ = upload_heap;
-
-  // Transition to shader resource
-  CD3DX12_RESOURCE_BARRIER barrier =
-    CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-  command_list->ResourceBarrier(1, &barrier);
-
-  SetResource(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+  SetResource(resource, D3D12_RESOURCE_STATE_COPY_DEST);
 
   // Create SRV
   if (!CreateSRV(device, srv_allocator)) {
@@ -231,20 +390,73 @@ bool Texture::CreateSRV(ID3D12Device* device, DescriptorHeapAllocator& srv_alloc
   }
 
   // Create SRV
+  const D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = GetSRVDesc();
+  device->CreateShaderResourceView(resource_.Get(), &srv_desc, srv_allocation_.cpu);
+
+  return true;
+}
+
+bool Texture::CreateStagingSRV(ID3D12Device* device, DescriptorHeapAllocator& staging_allocator) {
+  assert(device != nullptr);
+  assert(resource_ != nullptr);
+
+  staging_srv_allocation_ = staging_allocator.Allocate(1);
+  if (!staging_srv_allocation_.IsValid()) {
+    std::cerr << "[Texture] Failed to allocate staging SRV descriptor" << '\n';
+    return false;
+  }
+
+  const D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = GetSRVDesc();
+  device->CreateShaderResourceView(resource_.Get(), &srv_desc, staging_srv_allocation_.cpu);
+
+  return true;
+}
+
+D3D12_SHADER_RESOURCE_VIEW_DESC Texture::GetSRVDesc() const {
   D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
   srv_desc.Format = format_;
   srv_desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
   srv_desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+  if (format_ == DXGI_FORMAT_BC4_UNORM) {
+    // Single-channel (grayscale) data reads as (r, r, r, 1) like the RGBA source it was cooked from
+    srv_desc.Shader4ComponentMapping = D3D12_ENCODE_SHADER_4_COMPONENT_MAPPING(D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0,
+      D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0,
+      D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_0,
+      D3D12_SHADER_COMPONENT_MAPPING_FORCE_VALUE_1);
+  }
   srv_desc.Texture2D.MostDetailedMip = 0;
   srv_desc.Texture2D.MipLevels = mip_levels_;
   srv_desc.Texture2D.PlaneSlice = 0;
   srv_desc.Texture2D.ResourceMinLODClamp = 0.0f;
+  return srv_desc;
+}
 
-  device->CreateShaderResourceView(resource_.Get(), &srv_desc, srv_allocation_.cpu);
+bool Texture::CreateTextureResource(ID3D12Device* device,
+  const D3D12_RESOURCE_DESC& desc,
+  D3D12_RESOURCE_STATES initial_state,
+  GpuMemoryAllocator* memory_allocator,
+  ComPtr<ID3D12Resource>& out_resource) {
+  if (memory_allocator != nullptr) {
+    memory_allocator_ = memory_allocator;
+    return memory_allocator->CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, initial_state, out_resource, memory_allocation_);
+  }
 
-  return true;
+  CD3DX12_HEAP_PROPERTIES heap_props(D3D12_HEAP_TYPE_DEFAULT);
+  HRESULT hr = device->CreateCommittedResource(
+    &heap_props, D3D12_HEAP_FLAG_NONE, &desc, initial_state, nullptr, IID_PPV_ARGS(out_resource.GetAddressOf()));
+  return SUCCEEDED(hr);
 }
 
-void Texture::ReleaseUploadHeap() {
-  upload_heap_.Reset();
+bool Texture::RecordUpload(UploadBatch& batch, ID3D12Resource* resource, const D3D12_SUBRESOURCE_DATA* subresource_data, UINT count) {
+  const UINT64 upload_size = GetRequiredIntermediateSize(resource, 0, count);
+  const UploadBatch::Staging staging = batch.AllocateStaging(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+  if (!staging.IsValid()) {
+    std::cerr << "[Texture] Failed to allocate staging memory" << '\n';
+    return false;
+  }
+
+  // No barrier: copy queues cannot reach PIXEL_SHADER_RESOURCE. The texture decays to COMMON when the batch
+  // completes and is promoted implicitly on its first read on the direct queue.
+  UpdateSubresources(batch.GetCommandList(), resource, staging.resource, staging.offset, 0, count, subresource_data);
+  return true;
 }
@@ -2,13 +2,22 @@
 
 #include <d3d12.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 #include "descriptor_heap_allocator.h"
+#include "gpu_memory_allocator.h"
 #include "gpu_resource.h"
 
+class AssetArchive;
+class UploadBatch;
+struct AssetBlob;
+
 class Texture : public GpuResource {
  public:
   Texture() = default;
-  ~Texture() override = default;
+  ~Texture() override;
 
   Texture(const Texture&) = delete;
   Texture& operator=(const Texture&) = delete;
@@ -20,23 +29,62 @@ class Texture : public GpuResource {
     DescriptorHeapAllocator& src_allocator,
     D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE,
     UINT mip_levels = 1,
-    UINT array_size = 1);
+    UINT array_size = 1,
+    GpuMemoryAllocator* memory_allocator = nullptr);
+
+  // Load / LoadFromMemory record the copy on a copy queue batch; the texture is readable by the direct
+  // queue (through implicit promotion from COMMON) once the batch completes. The caller tracks the texture
+  // on the batch (UploadBatch::Track) before the call, so it outlives the copy even if loading fails.
+  bool LoadFromFile(ID3D12Device* device,
+    UploadBatch& batch,
+    const std::wstring& filepath,
+    DescriptorHeapAllocator& src_allocator,
+    const AssetArchive* archive = nullptr);
 
-  bool LoadFromFile(
-    ID3D12Device* device, ID3D12GraphicsCommandList* command_list, const std::wstring& filepath, DescriptorHeapAllocator& src_allocator);
+  // Decode and record the copy only (safe on worker threads): no view is created. As above, the caller
+  // tracks the texture on the batch first, and calls CreateSRV before binding.
+  // Cooked containers (.ctex, tools/texture_cooker) are mapped and copied without decoding; a cooked
+  // <stem>.ctex next to an image source is preferred over the source unless the source is newer.
+  // PNG / TGA sources decode to R8G8B8A8 (_SRGB when the PNG declares sRGB) with a single mip.
+  // With an archive, packed entries (a packed <stem>.ctex first) are used before files on disk.
+  bool DecodeFromFile(ID3D12Device* device, UploadBatch& batch, const std::wstring& filepath, const AssetArchive* archive = nullptr);
+
+  // The two halves of DecodeFromFile: the bytes filepath decodes from (picked as described above; out_name
+  // names them in messages), and decoding bytes of a cooked container (by its magic) or PNG / TGA image
+  static bool OpenSource(const std::wstring& filepath, const AssetArchive* archive, AssetBlob& out_blob, std::string& out_name);
+  bool DecodeFromMemory(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name);
 
   bool LoadFromMemory(ID3D12Device* device,
-    ID3D12GraphicsCommandList* command_list,
+    UploadBatch& batch,
     const void* pixel_data,
     UINT width,
     UINT height,
     DXGI_FORMAT format,
     DescriptorHeapAllocator& srv_allocator,
-    UINT row_pitch = 0);
+    UINT row_pitch = 0,
+    GpuMemoryAllocator* memory_allocator = nullptr);
+
+  // Same as LoadFromMemory for a whole mip chain: mips[0] is width x height, each further level halves it
+  bool LoadMipChainFromMemory(ID3D12Device* device,
+    UploadBatch& batch,
+    const D3D12_SUBRESOURCE_DATA* mips,
+    UINT mip_count,
+    UINT width,
+    UINT height,
+    DXGI_FORMAT format,
+    DescriptorHeapAllocator& srv_allocator,
+    GpuMemoryAllocator* memory_allocator = nullptr);
 
   DescriptorHeapAllocator::Allocation GetSRV() const {
     return srv_allocation_;
   }
+  bool CreateSRV(ID3D12Device* device, DescriptorHeapAllocator& srv_allocator);
+
+  // Second SRV in a CPU-only heap, used as the CopyDescriptors source for per-frame tables
+  bool CreateStagingSRV(ID3D12Device* device, DescriptorHeapAllocator& staging_allocator);
+  DescriptorHeapAllocator::Allocation GetStagingSRV() const {
+    return staging_srv_allocation_;
+  }
 
   UINT GetWidth() const {
     return width_;
@@ -58,18 +106,43 @@ class Texture : public GpuResource {
     return GpuResource::IsValid() && srv_allocation_.IsValid();
   }
 
-  void ReleaseUploadHeap();
+  // Placed in a shared heap (residency belongs to the heap, not to this resource)
+  bool IsPlaced() const {
+    return memory_allocation_.IsValid();
+  }
+
+  const GpuMemoryAllocator::Allocation& GetMemoryAllocation() const {
+    return memory_allocation_;
+  }
 
  private:
   DescriptorHeapAllocator::Allocation srv_allocation_ = {};
+  DescriptorHeapAllocator::Allocation staging_srv_allocation_ = {};
   UINT width_ = 0;
   UINT height_ = 0;
   DXGI_FORMAT format_ = DXGI_FORMAT_UNKNOWN;
   UINT mip_levels_ = 1;
   UINT array_size_ = 1;
 
-  // Move upload_heap_ to outside the texture
-  ComPtr<ID3D12Resource> upload_heap_ = nullptr;
+  // Set when the texture is placed in a shared heap
+  GpuMemoryAllocator* memory_allocator_ = nullptr;
+  GpuMemoryAllocator::Allocation memory_allocation_ = {};
 
-  bool CreateSRV(ID3D12Device* device, DescriptorHeapAllocator& srv_allocator);
+  // Placed through memory_allocator when given, committed otherwise
+  bool CreateTextureResource(ID3D12Device* device,
+    const D3D12_RESOURCE_DESC& desc,
+    D3D12_RESOURCE_STATES initial_state,
+    GpuMemoryAllocator* memory_allocator,
+    ComPtr<ID3D12Resource>& out_resource);
+
+  // Decode a PNG / TGA image directly into the batch's staging memory
+  bool LoadImageData(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name);
+
+  // Record one copy per subresource of a .ctex container from its pre-laid-out data block
+  bool LoadCookedData(ID3D12Device* device, UploadBatch& batch, const uint8_t* data, size_t size, const std::string& name);
+
+  // Copy subresources [0, count) from CPU memory into resource through the batch's staging memory
+  bool RecordUpload(UploadBatch& batch, ID3D12Resource* resource, const D3D12_SUBRESOURCE_DATA* subresource_data, UINT count);
+
+  D3D12_SHADER_RESOURCE_VIEW_DESC GetSRVDesc() const;
 };
@@ -0,0 +1,176 @@
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include "image_decoder.h"
+#include "rect_packer.h"
+#include "types.h"
+#include "utils.h"
+
+namespace {
+UINT AlignUp(UINT value, UINT alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+bool TextureAtlasBuilder::AddImage(const std::string& name, const void* rgba8_pixels, UINT width, UINT height, UINT row_pitch) {
+  if (rgba8_pixels == nullptr || width == 0 || height == 0) {
+    std::cerr << "[TextureAtlasBuilder] Invalid image data for: " << name << '\n';
+    return false;
+  }
+
+  const UINT tight_pitch = width * 4;
+  if (row_pitch == 0) {
+    row_pitch = tight_pitch;
+  }
+
+  SourceImage image;
+  image.name = name;
+  image.width = width;
+  image.height = height;
+  image.pixels.resize(static_cast<size_t>(tight_pitch) * height);
+
+  const auto* src = static_cast<const uint8_t*>(rgba8_pixels);
+  for (UINT y = 0; y < height; ++y) {
+    std::memcpy(image.pixels.data() + static_cast<size_t>(y) * tight_pitch, src + static_cast<size_t>(y) * row_pitch, tight_pitch);
+  }
+
+  images_.push_back(std::move(image));
+  return true;
+}
+
+bool TextureAtlasBuilder::AddImageFromFile(const std::string& name, const std::wstring& file_path) {
+  Image image;
+  if (!DecodeImageFile(file_path, image)) {
+    std::cerr << "[TextureAtlasBuilder] Failed to decode image: " << utils::WstringToUtf8(file_path) << '\n';
+    return false;
+  }
+  return AddImage(name, image.pixels.data(), image.width, image.height, image.GetRowPitch());
+}
+
+bool TextureAtlasBuilder::Build(const TextureAtlasParams& params) {
+  pages_.clear();
+  regions_.clear();
+
+  if (images_.empty()) {
+    return true;
+  }
+
+  const UINT alignment = 1u << params.mip_safe_levels;
+  if (params.page_width % alignment != 0 || params.page_height % alignment != 0) {
+    std::cerr << "[TextureAtlasBuilder] Page size must be a multiple of the mip alignment (" << alignment << ")" << '\n';
+    return false;
+  }
+
+  auto cell_width = [&](const SourceImage& image) { return AlignUp(image.width + params.padding * 2, alignment); };
+  auto cell_height = [&](const SourceImage& image) { return AlignUp(image.height + params.padding * 2, alignment); };
+
+  // Largest-first insertion gives MaxRects much better occupancy
+  std::vector<size_t> order(images_.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    const UINT max_a = (std::max)(cell_width(images_[a]), cell_height(images_[a]));
+    const UINT max_b = (std::max)(cell_width(images_[b]), cell_height(images_[b]));
+    if (max_a != max_b) {
+      return max_a > max_b;
+    }
+    return cell_width(images_[a]) * cell_height(images_[a]) > cell_width(images_[b]) * cell_height(images_[b]);
+  });
+
+  struct Placement {
+    size_t image_index;
+    uint32_t page_index;
+    RectPacker::Rect cell;
+  };
+
+  std::vector<RectPacker> packers;
+  std::vector<Placement> placements;
+  placements.reserve(images_.size());
+
+  for (size_t image_index : order) {
+    const SourceImage& image = images_[image_index];
+    const UINT w = cell_width(image);
+    const UINT h = cell_height(image);
+
+    if (w > params.page_width || h > params.page_height) {
+      std::cerr << "[TextureAtlasBuilder] Image '" << image.name << "' (" << image.width << "x" << image.height
+                << ") does not fit into an atlas page of " << params.page_width << "x" << params.page_height << '\n';
+      pages_.clear();
+      return false;
+    }
+
+    Placement placement{image_index, 0, {}};
+    bool placed = false;
+    for (uint32_t page_index = 0; page_index < packers.size(); ++page_index) {
+      if (packers[page_index].Insert(w, h, placement.cell)) {
+        placement.page_index = page_index;
+        placed = true;
+        break;
+      }
+    }
+
+    if (!placed) {
+      packers.emplace_back(params.page_width, params.page_height);
+      packers.back().Insert(w, h, placement.cell);
+      placement.page_index = static_cast<uint32_t>(packers.size() - 1);
+    }
+
+    placements.push_back(placement);
+  }
+
+  pages_.resize(packers.size());
+  for (size_t i = 0; i < packers.size(); ++i) {
+    Page& page = pages_[i];
+    page.width = params.trim_pages ? AlignUp(packers[i].GetUsedWidth(), alignment) : params.page_width;
+    page.height = params.trim_pages ? AlignUp(packers[i].GetUsedHeight(), alignment) : params.page_height;
+    page.pixels.assign(static_cast<size_t>(page.width) * page.height * 4, 0);
+  }
+
+  regions_.reserve(placements.size());
+  for (const Placement& placement : placements) {
+    const SourceImage& image = images_[placement.image_index];
+    Page& page = pages_[placement.page_index];
+
+    BlitWithExtrusion(image, page, placement.cell.x, placement.cell.y, placement.cell.width, placement.cell.height, params.padding);
+
+    Region region;
+    region.name = image.name;
+    region.page_index = placement.page_index;
+    region.uv_transform = {static_cast<float>(placement.cell.x + params.padding) / static_cast<float>(page.width),
+      static_cast<float>(placement.cell.y + params.padding) / static_cast<float>(page.height),
+      static_cast<float>(image.width) / static_cast<float>(page.width),
+      static_cast<float>(image.height) / static_cast<float>(page.height)};
+    regions_.push_back(region);
+  }
+
+  std::cout << "[TextureAtlasBuilder] Packed " << images_.size() << " images into " << pages_.size() << " page(s)" << '\n';
+  return true;
+}
+
+void TextureAtlasBuilder::Clear() {
+  images_.clear();
+  pages_.clear();
+  regions_.clear();
+}
+
+void TextureAtlasBuilder::BlitWithExtrusion(
+  const SourceImage& image, Page& page, UINT cell_x, UINT cell_y, UINT cell_width, UINT cell_height, UINT padding) {
+  // The whole cell is written: texels outside the image clamp to the nearest edge texel,
+  // so both the padding ring and the alignment slack repeat the border colour.
+  const int max_x = static_cast<int>(image.width) - 1;
+  const int max_y = static_cast<int>(image.height) - 1;
+
+  for (UINT cy = 0; cy < cell_height; ++cy) {
+    const int sy = std::clamp(static_cast<int>(cy) - static_cast<int>(padding), 0, max_y);
+    const uint8_t* src_row = image.pixels.data() + static_cast<size_t>(sy) * image.width * 4;
+    uint8_t* dst_row = page.pixels.data() + (static_cast<size_t>(cell_y + cy) * page.width + cell_x) * 4;
+
+    for (UINT cx = 0; cx < cell_width; ++cx) {
+      const int sx = std::clamp(static_cast<int>(cx) - static_cast<int>(padding), 0, max_x);
+      std::memcpy(dst_row + static_cast<size_t>(cx) * 4, src_row + static_cast<size_t>(sx) * 4, 4);
+    }
+  }
+}
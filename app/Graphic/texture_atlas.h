@@ -0,0 +1,85 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <d3d12.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Atlas build parameters
+struct TextureAtlasParams {
+  UINT page_width = 2048;
+  UINT page_height = 2048;
+
+  // Border texels around every image, filled by edge extrusion to stop bilinear bleeding
+  UINT padding = 2;
+
+  // Regions are aligned to (1 << mip_safe_levels) texels so the first N mips never mix neighbouring images
+  UINT mip_safe_levels = 2;
+
+  // Shrink pages to the used extent (rounded up to the mip alignment) after packing
+  bool trim_pages = true;
+};
+
+// TextureAtlasBuilder: Packs many small RGBA8 images into shared atlas pages on the CPU.
+// The result is consumed by TextureManager::CreateAtlas, which uploads the pages and
+// exposes each image as a TextureRegion (page handle + uv_transform).
+class TextureAtlasBuilder {
+ public:
+  struct Page {
+    std::vector<uint8_t> pixels;  // RGBA8, tightly packed
+    UINT width = 0;
+    UINT height = 0;
+  };
+
+  struct Region {
+    std::string name;
+    uint32_t page_index = 0;
+    DirectX::XMFLOAT4 uv_transform = {0.0f, 0.0f, 1.0f, 1.0f};  // offset.xy, scale.xy within the page
+  };
+
+  TextureAtlasBuilder() = default;
+  ~TextureAtlasBuilder() = default;
+
+  TextureAtlasBuilder(const TextureAtlasBuilder&) = delete;
+  TextureAtlasBuilder& operator=(const TextureAtlasBuilder&) = delete;
+
+  // Add an RGBA8 image (pixels are copied). row_pitch = 0 means tightly packed.
+  bool AddImage(const std::string& name, const void* rgba8_pixels, UINT width, UINT height, UINT row_pitch = 0);
+
+  // Decode a PNG / TGA file and add it. Load-time helper only (decodes synchronously).
+  bool AddImageFromFile(const std::string& name, const std::wstring& file_path);
+
+  // Pack all added images. Returns false if any image does not fit into an empty page.
+  bool Build(const TextureAtlasParams& params = TextureAtlasParams{});
+
+  const std::vector<Page>& GetPages() const {
+    return pages_;
+  }
+
+  const std::vector<Region>& GetRegions() const {
+    return regions_;
+  }
+
+  size_t GetImageCount() const {
+    return images_.size();
+  }
+
+  void Clear();
+
+ private:
+  struct SourceImage {
+    std::string name;
+    std::vector<uint8_t> pixels;  // RGBA8, tightly packed
+    UINT width = 0;
+    UINT height = 0;
+  };
+
+  std::vector<SourceImage> images_;
+  std::vector<Page> pages_;
+  std::vector<Region> regions_;
+
+  static void BlitWithExtrusion(
+    const SourceImage& image, Page& page, UINT cell_x, UINT cell_y, UINT cell_width, UINT cell_height, UINT padding);
+};
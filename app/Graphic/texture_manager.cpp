@@ -1,16 +1,58 @@
 #include "texture_manager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+
+#include "asset_archive.h"
+#include "deferred_release_queue.h"
+#include "fence_manager.h"
+#include "profiler.h"
+#include "texture_atlas.h"
+#include "thread_pool.h"
 #include "utils.h"
+#include "xxhash.h"
+
+namespace {
+// Cache spelling of a path: absolute, "." / ".." resolved, '/'-separated and ASCII-lowercased (Windows
+// paths ignore case)
+std::string NormalizeTexturePath(const std::wstring& file_path) {
+  std::error_code error;
+  std::filesystem::path path = std::filesystem::absolute(file_path, error);
+  if (error) {
+    path = file_path;
+  }
+  std::string normalized = NormalizeAssetPath(path.lexically_normal());
+  std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  });
+  return normalized;
+}
+
+// XXH64 of the bytes a texture decodes from, seeded with force_srgb (the same bytes load differently with
+// it); never 0, which marks "no key". Identical keys are trusted: 64-bit collisions are not a practical risk.
+uint64_t ComputeContentKey(const AssetBlob& blob, bool force_srgb) {
+  const uint64_t hash = XxHash64(blob.data, blob.size, force_srgb ? 1 : 0);
+  return hash != 0 ? hash : 1;
+}
+}  // namespace
 
-bool TextureManager::Initialize(ID3D12Device* device, DescriptorHeapAllocator* srv_allocator, uint32_t max_textures) {
+bool TextureManager::Initialize(ID3D12Device* device,
+  DescriptorHeapAllocator* srv_allocator,
+  const FenceManager* fence_manager,
+  DeferredReleaseQueue* release_queue,
+  uint32_t max_textures) {
   assert(device != nullptr);
   assert(srv_allocator != nullptr);
   assert(max_textures > 0);
+  assert((fence_manager == nullptr) == (release_queue == nullptr));
 
   device_ = device;
   srv_allocator_ = srv_allocator;
+  fence_manager_ = fence_manager;
+  release_queue_ = release_queue;
   max_textures_ = max_textures;
 
   // Pre-allocate slots
@@ -30,15 +72,17 @@ bool TextureManager::Initialize(ID3D12Device* device, DescriptorHeapAllocator* s
   return true;
 }
 
-TextureHandle TextureManager::LoadTexture(ID3D12GraphicsCommandList* command_list, const TextureLoadParams& params) {
-  assert(command_list != nullptr);
+TextureHandle TextureManager::LoadTexture(UploadBatch& batch, const TextureLoadParams& params) {
+  PROFILE_SCOPE("TextureManager::LoadTexture");
 
   // Check cache first
-  auto cache_it = cache_.find(params);
+  const uint64_t cache_key = GetCacheKey(params);
+  auto cache_it = cache_.find(cache_key);
   if (cache_it != cache_.end()) {
     TextureHandle cached_handle = cache_it->second;
     if (ValidateHandle(cached_handle)) {
       ++cache_hits_;
+      ReferenceCached(cached_handle.index);
       std::wcout << L"[TextureManager] Cache hit: " << params.file_path << '\n';
       return cached_handle;
     }
@@ -48,19 +92,40 @@ TextureHandle TextureManager::LoadTexture(ID3D12GraphicsCommandList* command_lis
 
   ++cache_misses_;
 
+  AssetBlob source;
+  std::string source_name;
+  if (!Texture::OpenSource(params.file_path, asset_archive_, source, source_name)) {
+    std::wcerr << L"[TextureManager] Failed to load texture: " << params.file_path << '\n';
+    return INVALID_TEXTURE_HANDLE;
+  }
+  const uint64_t content_key = deduplicate_content_ ? ComputeContentKey(source, params.force_srgb) : 0;
+
   // Allocate new slot
   TextureHandle handle = AllocateSlot();
   if (!handle.IsValid()) {
     std::cerr << "[TextureManager] Failed to allocate slot for texture" << '\n';
     return INVALID_TEXTURE_HANDLE;
   }
-
-  // Create texture object
   TextureSlot& slot = slots_[handle.index];
-  slot.texture = std::make_unique<Texture>();
+  slot.debug_name = params.file_path;
 
-  // Load texture from file
-  bool success = slot.texture->LoadFromFile(device_, command_list, params.file_path, *srv_allocator_);
+  // Byte-identical to a loaded file: bind its texture instead of uploading a copy
+  if (const TextureHandle owner = FindContent(content_key); owner.IsValid()) {
+    ShareTexture(handle.index, owner.index);
+    AddToCache(handle.index, cache_key);
+    std::wcout << L"[TextureManager] Shared texture: " << params.file_path << L" [" << handle.index << L":" << handle.generation
+               << L"] -> [" << owner.index << L":" << owner.generation << L"]" << '\n';
+    return handle;
+  }
+
+  // Create texture object; the batch owns it too until the upload completes, so a failure below can retire
+  // it on the direct queue while the copy is still pending
+  slot.texture = std::make_shared<Texture>();
+  batch.Track(slot.texture);
+
+  // Decode and create the SRV
+  bool success = slot.texture->DecodeFromMemory(device_, batch, source.data, source.size, source_name) &&
+                 slot.texture->CreateSRV(device_, *srv_allocator_);
 
   if (!success) {
     std::wcerr << L"[TextureManager] Failed to load texture: " << params.file_path << '\n';
@@ -68,12 +133,18 @@ TextureHandle TextureManager::LoadTexture(ID3D12GraphicsCommandList* command_lis
     return INVALID_TEXTURE_HANDLE;
   }
 
+  CreateStagingSRV(*slot.texture);
+  TrackMemory(slot);
+
   // Set debug name
-  slot.debug_name = params.file_path;
   slot.texture->SetDebugName(params.file_path);
 
   // Add to cache
-  cache_[params] = handle;
+  AddToCache(handle.index, cache_key);
+  if (content_key != 0) {
+    slot.content_key = content_key;
+    content_cache_[content_key] = handle;
+  }
 
   std::wcout << L"[TextureManager] Loaded texture: " << params.file_path << L" [" << handle.index << L":" << handle.generation << L"]"
              << '\n';
@@ -81,11 +152,133 @@ TextureHandle TextureManager::LoadTexture(ID3D12GraphicsCommandList* command_lis
   return handle;
 }
 
-TextureHandle TextureManager::CreateTexture(
-  ID3D12GraphicsCommandList* command_list, const void* pixel_data, UINT width, UINT height, DXGI_FORMAT format, UINT row_pitch) {
-  assert(command_list != nullptr);
+TextureHandle TextureManager::LoadTextureAsync(const TextureLoadParams& params, TextureLoadCallback callback) {
+  PROFILE_SCOPE("TextureManager::LoadTextureAsync");
+
+  if (thread_pool_ == nullptr || copy_queue_ == nullptr) {
+    std::cerr << "[TextureManager] Async loading is not configured (SetAsyncLoader)" << '\n';
+    return INVALID_TEXTURE_HANDLE;
+  }
+
+  // Cache hit: the texture is loaded already or its load is in flight
+  const uint64_t cache_key = GetCacheKey(params);
+  auto cache_it = cache_.find(cache_key);
+  if (cache_it != cache_.end()) {
+    TextureHandle cached_handle = cache_it->second;
+    if (ValidateHandle(cached_handle)) {
+      ++cache_hits_;
+      ReferenceCached(cached_handle.index);
+      TextureSlot& slot = slots_[cached_handle.index];
+      if (callback) {
+        if (slot.load_state == TextureLoadState::Loading) {
+          slot.load_callbacks.push_back(std::move(callback));
+        } else {
+          callback(cached_handle, slot.load_state == TextureLoadState::Ready);
+        }
+      }
+      return cached_handle;
+    }
+    cache_.erase(cache_it);
+  }
+
+  ++cache_misses_;
+
+  TextureHandle handle = AllocateSlot();
+  if (!handle.IsValid()) {
+    std::cerr << "[TextureManager] Failed to allocate slot for texture" << '\n';
+    return INVALID_TEXTURE_HANDLE;
+  }
+
+  TextureSlot& slot = slots_[handle.index];
+  slot.load_state = TextureLoadState::Loading;
+  slot.debug_name = params.file_path;
+  if (callback) {
+    slot.load_callbacks.push_back(std::move(callback));
+  }
+  AddToCache(handle.index, cache_key);
+  ++pending_loads_;
+  ++async_loads_;
+
+  auto load = std::make_unique<AsyncLoad>();
+  load->handle = handle;
+  load->file_path = params.file_path;
+  load->force_srgb = params.force_srgb;
+  load->hash_content = deduplicate_content_;
+
+  // Decode and record on a batch of the worker's own; only the render thread touches slots
+  thread_pool_->Submit([this, load = std::move(load)]() mutable {
+    PROFILE_SCOPE("TextureManager::AsyncLoad");
+    UploadBatch* batch = copy_queue_->Begin();
+    if (batch != nullptr) {
+      AssetBlob source;
+      std::string source_name;
+      auto texture = std::make_shared<Texture>();
+      batch->Track(texture);
+      if (Texture::OpenSource(load->file_path, asset_archive_, source, source_name) &&
+          texture->DecodeFromMemory(device_, *batch, source.data, source.size, source_name)) {
+        load->texture = std::move(texture);
+        load->content_key = load->hash_content ? ComputeContentKey(source, load->force_srgb) : 0;
+      }
+      load->ticket = copy_queue_->Submit(batch);
+    }
+
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    completed_loads_.push_back(std::move(load));
+  });
+
+  return handle;
+}
+
+void TextureManager::ProcessAsyncLoads() {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    for (std::unique_ptr<AsyncLoad>& load : completed_loads_) {
+      uploading_loads_.push_back(std::move(load));
+    }
+    completed_loads_.clear();
+  }
+  if (uploading_loads_.empty()) {
+    return;
+  }
+
+  PROFILE_SCOPE("TextureManager::ProcessAsyncLoads");
+
+  // Install only after the copy completed, so the first frame binding the texture never waits for it
+  const uint64_t completed_fence = copy_queue_->GetCompletedFenceValue();
+  size_t kept = 0;
+  for (size_t i = 0; i < uploading_loads_.size(); ++i) {
+    if (uploading_loads_[i]->texture == nullptr || uploading_loads_[i]->ticket.fence_value <= completed_fence) {
+      CompleteAsyncLoad(std::move(uploading_loads_[i]));
+    } else if (kept != i) {
+      uploading_loads_[kept++] = std::move(uploading_loads_[i]);
+    } else {
+      ++kept;
+    }
+  }
+  uploading_loads_.resize(kept);
+}
+
+TextureLoadState TextureManager::GetLoadState(TextureHandle handle) const {
+  if (!ValidateHandle(handle)) {
+    return TextureLoadState::Failed;
+  }
+  return slots_[handle.index].load_state;
+}
+
+TextureHandle TextureManager::CreateTexture(UploadBatch& batch,
+  const void* pixel_data,
+  UINT width,
+  UINT height,
+  DXGI_FORMAT format,
+  UINT row_pitch,
+  const TextureMipOptions& mip_options) {
   assert(pixel_data != nullptr);
 
+  std::vector<Image> mips;
+  if (mip_options.generate) {
+    GenerateMips(pixel_data, width, height, format, row_pitch, mip_options, mips);
+  }
+
   // Allocate new slot
   TextureHandle handle = AllocateSlot();
   if (!handle.IsValid()) {
@@ -95,10 +288,31 @@ TextureHandle TextureManager::CreateTexture(
 
   // Create texture object
   TextureSlot& slot = slots_[handle.index];
-  slot.texture = std::make_unique<Texture>();
-
-  // Load texture from memory
-  bool success = slot.texture->LoadFromMemory(device_, command_list, pixel_data, width, height, format, *srv_allocator_, row_pitch);
+  slot.texture = std::make_shared<Texture>();
+  batch.Track(slot.texture);
+
+  // Load texture from memory (the mip chain is copied to staging memory while recording)
+  bool success = false;
+  if (mips.size() > 1) {
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources(mips.size());
+    for (size_t level = 0; level < mips.size(); ++level) {
+      subresources[level].pData = mips[level].pixels.data();
+      subresources[level].RowPitch = mips[level].GetRowPitch();
+      subresources[level].SlicePitch = mips[level].GetRowPitch() * mips[level].height;
+    }
+    success = slot.texture->LoadMipChainFromMemory(device_,
+      batch,
+      subresources.data(),
+      static_cast<UINT>(subresources.size()),
+      width,
+      height,
+      format,
+      *srv_allocator_,
+      memory_allocator_);
+  } else {
+    success = slot.texture->LoadFromMemory(
+      device_, batch, pixel_data, width, height, format, *srv_allocator_, row_pitch, memory_allocator_);
+  }
 
   if (!success) {
     std::cerr << "[TextureManager] Failed to create procedural texture" << '\n';
@@ -106,6 +320,9 @@ TextureHandle TextureManager::CreateTexture(
     return INVALID_TEXTURE_HANDLE;
   }
 
+  CreateStagingSRV(*slot.texture);
+  TrackMemory(slot);
+
   // Set debug name
   slot.debug_name = L"ProceduralTexture_" + std::to_wstring(handle.index);
   slot.texture->SetDebugName(slot.debug_name);
@@ -116,13 +333,12 @@ TextureHandle TextureManager::CreateTexture(
 }
 
 TextureHandle TextureManager::CreateTextureFromMemory(
-    ID3D12GraphicsCommandList* command_list,
+    UploadBatch& batch,
     const void* data,
     UINT width,
     UINT height,
     DXGI_FORMAT format,
     const std::string& name) {
-  assert(command_list != nullptr);
   assert(data != nullptr);
 
   // Enforce required format
@@ -140,10 +356,11 @@ TextureHandle TextureManager::CreateTextureFromMemory(
 
   // Create texture object
   TextureSlot& slot = slots_[handle.index];
-  slot.texture = std::make_unique<Texture>();
+  slot.texture = std::make_shared<Texture>();
+  batch.Track(slot.texture);
 
-  // provided command list. It will not execute/submit the command list.
-  bool success = slot.texture->LoadFromMemory(device_, command_list, data, width, height, format, *srv_allocator_);
+  // Records the copy on the batch; the caller submits it
+  bool success = slot.texture->LoadFromMemory(device_, batch, data, width, height, format, *srv_allocator_, 0, memory_allocator_);
 
   if (!success) {
     std::cerr << "[TextureManager] Failed to create texture from memory" << '\n';
@@ -151,6 +368,9 @@ TextureHandle TextureManager::CreateTextureFromMemory(
     return INVALID_TEXTURE_HANDLE;
   }
 
+  CreateStagingSRV(*slot.texture);
+  TrackMemory(slot);
+
   // Set debug name
   slot.debug_name = utils::Utf8ToWstring(name);
   slot.texture->SetDebugName(slot.debug_name);
@@ -170,10 +390,10 @@ TextureHandle TextureManager::CreateEmptyTexture(UINT width, UINT height, DXGI_F
 
   // Create texture object
   TextureSlot& slot = slots_[handle.index];
-  slot.texture = std::make_unique<Texture>();
+  slot.texture = std::make_shared<Texture>();
 
   // Create empty texture
-  bool success = slot.texture->Create(device_, width, height, format, *srv_allocator_, flags);
+  bool success = slot.texture->Create(device_, width, height, format, *srv_allocator_, flags, 1, 1, memory_allocator_);
 
   if (!success) {
     std::cerr << "[TextureManager] Failed to create empty texture" << '\n';
@@ -181,6 +401,9 @@ TextureHandle TextureManager::CreateEmptyTexture(UINT width, UINT height, DXGI_F
     return INVALID_TEXTURE_HANDLE;
   }
 
+  CreateStagingSRV(*slot.texture);
+  TrackMemory(slot);
+
   // Set debug name
   slot.debug_name = L"EmptyTexture_" + std::to_wstring(handle.index);
   slot.texture->SetDebugName(slot.debug_name);
@@ -190,6 +413,92 @@ TextureHandle TextureManager::CreateEmptyTexture(UINT width, UINT height, DXGI_F
   return handle;
 }
 
+bool TextureManager::CreateAtlas(UploadBatch& batch, const std::string& atlas_name, const TextureAtlasBuilder& builder) {
+  PROFILE_SCOPE("TextureManager::CreateAtlas");
+
+  if (atlas_pages_.find(atlas_name) != atlas_pages_.end()) {
+    std::cerr << "[TextureManager] Atlas already exists: " << atlas_name << '\n';
+    return false;
+  }
+
+  std::vector<TextureHandle> pages;
+  pages.reserve(builder.GetPages().size());
+
+  for (size_t i = 0; i < builder.GetPages().size(); ++i) {
+    const TextureAtlasBuilder::Page& page = builder.GetPages()[i];
+    TextureHandle handle = CreateTexture(batch, page.pixels.data(), page.width, page.height, DXGI_FORMAT_R8G8B8A8_UNORM);
+    if (!handle.IsValid()) {
+      std::cerr << "[TextureManager] Failed to create page " << i << " of atlas: " << atlas_name << '\n';
+      for (TextureHandle created : pages) {
+        ReleaseTexture(created);
+      }
+      return false;
+    }
+
+    TextureSlot& slot = slots_[handle.index];
+    slot.debug_name = utils::Utf8ToWstring("Atlas_" + atlas_name + "_" + std::to_string(i));
+    slot.texture->SetDebugName(slot.debug_name);
+    pages.push_back(handle);
+  }
+
+  for (const TextureAtlasBuilder::Region& region : builder.GetRegions()) {
+    if (atlas_regions_.find(region.name) != atlas_regions_.end()) {
+      std::cerr << "[TextureManager] Warning: Atlas region '" << region.name << "' already registered, overriding" << '\n';
+    }
+    atlas_regions_[region.name] = TextureRegion{pages[region.page_index], region.uv_transform};
+  }
+
+  std::cout << "[TextureManager] Created atlas '" << atlas_name << "' with " << pages.size() << " page(s), "
+            << builder.GetRegions().size() << " regions" << '\n';
+
+  atlas_pages_[atlas_name] = std::move(pages);
+  return true;
+}
+
+TextureRegion TextureManager::GetAtlasRegion(const std::string& region_name) const {
+  auto it = atlas_regions_.find(region_name);
+  if (it == atlas_regions_.end() || !ValidateHandle(it->second.texture)) {
+    return TextureRegion{};
+  }
+  return it->second;
+}
+
+std::vector<TextureHandle> TextureManager::GetAtlasPages(const std::string& atlas_name) const {
+  auto it = atlas_pages_.find(atlas_name);
+  return (it != atlas_pages_.end()) ? it->second : std::vector<TextureHandle>{};
+}
+
+void TextureManager::ReleaseAtlas(const std::string& atlas_name) {
+  auto it = atlas_pages_.find(atlas_name);
+  if (it == atlas_pages_.end()) {
+    return;
+  }
+
+  const std::vector<TextureHandle>& pages = it->second;
+  for (auto region_it = atlas_regions_.begin(); region_it != atlas_regions_.end();) {
+    if (std::find(pages.begin(), pages.end(), region_it->second.texture) != pages.end()) {
+      region_it = atlas_regions_.erase(region_it);
+    } else {
+      ++region_it;
+    }
+  }
+
+  for (TextureHandle page : pages) {
+    ReleaseTexture(page);
+  }
+
+  atlas_pages_.erase(it);
+}
+
+void TextureManager::AcquireTexture(TextureHandle handle) {
+  if (!ValidateHandle(handle)) {
+    std::cerr << "[TextureManager] Attempted to acquire invalid texture handle [" << handle.index << ":" << handle.generation << "]"
+              << '\n';
+    return;
+  }
+  ReferenceCached(handle.index);
+}
+
 void TextureManager::ReleaseTexture(TextureHandle handle) {
   if (!ValidateHandle(handle)) {
     std::cerr << "[TextureManager] Attempted to release invalid texture handle [" << handle.index << ":" << handle.generation << "]"
@@ -197,13 +506,23 @@ void TextureManager::ReleaseTexture(TextureHandle handle) {
     return;
   }
 
-  // Remove from cache if present
-  for (auto it = cache_.begin(); it != cache_.end();) {
-    if (it->second == handle) {
-      it = cache_.erase(it);
-    } else {
-      ++it;
-    }
+  TextureSlot& slot = slots_[handle.index];
+  if (slot.ref_count == 0) {
+    std::cerr << "[TextureManager] Texture released more often than acquired [" << handle.index << ":" << handle.generation << "]"
+              << '\n';
+    return;
+  }
+  if (slot.ref_count > 1) {
+    --slot.ref_count;
+    return;
+  }
+
+  // Last reference: a loaded file texture stays warm until evicted, so loading its path again is free
+  if (slot.cached && slot.load_state == TextureLoadState::Ready) {
+    slot.ref_count = 0;
+    LinkWarm(handle.index);
+    TrimWarmTextures();
+    return;
   }
 
   // Free the slot
@@ -212,31 +531,83 @@ void TextureManager::ReleaseTexture(TextureHandle handle) {
   std::cout << "[TextureManager] Released texture [" << handle.index << ":" << handle.generation << "]" << '\n';
 }
 
+void TextureManager::SetMemoryBudget(uint64_t budget_bytes) {
+  memory_budget_ = budget_bytes;
+  TrimWarmTextures();
+}
+
 Texture* TextureManager::GetTexture(TextureHandle handle) {
-  if (!ValidateHandle(handle)) {
-    return nullptr;
-  }
-  return slots_[handle.index].texture.get();
+  TextureSlot* slot = ResolveSlot(handle);
+  return (slot != nullptr) ? slot->texture.get() : nullptr;
 }
 
 const Texture* TextureManager::GetTexture(TextureHandle handle) const {
-  if (!ValidateHandle(handle)) {
-    return nullptr;
-  }
-  return slots_[handle.index].texture.get();
+  const TextureSlot* slot = ResolveSlot(handle);
+  return (slot != nullptr) ? slot->texture.get() : nullptr;
 }
 
 bool TextureManager::IsValid(TextureHandle handle) const {
   return ValidateHandle(handle);
 }
 
+uint32_t TextureManager::GetBindlessIndex(TextureHandle handle) const {
+  const TextureSlot* slot = ResolveSlot(handle);
+  if (slot == nullptr) {
+    slot = ResolveSlot(bindless_fallback_);
+    if (slot == nullptr) {
+      return 0;
+    }
+  }
+  return slot->texture->GetSRV().index;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE TextureManager::GetTableSource(TextureHandle handle) const {
+  const TextureSlot* slot = ResolveSlot(handle);
+  if (slot == nullptr) {
+    slot = ResolveSlot(bindless_fallback_);
+    if (slot == nullptr) {
+      return D3D12_CPU_DESCRIPTOR_HANDLE{0};
+    }
+  }
+  return slot->texture->GetStagingSRV().cpu;
+}
+
 void TextureManager::Clear() {
   // Clear cache
   cache_.clear();
+  path_ids_.clear();
+  content_cache_.clear();
+  atlas_pages_.clear();
+  atlas_regions_.clear();
+  bindless_fallback_ = INVALID_TEXTURE_HANDLE;
+  loading_placeholder_ = INVALID_TEXTURE_HANDLE;
+  failed_placeholder_ = INVALID_TEXTURE_HANDLE;
+
+  // The owner drains the thread pool and the GPU first; results not installed yet are simply dropped
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    completed_loads_.clear();
+  }
+  uploading_loads_.clear();
+  pending_loads_ = 0;
 
   // Reset all slots
   for (auto& slot : slots_) {
+    if (residency_manager_ != nullptr) {
+      residency_manager_->Unregister(slot.residency);
+    }
+    slot.residency = ResidencyManager::kInvalidHandle;
+    slot.gpu_size = 0;
     slot.texture.reset();
+    slot.load_state = TextureLoadState::Ready;
+    slot.load_callbacks.clear();
+    slot.ref_count = 0;
+    slot.cached = false;
+    slot.content_key = 0;
+    slot.shared_index = kNoSlot;
+    slot.share_count = 0;
+    slot.warm_prev = kNoSlot;
+    slot.warm_next = kNoSlot;
     slot.in_use = false;
     ++slot.generation;
   }
@@ -249,6 +620,13 @@ void TextureManager::Clear() {
   }
 
   active_count_ = 0;
+  gpu_memory_bytes_ = 0;
+  shared_textures_ = 0;
+  shared_memory_bytes_ = 0;
+  warm_head_ = kNoSlot;
+  warm_tail_ = kNoSlot;
+  warm_count_ = 0;
+  warm_memory_bytes_ = 0;
 
   std::cout << "[TextureManager] Cleared all textures" << '\n';
 }
@@ -258,6 +636,20 @@ void TextureManager::PrintStats() const {
   std::cout << "Active Textures: " << active_count_ << "/" << max_textures_ << '\n';
   std::cout << "Cache Hits: " << cache_hits_ << '\n';
   std::cout << "Cache Misses: " << cache_misses_ << '\n';
+  std::cout << "GPU Memory: " << (gpu_memory_bytes_ >> 10) << " KB" << '\n';
+  std::cout << "Memory Budget: ";
+  if (memory_budget_ > 0) {
+    std::cout << (memory_budget_ >> 20) << " MB" << '\n';
+  } else {
+    std::cout << "unlimited" << '\n';
+  }
+  std::cout << "Warm Textures: " << warm_count_ << " (" << (warm_memory_bytes_ >> 10) << " KB, revived " << warm_hits_ << ")" << '\n';
+  std::cout << "Evictions: " << evictions_ << " (" << (evicted_bytes_ >> 10) << " KB)" << '\n';
+  std::cout << "Interned Paths: " << path_ids_.size() << '\n';
+  std::cout << "Shared by Content: " << shared_textures_ << " handle(s), " << (shared_memory_bytes_ >> 10) << " KB saved"
+            << (deduplicate_content_ ? "" : " (deduplication off)") << '\n';
+  std::cout << "Atlases: " << atlas_pages_.size() << " (" << atlas_regions_.size() << " regions)" << '\n';
+  std::cout << "Async Loads: " << async_loads_ << " (failed " << async_failures_ << ", pending " << pending_loads_ << ")" << '\n';
 
   if (cache_hits_ + cache_misses_ > 0) {
     float hit_rate = static_cast<float>(cache_hits_) / static_cast<float>(cache_hits_ + cache_misses_) * 100.0f;
@@ -267,8 +659,118 @@ void TextureManager::PrintStats() const {
   std::cout << "==================================\n" << '\n';
 }
 
+uint64_t TextureManager::GetCacheKey(const TextureLoadParams& params) {
+  // Interned so that cache keys are small integers; ids stay valid until Clear
+  const uint32_t path_id =
+    path_ids_.try_emplace(NormalizeTexturePath(params.file_path), static_cast<uint32_t>(path_ids_.size())).first->second;
+  return (static_cast<uint64_t>(path_id) << 1) | (params.force_srgb ? 1 : 0);
+}
+
+void TextureManager::AddToCache(uint32_t index, uint64_t cache_key) {
+  TextureSlot& slot = slots_[index];
+  cache_[cache_key] = TextureHandle{index, slot.generation};
+  slot.cached = true;
+  slot.cache_key = cache_key;
+}
+
+void TextureManager::RemoveFromCache(TextureSlot& slot) {
+  if (slot.cached) {
+    cache_.erase(slot.cache_key);
+    slot.cached = false;
+  }
+}
+
+void TextureManager::ReferenceCached(uint32_t index) {
+  TextureSlot& slot = slots_[index];
+  if (slot.ref_count == 0) {
+    UnlinkWarm(index);
+    ++warm_hits_;
+  }
+  ++slot.ref_count;
+}
+
+void TextureManager::LinkWarm(uint32_t index) {
+  TextureSlot& slot = slots_[index];
+  slot.warm_prev = warm_tail_;
+  slot.warm_next = kNoSlot;
+  if (warm_tail_ != kNoSlot) {
+    slots_[warm_tail_].warm_next = index;
+  } else {
+    warm_head_ = index;
+  }
+  warm_tail_ = index;
+  ++warm_count_;
+  warm_memory_bytes_ += slot.gpu_size;
+}
+
+void TextureManager::UnlinkWarm(uint32_t index) {
+  TextureSlot& slot = slots_[index];
+  if (slot.warm_prev != kNoSlot) {
+    slots_[slot.warm_prev].warm_next = slot.warm_next;
+  } else {
+    warm_head_ = slot.warm_next;
+  }
+  if (slot.warm_next != kNoSlot) {
+    slots_[slot.warm_next].warm_prev = slot.warm_prev;
+  } else {
+    warm_tail_ = slot.warm_prev;
+  }
+  slot.warm_prev = kNoSlot;
+  slot.warm_next = kNoSlot;
+  --warm_count_;
+  warm_memory_bytes_ -= slot.gpu_size;
+}
+
+bool TextureManager::EvictWarmTexture() {
+  if (warm_head_ == kNoSlot) {
+    return false;
+  }
+  const uint32_t index = warm_head_;
+  const TextureHandle handle{index, slots_[index].generation};
+  const std::wstring name = slots_[index].debug_name;
+
+  // Freed like a released texture: the memory is retired through the release queue
+  const uint64_t memory_before = gpu_memory_bytes_;
+  FreeSlot(index);
+  ++evictions_;
+  evicted_bytes_ += memory_before - gpu_memory_bytes_;
+
+  std::wcout << L"[TextureManager] Evicted warm texture: " << name << L" [" << handle.index << L":" << handle.generation << L"]" << '\n';
+  return true;
+}
+
+void TextureManager::TrimWarmTextures() {
+  if (memory_budget_ == 0) {
+    return;
+  }
+  while (gpu_memory_bytes_ > memory_budget_ && EvictWarmTexture()) {
+  }
+}
+
+TextureHandle TextureManager::FindContent(uint64_t content_key) const {
+  if (content_key == 0) {
+    return INVALID_TEXTURE_HANDLE;
+  }
+  auto it = content_cache_.find(content_key);
+  // Owners are registered once their texture is loaded and removed when freed
+  return (it != content_cache_.end() && ValidateHandle(it->second)) ? it->second : INVALID_TEXTURE_HANDLE;
+}
+
+void TextureManager::ShareTexture(uint32_t index, uint32_t owner_index) {
+  TextureSlot& slot = slots_[index];
+  TextureSlot& owner = slots_[owner_index];
+  assert(owner.shared_index == kNoSlot && owner.load_state == TextureLoadState::Ready);
+
+  slot.shared_index = owner_index;
+  slot.load_state = TextureLoadState::Ready;
+  ++owner.share_count;
+  ++shared_textures_;
+  shared_memory_bytes_ += owner.gpu_size;
+}
+
 TextureHandle TextureManager::AllocateSlot() {
-  if (free_list_.empty()) {
+  // All slots taken: make room by evicting a warm texture
+  if (free_list_.empty() && !EvictWarmTexture()) {
     std::cerr << "[TextureManager] Out of texture slots! Capacity: " << max_textures_ << '\n';
     return INVALID_TEXTURE_HANDLE;
   }
@@ -280,6 +782,7 @@ TextureHandle TextureManager::AllocateSlot() {
   // Initialize slot
   TextureSlot& slot = slots_[index];
   slot.in_use = true;
+  slot.ref_count = 1;
   // Generation stays the same until freed
 
   ++active_count_;
@@ -292,6 +795,85 @@ TextureHandle TextureManager::AllocateSlot() {
   return handle;
 }
 
+void TextureManager::CreateStagingSRV(Texture& texture) {
+  if (staging_allocator_ == nullptr) {
+    return;
+  }
+  // Not fatal: without a staging SRV the texture is bound through its shader-visible SRV directly
+  if (!texture.CreateStagingSRV(device_, *staging_allocator_)) {
+    std::cerr << "[TextureManager] Staging SRV heap full; texture will not be copied into descriptor tables" << '\n';
+  }
+}
+
+void TextureManager::GenerateMips(const void* pixel_data,
+  UINT width,
+  UINT height,
+  DXGI_FORMAT format,
+  UINT row_pitch,
+  const TextureMipOptions& mip_options,
+  std::vector<Image>& out_mips) const {
+  PROFILE_SCOPE("TextureManager::GenerateMips");
+
+  MipGenerationOptions options;
+  options.filter = mip_options.filter;
+  options.alpha_mode = mip_options.alpha_mode;
+  options.pool = thread_pool_;
+  switch (format) {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+      options.srgb = false;
+      break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+      options.srgb = true;
+      break;
+    default:
+      std::cerr << "[TextureManager] Mip generation needs an 8-bit RGBA / BGRA format; uploading mip 0 only" << '\n';
+      return;
+  }
+
+  // The filters treat channel 3 as alpha and the others alike, so BGRA needs no swizzle
+  Image source;
+  source.Resize(width, height);
+  const UINT source_pitch = (row_pitch != 0) ? row_pitch : source.GetRowPitch();
+  const auto* source_rows = static_cast<const uint8_t*>(pixel_data);
+  for (UINT y = 0; y < height; ++y) {
+    std::memcpy(source.GetPixel(0, y), source_rows + static_cast<size_t>(y) * source_pitch, source.GetRowPitch());
+  }
+
+  GenerateMipChain(source, options, out_mips);
+}
+
+void TextureManager::TrackMemory(TextureSlot& slot) {
+  const Texture& texture = *slot.texture;
+  if (texture.IsPlaced()) {
+    slot.gpu_size = texture.GetMemoryAllocation().range.size;
+  } else {
+    const D3D12_RESOURCE_DESC desc = texture.GetDesc();
+    slot.gpu_size = device_->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+  }
+  gpu_memory_bytes_ += slot.gpu_size;
+
+  // Placed textures are accounted only; their heap page is the unit of residency
+  if (residency_manager_ != nullptr) {
+    slot.residency = residency_manager_->Register(texture.IsPlaced() ? nullptr : texture.GetResource(), slot.gpu_size);
+  }
+
+  // New textures are referenced; warm ones make room for them
+  TrimWarmTextures();
+}
+
+void TextureManager::MarkUsed(TextureHandle handle) {
+  TextureSlot* slot = ResolveSlot(handle);
+  if (slot == nullptr) {
+    return;
+  }
+  slot->texture->ResolvePendingUpload();
+  if (residency_manager_ != nullptr) {
+    residency_manager_->Touch(slot->residency);
+  }
+}
+
 void TextureManager::FreeSlot(uint32_t index) {
   assert(index < max_textures_);
 
@@ -302,8 +884,74 @@ void TextureManager::FreeSlot(uint32_t index) {
     return;
   }
 
-  // Destroy texture
-  slot.texture.reset();
+  // Warm texture being evicted
+  if (slot.ref_count == 0) {
+    UnlinkWarm(index);
+  }
+  slot.ref_count = 0;
+  RemoveFromCache(slot);
+
+  if (slot.shared_index != kNoSlot) {
+    // Drops only its reference: the texture belongs to the owner slot
+    TextureSlot& owner = slots_[slot.shared_index];
+    --owner.share_count;
+    --shared_textures_;
+    shared_memory_bytes_ -= owner.gpu_size;
+    slot.shared_index = kNoSlot;
+  } else if (slot.share_count > 0) {
+    // Hand the texture over to one of the slots sharing it; they keep their handles
+    uint32_t heir_index = kNoSlot;
+    for (uint32_t i = 0; i < max_textures_; ++i) {
+      if (slots_[i].in_use && slots_[i].shared_index == index) {
+        if (heir_index == kNoSlot) {
+          heir_index = i;
+        } else {
+          slots_[i].shared_index = heir_index;
+        }
+      }
+    }
+    assert(heir_index != kNoSlot);
+
+    TextureSlot& heir = slots_[heir_index];
+    heir.texture = std::move(slot.texture);
+    heir.gpu_size = slot.gpu_size;
+    heir.residency = slot.residency;
+    heir.content_key = slot.content_key;
+    heir.share_count = slot.share_count - 1;
+    heir.shared_index = kNoSlot;
+    heir.texture->SetDebugName(heir.debug_name);
+    if (heir.ref_count == 0) {
+      warm_memory_bytes_ += heir.gpu_size;
+    }
+    if (heir.content_key != 0) {
+      content_cache_[heir.content_key] = TextureHandle{heir_index, heir.generation};
+    }
+    --shared_textures_;
+    shared_memory_bytes_ -= slot.gpu_size;
+
+    slot.gpu_size = 0;
+    slot.residency = ResidencyManager::kInvalidHandle;
+    slot.content_key = 0;
+    slot.share_count = 0;
+  }
+  if (slot.content_key != 0) {
+    content_cache_.erase(slot.content_key);
+    slot.content_key = 0;
+  }
+
+  if (residency_manager_ != nullptr) {
+    residency_manager_->Unregister(slot.residency);
+  }
+  slot.residency = ResidencyManager::kInvalidHandle;
+  gpu_memory_bytes_ -= slot.gpu_size;
+  slot.gpu_size = 0;
+
+  if (slot.texture) {
+    RetireTexture(std::move(slot.texture));
+  }
+  // An async load still in flight is discarded when it completes (the generation no longer matches)
+  slot.load_state = TextureLoadState::Ready;
+  slot.load_callbacks.clear();
   slot.in_use = false;
   slot.debug_name.clear();
 
@@ -316,6 +964,107 @@ void TextureManager::FreeSlot(uint32_t index) {
   --active_count_;
 }
 
+void TextureManager::RetireTexture(std::shared_ptr<Texture> texture) {
+  // Retire texture and SRV once frames in flight no longer reference them. The release fence is a direct
+  // queue fence; a copy batch still writing the texture holds its own reference until the copy completes.
+  DescriptorHeapAllocator* srv_allocator = srv_allocator_;
+  DescriptorHeapAllocator* staging_allocator = staging_allocator_;
+  auto release = [srv_allocator, staging_allocator, texture = std::move(texture)]() mutable {
+    srv_allocator->Free(texture->GetSRV());
+    if (staging_allocator != nullptr) {
+      staging_allocator->Free(texture->GetStagingSRV());
+    }
+    texture.reset();
+  };
+  if (release_queue_ != nullptr) {
+    release_queue_->Enqueue(fence_manager_->GetCurrentFenceValue(), std::move(release));
+  } else {
+    release();
+  }
+}
+
+void TextureManager::CompleteAsyncLoad(std::unique_ptr<AsyncLoad> load) {
+  --pending_loads_;
+  const TextureHandle handle = load->handle;
+
+  // Released (or cleared) while loading: nobody binds the result
+  if (!ValidateHandle(handle) || slots_[handle.index].load_state != TextureLoadState::Loading) {
+    if (load->texture) {
+      RetireTexture(std::move(load->texture));
+    }
+    return;
+  }
+
+  TextureSlot& slot = slots_[handle.index];
+  std::shared_ptr<Texture> texture = std::move(load->texture);
+
+  // Byte-identical to a texture loaded meanwhile: bind that one and drop the duplicate upload
+  const TextureHandle owner = (texture != nullptr) ? FindContent(load->content_key) : INVALID_TEXTURE_HANDLE;
+  const bool loaded = owner.IsValid() || (texture != nullptr && texture->CreateSRV(device_, *srv_allocator_));
+
+  if (owner.IsValid()) {
+    RetireTexture(std::move(texture));
+    ShareTexture(handle.index, owner.index);
+
+    std::wcout << L"[TextureManager] Shared texture (async): " << load->file_path << L" [" << handle.index << L":" << handle.generation
+               << L"] -> [" << owner.index << L":" << owner.generation << L"]" << '\n';
+  } else if (loaded) {
+    // Swap the placeholder for the real views from the next bind on
+    slot.texture = std::move(texture);
+    slot.load_state = TextureLoadState::Ready;
+    CreateStagingSRV(*slot.texture);
+    TrackMemory(slot);
+    slot.texture->SetDebugName(slot.debug_name);
+    if (load->content_key != 0) {
+      slot.content_key = load->content_key;
+      content_cache_[load->content_key] = handle;
+    }
+
+    std::wcout << L"[TextureManager] Loaded texture (async): " << load->file_path << L" [" << handle.index << L":" << handle.generation
+               << L"]" << '\n';
+  } else {
+    if (texture) {
+      RetireTexture(std::move(texture));
+    }
+    slot.load_state = TextureLoadState::Failed;
+    ++async_failures_;
+
+    // The handle keeps binding the failed placeholder; a later load of the file tries again
+    RemoveFromCache(slot);
+
+    std::wcerr << L"[TextureManager] Failed to load texture (async): " << load->file_path << '\n';
+  }
+
+  // Callbacks may load or release textures, so run them from a local list
+  std::vector<TextureLoadCallback> callbacks = std::move(slot.load_callbacks);
+  slot.load_callbacks.clear();
+  for (TextureLoadCallback& callback : callbacks) {
+    callback(handle, loaded);
+  }
+}
+
+TextureManager::TextureSlot* TextureManager::ResolveSlot(TextureHandle handle) {
+  return const_cast<TextureSlot*>(static_cast<const TextureManager*>(this)->ResolveSlot(handle));
+}
+
+const TextureManager::TextureSlot* TextureManager::ResolveSlot(TextureHandle handle) const {
+  if (!ValidateHandle(handle)) {
+    return nullptr;
+  }
+
+  const TextureSlot& slot = slots_[handle.index];
+  if (slot.load_state == TextureLoadState::Ready) {
+    return (slot.shared_index != kNoSlot) ? &slots_[slot.shared_index] : &slot;
+  }
+
+  // Async load not ready: bind its placeholder
+  const TextureHandle placeholder = (slot.load_state == TextureLoadState::Loading) ? loading_placeholder_ : failed_placeholder_;
+  if (!ValidateHandle(placeholder) || slots_[placeholder.index].load_state != TextureLoadState::Ready) {
+    return nullptr;
+  }
+  return &slots_[placeholder.index];
+}
+
 bool TextureManager::ValidateHandle(TextureHandle handle) const {
   if (!handle.IsValid()) {
     return false;
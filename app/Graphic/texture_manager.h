@@ -1,15 +1,21 @@
 #pragma once
 
+#include <DirectXMath.h>
 #include <d3d12.h>
 #include <dxgiformat.h>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "copy_queue.h"
 #include "descriptor_heap_allocator.h"
+#include "mip_generator.h"
+#include "residency_manager.h"
 #include "texture.h"
 
 // Lightweight handle for texture references
@@ -35,6 +41,25 @@ struct TextureHandle {
 // Invalid handle constant
 inline constexpr TextureHandle INVALID_TEXTURE_HANDLE = {TextureHandle::INVALID_INDEX, 0};
 
+// Sub-rectangle of a (possibly shared) texture, e.g. one image inside an atlas page.
+// uv_transform uses the same (offset.xy, scale.xy) layout as RenderPacket::uv_transform.
+struct TextureRegion {
+  TextureHandle texture = INVALID_TEXTURE_HANDLE;
+  DirectX::XMFLOAT4 uv_transform = {0.0f, 0.0f, 1.0f, 1.0f};
+
+  bool IsValid() const {
+    return texture.IsValid();
+  }
+
+  // Remap a sprite-local uv_transform into this region
+  DirectX::XMFLOAT4 Apply(const DirectX::XMFLOAT4& local_uv_transform) const {
+    return {uv_transform.x + local_uv_transform.x * uv_transform.z,
+      uv_transform.y + local_uv_transform.y * uv_transform.w,
+      local_uv_transform.z * uv_transform.z,
+      local_uv_transform.w * uv_transform.w};
+  }
+};
+
 // Texture loading parameters for cache key
 struct TextureLoadParams {
   std::wstring file_path;
@@ -57,6 +82,29 @@ struct hash<TextureLoadParams> {
 };
 }  // namespace std
 
+class AssetArchive;
+class DeferredReleaseQueue;
+class DescriptorTableRing;
+class FenceManager;
+class TextureAtlasBuilder;
+class ThreadPool;
+
+enum class TextureLoadState : uint8_t {
+  Ready,    // Texture data bound
+  Loading,  // Async load in flight; binds the loading placeholder
+  Failed,   // Async load failed; binds the failed placeholder until released
+};
+
+// CPU mip chain generation for CreateTexture (8-bit RGBA / BGRA formats; *_SRGB formats filter in linear space)
+struct TextureMipOptions {
+  bool generate = false;
+  MipFilter filter = MipFilter::Box;
+  MipAlphaMode alpha_mode = MipAlphaMode::Straight;
+};
+
+// Runs on the render thread once an async load finished (loaded == false: the handle shows the failed placeholder)
+using TextureLoadCallback = std::function<void(TextureHandle handle, bool loaded)>;
+
 class TextureManager {
  public:
   TextureManager() = default;
@@ -65,36 +113,158 @@ class TextureManager {
   TextureManager(const TextureManager&) = delete;
   TextureManager& operator=(const TextureManager&) = delete;
 
-  // Initialize with device and descriptor allocator
-  bool Initialize(ID3D12Device* device, DescriptorHeapAllocator* srv_allocator, uint32_t max_textures = 1024);
+  // Initialize with device and descriptor allocator.
+  // With a release queue, released textures and their SRVs are kept alive until the GPU passes the
+  // fence value current at release time; without one they are destroyed immediately.
+  bool Initialize(ID3D12Device* device,
+    DescriptorHeapAllocator* srv_allocator,
+    const FenceManager* fence_manager = nullptr,
+    DeferredReleaseQueue* release_queue = nullptr,
+    uint32_t max_textures = 1024);
+
+  // Uploads are recorded on a copy queue batch and are not submitted here. The handle is usable right
+  // away; the first frame that binds the texture waits (on the GPU) for the batch.
+  //
+  // Handles are reference counted: every load or create returns a handle holding one reference, and
+  // every reference (including those added with AcquireTexture) is dropped with one ReleaseTexture.
+  // When the last reference of a texture loaded from a file goes, it stays loaded as an unreferenced
+  // ("warm") texture, so loading the same path again is free; warm textures are evicted least recently
+  // released first once texture memory exceeds the budget or all slots are taken. Other textures are
+  // released with their last reference.
 
   // Load texture from file with caching
-  // Returns existing handle if already loaded with same parameters
-  TextureHandle LoadTexture(ID3D12GraphicsCommandList* command_list, const TextureLoadParams& params);
+  // Returns existing handle if already loaded with same parameters. Paths are compared normalized
+  // (absolute, "." / ".." resolved, either separator, ASCII case ignored), so every spelling of one file
+  // maps to the same handle.
+  TextureHandle LoadTexture(UploadBatch& batch, const TextureLoadParams& params);
+
+  // Returns a handle right away; the file is decoded on a worker thread and uploaded on its own copy batch.
+  // Until ProcessAsyncLoads installs the texture (after its copy completed), the handle binds as the
+  // loading placeholder. Shares the cache with LoadTexture. The callback runs on the render thread, from
+  // ProcessAsyncLoads or immediately when the cached texture is already loaded.
+  TextureHandle LoadTextureAsync(const TextureLoadParams& params, TextureLoadCallback callback = nullptr);
+
+  // Install finished async loads and run their callbacks (render thread, once per frame)
+  void ProcessAsyncLoads();
+
+  // Polling for async loads (invalid handles report Failed)
+  TextureLoadState GetLoadState(TextureHandle handle) const;
+  bool IsLoaded(TextureHandle handle) const {
+    return GetLoadState(handle) == TextureLoadState::Ready;
+  }
+
+  // Required by LoadTextureAsync. Jobs use this manager, so the pool must be drained before it is cleared.
+  void SetAsyncLoader(ThreadPool* thread_pool, CopyQueue* copy_queue) {
+    thread_pool_ = thread_pool;
+    copy_queue_ = copy_queue;
+  }
+
+  // Optional: packed content (tools/asset_packer) searched before loose files; read by loader jobs, so it
+  // must stay open while they run
+  void SetAssetArchive(const AssetArchive* archive) {
+    asset_archive_ = archive;
+  }
+
+  // Optional: hash the bytes of each loaded file (XXH64) so that byte-identical files under different
+  // paths share one texture. Each path keeps its own handle; the shared texture lives until the last of
+  // them is released. Async duplicates are still decoded and uploaded, then dropped when installed.
+  void SetContentDeduplication(bool enabled) {
+    deduplicate_content_ = enabled;
+  }
 
-  // Create procedural texture (non-cached)
-  TextureHandle CreateTexture(
-    ID3D12GraphicsCommandList* command_list, const void* pixel_data, UINT width, UINT height, DXGI_FORMAT format, UINT row_pitch = 0);
+  // Textures bound in place of async loads that are in flight / failed
+  void SetLoadPlaceholders(TextureHandle loading, TextureHandle failed) {
+    loading_placeholder_ = loading;
+    failed_placeholder_ = failed;
+  }
 
-  // Create a texture from CPU memory. Records copy and transition to
-  // PIXEL_SHADER_RESOURCE on the provided command list but does NOT
-  // execute/submit the command list.
+  // Create procedural texture (non-cached). With mip_options.generate the full mip chain is generated on
+  // the CPU (on the async loader's pool when set) and uploaded with mip 0.
+  TextureHandle CreateTexture(UploadBatch& batch,
+    const void* pixel_data,
+    UINT width,
+    UINT height,
+    DXGI_FORMAT format,
+    UINT row_pitch = 0,
+    const TextureMipOptions& mip_options = {});
+
+  // Create a texture from CPU memory
   TextureHandle CreateTextureFromMemory(
-    ID3D12GraphicsCommandList* command_list, const void* data, UINT width, UINT height, DXGI_FORMAT format, const std::string& name);
+    UploadBatch& batch, const void* data, UINT width, UINT height, DXGI_FORMAT format, const std::string& name);
 
   // Create empty texture with specified parameters (non-cached)
   TextureHandle CreateEmptyTexture(UINT width, UINT height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE);
 
-  // Release texture by handle
+  // Optional: place new textures in shared heaps instead of committed resources
+  void SetGpuMemoryAllocator(GpuMemoryAllocator* memory_allocator) {
+    memory_allocator_ = memory_allocator;
+  }
+
+  // Optional: give every texture a second SRV in a CPU-only staging heap, and a per-frame ring to build
+  // descriptor tables from them (MaterialInstance::Bind copies instead of pointing at single SRVs).
+  void SetDescriptorTableSources(DescriptorHeapAllocator* staging_allocator, DescriptorTableRing* table_ring) {
+    staging_allocator_ = staging_allocator;
+    table_ring_ = table_ring;
+  }
+  // Optional: account texture memory and let cold textures be evicted under memory pressure
+  void SetResidencyManager(ResidencyManager* residency_manager) {
+    residency_manager_ = residency_manager;
+  }
+
+  // Called when a texture is bound for drawing (keeps it resident; restores it if it was evicted, and
+  // makes the frame wait for its upload the first time)
+  void MarkUsed(TextureHandle handle);
+
+  DescriptorTableRing* GetDescriptorTableRing() const {
+    return table_ring_;
+  }
+  // Staging SRV of a texture (the bindless fallback for invalid handles); null handle if there is none
+  D3D12_CPU_DESCRIPTOR_HANDLE GetTableSource(TextureHandle handle) const;
+
+  // Upload the pages of a built atlas (non-cached) and register every packed image as a named region.
+  // Sprites using regions of the same page share one texture, so they sort and batch together.
+  bool CreateAtlas(UploadBatch& batch, const std::string& atlas_name, const TextureAtlasBuilder& builder);
+
+  // Look up a packed image by name (invalid region if unknown)
+  TextureRegion GetAtlasRegion(const std::string& region_name) const;
+
+  // Page handles of an atlas (empty if unknown)
+  std::vector<TextureHandle> GetAtlasPages(const std::string& atlas_name) const;
+
+  // Release all pages of an atlas and forget its regions
+  void ReleaseAtlas(const std::string& atlas_name);
+
+  // Add a reference, e.g. for a material binding the texture (revives a warm texture)
+  void AcquireTexture(TextureHandle handle);
+
+  // Drop a reference. Do not use the handle after dropping its last reference: it is invalid right away,
+  // or once its warm texture is evicted. GPU memory is retired via the release queue.
   void ReleaseTexture(TextureHandle handle);
 
-  // Get texture pointer (nullptr if invalid)
+  // Texture memory above which warm textures are evicted (0 = unlimited, the default). Referenced
+  // textures are never evicted, so the total may still exceed the budget.
+  void SetMemoryBudget(uint64_t budget_bytes);
+
+  // Get texture pointer (nullptr if invalid; the placeholder while an async load is not ready)
   Texture* GetTexture(TextureHandle handle);
   const Texture* GetTexture(TextureHandle handle) const;
 
   // Validate handle
   bool IsValid(TextureHandle handle) const;
 
+  // Bindless: every texture SRV lives at a stable index of one shader-visible table
+  // (the static SRV region). Invalid handles resolve to the fallback texture, or 0 if none is set.
+  uint32_t GetBindlessIndex(TextureHandle handle) const;
+  void SetBindlessFallback(TextureHandle handle) {
+    bindless_fallback_ = handle;
+  }
+  D3D12_GPU_DESCRIPTOR_HANDLE GetBindlessTableStart() const {
+    return srv_allocator_->GetGpuBase();
+  }
+  uint32_t GetBindlessTableSize() const {
+    return srv_allocator_->GetCapacity();
+  }
+
   // Clear all textures
   void Clear();
 
@@ -111,34 +281,162 @@ class TextureManager {
   uint32_t GetCacheMisses() const {
     return cache_misses_;
   }
+  // Video memory of all live textures (allocation sizes, including placement padding)
+  uint64_t GetGpuMemoryBytes() const {
+    return gpu_memory_bytes_;
+  }
+  uint32_t GetRefCount(TextureHandle handle) const {
+    return ValidateHandle(handle) ? slots_[handle.index].ref_count : 0;
+  }
+  // Unreferenced textures kept loaded, and their video memory
+  uint32_t GetWarmTextureCount() const {
+    return warm_count_;
+  }
+  uint64_t GetWarmMemoryBytes() const {
+    return warm_memory_bytes_;
+  }
+  // Handles currently sharing another handle's texture, and the video memory that saves
+  uint32_t GetSharedTextureCount() const {
+    return shared_textures_;
+  }
+  uint64_t GetSharedMemoryBytes() const {
+    return shared_memory_bytes_;
+  }
+  // Async loads not installed yet (including loads of handles released meanwhile)
+  uint32_t GetPendingLoadCount() const {
+    return pending_loads_;
+  }
 
   void PrintStats() const;
 
  private:
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
   struct TextureSlot {
-    std::unique_ptr<Texture> texture = nullptr;
+    std::shared_ptr<Texture> texture = nullptr;  // Shared with copy batches until their uploads complete
     uint32_t generation = 0;
     bool in_use = false;
     std::wstring debug_name;
+    uint64_t gpu_size = 0;
+    ResidencyManager::Handle residency = ResidencyManager::kInvalidHandle;
+    TextureLoadState load_state = TextureLoadState::Ready;  // texture is null unless Ready
+    std::vector<TextureLoadCallback> load_callbacks;
+    uint32_t ref_count = 0;           // Warm (in the warm list) when 0 while in use
+    bool cached = false;              // cache_key is in cache_
+    uint64_t cache_key = 0;
+    uint64_t content_key = 0;         // content_cache_ entry this slot owns (0 if none)
+    uint32_t shared_index = kNoSlot;  // Slot whose texture this one binds (its own texture is null)
+    uint32_t share_count = 0;         // Slots binding this slot's texture
+    uint32_t warm_prev = kNoSlot;     // Warm list links
+    uint32_t warm_next = kNoSlot;
+  };
+
+  // One LoadTextureAsync request; owned by its worker job until pushed to completed_loads_
+  struct AsyncLoad {
+    TextureHandle handle = INVALID_TEXTURE_HANDLE;
+    std::wstring file_path;
+    bool force_srgb = false;
+    bool hash_content = false;
+    uint64_t content_key = 0;          // Set by the worker when hash_content
+    std::shared_ptr<Texture> texture;  // Null when decoding failed
+    UploadTicket ticket;
   };
 
   ID3D12Device* device_ = nullptr;
   DescriptorHeapAllocator* srv_allocator_ = nullptr;
+  DescriptorHeapAllocator* staging_allocator_ = nullptr;
+  DescriptorTableRing* table_ring_ = nullptr;
+  GpuMemoryAllocator* memory_allocator_ = nullptr;
+  ResidencyManager* residency_manager_ = nullptr;
+  const FenceManager* fence_manager_ = nullptr;
+  DeferredReleaseQueue* release_queue_ = nullptr;
   uint32_t max_textures_ = 0;
 
   std::vector<TextureSlot> slots_;
   std::vector<uint32_t> free_list_;
 
-  // Cache: maps loading parameters to handle
-  std::unordered_map<TextureLoadParams, TextureHandle> cache_;
+  // Cache: maps loading parameters (interned normalized path, force_srgb) to handle
+  std::unordered_map<uint64_t, TextureHandle> cache_;
+  std::unordered_map<std::string, uint32_t> path_ids_;
+
+  // Content cache: XXH64 of a file's bytes (seeded with force_srgb) -> handle owning the texture
+  std::unordered_map<uint64_t, TextureHandle> content_cache_;
+  bool deduplicate_content_ = false;
+
+  // Atlases: atlas name -> page handles, region name -> region
+  std::unordered_map<std::string, std::vector<TextureHandle>> atlas_pages_;
+  std::unordered_map<std::string, TextureRegion> atlas_regions_;
+
+  TextureHandle bindless_fallback_ = INVALID_TEXTURE_HANDLE;
+
+  // Async loading
+  ThreadPool* thread_pool_ = nullptr;
+  CopyQueue* copy_queue_ = nullptr;
+  const AssetArchive* asset_archive_ = nullptr;
+  TextureHandle loading_placeholder_ = INVALID_TEXTURE_HANDLE;
+  TextureHandle failed_placeholder_ = INVALID_TEXTURE_HANDLE;
+  std::mutex async_mutex_;
+  std::vector<std::unique_ptr<AsyncLoad>> completed_loads_;  // Decoded and submitted (async_mutex_)
+  std::vector<std::unique_ptr<AsyncLoad>> uploading_loads_;  // Waiting for their copy (render thread)
+  uint32_t pending_loads_ = 0;
+  uint32_t async_loads_ = 0;
+  uint32_t async_failures_ = 0;
 
   uint32_t active_count_ = 0;
   uint32_t cache_hits_ = 0;
   uint32_t cache_misses_ = 0;
+  uint64_t gpu_memory_bytes_ = 0;
+  uint32_t shared_textures_ = 0;
+  uint64_t shared_memory_bytes_ = 0;
+
+  // Warm textures, least recently released first
+  uint32_t warm_head_ = kNoSlot;
+  uint32_t warm_tail_ = kNoSlot;
+  uint32_t warm_count_ = 0;
+  uint64_t warm_memory_bytes_ = 0;
+  uint64_t memory_budget_ = 0;
+  uint32_t warm_hits_ = 0;
+  uint32_t evictions_ = 0;
+  uint64_t evicted_bytes_ = 0;
+
+  uint64_t GetCacheKey(const TextureLoadParams& params);
+  void AddToCache(uint32_t index, uint64_t cache_key);
+  void RemoveFromCache(TextureSlot& slot);
+
+  // Cache hit on a slot: one more reference, taking a warm texture out of the warm list
+  void ReferenceCached(uint32_t index);
+  void LinkWarm(uint32_t index);
+  void UnlinkWarm(uint32_t index);
+  // Evict the least recently released warm texture (false if there is none)
+  bool EvictWarmTexture();
+  // Evict warm textures while texture memory exceeds the budget
+  void TrimWarmTextures();
+
+  // Owner of a loaded texture with these contents (invalid handle if none)
+  TextureHandle FindContent(uint64_t content_key) const;
+  // Let slot index bind the texture of slot owner_index
+  void ShareTexture(uint32_t index, uint32_t owner_index);
 
   // Internal allocation
   TextureHandle AllocateSlot();
+  void CreateStagingSRV(Texture& texture);
+  void TrackMemory(TextureSlot& slot);
   void FreeSlot(uint32_t index);
+  void RetireTexture(std::shared_ptr<Texture> texture);
+  void CompleteAsyncLoad(std::unique_ptr<AsyncLoad> load);
+
+  // Mip chain of 8-bit RGBA / BGRA pixels (empty for other formats)
+  void GenerateMips(const void* pixel_data,
+    UINT width,
+    UINT height,
+    DXGI_FORMAT format,
+    UINT row_pitch,
+    const TextureMipOptions& mip_options,
+    std::vector<Image>& out_mips) const;
+
+  // Slot to bind for a handle: its own, or a placeholder while an async load is not ready (nullptr if none)
+  TextureSlot* ResolveSlot(TextureHandle handle);
+  const TextureSlot* ResolveSlot(TextureHandle handle) const;
 
   // Validation
   bool ValidateHandle(TextureHandle handle) const;
@@ -0,0 +1,167 @@
+#include "upload_ring.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include "deferred_release_queue.h"
+#include "fence_manager.h"
+
+bool UploadRing::Initialize(
+  ID3D12Device* device, const FenceManager* fence_manager, DeferredReleaseQueue* release_queue, uint64_t page_size) {
+  assert(device != nullptr);
+  assert(fence_manager != nullptr);
+  assert(release_queue != nullptr);
+
+  device_ = device;
+  fence_manager_ = fence_manager;
+  release_queue_ = release_queue;
+  page_size_ = page_size;
+
+  current_page_ = CreatePage(page_size_);
+  current_offset_ = 0;
+  return current_page_ != nullptr;
+}
+
+void UploadRing::BeginFrame() {
+  stats_.peak_frame_bytes = (std::max)(stats_.peak_frame_bytes, frame_bytes_);
+  frame_bytes_ = 0;
+}
+
+UploadRing::Allocation UploadRing::Allocate(uint64_t size, uint64_t alignment) {
+  assert(device_ != nullptr);
+  assert(std::has_single_bit(alignment));
+  if (size == 0) {
+    return {};
+  }
+
+  // Oversized request: one-off page, retired right away (it is released once this frame completes)
+  if (size > page_size_) {
+    std::unique_ptr<Page> page = CreatePage(size);
+    if (page == nullptr) {
+      return {};
+    }
+    ++stats_.dedicated_pages;
+
+    Allocation allocation;
+    allocation.cpu = page->cpu;
+    allocation.gpu = page->gpu;
+    allocation.resource = page->resource.Get();
+    allocation.offset = 0;
+    allocation.size = size;
+    RetirePage(std::move(page));
+
+    ++stats_.allocations;
+    stats_.allocated_bytes += size;
+    frame_bytes_ += size;
+    return allocation;
+  }
+
+  uint64_t offset = (current_offset_ + alignment - 1) & ~(alignment - 1);
+  if (current_page_ == nullptr || offset + size > current_page_->size) {
+    // Page full: it may still hold data of frames in flight, so it only comes back through the queue
+    if (current_page_ != nullptr) {
+      RetirePage(std::move(current_page_));
+    }
+
+    if (!free_pages_.empty()) {
+      current_page_ = std::move(free_pages_.back());
+      free_pages_.pop_back();
+    } else {
+      current_page_ = CreatePage(page_size_);
+      if (current_page_ == nullptr) {
+        return {};
+      }
+    }
+    current_offset_ = 0;
+    offset = 0;
+  }
+
+  current_offset_ = offset + size;
+
+  Allocation allocation;
+  allocation.cpu = current_page_->cpu + offset;
+  allocation.gpu = current_page_->gpu + offset;
+  allocation.resource = current_page_->resource.Get();
+  allocation.offset = offset;
+  allocation.size = size;
+
+  ++stats_.allocations;
+  stats_.allocated_bytes += size;
+  frame_bytes_ += size;
+  return allocation;
+}
+
+UploadRing::Allocation UploadRing::Push(const void* data, uint64_t size, uint64_t alignment) {
+  assert(data != nullptr);
+
+  Allocation allocation = Allocate(size, alignment);
+  if (allocation.IsValid()) {
+    std::memcpy(allocation.cpu, data, size);
+  }
+  return allocation;
+}
+
+std::unique_ptr<UploadRing::Page> UploadRing::CreatePage(uint64_t size) {
+  D3D12_HEAP_PROPERTIES heap_props = {};
+  heap_props.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+  D3D12_RESOURCE_DESC buffer_desc = {};
+  buffer_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+  buffer_desc.Width = size;
+  buffer_desc.Height = 1;
+  buffer_desc.DepthOrArraySize = 1;
+  buffer_desc.MipLevels = 1;
+  buffer_desc.Format = DXGI_FORMAT_UNKNOWN;
+  buffer_desc.SampleDesc.Count = 1;
+  buffer_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+  buffer_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+  // Pages are large and long-lived, so one committed resource each is fine
+  auto page = std::make_unique<Page>();
+  HRESULT hr = device_->CreateCommittedResource(
+    &heap_props, D3D12_HEAP_FLAG_NONE, &buffer_desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&page->resource));
+  if (FAILED(hr)) {
+    std::cerr << "[UploadRing] Failed to create upload page (" << size << " bytes)" << '\n';
+    return nullptr;
+  }
+
+  void* mapped = nullptr;
+  D3D12_RANGE read_range = {};  // Never read on the CPU
+  hr = page->resource->Map(0, &read_range, &mapped);
+  if (FAILED(hr)) {
+    std::cerr << "[UploadRing] Failed to map upload page" << '\n';
+    return nullptr;
+  }
+
+  page->cpu = static_cast<uint8_t*>(mapped);
+  page->gpu = page->resource->GetGPUVirtualAddress();
+  page->size = size;
+
+  if (size == page_size_) {
+    ++stats_.page_count;
+  }
+  ++stats_.pages_created;
+  return page;
+}
+
+void UploadRing::RetirePage(std::unique_ptr<Page> page) {
+  const bool reusable = page->size == page_size_;
+  release_queue_->Enqueue(fence_manager_->GetCurrentFenceValue(), [this, reusable, page = std::move(page)]() mutable {
+    if (reusable) {
+      free_pages_.push_back(std::move(page));
+    }
+    // Oversized pages are destroyed here (unmapped by the resource release)
+  });
+}
+
+void UploadRing::PrintStats() const {
+  std::cout << "\n=== Upload Ring Statistics ===" << '\n';
+  std::cout << "Pages: " << stats_.page_count << " x " << (page_size_ >> 10) << " KB (" << stats_.pages_created << " created, "
+            << stats_.dedicated_pages << " oversized)" << '\n';
+  std::cout << "Allocations: " << stats_.allocations << ", " << (stats_.allocated_bytes >> 10) << " KB total, peak frame "
+            << ((std::max)(stats_.peak_frame_bytes, frame_bytes_) >> 10) << " KB" << '\n';
+  std::cout << "==============================\n" << '\n';
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.h"
+
+class DeferredReleaseQueue;
+class FenceManager;
+
+constexpr uint64_t DEFAULT_UPLOAD_RING_PAGE_SIZE = 2ull << 20;
+
+// UploadRing: Engine-wide linear allocator for per-frame dynamic data (constant buffers, debug vertices).
+// Allocations are bump-allocated from persistently mapped upload pages and are valid until the end of
+// the frame they were made in. A page that fills up is handed to the deferred release queue and comes
+// back for reuse once the GPU has passed the current frame, so there is no fixed per-frame cap: the
+// ring grows by another page when the free pages run out.
+//
+// Render thread only (Allocate and the release queue's Process run on the thread that owns the frame).
+class UploadRing {
+ public:
+  struct Allocation {
+    void* cpu = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;
+    ID3D12Resource* resource = nullptr;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+
+    bool IsValid() const {
+      return cpu != nullptr;
+    }
+  };
+
+  struct Stats {
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t peak_frame_bytes = 0;
+    uint32_t page_count = 0;       // Standard pages owned (in use, retired or free)
+    uint32_t pages_created = 0;
+    uint32_t dedicated_pages = 0;  // Oversized one-off pages created
+  };
+
+  UploadRing() = default;
+  ~UploadRing() = default;
+
+  UploadRing(const UploadRing&) = delete;
+  UploadRing& operator=(const UploadRing&) = delete;
+
+  bool Initialize(ID3D12Device* device,
+    const FenceManager* fence_manager,
+    DeferredReleaseQueue* release_queue,
+    uint64_t page_size = DEFAULT_UPLOAD_RING_PAGE_SIZE);
+
+  // Start of a frame (only rolls the per-frame statistics; memory is reclaimed by the release queue)
+  void BeginFrame();
+
+  // alignment must be a power of two (256 for constant buffers)
+  Allocation Allocate(uint64_t size, uint64_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+  // Allocate and copy
+  Allocation Push(const void* data, uint64_t size, uint64_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+  void PrintStats() const;
+
+ private:
+  struct Page {
+    ComPtr<ID3D12Resource> resource;
+    uint8_t* cpu = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;
+    uint64_t size = 0;
+  };
+
+  ID3D12Device* device_ = nullptr;
+  const FenceManager* fence_manager_ = nullptr;
+  DeferredReleaseQueue* release_queue_ = nullptr;
+  uint64_t page_size_ = DEFAULT_UPLOAD_RING_PAGE_SIZE;
+
+  std::unique_ptr<Page> current_page_;
+  uint64_t current_offset_ = 0;
+  std::vector<std::unique_ptr<Page>> free_pages_;
+
+  Stats stats_;
+  uint64_t frame_bytes_ = 0;
+
+  std::unique_ptr<Page> CreatePage(uint64_t size);
+
+  // Hand a page to the release queue; standard pages return to free_pages_, oversized ones are destroyed
+  void RetirePage(std::unique_ptr<Page> page);
+};
@@ -26,3 +26,13 @@ static const D3D12_INPUT_ELEMENT_DESC s_inputLayout_DebugVertex2D[] = {
 std::span<const D3D12_INPUT_ELEMENT_DESC> GetInputLayout_DebugVertex2D() {
   return std::span<const D3D12_INPUT_ELEMENT_DESC>(s_inputLayout_DebugVertex2D, std::size(s_inputLayout_DebugVertex2D));
 }
+
+static const D3D12_INPUT_ELEMENT_DESC s_inputLayout_CookedMeshVertex[] = {
+  {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+  {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+  {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+};
+
+std::span<const D3D12_INPUT_ELEMENT_DESC> GetInputLayout_CookedMeshVertex() {
+  return std::span<const D3D12_INPUT_ELEMENT_DESC>(s_inputLayout_CookedMeshVertex, std::size(s_inputLayout_CookedMeshVertex));
+}
@@ -27,3 +27,7 @@ struct DebugVertex2D {
 };
 
 std::span<const D3D12_INPUT_ELEMENT_DESC> GetInputLayout_DebugVertex2D();
+
+// Cooked mesh vertex (CookedMeshVertex in cooked_mesh.h, 16 bytes): unorm16 position to dequantize with the
+// mesh's position transform, octahedral snorm16 normal and half-float texcoord
+std::span<const D3D12_INPUT_ELEMENT_DESC> GetInputLayout_CookedMeshVertex();
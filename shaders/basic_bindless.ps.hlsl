@@ -0,0 +1,22 @@
+//==============================================================================
+// basic_bindless.ps.hlsl
+// 
+// Purpose: Pixel shader for basic sprite rendering (bindless texture model)
+// Material: DefaultSprite2D (bindless root signature)
+// 
+// Features:
+// - Texture fetched from the global SRV table by a per-draw index
+// - Color tint multiplication
+//==============================================================================
+
+#include "basic_type.hlsli"
+
+Texture2D<float4> textures[] : register(t0, space1);
+
+cbuffer PerObjectTextures : register(b4) { uint base_color_index; };
+
+float4 main(BasicType input) : SV_TARGET {
+  // Index is uniform per draw, so no NonUniformResourceIndex is needed
+  float4 texCol = textures[base_color_index].Sample(smp, input.uv);
+  return texCol * input.color;
+}
@@ -11,6 +11,10 @@
 //   param[3] = b1: FrameCB                 (constant buffer view)
 //   param[4] = t0: Texture2D               (descriptor table SRV)
 //   sampler s0: Static sampler (POINT, WRAP)
+//
+// Bindless variant (basic_bindless.ps.hlsl):
+//   param[4] = t0, space1: Texture2D[]     (unbounded table over the static SRV region, bound once)
+//   param[5] = b4: uint texture index      (1 x 32-bit constant per texture slot)
 //==============================================================================
 
 struct VSIN {
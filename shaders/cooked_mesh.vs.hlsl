@@ -0,0 +1,65 @@
+//==============================================================================
+// cooked_mesh.vs.hlsl
+//
+// Purpose: Vertex shader for cooked meshes (tools/mesh_cooker, 16-byte vertex)
+// Material: MeshCookedOpaque (sprite root signature plus b5, basic.ps / basic_bindless.ps)
+//
+// Features:
+// - UNORM16 positions dequantized by the mesh's offset and scale (b5), then
+//   transformed by the world matrix
+// - Octahedral normals with a fixed directional light applied to the tint
+// - Half-float texcoords with the per-object UV transform
+//==============================================================================
+
+#include "basic_type.hlsli"
+
+cbuffer PerObjectWorldPos : register(b0) { row_major float4x4 world_pos; };
+cbuffer PerObjectColor : register(b2) { float4 color_tint; };
+cbuffer PerObjectUV : register(b3) {
+  float4 uv_transform;
+}; // (offset.xy, scale.xy)
+cbuffer PerObjectDequantization : register(b5) {
+  float4 position_offset;  // xyz: local position of stored 0
+  float4 position_scale;   // xyz: local units per stored step
+};
+
+struct CookedVSIN {
+  float4 pos : POSITION;   // R16G16B16A16_UNORM, read as 0..1
+  float2 normal : NORMAL;  // R16G16_SNORM, octahedral
+  float2 uv : TEXCOORD;    // R16G16_FLOAT
+};
+
+static const float3 kLightDir = float3(-0.4f, 0.8f, -0.45f);
+static const float kAmbient = 0.35f;
+
+float3 DecodeOctahedral(float2 e) {
+  float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+  if (n.z < 0.0f) {
+    float2 sign_not_zero = float2(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+    n.xy = (1.0f - abs(e.yx)) * sign_not_zero;
+  }
+  return normalize(n);
+}
+
+BasicType main(CookedVSIN input) {
+  BasicType output;
+
+  // The scale is per stored step (0..65535), the fetch gives 0..1
+  float3 posL = position_offset.xyz + input.pos.xyz * 65535.0f * position_scale.xyz;
+  float4 posW = mul(float4(posL, 1.0f), world_pos);
+  posW = mul(posW, view);
+  output.svpos = mul(posW, proj);
+
+  // Normals are in local space, so they take world_pos alone. Its rows are orthogonal
+  // for rotation and (non-uniform) scale, so dividing each by its squared length
+  // gives the inverse transpose
+  float3x3 m = (float3x3)world_pos;
+  float3 n = DecodeOctahedral(input.normal);
+  float3 normalW = normalize(n.x * m[0] / dot(m[0], m[0]) + n.y * m[1] / dot(m[1], m[1]) + n.z * m[2] / dot(m[2], m[2]));
+  float light = kAmbient + (1.0f - kAmbient) * saturate(dot(normalW, normalize(kLightDir)));
+
+  output.uv = input.uv * uv_transform.zw + uv_transform.xy;
+  output.color = float4(color_tint.rgb * light, color_tint.a);
+
+  return output;
+}
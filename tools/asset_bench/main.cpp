@@ -0,0 +1,244 @@
+// asset_bench: Cold-start load times of an asset archive (.pak, tools/asset_packer) against the loose files
+// it was packed from. Every entry is loaded into memory and read once per run: as loose files (open + read,
+// serially and one pool job per file), and from the archive (opened fresh per run; serially, one pool job
+// per entry, and entries in order with their chunks decompressed on the pool). With --cold the OS file
+// cache is dropped for the archive and every loose file before each run (Linux only), so timings include
+// the disk; otherwise they measure warm-cache open and decompression cost.
+//
+// Usage: asset_bench [--root <dir>] [--iterations <n>] [--threads <n>] [--cold] <archive.pak>
+//   --root <dir>   Directory the archive was packed from (default: current directory)
+//   e.g. asset_bench --cold Content.pak
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "asset_archive.h"
+#include "thread_pool.h"
+
+namespace {
+struct Options {
+  std::filesystem::path archive;
+  std::filesystem::path root = ".";
+  int iterations = 5;
+  uint32_t threads = 0;
+  bool cold = false;
+};
+
+enum class LoadMode : uint8_t { LooseSerial, LooseParallel, ArchiveSerial, ArchiveParallelEntries, ArchiveParallelChunks };
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--root" && has_value) {
+      options.root = argv[++i];
+    } else if (arg == "--iterations" && has_value) {
+      options.iterations = (std::max)(1, std::atoi(argv[++i]));
+    } else if (arg == "--threads" && has_value) {
+      options.threads = static_cast<uint32_t>((std::max)(0, std::atoi(argv[++i])));
+    } else if (arg == "--cold") {
+      options.cold = true;
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[asset_bench] Unknown option: " << arg << '\n';
+      return false;
+    } else {
+      options.archive = arg;
+    }
+  }
+  return !options.archive.empty();
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Evict a file's pages from the OS cache; false where that is not supported
+bool DropFileCache(const std::filesystem::path& path) {
+#if defined(__linux__)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  const bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+  close(fd);
+  return dropped;
+#else
+  (void)path;
+  return false;
+#endif
+}
+
+// Consume every byte, like an upload copy would (archive entries read in place are only faulted in here)
+uint64_t Checksum(const uint8_t* data, size_t size) {
+  uint64_t sum = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    sum ^= word;
+  }
+  for (; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+uint64_t LoadLooseFile(const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream) {
+    std::cerr << "[asset_bench] Failed to open " << path.string() << '\n';
+    return 0;
+  }
+  std::vector<uint8_t> bytes(static_cast<size_t>(stream.tellg()));
+  stream.seekg(0);
+  stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  return Checksum(bytes.data(), bytes.size());
+}
+
+uint64_t LoadArchiveEntry(const AssetArchive& archive, const AssetArchiveEntry& entry, ThreadPool* pool) {
+  AssetBlob blob;
+  if (!archive.Load(entry, blob, pool)) {
+    return 0;
+  }
+  return Checksum(blob.data, blob.size);
+}
+
+// One cold start: everything loaded once; the checksum keeps the reads from being optimized away
+uint64_t LoadAll(LoadMode mode, const Options& options, const std::vector<std::filesystem::path>& loose_files, ThreadPool& pool) {
+  std::atomic<uint64_t> checksum = 0;
+  auto run_jobs = [&pool](size_t count, auto&& job) {
+    std::latch done(static_cast<std::ptrdiff_t>(count));
+    for (size_t i = 0; i < count; ++i) {
+      pool.Submit([&job, &done, i] {
+        job(i);
+        done.count_down();
+      });
+    }
+    done.wait();
+  };
+
+  if (mode == LoadMode::LooseSerial) {
+    for (const std::filesystem::path& path : loose_files) {
+      checksum += LoadLooseFile(path);
+    }
+    return checksum;
+  }
+  if (mode == LoadMode::LooseParallel) {
+    run_jobs(loose_files.size(), [&](size_t i) { checksum += LoadLooseFile(loose_files[i]); });
+    return checksum;
+  }
+
+  AssetArchive archive;
+  if (!archive.Open(options.archive)) {
+    return 0;
+  }
+  if (mode == LoadMode::ArchiveParallelEntries) {
+    run_jobs(archive.GetEntryCount(), [&](size_t i) {
+      checksum += LoadArchiveEntry(archive, archive.GetEntry(static_cast<uint32_t>(i)), nullptr);
+    });
+    return checksum;
+  }
+  ThreadPool* chunk_pool = (mode == LoadMode::ArchiveParallelChunks) ? &pool : nullptr;
+  for (uint32_t i = 0; i < archive.GetEntryCount(); ++i) {
+    checksum += LoadArchiveEntry(archive, archive.GetEntry(i), chunk_pool);
+  }
+  return checksum;
+}
+
+// Average milliseconds per cold start (after one warm-up run that also yields the reference checksum)
+double TimeLoadAll(LoadMode mode,
+  const Options& options,
+  const std::vector<std::filesystem::path>& loose_files,
+  ThreadPool& pool,
+  uint64_t expected_checksum,
+  bool& out_matches) {
+  out_matches = LoadAll(mode, options, loose_files, pool) == expected_checksum;
+
+  uint64_t total_ns = 0;
+  for (int iteration = 0; iteration < options.iterations; ++iteration) {
+    if (options.cold) {
+      DropFileCache(options.archive);
+      for (const std::filesystem::path& path : loose_files) {
+        DropFileCache(path);
+      }
+    }
+    const uint64_t start = NowNs();
+    LoadAll(mode, options, loose_files, pool);
+    total_ns += NowNs() - start;
+  }
+  return static_cast<double>(total_ns) / 1e6 / options.iterations;
+}
+
+void PrintRow(const char* name, double ms, uint64_t bytes, double baseline_ms, bool matches) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2) << std::setw(9) << ms
+            << " ms" << std::setw(9) << std::setprecision(1) << static_cast<double>(bytes) / 1e6 / (ms / 1000.0) << " MB/s"
+            << std::setw(7) << std::setprecision(2) << baseline_ms / ms << "x" << (matches ? "" : "  (content mismatch)") << '\n';
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: asset_bench [--root <dir>] [--iterations <n>] [--threads <n>] [--cold] <archive.pak>" << '\n';
+    return 1;
+  }
+
+  AssetArchive archive;
+  if (!archive.Open(options.archive)) {
+    return 1;
+  }
+  std::vector<std::filesystem::path> loose_files;
+  uint64_t total_bytes = 0;
+  uint64_t compressed_entries = 0;
+  for (uint32_t i = 0; i < archive.GetEntryCount(); ++i) {
+    const AssetArchiveEntry& entry = archive.GetEntry(i);
+    loose_files.push_back(options.root / std::filesystem::path(archive.GetEntryPath(entry)));
+    total_bytes += entry.size;
+    compressed_entries += (entry.flags & kAssetArchiveEntryFlagCompressed) != 0 ? 1 : 0;
+  }
+  const size_t archive_size = archive.GetFileSize();
+  archive.Close();
+
+  ThreadPool pool;
+  const uint32_t threads = options.threads > 0 ? options.threads : (std::max)(1u, std::thread::hardware_concurrency());
+  pool.Initialize(threads, "Bench");
+
+  const bool cold = options.cold && DropFileCache(options.archive);
+  std::cout << "=== Asset Bench ===" << '\n';
+  std::cout << "Entries: " << loose_files.size() << " (" << compressed_entries << " compressed), " << total_bytes / 1024 << " KB -> "
+            << archive_size / 1024 << " KB packed" << '\n';
+  std::cout << "Iterations: " << options.iterations << ", threads: " << threads << ", file cache: " << (cold ? "dropped" : "warm")
+            << (options.cold && !cold ? " (dropping is not supported here)" : "") << '\n';
+
+  const uint64_t expected_checksum = LoadAll(LoadMode::LooseSerial, options, loose_files, pool);
+  bool matches = false;
+  const double loose_ms = TimeLoadAll(LoadMode::LooseSerial, options, loose_files, pool, expected_checksum, matches);
+  PrintRow("loose, serial", loose_ms, total_bytes, loose_ms, matches);
+  const double loose_parallel_ms = TimeLoadAll(LoadMode::LooseParallel, options, loose_files, pool, expected_checksum, matches);
+  PrintRow("loose, parallel files", loose_parallel_ms, total_bytes, loose_ms, matches);
+  const double archive_ms = TimeLoadAll(LoadMode::ArchiveSerial, options, loose_files, pool, expected_checksum, matches);
+  PrintRow("pak, serial", archive_ms, total_bytes, loose_ms, matches);
+  const double entries_ms = TimeLoadAll(LoadMode::ArchiveParallelEntries, options, loose_files, pool, expected_checksum, matches);
+  PrintRow("pak, parallel entries", entries_ms, total_bytes, loose_ms, matches);
+  const double chunks_ms = TimeLoadAll(LoadMode::ArchiveParallelChunks, options, loose_files, pool, expected_checksum, matches);
+  PrintRow("pak, parallel chunks", chunks_ms, total_bytes, loose_ms, matches);
+  return 0;
+}
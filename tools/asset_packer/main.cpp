@@ -0,0 +1,301 @@
+// asset_packer: Packs asset files into one archive (.pak, see asset_archive.h) that the runtime maps and
+// reads through AssetArchive: a hash-sorted index, 64 KB LZ4 chunks and 4096-byte aligned raw entries. Chunks
+// that LZ4 cannot shrink by at least 1/8 are stored raw; cooked textures (.ctex) and meshes (.cmsh) are always
+// stored, so the loader copies them into upload memory straight from the mapping. Directories are packed recursively.
+//
+// Usage: asset_packer -o <archive.pak> [options] <file | directory>...
+//   --root <dir>      Entry paths are relative to this directory (default: current directory)
+//   --store <ext>     Also store files with this extension uncompressed (repeatable, e.g. --store .cso)
+//   --threads <n>     Compression threads (default: hardware concurrency)
+//   e.g. asset_packer -o Content.pak Content
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asset_archive.h"
+#include "lz4.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+namespace {
+struct Options {
+  std::filesystem::path output;
+  std::filesystem::path root = ".";
+  std::vector<std::string> stored_extensions = {".ctex", ".cmsh"};
+  uint32_t threads = 0;
+  std::vector<std::filesystem::path> inputs;
+};
+
+// One input file with its chunks; compressed holds the LZ4 bytes of each chunk, empty for stored chunks
+struct PackedFile {
+  std::filesystem::path source;
+  std::string path;
+  std::string lookup_key;  // ASCII-lowercased path
+  uint64_t hash = 0;
+  MappedFile file;
+  std::vector<std::vector<uint8_t>> compressed;
+  bool stored = false;
+  bool failed = false;
+};
+
+void PrintUsage() {
+  std::cerr << "Usage: asset_packer -o <archive.pak> [--root <dir>] [--store <ext>]... [--threads <n>] <file | directory>..." << '\n';
+}
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "-o" && has_value) {
+      options.output = argv[++i];
+    } else if (arg == "--root" && has_value) {
+      options.root = argv[++i];
+    } else if (arg == "--store" && has_value) {
+      options.stored_extensions.emplace_back(argv[++i]);
+    } else if (arg == "--threads" && has_value) {
+      options.threads = static_cast<uint32_t>((std::max)(0, std::atoi(argv[++i])));
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[asset_packer] Unknown option: " << arg << '\n';
+      return false;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.output.empty() && !options.inputs.empty();
+}
+
+// Expand directories into the regular files below them (sorted, so archives are reproducible)
+std::vector<std::filesystem::path> CollectFiles(const Options& options) {
+  std::vector<std::filesystem::path> files;
+  for (const std::filesystem::path& input : options.inputs) {
+    if (!std::filesystem::is_directory(input)) {
+      files.push_back(input);
+      continue;
+    }
+    for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(input)) {
+      std::error_code error;
+      if (entry.is_regular_file() && !std::filesystem::equivalent(entry.path(), options.output, error)) {
+        files.push_back(entry.path());
+      }
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+bool IsStoredExtension(const Options& options, const std::filesystem::path& path) {
+  const std::string extension = path.extension().string();
+  return std::find(options.stored_extensions.begin(), options.stored_extensions.end(), extension) != options.stored_extensions.end();
+}
+
+// Split into chunks and keep LZ4 output only where it saves at least 1/8 of the chunk (decompressing costs
+// more than reading the few bytes it would save otherwise)
+void CompressFile(PackedFile& packed) {
+  if (!packed.file.Open(packed.source)) {
+    packed.failed = true;
+    return;
+  }
+  const size_t size = packed.file.GetSize();
+  const size_t chunk_count = (size + kAssetArchiveChunkSize - 1) / kAssetArchiveChunkSize;
+  packed.compressed.resize(chunk_count);
+  if (packed.stored) {
+    return;
+  }
+
+  std::vector<uint8_t> scratch(Lz4CompressBound(kAssetArchiveChunkSize));
+  for (size_t c = 0; c < chunk_count; ++c) {
+    const size_t offset = c * kAssetArchiveChunkSize;
+    const size_t raw_size = (std::min)(static_cast<size_t>(kAssetArchiveChunkSize), size - offset);
+    const size_t compressed_size = Lz4Compress(packed.file.GetData() + offset, raw_size, scratch.data(), raw_size - raw_size / 8);
+    if (compressed_size > 0) {
+      packed.compressed[c].assign(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(compressed_size));
+    }
+  }
+}
+
+class ArchiveWriter {
+ public:
+  explicit ArchiveWriter(std::ofstream& stream) : stream_(stream) {
+  }
+
+  void Write(const void* data, size_t size) {
+    if (size > 0) {
+      stream_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+    position_ += size;
+  }
+
+  void Align(uint64_t alignment) {
+    static constexpr uint8_t kZeros[kAssetArchiveDataAlignment] = {};
+    Write(kZeros, static_cast<size_t>((alignment - position_ % alignment) % alignment));
+  }
+
+  uint64_t GetPosition() const {
+    return position_;
+  }
+
+ private:
+  std::ofstream& stream_;
+  uint64_t position_ = 0;
+};
+
+bool WriteArchive(const std::filesystem::path& output,
+  const std::vector<PackedFile>& files,
+  uint64_t& out_size,
+  uint32_t& out_stored_chunks) {
+  std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+  if (!stream) {
+    std::cerr << "[asset_packer] Failed to create " << output.string() << '\n';
+    return false;
+  }
+
+  ArchiveWriter writer(stream);
+  AssetArchiveHeader header = {};
+  writer.Write(&header, sizeof(header));
+
+  std::vector<AssetArchiveEntry> entries;
+  std::vector<AssetArchiveChunk> chunks;
+  std::string paths;
+  out_stored_chunks = 0;
+  for (const PackedFile& packed : files) {
+    // Only entries read in place need the alignment; compressed ones are decompressed into fresh memory
+    const bool stored = std::all_of(packed.compressed.begin(), packed.compressed.end(), [](const auto& bytes) { return bytes.empty(); });
+    if (stored) {
+      writer.Align(kAssetArchiveDataAlignment);
+    }
+    AssetArchiveEntry entry = {};
+    entry.path_hash = packed.hash;
+    entry.data_offset = writer.GetPosition();
+    entry.size = packed.file.GetSize();
+    entry.first_chunk = static_cast<uint32_t>(chunks.size());
+    entry.chunk_count = static_cast<uint32_t>(packed.compressed.size());
+    entry.path_offset = static_cast<uint32_t>(paths.size());
+    entry.path_length = static_cast<uint32_t>(packed.path.size());
+    paths += packed.path;
+
+    for (size_t c = 0; c < packed.compressed.size(); ++c) {
+      AssetArchiveChunk chunk = {};
+      chunk.offset = writer.GetPosition();
+      if (packed.compressed[c].empty()) {
+        const size_t offset = c * kAssetArchiveChunkSize;
+        chunk.stored_size = static_cast<uint32_t>((std::min)(static_cast<size_t>(kAssetArchiveChunkSize), packed.file.GetSize() - offset));
+        writer.Write(packed.file.GetData() + offset, chunk.stored_size);
+        ++out_stored_chunks;
+      } else {
+        chunk.stored_size = static_cast<uint32_t>(packed.compressed[c].size());
+        chunk.flags = kAssetArchiveChunkFlagLz4;
+        writer.Write(packed.compressed[c].data(), chunk.stored_size);
+        entry.flags |= kAssetArchiveEntryFlagCompressed;
+      }
+      chunks.push_back(chunk);
+    }
+    entries.push_back(entry);
+  }
+
+  writer.Align(alignof(AssetArchiveEntry));
+  header.magic = kAssetArchiveMagic;
+  header.version = kAssetArchiveVersion;
+  header.chunk_size = kAssetArchiveChunkSize;
+  header.entry_count = static_cast<uint32_t>(entries.size());
+  header.chunk_count = static_cast<uint32_t>(chunks.size());
+  header.entry_table_offset = writer.GetPosition();
+  writer.Write(entries.data(), entries.size() * sizeof(AssetArchiveEntry));
+  header.chunk_table_offset = writer.GetPosition();
+  writer.Write(chunks.data(), chunks.size() * sizeof(AssetArchiveChunk));
+  header.path_table_offset = writer.GetPosition();
+  header.path_table_size = paths.size();
+  writer.Write(paths.data(), paths.size());
+  out_size = writer.GetPosition();
+
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!stream.flush()) {
+    std::cerr << "[asset_packer] Failed to write " << output.string() << '\n';
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    PrintUsage();
+    return 1;
+  }
+  const auto start = std::chrono::steady_clock::now();
+
+  const std::vector<std::filesystem::path> sources = CollectFiles(options);
+  std::vector<PackedFile> files(sources.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    PackedFile& packed = files[i];
+    packed.source = sources[i];
+    std::error_code error;
+    const std::filesystem::path relative = std::filesystem::relative(packed.source, options.root, error);
+    packed.path = NormalizeAssetPath(relative);
+    if (error || packed.path.empty() || packed.path.starts_with("..")) {
+      std::cerr << "[asset_packer] " << packed.source.string() << " is not below the root " << options.root.string() << '\n';
+      return 1;
+    }
+    packed.hash = HashAssetPath(packed.path);
+    packed.lookup_key = packed.path;
+    std::transform(packed.lookup_key.begin(), packed.lookup_key.end(), packed.lookup_key.begin(), [](char c) {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    });
+    packed.stored = IsStoredExtension(options, packed.source);
+  }
+
+  // Index order: by hash, then path; paths equal apart from case would be ambiguous at lookup
+  std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+    return a.hash != b.hash ? a.hash < b.hash : a.lookup_key < b.lookup_key;
+  });
+  for (size_t i = 1; i < files.size(); ++i) {
+    if (files[i].lookup_key == files[i - 1].lookup_key) {
+      std::cerr << "[asset_packer] Duplicate path: " << files[i].path << '\n';
+      return 1;
+    }
+  }
+
+  ThreadPool pool;
+  const uint32_t threads = options.threads > 0 ? options.threads : (std::max)(1u, std::thread::hardware_concurrency());
+  pool.Initialize(threads, "Packer");
+  std::latch done(static_cast<std::ptrdiff_t>(files.size()));
+  for (PackedFile& packed : files) {
+    pool.Submit([&packed, &done] {
+      CompressFile(packed);
+      done.count_down();
+    });
+  }
+  done.wait();
+
+  uint64_t input_size = 0;
+  uint32_t chunk_count = 0;
+  for (const PackedFile& packed : files) {
+    if (packed.failed) {
+      return 1;
+    }
+    input_size += packed.file.GetSize();
+    chunk_count += static_cast<uint32_t>(packed.compressed.size());
+  }
+
+  uint64_t output_size = 0;
+  uint32_t stored_chunks = 0;
+  if (!WriteArchive(options.output, files, output_size, stored_chunks)) {
+    return 1;
+  }
+
+  const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout << options.output.string() << ": " << files.size() << " file(s), " << input_size / 1024 << " KB -> " << output_size / 1024
+            << " KB, " << chunk_count << " chunk(s) (" << stored_chunks << " stored), " << static_cast<uint64_t>(elapsed_ms) << " ms"
+            << '\n';
+  return 0;
+}
@@ -0,0 +1,262 @@
+// barrier_batch_check: Checks BarrierBatch (barrier_batch.h), the merge / cancel and subresource bookkeeping
+// behind ResourceStateTracker.
+//
+// The known-answer cases cover redundant transitions, chained ones merging, A->B->A cancelling, merges
+// stopping at another subresource's barrier, subresources diverging, a whole-resource transition after
+// they diverged and collapsing back once they agree. The random part runs batches of transitions over
+// resources with 1 to 8 subresources against a reference that keeps one state per subresource. After each
+// batch the pending barriers are replayed in order: every barrier's before state must match what the
+// GPU would see, no barrier may be a no-op, and the result must be the reference states. Tracked states
+// must equal the reference after every transition and must never hold diverged subresources that agree.
+//
+// Usage: barrier_batch_check [--batches <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "barrier_batch.h"
+
+namespace {
+struct Options {
+  uint32_t batches = 20000;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--batches" && has_value) {
+      options.batches = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[barrier_batch_check] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+constexpr uint32_t kAll = BarrierBatch::kAllSubresources;
+
+// Stand-ins for D3D12_RESOURCE_STATES bits
+constexpr uint32_t kCommon = 0;
+constexpr uint32_t kRenderTarget = 0x4;
+constexpr uint32_t kShaderResource = 0xc0;
+constexpr uint32_t kCopyDest = 0x400;
+
+bool IsBarrier(const BarrierBatch::Barrier& barrier, void* resource, uint32_t subresource, uint32_t before, uint32_t after) {
+  return barrier.resource == resource && barrier.subresource == subresource && barrier.before == before && barrier.after == after;
+}
+
+bool RunChecks() {
+  Checker checker;
+  BarrierBatch batch;
+  int texture_a = 0;
+  int texture_b = 0;
+  BarrierBatch::TrackedState a;
+  BarrierBatch::TrackedState b;
+
+  // Redundant transitions record nothing
+  batch.Transition(&texture_a, a, 0, kCommon);
+  checker.Expect(batch.IsEmpty() && batch.GetEliminatedCount() == 1, "redundant transition dropped");
+
+  // A->B->C merges into A->C; the tracked state moves with every call
+  batch.Transition(&texture_a, a, 0, kCopyDest);
+  checker.Expect(a.state == kCopyDest, "state updated on record");
+  batch.Transition(&texture_a, a, 0, kShaderResource);
+  checker.Expect(batch.GetPending().size() == 1 && IsBarrier(batch.GetPending()[0], &texture_a, kAll, kCommon, kShaderResource),
+    "chained transitions merge");
+
+  // Another resource in between does not block the merge; B->A cancels
+  batch.Transition(&texture_b, b, 0, kRenderTarget);
+  batch.Transition(&texture_a, a, 0, kCommon);
+  checker.Expect(batch.GetPending().size() == 1 && IsBarrier(batch.GetPending()[0], &texture_b, kAll, kCommon, kRenderTarget),
+    "A->B->A cancels");
+  checker.Expect(a.state == kCommon && batch.GetEliminatedCount() == 4, "merged and cancelled counted");
+  batch.Clear();
+
+  // A single subresource splits the tracking; the others stay where the resource was
+  batch.Transition(&texture_a, a, 4, kRenderTarget, 2);
+  checker.Expect(a.subresource_states.size() == 4 && a.Get(2) == kRenderTarget && a.Get(1) == kCommon, "subresource diverges");
+  checker.Expect(batch.GetPending().size() == 1 && IsBarrier(batch.GetPending()[0], &texture_a, 2, kCommon, kRenderTarget),
+    "subresource barrier");
+
+  // A merge only looks at the resource's last barrier: subresource 1 in between keeps subresource 2 separate
+  batch.Transition(&texture_a, a, 4, kCopyDest, 1);
+  batch.Transition(&texture_a, a, 4, kShaderResource, 2);
+  checker.Expect(batch.GetPending().size() == 3, "merge stops at another subresource");
+  batch.Transition(&texture_a, a, 4, kRenderTarget, 2);
+  checker.Expect(batch.GetPending().size() == 2 && a.Get(2) == kRenderTarget, "last barrier of the subresource cancels");
+
+  // A whole-resource transition brings each diverged subresource over on its own
+  batch.Clear();
+  batch.Transition(&texture_a, a, 0, kShaderResource);
+  const std::vector<BarrierBatch::Barrier>& pending = batch.GetPending();
+  checker.Expect(pending.size() == 4 && IsBarrier(pending[0], &texture_a, 0, kCommon, kShaderResource) &&
+                   IsBarrier(pending[1], &texture_a, 1, kCopyDest, kShaderResource) &&
+                   IsBarrier(pending[2], &texture_a, 2, kRenderTarget, kShaderResource),
+    "whole transition per subresource");
+  checker.Expect(a.subresource_states.empty() && a.state == kShaderResource, "whole transition collapses");
+
+  // Subresources agreeing again collapse back to whole-resource tracking
+  batch.Clear();
+  for (uint32_t i = 0; i < 3; ++i) {
+    batch.Transition(&texture_a, a, 3, kRenderTarget, i);
+  }
+  checker.Expect(
+    a.subresource_states.empty() && a.state == kRenderTarget && batch.GetPending().size() == 3, "agreeing subresources collapse");
+
+  // Reset puts the whole resource in a state without a barrier
+  a.Reset(kCopyDest);
+  checker.Expect(a.Get(0) == kCopyDest && a.subresource_states.empty(), "reset");
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+struct Resource {
+  BarrierBatch::TrackedState tracked;
+  std::vector<uint32_t> reference;  // Where each subresource should be after the recorded transitions
+  std::vector<uint32_t> gpu;        // Where each subresource is after the issued barriers
+};
+
+struct RandomTotals {
+  uint64_t transitions = 0;
+  uint64_t barriers = 0;
+  uint64_t needed = 0;  // Transitions that changed a subresource's state
+  uint32_t violations = 0;
+};
+
+bool MatchesReference(const Resource& resource) {
+  const BarrierBatch::TrackedState& tracked = resource.tracked;
+  if (!tracked.subresource_states.empty()) {
+    const uint32_t first = tracked.subresource_states[0];
+    const bool all_agree = std::all_of(
+      tracked.subresource_states.begin(), tracked.subresource_states.end(), [first](uint32_t state) { return state == first; });
+    if (all_agree || tracked.subresource_states.size() != resource.reference.size()) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < static_cast<uint32_t>(resource.reference.size()); ++i) {
+    if (tracked.Get(i) != resource.reference[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Replays the pending barriers on the GPU-side states: each must start where the subresources are
+uint32_t ReplayBarriers(const BarrierBatch& batch, std::vector<Resource>& resources) {
+  uint32_t violations = 0;
+  for (const BarrierBatch::Barrier& barrier : batch.GetPending()) {
+    std::vector<uint32_t>& gpu = resources[*static_cast<uint32_t*>(barrier.resource)].gpu;
+    if (barrier.before == barrier.after) {
+      ++violations;
+    }
+    if (barrier.subresource == kAll) {
+      for (uint32_t& state : gpu) {
+        violations += state != barrier.before ? 1 : 0;
+        state = barrier.after;
+      }
+    } else if (barrier.subresource >= gpu.size()) {
+      ++violations;
+    } else {
+      violations += gpu[barrier.subresource] != barrier.before ? 1 : 0;
+      gpu[barrier.subresource] = barrier.after;
+    }
+  }
+  return violations;
+}
+
+bool RunRandom(const Options& options) {
+  std::mt19937 rng(options.seed);
+  const uint32_t states[] = {kCommon, kRenderTarget, kShaderResource, kCopyDest, 0x8, 0x800};
+
+  // The index doubles as the resource pointer's target so that replay can find the resource
+  std::vector<uint32_t> ids(16);
+  std::vector<Resource> resources(ids.size());
+  for (uint32_t i = 0; i < static_cast<uint32_t>(resources.size()); ++i) {
+    ids[i] = i;
+    resources[i].reference.assign(1 + i % 8, kCommon);
+    resources[i].gpu = resources[i].reference;
+  }
+
+  RandomTotals totals;
+  BarrierBatch batch;
+  for (uint32_t batch_index = 0; batch_index < options.batches; ++batch_index) {
+    // Few resources and states per batch so that merges and cancels are common
+    const uint32_t length = 1 + rng() % 24;
+    const uint32_t first_resource = rng() % static_cast<uint32_t>(resources.size());
+    for (uint32_t i = 0; i < length; ++i) {
+      const uint32_t index = (first_resource + rng() % 3) % static_cast<uint32_t>(resources.size());
+      Resource& resource = resources[index];
+      const uint32_t count = static_cast<uint32_t>(resource.reference.size());
+      const uint32_t new_state = states[rng() % (rng() % 2 == 0 ? 3 : std::size(states))];
+      const uint32_t subresource = rng() % 2 == 0 ? kAll : rng() % count;
+
+      for (uint32_t s = 0; s < count; ++s) {
+        if ((subresource == kAll || subresource == s) && resource.reference[s] != new_state) {
+          ++totals.needed;
+          resource.reference[s] = new_state;
+        }
+      }
+      batch.Transition(&ids[index], resource.tracked, count, new_state, subresource);
+      ++totals.transitions;
+      totals.violations += MatchesReference(resource) ? 0 : 1;
+    }
+
+    totals.barriers += batch.GetPending().size();
+    totals.violations += ReplayBarriers(batch, resources);
+    batch.Clear();
+    for (const Resource& resource : resources) {
+      totals.violations += resource.gpu != resource.reference ? 1 : 0;
+    }
+  }
+
+  // Merging never issues more barriers than there were state changes
+  if (totals.barriers > totals.needed) {
+    ++totals.violations;
+  }
+
+  std::cout << "Random: " << options.batches << " batches, seed " << options.seed << '\n';
+  std::cout << "  Transitions: " << totals.transitions << ", subresource changes: " << totals.needed << ", barriers: " << totals.barriers
+            << ", eliminated: " << batch.GetEliminatedCount() << '\n';
+  std::cout << "  Violations: " << totals.violations << " (must be 0)" << '\n';
+  return totals.violations == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: barrier_batch_check [--batches <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Barrier Batch Check ===" << '\n';
+  const bool checks_passed = RunChecks();
+  const bool random_passed = RunRandom(options);
+  return checks_passed && random_passed ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+// descriptor_stress: Multithreaded stress test for ThreadCachedRangeAllocator (thread_cached_range_allocator.h),
+// the front-end DescriptorHeapAllocator uses for SRV indices.
+//
+// Each thread allocates and frees random mixes of single descriptors (the magazine path), descriptor tables and
+// aligned ranges (the shared path), and hands some of its allocations to other threads to free, as loader
+// threads do with the main thread. The capacity is kept small enough that the shared allocator runs dry, so
+// refills, flushes and steals between magazines all happen. Every unit handed out is claimed in an ownership
+// table, so a unit given to two holders at once is reported as an overlap. After the threads join, every unit
+// must be free again: nothing allocated, and the whole capacity allocatable one descriptor at a time.
+//
+// Usage: descriptor_stress [--threads <n>] [--iterations <n>] [--capacity <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "thread_cached_range_allocator.h"
+
+namespace {
+struct Options {
+  uint32_t threads = 16;
+  uint32_t iterations = 200000;
+  uint64_t capacity = 4096;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--threads" && has_value) {
+      options.threads = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--iterations" && has_value) {
+      options.iterations = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--capacity" && has_value) {
+      options.capacity = static_cast<uint64_t>((std::max)(64, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[descriptor_stress] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Units per holder: 0 is free, otherwise the id of the thread holding it plus one
+class OwnershipTable {
+ public:
+  explicit OwnershipTable(uint64_t capacity) : owners_(std::make_unique<std::atomic<uint32_t>[]>(capacity)), capacity_(capacity) {
+  }
+
+  // False when a unit is out of range or already held
+  bool Claim(const RangeAllocator::Allocation& allocation, uint32_t owner) {
+    if (allocation.offset + allocation.size > capacity_) {
+      return false;
+    }
+    bool claimed = true;
+    for (uint64_t unit = allocation.offset; unit < allocation.offset + allocation.size; ++unit) {
+      uint32_t expected = 0;
+      if (!owners_[unit].compare_exchange_strong(expected, owner, std::memory_order_acq_rel)) {
+        claimed = false;
+      }
+    }
+    return claimed;
+  }
+
+  // False when a unit was not held by owner (someone else claimed it in the meantime)
+  bool Release(const RangeAllocator::Allocation& allocation, uint32_t owner) {
+    bool released = true;
+    for (uint64_t unit = allocation.offset; unit < allocation.offset + allocation.size; ++unit) {
+      if (owners_[unit].exchange(0, std::memory_order_acq_rel) != owner) {
+        released = false;
+      }
+    }
+    return released;
+  }
+
+  uint64_t CountHeld() const {
+    uint64_t held = 0;
+    for (uint64_t unit = 0; unit < capacity_; ++unit) {
+      if (owners_[unit].load(std::memory_order_relaxed) != 0) {
+        ++held;
+      }
+    }
+    return held;
+  }
+
+ private:
+  std::unique_ptr<std::atomic<uint32_t>[]> owners_;
+  uint64_t capacity_;
+};
+
+// Allocations passed between threads; whoever pops one frees it
+struct Handoff {
+  std::mutex mutex;
+  std::vector<std::pair<RangeAllocator::Allocation, uint32_t>> allocations;
+};
+
+struct Counters {
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> failed_allocations{0};
+  std::atomic<uint64_t> frees{0};
+  std::atomic<uint64_t> handoffs{0};
+  std::atomic<uint64_t> overlaps{0};
+  std::atomic<uint64_t> bad_frees{0};
+};
+
+struct Request {
+  uint64_t size;
+  uint64_t alignment;
+};
+
+// Mostly single SRVs, as in practice; some tables and aligned ranges exercise the shared path
+Request RandomRequest(std::mt19937& rng) {
+  const uint32_t roll = rng() % 100;
+  if (roll < 85) {
+    return {1, 1};
+  }
+  if (roll < 95) {
+    return {2 + rng() % 7, 1};
+  }
+  return {1 + rng() % 4, 1ull << (rng() % 4)};
+}
+
+void RunThread(
+  ThreadCachedRangeAllocator& allocator,
+  OwnershipTable& table,
+  Handoff& handoff,
+  Counters& counters,
+  uint32_t thread_index,
+  uint32_t iterations,
+  size_t max_live,
+  uint32_t seed) {
+  const uint32_t owner = thread_index + 1;
+  std::mt19937 rng(seed * 7919u + thread_index);
+  std::vector<RangeAllocator::Allocation> live;
+  live.reserve(max_live);
+
+  auto release = [&](const RangeAllocator::Allocation& allocation, uint32_t holder) {
+    if (!table.Release(allocation, holder)) {
+      counters.bad_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+    allocator.Free(allocation);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+  };
+
+  for (uint32_t i = 0; i < iterations; ++i) {
+    const uint32_t action = rng() % 100;
+    if (action < 55 && live.size() < max_live) {
+      const Request request = RandomRequest(rng);
+      const RangeAllocator::Allocation allocation = allocator.Allocate(request.size, request.alignment);
+      if (!allocation.IsValid()) {
+        counters.failed_allocations.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      counters.allocations.fetch_add(1, std::memory_order_relaxed);
+      if (allocation.size != request.size || (allocation.offset & (request.alignment - 1)) != 0 ||
+          !table.Claim(allocation, owner)) {
+        counters.overlaps.fetch_add(1, std::memory_order_relaxed);
+      }
+      live.push_back(allocation);
+    } else if (action < 90 && !live.empty()) {
+      const size_t index = rng() % live.size();
+      release(live[index], owner);
+      live[index] = live.back();
+      live.pop_back();
+    } else if (action < 95 && !live.empty()) {
+      std::lock_guard<std::mutex> lock(handoff.mutex);
+      handoff.allocations.emplace_back(live.back(), owner);
+      live.pop_back();
+      counters.handoffs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      std::pair<RangeAllocator::Allocation, uint32_t> received{};
+      {
+        std::lock_guard<std::mutex> lock(handoff.mutex);
+        if (handoff.allocations.empty()) {
+          continue;
+        }
+        received = handoff.allocations.back();
+        handoff.allocations.pop_back();
+      }
+      release(received.first, received.second);
+    }
+  }
+
+  for (const RangeAllocator::Allocation& allocation : live) {
+    release(allocation, owner);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: descriptor_stress [--threads <n>] [--iterations <n>] [--capacity <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  ThreadCachedRangeAllocator allocator;
+  allocator.Initialize(options.capacity);
+  OwnershipTable table(options.capacity);
+  Handoff handoff;
+  Counters counters;
+
+  // Enough live allocations across threads to exhaust the capacity now and then
+  const size_t max_live = static_cast<size_t>((options.capacity * 3 / 2) / options.threads) + 1;
+
+  std::cout << "=== Descriptor Stress ===" << '\n';
+  std::cout << "Threads: " << options.threads << ", iterations per thread: " << options.iterations
+            << ", capacity: " << options.capacity << '\n';
+
+  const uint64_t start = NowNs();
+  std::vector<std::thread> threads;
+  threads.reserve(options.threads);
+  for (uint32_t t = 0; t < options.threads; ++t) {
+    threads.emplace_back(
+      RunThread, std::ref(allocator), std::ref(table), std::ref(handoff), std::ref(counters), t, options.iterations, max_live,
+      options.seed);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const double elapsed_ms = static_cast<double>(NowNs() - start) / 1e6;
+
+  // Allocations still waiting in the handoff list belong to threads that have exited
+  for (const auto& [allocation, holder] : handoff.allocations) {
+    if (!table.Release(allocation, holder)) {
+      counters.bad_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+    allocator.Free(allocation);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+  }
+  handoff.allocations.clear();
+
+  const ThreadCachedRangeAllocator::Stats stats = allocator.GetStats();
+  const uint64_t operations = counters.allocations + counters.failed_allocations + counters.frees;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Time: " << elapsed_ms << " ms, " << (static_cast<double>(operations) / (elapsed_ms * 1000.0)) << " M ops/s" << '\n';
+  std::cout << "Allocations: " << counters.allocations << " (" << counters.failed_allocations << " failed while exhausted)"
+            << ", frees: " << counters.frees << " (" << counters.handoffs << " on another thread)" << '\n';
+  std::cout << "Magazine hits: " << stats.magazine_hits << ", refills: " << stats.refills << ", flushes: " << stats.flushes
+            << ", steals: " << stats.steals << ", lock contentions: " << stats.lock_contentions << '\n';
+
+  bool passed = true;
+  auto check = [&passed](bool condition, const char* what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << '\n';
+    passed = passed && condition;
+  };
+
+  // Leak checks: everything came back, and every unit can be handed out again exactly once
+  const uint64_t held_units = table.CountHeld();
+  const uint64_t allocated_size = allocator.GetAllocatedSize();
+
+  uint64_t drained = 0;
+  bool drain_overlap = false;
+  for (;;) {
+    const RangeAllocator::Allocation allocation = allocator.Allocate(1);
+    if (!allocation.IsValid()) {
+      break;
+    }
+    if (!table.Claim(allocation, 1)) {
+      drain_overlap = true;
+    }
+    ++drained;
+  }
+
+  check(counters.overlaps == 0, "no unit handed to two holders at once");
+  check(counters.bad_frees == 0, "every freed unit was held by the freeing holder");
+  check(held_units == 0, "no units held after join");
+  check(allocated_size == 0, "allocator reports nothing allocated after join");
+  check(counters.allocations == counters.frees, "every allocation freed exactly once");
+  check(drained == options.capacity && !drain_overlap, "whole capacity allocatable again, one descriptor at a time");
+
+  std::cout << (passed ? "Passed" : "FAILED") << '\n';
+  return passed ? 0 : 1;
+}
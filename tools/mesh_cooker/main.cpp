@@ -0,0 +1,132 @@
+// mesh_cooker: Converts OBJ / glTF meshes into cooked mesh containers (.cmsh, see cooked_mesh.h): welded
+// vertices, triangles ordered for the post-transform vertex cache, vertices ordered for fetch locality,
+// quantized 16-byte vertices and 16-bit indices whenever they fit, so the runtime maps the file and copies
+// the vertex and index blocks into upload memory as they are. Triangles are also grouped into meshlets
+// (64 vertices / 124 triangles) with bounding spheres and normal cones for per-cluster culling.
+//
+// Usage: mesh_cooker [options] <input.obj | input.gltf | input.glb>...
+//   -o <dir>          Output directory (default: next to each input)
+//   --index32         Always write 32-bit indices
+//   --no-optimize     Keep the source triangle and vertex order (welding and quantization still apply)
+//   --no-meshlets     Do not build meshlets
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cooked_mesh.h"
+#include "mesh_import.h"
+
+namespace {
+struct Options {
+  std::filesystem::path output_dir;
+  bool force_index32 = false;
+  bool optimize = true;
+  bool meshlets = true;
+  std::vector<std::filesystem::path> inputs;
+};
+
+void PrintUsage() {
+  std::cerr << "Usage: mesh_cooker [-o <dir>] [--index32] [--no-optimize] [--no-meshlets] <input.obj | input.gltf | input.glb>..." << '\n';
+}
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "-o" && has_value) {
+      options.output_dir = argv[++i];
+    } else if (arg == "--index32") {
+      options.force_index32 = true;
+    } else if (arg == "--no-optimize") {
+      options.optimize = false;
+    } else if (arg == "--no-meshlets") {
+      options.meshlets = false;
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[mesh_cooker] Unknown option: " << arg << '\n';
+      return false;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.inputs.empty();
+}
+
+bool CookFile(const std::filesystem::path& input, const Options& options) {
+  const auto start = std::chrono::steady_clock::now();
+
+  MeshSource source;
+  if (!ImportMesh(input, source)) {
+    std::cerr << "[mesh_cooker] Failed to import " << input.string() << '\n';
+    return false;
+  }
+
+  CookMeshOptions cook_options;
+  cook_options.optimize_vertex_cache = options.optimize;
+  cook_options.optimize_vertex_fetch = options.optimize;
+  cook_options.force_index32 = options.force_index32;
+  cook_options.build_meshlets = options.meshlets;
+
+  std::vector<uint8_t> file;
+  CookMeshStats stats;
+  if (!CookMesh(source, cook_options, file, &stats)) {
+    return false;
+  }
+
+  const std::filesystem::path output_dir = options.output_dir.empty() ? input.parent_path() : options.output_dir;
+  const std::filesystem::path output = output_dir / input.filename().replace_extension(".cmsh");
+  std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+  if (!stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()))) {
+    std::cerr << "[mesh_cooker] Failed to write " << output.string() << '\n';
+    return false;
+  }
+
+  const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  const auto* header = reinterpret_cast<const CookedMeshHeader*>(file.data());
+  const bool index32 = (header->flags & kCookedMeshFlagIndex32) != 0;
+  std::cout << output.string() << ": " << header->submesh_count << " submesh(es), " << stats.triangles << " triangles, "
+            << stats.source_vertices << " -> " << stats.vertices << " vertices, " << (index32 ? "32" : "16") << "-bit indices, "
+            << file.size() / 1024 << " KB, " << std::fixed << std::setprecision(1) << elapsed_ms << " ms" << '\n';
+  std::cout << std::setprecision(3) << "  ACMR " << stats.acmr_before << " -> " << stats.acmr_after << ", ATVR " << stats.atvr_before
+            << " -> " << stats.atvr_after << ", overfetch " << stats.overfetch_before << " -> " << stats.overfetch_after << '\n';
+  std::cout << "  Max error: position " << std::setprecision(6) << stats.max_position_error << ", normal " << std::setprecision(3)
+            << stats.max_normal_error << " deg, texcoord " << std::setprecision(6) << stats.max_texcoord_error
+            << (stats.generated_normals ? " (generated normals)" : "") << '\n';
+  if (stats.meshlets > 0) {
+    std::cout << "  " << stats.meshlets << " meshlets, " << std::setprecision(1)
+              << static_cast<double>(stats.meshlet_vertices) / static_cast<double>(stats.meshlets) << " vertices / "
+              << static_cast<double>(stats.triangles) / static_cast<double>(stats.meshlets) << " triangles on average" << '\n';
+  }
+  if (stats.degenerate_triangles > 0) {
+    std::cout << "  Removed " << stats.degenerate_triangles << " degenerate triangle(s)" << '\n';
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    PrintUsage();
+    return 1;
+  }
+
+  if (!options.output_dir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(options.output_dir, error);
+  }
+
+  uint32_t failures = 0;
+  for (const std::filesystem::path& input : options.inputs) {
+    if (!CookFile(input, options)) {
+      ++failures;
+    }
+  }
+
+  std::cout << "Cooked " << options.inputs.size() - failures << " / " << options.inputs.size() << " mesh(es)" << '\n';
+  return failures == 0 ? 0 : 1;
+}
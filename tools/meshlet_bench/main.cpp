@@ -0,0 +1,368 @@
+// meshlet_bench: How much of a cooked mesh per-meshlet culling removes, and what it costs on the CPU.
+// The mesh is viewed from cameras spread evenly around it, in two sets: orbit views that frame the whole
+// mesh (only backface cones cull much) and close-up views with a narrow field of view that see part of it
+// (frustum culling dominates). For each set it reports the meshlets and triangles culled by the frustum and
+// by the normal cones, the sub-draws left after merging neighbouring visible meshlets, and the time per
+// meshlet test. --verify checks every culled meshlet triangle by triangle: none may be both front-facing
+// and inside the frustum.
+//
+// Usage: meshlet_bench [--views <n>] [--iterations <n>] [--verify] <mesh.cmsh | mesh.obj | mesh.gltf | mesh.glb>
+//   Source meshes are cooked in memory with the default options first.
+//   e.g. meshlet_bench --verify Content/Meshes/rock.cmsh
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "cooked_mesh.h"
+#include "mapped_file.h"
+#include "mesh_import.h"
+#include "meshlet.h"
+
+namespace {
+struct Options {
+  std::filesystem::path input;
+  uint32_t views = 64;
+  int iterations = 20;
+  bool verify = false;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--views" && has_value) {
+      options.views = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--iterations" && has_value) {
+      options.iterations = (std::max)(1, std::atoi(argv[++i]));
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[meshlet_bench] Unknown option: " << arg << '\n';
+      return false;
+    } else {
+      options.input = arg;
+    }
+  }
+  return !options.input.empty();
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Subtract(const float a[3], const float b[3], float out[3]) {
+  out[0] = a[0] - b[0];
+  out[1] = a[1] - b[1];
+  out[2] = a[2] - b[2];
+}
+
+void Cross(const float a[3], const float b[3], float out[3]) {
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+float Dot(const float a[3], const float b[3]) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+void Normalize(float v[3]) {
+  const float length = std::sqrt(Dot(v, v));
+  if (length > 0.0f) {
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+  }
+}
+
+// Row-vector view * projection, as XMMatrixLookAtLH * XMMatrixPerspectiveFovLH would build it
+void BuildViewProjection(const float eye[3], const float target[3], float fov_y, float aspect, float near_z, float far_z, float out[16]) {
+  float z_axis[3];
+  Subtract(target, eye, z_axis);
+  Normalize(z_axis);
+  float up[3] = {0.0f, 1.0f, 0.0f};
+  if (std::abs(z_axis[1]) > 0.99f) {
+    up[1] = 0.0f;
+    up[2] = 1.0f;
+  }
+  float x_axis[3];
+  Cross(up, z_axis, x_axis);
+  Normalize(x_axis);
+  float y_axis[3];
+  Cross(z_axis, x_axis, y_axis);
+
+  const float view[16] = {
+    x_axis[0], y_axis[0], z_axis[0], 0.0f,
+    x_axis[1], y_axis[1], z_axis[1], 0.0f,
+    x_axis[2], y_axis[2], z_axis[2], 0.0f,
+    -Dot(x_axis, eye), -Dot(y_axis, eye), -Dot(z_axis, eye), 1.0f,
+  };
+  const float height = 1.0f / std::tan(fov_y * 0.5f);
+  const float range = far_z / (far_z - near_z);
+  const float projection[16] = {
+    height / aspect, 0.0f, 0.0f, 0.0f,
+    0.0f, height, 0.0f, 0.0f,
+    0.0f, 0.0f, range, 1.0f,
+    0.0f, 0.0f, -range * near_z, 0.0f,
+  };
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t c = 0; c < 4; ++c) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < 4; ++k) {
+        sum += view[r * 4 + k] * projection[k * 4 + c];
+      }
+      out[r * 4 + c] = sum;
+    }
+  }
+}
+
+// The mesh as the culling code sees it: meshlet bounds plus dequantized triangles for verification
+struct BenchMesh {
+  std::vector<MeshletBounds> bounds;
+  std::vector<uint32_t> first_triangle;  // Per meshlet, into triangles
+  std::vector<uint32_t> triangle_count;
+  std::vector<uint32_t> first_index;     // Absolute, for merging sub-draws
+  std::vector<uint32_t> base_vertex;
+  std::vector<float> triangles;          // 9 floats per triangle
+  uint32_t submesh_count = 0;
+  float center[3] = {0.0f, 0.0f, 0.0f};
+  float radius = 0.0f;
+};
+
+bool LoadBenchMesh(const CookedMeshView& view, BenchMesh& out) {
+  const CookedMeshHeader& header = *view.header;
+  if (header.meshlet_count == 0) {
+    std::cerr << "[meshlet_bench] Mesh was cooked without meshlets" << '\n';
+    return false;
+  }
+  out.submesh_count = header.submesh_count;
+  float radius_squared = 0.0f;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    out.center[axis] = (header.bounds_min[axis] + header.bounds_max[axis]) * 0.5f;
+    const float half_extent = (header.bounds_max[axis] - header.bounds_min[axis]) * 0.5f;
+    radius_squared += half_extent * half_extent;
+  }
+  out.radius = (std::max)(std::sqrt(radius_squared), 1e-3f);
+
+  for (uint32_t s = 0; s < header.submesh_count; ++s) {
+    const CookedMeshSubmesh& submesh = view.submeshes[s];
+    for (uint32_t m = submesh.first_meshlet; m < submesh.first_meshlet + submesh.meshlet_count; ++m) {
+      const CookedMeshMeshlet& meshlet = view.meshlets[m];
+      MeshletBounds& bounds = out.bounds.emplace_back();
+      std::copy(std::begin(meshlet.center), std::end(meshlet.center), bounds.center);
+      bounds.radius = meshlet.radius;
+      std::copy(std::begin(meshlet.cone_axis), std::end(meshlet.cone_axis), bounds.cone_axis);
+      bounds.cone_cutoff = meshlet.cone_cutoff;
+      out.first_triangle.push_back(static_cast<uint32_t>(out.triangles.size() / 9));
+      out.triangle_count.push_back(meshlet.triangle_count);
+      out.first_index.push_back(meshlet.first_index);
+      out.base_vertex.push_back(submesh.base_vertex);
+      for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i) {
+        float position[3];
+        DequantizePosition(header, view.vertices[submesh.base_vertex + view.GetIndex(meshlet.first_index + i)], position);
+        out.triangles.insert(out.triangles.end(), std::begin(position), std::end(position));
+      }
+    }
+  }
+  return true;
+}
+
+// Sub-draws left after merging visible meshlets that are adjacent in the index buffer
+size_t CountSubDraws(const BenchMesh& mesh, const std::vector<uint32_t>& visible) {
+  size_t draws = 0;
+  uint32_t next_index = ~0u;
+  uint32_t base_vertex = ~0u;
+  for (uint32_t m : visible) {
+    if (mesh.first_index[m] != next_index || mesh.base_vertex[m] != base_vertex) {
+      ++draws;
+    }
+    next_index = mesh.first_index[m] + mesh.triangle_count[m] * 3;
+    base_vertex = mesh.base_vertex[m];
+  }
+  return draws;
+}
+
+// A triangle could produce pixels: front-facing (clockwise in a left-handed space) and not entirely
+// outside one clip plane
+bool IsTriangleVisible(const float* triangle, const float view_projection[16], const float eye[3]) {
+  float ab[3];
+  float ac[3];
+  Subtract(triangle + 3, triangle, ab);
+  Subtract(triangle + 6, triangle, ac);
+  float normal[3];
+  Cross(ab, ac, normal);
+  float to_triangle[3];
+  Subtract(triangle, eye, to_triangle);
+  if (Dot(normal, to_triangle) >= 0.0f) {
+    return false;
+  }
+
+  float clip[3][4];
+  for (size_t k = 0; k < 3; ++k) {
+    const float* p = triangle + k * 3;
+    for (size_t c = 0; c < 4; ++c) {
+      clip[k][c] = p[0] * view_projection[c] + p[1] * view_projection[4 + c] + p[2] * view_projection[8 + c] + view_projection[12 + c];
+    }
+  }
+  auto all_outside = [&](auto&& outside) {
+    return outside(clip[0]) && outside(clip[1]) && outside(clip[2]);
+  };
+  return !(all_outside([](const float* v) { return v[0] < -v[3]; }) || all_outside([](const float* v) { return v[0] > v[3]; }) ||
+           all_outside([](const float* v) { return v[1] < -v[3]; }) || all_outside([](const float* v) { return v[1] > v[3]; }) ||
+           all_outside([](const float* v) { return v[2] < 0.0f; }) || all_outside([](const float* v) { return v[2] > v[3]; }));
+}
+
+struct ViewSetResult {
+  MeshletCullStats stats;
+  size_t triangles = 0;
+  size_t frustum_culled_triangles = 0;
+  size_t cone_culled_triangles = 0;
+  size_t sub_draws = 0;
+  size_t empty_views = 0;
+  uint64_t cull_ns = 0;
+  size_t violations = 0;
+};
+
+// Distance (in bounding radii) and vertical field of view of each camera set
+ViewSetResult RunViewSet(const BenchMesh& mesh, const Options& options, float distance, float fov_y) {
+  ViewSetResult result;
+  const size_t meshlet_count = mesh.bounds.size();
+  std::vector<uint32_t> visible;
+  std::vector<uint8_t> is_visible(meshlet_count);
+  float planes[6][4];
+
+  for (uint32_t v = 0; v < options.views; ++v) {
+    // Fibonacci sphere: evenly spread directions
+    const float y = 1.0f - 2.0f * (static_cast<float>(v) + 0.5f) / static_cast<float>(options.views);
+    const float ring = std::sqrt((std::max)(0.0f, 1.0f - y * y));
+    const float angle = static_cast<float>(v) * std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f));
+    const float direction[3] = {ring * std::cos(angle), y, ring * std::sin(angle)};
+    const float eye[3] = {
+      mesh.center[0] + direction[0] * mesh.radius * distance,
+      mesh.center[1] + direction[1] * mesh.radius * distance,
+      mesh.center[2] + direction[2] * mesh.radius * distance,
+    };
+    float view_projection[16];
+    BuildViewProjection(eye, mesh.center, fov_y, 16.0f / 9.0f, mesh.radius * 0.01f, mesh.radius * (distance + 2.0f), view_projection);
+
+    const uint64_t start = NowNs();
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+      visible.clear();
+      CullMeshlets(mesh.bounds.data(), meshlet_count, view_projection, eye, visible, nullptr);
+    }
+    result.cull_ns += NowNs() - start;
+
+    // Per-reason counts, which CullMeshlets only reports as totals
+    ExtractFrustumPlanes(view_projection, planes);
+    std::fill(is_visible.begin(), is_visible.end(), 0);
+    for (uint32_t m : visible) {
+      is_visible[m] = 1;
+    }
+    for (size_t m = 0; m < meshlet_count; ++m) {
+      result.triangles += mesh.triangle_count[m];
+      if (is_visible[m] != 0) {
+        continue;
+      }
+      if (IsMeshletOutsideFrustum(mesh.bounds[m], planes)) {
+        ++result.stats.frustum_culled;
+        result.frustum_culled_triangles += mesh.triangle_count[m];
+      } else {
+        ++result.stats.cone_culled;
+        result.cone_culled_triangles += mesh.triangle_count[m];
+      }
+      if (options.verify) {
+        for (uint32_t t = 0; t < mesh.triangle_count[m]; ++t) {
+          const float* triangle = &mesh.triangles[(static_cast<size_t>(mesh.first_triangle[m]) + t) * 9];
+          if (IsTriangleVisible(triangle, view_projection, eye)) {
+            ++result.violations;
+          }
+        }
+      }
+    }
+    result.stats.tested += meshlet_count;
+    result.sub_draws += CountSubDraws(mesh, visible);
+    result.empty_views += visible.empty() ? 1 : 0;
+  }
+  return result;
+}
+
+double Percent(size_t part, size_t total) {
+  return total > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+}
+
+void PrintViewSet(const char* name, const ViewSetResult& result, const BenchMesh& mesh, const Options& options) {
+  const double views = static_cast<double>(options.views);
+  const size_t culled_meshlets = result.stats.frustum_culled + result.stats.cone_culled;
+  const size_t culled_triangles = result.frustum_culled_triangles + result.cone_culled_triangles;
+  std::cout << name << '\n';
+  std::cout << std::fixed << std::setprecision(1) << "  Meshlets culled: " << Percent(culled_meshlets, result.stats.tested) << "% (frustum "
+            << Percent(result.stats.frustum_culled, result.stats.tested) << "%, cone "
+            << Percent(result.stats.cone_culled, result.stats.tested) << "%)" << '\n';
+  std::cout << "  Triangles culled: " << Percent(culled_triangles, result.triangles) << "% (frustum "
+            << Percent(result.frustum_culled_triangles, result.triangles) << "%, cone "
+            << Percent(result.cone_culled_triangles, result.triangles) << "%)" << '\n';
+  std::cout << "  Draws per view: " << static_cast<double>(result.sub_draws) / views << " merged sub-draws (" << mesh.bounds.size()
+            << " meshlets, " << mesh.submesh_count << " without culling), " << result.empty_views << " view(s) fully culled" << '\n';
+  std::cout << std::setprecision(2) << "  Cull cost: "
+            << static_cast<double>(result.cull_ns) / (static_cast<double>(result.stats.tested) * options.iterations) << " ns / meshlet, "
+            << static_cast<double>(result.cull_ns) / 1e3 / (views * options.iterations) << " us / view" << '\n';
+  if (options.verify) {
+    std::cout << "  Verify: " << result.violations << " visible triangle(s) in culled meshlets" << '\n';
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: meshlet_bench [--views <n>] [--iterations <n>] [--verify] <mesh.cmsh | mesh.obj | mesh.gltf | mesh.glb>" << '\n';
+    return 1;
+  }
+
+  MappedFile mapped;
+  std::vector<uint8_t> cooked;
+  const uint8_t* bytes = nullptr;
+  size_t size = 0;
+  if (options.input.extension() == ".cmsh") {
+    if (!mapped.Open(options.input)) {
+      std::cerr << "[meshlet_bench] Failed to open " << options.input.string() << '\n';
+      return 1;
+    }
+    bytes = mapped.GetData();
+    size = mapped.GetSize();
+  } else {
+    MeshSource source;
+    if (!ImportMesh(options.input, source) || !CookMesh(source, {}, cooked)) {
+      std::cerr << "[meshlet_bench] Failed to cook " << options.input.string() << '\n';
+      return 1;
+    }
+    bytes = cooked.data();
+    size = cooked.size();
+  }
+
+  CookedMeshView view;
+  BenchMesh mesh;
+  if (!ParseCookedMesh(bytes, size, view) || !LoadBenchMesh(view, mesh)) {
+    return 1;
+  }
+
+  std::cout << "=== Meshlet Bench ===" << '\n';
+  std::cout << "Mesh: " << options.input.filename().string() << ", " << view.header->index_count / 3 << " triangles, " << mesh.bounds.size()
+            << " meshlets in " << mesh.submesh_count << " submesh(es)" << '\n';
+  std::cout << "Views: " << options.views << " per set, iterations: " << options.iterations << '\n';
+
+  constexpr float kDegrees = std::numbers::pi_v<float> / 180.0f;
+  PrintViewSet("Orbit (whole mesh in view, 60 deg at 2.5 radii)", RunViewSet(mesh, options, 2.5f, 60.0f * kDegrees), mesh, options);
+  PrintViewSet("Close-up (25 deg at 1.2 radii)", RunViewSet(mesh, options, 1.2f, 25.0f * kDegrees), mesh, options);
+  return 0;
+}
@@ -0,0 +1,305 @@
+// occlusion_bench: Correctness checks and timings for the software occlusion buffer (occlusion_buffer.h)
+// on synthetic scenes, at the resolution RenderSystem uses.
+//
+// The checks are scenes with known answers, seen by a camera at the origin looking down +z: bounds behind a
+// full-screen wall are culled; bounds in front of it, beside a half-screen wall, inside a gap between two
+// walls, straddling a wall's edge or depth, or crossing the near plane stay visible; a ground plane that
+// crosses the near plane (and so gets clipped) hides boxes below it. The benchmark fills random scenes of box
+// occluders and times rasterization, the hierarchical depth build and the bounds tests. Bounds placed in
+// front of every occluder must all stay visible, which guards against culling too much.
+//
+// Usage: occlusion_bench [--occluders <n>] [--tests <n>] [--iterations <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "occlusion_buffer.h"
+
+namespace {
+// Same as RenderSystem
+constexpr uint32_t kWidth = 256;
+constexpr uint32_t kHeight = 144;
+
+constexpr float kNearZ = 0.1f;
+constexpr float kFarZ = 1000.0f;
+
+struct Options {
+  uint32_t occluders = 64;
+  uint32_t tests = 4096;
+  int iterations = 50;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--occluders" && has_value) {
+      options.occluders = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--tests" && has_value) {
+      options.tests = static_cast<uint32_t>((std::max)(2, std::atoi(argv[++i])));
+    } else if (arg == "--iterations" && has_value) {
+      options.iterations = (std::max)(1, std::atoi(argv[++i]));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[occlusion_bench] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Row-vector XMMatrixPerspectiveFovLH; the camera sits at the origin looking down +z, so view space is
+// the local space of every test object
+struct Projection {
+  float m[16] = {};
+
+  Projection() {
+    const float fov_y = 60.0f * std::numbers::pi_v<float> / 180.0f;
+    const float height = 1.0f / std::tan(fov_y * 0.5f);
+    const float range = kFarZ / (kFarZ - kNearZ);
+    m[0] = height * static_cast<float>(kHeight) / static_cast<float>(kWidth);
+    m[5] = height;
+    m[10] = range;
+    m[11] = 1.0f;
+    m[14] = -range * kNearZ;
+  }
+};
+
+struct Box {
+  float min[3];
+  float max[3];
+};
+
+// Occluder geometry collected per scene
+struct Mesh {
+  std::vector<float> positions;
+  std::vector<uint32_t> indices;
+
+  void AddQuad(const float a[3], const float b[3], const float c[3], const float d[3]) {
+    const uint32_t base = static_cast<uint32_t>(positions.size() / 3);
+    for (const float* p : {a, b, c, d}) {
+      positions.insert(positions.end(), p, p + 3);
+    }
+    indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+  }
+
+  // Rectangle facing the camera at depth z
+  void AddWall(float min_x, float min_y, float max_x, float max_y, float z) {
+    const float a[3] = {min_x, min_y, z};
+    const float b[3] = {min_x, max_y, z};
+    const float c[3] = {max_x, max_y, z};
+    const float d[3] = {max_x, min_y, z};
+    AddQuad(a, b, c, d);
+  }
+
+  void AddBox(const Box& box) {
+    const float x[2] = {box.min[0], box.max[0]};
+    const float y[2] = {box.min[1], box.max[1]};
+    const float z[2] = {box.min[2], box.max[2]};
+    const uint32_t base = static_cast<uint32_t>(positions.size() / 3);
+    for (size_t corner = 0; corner < 8; ++corner) {
+      positions.insert(positions.end(), {x[corner & 1], y[(corner >> 1) & 1], z[corner >> 2]});
+    }
+    constexpr uint32_t kFaces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+    for (const auto& face : kFaces) {
+      indices.insert(indices.end(),
+        {base + face[0], base + face[1], base + face[2], base + face[0], base + face[2], base + face[3]});
+    }
+  }
+};
+
+void Rasterize(OcclusionBuffer& buffer, const Projection& projection, const Mesh& mesh) {
+  buffer.Clear();
+  buffer.RasterizeOccluder(projection.m,
+    mesh.positions.data(),
+    static_cast<uint32_t>(mesh.positions.size() / 3),
+    mesh.indices.data(),
+    static_cast<uint32_t>(mesh.indices.size()));
+  buffer.BuildHiZ();
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(OcclusionBuffer& buffer, const Projection& projection, const char* name, const Box& box, bool expected_visible) {
+    const bool visible = buffer.IsVisible(projection.m, box.min, box.max);
+    if (visible == expected_visible) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << ": " << (visible ? "visible" : "culled") << ", expected "
+              << (expected_visible ? "visible" : "culled") << '\n';
+  }
+};
+
+bool RunChecks(OcclusionBuffer& buffer, const Projection& projection) {
+  Checker checker;
+
+  // Nothing rasterized: everything is visible
+  Rasterize(buffer, projection, {});
+  checker.Expect(buffer, projection, "empty buffer", {{-1, -1, 20}, {1, 1, 22}}, true);
+
+  // Full-screen wall at z = 10
+  Mesh wall;
+  wall.AddWall(-100, -100, 100, 100, 10);
+  Rasterize(buffer, projection, wall);
+  checker.Expect(buffer, projection, "behind full wall", {{-1, -1, 20}, {1, 1, 22}}, false);
+  checker.Expect(buffer, projection, "far behind full wall", {{-50, -20, 500}, {50, 20, 600}}, false);
+  checker.Expect(buffer, projection, "in front of full wall", {{-1, -1, 5}, {1, 1, 6}}, true);
+  checker.Expect(buffer, projection, "through full wall depth", {{-1, -1, 8}, {1, 1, 12}}, true);
+  checker.Expect(buffer, projection, "crossing near plane", {{-1, -1, -1}, {1, 1, 30}}, true);
+
+  // Left half of the screen covered
+  Mesh half;
+  half.AddWall(-100, -100, 0, 100, 10);
+  Rasterize(buffer, projection, half);
+  checker.Expect(buffer, projection, "behind half wall", {{-8, -1, 20}, {-6, 1, 22}}, false);
+  checker.Expect(buffer, projection, "beside half wall", {{6, -1, 20}, {8, 1, 22}}, true);
+  checker.Expect(buffer, projection, "straddling half wall edge", {{-1, -1, 20}, {1, 1, 22}}, true);
+
+  // Two walls with a gap around x = 0
+  Mesh gap;
+  gap.AddWall(-100, -100, -2, 100, 10);
+  gap.AddWall(2, -100, 100, 100, 10);
+  Rasterize(buffer, projection, gap);
+  checker.Expect(buffer, projection, "behind gap", {{-0.5f, -1, 20}, {0.5f, 1, 22}}, true);
+  checker.Expect(buffer, projection, "behind left wall of gap", {{-30, -1, 20}, {-20, 1, 22}}, false);
+
+  // Ground plane at y = -1 from behind the camera to z = 200: clipped at the near plane
+  Mesh ground;
+  const float a[3] = {-200, -1, -10};
+  const float b[3] = {-200, -1, 200};
+  const float c[3] = {200, -1, 200};
+  const float d[3] = {200, -1, -10};
+  ground.AddQuad(a, b, c, d);
+  Rasterize(buffer, projection, ground);
+  checker.Expect(buffer, projection, "below clipped ground", {{-1, -5, 20}, {1, -3, 22}}, false);
+  checker.Expect(buffer, projection, "above clipped ground", {{-1, 1, 20}, {1, 3, 22}}, true);
+
+  // Box occluder: a smaller box right behind it is hidden, one sticking out above it is not
+  Mesh box;
+  box.AddBox({{-4, -4, 10}, {4, 4, 12}});
+  Rasterize(buffer, projection, box);
+  checker.Expect(buffer, projection, "behind box occluder", {{-1, -1, 20}, {1, 1, 21}}, false);
+  checker.Expect(buffer, projection, "above box occluder", {{-1, 6, 20}, {1, 12, 21}}, true);
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+float Uniform(std::mt19937& rng, float min, float max) {
+  return std::uniform_real_distribution<float>(min, max)(rng);
+}
+
+// Boxes at depth [min_z, max_z) with their near face inside the view (60 degrees vertical, 16:9), so none
+// are culled for being off-screen; sizes relative to their distance
+Box RandomBox(std::mt19937& rng, float min_z, float max_z, float min_size, float max_size) {
+  const float z = Uniform(rng, min_z, max_z);
+  const float half_width = z * 0.9f;
+  const float half_height = z * 0.5f;
+  const float size[3] = {Uniform(rng, min_size, max_size) * z, Uniform(rng, min_size, max_size) * z, Uniform(rng, min_size, max_size) * z};
+  const float x = Uniform(rng, -half_width, half_width);
+  const float y = Uniform(rng, -half_height, half_height);
+  return {{x - size[0] * 0.5f, y - size[1] * 0.5f, z}, {x + size[0] * 0.5f, y + size[1] * 0.5f, z + size[2]}};
+}
+
+bool RunBenchmark(OcclusionBuffer& buffer, const Projection& projection, const Options& options) {
+  std::mt19937 rng(options.seed);
+
+  Mesh occluders;
+  for (uint32_t i = 0; i < options.occluders; ++i) {
+    occluders.AddBox(RandomBox(rng, 20.0f, 60.0f, 0.1f, 0.4f));
+  }
+  // Half of the tests sit in front of every occluder (must stay visible), half behind all of them
+  std::vector<Box> tests;
+  for (uint32_t i = 0; i < options.tests; ++i) {
+    tests.push_back(i % 2 == 0 ? RandomBox(rng, 2.0f, 10.0f, 0.01f, 0.05f) : RandomBox(rng, 100.0f, 300.0f, 0.01f, 0.05f));
+  }
+
+  uint64_t raster_ns = 0;
+  uint64_t hiz_ns = 0;
+  uint64_t test_ns = 0;
+  uint32_t wrongly_culled = 0;
+  uint32_t culled_behind = 0;
+  for (int iteration = 0; iteration < options.iterations; ++iteration) {
+    const uint64_t start = NowNs();
+    buffer.Clear();
+    buffer.RasterizeOccluder(projection.m,
+      occluders.positions.data(),
+      static_cast<uint32_t>(occluders.positions.size() / 3),
+      occluders.indices.data(),
+      static_cast<uint32_t>(occluders.indices.size()));
+    const uint64_t rasterized = NowNs();
+    buffer.BuildHiZ();
+    const uint64_t built = NowNs();
+    uint32_t front_culled = 0;
+    uint32_t behind_culled = 0;
+    for (size_t i = 0; i < tests.size(); ++i) {
+      const bool visible = buffer.IsVisible(projection.m, tests[i].min, tests[i].max);
+      front_culled += (i % 2 == 0 && !visible) ? 1 : 0;
+      behind_culled += (i % 2 == 1 && !visible) ? 1 : 0;
+    }
+    const uint64_t tested = NowNs();
+
+    raster_ns += rasterized - start;
+    hiz_ns += built - rasterized;
+    test_ns += tested - built;
+    wrongly_culled = front_culled;
+    culled_behind = behind_culled;
+  }
+
+  const double iterations = static_cast<double>(options.iterations);
+  const uint32_t triangles = static_cast<uint32_t>(occluders.indices.size() / 3);
+  const size_t behind_count = tests.size() / 2;
+  std::cout << "Random scene: " << options.occluders << " box occluders (" << triangles << " triangles), " << tests.size()
+            << " tested bounds, seed " << options.seed << '\n';
+  std::cout << std::fixed << std::setprecision(2) << "  Rasterize: " << static_cast<double>(raster_ns) / 1e3 / iterations << " us ("
+            << static_cast<double>(raster_ns) / (iterations * triangles) << " ns / triangle)" << '\n';
+  std::cout << "  Build HiZ: " << static_cast<double>(hiz_ns) / 1e3 / iterations << " us" << '\n';
+  std::cout << "  Tests: " << static_cast<double>(test_ns) / 1e3 / iterations << " us ("
+            << static_cast<double>(test_ns) / (iterations * static_cast<double>(tests.size())) << " ns / bounds)" << '\n';
+  std::cout << std::setprecision(1) << "  Behind the occluders: " << 100.0 * culled_behind / static_cast<double>(behind_count)
+            << "% culled" << '\n';
+  std::cout << "  In front of the occluders: " << wrongly_culled << " culled (must be 0)" << '\n';
+  return wrongly_culled == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: occlusion_bench [--occluders <n>] [--tests <n>] [--iterations <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  OcclusionBuffer buffer;
+  if (!buffer.Initialize(kWidth, kHeight)) {
+    return 1;
+  }
+  const Projection projection;
+
+  std::cout << "=== Occlusion Bench ===" << '\n';
+  std::cout << "Buffer: " << buffer.GetWidth() << "x" << buffer.GetHeight() << ", iterations: " << options.iterations << '\n';
+  const bool checks_passed = RunChecks(buffer, projection);
+  const bool benchmark_passed = RunBenchmark(buffer, projection, options);
+  return checks_passed && benchmark_passed ? 0 : 1;
+}
@@ -0,0 +1,315 @@
+// placement_bench: Correctness checks, fragmentation and timings for PagedRangeAllocator
+// (paged_range_allocator.h), the placement logic behind GpuMemoryAllocator's heap pages.
+//
+// The checks are cases with known answers: invalid requests, placement alignment, pages filling up and new
+// ones being added, oversized requests getting a dedicated page, the one kept empty page, page id reuse, and
+// fragmentation stats on a checkerboard of freed blocks that coalesce again. The benchmark runs a random mix
+// of texture and buffer sized requests (64KB placement alignment, like the GPU pools) whose live set grows to
+// the budget and shrinks to a quarter of it in waves, and checks every placement against a shadow map of each
+// page: in bounds, aligned and overlapping nothing. Freeing everything at the end must leave only the kept
+// empty page.
+//
+// Usage: placement_bench [--page-size <MB>] [--budget <MB>] [--operations <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "paged_range_allocator.h"
+
+namespace {
+// D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT and D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT
+constexpr uint64_t kPlacementAlignment = 64ull << 10;
+constexpr uint64_t kMsaaPlacementAlignment = 4ull << 20;
+
+struct Options {
+  uint64_t page_size = 32ull << 20;  // DEFAULT_GPU_HEAP_PAGE_SIZE
+  uint64_t budget = 512ull << 20;
+  uint32_t operations = 200000;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--page-size" && has_value) {
+      options.page_size = static_cast<uint64_t>((std::max)(1, std::atoi(argv[++i]))) << 20;
+    } else if (arg == "--budget" && has_value) {
+      options.budget = static_cast<uint64_t>((std::max)(1, std::atoi(argv[++i]))) << 20;
+    } else if (arg == "--operations" && has_value) {
+      options.operations = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[placement_bench] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+// Occupied ranges of every page (offset -> end), to catch placements that overlap or leave their page
+class ShadowPages {
+ public:
+  bool Insert(const PagedRangeAllocator& allocator, const PagedRangeAllocator::Allocation& allocation, uint64_t alignment) {
+    if (!allocator.IsPageActive(allocation.page) || allocation.offset % alignment != 0 ||
+        allocation.offset + allocation.size > allocator.GetPageSize(allocation.page)) {
+      return false;
+    }
+    if (pages_.size() <= allocation.page) {
+      pages_.resize(allocation.page + 1);
+    }
+
+    std::map<uint64_t, uint64_t>& ranges = pages_[allocation.page];
+    const uint64_t end = allocation.offset + allocation.size;
+    const auto next = ranges.lower_bound(allocation.offset);
+    if (next != ranges.end() && next->first < end) {
+      return false;
+    }
+    if (next != ranges.begin() && std::prev(next)->second > allocation.offset) {
+      return false;
+    }
+    ranges.emplace(allocation.offset, end);
+    return true;
+  }
+
+  void Erase(const PagedRangeAllocator::Allocation& allocation) {
+    pages_[allocation.page].erase(allocation.offset);
+  }
+
+ private:
+  std::vector<std::map<uint64_t, uint64_t>> pages_;
+};
+
+bool RunChecks(uint64_t page_size) {
+  Checker checker;
+  PagedRangeAllocator allocator;
+  allocator.Initialize(page_size);
+  bool new_page = false;
+
+  // Invalid requests place nothing
+  checker.Expect(!allocator.Allocate(0, kPlacementAlignment, new_page).IsValid() && !new_page, "zero size rejected");
+  checker.Expect(!allocator.Allocate(256, 0, new_page).IsValid() && !new_page, "zero alignment rejected");
+  checker.Expect(!allocator.Allocate(256, 3 << 10, new_page).IsValid() && !new_page, "non power of two alignment rejected");
+
+  // The first request adds a page, later ones share it
+  const PagedRangeAllocator::Allocation first = allocator.Allocate(256, 256, new_page);
+  checker.Expect(first.IsValid() && new_page && first.page == 0, "first allocation adds a page");
+  const PagedRangeAllocator::Allocation second = allocator.Allocate(kPlacementAlignment, kPlacementAlignment, new_page);
+  checker.Expect(second.IsValid() && !new_page && second.page == first.page, "second allocation shares the page");
+  checker.Expect(second.offset % kPlacementAlignment == 0 && second.offset >= first.offset + first.size, "placement alignment honoured");
+  const PagedRangeAllocator::Allocation msaa = allocator.Allocate(kMsaaPlacementAlignment, kMsaaPlacementAlignment, new_page);
+  checker.Expect(msaa.IsValid() && msaa.offset % kMsaaPlacementAlignment == 0, "MSAA placement alignment honoured");
+  allocator.Free(first);
+  allocator.Free(second);
+  allocator.Free(msaa);
+
+  // A page holds exactly page_size / 64KB blocks of 64KB
+  const uint64_t blocks_per_page = page_size / kPlacementAlignment;
+  std::vector<PagedRangeAllocator::Allocation> blocks;
+  auto fill_page = [&]() {
+    blocks.clear();
+    bool single_page = true;
+    for (uint64_t i = 0; i < blocks_per_page; ++i) {
+      blocks.push_back(allocator.Allocate(kPlacementAlignment, kPlacementAlignment, new_page));
+      single_page = single_page && blocks.back().IsValid() && blocks.back().page == 0 && !new_page;
+    }
+    return single_page;
+  };
+  checker.Expect(fill_page(), "full page of 64KB blocks fits one page");
+
+  // Fragmentation: freeing every other block leaves 64KB holes, freeing the rest coalesces the page
+  for (size_t i = 0; i < blocks.size(); i += 2) {
+    allocator.Free(blocks[i]);
+  }
+  PagedRangeAllocator::Stats stats = allocator.GetStats();
+  const double checkerboard_fragmentation = 1.0 - 2.0 / static_cast<double>(blocks_per_page);
+  checker.Expect(stats.free_block_count == blocks_per_page / 2 && stats.largest_free_block == kPlacementAlignment &&
+                   std::abs(stats.GetFragmentation() - checkerboard_fragmentation) < 1e-9,
+    "checkerboard reports fragmentation");
+  for (size_t i = 1; i < blocks.size(); i += 2) {
+    allocator.Free(blocks[i]);
+  }
+  stats = allocator.GetStats();
+  checker.Expect(stats.free_block_count == 1 && stats.largest_free_block == page_size && stats.GetFragmentation() == 0.0,
+    "freed blocks coalesce back into one");
+
+  // One more block past a full page adds a page
+  fill_page();
+  const PagedRangeAllocator::Allocation overflow = allocator.Allocate(kPlacementAlignment, kPlacementAlignment, new_page);
+  checker.Expect(overflow.IsValid() && new_page && overflow.page == 1, "block past a full page adds a page");
+  for (const PagedRangeAllocator::Allocation& block : blocks) {
+    allocator.Free(block);
+  }
+
+  // Oversized requests get a dedicated page of exactly their size, released on free
+  const uint64_t oversized_size = page_size + kPlacementAlignment;
+  const PagedRangeAllocator::Allocation oversized = allocator.Allocate(oversized_size, kPlacementAlignment, new_page);
+  checker.Expect(oversized.IsValid() && new_page && oversized.offset == 0 && allocator.GetPageSize(oversized.page) == oversized_size,
+    "oversized request gets a dedicated page");
+  checker.Expect(allocator.GetStats().dedicated_page_count == 1, "dedicated page counted");
+  checker.Expect(allocator.Free(oversized) == oversized.page && !allocator.IsPageActive(oversized.page), "dedicated page released on free");
+
+  // Page 0 is empty and kept; emptying page 1 as well releases it, and a new page reuses its id
+  checker.Expect(allocator.Free(overflow) == overflow.page, "second empty page released");
+  stats = allocator.GetStats();
+  checker.Expect(stats.page_count == 1 && stats.allocated_bytes == 0 && stats.GetFragmentation() == 0.0, "one empty page kept");
+  const PagedRangeAllocator::Allocation oversized_again = allocator.Allocate(oversized_size, kPlacementAlignment, new_page);
+  checker.Expect(oversized_again.page == oversized.page || oversized_again.page == overflow.page, "released page id reused");
+  allocator.Free(oversized_again);
+
+  // release_empty_page hands back even the kept page (its backing memory could not be created)
+  const PagedRangeAllocator::Allocation last = allocator.Allocate(256, 256, new_page);
+  checker.Expect(allocator.Free(last, true) == last.page && allocator.GetStats().page_count == 0, "release_empty_page releases the page");
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+struct LiveAllocation {
+  PagedRangeAllocator::Allocation allocation;
+  uint64_t alignment;
+};
+
+// Textures from 64KB to 16MB (a few oversized at large page sizes), buffers from 256 bytes to 1MB
+uint64_t RandomSize(std::mt19937& rng) {
+  if (rng() % 2 == 0) {
+    return kPlacementAlignment << (rng() % 9);
+  }
+  return 256ull << (rng() % 13);
+}
+
+bool RunBenchmark(const Options& options) {
+  std::mt19937 rng(options.seed);
+  PagedRangeAllocator allocator;
+  allocator.Initialize(options.page_size);
+  ShadowPages shadow;
+
+  std::vector<LiveAllocation> live;
+  uint64_t live_bytes = 0;
+  bool growing = true;
+  uint64_t allocate_ns = 0;
+  uint64_t free_ns = 0;
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  uint32_t bad_placements = 0;
+  uint32_t peak_pages = 0;
+  uint64_t peak_reserved = 0;
+  double fragmentation_sum = 0.0;
+  double utilization_sum = 0.0;
+  uint32_t samples = 0;
+
+  // The live set grows and shrinks in waves (level loads and unloads) with churn on the way, which is what
+  // fragments pages
+  for (uint32_t i = 0; i < options.operations; ++i) {
+    if (growing && live_bytes >= options.budget) {
+      growing = false;
+    } else if (!growing && live_bytes <= options.budget / 4) {
+      growing = true;
+    }
+    const bool allocate = live.empty() || rng() % 100 < (growing ? 75u : 25u);
+    if (allocate) {
+      const uint64_t size = RandomSize(rng);
+      const uint64_t alignment = size >= kPlacementAlignment ? kPlacementAlignment : 256;
+      bool new_page = false;
+      const uint64_t start = NowNs();
+      const PagedRangeAllocator::Allocation allocation = allocator.Allocate(size, alignment, new_page);
+      allocate_ns += NowNs() - start;
+      ++allocations;
+      if (!allocation.IsValid() || allocation.size < size || !shadow.Insert(allocator, allocation, alignment)) {
+        ++bad_placements;
+        continue;
+      }
+      live.push_back({allocation, alignment});
+      live_bytes += allocation.size;
+    } else {
+      const size_t index = rng() % live.size();
+      shadow.Erase(live[index].allocation);
+      const uint64_t start = NowNs();
+      allocator.Free(live[index].allocation);
+      free_ns += NowNs() - start;
+      ++frees;
+      live_bytes -= live[index].allocation.size;
+      live[index] = live.back();
+      live.pop_back();
+    }
+
+    if (i % 256 == 0) {
+      const PagedRangeAllocator::Stats stats = allocator.GetStats();
+      peak_pages = (std::max)(peak_pages, stats.page_count);
+      peak_reserved = (std::max)(peak_reserved, stats.reserved_bytes);
+      if (stats.reserved_bytes > 0) {
+        fragmentation_sum += stats.GetFragmentation();
+        utilization_sum += static_cast<double>(stats.allocated_bytes) / static_cast<double>(stats.reserved_bytes);
+        ++samples;
+      }
+    }
+  }
+
+  const PagedRangeAllocator::Stats before_release = allocator.GetStats();
+  for (const LiveAllocation& entry : live) {
+    shadow.Erase(entry.allocation);
+    allocator.Free(entry.allocation);
+  }
+  const PagedRangeAllocator::Stats after_release = allocator.GetStats();
+  const bool released = after_release.page_count <= 1 && after_release.allocation_count == 0 && after_release.allocated_bytes == 0;
+
+  const double sample_count = static_cast<double>((std::max)(1u, samples));
+  std::cout << "Random workload: " << options.operations << " operations, page size " << (options.page_size >> 20) << " MB, budget "
+            << (options.budget >> 20) << " MB, seed " << options.seed << '\n';
+  std::cout << std::fixed << std::setprecision(1) << "  Allocate: " << static_cast<double>(allocate_ns) / static_cast<double>(allocations)
+            << " ns, free: " << static_cast<double>(free_ns) / static_cast<double>((std::max)(uint64_t{1}, frees)) << " ns" << '\n';
+  std::cout << "  Peak: " << peak_pages << " pages, " << (peak_reserved >> 20) << " MB reserved" << '\n';
+  std::cout << std::setprecision(2) << "  Average utilization: " << utilization_sum / sample_count
+            << ", average fragmentation: " << fragmentation_sum / sample_count << '\n';
+  std::cout << "  At the end: " << before_release.page_count << " pages (" << before_release.dedicated_page_count << " dedicated), "
+            << before_release.allocation_count << " allocations, " << before_release.free_block_count << " free blocks, fragmentation "
+            << before_release.GetFragmentation() << '\n';
+  std::cout << "  Bad placements: " << bad_placements << " (must be 0)" << '\n';
+  std::cout << "  After freeing everything: " << after_release.page_count << " pages (must be at most 1)" << '\n';
+  return bad_placements == 0 && released;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: placement_bench [--page-size <MB>] [--budget <MB>] [--operations <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Placement Bench ===" << '\n';
+  const bool checks_passed = RunChecks(options.page_size);
+  const bool benchmark_passed = RunBenchmark(options);
+  return checks_passed && benchmark_passed ? 0 : 1;
+}
@@ -0,0 +1,343 @@
+// range_allocator_bench: Fuzzes RangeAllocator (range_allocator.h) against an interval map and times it.
+//
+// The known-answer cases cover invalid requests, an exact fill of the range, alignment padding, neighbours
+// coalescing on free in every order and Reset. The fuzzer runs random sizes and power-of-two alignments over
+// several capacities and checks each allocation against a map of the live ranges: in bounds, aligned, the
+// requested size and overlapping nothing. A failed allocation must mean that no free gap can hold the
+// request at that alignment. Every few hundred operations the free blocks must be exactly the maximal gaps
+// of the map (full coalescing), with matching sizes, counts and largest free block. The benchmark times
+// allocate / free pairs at a steady live count, as descriptor churn does.
+//
+// Usage: range_allocator_bench [--operations <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "range_allocator.h"
+
+namespace {
+struct Options {
+  uint32_t operations = 1000000;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--operations" && has_value) {
+      options.operations = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[range_allocator_bench] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+bool RunChecks() {
+  Checker checker;
+  RangeAllocator allocator(1024);
+
+  // Invalid requests allocate nothing
+  checker.Expect(!allocator.Allocate(0).IsValid(), "zero size rejected");
+  checker.Expect(!allocator.Allocate(16, 0).IsValid() && !allocator.Allocate(16, 24).IsValid(), "non power of two alignment rejected");
+  checker.Expect(!allocator.Allocate(1025).IsValid(), "larger than capacity rejected");
+  checker.Expect(allocator.GetAllocationCount() == 0 && allocator.GetFreeBlockCount() == 1, "nothing allocated by rejected requests");
+
+  // The whole range can be handed out exactly, then nothing more
+  std::vector<RangeAllocator::Allocation> blocks;
+  for (uint64_t i = 0; i < 16; ++i) {
+    blocks.push_back(allocator.Allocate(64));
+  }
+  bool exact_fill = true;
+  for (uint64_t i = 0; i < blocks.size(); ++i) {
+    exact_fill = exact_fill && blocks[i].IsValid() && blocks[i].offset == i * 64 && blocks[i].size == 64;
+  }
+  checker.Expect(exact_fill, "range filled in order");
+  checker.Expect(!allocator.Allocate(1).IsValid() && allocator.GetFreeSize() == 0 && allocator.GetFreeBlockCount() == 0, "full range");
+
+  // Freeing every other block leaves separate holes; freeing the rest in between merges both neighbours
+  for (size_t i = 0; i < blocks.size(); i += 2) {
+    allocator.Free(blocks[i]);
+  }
+  checker.Expect(allocator.GetFreeBlockCount() == 8 && allocator.GetLargestFreeBlock() == 64, "holes stay separate");
+  checker.Expect(!allocator.Allocate(65).IsValid(), "no hole holds more than a block");
+  for (size_t i = 1; i < blocks.size(); i += 2) {
+    allocator.Free(blocks[i]);
+  }
+  checker.Expect(allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFreeBlock() == 1024 && allocator.GetAllocatedSize() == 0,
+    "freed blocks coalesce into one");
+
+  // Alignment pads the front; the padding is free again and merges back on free
+  const RangeAllocator::Allocation small = allocator.Allocate(3);
+  const RangeAllocator::Allocation aligned = allocator.Allocate(100, 256);
+  checker.Expect(small.offset == 0 && aligned.IsValid() && aligned.offset == 256 && aligned.size == 100, "aligned offset");
+  checker.Expect(allocator.GetFreeBlockCount() == 2 && allocator.GetFreeSize() == 1024 - 103, "padding stays free");
+  const RangeAllocator::Allocation fits_padding = allocator.Allocate(200);
+  const bool in_padding = fits_padding.offset >= 3 && fits_padding.offset + fits_padding.size <= 256;
+  checker.Expect(fits_padding.IsValid() && (in_padding || fits_padding.offset >= 356), "padding reused without overlap");
+  allocator.Free(aligned);
+  allocator.Free(small);
+  allocator.Free(fits_padding);
+  checker.Expect(allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFreeBlock() == 1024, "padding merges back");
+
+  // The last aligned slot of a nearly full range is found (no size class guarantees it)
+  const RangeAllocator::Allocation head = allocator.Allocate(512 + 1);
+  const RangeAllocator::Allocation last_slot = allocator.Allocate(256, 256);
+  checker.Expect(head.IsValid() && last_slot.IsValid() && last_slot.offset == 768, "last aligned slot found");
+  allocator.Free(head);
+  allocator.Free(last_slot);
+
+  // Reset releases everything
+  allocator.Allocate(10);
+  allocator.Allocate(20);
+  allocator.Reset();
+  checker.Expect(allocator.GetAllocationCount() == 0 && allocator.GetFreeBlockCount() == 1 && allocator.Allocate(1024).offset == 0,
+    "reset releases everything");
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Live ranges (offset -> allocation) as the reference for where the free gaps are
+class IntervalMap {
+ public:
+  explicit IntervalMap(uint64_t capacity) : capacity_(capacity) {
+  }
+
+  bool Insert(const RangeAllocator::Allocation& allocation) {
+    if (allocation.offset + allocation.size > capacity_) {
+      return false;
+    }
+    const auto next = ranges_.lower_bound(allocation.offset);
+    if (next != ranges_.end() && next->first < allocation.offset + allocation.size) {
+      return false;
+    }
+    if (next != ranges_.begin() && std::prev(next)->first + std::prev(next)->second.size > allocation.offset) {
+      return false;
+    }
+    ranges_.emplace(allocation.offset, allocation);
+    return true;
+  }
+
+  void Erase(uint64_t offset) {
+    ranges_.erase(offset);
+  }
+
+  // Calls visit(offset, size) for each maximal free gap
+  template <typename Visit>
+  void ForEachGap(Visit visit) const {
+    uint64_t cursor = 0;
+    for (const auto& [offset, allocation] : ranges_) {
+      if (offset > cursor) {
+        visit(cursor, offset - cursor);
+      }
+      cursor = offset + allocation.size;
+    }
+    if (cursor < capacity_) {
+      visit(cursor, capacity_ - cursor);
+    }
+  }
+
+  bool HasFit(uint64_t size, uint64_t alignment) const {
+    bool fits = false;
+    ForEachGap([&](uint64_t offset, uint64_t gap) { fits = fits || AlignUp(offset, alignment) + size <= offset + gap; });
+    return fits;
+  }
+
+  size_t GetCount() const {
+    return ranges_.size();
+  }
+
+  const std::map<uint64_t, RangeAllocator::Allocation>& GetRanges() const {
+    return ranges_;
+  }
+
+ private:
+  uint64_t capacity_;
+  std::map<uint64_t, RangeAllocator::Allocation> ranges_;
+};
+
+struct FuzzTotals {
+  uint64_t allocations = 0;
+  uint64_t failed_allocations = 0;
+  uint64_t frees = 0;
+  uint64_t consistency_checks = 0;
+  uint32_t violations = 0;
+};
+
+// Descriptor-like sizes most of the time, occasionally large blocks and large alignments
+void FuzzCapacity(uint64_t capacity, uint32_t operations, std::mt19937& rng, FuzzTotals& totals) {
+  RangeAllocator allocator(capacity);
+  IntervalMap reference(capacity);
+  std::vector<uint64_t> live;
+
+  auto check_consistency = [&]() {
+    ++totals.consistency_checks;
+    uint64_t gap_count = 0;
+    uint64_t largest_gap = 0;
+    reference.ForEachGap([&](uint64_t, uint64_t gap) {
+      ++gap_count;
+      largest_gap = (std::max)(largest_gap, gap);
+    });
+    uint64_t allocated = 0;
+    for (const auto& [offset, allocation] : reference.GetRanges()) {
+      allocated += allocation.size;
+    }
+    if (allocator.GetFreeBlockCount() != gap_count || allocator.GetLargestFreeBlock() != largest_gap ||
+        allocator.GetAllocatedSize() != allocated || allocator.GetAllocationCount() != reference.GetCount()) {
+      ++totals.violations;
+    }
+  };
+
+  for (uint32_t i = 0; i < operations; ++i) {
+    const bool allocate = live.empty() || rng() % 100 < 52;
+    if (allocate) {
+      const uint32_t kind = rng() % 100;
+      const uint64_t max_size = kind < 80 ? 8 : (kind < 95 ? capacity / 16 : capacity / 2);
+      const uint64_t size = 1 + rng() % (std::max)(uint64_t{1}, max_size);
+      const uint64_t alignment = rng() % 4 == 0 ? 1ull << (rng() % 12) : 1;
+      const RangeAllocator::Allocation allocation = allocator.Allocate(size, alignment);
+      if (!allocation.IsValid()) {
+        ++totals.failed_allocations;
+        if (reference.HasFit(size, alignment)) {
+          ++totals.violations;  // Out of space while a gap could hold it
+        }
+        continue;
+      }
+      ++totals.allocations;
+      if (allocation.size != size || allocation.offset % alignment != 0 || !reference.Insert(allocation)) {
+        ++totals.violations;
+        continue;
+      }
+      live.push_back(allocation.offset);
+    } else {
+      const size_t index = rng() % live.size();
+      const auto it = reference.GetRanges().find(live[index]);
+      allocator.Free(it->second);
+      reference.Erase(live[index]);
+      ++totals.frees;
+      live[index] = live.back();
+      live.pop_back();
+    }
+
+    if (i % 256 == 0) {
+      check_consistency();
+    }
+  }
+
+  // Freeing everything (in random order) must coalesce the range back into one block
+  std::shuffle(live.begin(), live.end(), rng);
+  for (const uint64_t offset : live) {
+    allocator.Free(reference.GetRanges().at(offset));
+    reference.Erase(offset);
+    ++totals.frees;
+  }
+  check_consistency();
+  if (allocator.GetFreeBlockCount() != 1 || allocator.GetLargestFreeBlock() != capacity || !allocator.Allocate(capacity).IsValid()) {
+    ++totals.violations;
+  }
+}
+
+bool RunFuzzer(const Options& options) {
+  std::mt19937 rng(options.seed);
+  FuzzTotals totals;
+  const uint64_t capacities[] = {1, 7, 64, 1000, 4096, 65536, 1000000, 1ull << 40};
+  const uint32_t operations_per_capacity = (std::max)(1u, options.operations / static_cast<uint32_t>(std::size(capacities)));
+  for (const uint64_t capacity : capacities) {
+    FuzzCapacity(capacity, operations_per_capacity, rng, totals);
+  }
+
+  std::cout << "Fuzzer: " << std::size(capacities) << " capacities x " << operations_per_capacity << " operations, seed " << options.seed
+            << '\n';
+  std::cout << "  Allocations: " << totals.allocations << " (" << totals.failed_allocations << " out of space), frees: " << totals.frees
+            << ", consistency checks: " << totals.consistency_checks << '\n';
+  std::cout << "  Violations: " << totals.violations << " (must be 0)" << '\n';
+  return totals.violations == 0;
+}
+
+// Allocate / free pairs with 384 tables (about three quarters of the slots) live in a 4096 descriptor heap
+void RunBenchmark(const Options& options) {
+  std::mt19937 rng(options.seed);
+  RangeAllocator allocator(4096);
+  std::vector<RangeAllocator::Allocation> live;
+  for (uint32_t i = 0; i < 384; ++i) {
+    live.push_back(allocator.Allocate(1 + rng() % 8));
+  }
+
+  // Requests are drawn up front so the loop times the allocator only
+  std::vector<uint64_t> sizes(options.operations);
+  std::vector<uint32_t> victims(options.operations);
+  for (uint32_t i = 0; i < options.operations; ++i) {
+    sizes[i] = rng() % 10 == 0 ? 16 + rng() % 48 : 1 + rng() % 8;
+    victims[i] = rng();
+  }
+
+  uint64_t failed = 0;
+  const uint64_t start = NowNs();
+  for (uint32_t i = 0; i < options.operations; ++i) {
+    const size_t index = victims[i] % live.size();
+    allocator.Free(live[index]);
+    live[index] = allocator.Allocate(sizes[i]);
+    if (!live[index].IsValid()) {
+      ++failed;
+      live[index] = allocator.Allocate(1);
+    }
+  }
+  const double elapsed_ns = static_cast<double>(NowNs() - start);
+
+  std::cout << "Benchmark: " << options.operations << " allocate / free pairs, " << live.size() << " live in 4096" << '\n';
+  std::cout << std::fixed << std::setprecision(1) << "  " << elapsed_ns / options.operations << " ns per pair, " << failed
+            << " out of space, " << allocator.GetFreeBlockCount() << " free blocks at the end" << '\n';
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: range_allocator_bench [--operations <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Range Allocator Bench ===" << '\n';
+  const bool checks_passed = RunChecks();
+  const bool fuzzer_passed = RunFuzzer(options);
+  RunBenchmark(options);
+  return checks_passed && fuzzer_passed ? 0 : 1;
+}
@@ -0,0 +1,519 @@
+// render_graph_check: Checks RenderGraph (render_graph.h) compilation against its abstract resource model, since
+// the D3D12 executor rejects graphs that keep a transient alive and so never runs the transient placement.
+//
+// The known-answer cases cover pass culling (unobserved transients, side effects, read-only passes, writer
+// chains), derived transitions and final transitions for imported resources, transient placement (reuse of
+// the memory of a dead transient with an aliasing barrier, separate memory for overlapping lifetimes,
+// alignment, culled transients left unplaced), execution order and the rejected declarations. The randomized
+// part compiles random graphs and re-derives from the declarations what the compiled schedule must satisfy:
+// every culled pass is unobserved and every live one observed, no two live transients overlap in both
+// lifetime and memory, replaying the barriers puts every resource in the state each pass declares, and every
+// reuse of transient memory has its aliasing barrier.
+//
+// Usage: render_graph_check [--graphs <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "render_graph.h"
+
+namespace {
+using Access = RenderGraph::Access;
+using Barrier = RenderGraph::Barrier;
+using Resource = RenderGraph::Resource;
+
+struct Options {
+  uint32_t graphs = 3000;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--graphs" && has_value) {
+      options.graphs = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[render_graph_check] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+bool IsTransition(const Barrier& barrier, Resource resource, Access before, Access after) {
+  return barrier.type == Barrier::Type::Transition && barrier.resource == resource && barrier.before == before &&
+         barrier.after == after;
+}
+
+bool RunChecks() {
+  Checker checker;
+  RenderGraph graph;
+  constexpr RenderGraph::TransientDesc kTarget = {1 << 20, 1 << 16};
+
+  // Culling: a transient nobody reads and a read-only pass are dropped, side effects and writer chains stay
+  {
+    graph.Reset();
+    const Resource back_buffer = graph.Import("BackBuffer", Access::Present);
+    const Resource unused = graph.CreateTransient("Unused", kTarget);
+    const Resource chained = graph.CreateTransient("Chained", kTarget);
+    graph.AddPass("WritesUnused", [&](RenderGraph::PassBuilder& b) { b.Write(unused, Access::RenderTarget); }, nullptr);
+    graph.AddPass("WritesChained", [&](RenderGraph::PassBuilder& b) { b.Write(chained, Access::RenderTarget); }, nullptr);
+    graph.AddPass("ReadsOnly", [&](RenderGraph::PassBuilder& b) { b.Read(back_buffer, Access::ShaderRead); }, nullptr);
+    graph.AddPass("SideEffect", [](RenderGraph::PassBuilder& b) { b.SetSideEffect(); }, nullptr);
+    graph.AddPass("Composite", [&](RenderGraph::PassBuilder& b) {
+      b.Read(chained, Access::ShaderRead);
+      b.Write(back_buffer, Access::RenderTarget);
+    }, nullptr);
+    checker.Expect(graph.Compile(), "culling graph compiles");
+    checker.Expect(graph.IsPassCulled(0), "pass writing an unread transient culled");
+    checker.Expect(!graph.IsPassCulled(1), "writer of a read transient kept");
+    checker.Expect(graph.IsPassCulled(2), "pass that only reads culled");
+    checker.Expect(!graph.IsPassCulled(3), "side effect pass kept");
+    checker.Expect(!graph.IsPassCulled(4), "pass writing an imported resource kept");
+    checker.Expect(graph.GetSchedule() == std::vector<uint32_t>({1, 3, 4}), "schedule keeps declaration order");
+    checker.Expect(graph.GetStats().culled_pass_count == 2, "culled passes counted");
+    checker.Expect(graph.GetTransientOffset(unused) == RenderGraph::kUnplaced, "culled transient unplaced");
+  }
+
+  // Transitions: first use of an imported resource from None, changes only, final access after the last pass
+  {
+    graph.Reset();
+    const Resource back_buffer = graph.Import("BackBuffer", Access::Present);
+    const Resource depth = graph.Import("Depth");
+    graph.AddPass("World", [&](RenderGraph::PassBuilder& b) {
+      b.Write(back_buffer, Access::RenderTarget);
+      b.Write(depth, Access::DepthWrite);
+    }, nullptr);
+    graph.AddPass("Debug3D", [&](RenderGraph::PassBuilder& b) {
+      b.Write(back_buffer, Access::RenderTarget);
+      b.Read(depth, Access::DepthRead);
+    }, nullptr);
+    graph.AddPass("UI", [&](RenderGraph::PassBuilder& b) { b.Write(back_buffer, Access::RenderTarget); }, nullptr);
+    checker.Expect(graph.Compile(), "transition graph compiles");
+
+    const std::span<const Barrier> world = graph.GetPassBarriers(0);
+    checker.Expect(world.size() == 2 && IsTransition(world[0], back_buffer, Access::None, Access::RenderTarget) &&
+                     IsTransition(world[1], depth, Access::None, Access::DepthWrite),
+      "first uses transition from None");
+    const std::span<const Barrier> debug = graph.GetPassBarriers(1);
+    checker.Expect(debug.size() == 1 && IsTransition(debug[0], depth, Access::DepthWrite, Access::DepthRead), "depth write to read");
+    checker.Expect(graph.GetPassBarriers(2).empty(), "unchanged access needs no barrier");
+    const std::span<const Barrier> final_barriers = graph.GetFinalBarriers();
+    checker.Expect(final_barriers.size() == 1 && IsTransition(final_barriers[0], back_buffer, Access::RenderTarget, Access::Present),
+      "imported resource ends in its final access");
+    checker.Expect(graph.GetStats().barrier_count == 4, "transitions counted");
+
+    // Barriers run right before their pass, final barriers after the last one
+    std::vector<std::string> events;
+    graph.Reset();
+    const Resource target = graph.Import("Target", Access::ShaderRead);
+    graph.AddPass("A", [&](RenderGraph::PassBuilder& b) { b.Write(target, Access::RenderTarget); }, [&]() { events.push_back("A"); });
+    graph.AddPass("B", [&](RenderGraph::PassBuilder& b) { b.Write(target, Access::CopyDest); }, [&]() { events.push_back("B"); });
+    graph.Compile();
+    graph.Execute([&](std::span<const Barrier> barriers) {
+      for (const Barrier& barrier : barriers) {
+        events.push_back(RenderGraph::GetAccessName(barrier.after));
+      }
+    });
+    checker.Expect(events == std::vector<std::string>({"RenderTarget", "A", "CopyDest", "B", "ShaderRead"}), "execution order");
+  }
+
+  // Placement: a transient whose lifetime starts after another ends reuses its memory behind an aliasing barrier
+  {
+    graph.Reset();
+    const Resource back_buffer = graph.Import("BackBuffer");
+    const Resource first = graph.CreateTransient("First", kTarget);
+    const Resource second = graph.CreateTransient("Second", kTarget);
+    graph.AddPass("WriteFirst", [&](RenderGraph::PassBuilder& b) { b.Write(first, Access::RenderTarget); }, nullptr);
+    graph.AddPass("ReadFirst", [&](RenderGraph::PassBuilder& b) {
+      b.Read(first, Access::ShaderRead);
+      b.Write(back_buffer, Access::RenderTarget);
+    }, nullptr);
+    graph.AddPass("WriteSecond", [&](RenderGraph::PassBuilder& b) { b.Write(second, Access::UnorderedAccess); }, nullptr);
+    graph.AddPass("ReadSecond", [&](RenderGraph::PassBuilder& b) {
+      b.Read(second, Access::ShaderRead);
+      b.Write(back_buffer, Access::RenderTarget);
+    }, nullptr);
+    checker.Expect(graph.Compile(), "aliasing graph compiles");
+    checker.Expect(graph.GetTransientOffset(first) == 0 && graph.GetTransientOffset(second) == 0, "disjoint lifetimes share memory");
+    checker.Expect(graph.GetStats().transient_heap_size == kTarget.size && graph.GetStats().transient_bytes == 2 * kTarget.size,
+      "heap holds one target");
+    const std::span<const Barrier> write_first = graph.GetPassBarriers(0);
+    checker.Expect(write_first.empty() && graph.GetFirstAccess(first) == Access::RenderTarget, "first transient created in its first access");
+    const std::span<const Barrier> write_second = graph.GetPassBarriers(2);
+    checker.Expect(write_second.size() == 1 && write_second[0].type == Barrier::Type::Aliasing && write_second[0].resource == second &&
+                     write_second[0].aliased == first && write_second[0].after == Access::UnorderedAccess,
+      "reuse gets an aliasing barrier");
+    checker.Expect(graph.GetStats().aliasing_barrier_count == 1, "aliasing barriers counted");
+  }
+
+  // Overlapping lifetimes get separate, aligned memory
+  {
+    graph.Reset();
+    const Resource back_buffer = graph.Import("BackBuffer");
+    const Resource small = graph.CreateTransient("Small", {1000, 256});
+    const Resource large = graph.CreateTransient("Large", kTarget);
+    graph.AddPass("WriteBoth", [&](RenderGraph::PassBuilder& b) {
+      b.Write(small, Access::UnorderedAccess);
+      b.Write(large, Access::RenderTarget);
+    }, nullptr);
+    graph.AddPass("ReadBoth", [&](RenderGraph::PassBuilder& b) {
+      b.Read(small, Access::ShaderRead);
+      b.Read(large, Access::ShaderRead);
+      b.Write(back_buffer, Access::RenderTarget);
+    }, nullptr);
+    checker.Expect(graph.Compile(), "overlap graph compiles");
+    checker.Expect(graph.GetTransientOffset(large) == 0 && graph.GetTransientOffset(small) == kTarget.size, "largest placed first");
+    checker.Expect(graph.GetStats().transient_heap_size == kTarget.size + 1000 && graph.GetStats().aliasing_barrier_count == 0,
+      "overlapping lifetimes do not alias");
+
+    graph.Reset();
+    const Resource output = graph.Import("Output");
+    const Resource odd = graph.CreateTransient("Odd", {100, 1});
+    const Resource aligned = graph.CreateTransient("Aligned", {50, 4096});
+    graph.AddPass("Write", [&](RenderGraph::PassBuilder& b) {
+      b.Write(odd, Access::CopyDest);
+      b.Write(aligned, Access::CopyDest);
+    }, nullptr);
+    graph.AddPass("Read", [&](RenderGraph::PassBuilder& b) {
+      b.Read(odd, Access::CopySource);
+      b.Read(aligned, Access::CopySource);
+      b.Write(output, Access::CopyDest);
+    }, nullptr);
+    checker.Expect(graph.Compile() && graph.GetTransientOffset(odd) == 0 && graph.GetTransientOffset(aligned) == 4096,
+      "placement alignment honoured");
+  }
+
+  // Rejected declarations
+  {
+    graph.Reset();
+    const Resource output = graph.Import("Output");
+    const Resource transient = graph.CreateTransient("Transient", kTarget);
+    graph.AddPass("ReadsFirst", [&](RenderGraph::PassBuilder& b) {
+      b.Read(transient, Access::ShaderRead);
+      b.Write(output, Access::RenderTarget);
+    }, nullptr);
+    checker.Expect(!graph.Compile(), "transient read before any write rejected");
+
+    graph.Reset();
+    const Resource target = graph.Import("Target");
+    graph.AddPass("TwoStates", [&](RenderGraph::PassBuilder& b) {
+      b.Read(target, Access::ShaderRead);
+      b.Write(target, Access::RenderTarget);
+    }, nullptr);
+    checker.Expect(!graph.Compile(), "two accesses of one resource in a pass rejected");
+
+    graph.Reset();
+    checker.Expect(graph.Compile() && graph.GetSchedule().empty() && graph.GetPassCount() == 0, "empty graph compiles");
+  }
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+struct DeclaredAccess {
+  Resource resource;
+  Access access;
+  bool write;
+};
+
+struct RandomGraph {
+  std::vector<bool> transient;
+  std::vector<RenderGraph::TransientDesc> descs;
+  std::vector<Access> final_access;
+  std::vector<std::vector<DeclaredAccess>> passes;
+  std::vector<bool> side_effect;
+};
+
+constexpr Access kAccesses[] = {
+  Access::RenderTarget, Access::DepthWrite, Access::DepthRead, Access::ShaderRead, Access::UnorderedAccess, Access::CopySource, Access::CopyDest};
+
+// Valid declarations: transients are only read once an earlier pass wrote them, one access per resource per pass
+RandomGraph MakeRandomGraph(std::mt19937& rng) {
+  RandomGraph graph;
+  const uint32_t imported_count = 1 + rng() % 3;
+  const uint32_t transient_count = 1 + rng() % 12;
+  for (uint32_t i = 0; i < imported_count + transient_count; ++i) {
+    const bool is_transient = i >= imported_count;
+    graph.transient.push_back(is_transient);
+    graph.descs.push_back({256ull << (rng() % 12), 1ull << (rng() % 17)});
+    graph.final_access.push_back(!is_transient && rng() % 2 == 0 ? Access::Present : Access::None);
+  }
+
+  std::vector<bool> written(graph.transient.size(), false);
+  const uint32_t pass_count = 2 + rng() % 19;
+  for (uint32_t p = 0; p < pass_count; ++p) {
+    std::vector<DeclaredAccess> accesses;
+    std::vector<bool> used(graph.transient.size(), false);
+    const uint32_t access_count = 1 + rng() % 4;
+    for (uint32_t a = 0; a < access_count; ++a) {
+      const Resource resource = static_cast<Resource>(rng() % graph.transient.size());
+      if (used[resource]) {
+        continue;
+      }
+      const bool write = (graph.transient[resource] && !written[resource]) || rng() % 2 == 0;
+      used[resource] = true;
+      accesses.push_back({resource, kAccesses[rng() % std::size(kAccesses)], write});
+    }
+    for (const DeclaredAccess& access : accesses) {
+      written[access.resource] = written[access.resource] || access.write;
+    }
+    graph.passes.push_back(std::move(accesses));
+    graph.side_effect.push_back(rng() % 16 == 0);
+  }
+  return graph;
+}
+
+// Everything the compiled graph must satisfy, derived from the declarations alone; returns the number of violations
+uint32_t VerifyGraph(const RandomGraph& declared, const RenderGraph& graph, const std::vector<Resource>& handles) {
+  uint32_t violations = 0;
+  const size_t resource_count = declared.transient.size();
+  const uint32_t pass_count = static_cast<uint32_t>(declared.passes.size());
+
+  // Culling: a pass is live exactly when it has a side effect, writes an imported resource, or writes something a
+  // later live pass reads
+  std::vector<bool> live(pass_count, false);
+  for (uint32_t p = pass_count; p-- > 0;) {
+    bool observed = declared.side_effect[p];
+    for (const DeclaredAccess& access : declared.passes[p]) {
+      if (!access.write) {
+        continue;
+      }
+      if (!declared.transient[access.resource]) {
+        observed = true;
+      }
+      for (uint32_t later = p + 1; later < pass_count && !observed; ++later) {
+        for (const DeclaredAccess& other : declared.passes[later]) {
+          if (live[later] && !other.write && other.resource == access.resource) {
+            observed = true;
+          }
+        }
+      }
+    }
+    live[p] = observed;
+    if (graph.IsPassCulled(p) == observed) {
+      ++violations;
+    }
+  }
+
+  std::vector<uint32_t> schedule;
+  for (uint32_t p = 0; p < pass_count; ++p) {
+    if (live[p]) {
+      schedule.push_back(p);
+    }
+  }
+  if (schedule != graph.GetSchedule()) {
+    return violations + 1;
+  }
+
+  // Lifetimes over schedule positions
+  std::vector<uint32_t> first_use(resource_count, ~0u);
+  std::vector<uint32_t> last_use(resource_count, 0);
+  for (uint32_t s = 0; s < schedule.size(); ++s) {
+    for (const DeclaredAccess& access : declared.passes[schedule[s]]) {
+      first_use[access.resource] = (std::min)(first_use[access.resource], s);
+      last_use[access.resource] = s;
+    }
+  }
+
+  // Placement: aligned, unplaced only when unused, and no overlap in both lifetime and memory
+  auto overlaps_memory = [&](size_t a, size_t b) {
+    const uint64_t offset_a = graph.GetTransientOffset(handles[a]);
+    const uint64_t offset_b = graph.GetTransientOffset(handles[b]);
+    return offset_a < offset_b + declared.descs[b].size && offset_b < offset_a + declared.descs[a].size;
+  };
+  for (size_t r = 0; r < resource_count; ++r) {
+    if (!declared.transient[r]) {
+      continue;
+    }
+    const uint64_t offset = graph.GetTransientOffset(handles[r]);
+    if ((offset == RenderGraph::kUnplaced) != (first_use[r] == ~0u)) {
+      ++violations;
+      continue;
+    }
+    if (offset == RenderGraph::kUnplaced) {
+      continue;
+    }
+    if (offset % declared.descs[r].alignment != 0 || offset + declared.descs[r].size > graph.GetStats().transient_heap_size) {
+      ++violations;
+    }
+    for (size_t other = r + 1; other < resource_count; ++other) {
+      if (!declared.transient[other] || first_use[other] == ~0u) {
+        continue;
+      }
+      const bool overlaps_lifetime = first_use[r] <= last_use[other] && first_use[other] <= last_use[r];
+      if (overlaps_lifetime && overlaps_memory(r, other)) {
+        ++violations;
+      }
+    }
+  }
+
+  // Barriers: replaying them must put every resource in the declared state of each pass; a transient starts in its
+  // first access and takes over memory only behind an aliasing barrier for each earlier transient in that range
+  std::vector<Access> state(resource_count, Access::None);
+  for (uint32_t s = 0; s < schedule.size(); ++s) {
+    uint32_t aliasing_barriers = 0;
+    for (const Barrier& barrier : graph.GetPassBarriers(schedule[s])) {
+      const size_t r = barrier.resource;
+      if (barrier.type == Barrier::Type::Aliasing) {
+        const size_t before = barrier.aliased;
+        if (!declared.transient[r] || first_use[r] != s || !declared.transient[before] || last_use[before] >= s ||
+            !overlaps_memory(r, before)) {
+          ++violations;
+        }
+        state[r] = barrier.after;
+        ++aliasing_barriers;
+        continue;
+      }
+      if (barrier.before != state[r]) {
+        ++violations;
+      }
+      state[r] = barrier.after;
+    }
+
+    uint32_t expected_aliasing_barriers = 0;
+    for (const DeclaredAccess& access : declared.passes[schedule[s]]) {
+      const size_t r = access.resource;
+      if (declared.transient[r] && first_use[r] == s) {
+        for (size_t before = 0; before < resource_count; ++before) {
+          if (declared.transient[before] && first_use[before] != ~0u && last_use[before] < s && overlaps_memory(r, before)) {
+            ++expected_aliasing_barriers;
+          }
+        }
+        if (graph.GetFirstAccess(handles[r]) != access.access) {
+          ++violations;
+        }
+        state[r] = access.access;
+      }
+      if (state[r] != access.access) {
+        ++violations;
+      }
+    }
+    if (aliasing_barriers != expected_aliasing_barriers) {
+      ++violations;
+    }
+  }
+
+  for (const Barrier& barrier : graph.GetFinalBarriers()) {
+    if (barrier.before != state[barrier.resource]) {
+      ++violations;
+    }
+    state[barrier.resource] = barrier.after;
+  }
+  for (size_t r = 0; r < resource_count; ++r) {
+    if (!declared.transient[r] && declared.final_access[r] != Access::None && state[r] != declared.final_access[r]) {
+      ++violations;
+    }
+  }
+  return violations;
+}
+
+bool RunRandomGraphs(const Options& options) {
+  std::mt19937 rng(options.seed);
+  RenderGraph graph;
+  uint64_t compile_ns = 0;
+  uint32_t failed_compiles = 0;
+  uint32_t violating_graphs = 0;
+  uint64_t passes = 0;
+  uint64_t culled = 0;
+  uint64_t transient_bytes = 0;
+  uint64_t heap_bytes = 0;
+  uint64_t aliasing_barriers = 0;
+
+  for (uint32_t g = 0; g < options.graphs; ++g) {
+    const RandomGraph declared = MakeRandomGraph(rng);
+
+    graph.Reset();
+    std::vector<Resource> handles;
+    for (size_t r = 0; r < declared.transient.size(); ++r) {
+      const std::string name = "R" + std::to_string(r);
+      handles.push_back(declared.transient[r] ? graph.CreateTransient(name, declared.descs[r]) : graph.Import(name, declared.final_access[r]));
+    }
+    for (size_t p = 0; p < declared.passes.size(); ++p) {
+      graph.AddPass("P" + std::to_string(p), [&](RenderGraph::PassBuilder& builder) {
+        for (const DeclaredAccess& access : declared.passes[p]) {
+          if (access.write) {
+            builder.Write(handles[access.resource], access.access);
+          } else {
+            builder.Read(handles[access.resource], access.access);
+          }
+        }
+        if (declared.side_effect[p]) {
+          builder.SetSideEffect();
+        }
+      }, nullptr);
+    }
+
+    const uint64_t start = NowNs();
+    const bool compiled = graph.Compile();
+    compile_ns += NowNs() - start;
+    if (!compiled) {
+      ++failed_compiles;
+      continue;
+    }
+    if (VerifyGraph(declared, graph, handles) != 0) {
+      ++violating_graphs;
+    }
+
+    const RenderGraph::Stats& stats = graph.GetStats();
+    passes += stats.pass_count;
+    culled += stats.culled_pass_count;
+    transient_bytes += stats.transient_bytes;
+    heap_bytes += stats.transient_heap_size;
+    aliasing_barriers += stats.aliasing_barrier_count;
+  }
+
+  std::cout << "Random graphs: " << options.graphs << ", seed " << options.seed << '\n';
+  std::cout << std::fixed << std::setprecision(2) << "  Compile: " << static_cast<double>(compile_ns) / 1000.0 / options.graphs
+            << " us per graph, " << static_cast<double>(passes) / options.graphs << " passes ("
+            << static_cast<double>(culled) / options.graphs << " culled)" << '\n';
+  std::cout << "  Transient heap: " << static_cast<double>(heap_bytes) / static_cast<double>((std::max)(uint64_t{1}, transient_bytes))
+            << " of the unaliased size, " << static_cast<double>(aliasing_barriers) / options.graphs << " aliasing barriers per graph"
+            << '\n';
+  std::cout << "  Failed compiles: " << failed_compiles << ", graphs with violations: " << violating_graphs << " (must be 0)" << '\n';
+  return failed_compiles == 0 && violating_graphs == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: render_graph_check [--graphs <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Render Graph Check ===" << '\n';
+  const bool checks_passed = RunChecks();
+  const bool random_passed = RunRandomGraphs(options);
+  return checks_passed && random_passed ? 0 : 1;
+}
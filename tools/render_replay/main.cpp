@@ -0,0 +1,193 @@
+// render_replay: Feeds a render packet capture (RenderSystem::BeginCapture) through the
+// SceneRenderer filter / sort-key / sort / batch stages with a null backend and reports
+// per-stage timings and draw / PSO-switch counts.
+//
+// Usage: render_replay <capture file> [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "render_capture.h"
+#include "render_sort_key.h"
+
+namespace {
+// Must match RenderLayer / RenderTag in app/Graphic/RenderPass/render_layer.h
+constexpr uint8_t kLayerUI = 1 << 3;
+constexpr uint8_t kTagAll = 0xFF;
+constexpr uint8_t kTagNone = 0;
+
+struct StageTimes {
+  uint64_t filter_ns = 0;
+  uint64_t sort_key_ns = 0;
+  uint64_t sort_ns = 0;
+  uint64_t batch_ns = 0;
+};
+
+struct BatchStats {
+  uint64_t packets = 0;
+  uint64_t draws = 0;
+  uint64_t pso_switches = 0;
+  uint64_t material_changes = 0;
+  uint64_t mesh_changes = 0;
+  uint64_t triangles = 0;
+};
+
+struct SortablePacket {
+  const RenderCapturePacket* packet;
+  uint64_t sort_key;
+};
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Same semantics as RenderFilter::Match
+bool MatchFilter(const RenderCaptureView& view, const RenderCapturePacket& packet) {
+  if ((packet.layer & view.layer_mask) == 0) {
+    return false;
+  }
+  if (view.tag_mask != kTagAll && (packet.tag & view.tag_mask) == 0) {
+    return false;
+  }
+  if (view.tag_exclude_mask != kTagNone && (packet.tag & view.tag_exclude_mask) != 0) {
+    return false;
+  }
+  return true;
+}
+
+void ReplayView(const RenderCaptureView& view, std::vector<SortablePacket>& scratch, StageTimes& times, BatchStats& stats) {
+  // 1) Filter
+  uint64_t t0 = NowNs();
+  scratch.clear();
+  for (const RenderCapturePacket& packet : view.packets) {
+    if (MatchFilter(view, packet)) {
+      scratch.push_back({&packet, 0});
+    }
+  }
+
+  // 2) Sort keys
+  uint64_t t1 = NowNs();
+  for (SortablePacket& entry : scratch) {
+    const RenderCapturePacket& packet = *entry.packet;
+    entry.sort_key = ComposeRenderSortKey(packet.layer, packet.template_id, packet.texture_index, packet.lod_level, packet.material_id);
+  }
+
+  // 3) Sort
+  uint64_t t2 = NowNs();
+  std::sort(scratch.begin(), scratch.end(), [](const SortablePacket& a, const SortablePacket& b) {
+    return RenderDrawOrderLess(
+      a.packet->layer, a.packet->sort_order, a.sort_key, b.packet->layer, b.packet->sort_order, b.sort_key, kLayerUI);
+  });
+
+  // 4) Batch (null backend: only state-change tracking)
+  uint64_t t3 = NowNs();
+  uint32_t current_template = 0;
+  uint32_t current_material = 0;
+  uint32_t current_mesh = 0;
+  for (const SortablePacket& entry : scratch) {
+    const RenderCapturePacket& packet = *entry.packet;
+    if (packet.template_id != current_template) {
+      current_template = packet.template_id;
+      ++stats.pso_switches;
+    }
+    if (packet.material_id != current_material) {
+      current_material = packet.material_id;
+      ++stats.material_changes;
+    }
+    if (packet.mesh_id != current_mesh) {
+      current_mesh = packet.mesh_id;
+      ++stats.mesh_changes;
+    }
+    ++stats.draws;
+    stats.triangles += packet.index_count / 3;
+  }
+  uint64_t t4 = NowNs();
+
+  stats.packets += view.packets.size();
+  times.filter_ns += t1 - t0;
+  times.sort_key_ns += t2 - t1;
+  times.sort_ns += t3 - t2;
+  times.batch_ns += t4 - t3;
+}
+
+void PrintStage(const char* name, uint64_t total_ns, uint64_t frame_samples) {
+  const double per_frame_us = frame_samples > 0 ? static_cast<double>(total_ns) / 1000.0 / static_cast<double>(frame_samples) : 0.0;
+  std::cout << "  " << std::left << std::setw(10) << name << std::right << std::setw(12) << std::fixed << std::setprecision(3) << per_frame_us
+            << " us/frame" << '\n';
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: render_replay <capture file> [iterations]" << '\n';
+    return 1;
+  }
+
+  const std::string file_path = argv[1];
+  const int iterations = argc >= 3 ? (std::max)(1, std::atoi(argv[2])) : 10;
+
+  RenderCaptureReader reader;
+  if (!reader.Open(file_path)) {
+    return 1;
+  }
+
+  std::vector<RenderCaptureFrame> frames;
+  RenderCaptureFrame frame;
+  while (reader.ReadFrame(frame)) {
+    frames.push_back(std::move(frame));
+    frame = RenderCaptureFrame{};
+  }
+
+  if (frames.empty()) {
+    std::cerr << "[render_replay] Capture contains no frames" << '\n';
+    return 1;
+  }
+
+  std::vector<SortablePacket> scratch;
+  StageTimes times;
+  BatchStats stats;
+
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    BatchStats iteration_stats;
+    for (const RenderCaptureFrame& captured : frames) {
+      for (const RenderCaptureView& view : captured.views) {
+        ReplayView(view, scratch, times, iteration_stats);
+      }
+    }
+    // Counts are deterministic; keep the first pass only
+    if (iteration == 0) {
+      stats = iteration_stats;
+    }
+  }
+
+  const uint64_t frame_count = frames.size();
+  const uint64_t frame_samples = frame_count * static_cast<uint64_t>(iterations);
+  const double inv_frames = 1.0 / static_cast<double>(frame_count);
+
+  std::cout << "=== Render Replay: " << file_path << " ===" << '\n';
+  std::cout << "Frames: " << frame_count << ", iterations: " << iterations << '\n';
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "Per frame (average):" << '\n';
+  std::cout << "  Packets:          " << static_cast<double>(stats.packets) * inv_frames << '\n';
+  std::cout << "  Draws:            " << static_cast<double>(stats.draws) * inv_frames << '\n';
+  std::cout << "  PSO switches:     " << static_cast<double>(stats.pso_switches) * inv_frames << '\n';
+  std::cout << "  Material changes: " << static_cast<double>(stats.material_changes) * inv_frames << '\n';
+  std::cout << "  Mesh changes:     " << static_cast<double>(stats.mesh_changes) * inv_frames << '\n';
+  std::cout << "  Triangles:        " << static_cast<double>(stats.triangles) * inv_frames << '\n';
+
+  std::cout << "Stage timings:" << '\n';
+  PrintStage("filter", times.filter_ns, frame_samples);
+  PrintStage("sort_key", times.sort_key_ns, frame_samples);
+  PrintStage("sort", times.sort_ns, frame_samples);
+  PrintStage("batch", times.batch_ns, frame_samples);
+  PrintStage("total", times.filter_ns + times.sort_key_ns + times.sort_ns + times.batch_ns, frame_samples);
+
+  return 0;
+}
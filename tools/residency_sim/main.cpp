@@ -0,0 +1,330 @@
+// residency_sim: Checks ResidencyPolicy (residency_policy.h), the bookkeeping behind ResidencyManager, against a
+// simulated video memory budget.
+//
+// The known-answer cases cover least recently used order, Touch moving an entry to the back, pinned entries
+// counting towards the budget without ever being evicted, entries used by frames in flight being protected,
+// restores, unregistering evicted entries, handle reuse and an unlimited budget. The simulation then runs
+// frames of a texture-like workload (a drifting working set, streaming registrations and releases) under a
+// budget that shrinks and grows, mirrors every call in a reference model and checks after each frame: Touch
+// reports exactly the evicted entries, evictions only take idle unpinned resident entries in LRU order, the
+// budget is met unless every remaining candidate is still in flight, and the stats match the model.
+//
+// Usage: residency_sim [--frames <n>] [--entries <n>] [--min-idle <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "residency_policy.h"
+
+namespace {
+using Handle = ResidencyPolicy::Handle;
+
+struct Options {
+  uint32_t frames = 5000;
+  uint32_t entries = 400;
+  uint32_t min_idle = 3;  // FrameCount in flight
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--frames" && has_value) {
+      options.frames = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--entries" && has_value) {
+      options.entries = static_cast<uint32_t>((std::max)(8, std::atoi(argv[++i])));
+    } else if (arg == "--min-idle" && has_value) {
+      options.min_idle = static_cast<uint32_t>((std::max)(0, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[residency_sim] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+bool RunChecks() {
+  Checker checker;
+  std::vector<Handle> evicted;
+
+  // Least recently used first; Touch moves an entry to the back
+  {
+    ResidencyPolicy policy;
+    policy.BeginFrame(0);
+    const Handle a = policy.Register(100);
+    const Handle b = policy.Register(100);
+    const Handle c = policy.Register(100);
+    const Handle d = policy.Register(100);
+    policy.BeginFrame(1);
+    policy.Touch(a);
+    policy.BeginFrame(10);
+    policy.SetBudget(250);
+    checker.Expect(policy.CollectEvictions(2, evicted) == 2 && evicted == std::vector<Handle>({b, c}), "evicts least recently used first");
+    checker.Expect(!policy.IsResident(b) && !policy.IsResident(c) && policy.IsResident(a) && policy.IsResident(d), "survivors resident");
+    checker.Expect(policy.GetStats().resident_bytes == 200 && policy.GetStats().resident_count == 2, "resident bytes after eviction");
+    checker.Expect(policy.GetStats().evictions == 2 && policy.GetStats().evicted_bytes == 200, "evictions counted");
+
+    // An evicted entry reports that it must be made resident again, once
+    checker.Expect(policy.Touch(b) && policy.IsResident(b) && policy.GetStats().restores == 1, "touching an evicted entry restores it");
+    checker.Expect(!policy.Touch(b), "second touch of a restored entry reports nothing");
+    checker.Expect(policy.GetLastUsedFrame(b) == 10, "touch stamps the frame");
+
+    // Unregistering an evicted entry leaves resident bytes alone
+    policy.Unregister(c);
+    checker.Expect(policy.GetStats().tracked_bytes == 300 && policy.GetStats().resident_bytes == 300 && policy.GetStats().tracked_count == 3,
+      "unregistering an evicted entry");
+    const Handle e = policy.Register(50);
+    checker.Expect(e == c && policy.IsResident(e) && policy.GetSize(e) == 50, "released handle reused");
+  }
+
+  // Entries used by frames in flight stay resident even over budget
+  {
+    ResidencyPolicy policy;
+    policy.BeginFrame(5);
+    const Handle old_entry = policy.Register(100);
+    policy.BeginFrame(8);
+    const Handle busy = policy.Register(100);
+    policy.SetBudget(50);
+    evicted.clear();
+    checker.Expect(policy.CollectEvictions(3, evicted) == 1 && evicted == std::vector<Handle>({old_entry}), "idle entry evicted");
+    checker.Expect(policy.IsResident(busy) && policy.GetStats().resident_bytes == 100, "entry in flight kept over budget");
+    policy.BeginFrame(10);
+    evicted.clear();
+    checker.Expect(policy.CollectEvictions(3, evicted) == 0, "still in flight two frames later");
+    policy.BeginFrame(11);
+    checker.Expect(policy.CollectEvictions(3, evicted) == 1 && evicted == std::vector<Handle>({busy}), "evicted once idle for min_idle frames");
+  }
+
+  // Pinned entries count towards the budget but are never evicted
+  {
+    ResidencyPolicy policy;
+    policy.BeginFrame(0);
+    const Handle pinned = policy.Register(300, true);
+    const Handle normal = policy.Register(100);
+    policy.BeginFrame(100);
+    policy.SetBudget(200);
+    evicted.clear();
+    checker.Expect(policy.CollectEvictions(1, evicted) == 1 && evicted == std::vector<Handle>({normal}), "only the unpinned entry evicted");
+    checker.Expect(policy.IsResident(pinned) && policy.GetStats().resident_bytes == 300, "pinned entry stays resident over budget");
+    checker.Expect(!policy.Touch(pinned) && policy.GetLastUsedFrame(pinned) == 100, "touching a pinned entry");
+    policy.Unregister(pinned);
+    checker.Expect(policy.GetStats().resident_bytes == 0 && policy.GetStats().tracked_bytes == 100, "unregistering a pinned entry");
+  }
+
+  // No budget, no evictions
+  {
+    ResidencyPolicy policy;
+    policy.Register(1ull << 40);
+    policy.BeginFrame(1000);
+    evicted.clear();
+    checker.Expect(policy.CollectEvictions(0, evicted) == 0 && evicted.empty(), "unlimited budget evicts nothing");
+  }
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+struct ModelEntry {
+  uint64_t size = 0;
+  uint64_t last_used = 0;
+  bool alive = false;
+  bool resident = false;
+  bool pinned = false;
+};
+
+bool RunSimulation(const Options& options) {
+  std::mt19937 rng(options.seed);
+  ResidencyPolicy policy;
+  std::vector<ModelEntry> model;
+  std::vector<Handle> live;
+  std::vector<Handle> evicted;
+
+  uint32_t violations = 0;
+  uint32_t budget_misses = 0;
+  uint64_t policy_ns = 0;
+  uint64_t touches = 0;
+  uint64_t peak_evictions = 0;
+
+  auto register_entry = [&]() {
+    // Textures from 64KB to 16MB, one in sixteen pinned (placed in a shared heap)
+    const uint64_t size = (64ull << 10) << (rng() % 9);
+    const bool pinned = rng() % 16 == 0;
+    const Handle handle = policy.Register(size, pinned);
+    if (handle >= model.size()) {
+      model.resize(handle + 1);
+    }
+    if (model[handle].alive) {
+      ++violations;  // Handed out twice
+    }
+    model[handle] = {size, 0, true, true, pinned};
+    live.push_back(handle);
+  };
+
+  for (uint32_t i = 0; i < options.entries; ++i) {
+    register_entry();
+  }
+
+  for (uint64_t frame = 1; frame <= options.frames; ++frame) {
+    policy.BeginFrame(frame);
+
+    // Budget between a quarter and all of the tracked bytes, changing every few hundred frames (other apps,
+    // a window moving to another adapter)
+    if (frame % 300 == 1) {
+      uint64_t tracked = 0;
+      for (const Handle handle : live) {
+        tracked += model[handle].size;
+      }
+      policy.SetBudget(tracked / 4 + rng() % (tracked * 3 / 4 + 1));
+    }
+
+    // Streaming: a few textures come and go
+    const uint32_t churn = rng() % 4;
+    for (uint32_t i = 0; i < churn && !live.empty(); ++i) {
+      const size_t index = rng() % live.size();
+      const Handle handle = live[index];
+      const uint64_t start = NowNs();
+      policy.Unregister(handle);
+      policy_ns += NowNs() - start;
+      model[handle].alive = false;
+      live[index] = live.back();
+      live.pop_back();
+    }
+    for (uint32_t i = 0; i < churn; ++i) {
+      register_entry();
+      model[live.back()].last_used = frame;
+    }
+
+    // The working set drifts through the entries: a window around a moving centre, plus a few random ones
+    const size_t window = (std::max)(size_t{1}, live.size() / 4);
+    const size_t centre = static_cast<size_t>(frame / 7) % (std::max)(size_t{1}, live.size());
+    for (size_t i = 0; i < window + 8; ++i) {
+      const size_t index = i < window ? (centre + i) % live.size() : rng() % live.size();
+      const Handle handle = live[index];
+      ModelEntry& entry = model[handle];
+      const uint64_t start = NowNs();
+      const bool restore = policy.Touch(handle);
+      policy_ns += NowNs() - start;
+      ++touches;
+      if (restore != (!entry.pinned && !entry.resident)) {
+        ++violations;
+      }
+      entry.resident = true;
+      entry.last_used = frame;
+    }
+
+    evicted.clear();
+    const uint64_t start = NowNs();
+    policy.CollectEvictions(options.min_idle, evicted);
+    policy_ns += NowNs() - start;
+    peak_evictions = (std::max)(peak_evictions, static_cast<uint64_t>(evicted.size()));
+
+    // Evictions: resident, unpinned, idle, in LRU order, and never more recent than a survivor
+    uint64_t previous_last_used = 0;
+    for (const Handle handle : evicted) {
+      ModelEntry& entry = model[handle];
+      if (!entry.alive || !entry.resident || entry.pinned || entry.last_used + options.min_idle > frame ||
+          entry.last_used < previous_last_used) {
+        ++violations;
+      }
+      previous_last_used = entry.last_used;
+      entry.resident = false;
+    }
+
+    uint64_t tracked_bytes = 0;
+    uint64_t resident_bytes = 0;
+    uint32_t resident_count = 0;
+    bool evictable_left = false;
+    for (const Handle handle : live) {
+      const ModelEntry& entry = model[handle];
+      tracked_bytes += entry.size;
+      if (!entry.resident) {
+        continue;
+      }
+      resident_bytes += entry.size;
+      ++resident_count;
+      if (!entry.pinned && entry.last_used < previous_last_used) {
+        ++violations;  // A less recently used entry survived an eviction
+      }
+      if (!entry.pinned && entry.last_used + options.min_idle <= frame) {
+        evictable_left = true;
+      }
+      if (policy.IsResident(handle) != entry.resident) {
+        ++violations;
+      }
+    }
+
+    // Over budget only when every remaining candidate is pinned or still in flight
+    const ResidencyPolicy::Stats& stats = policy.GetStats();
+    if (stats.resident_bytes > stats.budget) {
+      ++budget_misses;
+      if (evictable_left) {
+        ++violations;
+      }
+    }
+    if (stats.tracked_bytes != tracked_bytes || stats.resident_bytes != resident_bytes || stats.resident_count != resident_count ||
+        stats.tracked_count != live.size()) {
+      ++violations;
+    }
+  }
+
+  for (const Handle handle : live) {
+    policy.Unregister(handle);
+  }
+  const ResidencyPolicy::Stats& stats = policy.GetStats();
+  const bool drained = stats.tracked_bytes == 0 && stats.resident_bytes == 0 && stats.tracked_count == 0 && stats.resident_count == 0;
+
+  std::cout << "Simulation: " << options.frames << " frames, " << options.entries << " entries, min idle " << options.min_idle
+            << " frames, seed " << options.seed << '\n';
+  std::cout << std::fixed << std::setprecision(1) << "  Policy time: " << static_cast<double>(policy_ns) / options.frames
+            << " ns per frame (" << touches / options.frames << " touches)" << '\n';
+  std::cout << "  Evictions: " << stats.evictions << " (" << (stats.evicted_bytes >> 20) << " MB), restores: " << stats.restores
+            << ", most in one frame: " << peak_evictions << '\n';
+  std::cout << "  Frames over budget with everything left in flight or pinned: " << budget_misses << '\n';
+  std::cout << "  Violations: " << violations << " (must be 0)" << '\n';
+  std::cout << "  After unregistering everything: " << stats.tracked_bytes << " bytes tracked (must be 0)" << '\n';
+  return violations == 0 && drained && stats.evictions > 0 && stats.restores > 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: residency_sim [--frames <n>] [--entries <n>] [--min-idle <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Residency Sim ===" << '\n';
+  const bool checks_passed = RunChecks();
+  const bool simulation_passed = RunSimulation(options);
+  return checks_passed && simulation_passed ? 0 : 1;
+}
@@ -0,0 +1,328 @@
+// ring_allocator_check: Checks FencedRingAllocator (fenced_ring_allocator.h) against a reference model.
+//
+// The known-answer cases cover owner merging, closed entries staying separate, wrapping to the start,
+// a wrapped allocation having to end before the oldest live one, alignment, Retire stopping at an open
+// or incomplete entry and GetUsedSize counting wrap waste. The random part runs many capacities with
+// random sizes, alignments, owners, Close and Retire calls. The model keeps every allocation on its own
+// in a FIFO; consecutive open allocations of one owner are always closed together, so retiring them one
+// by one must free exactly what the allocator's merged entries free. Each step compares the offset (or
+// failure) with where the ring should place the request, checks that live allocations never overlap,
+// and compares GetUsedSize, GetOldestFence and IsEmpty.
+//
+// Usage: ring_allocator_check [--capacities <n>] [--steps <n>] [--seed <n>]
+// Exits with 1 when a check fails.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+#include "fenced_ring_allocator.h"
+
+namespace {
+struct Options {
+  uint32_t capacities = 200;
+  uint32_t steps = 20000;
+  uint32_t seed = 1;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--capacities" && has_value) {
+      options.capacities = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--steps" && has_value) {
+      options.steps = static_cast<uint32_t>((std::max)(1, std::atoi(argv[++i])));
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else {
+      std::cerr << "[ring_allocator_check] Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const char* name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+// Allocates and returns the offset, or ~0 on failure
+uint64_t Allocate(FencedRingAllocator& ring, uint64_t size, uint64_t alignment, uint32_t owner) {
+  uint64_t offset = 0;
+  return ring.Allocate(size, alignment, owner, offset) ? offset : ~0ull;
+}
+
+bool RunChecks() {
+  Checker checker;
+  FencedRingAllocator ring(100);
+  uint64_t fence = 0;
+
+  checker.Expect(Allocate(ring, 0, 1, 1) == ~0ull && Allocate(ring, 101, 1, 1) == ~0ull && ring.IsEmpty(), "invalid sizes rejected");
+
+  // Consecutive allocations of one owner merge and retire together
+  checker.Expect(Allocate(ring, 40, 1, 1) == 0 && Allocate(ring, 40, 1, 1) == 40, "allocations in order");
+  checker.Expect(!ring.GetOldestFence(fence), "open allocation has no fence");
+  ring.Close(1, 5);
+  checker.Expect(ring.GetOldestFence(fence) && fence == 5 && ring.GetUsedSize() == 80, "close stamps the owner");
+  checker.Expect(Allocate(ring, 30, 1, 2) == ~0ull, "no wrap while the start is live");
+  ring.Retire(4);
+  checker.Expect(ring.GetUsedSize() == 80, "retire waits for the fence");
+  ring.Retire(5);
+  checker.Expect(ring.IsEmpty() && ring.GetUsedSize() == 0, "merged allocations retire together");
+
+  // An empty ring starts over at 0; a wrapped allocation must end before the oldest live one
+  checker.Expect(Allocate(ring, 30, 1, 2) == 0 && Allocate(ring, 50, 1, 3) == 30, "empty ring restarts at 0");
+  ring.Close(2, 1);
+  ring.Retire(1);
+  checker.Expect(ring.GetUsedSize() == 50, "retire frees the oldest");
+  checker.Expect(Allocate(ring, 30, 1, 3) == ~0ull, "wrapped allocation may not reach the oldest");
+  checker.Expect(Allocate(ring, 29, 1, 3) == 0 && ring.GetUsedSize() == 99, "wrap counts the unused end");
+  checker.Expect(Allocate(ring, 1, 1, 3) == ~0ull, "wrapped ring full");
+  ring.Close(3, 7);
+  ring.Retire(6);
+  checker.Expect(ring.GetUsedSize() == 99, "wrapped owner waits for its fence");
+  ring.Retire(7);
+  checker.Expect(ring.IsEmpty(), "wrapped owner retires across the wrap");
+
+  // A closed entry is not extended by the next allocation of its owner
+  checker.Expect(Allocate(ring, 10, 1, 4) == 0, "allocation before close");
+  ring.Close(4, 2);
+  checker.Expect(Allocate(ring, 10, 1, 4) == 10, "allocation after close");
+  ring.Retire(2);
+  checker.Expect(ring.GetUsedSize() == 10 && !ring.GetOldestFence(fence), "closed entry retires alone");
+
+  // Alignment pads from the newest end; the padding counts as used
+  checker.Expect(Allocate(ring, 5, 16, 5) == 32 && ring.GetUsedSize() == 27, "aligned allocation");
+
+  // An open entry blocks everything allocated after it
+  ring.Close(5, 3);
+  ring.Retire(100);
+  checker.Expect(ring.GetUsedSize() == 27, "open oldest entry blocks retire");
+  ring.Close(4, 9);
+  ring.Retire(8);
+  checker.Expect(ring.GetUsedSize() == 27, "oldest entry waits for its fence");
+  ring.Retire(9);
+  checker.Expect(ring.IsEmpty(), "everything retired");
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Every allocation on its own, oldest first
+class RingModel {
+ public:
+  explicit RingModel(uint64_t capacity) : capacity_(capacity) {
+  }
+
+  // Where the ring should place the request, or ~0 when it cannot: after the newest allocation, or at 0
+  // after wrapping, ending strictly before the oldest when wrapped
+  uint64_t GetExpectedOffset(uint64_t size, uint64_t alignment) const {
+    if (size == 0 || size > capacity_) {
+      return ~0ull;
+    }
+    if (live_.empty()) {
+      return 0;
+    }
+    const uint64_t head = live_.front().begin;
+    const uint64_t tail = live_.back().end;
+    const uint64_t offset = AlignUp(tail, alignment);
+    if (tail > head) {
+      if (offset + size <= capacity_) {
+        return offset;
+      }
+      return size < head ? 0 : ~0ull;
+    }
+    return offset + size < head ? offset : ~0ull;
+  }
+
+  // False when the range overlaps a live allocation
+  bool Add(uint64_t offset, uint64_t size, uint32_t owner) {
+    const auto next = occupied_.lower_bound(offset);
+    if (next != occupied_.end() && next->first < offset + size) {
+      return false;
+    }
+    if (next != occupied_.begin() && std::prev(next)->second > offset) {
+      return false;
+    }
+    occupied_.emplace(offset, offset + size);
+    live_.push_back({offset, offset + size, 0, owner, false});
+    return true;
+  }
+
+  void Close(uint32_t owner, uint64_t fence) {
+    for (Allocation& allocation : live_) {
+      if (!allocation.closed && allocation.owner == owner) {
+        allocation.closed = true;
+        allocation.fence = fence;
+      }
+    }
+  }
+
+  uint32_t Retire(uint64_t completed_fence) {
+    uint32_t retired = 0;
+    while (!live_.empty() && live_.front().closed && live_.front().fence <= completed_fence) {
+      occupied_.erase(live_.front().begin);
+      live_.pop_front();
+      ++retired;
+    }
+    return retired;
+  }
+
+  uint64_t GetUsedSize() const {
+    if (live_.empty()) {
+      return 0;
+    }
+    const uint64_t head = live_.front().begin;
+    const uint64_t tail = live_.back().end;
+    return tail > head ? tail - head : capacity_ - head + tail;
+  }
+
+  bool GetOldestFence(uint64_t& out_fence) const {
+    if (live_.empty() || !live_.front().closed) {
+      return false;
+    }
+    out_fence = live_.front().fence;
+    return true;
+  }
+
+  bool IsEmpty() const {
+    return live_.empty();
+  }
+
+ private:
+  struct Allocation {
+    uint64_t begin;
+    uint64_t end;
+    uint64_t fence;
+    uint32_t owner;
+    bool closed;
+  };
+
+  uint64_t capacity_;
+  std::deque<Allocation> live_;
+  std::map<uint64_t, uint64_t> occupied_;  // begin -> end
+};
+
+struct RandomTotals {
+  uint64_t allocations = 0;
+  uint64_t failed_allocations = 0;
+  uint64_t wrapped_allocations = 0;
+  uint64_t retired = 0;
+  uint32_t violations = 0;
+};
+
+// Up to four owners record at once, as upload batches do; each Close issues the next fence and the
+// completed fence trails the issued one
+void RunCapacity(uint64_t capacity, uint32_t steps, std::mt19937& rng, RandomTotals& totals) {
+  FencedRingAllocator ring(capacity);
+  RingModel model(capacity);
+  uint64_t issued_fence = 0;
+  uint64_t completed_fence = 0;
+  uint32_t next_owner = 1;
+
+  for (uint32_t step = 0; step < steps; ++step) {
+    const uint32_t action = rng() % 100;
+    if (action < 60) {
+      const uint64_t max_size = rng() % 8 == 0 ? capacity : (std::max)(uint64_t{1}, capacity / 8);
+      const uint64_t size = rng() % 64 == 0 ? 0 : 1 + rng() % max_size;
+      const uint64_t alignment = rng() % 3 == 0 ? 1ull << (rng() % 9) : 1;
+      const uint32_t owner = next_owner + rng() % 4;
+      const uint64_t expected = model.GetExpectedOffset(size, alignment);
+      uint64_t offset = 0;
+      const bool allocated = ring.Allocate(size, alignment, owner, offset);
+      if (!allocated) {
+        ++totals.failed_allocations;
+        totals.violations += expected != ~0ull ? 1 : 0;
+      } else {
+        ++totals.allocations;
+        const bool wraps = !model.IsEmpty() && offset == 0;
+        totals.wrapped_allocations += wraps ? 1 : 0;
+        if (offset != expected || offset % alignment != 0 || offset + size > capacity || !model.Add(offset, size, owner)) {
+          ++totals.violations;
+        }
+      }
+    } else if (action < 75) {
+      // Close the oldest recording owner; the others keep recording
+      ring.Close(next_owner, ++issued_fence);
+      model.Close(next_owner, issued_fence);
+      ++next_owner;
+    } else if (action < 80) {
+      // Close a random recording owner out of order
+      const uint32_t owner = next_owner + rng() % 4;
+      ring.Close(owner, ++issued_fence);
+      model.Close(owner, issued_fence);
+    } else {
+      completed_fence = (std::min)(issued_fence, completed_fence + rng() % 3);
+      ring.Retire(completed_fence);
+      totals.retired += model.Retire(completed_fence);
+    }
+
+    uint64_t fence = 0;
+    uint64_t model_fence = 0;
+    const bool has_fence = ring.GetOldestFence(fence);
+    if (has_fence != model.GetOldestFence(model_fence) || (has_fence && fence != model_fence) || ring.IsEmpty() != model.IsEmpty() ||
+        ring.GetUsedSize() != model.GetUsedSize() || ring.GetUsedSize() > capacity) {
+      ++totals.violations;
+    }
+  }
+
+  // Closing every owner and completing every fence must drain the ring
+  for (uint32_t owner = 1; owner < next_owner + 4; ++owner) {
+    ring.Close(owner, issued_fence + 1);
+  }
+  ring.Retire(issued_fence + 1);
+  if (!ring.IsEmpty() || ring.GetUsedSize() != 0 || Allocate(ring, capacity, 1, 0) != 0) {
+    ++totals.violations;
+  }
+}
+
+bool RunRandom(const Options& options) {
+  std::mt19937 rng(options.seed);
+  RandomTotals totals;
+  for (uint32_t i = 0; i < options.capacities; ++i) {
+    // Tiny rings first, where every request wraps or fails, then staging-sized ones
+    const uint64_t capacity = i < 16 ? i + 1 : 17 + rng() % 65536;
+    RunCapacity(capacity, options.steps, rng, totals);
+  }
+
+  std::cout << "Random: " << options.capacities << " capacities x " << options.steps << " steps, seed " << options.seed << '\n';
+  std::cout << "  Allocations: " << totals.allocations << " (" << totals.wrapped_allocations << " wrapped, " << totals.failed_allocations
+            << " failed), retired: " << totals.retired << '\n';
+  std::cout << "  Violations: " << totals.violations << " (must be 0)" << '\n';
+  return totals.violations == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: ring_allocator_check [--capacities <n>] [--steps <n>] [--seed <n>]" << '\n';
+    return 1;
+  }
+
+  std::cout << "=== Fenced Ring Allocator Check ===" << '\n';
+  const bool checks_passed = RunChecks();
+  const bool random_passed = RunRandom(options);
+  return checks_passed && random_passed ? 0 : 1;
+}
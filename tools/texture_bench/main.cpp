@@ -0,0 +1,429 @@
+// texture_bench: Times CPU texture processing on source images: PNG / TGA decode throughput per file and
+// for the whole set decoded serially and in parallel on a thread pool (one job per image, like the async
+// texture loader), then mip chain generation per filter on the scalar path, the SIMD path and the SIMD
+// path spread over the pool. Directories expand to the images they contain.
+//
+// With --verify it checks the mip generator instead of timing it: the scalar, SIMD and threaded paths must
+// produce bit-identical chains (synthetic images of awkward sizes plus any inputs, every filter, alpha mode
+// and color space), constant images must stay constant at every level, and sRGB averaging must happen in
+// linear space (a black / white checkerboard averages to sRGB 188, not 128) with alpha left linear.
+// Exits with 1 when a check fails.
+//
+// Usage: texture_bench [--iterations <n>] [--threads <n>] [--srgb] [--decode-only] [--verify] <image | directory>...
+//   e.g. texture_bench Content/textures
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "image_decoder.h"
+#include "mapped_file.h"
+#include "mip_generator.h"
+#include "thread_pool.h"
+
+namespace {
+struct Options {
+  int iterations = 10;
+  uint32_t threads = 0;
+  bool srgb = false;
+  bool decode_only = false;
+  bool verify = false;
+  std::vector<std::filesystem::path> inputs;
+};
+
+// A mapped source file with its decode destination (the warm-up decode faults the file in, so disk I/O
+// stays out of the timings)
+struct SourceFile {
+  std::filesystem::path path;
+  MappedFile file;
+  ImageInfo info;
+  Image decoded;
+};
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--iterations" && has_value) {
+      options.iterations = (std::max)(1, std::atoi(argv[++i]));
+    } else if (arg == "--threads" && has_value) {
+      options.threads = static_cast<uint32_t>((std::max)(0, std::atoi(argv[++i])));
+    } else if (arg == "--srgb") {
+      options.srgb = true;
+    } else if (arg == "--decode-only") {
+      options.decode_only = true;
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[texture_bench] Unknown option: " << arg << '\n';
+      return false;
+    } else if (std::filesystem::is_directory(arg)) {
+      std::vector<std::filesystem::path> files;
+      for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(arg)) {
+        const std::filesystem::path extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == ".png" || extension == ".tga")) {
+          files.push_back(entry.path());
+        }
+      }
+      std::sort(files.begin(), files.end());
+      options.inputs.insert(options.inputs.end(), files.begin(), files.end());
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.inputs.empty() || options.verify;
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Average milliseconds of GenerateMipChain over the iterations (after one warm-up run)
+double TimeMipChain(const Image& source, const MipGenerationOptions& options, int iterations) {
+  std::vector<Image> mips;
+  GenerateMipChain(source, options, mips);
+
+  const uint64_t start = NowNs();
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    GenerateMipChain(source, options, mips);
+  }
+  return static_cast<double>(NowNs() - start) / 1e6 / iterations;
+}
+
+// Average milliseconds to decode every file once, one after another or as one pool job per file
+double TimeDecodeSet(std::span<SourceFile> files, ThreadPool* pool, int iterations) {
+  auto decode = [](SourceFile& source) {
+    DecodeImage(source.file.GetData(), source.file.GetSize(), source.decoded.pixels.data(), source.decoded.GetRowPitch());
+  };
+
+  const uint64_t start = NowNs();
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    if (pool == nullptr) {
+      for (SourceFile& source : files) {
+        decode(source);
+      }
+      continue;
+    }
+    std::latch done(static_cast<std::ptrdiff_t>(files.size()));
+    for (SourceFile& source : files) {
+      pool->Submit([&decode, &source, &done] {
+        decode(source);
+        done.count_down();
+      });
+    }
+    done.wait();
+  }
+  return static_cast<double>(NowNs() - start) / 1e6 / iterations;
+}
+
+// Decode throughput: compressed input MB/s and decoded megapixels per second (speedup when baseline_ms > 0)
+void PrintDecodeRow(const std::string& name, double ms, uint64_t file_bytes, uint64_t pixels, double baseline_ms) {
+  std::cout << "  " << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(2) << std::setw(9) << ms
+            << " ms" << std::setw(9) << std::setprecision(1) << static_cast<double>(file_bytes) / 1e6 / (ms / 1000.0) << " MB/s"
+            << std::setw(9) << static_cast<double>(pixels) / 1e6 / (ms / 1000.0) << " MP/s";
+  if (baseline_ms > 0.0) {
+    std::cout << std::setw(7) << std::setprecision(2) << baseline_ms / ms << "x";
+  }
+  std::cout << '\n';
+}
+
+void PrintRow(const char* name, double ms, double baseline_ms, const Image& source) {
+  const double megapixels = static_cast<double>(source.width) * source.height / 1e6;
+  std::cout << "  " << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(2) << std::setw(9) << ms
+            << " ms" << std::setw(9) << std::setprecision(1) << megapixels / (ms / 1000.0) << " MP/s" << std::setw(7)
+            << std::setprecision(2) << baseline_ms / ms << "x" << '\n';
+}
+
+struct Checker {
+  uint32_t passed = 0;
+  uint32_t failed = 0;
+
+  void Expect(bool condition, const std::string& name) {
+    if (condition) {
+      ++passed;
+      return;
+    }
+    ++failed;
+    std::cout << "  FAIL " << name << '\n';
+  }
+};
+
+std::string DescribeOptions(const MipGenerationOptions& options) {
+  std::string text = (options.filter == MipFilter::Box) ? "box" : "kaiser";
+  text += (options.alpha_mode == MipAlphaMode::Straight) ? ", straight" : ", premultiplied";
+  text += options.srgb ? ", sRGB" : ", linear";
+  return text;
+}
+
+// Every combination of filter, alpha mode and color space
+std::vector<MipGenerationOptions> AllMipOptions() {
+  std::vector<MipGenerationOptions> all;
+  for (const MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+    for (const MipAlphaMode alpha_mode : {MipAlphaMode::Straight, MipAlphaMode::Premultiplied}) {
+      for (const bool srgb : {false, true}) {
+        MipGenerationOptions options;
+        options.filter = filter;
+        options.alpha_mode = alpha_mode;
+        options.srgb = srgb;
+        all.push_back(options);
+      }
+    }
+  }
+  return all;
+}
+
+Image MakeNoise(uint32_t width, uint32_t height, uint32_t seed) {
+  Image image;
+  image.Resize(width, height);
+  std::mt19937 rng(seed);
+  for (uint8_t& value : image.pixels) {
+    value = static_cast<uint8_t>(rng());
+  }
+  return image;
+}
+
+Image MakeConstant(uint32_t width, uint32_t height, const std::array<uint8_t, 4>& color) {
+  Image image;
+  image.Resize(width, height);
+  for (size_t i = 0; i < image.pixels.size(); ++i) {
+    image.pixels[i] = color[i % Image::kBytesPerPixel];
+  }
+  return image;
+}
+
+// 1-texel checkerboard of two colors
+Image MakeCheckerboard(uint32_t size, const std::array<uint8_t, 4>& even, const std::array<uint8_t, 4>& odd) {
+  Image image;
+  image.Resize(size, size);
+  for (uint32_t y = 0; y < size; ++y) {
+    for (uint32_t x = 0; x < size; ++x) {
+      const std::array<uint8_t, 4>& color = ((x + y) % 2 == 0) ? even : odd;
+      std::copy(color.begin(), color.end(), image.GetPixel(x, y));
+    }
+  }
+  return image;
+}
+
+// Every texel of levels 1.. at least border texels away from the edges has the expected channels
+bool LevelsEqual(const std::vector<Image>& mips, const std::array<uint8_t, 4>& expected, uint32_t border) {
+  if (mips.size() < 2) {
+    return false;
+  }
+  for (size_t level = 1; level < mips.size(); ++level) {
+    const Image& image = mips[level];
+    for (uint32_t y = border; y + border < image.height; ++y) {
+      for (uint32_t x = border; x + border < image.width; ++x) {
+        if (!std::equal(expected.begin(), expected.end(), image.GetPixel(x, y))) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameChain(const std::vector<Image>& a, const std::vector<Image>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t level = 0; level < a.size(); ++level) {
+    if (a[level].width != b[level].width || a[level].height != b[level].height || a[level].pixels != b[level].pixels) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Scalar, SIMD and SIMD + threads must agree to the bit for every option combination
+void VerifyPathsMatch(Checker& checker, const std::string& name, const Image& source, ThreadPool& pool) {
+  for (MipGenerationOptions options : AllMipOptions()) {
+    std::vector<Image> scalar;
+    std::vector<Image> simd;
+    std::vector<Image> threaded;
+    options.force_scalar = true;
+    GenerateMipChain(source, options, scalar);
+    options.force_scalar = false;
+    GenerateMipChain(source, options, simd);
+    options.pool = &pool;
+    GenerateMipChain(source, options, threaded);
+
+    const std::string description = name + " (" + DescribeOptions(options) + ")";
+    checker.Expect(SameChain(scalar, simd), "simd matches scalar: " + description);
+    checker.Expect(SameChain(scalar, threaded), "threads match scalar: " + description);
+  }
+}
+
+// Every texel of every level equals color. Straight alpha weights color by alpha while filtering, so fully
+// transparent texels keep no color: those levels must be transparent black instead.
+void VerifyConstant(Checker& checker, uint32_t width, uint32_t height, const std::array<uint8_t, 4>& color, ThreadPool& pool) {
+  const Image source = MakeConstant(width, height, color);
+  for (MipGenerationOptions options : AllMipOptions()) {
+    options.pool = &pool;
+    std::vector<Image> mips;
+    GenerateMipChain(source, options, mips);
+
+    const bool cleared = options.alpha_mode == MipAlphaMode::Straight && color[3] == 0;
+    const std::array<uint8_t, 4> expected = cleared ? std::array<uint8_t, 4>{0, 0, 0, 0} : color;
+    const bool constant =
+      mips.size() == CalculateMipCount(width, height) && mips[0].pixels == source.pixels && LevelsEqual(mips, expected, 0);
+    checker.Expect(constant,
+      "constant stays constant: " + std::to_string(width) + "x" + std::to_string(height) + " (" + std::to_string(color[0]) + ", " +
+        std::to_string(color[1]) + ", " + std::to_string(color[2]) + ", " + std::to_string(color[3]) + "), " + DescribeOptions(options));
+  }
+}
+
+
+// A black / white checkerboard averages to linear 0.5: sRGB 188 when filtered in linear space, 128 when the
+// encoded values are averaged directly. Alpha is always linear. Kaiser taps clamp at the edges, which breaks
+// the pattern's symmetry there, so only its interior is checked.
+void VerifySrgbAveraging(Checker& checker, ThreadPool& pool) {
+  const double encoded = 1.055 * std::pow(0.5, 1.0 / 2.4) - 0.055;
+  const auto srgb_half = static_cast<uint8_t>(std::lround(encoded * 255.0));
+
+  const Image color_board = MakeCheckerboard(64, {0, 0, 0, 255}, {255, 255, 255, 255});
+  const Image alpha_board = MakeCheckerboard(64, {255, 255, 255, 0}, {255, 255, 255, 255});
+  for (const MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+    for (const bool force_scalar : {true, false}) {
+      MipGenerationOptions options;
+      options.filter = filter;
+      options.force_scalar = force_scalar;
+      options.pool = force_scalar ? nullptr : &pool;
+      const std::string path = std::string(filter == MipFilter::Box ? "box" : "kaiser") + (force_scalar ? ", scalar" : ", simd");
+      const uint32_t border = (filter == MipFilter::Box) ? 0 : 4;
+
+      std::vector<Image> mips;
+      options.srgb = true;
+      GenerateMipChain(color_board, options, mips);
+      checker.Expect(LevelsEqual(mips, {srgb_half, srgb_half, srgb_half, 255}, border),
+        "sRGB checkerboard averages to " + std::to_string(srgb_half) + " (" + path + ")");
+
+      options.srgb = false;
+      GenerateMipChain(color_board, options, mips);
+      checker.Expect(LevelsEqual(mips, {128, 128, 128, 255}, border), "linear checkerboard averages to 128 (" + path + ")");
+
+      options.srgb = true;
+      GenerateMipChain(alpha_board, options, mips);
+      checker.Expect(LevelsEqual(mips, {255, 255, 255, 128}, border), "alpha stays linear under sRGB (" + path + ")");
+    }
+  }
+}
+
+bool RunVerify(const std::vector<SourceFile>& files, ThreadPool& pool) {
+  Checker checker;
+
+  // Odd sizes and single rows / columns exercise the SIMD tails and the row bands of the pool
+  const std::array<std::array<uint32_t, 2>, 7> sizes = {{{256, 256}, {257, 131}, {1000, 3}, {3, 1000}, {64, 1}, {1, 64}, {5, 5}}};
+  uint32_t seed = 1;
+  for (const auto& [width, height] : sizes) {
+    VerifyPathsMatch(checker, "noise " + std::to_string(width) + "x" + std::to_string(height), MakeNoise(width, height, seed++), pool);
+  }
+  for (const SourceFile& file : files) {
+    VerifyPathsMatch(checker, file.path.filename().string(), file.decoded, pool);
+  }
+
+  for (const std::array<uint8_t, 4>& color : std::array<std::array<uint8_t, 4>, 5>{
+         {{0, 0, 0, 255}, {255, 255, 255, 255}, {37, 128, 200, 255}, {90, 20, 240, 128}, {200, 100, 50, 0}}}) {
+    VerifyConstant(checker, 64, 64, color, pool);
+    VerifyConstant(checker, 45, 27, color, pool);
+  }
+
+  VerifySrgbAveraging(checker, pool);
+
+  std::cout << "Checks: " << checker.passed << " passed, " << checker.failed << " failed" << '\n';
+  return checker.failed == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    std::cerr << "Usage: texture_bench [--iterations <n>] [--threads <n>] [--srgb] [--decode-only] [--verify] <image | directory>..."
+              << '\n';
+    return 1;
+  }
+
+  ThreadPool pool;
+  const uint32_t threads = options.threads > 0 ? options.threads : (std::max)(1u, std::thread::hardware_concurrency());
+  pool.Initialize(threads, "Bench");
+
+  std::vector<SourceFile> files(options.inputs.size());
+  uint64_t total_bytes = 0;
+  uint64_t total_pixels = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    SourceFile& source = files[i];
+    source.path = options.inputs[i];
+    if (!source.file.Open(source.path) || !ReadImageInfo(source.file.GetData(), source.file.GetSize(), source.info)) {
+      std::cerr << "[texture_bench] Failed to read " << source.path.string() << '\n';
+      return 1;
+    }
+    source.decoded.Resize(source.info.width, source.info.height);
+    if (!DecodeImage(source.file.GetData(), source.file.GetSize(), source.decoded.pixels.data(), source.decoded.GetRowPitch())) {
+      std::cerr << "[texture_bench] Failed to decode " << source.path.string() << '\n';
+      return 1;
+    }
+    total_bytes += source.file.GetSize();
+    total_pixels += static_cast<uint64_t>(source.info.width) * source.info.height;
+  }
+
+  std::cout << "=== Texture Bench ===" << '\n';
+  if (options.verify) {
+    std::cout << "Verify: " << files.size() << " inputs, threads: " << threads << ", SIMD: " << GetMipGeneratorSimdPath() << '\n';
+    return RunVerify(files, pool) ? 0 : 1;
+  }
+  std::cout << "Iterations: " << options.iterations << ", threads: " << threads << ", SIMD: " << GetMipGeneratorSimdPath()
+            << (options.srgb ? ", sRGB" : "") << '\n';
+
+  std::cout << "Decode:" << '\n';
+  for (SourceFile& source : files) {
+    const double ms = TimeDecodeSet(std::span(&source, 1), nullptr, options.iterations);
+    const uint64_t pixels = static_cast<uint64_t>(source.info.width) * source.info.height;
+    PrintDecodeRow(source.path.filename().string(), ms, source.file.GetSize(), pixels, 0.0);
+  }
+  const double serial_ms = TimeDecodeSet(files, nullptr, options.iterations);
+  const double parallel_ms = TimeDecodeSet(files, &pool, options.iterations);
+  PrintDecodeRow("all " + std::to_string(files.size()) + ", serial", serial_ms, total_bytes, total_pixels, serial_ms);
+  PrintDecodeRow("all " + std::to_string(files.size()) + ", parallel", parallel_ms, total_bytes, total_pixels, serial_ms);
+  if (options.decode_only) {
+    return 0;
+  }
+
+  for (const SourceFile& file : files) {
+    const Image& source = file.decoded;
+    std::cout << file.path.string() << " (" << source.width << "x" << source.height << ", "
+              << CalculateMipCount(source.width, source.height) << " mips)" << '\n';
+
+    for (const MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+      const char* filter_name = (filter == MipFilter::Box) ? "box" : "kaiser";
+      MipGenerationOptions mip_options;
+      mip_options.filter = filter;
+      mip_options.srgb = options.srgb;
+
+      mip_options.force_scalar = true;
+      const double scalar_ms = TimeMipChain(source, mip_options, options.iterations);
+      mip_options.force_scalar = false;
+      const double simd_ms = TimeMipChain(source, mip_options, options.iterations);
+      mip_options.pool = &pool;
+      const double threaded_ms = TimeMipChain(source, mip_options, options.iterations);
+
+      std::cout << " Mip chain, " << filter_name << ":" << '\n';
+      PrintRow("scalar", scalar_ms, scalar_ms, source);
+      PrintRow("simd", simd_ms, scalar_ms, source);
+      PrintRow("simd + threads", threaded_ms, scalar_ms, source);
+    }
+  }
+
+  return 0;
+}
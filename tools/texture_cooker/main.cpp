@@ -0,0 +1,221 @@
+// texture_cooker: Converts PNG / TGA textures into cooked texture containers (.ctex, see cooked_texture.h):
+// full mip chain, block compression and D3D12 placed-footprint layout, so the runtime maps the file and
+// copies it into upload memory without decoding.
+//
+// Usage: texture_cooker [options] <input.png | input.tga>...
+//   -o <dir>          Output directory (default: next to each input)
+//   --format <name>   auto | rgba8 | bc1 | bc3 | bc4 | bc5 | bc7 (default: auto)
+//                     auto picks bc4 for grayscale images and bc7 otherwise
+//   --srgb            Color data: filter mips in linear space and load as *_SRGB
+//   --no-mips         Mip 0 only
+//   --mip-filter <f>  box | kaiser (default: kaiser)
+//   --premultiplied   Source color is premultiplied by alpha (default: straight alpha)
+//   --threads <n>     Encoder threads (default: hardware concurrency)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "block_compression.h"
+#include "cooked_texture.h"
+#include "image_decoder.h"
+#include "thread_pool.h"
+
+namespace {
+struct Options {
+  std::filesystem::path output_dir;
+  bool auto_format = true;
+  CookedTextureFormat format = CookedTextureFormat::BC7;
+  bool srgb = false;
+  bool generate_mips = true;
+  MipFilter mip_filter = MipFilter::Kaiser;
+  MipAlphaMode alpha_mode = MipAlphaMode::Straight;
+  uint32_t threads = 0;
+  std::vector<std::filesystem::path> inputs;
+};
+
+void PrintUsage() {
+  std::cerr << "Usage: texture_cooker [-o <dir>] [--format auto|rgba8|bc1|bc3|bc4|bc5|bc7] [--srgb] [--no-mips] "
+               "[--mip-filter box|kaiser] [--premultiplied] [--threads <n>] <input.png | input.tga>..."
+            << '\n';
+}
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "-o" && has_value) {
+      options.output_dir = argv[++i];
+    } else if (arg == "--format" && has_value) {
+      const std::string name = argv[++i];
+      options.auto_format = (name == "auto");
+      if (!options.auto_format && !ParseCookedTextureFormat(name, options.format)) {
+        std::cerr << "[texture_cooker] Unknown format: " << name << '\n';
+        return false;
+      }
+    } else if (arg == "--srgb") {
+      options.srgb = true;
+    } else if (arg == "--no-mips") {
+      options.generate_mips = false;
+    } else if (arg == "--mip-filter" && has_value) {
+      const std::string name = argv[++i];
+      if (name != "box" && name != "kaiser") {
+        std::cerr << "[texture_cooker] Unknown mip filter: " << name << '\n';
+        return false;
+      }
+      options.mip_filter = (name == "box") ? MipFilter::Box : MipFilter::Kaiser;
+    } else if (arg == "--premultiplied") {
+      options.alpha_mode = MipAlphaMode::Premultiplied;
+    } else if (arg == "--threads" && has_value) {
+      options.threads = static_cast<uint32_t>((std::max)(0, std::atoi(argv[++i])));
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cerr << "[texture_cooker] Unknown option: " << arg << '\n';
+      return false;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+  }
+  return !options.inputs.empty();
+}
+
+bool IsGrayscale(const Image& image) {
+  for (size_t i = 0; i < image.pixels.size(); i += Image::kBytesPerPixel) {
+    const uint8_t* p = image.pixels.data() + i;
+    if (p[0] != p[1] || p[0] != p[2] || p[3] != 255) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Channels a format preserves (BC4: R, BC5: RG, BC1: RGB, otherwise RGBA)
+uint32_t GetComparedChannels(CookedTextureFormat format) {
+  switch (format) {
+    case CookedTextureFormat::BC4:
+      return 1;
+    case CookedTextureFormat::BC5:
+      return 2;
+    case CookedTextureFormat::BC1:
+      return 3;
+    default:
+      return 4;
+  }
+}
+
+// PSNR of mip 0 as stored in the container against the source (infinity when lossless)
+double MeasurePsnr(const Image& source, const std::vector<uint8_t>& file) {
+  CookedTextureView view;
+  if (!ParseCookedTexture(file.data(), file.size(), view)) {
+    return 0.0;
+  }
+
+  const CookedTextureFormat format = view.header->format;
+  const CookedTextureSubresource& mip0 = view.subresources[0];
+  Image decoded;
+  if (IsBlockCompressed(format)) {
+    const BlockFormat block_format = format == CookedTextureFormat::BC1   ? BlockFormat::BC1
+                                     : format == CookedTextureFormat::BC3 ? BlockFormat::BC3
+                                     : format == CookedTextureFormat::BC4 ? BlockFormat::BC4
+                                     : format == CookedTextureFormat::BC5 ? BlockFormat::BC5
+                                                                          : BlockFormat::BC7;
+    DecompressImage(view.data + mip0.offset, mip0.row_pitch, block_format, mip0.width, mip0.height, decoded);
+  } else {
+    decoded.Resize(mip0.width, mip0.height);
+    for (uint32_t y = 0; y < mip0.height; ++y) {
+      std::copy_n(view.data + mip0.offset + static_cast<size_t>(y) * mip0.row_pitch, mip0.row_bytes, decoded.GetPixel(0, y));
+    }
+  }
+
+  const uint32_t channels = GetComparedChannels(format);
+  double squared_error = 0.0;
+  for (size_t i = 0; i < source.pixels.size(); ++i) {
+    if (i % Image::kBytesPerPixel < channels) {
+      const double diff = static_cast<double>(source.pixels[i]) - static_cast<double>(decoded.pixels[i]);
+      squared_error += diff * diff;
+    }
+  }
+  const double mse = squared_error / (static_cast<double>(source.pixels.size() / Image::kBytesPerPixel) * channels);
+  return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : INFINITY;
+}
+
+bool CookFile(const std::filesystem::path& input, const Options& options, ThreadPool& pool) {
+  const auto start = std::chrono::steady_clock::now();
+
+  Image source;
+  if (!DecodeImageFile(input, source)) {
+    std::cerr << "[texture_cooker] Failed to decode " << input.string() << '\n';
+    return false;
+  }
+
+  CookTextureOptions cook_options;
+  cook_options.format = options.auto_format ? (IsGrayscale(source) ? CookedTextureFormat::BC4 : CookedTextureFormat::BC7) : options.format;
+  cook_options.srgb = options.srgb;
+  cook_options.generate_mips = options.generate_mips;
+  cook_options.mip_filter = options.mip_filter;
+  cook_options.alpha_mode = options.alpha_mode;
+  cook_options.pool = &pool;
+
+  if (IsBlockCompressed(cook_options.format) && (source.width % 4 != 0 || source.height % 4 != 0)) {
+    std::cerr << "[texture_cooker] " << input.string() << ": " << source.width << "x" << source.height
+              << " is not a multiple of 4, falling back to rgba8" << '\n';
+    cook_options.format = CookedTextureFormat::RGBA8;
+  }
+
+  std::vector<uint8_t> file;
+  if (!CookTexture(source, cook_options, file)) {
+    return false;
+  }
+
+  const std::filesystem::path output_dir = options.output_dir.empty() ? input.parent_path() : options.output_dir;
+  const std::filesystem::path output = output_dir / input.filename().replace_extension(".ctex");
+  std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+  if (!stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()))) {
+    std::cerr << "[texture_cooker] Failed to write " << output.string() << '\n';
+    return false;
+  }
+
+  const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  const auto* header = reinterpret_cast<const CookedTextureHeader*>(file.data());
+  std::cout << output.string() << ": " << source.width << "x" << source.height << " " << GetCookedTextureFormatName(cook_options.format)
+            << (cook_options.srgb ? " srgb" : "") << ", " << header->mip_count << " mip(s), " << file.size() / 1024 << " KB, PSNR "
+            << std::fixed << std::setprecision(2) << MeasurePsnr(source, file) << " dB, " << std::setprecision(1) << elapsed_ms << " ms"
+            << '\n';
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    PrintUsage();
+    return 1;
+  }
+
+  if (!options.output_dir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(options.output_dir, error);
+  }
+
+  ThreadPool pool;
+  const uint32_t threads = options.threads > 0 ? options.threads : (std::max)(1u, std::thread::hardware_concurrency());
+  pool.Initialize(threads, "Cooker");
+
+  uint32_t failures = 0;
+  for (const std::filesystem::path& input : options.inputs) {
+    if (!CookFile(input, options, pool)) {
+      ++failures;
+    }
+  }
+
+  std::cout << "Cooked " << options.inputs.size() - failures << " / " << options.inputs.size() << " texture(s)" << '\n';
+  return failures == 0 ? 0 : 1;
+}